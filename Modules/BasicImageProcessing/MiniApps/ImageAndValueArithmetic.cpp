@@ -15,7 +15,7 @@ found in the LICENSE file.
 #include "mitkCommandLineParser.h"
 #include "mitkIOUtil.h"
 
-#include <mitkArithmeticOperation.h>
+#include <mitkArithmeticExpression.h>
 
 static bool ConvertToBool(std::map<std::string, us::Any> &data, std::string name)
 {
@@ -90,55 +90,58 @@ int main(int argc, char* argv[])
   bool resultAsDouble = ConvertToBool(parsedArgs, "as-double");
   MITK_INFO << "Output image as double: " << resultAsDouble;
 
-  mitk::Image::Pointer tmpImage = image->Clone();
+  mitk::ArithmeticExpression expression(image);
   if (ConvertToBool(parsedArgs, "image-right"))
   {
     if (ConvertToBool(parsedArgs, "add"))
     {
-      MITK_INFO << " Start Doing Operation: ADD()";
-      tmpImage = mitk::ArithmeticOperation::Add(value, tmpImage, resultAsDouble);
+      MITK_INFO << " Adding Operation: ADD()";
+      expression = value + expression;
     }
     if (ConvertToBool(parsedArgs, "subtract"))
     {
-      MITK_INFO << " Start Doing Operation: SUB()";
-      tmpImage = mitk::ArithmeticOperation::Subtract(value, tmpImage, resultAsDouble);
+      MITK_INFO << " Adding Operation: SUB()";
+      expression = value - expression;
     }
     if (ConvertToBool(parsedArgs, "multiply"))
     {
-      MITK_INFO << " Start Doing Operation: MULT()";
-      tmpImage = mitk::ArithmeticOperation::Multiply(value, tmpImage, resultAsDouble);
+      MITK_INFO << " Adding Operation: MULT()";
+      expression = value * expression;
     }
     if (ConvertToBool(parsedArgs, "divide"))
     {
-      MITK_INFO << " Start Doing Operation: DIV()";
-      tmpImage = mitk::ArithmeticOperation::Divide(value, tmpImage, resultAsDouble);
+      MITK_INFO << " Adding Operation: DIV()";
+      expression = value / expression;
     }
   }
   else {
     if (ConvertToBool(parsedArgs, "add"))
     {
-      MITK_INFO << " Start Doing Operation: ADD()";
-      tmpImage = mitk::ArithmeticOperation::Add(tmpImage, value, resultAsDouble);
+      MITK_INFO << " Adding Operation: ADD()";
+      expression = expression + value;
     }
     if (ConvertToBool(parsedArgs, "subtract"))
     {
-      MITK_INFO << " Start Doing Operation: SUB()";
-      tmpImage = mitk::ArithmeticOperation::Subtract(tmpImage, value, resultAsDouble);
+      MITK_INFO << " Adding Operation: SUB()";
+      expression = expression - value;
     }
     if (ConvertToBool(parsedArgs, "multiply"))
     {
-      MITK_INFO << " Start Doing Operation: MULT()";
-      tmpImage = mitk::ArithmeticOperation::Multiply(tmpImage, value, resultAsDouble);
+      MITK_INFO << " Adding Operation: MULT()";
+      expression = expression * value;
     }
     if (ConvertToBool(parsedArgs, "divide"))
     {
-      MITK_INFO << " Start Doing Operation: DIV()";
-      tmpImage = mitk::ArithmeticOperation::Divide(tmpImage, value, resultAsDouble);
+      MITK_INFO << " Adding Operation: DIV()";
+      expression = expression / value;
     }
 
   }
 
-  mitk::IOUtil::Save(tmpImage, outputFilename);
+  MITK_INFO << " Start Evaluating Operations";
+  auto resultImage = expression.Evaluate(resultAsDouble);
+
+  mitk::IOUtil::Save(resultImage, outputFilename);
 
   return EXIT_SUCCESS;
 }
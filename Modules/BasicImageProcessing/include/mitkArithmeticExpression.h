@@ -0,0 +1,138 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkArithmeticExpression_h
+#define mitkArithmeticExpression_h
+
+#include <mitkImage.h>
+#include <MitkBasicImageProcessingExports.h>
+
+#include <memory>
+
+namespace mitk
+{
+  /** \brief Lazily evaluated arithmetic expression over images and scalar values
+  *
+  * An expression is a tree that is built with the arithmetic operators and the static functions
+  * of this class. Building the tree does not touch any pixel data:
+  *
+  * \code
+  * auto expression = ArithmeticExpression::Sqrt(ArithmeticExpression(imageA) * 2.0 + imageB);
+  * Image::Pointer result = expression.Evaluate();
+  * \endcode
+  *
+  * Evaluate() computes the whole expression in a single pass over the voxels. The voxels are split
+  * into blocks that are distributed over several threads. Each block of every input image is converted
+  * to double and passed through all operations of the expression in tight loops, which the compiler can
+  * vectorize. The result image is the only full size image that is allocated; no intermediate image is
+  * created for the individual operations. Subexpressions without any image are folded into constants.
+  *
+  * All images of an expression must have the same dimensions and scalar pixels. The output image gets the
+  * geometry of the first image of the expression (in depth-first, left to right order).
+  */
+  class MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression
+  {
+  public:
+    /** \brief Expression of a single image.
+    *
+    * The constructor is explicit, because a literal 0 would otherwise be ambiguous between a null image and the value 0.
+    * \exception mitk::Exception if the image is null.
+    */
+    explicit ArithmeticExpression(const Image *image);
+    ArithmeticExpression(const Image::Pointer &image);
+    ArithmeticExpression(double value);
+
+    static ArithmeticExpression Pow(const ArithmeticExpression &base, const ArithmeticExpression &exponent);
+
+    static ArithmeticExpression Tan(const ArithmeticExpression &argument);
+    static ArithmeticExpression Atan(const ArithmeticExpression &argument);
+    static ArithmeticExpression Cos(const ArithmeticExpression &argument);
+    static ArithmeticExpression Acos(const ArithmeticExpression &argument);
+    static ArithmeticExpression Sin(const ArithmeticExpression &argument);
+    static ArithmeticExpression Asin(const ArithmeticExpression &argument);
+    static ArithmeticExpression Square(const ArithmeticExpression &argument);
+    static ArithmeticExpression Sqrt(const ArithmeticExpression &argument);
+    static ArithmeticExpression Abs(const ArithmeticExpression &argument);
+    static ArithmeticExpression Exp(const ArithmeticExpression &argument);
+    static ArithmeticExpression ExpNeg(const ArithmeticExpression &argument);
+    static ArithmeticExpression Log10(const ArithmeticExpression &argument);
+
+    /** \brief Computes the expression for all voxels of its images.
+    *
+    * All operations are computed in double precision; only the final result is converted to the output pixel
+    * type. For integer output types, the result is rounded towards zero and clamped to the range of the type.
+    * A division by zero results in the largest double value.
+    *
+    * \param outputAsDouble If true, the output image has double pixels, otherwise the pixel type of the first image.
+    * \param numberOfThreads Number of computing threads. 0 uses all cores.
+    * \exception mitk::Exception if the expression contains no image, if an image is not initialized, if an image
+    * has non-scalar pixels or if the images do not have the same dimensions.
+    */
+    Image::Pointer Evaluate(bool outputAsDouble = true, unsigned int numberOfThreads = 0) const;
+
+    friend ArithmeticExpression operator+(const ArithmeticExpression &left, const ArithmeticExpression &right)
+    {
+      return CreateBinary(OperationType::Add, left, right);
+    }
+
+    friend ArithmeticExpression operator-(const ArithmeticExpression &left, const ArithmeticExpression &right)
+    {
+      return CreateBinary(OperationType::Subtract, left, right);
+    }
+
+    friend ArithmeticExpression operator*(const ArithmeticExpression &left, const ArithmeticExpression &right)
+    {
+      return CreateBinary(OperationType::Multiply, left, right);
+    }
+
+    friend ArithmeticExpression operator/(const ArithmeticExpression &left, const ArithmeticExpression &right)
+    {
+      return CreateBinary(OperationType::Divide, left, right);
+    }
+
+  private:
+    enum class OperationType
+    {
+      Image,
+      Value,
+      Add,
+      Subtract,
+      Multiply,
+      Divide,
+      Pow,
+      Tan,
+      Atan,
+      Cos,
+      Acos,
+      Sin,
+      Asin,
+      Square,
+      Sqrt,
+      Abs,
+      Exp,
+      ExpNeg,
+      Log10
+    };
+
+    struct Node;
+    class Program;
+
+    explicit ArithmeticExpression(std::shared_ptr<const Node> node);
+
+    static ArithmeticExpression CreateUnary(OperationType operation, const ArithmeticExpression &argument);
+    static ArithmeticExpression CreateBinary(OperationType operation, const ArithmeticExpression &left, const ArithmeticExpression &right);
+
+    std::shared_ptr<const Node> m_Node;
+  };
+}
+
+#endif
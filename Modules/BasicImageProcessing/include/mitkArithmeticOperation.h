@@ -14,14 +14,16 @@ found in the LICENSE file.
 #define mitkArithmeticOperation_h
 
 #include <mitkImage.h>
+#include <mitkArithmeticExpression.h>
 #include <MitkBasicImageProcessingExports.h>
 
 namespace mitk
 {
   /** \brief Executes a arithmetic operations on one or two images
   *
-  * All parameters of the arithmetic operations must be specified during construction.
-  * The actual operation is executed when calling GetResult().
+  * Each function evaluates a single node mitk::ArithmeticExpression and allocates a new output image.
+  * To combine several operations, build one ArithmeticExpression instead, which computes the whole
+  * chain in one pass without intermediate images.
   */
   class MITKBASICIMAGEPROCESSING_EXPORT ArithmeticOperation {
   public:
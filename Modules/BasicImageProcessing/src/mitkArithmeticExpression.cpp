@@ -0,0 +1,513 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkArithmeticExpression.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkPixelTypeMultiplex.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+  // Number of voxels that are computed at once. The temporary buffers of one block stay in the cache.
+  constexpr std::size_t BlockSize = 4096;
+
+  using ReadFunction = void (*)(const void *data, std::size_t first, std::size_t count, double *output);
+  using WriteFunction = void (*)(const double *input, std::size_t count, void *data, std::size_t first);
+
+  struct InputData
+  {
+    const void *data;
+    ReadFunction read;
+  };
+
+  template <typename TPixel>
+  TPixel ConvertToPixel(double value)
+  {
+    if constexpr (std::is_integral<TPixel>::value)
+    {
+      if (std::isnan(value))
+        return TPixel(0);
+      if (value <= static_cast<double>(std::numeric_limits<TPixel>::lowest()))
+        return std::numeric_limits<TPixel>::lowest();
+      if (value >= static_cast<double>(std::numeric_limits<TPixel>::max()))
+        return std::numeric_limits<TPixel>::max();
+    }
+    return static_cast<TPixel>(value);
+  }
+
+  template <typename TPixel>
+  void ReadBlock(const void *data, std::size_t first, std::size_t count, double *output)
+  {
+    const auto *pixels = static_cast<const TPixel *>(data) + first;
+    for (std::size_t i = 0; i < count; ++i)
+      output[i] = static_cast<double>(pixels[i]);
+  }
+
+  template <typename TPixel>
+  void WriteBlock(const double *input, std::size_t count, void *data, std::size_t first)
+  {
+    auto *pixels = static_cast<TPixel *>(data) + first;
+    for (std::size_t i = 0; i < count; ++i)
+      pixels[i] = ConvertToPixel<TPixel>(input[i]);
+  }
+
+  template <typename TPixel>
+  void SelectBlockFunctions(const mitk::PixelType &, ReadFunction &read, WriteFunction &write)
+  {
+    read = &ReadBlock<TPixel>;
+    write = &WriteBlock<TPixel>;
+  }
+
+  struct AddFunction { double operator()(double a, double b) const { return a + b; } };
+  struct SubtractFunction { double operator()(double a, double b) const { return a - b; } };
+  struct MultiplyFunction { double operator()(double a, double b) const { return a * b; } };
+  // same result as itk::Functor::Div for a division by zero
+  struct DivideFunction { double operator()(double a, double b) const { return b != 0.0 ? a / b : std::numeric_limits<double>::max(); } };
+  struct PowFunction { double operator()(double a, double b) const { return std::pow(a, b); } };
+
+  struct TanFunction { double operator()(double a) const { return std::tan(a); } };
+  struct AtanFunction { double operator()(double a) const { return std::atan(a); } };
+  struct CosFunction { double operator()(double a) const { return std::cos(a); } };
+  struct AcosFunction { double operator()(double a) const { return std::acos(a); } };
+  struct SinFunction { double operator()(double a) const { return std::sin(a); } };
+  struct AsinFunction { double operator()(double a) const { return std::asin(a); } };
+  struct SquareFunction { double operator()(double a) const { return a * a; } };
+  struct SqrtFunction { double operator()(double a) const { return std::sqrt(a); } };
+  struct AbsFunction { double operator()(double a) const { return std::abs(a); } };
+  struct ExpFunction { double operator()(double a) const { return std::exp(a); } };
+  struct ExpNegFunction { double operator()(double a) const { return std::exp(-a); } };
+  struct Log10Function { double operator()(double a) const { return std::log10(a); } };
+}
+
+struct mitk::ArithmeticExpression::Node
+{
+  OperationType operation = OperationType::Value;
+  Image::ConstPointer image;
+  double value = 0.0;
+  std::shared_ptr<const Node> left;
+  std::shared_ptr<const Node> right;
+  bool containsImage = false;
+};
+
+/** Postfix program of an expression. Each instruction works on a stack of voxel blocks: an image instruction
+* pushes the converted block of an image, a unary instruction transforms the top block and a binary instruction
+* combines the two top blocks or the top block and a folded constant.
+*/
+class mitk::ArithmeticExpression::Program
+{
+public:
+  explicit Program(const Node &root)
+  {
+    if (!root.containsImage)
+      mitkThrow() << "Arithmetic expression does not contain any image.";
+
+    std::size_t depth = 0;
+    this->Compile(root, depth);
+  }
+
+  /** Distinct images of the expression, in the order of their first occurrence.*/
+  const std::vector<Image::ConstPointer> &GetImages() const
+  {
+    return m_Images;
+  }
+
+  std::size_t GetStackDepth() const
+  {
+    return m_StackDepth;
+  }
+
+  /** Computes the voxels [first, first + count) into the first block of the stack.*/
+  void Execute(const std::vector<InputData> &inputs, std::size_t first, std::size_t count, double *stack) const
+  {
+    std::size_t top = 0;
+
+    for (const auto &instruction : m_Instructions)
+    {
+      if (OperationType::Image == instruction.operation)
+      {
+        const auto &input = inputs[instruction.input];
+        input.read(input.data, first, count, stack + top * BlockSize);
+        ++top;
+      }
+      else if (IsUnary(instruction.operation))
+      {
+        auto *block = stack + (top - 1) * BlockSize;
+        VisitUnary(instruction.operation, [block, count](auto function) {
+          for (std::size_t i = 0; i < count; ++i)
+            block[i] = function(block[i]);
+        });
+      }
+      else if (OperandType::Block == instruction.operand)
+      {
+        auto *block = stack + (top - 2) * BlockSize;
+        const auto *right = block + BlockSize;
+        VisitBinary(instruction.operation, [block, right, count](auto function) {
+          for (std::size_t i = 0; i < count; ++i)
+            block[i] = function(block[i], right[i]);
+        });
+        --top;
+      }
+      else if (OperandType::LeftValue == instruction.operand)
+      {
+        auto *block = stack + (top - 1) * BlockSize;
+        const auto value = instruction.value;
+        VisitBinary(instruction.operation, [block, value, count](auto function) {
+          for (std::size_t i = 0; i < count; ++i)
+            block[i] = function(value, block[i]);
+        });
+      }
+      else
+      {
+        auto *block = stack + (top - 1) * BlockSize;
+        const auto value = instruction.value;
+        VisitBinary(instruction.operation, [block, value, count](auto function) {
+          for (std::size_t i = 0; i < count; ++i)
+            block[i] = function(block[i], value);
+        });
+      }
+    }
+  }
+
+private:
+  enum class OperandType
+  {
+    Block,
+    LeftValue,
+    RightValue
+  };
+
+  struct Instruction
+  {
+    OperationType operation;
+    OperandType operand;
+    double value;
+    std::size_t input;
+  };
+
+  static bool IsUnary(OperationType operation)
+  {
+    return operation >= OperationType::Tan;
+  }
+
+  template <typename TVisitor>
+  static void VisitUnary(OperationType operation, TVisitor visitor)
+  {
+    switch (operation)
+    {
+    case OperationType::Tan: visitor(TanFunction()); break;
+    case OperationType::Atan: visitor(AtanFunction()); break;
+    case OperationType::Cos: visitor(CosFunction()); break;
+    case OperationType::Acos: visitor(AcosFunction()); break;
+    case OperationType::Sin: visitor(SinFunction()); break;
+    case OperationType::Asin: visitor(AsinFunction()); break;
+    case OperationType::Square: visitor(SquareFunction()); break;
+    case OperationType::Sqrt: visitor(SqrtFunction()); break;
+    case OperationType::Abs: visitor(AbsFunction()); break;
+    case OperationType::Exp: visitor(ExpFunction()); break;
+    case OperationType::ExpNeg: visitor(ExpNegFunction()); break;
+    case OperationType::Log10: visitor(Log10Function()); break;
+    default: mitkThrow() << "Invalid unary arithmetic operation.";
+    }
+  }
+
+  template <typename TVisitor>
+  static void VisitBinary(OperationType operation, TVisitor visitor)
+  {
+    switch (operation)
+    {
+    case OperationType::Add: visitor(AddFunction()); break;
+    case OperationType::Subtract: visitor(SubtractFunction()); break;
+    case OperationType::Multiply: visitor(MultiplyFunction()); break;
+    case OperationType::Divide: visitor(DivideFunction()); break;
+    case OperationType::Pow: visitor(PowFunction()); break;
+    default: mitkThrow() << "Invalid binary arithmetic operation.";
+    }
+  }
+
+  static double EvaluateConstant(const Node &node)
+  {
+    double result = node.value;
+
+    if (IsUnary(node.operation))
+    {
+      const auto argument = EvaluateConstant(*node.left);
+      VisitUnary(node.operation, [&result, argument](auto function) { result = function(argument); });
+    }
+    else if (OperationType::Value != node.operation)
+    {
+      const auto left = EvaluateConstant(*node.left);
+      const auto right = EvaluateConstant(*node.right);
+      VisitBinary(node.operation, [&result, left, right](auto function) { result = function(left, right); });
+    }
+
+    return result;
+  }
+
+  std::size_t AddInput(const Image *image)
+  {
+    auto iter = std::find_if(m_Images.begin(), m_Images.end(), [image](const Image::ConstPointer &candidate) { return candidate.GetPointer() == image; });
+    if (iter != m_Images.end())
+      return static_cast<std::size_t>(iter - m_Images.begin());
+
+    m_Images.push_back(image);
+    return m_Images.size() - 1;
+  }
+
+  void Compile(const Node &node, std::size_t &depth)
+  {
+    if (OperationType::Image == node.operation)
+    {
+      m_Instructions.push_back({node.operation, OperandType::Block, 0.0, this->AddInput(node.image)});
+      m_StackDepth = std::max(m_StackDepth, ++depth);
+    }
+    else if (IsUnary(node.operation))
+    {
+      this->Compile(*node.left, depth);
+      m_Instructions.push_back({node.operation, OperandType::Block, 0.0, 0});
+    }
+    else if (!node.left->containsImage)
+    {
+      this->Compile(*node.right, depth);
+      m_Instructions.push_back({node.operation, OperandType::LeftValue, EvaluateConstant(*node.left), 0});
+    }
+    else if (!node.right->containsImage)
+    {
+      this->Compile(*node.left, depth);
+      m_Instructions.push_back({node.operation, OperandType::RightValue, EvaluateConstant(*node.right), 0});
+    }
+    else
+    {
+      this->Compile(*node.left, depth);
+      this->Compile(*node.right, depth);
+      m_Instructions.push_back({node.operation, OperandType::Block, 0.0, 0});
+      --depth;
+    }
+  }
+
+  std::vector<Instruction> m_Instructions;
+  std::vector<Image::ConstPointer> m_Images;
+  std::size_t m_StackDepth = 0;
+};
+
+mitk::ArithmeticExpression::ArithmeticExpression(const Image *image)
+{
+  if (nullptr == image)
+    mitkThrow() << "Arithmetic expression cannot be created from a null image.";
+
+  auto node = std::make_shared<Node>();
+  node->operation = OperationType::Image;
+  node->image = image;
+  node->containsImage = true;
+  m_Node = node;
+}
+
+mitk::ArithmeticExpression::ArithmeticExpression(const Image::Pointer &image)
+  : ArithmeticExpression(image.GetPointer())
+{
+}
+
+mitk::ArithmeticExpression::ArithmeticExpression(double value)
+{
+  auto node = std::make_shared<Node>();
+  node->operation = OperationType::Value;
+  node->value = value;
+  m_Node = node;
+}
+
+mitk::ArithmeticExpression::ArithmeticExpression(std::shared_ptr<const Node> node)
+  : m_Node(node)
+{
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::CreateUnary(OperationType operation, const ArithmeticExpression &argument)
+{
+  auto node = std::make_shared<Node>();
+  node->operation = operation;
+  node->left = argument.m_Node;
+  node->containsImage = argument.m_Node->containsImage;
+  return ArithmeticExpression(node);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::CreateBinary(OperationType operation, const ArithmeticExpression &left, const ArithmeticExpression &right)
+{
+  auto node = std::make_shared<Node>();
+  node->operation = operation;
+  node->left = left.m_Node;
+  node->right = right.m_Node;
+  node->containsImage = left.m_Node->containsImage || right.m_Node->containsImage;
+  return ArithmeticExpression(node);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Pow(const ArithmeticExpression &base, const ArithmeticExpression &exponent)
+{
+  return CreateBinary(OperationType::Pow, base, exponent);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Tan(const ArithmeticExpression &argument)
+{
+  return CreateUnary(OperationType::Tan, argument);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Atan(const ArithmeticExpression &argument)
+{
+  return CreateUnary(OperationType::Atan, argument);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Cos(const ArithmeticExpression &argument)
+{
+  return CreateUnary(OperationType::Cos, argument);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Acos(const ArithmeticExpression &argument)
+{
+  return CreateUnary(OperationType::Acos, argument);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Sin(const ArithmeticExpression &argument)
+{
+  return CreateUnary(OperationType::Sin, argument);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Asin(const ArithmeticExpression &argument)
+{
+  return CreateUnary(OperationType::Asin, argument);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Square(const ArithmeticExpression &argument)
+{
+  return CreateUnary(OperationType::Square, argument);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Sqrt(const ArithmeticExpression &argument)
+{
+  return CreateUnary(OperationType::Sqrt, argument);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Abs(const ArithmeticExpression &argument)
+{
+  return CreateUnary(OperationType::Abs, argument);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Exp(const ArithmeticExpression &argument)
+{
+  return CreateUnary(OperationType::Exp, argument);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::ExpNeg(const ArithmeticExpression &argument)
+{
+  return CreateUnary(OperationType::ExpNeg, argument);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Log10(const ArithmeticExpression &argument)
+{
+  return CreateUnary(OperationType::Log10, argument);
+}
+
+mitk::Image::Pointer mitk::ArithmeticExpression::Evaluate(bool outputAsDouble, unsigned int numberOfThreads) const
+{
+  const Program program(*m_Node);
+  const auto &images = program.GetImages();
+  const Image *referenceImage = images.front();
+
+  // an image without any voxels is not initialized, its data cannot be accessed
+  for (const auto &image : images)
+  {
+    if (!image->IsInitialized())
+      mitkThrow() << "Images of an arithmetic expression have to be initialized.";
+  }
+
+  std::size_t numberOfVoxels = 1;
+  for (unsigned int i = 0; i < referenceImage->GetDimension(); ++i)
+    numberOfVoxels *= referenceImage->GetDimension(i);
+
+  std::vector<std::unique_ptr<ImageReadAccessor>> accessors;
+  std::vector<InputData> inputs;
+
+  for (const auto &image : images)
+  {
+    if (image->GetDimension() != referenceImage->GetDimension())
+      mitkThrow() << "Images of an arithmetic expression have different dimensions. This is not supported.";
+
+    for (unsigned int i = 0; i < referenceImage->GetDimension(); ++i)
+    {
+      if (image->GetDimension(i) != referenceImage->GetDimension(i))
+        mitkThrow() << "Images of an arithmetic expression have different sizes. This is not supported.";
+    }
+
+    const auto pixelType = image->GetPixelType();
+    if (1 != pixelType.GetNumberOfComponents())
+      mitkThrow() << "Pixel type " << pixelType.GetTypeAsString() << " is not supported by arithmetic expressions.";
+
+    ReadFunction read = nullptr;
+    WriteFunction write = nullptr;
+    mitkPixelTypeMultiplex2(SelectBlockFunctions, pixelType, read, write);
+    if (nullptr == read)
+      mitkThrow() << "Pixel type " << pixelType.GetTypeAsString() << " is not supported by arithmetic expressions.";
+
+    accessors.push_back(std::make_unique<ImageReadAccessor>(image));
+    inputs.push_back({accessors.back()->GetData(), read});
+  }
+
+  const auto outputPixelType = outputAsDouble ? MakeScalarPixelType<double>() : referenceImage->GetPixelType();
+  ReadFunction read = nullptr;
+  WriteFunction write = nullptr;
+  mitkPixelTypeMultiplex2(SelectBlockFunctions, outputPixelType, read, write);
+
+  auto outputImage = Image::New();
+  outputImage->Initialize(outputPixelType, referenceImage->GetDimension(), referenceImage->GetDimensions());
+  outputImage->SetClonedTimeGeometry(referenceImage->GetTimeGeometry());
+
+  ImageWriteAccessor outputAccessor(outputImage);
+  auto *outputData = outputAccessor.GetData();
+
+  const std::size_t numberOfBlocks = (numberOfVoxels + BlockSize - 1) / BlockSize;
+  if (0 == numberOfThreads)
+    numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+  numberOfThreads = static_cast<unsigned int>(std::min<std::size_t>(numberOfThreads, numberOfBlocks));
+
+  // Blocks are handed out one at a time, so threads that hit expensive voxels (e.g. denormals) do not stall the others.
+  std::atomic<std::size_t> nextBlock(0);
+  auto worker = [&program, &inputs, &nextBlock, write, outputData, numberOfVoxels, numberOfBlocks]()
+  {
+    std::vector<double> stack(program.GetStackDepth() * BlockSize);
+
+    for (auto block = nextBlock++; block < numberOfBlocks; block = nextBlock++)
+    {
+      const auto first = block * BlockSize;
+      const auto count = std::min(BlockSize, numberOfVoxels - first);
+      program.Execute(inputs, first, count, stack.data());
+      write(stack.data(), count, outputData, first);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < numberOfThreads; ++i)
+    threads.emplace_back(worker);
+
+  worker();
+
+  for (auto &thread : threads)
+    thread.join();
+
+  return outputImage;
+}
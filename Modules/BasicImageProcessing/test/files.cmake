@@ -0,0 +1,4 @@
+set(MODULE_TESTS
+  mitkArithmeticExpressionTest.cpp
+  mitkArithmeticOperationTest.cpp
+)
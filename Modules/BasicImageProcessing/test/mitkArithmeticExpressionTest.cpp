@@ -0,0 +1,226 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkArithmeticExpression.h>
+#include <mitkArithmeticOperation.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <itkRGBPixel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+class mitkArithmeticExpressionTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkArithmeticExpressionTestSuite);
+  MITK_TEST(ChainedExpression_EqualsSequentialOperations);
+  MITK_TEST(RepeatedImage_UsesSameValues);
+  MITK_TEST(ConstantSubexpressions_AreFolded);
+  MITK_TEST(LiteralZero_IsValue);
+  MITK_TEST(NumberOfThreads_DoesNotChangeResult);
+  MITK_TEST(Evaluate_WithoutImage_Throws);
+  MITK_TEST(Evaluate_MismatchedSizes_Throws);
+  MITK_TEST(Evaluate_NonScalarPixels_Throws);
+  MITK_TEST(Evaluate_ImageWithoutVoxels_Throws);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_ImageA;
+  mitk::Image::Pointer m_ImageB;
+
+  static mitk::Image::Pointer CreateImage(unsigned int sizeX, unsigned int sizeY, unsigned int sizeZ, double offset)
+  {
+    const unsigned int dimensions[3] = { sizeX, sizeY, sizeZ };
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions);
+
+    mitk::ImageWriteAccessor accessor(image);
+    auto *data = static_cast<short *>(accessor.GetData());
+    const std::size_t numberOfVoxels = sizeX * sizeY * sizeZ;
+    for (std::size_t i = 0; i < numberOfVoxels; ++i)
+      data[i] = static_cast<short>(static_cast<double>(i % 97) - offset);
+
+    return image;
+  }
+
+  static std::vector<double> GetValues(const mitk::Image *image)
+  {
+    CPPUNIT_ASSERT_MESSAGE("Double output", image->GetPixelType() == mitk::MakeScalarPixelType<double>());
+
+    std::size_t numberOfVoxels = 1;
+    for (unsigned int i = 0; i < image->GetDimension(); ++i)
+      numberOfVoxels *= image->GetDimension(i);
+
+    mitk::ImageReadAccessor accessor(image);
+    const auto *data = static_cast<const double *>(accessor.GetData());
+    return std::vector<double>(data, data + numberOfVoxels);
+  }
+
+  static void CheckValues(const std::vector<double> &expected, const std::vector<double> &actual, const std::string &message)
+  {
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(message + ": number of voxels", expected.size(), actual.size());
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(message + ", voxel #" + std::to_string(i), expected[i], actual[i],
+                                           1e-12 * std::max(1.0, std::abs(expected[i])));
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_ImageA = CreateImage(4, 3, 2, 10.0);
+    m_ImageB = CreateImage(4, 3, 2, -1.0);
+  }
+
+  void tearDown() override
+  {
+    m_ImageA = nullptr;
+    m_ImageB = nullptr;
+  }
+
+  void ChainedExpression_EqualsSequentialOperations()
+  {
+    using mitk::ArithmeticExpression;
+    using mitk::ArithmeticOperation;
+
+    const auto expression = ArithmeticExpression::Sqrt(ArithmeticExpression::Abs(ArithmeticExpression(m_ImageA) * 2.0 - m_ImageB)) / (m_ImageB + ArithmeticExpression(1.0));
+    const auto result = expression.Evaluate();
+
+    auto doubled = ArithmeticOperation::Multiply(m_ImageA, 2.0);
+    auto difference = ArithmeticOperation::Subtract(doubled, m_ImageB);
+    auto absolute = ArithmeticOperation::Abs(difference);
+    auto root = ArithmeticOperation::Sqrt(absolute);
+    auto denominator = ArithmeticOperation::Add(m_ImageB, 1.0);
+    auto sequentialResult = ArithmeticOperation::Divide(root, denominator);
+
+    CheckValues(GetValues(sequentialResult), GetValues(result), "Chained expression");
+  }
+
+  void RepeatedImage_UsesSameValues()
+  {
+    using mitk::ArithmeticExpression;
+
+    const auto product = (ArithmeticExpression(m_ImageA) * m_ImageA - m_ImageA).Evaluate();
+
+    const auto values = GetValues((ArithmeticExpression(m_ImageA) + 0.0).Evaluate());
+    std::vector<double> expected(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+      expected[i] = values[i] * values[i] - values[i];
+
+    CheckValues(expected, GetValues(product), "Image used several times");
+  }
+
+  void ConstantSubexpressions_AreFolded()
+  {
+    using mitk::ArithmeticExpression;
+
+    const auto constant = (ArithmeticExpression(2.0) + 3.0) * ArithmeticExpression::Sqrt(16.0);
+    const auto result = (ArithmeticExpression(m_ImageA) * constant - ArithmeticExpression::Pow(2.0, 3.0)).Evaluate();
+
+    const auto values = GetValues((ArithmeticExpression(m_ImageA) + 0.0).Evaluate());
+    std::vector<double> expected(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+      expected[i] = values[i] * 20.0 - 8.0;
+
+    CheckValues(expected, GetValues(result), "Folded constants");
+  }
+
+  void LiteralZero_IsValue()
+  {
+    using mitk::ArithmeticExpression;
+
+    // a literal 0 has to be the value 0, not a null image
+    const auto values = GetValues((ArithmeticExpression(m_ImageA) + 0).Evaluate());
+    const auto negatedValues = GetValues((0 - ArithmeticExpression(m_ImageA)).Evaluate());
+
+    std::vector<double> expected(negatedValues.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+      expected[i] = -values[i];
+
+    CheckValues(expected, negatedValues, "Zero minus image");
+    CPPUNIT_ASSERT_THROW(ArithmeticExpression(static_cast<const mitk::Image *>(nullptr)), mitk::Exception);
+  }
+
+  void NumberOfThreads_DoesNotChangeResult()
+  {
+    using mitk::ArithmeticExpression;
+
+    // several blocks with an incomplete last block
+    auto imageA = CreateImage(70, 60, 5, 10.0);
+    auto imageB = CreateImage(70, 60, 5, -1.0);
+    const auto expression = ArithmeticExpression::Exp(ArithmeticExpression(imageA) / imageB) + ArithmeticExpression::Cos(imageB);
+
+    const auto sequentialValues = GetValues(expression.Evaluate(true, 1));
+    for (unsigned int numberOfThreads : { 2u, 3u, 8u, 0u })
+    {
+      const auto values = GetValues(expression.Evaluate(true, numberOfThreads));
+      CPPUNIT_ASSERT_EQUAL(sequentialValues.size(), values.size());
+      CPPUNIT_ASSERT_MESSAGE("Same result with " + std::to_string(numberOfThreads) + " threads",
+                             0 == std::memcmp(sequentialValues.data(), values.data(), values.size() * sizeof(double)));
+    }
+
+    const auto shortResult = expression.Evaluate(false, 4);
+    CPPUNIT_ASSERT_MESSAGE("Pixel type of the first image", shortResult->GetPixelType() == mitk::MakeScalarPixelType<short>());
+  }
+
+  void Evaluate_WithoutImage_Throws()
+  {
+    using mitk::ArithmeticExpression;
+
+    CPPUNIT_ASSERT_THROW((ArithmeticExpression(2.0) + 3.0).Evaluate(), mitk::Exception);
+  }
+
+  void Evaluate_MismatchedSizes_Throws()
+  {
+    using mitk::ArithmeticExpression;
+
+    auto largerImage = CreateImage(4, 3, 3, 0.0);
+    CPPUNIT_ASSERT_THROW((ArithmeticExpression(m_ImageA) + largerImage).Evaluate(), mitk::Exception);
+
+    const unsigned int dimensions[2] = { 4, 3 };
+    auto image2D = mitk::Image::New();
+    image2D->Initialize(mitk::MakeScalarPixelType<short>(), 2, dimensions);
+    CPPUNIT_ASSERT_THROW((ArithmeticExpression(m_ImageA) + image2D).Evaluate(), mitk::Exception);
+  }
+
+  void Evaluate_NonScalarPixels_Throws()
+  {
+    using mitk::ArithmeticExpression;
+
+    const unsigned int dimensions[3] = { 4, 3, 2 };
+    auto rgbImage = mitk::Image::New();
+    rgbImage->Initialize(mitk::MakePixelType<itk::Image<itk::RGBPixel<unsigned char>, 3>>(), 3, dimensions);
+
+    CPPUNIT_ASSERT_THROW(ArithmeticExpression::Sqrt(rgbImage).Evaluate(), mitk::Exception);
+    CPPUNIT_ASSERT_THROW((ArithmeticExpression(m_ImageA) * rgbImage).Evaluate(), mitk::Exception);
+  }
+
+  void Evaluate_ImageWithoutVoxels_Throws()
+  {
+    using mitk::ArithmeticExpression;
+
+    // MITK images cannot be initialized with a size of 0, so an image without voxels is an uninitialized one
+    auto emptyImage = mitk::Image::New();
+    CPPUNIT_ASSERT_THROW(ArithmeticExpression(emptyImage).Evaluate(), mitk::Exception);
+    CPPUNIT_ASSERT_THROW((ArithmeticExpression(m_ImageA) + emptyImage).Evaluate(), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkArithmeticExpression)
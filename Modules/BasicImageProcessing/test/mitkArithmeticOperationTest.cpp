@@ -0,0 +1,260 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkArithmeticOperation.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+  const unsigned int ImageDimensions[3] = { 4, 3, 2 };
+  const std::size_t NumberOfVoxels = 4 * 3 * 2;
+
+  /** Same conversion as the one of the arithmetic expressions: integers are truncated and clamped, NaN becomes 0.*/
+  template <typename TPixel>
+  TPixel ToPixel(double value)
+  {
+    if constexpr (std::is_integral<TPixel>::value)
+    {
+      if (std::isnan(value))
+        return TPixel(0);
+      if (value <= static_cast<double>(std::numeric_limits<TPixel>::lowest()))
+        return std::numeric_limits<TPixel>::lowest();
+      if (value >= static_cast<double>(std::numeric_limits<TPixel>::max()))
+        return std::numeric_limits<TPixel>::max();
+    }
+    return static_cast<TPixel>(value);
+  }
+
+  template <typename TPixel>
+  mitk::Image::Pointer CreateImage(const std::vector<double> &values)
+  {
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<TPixel>(), 3, ImageDimensions);
+
+    mitk::ImageWriteAccessor accessor(image);
+    auto *data = static_cast<TPixel *>(accessor.GetData());
+    for (std::size_t i = 0; i < NumberOfVoxels; ++i)
+      data[i] = static_cast<TPixel>(values[i]);
+
+    return image;
+  }
+
+  /** First operand: negative, zero and positive values; within [-1, 1] for floating point pixels.*/
+  template <typename TPixel>
+  std::vector<double> CreateValuesA()
+  {
+    std::vector<double> values(NumberOfVoxels);
+    for (std::size_t i = 0; i < NumberOfVoxels; ++i)
+      values[i] = std::is_integral<TPixel>::value ? static_cast<double>(i) - 7.0 : (i + 1) / 25.0 - 0.3;
+    return values;
+  }
+
+  /** Second operand: positive values without zero.*/
+  template <typename TPixel>
+  std::vector<double> CreateValuesB()
+  {
+    std::vector<double> values(NumberOfVoxels);
+    for (std::size_t i = 0; i < NumberOfVoxels; ++i)
+      values[i] = std::is_integral<TPixel>::value ? static_cast<double>(i % 5 + 1) : 0.1 * (i % 5 + 1);
+    return values;
+  }
+
+  double Divide(double a, double b)
+  {
+    return b != 0.0 ? a / b : std::numeric_limits<double>::max();
+  }
+}
+
+class mitkArithmeticOperationTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkArithmeticOperationTestSuite);
+  MITK_TEST(TwoImageOperations_Integer);
+  MITK_TEST(TwoImageOperations_Double);
+  MITK_TEST(ImageAndValueOperations_Integer);
+  MITK_TEST(ImageAndValueOperations_Double);
+  MITK_TEST(ValueAndImageOperations_Integer);
+  MITK_TEST(ValueAndImageOperations_Double);
+  MITK_TEST(UnaryOperations_Integer);
+  MITK_TEST(UnaryOperations_Double);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  template <typename TOutputPixel>
+  void CheckValues(const mitk::Image *result, const std::vector<double> &expected, const std::string &message)
+  {
+    CPPUNIT_ASSERT_MESSAGE(message + ": output pixel type", result->GetPixelType() == mitk::MakeScalarPixelType<TOutputPixel>());
+
+    mitk::ImageReadAccessor accessor(result);
+    const auto *data = static_cast<const TOutputPixel *>(accessor.GetData());
+
+    for (std::size_t i = 0; i < NumberOfVoxels; ++i)
+    {
+      const auto expectedPixel = ToPixel<TOutputPixel>(expected[i]);
+      const auto voxelMessage = message + ", voxel #" + std::to_string(i);
+
+      if (std::is_integral<TOutputPixel>::value)
+      {
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(voxelMessage, expectedPixel, data[i]);
+      }
+      else if (std::isnan(static_cast<double>(expectedPixel)))
+      {
+        CPPUNIT_ASSERT_MESSAGE(voxelMessage, std::isnan(static_cast<double>(data[i])));
+      }
+      else
+      {
+        const double tolerance = 1e-12 * std::max(1.0, std::abs(static_cast<double>(expectedPixel)));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(voxelMessage, static_cast<double>(expectedPixel), static_cast<double>(data[i]), tolerance);
+      }
+    }
+  }
+
+  /** Applies the operation to images with the pixel type TPixel and compares the result with the reference
+  * function for double and for TPixel output.*/
+  template <typename TPixel, typename TOperation, typename TReference>
+  void CheckOperation(const std::string &name, TOperation operation, TReference reference)
+  {
+    const auto valuesA = CreateValuesA<TPixel>();
+    const auto valuesB = CreateValuesB<TPixel>();
+
+    std::vector<double> expected(NumberOfVoxels);
+    for (std::size_t i = 0; i < NumberOfVoxels; ++i)
+      expected[i] = reference(static_cast<double>(static_cast<TPixel>(valuesA[i])), static_cast<double>(static_cast<TPixel>(valuesB[i])));
+
+    for (bool outputAsDouble : { true, false })
+    {
+      auto imageA = CreateImage<TPixel>(valuesA);
+      auto imageB = CreateImage<TPixel>(valuesB);
+      mitk::Image::Pointer result = operation(imageA, imageB, outputAsDouble);
+      CPPUNIT_ASSERT_MESSAGE(name + ": result exists", result.IsNotNull());
+
+      if (outputAsDouble)
+      {
+        this->CheckValues<double>(result, expected, name + " (double output)");
+      }
+      else
+      {
+        this->CheckValues<TPixel>(result, expected, name + " (input pixel type output)");
+      }
+    }
+  }
+
+  template <typename TPixel>
+  void CheckTwoImageOperations()
+  {
+    using mitk::ArithmeticOperation;
+    using Pointer = mitk::Image::Pointer;
+
+    this->CheckOperation<TPixel>("Add", [](Pointer &a, Pointer &b, bool d) { return ArithmeticOperation::Add(a, b, d); },
+                                 [](double a, double b) { return a + b; });
+    this->CheckOperation<TPixel>("Subtract", [](Pointer &a, Pointer &b, bool d) { return ArithmeticOperation::Subtract(a, b, d); },
+                                 [](double a, double b) { return a - b; });
+    this->CheckOperation<TPixel>("Multiply", [](Pointer &a, Pointer &b, bool d) { return ArithmeticOperation::Multiply(a, b, d); },
+                                 [](double a, double b) { return a * b; });
+    this->CheckOperation<TPixel>("Divide", [](Pointer &a, Pointer &b, bool d) { return ArithmeticOperation::Divide(a, b, d); },
+                                 [](double a, double b) { return Divide(a, b); });
+    // the first image contains zeros for integer pixels
+    this->CheckOperation<TPixel>("Divide by image with zeros", [](Pointer &a, Pointer &b, bool d) { return ArithmeticOperation::Divide(b, a, d); },
+                                 [](double a, double b) { return Divide(b, a); });
+  }
+
+  template <typename TPixel>
+  void CheckImageAndValueOperations()
+  {
+    using mitk::ArithmeticOperation;
+    using Pointer = mitk::Image::Pointer;
+
+    this->CheckOperation<TPixel>("Add value", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Add(a, 3.0, d); },
+                                 [](double a, double) { return a + 3.0; });
+    this->CheckOperation<TPixel>("Subtract value", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Subtract(a, 3.0, d); },
+                                 [](double a, double) { return a - 3.0; });
+    this->CheckOperation<TPixel>("Multiply value", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Multiply(a, 2.5, d); },
+                                 [](double a, double) { return a * 2.5; });
+    this->CheckOperation<TPixel>("Divide value", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Divide(a, 4.0, d); },
+                                 [](double a, double) { return a / 4.0; });
+    this->CheckOperation<TPixel>("Divide zero value", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Divide(a, 0.0, d); },
+                                 [](double a, double) { return Divide(a, 0.0); });
+  }
+
+  template <typename TPixel>
+  void CheckValueAndImageOperations()
+  {
+    using mitk::ArithmeticOperation;
+    using Pointer = mitk::Image::Pointer;
+
+    this->CheckOperation<TPixel>("Value add", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Add(3.0, a, d); },
+                                 [](double a, double) { return 3.0 + a; });
+    this->CheckOperation<TPixel>("Value subtract", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Subtract(3.0, a, d); },
+                                 [](double a, double) { return 3.0 - a; });
+    this->CheckOperation<TPixel>("Value multiply", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Multiply(2.5, a, d); },
+                                 [](double a, double) { return 2.5 * a; });
+    this->CheckOperation<TPixel>("Value divide", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Divide(4.0, a, d); },
+                                 [](double a, double) { return Divide(4.0, a); });
+  }
+
+  template <typename TPixel>
+  void CheckUnaryOperations()
+  {
+    using mitk::ArithmeticOperation;
+    using Pointer = mitk::Image::Pointer;
+
+    this->CheckOperation<TPixel>("Tan", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Tan(a, d); },
+                                 [](double a, double) { return std::tan(a); });
+    this->CheckOperation<TPixel>("Atan", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Atan(a, d); },
+                                 [](double a, double) { return std::atan(a); });
+    this->CheckOperation<TPixel>("Cos", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Cos(a, d); },
+                                 [](double a, double) { return std::cos(a); });
+    this->CheckOperation<TPixel>("Acos", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Acos(a, d); },
+                                 [](double a, double) { return std::acos(a); });
+    this->CheckOperation<TPixel>("Sin", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Sin(a, d); },
+                                 [](double a, double) { return std::sin(a); });
+    this->CheckOperation<TPixel>("Asin", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Asin(a, d); },
+                                 [](double a, double) { return std::asin(a); });
+    this->CheckOperation<TPixel>("Square", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Square(a, d); },
+                                 [](double a, double) { return a * a; });
+    this->CheckOperation<TPixel>("Sqrt", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Sqrt(a, d); },
+                                 [](double a, double) { return std::sqrt(a); });
+    this->CheckOperation<TPixel>("Abs", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Abs(a, d); },
+                                 [](double a, double) { return std::abs(a); });
+    this->CheckOperation<TPixel>("Exp", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Exp(a, d); },
+                                 [](double a, double) { return std::exp(a); });
+    this->CheckOperation<TPixel>("ExpNeg", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::ExpNeg(a, d); },
+                                 [](double a, double) { return std::exp(-a); });
+    this->CheckOperation<TPixel>("Log10", [](Pointer &a, Pointer &, bool d) { return ArithmeticOperation::Log10(a, d); },
+                                 [](double a, double) { return std::log10(a); });
+  }
+
+public:
+  void TwoImageOperations_Integer() { this->CheckTwoImageOperations<int>(); }
+  void TwoImageOperations_Double() { this->CheckTwoImageOperations<double>(); }
+
+  void ImageAndValueOperations_Integer() { this->CheckImageAndValueOperations<int>(); }
+  void ImageAndValueOperations_Double() { this->CheckImageAndValueOperations<double>(); }
+
+  void ValueAndImageOperations_Integer() { this->CheckValueAndImageOperations<int>(); }
+  void ValueAndImageOperations_Double() { this->CheckValueAndImageOperations<double>(); }
+
+  void UnaryOperations_Integer() { this->CheckUnaryOperations<int>(); }
+  void UnaryOperations_Double() { this->CheckUnaryOperations<double>(); }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkArithmeticOperation)
@@ -21,6 +21,7 @@ found in the LICENSE file.
 
 #include <mitkCommandLineParser.h>
 
+#include <mitkGlobalImageFeatureCache.h>
 #include <mitkIntensityQuantifier.h>
 
 // STD Includes
@@ -233,6 +234,11 @@ public:
   itkSetMacro(IgnoreMask, bool);
   itkGetConstMacro(IgnoreMask, bool);
 
+  /** Cache that is shared with other feature classes calculated for the same image. It is only used
+  * if the features are calculated for the image of the cache, otherwise each calculation uses its own.*/
+  itkSetObjectMacro(Cache, GlobalImageFeatureCache);
+  itkGetObjectMacro(Cache, GlobalImageFeatureCache);
+
   itkSetMacro(EncodeParametersInFeaturePrefix, bool);
   itkGetConstMacro(EncodeParametersInFeaturePrefix, bool);
   itkBooleanMacro(EncodeParametersInFeaturePrefix);
@@ -267,6 +273,9 @@ protected:
   * This method will be called by SetParameters(...) after ConfigureQuantifierSettingsByParameters() was called.*/
   virtual void ConfigureSettingsByParameters(const ParametersType& parameters);
 
+  /** Returns the shared cache if it belongs to the passed image, otherwise a new cache for the image.*/
+  GlobalImageFeatureCache::Pointer GetCacheForImage(const Image* image);
+
   /**Initializes the quantifier gigen the quantifier relevant variables and the passed arguments.*/
   void InitializeQuantifier(const Image* image, const Image* mask, unsigned int defaultBins = 256);
 
@@ -319,6 +328,7 @@ private:
 
 
   IntensityQuantifier::Pointer m_Quantifier;
+  GlobalImageFeatureCache::Pointer m_Cache;
   //Quantifier relevant variables
   double m_MinimumIntensity = 0;
   bool m_UseMinimumIntensity = false;
@@ -337,6 +347,17 @@ private:
 //#endif // Skip Doxygen
 
 };
+
+  /** Calculates the passed feature classes for the same image and appends their features to the feature list.
+  * The feature classes share one GlobalImageFeatureCache and are calculated concurrently by up to numberOfThreads
+  * threads (0: ITK default). The features are appended in the order of the feature classes, independent of the
+  * number of threads. Each feature class instance must only be passed once.
+  * @param checkParameterActivation see AbstractGlobalImageFeature::CalculateAndAppendFeatures
+  */
+  MITKCLCORE_EXPORT void CalculateAndAppendFeatures(const std::vector<AbstractGlobalImageFeature::Pointer>& featureClasses,
+                                                    const Image* image, const Image* mask, const Image* maskNoNaN,
+                                                    AbstractGlobalImageFeature::FeatureListType& featureList,
+                                                    bool checkParameterActivation = true, unsigned int numberOfThreads = 0);
 }
 
 #endif
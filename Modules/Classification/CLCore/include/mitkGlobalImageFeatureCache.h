@@ -0,0 +1,156 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+
+#ifndef mitkGlobalImageFeatureCache_h
+#define mitkGlobalImageFeatureCache_h
+
+#include <MitkCLCoreExports.h>
+
+#include <mitkImage.h>
+#include <mitkImageCast.h>
+
+#include <itkObject.h>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace mitk
+{
+  /**
+  * \brief Shares the intermediate results that all global image feature classes derive from the same image.
+  *
+  * Each feature class initializes its quantifier by searching the intensity range of the (masked) image
+  * and converts the mask into an ITK image before walking over it. If several feature classes are
+  * calculated for the same image, they can share one cache (see AbstractGlobalImageFeature::SetCache())
+  * so that this is done only once per mask, regardless of the number of feature classes.
+  *
+  * The cache holds a reference to the image and to all masks it was asked for. Neither of them may be
+  * modified while the cache is in use. All methods are thread-safe and the returned ITK images are
+  * shared between the callers, so they must not be modified either.
+  */
+  class MITKCLCORE_EXPORT GlobalImageFeatureCache : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(GlobalImageFeatureCache, itk::Object);
+    mitkNewMacro1Param(Self, const Image*);
+
+    const Image* GetImage() const;
+
+    /** Minimum and maximum intensity of the whole image.*/
+    void GetIntensityRange(double& minimum, double& maximum);
+
+    /** Minimum and maximum intensity of all voxels inside the mask.*/
+    void GetIntensityRange(const Image* mask, double& minimum, double& maximum);
+
+    /** Index range of the voxels inside the mask, in the geometry of the mask.
+    * If the mask is empty, the returned region is empty.*/
+    template <unsigned int VImageDimension>
+    itk::ImageRegion<VImageDimension> GetMaskRegion(const Image* mask)
+    {
+      const auto* itkMask = this->GetItkMask<VImageDimension>(mask);
+      auto entry = this->GetMaskEntry(mask);
+      std::call_once(entry->RegionFlag, [&]() {
+        entry->RegionLower.fill(0);
+        entry->RegionUpper.fill(-1);
+        ComputeMaskRegion<VImageDimension>(itkMask, entry->RegionLower, entry->RegionUpper);
+      });
+
+      itk::ImageRegion<VImageDimension> region;
+      for (unsigned int i = 0; i < VImageDimension; ++i)
+      {
+        region.SetIndex(i, entry->RegionLower[i]);
+        region.SetSize(i, entry->RegionUpper[i] < entry->RegionLower[i] ? 0 : entry->RegionUpper[i] - entry->RegionLower[i] + 1);
+      }
+      return region;
+    }
+
+    /** The mask as ITK image with the pixel type used by the feature classes.*/
+    template <unsigned int VImageDimension>
+    const itk::Image<unsigned short, VImageDimension>* GetItkMask(const Image* mask)
+    {
+      static_assert(VImageDimension < MaximumDimension, "Unsupported image dimension");
+      using MaskType = itk::Image<unsigned short, VImageDimension>;
+
+      auto entry = this->GetMaskEntry(mask);
+      std::call_once(entry->ItkMaskFlags[VImageDimension], [&]() {
+        typename MaskType::Pointer itkMask = MaskType::New();
+        CastToItkImage(mask, itkMask);
+        entry->ItkMasks[VImageDimension] = itkMask.GetPointer();
+      });
+      return static_cast<const MaskType*>(entry->ItkMasks[VImageDimension].GetPointer());
+    }
+
+  protected:
+    explicit GlobalImageFeatureCache(const Image* image);
+    ~GlobalImageFeatureCache() override;
+
+  private:
+    static constexpr unsigned int MaximumDimension = 5;
+
+    struct IntensityRange
+    {
+      std::once_flag Flag;
+      double Minimum = 0;
+      double Maximum = 0;
+    };
+
+    struct MaskEntry
+    {
+      Image::ConstPointer Mask;
+      IntensityRange Range;
+      std::array<std::once_flag, MaximumDimension> ItkMaskFlags;
+      std::array<itk::DataObject::Pointer, MaximumDimension> ItkMasks;
+      std::once_flag RegionFlag;
+      std::array<itk::IndexValueType, MaximumDimension> RegionLower;
+      std::array<itk::IndexValueType, MaximumDimension> RegionUpper;
+    };
+
+    std::shared_ptr<MaskEntry> GetMaskEntry(const Image* mask);
+
+    template <unsigned int VImageDimension>
+    static void ComputeMaskRegion(const itk::Image<unsigned short, VImageDimension>* itkMask,
+                                  std::array<itk::IndexValueType, MaximumDimension>& lower,
+                                  std::array<itk::IndexValueType, MaximumDimension>& upper)
+    {
+      const auto region = itkMask->GetBufferedRegion();
+      const auto* buffer = itkMask->GetBufferPointer();
+      const auto numberOfPixels = region.GetNumberOfPixels();
+      bool isEmpty = true;
+
+      for (itk::SizeValueType offset = 0; offset < numberOfPixels; ++offset)
+      {
+        if (buffer[offset] == 0)
+          continue;
+
+        const auto index = itkMask->ComputeIndex(static_cast<itk::OffsetValueType>(offset));
+        for (unsigned int i = 0; i < VImageDimension; ++i)
+        {
+          lower[i] = isEmpty ? index[i] : std::min(lower[i], index[i]);
+          upper[i] = isEmpty ? index[i] : std::max(upper[i], index[i]);
+        }
+        isEmpty = false;
+      }
+    }
+
+    Image::ConstPointer m_Image;
+    IntensityRange m_ImageRange;
+
+    std::mutex m_MaskEntriesMutex;
+    std::map<const Image*, std::shared_ptr<MaskEntry>> m_MaskEntries;
+  };
+}
+
+#endif
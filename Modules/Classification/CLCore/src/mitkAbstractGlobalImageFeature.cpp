@@ -14,6 +14,9 @@ found in the LICENSE file.
 
 #include <mitkImageCast.h>
 #include <mitkITKImageImport.h>
+
+#include <itkMultiThreaderBase.h>
+
 #include <iterator>
 
 
@@ -253,8 +256,21 @@ void mitk::AbstractGlobalImageFeature::ConfigureSettingsByParameters(const Param
   //Override to change behavior.
 }
 
+mitk::GlobalImageFeatureCache::Pointer mitk::AbstractGlobalImageFeature::GetCacheForImage(const Image* image)
+{
+  if (m_Cache.IsNotNull() && m_Cache->GetImage() == image)
+    return m_Cache;
+  return GlobalImageFeatureCache::New(image);
+}
+
 void  mitk::AbstractGlobalImageFeature::InitializeQuantifier(const Image* image, const Image* mask, unsigned int defaultBins)
 {
+  // The intensity ranges are taken from the cache, which yields the same
+  // quantifier as the corresponding InitializeByImage... methods.
+  auto cache = this->GetCacheForImage(image);
+  double minimum = 0;
+  double maximum = 0;
+
   m_Quantifier = IntensityQuantifier::New();
   if (GetUseMinimumIntensity() && GetUseMaximumIntensity() && GetUseBinsize())
     m_Quantifier->InitializeByBinsizeAndMaximum(GetMinimumIntensity(), GetMaximumIntensity(), GetBinsize());
@@ -263,38 +279,47 @@ void  mitk::AbstractGlobalImageFeature::InitializeQuantifier(const Image* image,
   else if (GetUseMinimumIntensity() && GetUseMaximumIntensity() && GetUseBins())
     m_Quantifier->InitializeByMinimumMaximum(GetMinimumIntensity(), GetMaximumIntensity(), GetBins());
   // Intialize from Image and Binsize
-  else if (GetUseBinsize() && GetIgnoreMask() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageAndBinsizeAndMinimum(image, GetMinimumIntensity(), GetBinsize());
-  else if (GetUseBinsize() && GetIgnoreMask() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageAndBinsizeAndMaximum(image, GetMaximumIntensity(), GetBinsize());
   else if (GetUseBinsize() && GetIgnoreMask())
-    m_Quantifier->InitializeByImageAndBinsize(image, GetBinsize());
+  {
+    cache->GetIntensityRange(minimum, maximum);
+    if (GetUseMinimumIntensity())
+      minimum = GetMinimumIntensity();
+    else if (GetUseMaximumIntensity())
+      maximum = GetMaximumIntensity();
+    m_Quantifier->InitializeByBinsizeAndMaximum(minimum, maximum, GetBinsize());
+  }
   // Initialize form Image, Mask and Binsize
-  else if (GetUseBinsize() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageRegionAndBinsizeAndMinimum(image, mask, GetMinimumIntensity(), GetBinsize());
-  else if (GetUseBinsize() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageRegionAndBinsizeAndMaximum(image, mask, GetMaximumIntensity(), GetBinsize());
   else if (GetUseBinsize())
-    m_Quantifier->InitializeByImageRegionAndBinsize(image, mask, GetBinsize());
+  {
+    cache->GetIntensityRange(mask, minimum, maximum);
+    if (GetUseMinimumIntensity())
+      minimum = GetMinimumIntensity();
+    else if (GetUseMaximumIntensity())
+      maximum = GetMaximumIntensity();
+    m_Quantifier->InitializeByBinsizeAndMaximum(minimum, maximum, GetBinsize());
+  }
   // Intialize from Image and Bins
   else if (GetUseBins() && GetIgnoreMask() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageAndMinimum(image, GetMinimumIntensity(), GetBins());
+  {
+    cache->GetIntensityRange(minimum, maximum);
+    m_Quantifier->InitializeByMinimumMaximum(GetMinimumIntensity(), maximum, GetBins());
+  }
   else if (GetUseBins() && GetIgnoreMask() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageAndMaximum(image, GetMaximumIntensity(), GetBins());
-  else if (GetUseBins())
-    m_Quantifier->InitializeByImage(image, GetBins());
-  // Intialize from Image, Mask and Bins
-  else if (GetUseBins() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageRegionAndMinimum(image, mask, GetMinimumIntensity(), GetBins());
-  else if (GetUseBins() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageRegionAndMaximum(image, mask, GetMaximumIntensity(), GetBins());
-  else if (GetUseBins())
-    m_Quantifier->InitializeByImageRegion(image, mask, GetBins());
+  {
+    cache->GetIntensityRange(minimum, maximum);
+    m_Quantifier->InitializeByMinimumMaximum(minimum, GetMaximumIntensity(), GetBins());
+  }
+  else if (GetUseBins() || GetIgnoreMask())
+  {
+    cache->GetIntensityRange(minimum, maximum);
+    m_Quantifier->InitializeByMinimumMaximum(minimum, maximum, GetBins());
+  }
   // Default
-  else if (GetIgnoreMask())
-    m_Quantifier->InitializeByImage(image, GetBins());
   else
-    m_Quantifier->InitializeByImageRegion(image, mask, defaultBins);
+  {
+    cache->GetIntensityRange(mask, minimum, maximum);
+    m_Quantifier->InitializeByMinimumMaximum(minimum, maximum, defaultBins);
+  }
 }
 
 std::string mitk::AbstractGlobalImageFeature::GenerateLegacyFeatureName(const FeatureID& id) const
@@ -493,6 +518,39 @@ void mitk::AbstractGlobalImageFeature::CalculateAndAppendFeatures(const Image* i
   }
 }
 
+void mitk::CalculateAndAppendFeatures(const std::vector<AbstractGlobalImageFeature::Pointer>& featureClasses,
+                                      const Image* image, const Image* mask, const Image* maskNoNaN,
+                                      AbstractGlobalImageFeature::FeatureListType& featureList,
+                                      bool checkParameterActivation, unsigned int numberOfThreads)
+{
+  auto cache = GlobalImageFeatureCache::New(image);
+  std::vector<AbstractGlobalImageFeature::FeatureListType> results(featureClasses.size());
+
+  auto calculate = [&](itk::SizeValueType index) {
+    featureClasses[index]->SetCache(cache);
+    featureClasses[index]->CalculateAndAppendFeatures(image, mask, maskNoNaN, results[index], checkParameterActivation);
+    featureClasses[index]->SetCache(nullptr);
+  };
+
+  if (numberOfThreads == 1 || featureClasses.size() < 2)
+  {
+    for (std::size_t index = 0; index < featureClasses.size(); ++index)
+      calculate(index);
+  }
+  else
+  {
+    auto multiThreader = itk::MultiThreaderBase::New();
+    if (numberOfThreads > 0)
+      multiThreader->SetMaximumNumberOfThreads(numberOfThreads);
+    // One work unit per feature class, the feature classes differ a lot in their runtime
+    multiThreader->SetNumberOfWorkUnits(static_cast<itk::ThreadIdType>(featureClasses.size()));
+    multiThreader->ParallelizeArray(0, featureClasses.size(), calculate, nullptr);
+  }
+
+  for (const auto& result : results)
+    featureList.insert(featureList.end(), result.begin(), result.end());
+}
+
 mitk::AbstractGlobalImageFeature::FeatureListType mitk::AbstractGlobalImageFeature::CalculateFeatures(const Image* image, const Image* mask)
 {
   auto result = this->DoCalculateFeatures(image, mask);
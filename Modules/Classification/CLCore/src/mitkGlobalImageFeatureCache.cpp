@@ -0,0 +1,65 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkGlobalImageFeatureCache.h>
+
+// MITK
+#include <mitkImageAccessByItk.h>
+#include "mitkImageMinMaxHelper.h"
+
+mitk::GlobalImageFeatureCache::GlobalImageFeatureCache(const Image* image)
+  : m_Image(image)
+{
+  if (nullptr == image)
+    mitkThrow() << "GlobalImageFeatureCache requires an image.";
+}
+
+mitk::GlobalImageFeatureCache::~GlobalImageFeatureCache() = default;
+
+const mitk::Image* mitk::GlobalImageFeatureCache::GetImage() const
+{
+  return m_Image;
+}
+
+void mitk::GlobalImageFeatureCache::GetIntensityRange(double& minimum, double& maximum)
+{
+  std::call_once(m_ImageRange.Flag, [this]() {
+    AccessByItk_2(m_Image, CalculateImageMinMax, m_ImageRange.Minimum, m_ImageRange.Maximum);
+  });
+  minimum = m_ImageRange.Minimum;
+  maximum = m_ImageRange.Maximum;
+}
+
+void mitk::GlobalImageFeatureCache::GetIntensityRange(const Image* mask, double& minimum, double& maximum)
+{
+  auto entry = this->GetMaskEntry(mask);
+  std::call_once(entry->Range.Flag, [this, mask, &entry]() {
+    AccessByItk_3(m_Image, CalculateImageRegionMinMax, mask, entry->Range.Minimum, entry->Range.Maximum);
+  });
+  minimum = entry->Range.Minimum;
+  maximum = entry->Range.Maximum;
+}
+
+std::shared_ptr<mitk::GlobalImageFeatureCache::MaskEntry> mitk::GlobalImageFeatureCache::GetMaskEntry(const Image* mask)
+{
+  if (nullptr == mask)
+    mitkThrow() << "GlobalImageFeatureCache requires a mask.";
+
+  std::lock_guard<std::mutex> lock(m_MaskEntriesMutex);
+  auto& entry = m_MaskEntries[mask];
+  if (nullptr == entry)
+  {
+    entry = std::make_shared<MaskEntry>();
+    entry->Mask = mask;
+  }
+  return entry;
+}
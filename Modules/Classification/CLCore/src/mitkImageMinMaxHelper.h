@@ -0,0 +1,79 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkImageMinMaxHelper_h
+#define mitkImageMinMaxHelper_h
+
+// STD
+#include <algorithm>
+#include <limits>
+
+// ITK
+#include <itkImage.h>
+#include <itkImageRegionConstIterator.h>
+
+// MITK
+#include <mitkImage.h>
+#include <mitkImageCast.h>
+
+namespace mitk
+{
+  /** Intensity range of the whole image. Used by IntensityQuantifier and GlobalImageFeatureCache,
+  so that quantifiers initialized from the cache produce identical bins. */
+  template<typename TPixel, unsigned int VImageDimension>
+  void CalculateImageMinMax(const itk::Image<TPixel, VImageDimension>* itkImage, double &minimum, double &maximum)
+  {
+    typedef itk::Image<TPixel, VImageDimension> ImageType;
+
+    minimum = std::numeric_limits<TPixel>::max();
+    maximum = std::numeric_limits<TPixel>::lowest();
+
+    itk::ImageRegionConstIterator<ImageType> iter(itkImage, itkImage->GetLargestPossibleRegion());
+
+    while (!iter.IsAtEnd())
+    {
+      minimum = std::min<TPixel>(minimum, iter.Get());
+      maximum = std::max<TPixel>(maximum, iter.Get());
+      ++iter;
+    }
+  }
+
+  /** Intensity range of the image voxels inside the mask (mask value > 0). */
+  template<typename TPixel, unsigned int VImageDimension>
+  void CalculateImageRegionMinMax(const itk::Image<TPixel, VImageDimension>* itkImage, const mitk::Image* mask, double &minimum, double &maximum)
+  {
+    typedef itk::Image<TPixel, VImageDimension> ImageType;
+    typedef itk::Image<int, VImageDimension> MaskType;
+
+    typename MaskType::Pointer itkMask = MaskType::New();
+    mitk::CastToItkImage(mask, itkMask);
+
+    minimum = std::numeric_limits<TPixel>::max();
+    maximum = std::numeric_limits<TPixel>::lowest();
+
+    itk::ImageRegionConstIterator<ImageType> iter(itkImage, itkImage->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<MaskType> maskIter(itkMask, itkMask->GetLargestPossibleRegion());
+
+    while (!iter.IsAtEnd())
+    {
+      if (maskIter.Get() > 0)
+      {
+        minimum = std::min<TPixel>(minimum, iter.Get());
+        maximum = std::max<TPixel>(maximum, iter.Get());
+      }
+      ++iter;
+      ++maskIter;
+    }
+  }
+}
+
+#endif
@@ -15,59 +15,9 @@ found in the LICENSE file.
 // STD
 #include <numeric>
 
-// ITK
-#include <itkImageRegionConstIterator.h>
-
 // MITK
-#include <mitkImageCast.h>
 #include <mitkImageAccessByItk.h>
-
-template<typename TPixel, unsigned int VImageDimension>
-static void
-CalculateImageMinMax(const itk::Image<TPixel, VImageDimension>* itkImage, double &minimum, double &maximum)
-{
-  typedef itk::Image<TPixel, VImageDimension> ImageType;
-
-  minimum = std::numeric_limits<TPixel>::max();
-  maximum = std::numeric_limits<TPixel>::lowest();
-
-  itk::ImageRegionConstIterator<ImageType> iter(itkImage, itkImage->GetLargestPossibleRegion());
-
-  while (!iter.IsAtEnd())
-  {
-    minimum = std::min<TPixel>(minimum, iter.Get());
-    maximum = std::max<TPixel>(maximum, iter.Get());
-    ++iter;
-  }
-}
-
-template<typename TPixel, unsigned int VImageDimension>
-static void
-CalculateImageRegionMinMax(const itk::Image<TPixel, VImageDimension>* itkImage, const mitk::Image* mask, double &minimum, double &maximum)
-{
-  typedef itk::Image<TPixel, VImageDimension> ImageType;
-  typedef itk::Image<int, VImageDimension> MaskType;
-
-  typename MaskType::Pointer itkMask = MaskType::New();
-  mitk::CastToItkImage(mask, itkMask);
-
-  minimum = std::numeric_limits<TPixel>::max();
-  maximum = std::numeric_limits<TPixel>::lowest();
-
-  itk::ImageRegionConstIterator<ImageType> iter(itkImage, itkImage->GetLargestPossibleRegion());
-  itk::ImageRegionConstIterator<MaskType> maskIter(itkMask, itkMask->GetLargestPossibleRegion());
-
-  while (!iter.IsAtEnd())
-  {
-    if (maskIter.Get() > 0)
-    {
-      minimum = std::min<TPixel>(minimum, iter.Get());
-      maximum = std::max<TPixel>(maximum, iter.Get());
-    }
-    ++iter;
-    ++maskIter;
-  }
-}
+#include "mitkImageMinMaxHelper.h"
 
 mitk::IntensityQuantifier::IntensityQuantifier() :
       m_Initialized(false),
@@ -47,6 +47,7 @@ found in the LICENSE file.
 #include <mitkCLResultXMLWriter.h>
 #include <mitkVersion.h>
 
+#include <algorithm>
 #include <iostream>
 #include <locale>
 
@@ -414,6 +415,7 @@ int main(int argc, char* argv[])
   parser.addArgument("description","d",mitkCommandLineParser::String,"Text","Description that is added to the output",us::Any());
   parser.addArgument("direction", "dir", mitkCommandLineParser::String, "Int", "Allows to specify the direction for Cooc and RL. 0: All directions, 1: Only single direction (Test purpose), 2,3,4... Without dimension 0,1,2... ", us::Any());
   parser.addArgument("slice-wise", "slice", mitkCommandLineParser::String, "Int", "Allows to specify if the image is processed slice-wise (number giving direction) ", us::Any());
+  parser.addArgument("threads", "t", mitkCommandLineParser::Int, "Int", "Number of feature classes that are calculated concurrently. 0: (Default) number of processor cores; 1: sequential calculation", us::Any());
   parser.addArgument("output-mode", "omode", mitkCommandLineParser::Int, "Int", "Defines the format of the output. 0: (Default) results of an image / slice are written in a single row;"
     " 1: results of an image / slice are written in a single column; 2: store the result of on image as structured radiomocs report (XML).");
 
@@ -548,6 +550,12 @@ int main(int argc, char* argv[])
     }
   }
 
+  unsigned int numberOfThreads = 0;
+  if (parsedArgs.count("threads"))
+  {
+    numberOfThreads = std::max(0, us::any_cast<int>(parsedArgs["threads"]));
+  }
+
   int direction = 0;
   if (parsedArgs.count("direction"))
   {
@@ -674,8 +682,10 @@ int main(int argc, char* argv[])
     {
       log << " Calculating " << cFeature->GetFeatureClassName() << " -";
       cFeature->SetMorphMask(cMorphMask);
-      cFeature->CalculateAndAppendFeatures(cImage, cMask, cMaskNoNaN, stats, !param.calculateAllFeatures);
     }
+    // The feature classes share the quantification of the image and run concurrently,
+    // the features are nevertheless listed in the order of the feature classes.
+    mitk::CalculateAndAppendFeatures(features, cImage, cMask, cMaskNoNaN, stats, !param.calculateAllFeatures, numberOfThreads);
 
     for (std::size_t i = 0; i < stats.size(); ++i)
     {
@@ -19,7 +19,10 @@ found in the LICENSE file.
 #include <itkImageRegionIterator.h>
 #include <itkImageIterator.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <limits>
+#include <vector>
 
 #include "itkImageScanlineIterator.h"
 #include "itkProgressReporter.h"
@@ -225,21 +228,16 @@ namespace itk
       regionSize[i] = offset;
     }
 
+    // Offsets of all voxels of the neighbourhood that are closer to the center than the range
+    typedef typename TInputImage::OffsetType OffsetType;
     itk::ConstNeighborhoodIterator<TInputImage> iter(regionSize, itkImage, outputRegionForThread);
-    itk::ConstNeighborhoodIterator<MaskImageType> iterMask(regionSize, itkMask, outputRegionForThread);
 
     typename TInputImage::PointType origin;
     typename TInputImage::PointType localPoint;
-    itk::Index<TInputImage::ImageDimension> index;
-
-    double tmpPeakValue;
-    double globalPeakValue = std::numeric_limits<double>::lowest();
-    double localPeakValue = std::numeric_limits<double>::lowest();
-    PixelType localMaximum = std::numeric_limits<PixelType>::lowest();
+    IndexType index = iter.GetIndex();
+    itkImage->TransformIndexToPhysicalPoint(index, origin);
 
     std::vector<bool> vectorIsInRange;
-    index = iter.GetIndex();
-    itkImage->TransformIndexToPhysicalPoint(index, origin);
     for (itk::SizeValueType i = 0; i < iter.Size(); ++i)
     {
       itkImage->TransformIndexToPhysicalPoint(iter.GetIndex(i), localPoint);
@@ -247,53 +245,114 @@ namespace itk
       vectorIsInRange.push_back((dist < range));
     }
 
-    int count = 0;
+    // When the sphere moves by one voxel along the first dimension, only voxels whose predecessor
+    // (leaving) or successor (entering) along this dimension is not part of the sphere change.
+    // Keeping a running sum over these voxels avoids visiting the complete sphere for each voxel.
+    OffsetType stepOffset;
+    stepOffset.Fill(0);
+    stepOffset[0] = 1;
+    auto isInRange = [&](const OffsetType &neighbourOffset) {
+      for (unsigned int dimension = 0; dimension < ImageDimension; ++dimension)
+      {
+        if (std::abs(neighbourOffset[dimension]) > static_cast<OffsetValueType>(regionSize[dimension]))
+          return false;
+      }
+      return static_cast<bool>(vectorIsInRange[iter.GetNeighborhoodIndex(neighbourOffset)]);
+    };
 
-    iter.NeedToUseBoundaryConditionOff();
-    iterMask.NeedToUseBoundaryConditionOff();
+    std::vector<OffsetType> sphereOffsets;
+    std::vector<OffsetType> leavingOffsets;
+    std::vector<OffsetType> enteringOffsets;
+    for (itk::SizeValueType i = 0; i < iter.Size(); ++i)
+    {
+      if (!vectorIsInRange[i])
+        continue;
+      OffsetType neighbourOffset = iter.GetOffset(i);
+      sphereOffsets.push_back(neighbourOffset);
+      if (!isInRange(neighbourOffset - stepOffset))
+        leavingOffsets.push_back(neighbourOffset);
+      if (!isInRange(neighbourOffset + stepOffset))
+        enteringOffsets.push_back(neighbourOffset);
+    }
+
+    const RegionType imageRegion = itkImage->GetLargestPossibleRegion();
+    const PixelType* imageBuffer = itkImage->GetBufferPointer();
+    double peakSum = 0;
+    int count = 0;
+    auto addVoxels = [&](const IndexType &center, const std::vector<OffsetType> &offsets, int sign) {
+      for (const auto &neighbourOffset : offsets)
+      {
+        auto localIndex = center + neighbourOffset;
+        if (imageRegion.IsInside(localIndex))
+        {
+          peakSum += sign * static_cast<double>(imageBuffer[itkImage->ComputeOffset(localIndex)]);
+          count += sign;
+        }
+      }
+    };
 
-    auto imageSize = itkImage->GetLargestPossibleRegion().GetSize();
-    unsigned int imageDimension = itkImage->GetImageDimension();
+    double tmpPeakValue;
+    double globalPeakValue = std::numeric_limits<double>::lowest();
+    double localPeakValue = std::numeric_limits<double>::lowest();
+    PixelType localMaximum = std::numeric_limits<PixelType>::lowest();
 
-    while (!iter.IsAtEnd())
+    // Lines along the first dimension are only processed between their first and last masked voxel.
+    const OffsetValueType lineLength = outputRegionForThread.GetSize(0);
+    const itk::SizeValueType numberOfLines = outputRegionForThread.GetNumberOfPixels() / std::max<itk::SizeValueType>(1, lineLength);
+    for (itk::SizeValueType line = 0; line < numberOfLines; ++line)
     {
-      if (iterMask.GetCenterPixel() > 0)
+      IndexType lineIndex = outputRegionForThread.GetIndex();
+      itk::SizeValueType remainder = line;
+      for (unsigned int dimension = 1; dimension < ImageDimension; ++dimension)
+      {
+        lineIndex[dimension] += static_cast<OffsetValueType>(remainder % outputRegionForThread.GetSize(dimension));
+        remainder /= outputRegionForThread.GetSize(dimension);
+      }
+
+      OffsetValueType first = lineLength;
+      OffsetValueType last = -1;
+      index = lineIndex;
+      for (OffsetValueType x = 0; x < lineLength; ++x)
       {
-        tmpPeakValue = 0;
-        count = 0;
-        for (itk::SizeValueType i = 0; i < iter.Size(); ++i)
+        index[0] = lineIndex[0] + x;
+        if (itkMask->GetPixel(index) > 0)
         {
-          if (vectorIsInRange[i])
-          {
-            auto localIndex = iter.GetIndex(i);
-            bool calculatePoint = true;
-            for (unsigned int dimension = 0; dimension < imageDimension; ++dimension)
-            {
-              calculatePoint &= (localIndex[dimension] < static_cast<signed int>(imageSize[dimension]));
-              calculatePoint &= (0 <= localIndex[dimension]);
-            }
-            if (calculatePoint)
-            {
-              tmpPeakValue += iter.GetPixel(i);
-              ++count;
-            }
-          }
+          first = std::min(first, x);
+          last = x;
         }
-        tmpPeakValue /= count;
-        globalPeakValue = std::max<double>(tmpPeakValue, globalPeakValue);
-        auto currentCenterPixelValue = iter.GetCenterPixel();
-        if (localMaximum == currentCenterPixelValue)
+      }
+
+      for (OffsetValueType x = first; x <= last; ++x)
+      {
+        index[0] = lineIndex[0] + x;
+        if (x == first)
         {
-          localPeakValue = std::max<double>(tmpPeakValue, localPeakValue);
+          peakSum = 0;
+          count = 0;
+          addVoxels(index, sphereOffsets, 1);
         }
-        else if (localMaximum < currentCenterPixelValue)
+        else
+        {
+          addVoxels(index - stepOffset, leavingOffsets, -1);
+          addVoxels(index, enteringOffsets, 1);
+        }
+
+        if (itkMask->GetPixel(index) > 0)
         {
-          localMaximum = currentCenterPixelValue;
-          localPeakValue = tmpPeakValue;
+          tmpPeakValue = peakSum / count;
+          globalPeakValue = std::max<double>(tmpPeakValue, globalPeakValue);
+          auto currentCenterPixelValue = itkImage->GetPixel(index);
+          if (localMaximum == currentCenterPixelValue)
+          {
+            localPeakValue = std::max<double>(tmpPeakValue, localPeakValue);
+          }
+          else if (localMaximum < currentCenterPixelValue)
+          {
+            localMaximum = currentCenterPixelValue;
+            localPeakValue = tmpPeakValue;
+          }
         }
       }
-      ++iterMask;
-      ++iter;
     }
 
     m_ThreadLocalMaximum[threadId] = localMaximum;
@@ -3,11 +3,12 @@
 
 #include <itkLocalStatisticFilter.h>
 
-#include <itkNeighborhoodIterator.h>
+#include <itkSlidingWindowNeighborhood.h>
 #include <itkImageRegionIterator.h>
 #include <itkImageIterator.h>
 #include "itkMinimumMaximumImageCalculator.h"
 
+#include <deque>
 #include <limits>
 
 template< class TInputImageType, class TOuputImageType>
@@ -39,8 +40,41 @@ template< class TInputImageType, class TOuputImageType>
 void
 itk::LocalStatisticFilter<TInputImageType, TOuputImageType>::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, ThreadIdType /*threadId*/)
 {
-  typedef itk::ImageRegionIterator<TInputImageType> IteratorType;
-  typedef itk::ConstNeighborhoodIterator<TInputImageType> ConstIteratorType;
+  typedef itk::ImageRegionIterator<TOuputImageType> IteratorType;
+  typedef itk::SlidingWindowNeighborhood<TInputImageType> SlidingWindowType;
+
+  // Minimum and maximum cannot be updated when a pixel leaves the window. Therefore the
+  // statistics are kept per plane of the window and combined for each voxel, which only
+  // needs one value per plane instead of one per pixel.
+  struct PlaneStatistics
+  {
+    double min;
+    double max;
+    double sum;
+    double squaredSum;
+    std::size_t count;
+  };
+
+  struct StatisticsAccumulator
+  {
+    std::deque<PlaneStatistics> planes;
+
+    void Clear() { planes.clear(); }
+    void AddPlane(const typename SlidingWindowType::PlaneType &plane)
+    {
+      PlaneStatistics statistics{ std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(), 0, 0, plane.size() };
+      for (const auto &pixel : plane)
+      {
+        double value = pixel;
+        statistics.min = std::min<double>(statistics.min, value);
+        statistics.max = std::max<double>(statistics.max, value);
+        statistics.sum += value;
+        statistics.squaredSum += value * value;
+      }
+      planes.push_back(statistics);
+    }
+    void RemovePlane(const typename SlidingWindowType::PlaneType &) { planes.pop_front(); }
+  };
 
   typename TInputImageType::SizeType size; size.Fill(m_Size);
   InputImagePointer input = this->GetInput(0);
@@ -50,7 +84,6 @@ itk::LocalStatisticFilter<TInputImageType, TOuputImageType>::ThreadedGenerateDat
     size[2] = 0;
   }
 
-//  MITK_INFO << "Creating output iterator";
   std::vector<IteratorType> iterVector;
   for (int i = 0; i < m_Bins; ++i)
   {
@@ -58,40 +91,38 @@ itk::LocalStatisticFilter<TInputImageType, TOuputImageType>::ThreadedGenerateDat
     iterVector.push_back(iter);
   }
 
-  ConstIteratorType inputIter(size, input, outputRegionForThread);
-  while (!inputIter.IsAtEnd())
-  {
-    for (int i = 0; i < m_Bins; ++i)
-    {
-      iterVector[i].Set(0);
-    }
-
+  StatisticsAccumulator statistics;
+  SlidingWindowType window(input, size);
+  window.Slide(outputRegionForThread, statistics, [&](const typename TInputImageType::IndexType &, const StatisticsAccumulator &accumulator) {
     double min = std::numeric_limits<double>::max();
     double max = std::numeric_limits<double>::lowest();
-    double mean = 0;
-    double std = 0;
+    double sum = 0;
+    double squaredSum = 0;
+    std::size_t count = 0;
 
-    for (unsigned int i = 0; i < inputIter.Size(); ++i)
+    for (const auto &plane : accumulator.planes)
     {
-      double value = inputIter.GetPixel(i);
-      min = std::min<double>(min, value);
-      max = std::max<double>(max, value);
-      mean += value / inputIter.Size();
-      std += (value*value) / inputIter.Size();
+      min = std::min<double>(min, plane.min);
+      max = std::max<double>(max, plane.max);
+      sum += plane.sum;
+      squaredSum += plane.squaredSum;
+      count += plane.count;
     }
 
-    iterVector[0].Value() = min;
-    iterVector[1].Value() = max;
-    iterVector[2].Value() = mean;
-    iterVector[3].Value() = std::sqrt(std - mean*mean);
-    iterVector[4].Value() = max-min;
+    double mean = sum / count;
+    double squaredMean = squaredSum / count;
+
+    iterVector[0].Set(min);
+    iterVector[1].Set(max);
+    iterVector[2].Set(mean);
+    iterVector[3].Set(std::sqrt(squaredMean - mean*mean));
+    iterVector[4].Set(max-min);
 
     for (int i = 0; i < m_Bins; ++i)
     {
       ++(iterVector[i]);
     }
-    ++inputIter;
-  }
+  });
 }
 
 template< class TInputImageType, class TOuputImageType>
@@ -15,7 +15,7 @@ found in the LICENSE file.
 
 #include <itkMultiHistogramFilter.h>
 
-#include <itkNeighborhoodIterator.h>
+#include <itkSlidingWindowNeighborhood.h>
 #include <itkImageRegionIterator.h>
 #include <itkImageIterator.h>
 #include "itkMinimumMaximumImageCalculator.h"
@@ -62,16 +62,41 @@ template< class TInputImageType, class TOuputImageType>
 void
 itk::MultiHistogramFilter<TInputImageType, TOuputImageType>::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, ThreadIdType /*threadId*/)
 {
-  double offset = m_Offset;// -3.0;
-  double delta = m_Delta;// 0.6;
+  typedef itk::ImageRegionIterator<TOuputImageType> IteratorType;
+  typedef itk::SlidingWindowNeighborhood<TInputImageType> SlidingWindowType;
 
-  typedef itk::ImageRegionIterator<TInputImageType> IteratorType;
-  typedef itk::ConstNeighborhoodIterator<TInputImageType> ConstIteratorType;
+  // Counts the pixels of the window per bin. Planes entering and leaving the window
+  // are added and subtracted, so the histogram never has to be rebuilt from scratch.
+  struct HistogramAccumulator
+  {
+    double offset;
+    double delta;
+    int bins;
+    std::vector<int> counts;
+
+    int GetBin(double value) const
+    {
+      value -= offset;
+      value /= delta;
+      auto pos = (int)(value);
+      return std::max(0, std::min(bins - 1, pos));
+    }
+    void Clear() { std::fill(counts.begin(), counts.end(), 0); }
+    void AddPlane(const typename SlidingWindowType::PlaneType &plane)
+    {
+      for (const auto &value : plane)
+        ++counts[GetBin(value)];
+    }
+    void RemovePlane(const typename SlidingWindowType::PlaneType &plane)
+    {
+      for (const auto &value : plane)
+        --counts[GetBin(value)];
+    }
+  };
 
   typename TInputImageType::SizeType size; size.Fill(m_Size);
   InputImagePointer input = this->GetInput(0);
 
-//  MITK_INFO << "Creating output iterator";
   std::vector<IteratorType> iterVector;
   for (int i = 0; i < m_Bins; ++i)
   {
@@ -79,30 +104,15 @@ itk::MultiHistogramFilter<TInputImageType, TOuputImageType>::ThreadedGenerateDat
     iterVector.push_back(iter);
   }
 
-  ConstIteratorType inputIter(size, input, outputRegionForThread);
-  while (!inputIter.IsAtEnd())
-  {
-    for (int i = 0; i < m_Bins; ++i)
-    {
-      iterVector[i].Set(0);
-    }
-
-    for (unsigned int i = 0; i < inputIter.Size(); ++i)
-    {
-      double value = inputIter.GetPixel(i);
-      value -=  offset;
-      value /= delta;
-      auto pos = (int)(value);
-      pos = std::max(0, std::min(m_Bins-1, pos));
-      iterVector[pos].Value() += 1;// (iterVector[pos].GetCenterPixel() + 1);
-    }
-
+  HistogramAccumulator histogram{ m_Offset, m_Delta, m_Bins, std::vector<int>(m_Bins, 0) };
+  SlidingWindowType window(input, size);
+  window.Slide(outputRegionForThread, histogram, [&](const typename TInputImageType::IndexType &, const HistogramAccumulator &accumulator) {
     for (int i = 0; i < m_Bins; ++i)
     {
+      iterVector[i].Set(accumulator.counts[i]);
       ++(iterVector[i]);
     }
-    ++inputIter;
-  }
+  });
 }
 
 template< class TInputImageType, class TOuputImageType>
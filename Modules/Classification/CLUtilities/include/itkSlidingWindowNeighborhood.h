@@ -0,0 +1,160 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef itkSlidingWindowNeighborhood_h
+#define itkSlidingWindowNeighborhood_h
+
+#include <itkImage.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace itk
+{
+  /** \brief Moves a rectangular neighborhood window along the lines of an image region and updates it incrementally.
+  *
+  * Filters that compute a voxelwise feature map usually evaluate the complete neighborhood of each voxel,
+  * i.e. (2r+1)^D pixels per voxel. This class walks the region line by line along the first image
+  * dimension instead. When the window moves by one voxel, only the plane of pixels leaving the window and
+  * the plane entering it are handed to an accumulator, which reduces the costs to 2*(2r+1)^(D-1) pixels
+  * per voxel. The accumulator has to provide the following methods:
+  *
+  * \code
+  * void Clear();                                       // Called at the start of each line
+  * void AddPlane(const std::vector<PixelType>& plane);    // Plane entering the window
+  * void RemovePlane(const std::vector<PixelType>& plane); // Oldest plane of the window
+  * \endcode
+  *
+  * Planes are always removed in the order they were added. Once the window is centered at a voxel,
+  * visitor(index, accumulator) is called. The voxels are visited in the order of an
+  * ImageRegionIterator, so output iterators can simply be advanced in the visitor.
+  *
+  * Pixels outside of the buffered region are replaced by the nearest pixel inside of it, like
+  * ConstNeighborhoodIterator does with its default ZeroFluxNeumannBoundaryCondition. The accumulator
+  * therefore sees exactly the pixels of a neighborhood iterator with the same radius.
+  *
+  * The object does not change while sliding, so the threads of a filter can share one instance
+  * as long as each of them uses its own accumulator and region.
+  */
+  template <typename TImage>
+  class SlidingWindowNeighborhood
+  {
+  public:
+    typedef typename TImage::PixelType   PixelType;
+    typedef typename TImage::IndexType   IndexType;
+    typedef typename TImage::SizeType    SizeType;
+    typedef typename TImage::RegionType  RegionType;
+    typedef std::vector<PixelType>       PlaneType;
+
+    static constexpr unsigned int ImageDimension = TImage::ImageDimension;
+
+    SlidingWindowNeighborhood(const TImage* image, const SizeType& radius)
+      : m_Image(image), m_Radius(radius)
+    {
+    }
+
+    template <typename TAccumulator, typename TVisitor>
+    void Slide(const RegionType& region, TAccumulator& accumulator, TVisitor visitor) const
+    {
+      const SizeValueType numberOfPixels = region.GetNumberOfPixels();
+      if (numberOfPixels == 0)
+        return;
+
+      const RegionType bufferedRegion = m_Image->GetBufferedRegion();
+      const PixelType* buffer = m_Image->GetBufferPointer();
+      const OffsetValueType lowerX = bufferedRegion.GetIndex(0);
+      const OffsetValueType upperX = lowerX + static_cast<OffsetValueType>(bufferedRegion.GetSize(0)) - 1;
+      const OffsetValueType radiusX = static_cast<OffsetValueType>(m_Radius[0]);
+      const OffsetValueType lineLength = static_cast<OffsetValueType>(region.GetSize(0));
+      const SizeValueType numberOfLines = numberOfPixels / region.GetSize(0);
+
+      std::vector<OffsetValueType> planeOffsets;
+      PlaneType plane;
+
+      auto gatherPlane = [&](OffsetValueType x) {
+        const OffsetValueType clampedX = std::min(std::max(x, lowerX), upperX) - lowerX;
+        for (std::size_t i = 0; i < planeOffsets.size(); ++i)
+        {
+          plane[i] = buffer[planeOffsets[i] + clampedX];
+        }
+      };
+
+      for (SizeValueType line = 0; line < numberOfLines; ++line)
+      {
+        IndexType index = region.GetIndex();
+        SizeValueType remainder = line;
+        for (unsigned int d = 1; d < ImageDimension; ++d)
+        {
+          index[d] += static_cast<OffsetValueType>(remainder % region.GetSize(d));
+          remainder /= region.GetSize(d);
+        }
+
+        this->ComputePlaneOffsets(index, bufferedRegion, planeOffsets);
+        plane.resize(planeOffsets.size());
+
+        accumulator.Clear();
+        for (OffsetValueType x = index[0] - radiusX; x <= index[0] + radiusX; ++x)
+        {
+          gatherPlane(x);
+          accumulator.AddPlane(plane);
+        }
+        visitor(index, accumulator);
+
+        for (OffsetValueType step = 1; step < lineLength; ++step)
+        {
+          gatherPlane(index[0] - radiusX);
+          accumulator.RemovePlane(plane);
+          ++index[0];
+          gatherPlane(index[0] + radiusX);
+          accumulator.AddPlane(plane);
+          visitor(index, accumulator);
+        }
+      }
+    }
+
+  private:
+    // Buffer offsets of all pixels of a plane of the window centered at the given line, without the
+    // contribution of the first dimension. The order matches the one of ConstNeighborhoodIterator.
+    void ComputePlaneOffsets(const IndexType& lineIndex, const RegionType& bufferedRegion, std::vector<OffsetValueType>& planeOffsets) const
+    {
+      const OffsetValueType* offsetTable = m_Image->GetOffsetTable();
+
+      SizeValueType numberOfPlanePixels = 1;
+      for (unsigned int d = 1; d < ImageDimension; ++d)
+      {
+        numberOfPlanePixels *= 2 * m_Radius[d] + 1;
+      }
+      planeOffsets.resize(numberOfPlanePixels);
+
+      for (SizeValueType i = 0; i < numberOfPlanePixels; ++i)
+      {
+        OffsetValueType offset = 0;
+        SizeValueType remainder = i;
+        for (unsigned int d = 1; d < ImageDimension; ++d)
+        {
+          const SizeValueType width = 2 * m_Radius[d] + 1;
+          const OffsetValueType lower = bufferedRegion.GetIndex(d);
+          const OffsetValueType upper = lower + static_cast<OffsetValueType>(bufferedRegion.GetSize(d)) - 1;
+          const OffsetValueType position = lineIndex[d] + static_cast<OffsetValueType>(remainder % width) - static_cast<OffsetValueType>(m_Radius[d]);
+          offset += (std::min(std::max(position, lower), upper) - lower) * offsetTable[d];
+          remainder /= width;
+        }
+        planeOffsets[i] = offset;
+      }
+    }
+
+    const TImage* m_Image;
+    SizeType m_Radius;
+  };
+}
+
+#endif // itkSlidingWindowNeighborhood_h
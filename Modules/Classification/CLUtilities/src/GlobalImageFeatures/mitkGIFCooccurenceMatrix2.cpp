@@ -37,6 +37,7 @@ namespace mitk
     double MaximumIntensity;
     int Bins;
     FeatureID id;
+    GlobalImageFeatureCache::Pointer Cache;
   };
 
   struct CoocurenceMatrixHolder
@@ -213,6 +214,7 @@ template<typename TPixel, unsigned int VImageDimension>
 void
 CalculateCoOcMatrix(const itk::Image<TPixel, VImageDimension>* itkImage,
                     const itk::Image<unsigned short, VImageDimension>* mask,
+                    const itk::ImageRegion<VImageDimension>& maskRegion,
                     itk::Offset<VImageDimension> offset,
                     int range,
                     mitk::CoocurenceMatrixHolder &holder)
@@ -225,14 +227,20 @@ CalculateCoOcMatrix(const itk::Image<TPixel, VImageDimension>* itkImage,
   typedef itk::ImageRegionConstIterator<MaskImageType> ConstMaskIterType;
 
 
+  if (maskRegion.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
   itk::Size<VImageDimension> radius;
   radius.Fill(range+1);
-  ShapeIterType imageOffsetIter(radius, itkImage, itkImage->GetLargestPossibleRegion());
-  ShapeMaskIterType maskOffsetIter(radius, mask, mask->GetLargestPossibleRegion());
+  // Only the bounding box of the mask is visited, all other voxels are outside of the mask
+  ShapeIterType imageOffsetIter(radius, itkImage, maskRegion);
+  ShapeMaskIterType maskOffsetIter(radius, mask, maskRegion);
   imageOffsetIter.ActivateOffset(offset);
   maskOffsetIter.ActivateOffset(offset);
-  ConstIterType imageIter(itkImage, itkImage->GetLargestPossibleRegion());
-  ConstMaskIterType maskIter(mask, mask->GetLargestPossibleRegion());
+  ConstIterType imageIter(itkImage, maskRegion);
+  ConstMaskIterType maskIter(mask, maskRegion);
   //  iterator.GetIndex() + ci.GetNeighborhoodOffset()
   auto region = mask->GetLargestPossibleRegion();
 
@@ -432,8 +440,8 @@ CalculateCoocurenceFeatures(const itk::Image<TPixel, VImageDimension>* itkImage,
   double rangeMax = config.MaximumIntensity;
   int numberOfBins = config.Bins;
 
-  typename MaskType::Pointer maskImage = MaskType::New();
-  mitk::CastToItkImage(mask, maskImage);
+  const MaskType* maskImage = config.Cache->template GetItkMask<VImageDimension>(mask);
+  const auto maskRegion = config.Cache->template GetMaskRegion<VImageDimension>(mask);
 
   //Find possible directions
   std::vector < itk::Offset<VImageDimension> > offsetVector;
@@ -483,7 +491,7 @@ CalculateCoocurenceFeatures(const itk::Image<TPixel, VImageDimension>* itkImage,
     offset = offsetVector[i];
     mitk::CoocurenceMatrixHolder holder(rangeMin, rangeMax, numberOfBins);
     mitk::CoocurenceMatrixFeatures coocResults;
-    CalculateCoOcMatrix<TPixel, VImageDimension>(itkImage, maskImage, offset, config.range, holder);
+    CalculateCoOcMatrix<TPixel, VImageDimension>(itkImage, maskImage, maskRegion, offset, config.range, holder);
     holderOverall.m_Matrix += holder.m_Matrix;
     CalculateFeatures(holder, coocResults);
     resultVector.push_back(coocResults);
@@ -651,6 +659,7 @@ mitk::AbstractGlobalImageFeature::FeatureListType mitk::GIFCooccurenceMatrix2::D
   FeatureListType featureList;
 
   InitializeQuantifier(image, mask);
+  auto cache = this->GetCacheForImage(image);
 
   for (const auto& range: m_Ranges)
   {
@@ -663,6 +672,7 @@ mitk::AbstractGlobalImageFeature::FeatureListType mitk::GIFCooccurenceMatrix2::D
     config.MaximumIntensity = GetQuantifier()->GetMaximum();
     config.Bins = GetQuantifier()->GetBins();
     config.id = this->CreateTemplateFeatureID(std::to_string(range), { {GetOptionPrefix() + "::range", range} });
+    config.Cache = cache;
 
     AccessByItk_3(image, CalculateCoocurenceFeatures, mask, featureList, config);
 
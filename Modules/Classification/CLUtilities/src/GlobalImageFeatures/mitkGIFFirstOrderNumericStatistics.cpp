@@ -31,6 +31,7 @@ struct FirstOrderNumericParameterStruct {
   double MaximumIntensity;
   int Bins;
   mitk::FeatureID id;
+  mitk::GlobalImageFeatureCache::Pointer cache;
 };
 
 template<typename TPixel, unsigned int VImageDimension>
@@ -40,8 +41,7 @@ CalculateFirstOrderStatistics(const itk::Image<TPixel, VImageDimension>* itkImag
   typedef itk::Image<TPixel, VImageDimension>             ImageType;
   typedef itk::Image<unsigned short, VImageDimension>     MaskType;
 
-  typename MaskType::Pointer maskImage = MaskType::New();
-  mitk::CastToItkImage(mask, maskImage);
+  const MaskType* maskImage = params.cache->template GetItkMask<VImageDimension>(mask);
 
   //
   // Calculate the Volume of Voxel (Maximum to the 3th order)
@@ -321,6 +321,7 @@ mitk::AbstractGlobalImageFeature::FeatureListType mitk::GIFFirstOrderNumericStat
   params.MaximumIntensity = GetQuantifier()->GetMaximum();
   params.Bins = GetQuantifier()->GetBins();
   params.id = this->CreateTemplateFeatureID();
+  params.cache = this->GetCacheForImage(image);
   AccessByItk_3(image, CalculateFirstOrderStatistics, mask, featureList, params);
 
   MITK_INFO << "Finished calculating first order features....";
@@ -39,6 +39,7 @@ namespace mitk{
     double MaximumIntensity;
     int Bins;
     FeatureID id;
+    GlobalImageFeatureCache::Pointer Cache;
   };
 
   struct GreyLevelDistanceZoneMatrixHolder
@@ -367,8 +368,7 @@ CalculateGreyLevelDistanceZoneFeatures(const itk::Image<TPixel, VImageDimension>
   typename MaskType::Pointer distanceImage = MaskType::New();
   mitk::CastToItkImage(mitkDistanceImage, distanceImage);
 
-  typename MaskType::Pointer maskImage = MaskType::New();
-  mitk::CastToItkImage(mask, maskImage);
+  const MaskType* maskImage = config.Cache->template GetItkMask<VImageDimension>(mask);
 
   //Find possible directions
   std::vector < itk::Offset<VImageDimension> > offsetVector;
@@ -453,6 +453,7 @@ mitk::AbstractGlobalImageFeature::FeatureListType mitk::GIFGreyLevelDistanceZone
   config.Bins = GetQuantifier()->GetBins();
   config.id = this->CreateTemplateFeatureID();
   config.Quantifier = GetQuantifier();
+  config.Cache = this->GetCacheForImage(image);
 
   AccessByItk_3(image, CalculateGreyLevelDistanceZoneFeatures, mask, featureList, config);
 
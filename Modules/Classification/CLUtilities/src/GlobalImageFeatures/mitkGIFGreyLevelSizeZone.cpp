@@ -32,6 +32,7 @@ namespace mitk
     double MaximumIntensity;
     int Bins;
     FeatureID id;
+    GlobalImageFeatureCache::Pointer Cache;
   };
 
   struct GreyLevelSizeZoneMatrixHolder
@@ -157,6 +158,7 @@ template<typename TPixel, unsigned int VImageDimension>
 static int
 CalculateGlSZMatrix(const itk::Image<TPixel, VImageDimension>* itkImage,
                     const itk::Image<unsigned short, VImageDimension>* mask,
+                    const itk::ImageRegion<VImageDimension>& maskRegion,
                     std::vector<itk::Offset<VImageDimension> > offsets,
                     bool estimateLargestRegion,
                     mitk::GreyLevelSizeZoneMatrixHolder &holder)
@@ -173,8 +175,9 @@ CalculateGlSZMatrix(const itk::Image<TPixel, VImageDimension>* itkImage,
   newRegion.SetSize(region.GetSize());
   newRegion.SetIndex(region.GetIndex());
 
-  ConstIterType imageIter(itkImage, itkImage->GetLargestPossibleRegion());
-  ConstMaskIterType maskIter(mask, mask->GetLargestPossibleRegion());
+  // Zones can only start inside the bounding box of the mask
+  ConstIterType imageIter(itkImage, maskRegion);
+  ConstMaskIterType maskIter(mask, maskRegion);
 
   typename MaskImageType::Pointer visitedImage = MaskImageType::New();
   visitedImage->SetRegions(newRegion);
@@ -338,8 +341,8 @@ CalculateGreyLevelSizeZoneFeatures(const itk::Image<TPixel, VImageDimension>* it
   double rangeMax = config.MaximumIntensity;
   int numberOfBins = config.Bins;
 
-  typename MaskType::Pointer maskImage = MaskType::New();
-  mitk::CastToItkImage(mask, maskImage);
+  const MaskType* maskImage = config.Cache->template GetItkMask<VImageDimension>(mask);
+  const auto maskRegion = config.Cache->template GetMaskRegion<VImageDimension>(mask);
 
   //Find possible directions
   std::vector < itk::Offset<VImageDimension> > offsetVector;
@@ -375,10 +378,10 @@ CalculateGreyLevelSizeZoneFeatures(const itk::Image<TPixel, VImageDimension>* it
 
   std::vector<mitk::GreyLevelSizeZoneFeatures> resultVector;
   mitk::GreyLevelSizeZoneMatrixHolder tmpHolder(rangeMin, rangeMax, numberOfBins, 3);
-  int largestRegion = CalculateGlSZMatrix<TPixel, VImageDimension>(itkImage, maskImage, offsetVector, true, tmpHolder);
+  int largestRegion = CalculateGlSZMatrix<TPixel, VImageDimension>(itkImage, maskImage, maskRegion, offsetVector, true, tmpHolder);
   mitk::GreyLevelSizeZoneMatrixHolder holderOverall(rangeMin, rangeMax, numberOfBins,largestRegion);
   mitk::GreyLevelSizeZoneFeatures overallFeature;
-  CalculateGlSZMatrix<TPixel, VImageDimension>(itkImage, maskImage, offsetVector, false, holderOverall);
+  CalculateGlSZMatrix<TPixel, VImageDimension>(itkImage, maskImage, maskRegion, offsetVector, false, holderOverall);
   CalculateFeatures(holderOverall, overallFeature);
 
   MatrixFeaturesTo(overallFeature, config, featureList);
@@ -415,6 +418,7 @@ mitk::AbstractGlobalImageFeature::FeatureListType mitk::GIFGreyLevelSizeZone::Do
   config.MaximumIntensity = GetQuantifier()->GetMaximum();
   config.Bins = GetQuantifier()->GetBins();
   config.id = this->CreateTemplateFeatureID();
+  config.Cache = this->GetCacheForImage(image);
 
   AccessByItk_3(image, CalculateGreyLevelSizeZoneFeatures, mask, featureList, config);
 
@@ -30,6 +30,7 @@ namespace
   {
     mitk::IntensityQuantifier::Pointer quantifier;
     mitk::FeatureID id;
+    mitk::GlobalImageFeatureCache::Pointer cache;
   };
 
   template<typename TPixel, unsigned int VImageDimension>
@@ -38,8 +39,7 @@ namespace
     typedef itk::Image<TPixel, VImageDimension> ImageType;
     typedef itk::Image<unsigned short, VImageDimension> MaskType;
 
-    typename MaskType::Pointer itkMask = MaskType::New();
-    mitk::CastToItkImage(mask, itkMask);
+    const MaskType* itkMask = params.cache->template GetItkMask<VImageDimension>(mask);
 
     mitk::IntensityQuantifier::Pointer quantifier = params.quantifier;
 
@@ -138,6 +138,7 @@ mitk::AbstractGlobalImageFeature::FeatureListType mitk::GIFIntensityVolumeHistog
   GIFIntensityVolumeHistogramFeaturesParameters params;
   params.quantifier = GetQuantifier();
   params.id = this->CreateTemplateFeatureID();
+  params.cache = this->GetCacheForImage(image);
   AccessByItk_3(image, CalculateIntensityPeak, mask, params, featureList);
   MITK_INFO << "Finished calculating local intensity features....";
 
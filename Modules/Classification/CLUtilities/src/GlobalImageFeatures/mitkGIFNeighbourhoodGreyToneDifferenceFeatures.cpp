@@ -30,6 +30,7 @@ struct GIFNeighbourhoodGreyToneDifferenceParameter
   int Range = 1;
   mitk::IntensityQuantifier::Pointer quantifier;
   mitk::FeatureID id;
+  mitk::GlobalImageFeatureCache::Pointer cache;
 };
 
 template<typename TPixel, unsigned int VImageDimension>
@@ -39,8 +40,7 @@ CalculateIntensityPeak(const itk::Image<TPixel, VImageDimension>* itkImage, cons
   typedef itk::Image<TPixel, VImageDimension> ImageType;
   typedef itk::Image<unsigned short, VImageDimension> MaskType;
 
-  typename MaskType::Pointer itkMask = MaskType::New();
-  mitk::CastToItkImage(mask, itkMask);
+  const MaskType* itkMask = params.cache->template GetItkMask<VImageDimension>(mask);
 
   typename ImageType::SizeType regionSize;
   regionSize.Fill(params.Range);
@@ -177,6 +177,7 @@ mitk::AbstractGlobalImageFeature::FeatureListType mitk::GIFNeighbourhoodGreyTone
   params.Range = GetRange();
   params.quantifier = GetQuantifier();
   params.id = this->CreateTemplateFeatureID();
+  params.cache = this->GetCacheForImage(image);
 
   AccessByItk_3(image, CalculateIntensityPeak, mask, params, featureList);
 
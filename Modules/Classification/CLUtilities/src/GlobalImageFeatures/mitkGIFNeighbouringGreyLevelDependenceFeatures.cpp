@@ -36,6 +36,7 @@ struct GIFNeighbouringGreyLevelDependenceFeatureConfiguration
   double MaximumIntensity;
   int Bins;
   mitk::FeatureID id;
+  mitk::GlobalImageFeatureCache::Pointer Cache;
 };
 
 namespace mitk
@@ -199,6 +200,7 @@ template<typename TPixel, unsigned int VImageDimension>
 void
 CalculateNGLDMMatrix(const itk::Image<TPixel, VImageDimension>* itkImage,
                     const itk::Image<unsigned short, VImageDimension>* mask,
+                    const itk::ImageRegion<VImageDimension>& maskRegion,
                     int alpha,
                     int range,
                     unsigned int direction,
@@ -222,8 +224,14 @@ CalculateNGLDMMatrix(const itk::Image<TPixel, VImageDimension>* itkImage,
     radius[direction - 2] = 0;
   }
 
-  ShapeIterType imageIter(radius, itkImage, itkImage->GetLargestPossibleRegion());
-  ShapeMaskIterType maskIter(radius, mask, mask->GetLargestPossibleRegion());
+  if (maskRegion.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  // Only the bounding box of the mask is visited, all other voxels are outside of the mask
+  ShapeIterType imageIter(radius, itkImage, maskRegion);
+  ShapeMaskIterType maskIter(radius, mask, maskRegion);
 
   auto region = mask->GetLargestPossibleRegion();
 
@@ -399,8 +407,8 @@ CalculateCoocurenceFeatures(const itk::Image<TPixel, VImageDimension>* itkImage,
   double rangeMax = config.MaximumIntensity;
   int numberOfBins = config.Bins;
 
-  typename MaskType::Pointer maskImage = MaskType::New();
-  mitk::CastToItkImage(mask, maskImage);
+  const MaskType* maskImage = config.Cache->template GetItkMask<VImageDimension>(mask);
+  const auto maskRegion = config.Cache->template GetMaskRegion<VImageDimension>(mask);
 
   std::vector<mitk::NGLDMMatrixFeatures> resultVector;
   int numberofDependency = 37;
@@ -409,7 +417,7 @@ CalculateCoocurenceFeatures(const itk::Image<TPixel, VImageDimension>* itkImage,
 
   mitk::NGLDMMatrixHolder holderOverall(rangeMin, rangeMax, numberOfBins, numberofDependency);
   mitk::NGLDMMatrixFeatures overallFeature;
-  CalculateNGLDMMatrix<TPixel, VImageDimension>(itkImage, maskImage, config.alpha, config.range, config.direction, holderOverall);
+  CalculateNGLDMMatrix<TPixel, VImageDimension>(itkImage, maskImage, maskRegion, config.alpha, config.range, config.direction, holderOverall);
   LocalCalculateFeatures(holderOverall, overallFeature);
 
   MatrixFeaturesTo(overallFeature, config, featureList);
@@ -452,6 +460,7 @@ mitk::AbstractGlobalImageFeature::FeatureListType mitk::GIFNeighbouringGreyLevel
   FeatureListType featureList;
 
   this->InitializeQuantifier(image, mask);
+  auto cache = this->GetCacheForImage(image);
   for (const auto& range : m_Ranges)
   {
     MITK_INFO << "Start calculating NGLD with range " << range << "....";
@@ -465,6 +474,7 @@ mitk::AbstractGlobalImageFeature::FeatureListType mitk::GIFNeighbouringGreyLevel
     config.Bins = GetQuantifier()->GetBins();
 
     config.id = this->CreateTemplateFeatureID(std::to_string(range), { {GetOptionPrefix() + "::range", range} });
+    config.Cache = cache;
 
     AccessByItk_3(image, CalculateCoocurenceFeatures, mask, featureList, config);
     MITK_INFO << "Finished calculating NGLD with range " << range << "....";
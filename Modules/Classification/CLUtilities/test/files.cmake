@@ -13,4 +13,6 @@ set(MODULE_TESTS
   mitkGIFNeighbouringGreyLevelDependenceFeatureTest.cpp
   mitkGIFVolumetricDensityStatisticsTest.cpp
   mitkGIFVolumetricStatisticsTest.cpp
+  mitkGlobalImageFeatureCacheTest.cpp
+  mitkSlidingWindowNeighborhoodTest.cpp
 )
@@ -0,0 +1,151 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+#include "mitkIOUtil.h"
+#include <cmath>
+
+#include <mitkGlobalImageFeatureCache.h>
+#include <mitkGIFCooccurenceMatrix2.h>
+#include <mitkGIFFirstOrderNumericStatistics.h>
+#include <mitkGIFGreyLevelSizeZone.h>
+#include <mitkGIFNeighbouringGreyLevelDependenceFeatures.h>
+
+#include <itkImageRegionConstIteratorWithIndex.h>
+
+class mitkGlobalImageFeatureCacheTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkGlobalImageFeatureCacheTestSuite);
+
+  MITK_TEST(IntensityRange_EqualsQuantifier);
+  MITK_TEST(ItkMask_IsShared);
+  MITK_TEST(MaskRegion_IsBoundingBox);
+  MITK_TEST(ParallelCalculation_EqualsSequentialCalculation);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_IBSI_Phantom_Image_Large;
+  mitk::Image::Pointer m_IBSI_Phantom_Mask_Large;
+
+  std::vector<mitk::AbstractGlobalImageFeature::Pointer> CreateFeatureClasses()
+  {
+    std::vector<mitk::AbstractGlobalImageFeature::Pointer> featureClasses;
+    featureClasses.push_back(mitk::GIFFirstOrderNumericStatistics::New().GetPointer());
+    featureClasses.push_back(mitk::GIFCooccurenceMatrix2::New().GetPointer());
+    featureClasses.push_back(mitk::GIFNeighbouringGreyLevelDependenceFeature::New().GetPointer());
+    featureClasses.push_back(mitk::GIFGreyLevelSizeZone::New().GetPointer());
+
+    for (auto& featureClass : featureClasses)
+    {
+      featureClass->SetUseBinsize(true);
+      featureClass->SetBinsize(1.0);
+      featureClass->SetUseMinimumIntensity(true);
+      featureClass->SetMinimumIntensity(0.5);
+    }
+    return featureClasses;
+  }
+
+public:
+
+  void setUp(void) override
+  {
+    m_IBSI_Phantom_Image_Large = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Image_Large.nrrd"));
+    m_IBSI_Phantom_Mask_Large = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Mask_Large.nrrd"));
+  }
+
+  void IntensityRange_EqualsQuantifier()
+  {
+    auto cache = mitk::GlobalImageFeatureCache::New(m_IBSI_Phantom_Image_Large);
+    double minimum = 0;
+    double maximum = 0;
+
+    auto quantifier = mitk::IntensityQuantifier::New();
+    quantifier->InitializeByImage(m_IBSI_Phantom_Image_Large, 10);
+    cache->GetIntensityRange(minimum, maximum);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Minimum of the image", quantifier->GetMinimum(), minimum);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Maximum of the image", quantifier->GetMaximum(), maximum);
+
+    quantifier->InitializeByImageRegion(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large, 10);
+    cache->GetIntensityRange(m_IBSI_Phantom_Mask_Large, minimum, maximum);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Minimum inside the mask", quantifier->GetMinimum(), minimum);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Maximum inside the mask", quantifier->GetMaximum(), maximum);
+  }
+
+  void ItkMask_IsShared()
+  {
+    auto cache = mitk::GlobalImageFeatureCache::New(m_IBSI_Phantom_Image_Large);
+    auto itkMask = cache->GetItkMask<3>(m_IBSI_Phantom_Mask_Large);
+    CPPUNIT_ASSERT_MESSAGE("Mask is converted", nullptr != itkMask);
+    CPPUNIT_ASSERT_MESSAGE("Mask is converted only once", itkMask == cache->GetItkMask<3>(m_IBSI_Phantom_Mask_Large));
+  }
+
+  void MaskRegion_IsBoundingBox()
+  {
+    auto cache = mitk::GlobalImageFeatureCache::New(m_IBSI_Phantom_Image_Large);
+    auto itkMask = cache->GetItkMask<3>(m_IBSI_Phantom_Mask_Large);
+    auto region = cache->GetMaskRegion<3>(m_IBSI_Phantom_Mask_Large);
+
+    unsigned int voxelsInMask = 0;
+    unsigned int voxelsInRegion = 0;
+    itk::ImageRegionConstIteratorWithIndex<itk::Image<unsigned short, 3>> iter(itkMask, itkMask->GetLargestPossibleRegion());
+    for (; !iter.IsAtEnd(); ++iter)
+    {
+      if (iter.Get() > 0)
+      {
+        ++voxelsInMask;
+        if (region.IsInside(iter.GetIndex()))
+          ++voxelsInRegion;
+      }
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Mask is not empty", voxelsInMask > 0);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("All mask voxels are inside the region", voxelsInMask, voxelsInRegion);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      auto shrunkRegion = region;
+      shrunkRegion.SetSize(i, region.GetSize(i) - 1);
+      unsigned int voxelsInShrunkRegion = 0;
+      itk::ImageRegionConstIteratorWithIndex<itk::Image<unsigned short, 3>> shrunkIter(itkMask, shrunkRegion);
+      for (; !shrunkIter.IsAtEnd(); ++shrunkIter)
+        voxelsInShrunkRegion += shrunkIter.Get() > 0 ? 1 : 0;
+      CPPUNIT_ASSERT_MESSAGE("Region is the smallest bounding box", voxelsInShrunkRegion < voxelsInMask);
+    }
+  }
+
+  void ParallelCalculation_EqualsSequentialCalculation()
+  {
+    // Reference: every feature class on its own, without shared cache
+    mitk::AbstractGlobalImageFeature::FeatureListType expectedFeatures;
+    for (const auto& featureClass : this->CreateFeatureClasses())
+    {
+      featureClass->CalculateAndAppendFeatures(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large, m_IBSI_Phantom_Mask_Large, expectedFeatures, false);
+    }
+
+    for (unsigned int numberOfThreads : {1u, 4u})
+    {
+      mitk::AbstractGlobalImageFeature::FeatureListType features;
+      mitk::CalculateAndAppendFeatures(this->CreateFeatureClasses(), m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large, m_IBSI_Phantom_Mask_Large, features, false, numberOfThreads);
+
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Number of features", expectedFeatures.size(), features.size());
+      for (std::size_t i = 0; i < features.size(); ++i)
+      {
+        CPPUNIT_ASSERT_MESSAGE("Features are in the order of the feature classes", expectedFeatures[i].first == features[i].first);
+        const bool bothNaN = std::isnan(expectedFeatures[i].second) && std::isnan(features[i].second);
+        CPPUNIT_ASSERT_MESSAGE(features[i].first.legacyName, bothNaN || expectedFeatures[i].second == features[i].second);
+      }
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkGlobalImageFeatureCache)
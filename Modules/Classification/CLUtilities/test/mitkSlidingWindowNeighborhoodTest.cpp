@@ -0,0 +1,274 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+
+#include <itkConstNeighborhoodIterator.h>
+#include <itkImageRegionConstIterator.h>
+#include <itkImageRegionIterator.h>
+#include <itkLocalIntensityFilter.h>
+#include <itkLocalStatisticFilter.h>
+#include <itkMultiHistogramFilter.h>
+#include <itkSlidingWindowNeighborhood.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+class mitkSlidingWindowNeighborhoodTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkSlidingWindowNeighborhoodTestSuite);
+
+  MITK_TEST(Slide_VisitsNeighborhoodOfEachVoxel);
+  MITK_TEST(LocalStatisticFilter_EqualsFullNeighborhood);
+  MITK_TEST(MultiHistogramFilter_EqualsFullNeighborhood);
+  MITK_TEST(LocalIntensityFilter_EqualsFullNeighborhood);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<double, 3> ImageType;
+  typedef itk::Image<short, 3> ShortImageType;
+  typedef itk::Image<unsigned short, 3> MaskType;
+
+  ImageType::Pointer m_Image;
+  ShortImageType::Pointer m_ShortImage;
+  MaskType::Pointer m_Mask;
+
+  // Collects the sum of all pixels and the number of pixels of the window
+  struct SumAccumulator
+  {
+    double sum = 0;
+    std::size_t count = 0;
+
+    void Clear() { sum = 0; count = 0; }
+    void AddPlane(const std::vector<double> &plane)
+    {
+      for (auto value : plane)
+        sum += value;
+      count += plane.size();
+    }
+    void RemovePlane(const std::vector<double> &plane)
+    {
+      for (auto value : plane)
+        sum -= value;
+      count -= plane.size();
+    }
+  };
+
+  template <typename TImageType>
+  typename TImageType::Pointer CreateImage(double spacingX)
+  {
+    typename TImageType::SizeType size = {{23, 17, 9}};
+    typename TImageType::SpacingType spacing;
+    spacing[0] = spacingX;
+    spacing[1] = 1.0;
+    spacing[2] = 2.0;
+
+    auto image = TImageType::New();
+    image->SetRegions(typename TImageType::RegionType(size));
+    image->SetSpacing(spacing);
+    image->Allocate();
+    return image;
+  }
+
+public:
+
+  void setUp() override
+  {
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> intensity(-100, 100);
+    std::uniform_int_distribution<int> label(0, 3);
+
+    m_Image = CreateImage<ImageType>(1.0);
+    m_ShortImage = CreateImage<ShortImageType>(0.5);
+    m_Mask = CreateImage<MaskType>(0.5);
+
+    itk::ImageRegionIterator<ImageType> imageIter(m_Image, m_Image->GetLargestPossibleRegion());
+    itk::ImageRegionIterator<ShortImageType> shortImageIter(m_ShortImage, m_ShortImage->GetLargestPossibleRegion());
+    itk::ImageRegionIterator<MaskType> maskIter(m_Mask, m_Mask->GetLargestPossibleRegion());
+    for (; !imageIter.IsAtEnd(); ++imageIter, ++shortImageIter, ++maskIter)
+    {
+      imageIter.Set(intensity(generator) / 10.0);
+      shortImageIter.Set(intensity(generator));
+      maskIter.Set(label(generator) == 0 ? 1 : 0);
+    }
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+    m_ShortImage = nullptr;
+    m_Mask = nullptr;
+  }
+
+  void Slide_VisitsNeighborhoodOfEachVoxel()
+  {
+    ImageType::SizeType radius = {{3, 2, 1}};
+    ImageType::RegionType region = m_Image->GetLargestPossibleRegion();
+    region.SetIndex(1, 2);
+    region.SetSize(1, 10);
+
+    itk::ConstNeighborhoodIterator<ImageType> neighborhoodIter(radius, m_Image, region);
+    itk::SlidingWindowNeighborhood<ImageType> window(m_Image, radius);
+    SumAccumulator accumulator;
+    unsigned int numberOfVoxels = 0;
+    window.Slide(region, accumulator, [&](const ImageType::IndexType &index, const SumAccumulator &result) {
+      double expectedSum = 0;
+      for (unsigned int i = 0; i < neighborhoodIter.Size(); ++i)
+        expectedSum += neighborhoodIter.GetPixel(i);
+
+      CPPUNIT_ASSERT_MESSAGE("Voxels are visited in region order", index == neighborhoodIter.GetIndex());
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Window size", static_cast<std::size_t>(neighborhoodIter.Size()), result.count);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Window contains the neighborhood", expectedSum, result.sum, 1e-9);
+      ++neighborhoodIter;
+      ++numberOfVoxels;
+    });
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("All voxels are visited", static_cast<unsigned int>(region.GetNumberOfPixels()), numberOfVoxels);
+  }
+
+  void LocalStatisticFilter_EqualsFullNeighborhood()
+  {
+    typedef itk::LocalStatisticFilter<ImageType, ImageType> FilterType;
+    auto filter = FilterType::New();
+    filter->SetInput(m_Image);
+    filter->SetSize(3);
+    filter->Update();
+
+    ImageType::SizeType radius = {{3, 3, 0}};
+    itk::ConstNeighborhoodIterator<ImageType> neighborhoodIter(radius, m_Image, m_Image->GetLargestPossibleRegion());
+    std::vector<itk::ImageRegionConstIterator<ImageType>> outputIters;
+    for (unsigned int i = 0; i < 5; ++i)
+      outputIters.emplace_back(filter->GetOutput(i), m_Image->GetLargestPossibleRegion());
+
+    for (; !neighborhoodIter.IsAtEnd(); ++neighborhoodIter)
+    {
+      double min = std::numeric_limits<double>::max();
+      double max = std::numeric_limits<double>::lowest();
+      double sum = 0;
+      double squaredSum = 0;
+      for (unsigned int i = 0; i < neighborhoodIter.Size(); ++i)
+      {
+        double value = neighborhoodIter.GetPixel(i);
+        min = std::min(min, value);
+        max = std::max(max, value);
+        sum += value;
+        squaredSum += value * value;
+      }
+      double mean = sum / neighborhoodIter.Size();
+      double standardDeviation = std::sqrt(squaredSum / neighborhoodIter.Size() - mean * mean);
+
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Minimum", min, outputIters[0].Get());
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Maximum", max, outputIters[1].Get());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Mean", mean, outputIters[2].Get(), 1e-9);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Standard deviation", standardDeviation, outputIters[3].Get(), 1e-6);
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Range", max - min, outputIters[4].Get());
+      for (auto &outputIter : outputIters)
+        ++outputIter;
+    }
+  }
+
+  void MultiHistogramFilter_EqualsFullNeighborhood()
+  {
+    typedef itk::MultiHistogramFilter<ImageType, ImageType> FilterType;
+    auto filter = FilterType::New();
+    filter->SetInput(m_Image);
+    filter->SetSize(2);
+    filter->SetBins(11);
+    filter->SetOffset(-8.0);
+    filter->SetDelta(1.5);
+    filter->Update();
+
+    ImageType::SizeType radius;
+    radius.Fill(2);
+    itk::ConstNeighborhoodIterator<ImageType> neighborhoodIter(radius, m_Image, m_Image->GetLargestPossibleRegion());
+    std::vector<itk::ImageRegionConstIterator<ImageType>> outputIters;
+    for (unsigned int i = 0; i < 11; ++i)
+      outputIters.emplace_back(filter->GetOutput(i), m_Image->GetLargestPossibleRegion());
+
+    for (; !neighborhoodIter.IsAtEnd(); ++neighborhoodIter)
+    {
+      std::vector<double> counts(11, 0);
+      for (unsigned int i = 0; i < neighborhoodIter.Size(); ++i)
+      {
+        auto pos = static_cast<int>((neighborhoodIter.GetPixel(i) + 8.0) / 1.5);
+        ++counts[std::max(0, std::min(10, pos))];
+      }
+      for (unsigned int i = 0; i < 11; ++i)
+      {
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Bin count", counts[i], outputIters[i].Get());
+        ++outputIters[i];
+      }
+    }
+  }
+
+  void LocalIntensityFilter_EqualsFullNeighborhood()
+  {
+    const double range = 2.5;
+    typedef itk::LocalIntensityFilter<ShortImageType> FilterType;
+    auto filter = FilterType::New();
+    filter->SetInput(m_ShortImage);
+    filter->SetMask(m_Mask);
+    filter->SetRange(range);
+    filter->Update();
+
+    // Mean of all voxels of the image that are closer than the range, evaluated at each masked voxel
+    double globalPeak = std::numeric_limits<double>::lowest();
+    double localPeak = std::numeric_limits<double>::lowest();
+    short localMaximum = std::numeric_limits<short>::lowest();
+    const auto imageRegion = m_ShortImage->GetLargestPossibleRegion();
+    itk::ImageRegionConstIterator<MaskType> maskIter(m_Mask, imageRegion);
+    for (; !maskIter.IsAtEnd(); ++maskIter)
+    {
+      if (maskIter.Get() == 0)
+        continue;
+
+      ShortImageType::PointType center;
+      m_ShortImage->TransformIndexToPhysicalPoint(maskIter.GetIndex(), center);
+      double sum = 0;
+      unsigned int count = 0;
+      itk::ImageRegionConstIterator<ShortImageType> imageIter(m_ShortImage, imageRegion);
+      for (; !imageIter.IsAtEnd(); ++imageIter)
+      {
+        ShortImageType::PointType point;
+        m_ShortImage->TransformIndexToPhysicalPoint(imageIter.GetIndex(), point);
+        if (center.EuclideanDistanceTo(point) < range)
+        {
+          sum += imageIter.Get();
+          ++count;
+        }
+      }
+
+      const double peak = sum / count;
+      const short value = m_ShortImage->GetPixel(maskIter.GetIndex());
+      globalPeak = std::max(globalPeak, peak);
+      if (value == localMaximum)
+      {
+        localPeak = std::max(localPeak, peak);
+      }
+      else if (value > localMaximum)
+      {
+        localMaximum = value;
+        localPeak = peak;
+      }
+    }
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Local maximum", static_cast<double>(localMaximum), filter->GetLocalMaximum());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Local intensity peak", localPeak, filter->GetLocalPeak(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Global intensity peak", globalPeak, filter->GetGlobalPeak(), 1e-9);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkSlidingWindowNeighborhood)
@@ -82,6 +82,16 @@ namespace mitk
     */
     virtual bool AppliesTo(const std::string &path) const;
 
+    /**
+    * \brief Returns true if AppliesTo() may check more than the extension of a path.
+    *
+    * mitk::MimeTypeProvider looks up mime-types that only check extensions in an
+    * extension index and calls AppliesTo() only for the other ones. The base
+    * implementation returns false for plain CustomMimeType instances and true for all
+    * subclasses. Subclasses that do not override AppliesTo() may return false as well.
+    */
+    virtual bool ChecksFileContent() const;
+
     /**
     * \brief Checks if the MimeType can handle the extension of the given path
     *
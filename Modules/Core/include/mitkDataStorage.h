@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include <MitkCoreExports.h>
 #include <map>
 #include <mutex>
+#include <vector>
 
 namespace mitk
 {
@@ -265,6 +266,59 @@ namespace mitk
 
     DataStorageEvent InteractorChangedNodeEvent;
 
+    //##Documentation
+    //## @brief Nodes that were added or removed during a batch, see BeginBatch().
+    struct BatchChanges
+    {
+      //## Nodes that were added during the batch and still exist at its end, in the order of their addition.
+      std::vector<DataNode::ConstPointer> AddedNodes;
+
+      //## Nodes that were removed during the batch and do not exist at its end.
+      std::vector<DataNode::ConstPointer> RemovedNodes;
+    };
+
+    typedef Message1<const BatchChanges &> DataStorageBatchEvent;
+
+    //##Documentation
+    //## @brief BatchCommittedEvent is emitted once at the end of a batch that added or removed nodes.
+    //##
+    //## AddNodeEvent and RemoveNodeEvent are still emitted for each node during the batch. Observers that
+    //## have to process all nodes anyway, e.g. to rebuild a model, can ignore AddNodeEvent while IsBatchActive()
+    //## returns true and process the added nodes of this event in a single pass.
+    DataStorageBatchEvent BatchCommittedEvent;
+
+    //##Documentation
+    //## @brief Starts a batch of additions and removals, e.g. while loading a scene.
+    //##
+    //## Batches can be nested, only the end of the outermost batch emits BatchCommittedEvent.
+    //## Every call must be paired with a call of CommitBatch(), see also DataStorage::Batch.
+    void BeginBatch();
+
+    //##Documentation
+    //## @brief Ends a batch started by BeginBatch() and emits BatchCommittedEvent at the end of the
+    //## outermost batch.
+    void CommitBatch();
+
+    //##Documentation
+    //## @brief Returns true between BeginBatch() and the corresponding CommitBatch().
+    bool IsBatchActive() const;
+
+    //##Documentation
+    //## @brief Calls BeginBatch() on construction and CommitBatch() on destruction, even if an exception
+    //## is thrown in between.
+    class MITKCORE_EXPORT Batch
+    {
+    public:
+      explicit Batch(DataStorage *dataStorage);
+      ~Batch();
+
+      Batch(const Batch &) = delete;
+      Batch &operator=(const Batch &) = delete;
+
+    private:
+      DataStorage::Pointer m_DataStorage;
+    };
+
     //##Documentation
     //## @brief Compute the axis-parallel bounding geometry of the input objects
     //##
@@ -415,6 +469,12 @@ namespace mitk
     //## to suppress NodeChangedEvent to be emitted.
     bool m_BlockNodeModifiedEvents;
 
+    //##Documentation
+    //## @brief Nesting depth of BeginBatch() calls and the changes of the current batch.
+    unsigned int m_BatchDepth;
+    BatchChanges m_BatchChanges;
+    mutable std::mutex m_BatchMutex;
+
     DataStorage();
     ~DataStorage() override;
 
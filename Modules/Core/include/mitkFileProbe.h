@@ -0,0 +1,144 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkFileProbe_h
+#define mitkFileProbe_h
+
+#include <MitkCoreExports.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * @ingroup IO
+   *
+   * @brief Shared, read-once view on the beginning of a file.
+   *
+   * Content based checks like mitk::CustomMimeType::AppliesTo() and
+   * mitk::IFileReader::GetConfidenceLevel() usually only need the first bytes of a file.
+   * Instead of opening the file themselves, they can ask FileProbe::Get() for a probe.
+   * The header of the file is read once and the probe is shared by all checks of the
+   * same file as long as it stays in a small cache of recently probed files. A probe
+   * is invalidated if size, modification time, change time or inode (file index on
+   * Windows) of the file change, so a file replaced by renaming is probed again.
+   *
+   * Results of expensive checks that cannot be decided on the header alone can be
+   * stored in the probe via Evaluate(), so that e.g. several DICOM mime types do not
+   * parse the same file again.
+   *
+   * All methods are thread safe.
+   */
+  class MITKCORE_EXPORT FileProbe
+  {
+  public:
+    /** Number of bytes read from the beginning of a file. */
+    static constexpr std::size_t HeaderSize = 16384;
+
+    /**
+     * @brief Returns the probe of the given file, reading its header only if it is not cached yet.
+     *
+     * A probe is returned for non-existing files and directories as well, its
+     * header is empty then.
+     */
+    static std::shared_ptr<const FileProbe> Get(const std::string &path);
+
+    /** @brief Removes all probes from the cache. */
+    static void ClearCache();
+
+    const std::string &GetPath() const;
+
+    bool Exists() const;
+    bool IsDirectory() const;
+    std::uint64_t GetFileSize() const;
+
+    /** @brief Returns the first (at most HeaderSize) bytes of the file. */
+    const std::vector<char> &GetHeader() const;
+
+    /** @brief Returns true if the header contains the complete file. */
+    bool IsHeaderComplete() const;
+
+    bool HeaderStartsWith(const std::string &magic) const;
+
+    /**
+     * @brief Returns true if the file header, which ends at the first occurrence of
+     * headerTerminator, is completely contained in the probe and does not contain text.
+     *
+     * Can be used to rule out text based formats (e.g. the key value pairs of a NRRD
+     * header) without parsing the file. false means "cannot rule out", not "contains".
+     */
+    bool ExcludesText(const std::string &text, const std::string &headerTerminator) const;
+
+    /** @brief Returns true if the file is a DICOM part 10 file (i.e. has the "DICM" prefix). */
+    bool IsDicom() const;
+
+    /**
+     * @brief Looks up a top level DICOM element in the header of a DICOM part 10 file.
+     *
+     * @return false if the element cannot be decided on the header (e.g. no DICOM file,
+     * big endian or deflated transfer syntax, sequences of undefined length before the
+     * element or the header ends before the element). If true is returned, value contains
+     * the element value without padding or is empty if the file has no such element.
+     */
+    bool FindDicomElement(std::uint16_t group, std::uint16_t element, std::string &value) const;
+
+    /**
+     * @brief Evaluates predicate only once per probe and key and returns the stored result afterwards.
+     *
+     * Use unique keys (e.g. the name of the class implementing the check), the result
+     * must only depend on the file content.
+     */
+    template <typename TPredicate>
+    bool Evaluate(const std::string &key, TPredicate predicate) const
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_ResultsMutex);
+        auto iter = m_Results.find(key);
+        if (iter != m_Results.end())
+          return iter->second;
+      }
+
+      bool result = predicate();
+
+      std::lock_guard<std::mutex> lock(m_ResultsMutex);
+      m_Results.emplace(key, result);
+      return result;
+    }
+
+    explicit FileProbe(const std::string &path);
+
+    FileProbe(const FileProbe &) = delete;
+    FileProbe &operator=(const FileProbe &) = delete;
+
+  private:
+    friend class FileProbeCache;
+
+    std::string m_Path;
+    bool m_Exists;
+    bool m_IsDirectory;
+    std::uint64_t m_FileSize;
+    std::int64_t m_ModificationTime;
+    std::uint64_t m_FileId;
+    std::int64_t m_ChangeTime;
+    std::vector<char> m_Header;
+
+    mutable std::mutex m_ResultsMutex;
+    mutable std::map<std::string, bool> m_Results;
+  };
+}
+
+#endif
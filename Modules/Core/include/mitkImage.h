@@ -518,6 +518,68 @@ namespace mitk
       */
     StatisticsHolderPointer GetStatistics() const { return m_ImageStatistics; }
 
+    /**
+      \brief Event invoked by RegionModified(). It carries the modified region of the image.
+      */
+    class MITKCORE_EXPORT RegionModifiedEvent : public itk::AnyEvent
+    {
+    public:
+      typedef RegionModifiedEvent Self;
+      typedef itk::AnyEvent Superclass;
+
+      RegionModifiedEvent(const RegionType &region) : m_Region(region) {}
+      ~RegionModifiedEvent() override {}
+      const char *GetEventName() const override { return "RegionModifiedEvent"; }
+      bool CheckEvent(const ::itk::EventObject *e) const override { return dynamic_cast<const Self *>(e); }
+      ::itk::EventObject *MakeObject() const override { return new Self(m_Region); }
+      const RegionType &GetRegion() const { return m_Region; }
+
+    private:
+      RegionType m_Region;
+      void operator=(const Self &);
+    };
+
+    /**
+      \brief Marks the image as modified, but only within the given region.
+
+      Writers that change only a part of the image data (e.g. a slice written by a segmentation tool) should
+      call this method instead of Modified(). Index 0 to 2 of the region are voxel indices, index 3 the time
+      steps. In addition to the ModifiedEvent a RegionModifiedEvent is invoked. Consumers can ask for
+      everything that changed since their last update with GetModifiedRegionSince().
+      */
+    void RegionModified(const RegionType &region) const;
+
+    /**
+      \brief Convenience method for marking a region of a single time step as modified.
+      */
+    void RegionModified(const itk::ImageRegion<3> &region, TimeStepType timeStep) const;
+
+    /**
+      \brief Gets the bounding box of all regions that were modified after the given time.
+
+      Returns false if the image data or its geometry was modified in an unknown way after the given time,
+      e.g. by a plain Modified(). In this case the caller has to assume that everything changed. If nothing
+      was modified, true is returned together with an empty region.
+      */
+    bool GetModifiedRegionSince(itk::ModifiedTimeType time, RegionType &region) const;
+
+    /**
+      \brief Checks whether the image was modified after the given time at the given time step near the plane.
+
+      Used by mappers to skip views that are not affected by a modification. The margin (in voxels) is added
+      around the modified region to account for interpolation or thick slices. Returns true if the image was
+      modified in an unknown way (see GetModifiedRegionSince()) or if the plane is not a flat plane.
+      */
+    bool IsModifiedNearPlaneSince(itk::ModifiedTimeType time,
+                                  TimeStepType timeStep,
+                                  const PlaneGeometry *plane,
+                                  ScalarType margin = 1.0) const;
+
+    /**
+      \brief Marks the complete image as modified.
+      */
+    void Modified() const override;
+
   protected:
     mitkCloneMacro(Self);
 
@@ -613,6 +675,13 @@ namespace mitk
     mutable std::mutex m_ReadWriteLock;
     /** A mutex, which needs to be locked to manage m_VtkReaders */
     mutable std::mutex m_VtkReadersLock;
+
+    /** Regions passed to RegionModified() after m_UnknownModificationTime, with their modification time */
+    mutable std::vector<std::pair<itk::ModifiedTimeType, RegionType>> m_ModifiedRegions;
+    /** Time of the last modification without region, i.e. of the last plain Modified() */
+    mutable itk::ModifiedTimeType m_UnknownModificationTime;
+    /** A mutex, which needs to be locked to manage m_ModifiedRegions */
+    mutable std::mutex m_ModifiedRegionsLock;
   };
 
   /**
@@ -191,6 +191,10 @@ namespace mitk
       /** \brief Timestamp of last update of stored data. */
       itk::TimeStamp m_LastUpdateTime;
 
+      /** \brief Distance (in voxels) up to which a modified image region affects the current slice.
+        Larger than one voxel if thick slices are rendered. */
+      mitk::ScalarType m_ModifiedRegionMargin = 1.0;
+
       /** \brief mmPerPixel relation between pixel and mm. (World spacing).*/
       mitk::ScalarType *m_mmPerPixel;
 
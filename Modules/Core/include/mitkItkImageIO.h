@@ -17,6 +17,9 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <itkImageIOBase.h>
 
+#include <functional>
+#include <mutex>
+
 namespace mitk
 {
   /**
@@ -29,13 +32,43 @@ namespace mitk
    * For all ITK ImageIOs that support the serialization of MetaData
    * (e.g. nrrd or mhd) the ItkImageIO ensures the serialization
    * of Identification UID.
+   *
+   * ItkImageIO objects can also be created from an ImageIOInfo. Then only the
+   * mime-types are registered and the ITK ImageIO is instantiated on first use.
    */
   class MITKCORE_EXPORT ItkImageIO : public AbstractFileIO
   {
   public:
+    using ImageIOFactoryFunction = std::function<itk::ImageIOBase::Pointer()>;
+
+    /**
+     * \brief Static description of an ITK ImageIO that allows registering it without instantiation.
+     *
+     * The extensions have to be the ones returned by itk::ImageIOBase::GetSupportedReadExtensions()
+     * and itk::ImageIOBase::GetSupportedWriteExtensions().
+     */
+    struct ImageIOInfo
+    {
+      std::string Name; ///< as returned by itk::LightObject::GetNameOfClass()
+      std::vector<std::string> ReadExtensions;
+      std::vector<std::string> WriteExtensions;
+      ImageIOFactoryFunction Factory;
+    };
+
+    /**
+     * \brief Returns the ITK ImageIOs known to MITK, which are registered lazily by the Core module.
+     */
+    static const std::vector<ImageIOInfo> &GetKnownImageIOs();
+
     ItkImageIO(itk::ImageIOBase::Pointer imageIO);
     ItkImageIO(const CustomMimeType &mimeType, itk::ImageIOBase::Pointer imageIO, int rank);
 
+    /** \brief Registers the reader and writer for the described ImageIO, which is instantiated on first use. */
+    ItkImageIO(const ImageIOInfo &imageIOInfo);
+
+    /** \brief Registers the reader and writer for the given mime-type, the ImageIO is instantiated on first use. */
+    ItkImageIO(const CustomMimeType &mimeType, const std::string &imageIOName, const ImageIOFactoryFunction &factory, int rank);
+
     // -------------- AbstractFileReader -------------
 
     using AbstractFileReader::Read;
@@ -66,6 +99,13 @@ namespace mitk
 
     static void SavePropertyListAsMetaData(itk::MetaDataDictionary& dictionary, const PropertyList* properties, const std::string& mimeTypeName);
 
+    /** Helper function that writes the image buffer with the passed ImageIO, which has to be prepared (see PreparImageIOToWriteImage()).
+    NRRD files with attached data and .nii.gz files of scalar images are compressed by several threads directly from the buffer
+    (see ParallelGzipWriter). All other files use the compression of the ImageIO. The compression is no writer option, so saving
+    does not ask for it interactively. Instead, the environment variables MITK_COMPRESSION_LEVEL (0 to 9; default: 2 for NRRD, 6 for NIfTI like the ImageIOs) and
+    MITK_COMPRESSION_THREADS (default 0: all cores) configure it.*/
+    static void WriteImageIO(itk::ImageIOBase* imageIO, const void* buffer, const std::string& path);
+
 
   protected:
     virtual std::vector<std::string> FixUpImageIOExtensions(const std::string &imageIOName);
@@ -82,7 +122,16 @@ namespace mitk
 
     ItkImageIO *IOClone() const override;
 
-    itk::ImageIOBase::Pointer m_ImageIO;
+    void InitializeMimeTypes(const std::string &imageIOName,
+                             std::vector<std::string> readExtensions,
+                             std::vector<std::string> writeExtensions);
+
+    // Returns the ImageIO, creates it via m_ImageIOFactory on first use
+    itk::ImageIOBase *GetImageIO() const;
+
+    mutable itk::ImageIOBase::Pointer m_ImageIO;
+    ImageIOFactoryFunction m_ImageIOFactory;
+    mutable std::mutex m_ImageIOMutex;
 
     std::vector<std::string> m_DefaultMetaDataKeys;
   };
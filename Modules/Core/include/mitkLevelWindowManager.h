@@ -132,6 +132,13 @@ namespace mitk
      *        the number of nodes.
      */
     void DataStorageAddedNode(const DataNode *dataNode = nullptr);
+    /**
+     * @brief This method is called when a batch of additions and removals is committed to the data storage.
+     *        Nodes added in a batch are handled here at once instead of one by one in DataStorageAddedNode.
+     * @throw mitk::Exception Throws an exception if something is wrong, e.g. if the number of observers differs from
+     *        the number of nodes.
+     */
+    void DataStorageCommittedBatch(const DataStorage::BatchChanges &changes);
     /**
      * @brief This method is called when a node is removed from the data storage.
      *        A listener on the data storage is used to call this method automatically before a node will be removed.
@@ -68,6 +68,9 @@ namespace mitk
     /** @see mitk::CustomMimeType::MatchesExtension()*/
     bool MatchesExtension(const std::string &path) const;
 
+    /** @see mitk::CustomMimeType::ChecksFileContent()*/
+    bool ChecksFileContent() const;
+
     /** @see mitk::CustomMimeType::IsValid()*/
     bool IsValid() const;
 
@@ -0,0 +1,82 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkParallelGzipWriter_h
+#define mitkParallelGzipWriter_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * \brief Writes gzip streams that are compressed by several threads.
+   *
+   * Like pigz, the input is split into blocks that are deflated independently and concatenated
+   * into a single deflate stream. Every block except the last one ends with a sync flush, so the
+   * result is a standard gzip stream that any zlib based reader (e.g. the NRRD and NIfTI readers
+   * of ITK) can decompress. The blocks do not share a dictionary, which costs a little compression
+   * ratio compared to a single-threaded stream.
+   */
+  class MITKCORE_EXPORT ParallelGzipWriter
+  {
+  public:
+    ParallelGzipWriter();
+
+    /** \brief Number of compressing threads. 0 (default) uses all cores.*/
+    void SetNumberOfThreads(unsigned int numberOfThreads);
+    unsigned int GetNumberOfThreads() const;
+
+    /** \brief zlib compression level, from 0 (no compression) to 9 (best compression). Default is 6.*/
+    void SetCompressionLevel(int level);
+    int GetCompressionLevel() const;
+
+    /** \brief Number of input bytes compressed as one block. Default is 128 KiB.*/
+    void SetBlockSize(std::size_t blockSize);
+    std::size_t GetBlockSize() const;
+
+    /**
+     * \brief Compresses everything that can be read from input and writes it to output as one gzip stream.
+     * \throw mitk::Exception if the input cannot be read, the output cannot be written or zlib fails.
+     */
+    void Write(std::istream &input, std::ostream &output) const;
+
+    /**
+     * \brief Compresses the prefix followed by size bytes at data and writes it to output as one gzip stream.
+     *
+     * The data is compressed directly from memory, e.g. the header of a file followed by the pixel data of an image.
+     * \throw mitk::Exception if the output cannot be written or zlib fails.
+     */
+    void Write(const std::string &prefix, const void *data, std::size_t size, std::ostream &output) const;
+
+    /**
+     * \brief Compresses the file at inputPath into a gzip file at outputPath, e.g. a .nii into a .nii.gz.
+     * \throw mitk::Exception if one of the files cannot be opened.
+     */
+    void WriteFile(const std::string &inputPath, const std::string &outputPath) const;
+
+  private:
+    /** \brief Compresses the blocks filled by readBlock, which returns true for the last block.*/
+    void Write(const std::function<bool(std::vector<char> &)> &readBlock, std::ostream &output) const;
+
+    unsigned int m_NumberOfThreads;
+    int m_CompressionLevel;
+    std::size_t m_BlockSize;
+  };
+}
+
+#endif
@@ -20,8 +20,12 @@ found in the LICENSE file.
 #include "mitkNodePredicateProperty.h"
 #include "mitkProperties.h"
 #include "mitkArbitraryTimeGeometry.h"
+#include "mitkExceptionMacro.h"
 
-mitk::DataStorage::DataStorage() : itk::Object(), m_BlockNodeModifiedEvents(false)
+#include <algorithm>
+#include <set>
+
+mitk::DataStorage::DataStorage() : itk::Object(), m_BlockNodeModifiedEvents(false), m_BatchDepth(0)
 {
 }
 
@@ -174,14 +178,97 @@ const mitk::DataNode::GroupTagList mitk::DataStorage::GetGroupTags() const
 
 void mitk::DataStorage::EmitAddNodeEvent(const DataNode *node)
 {
+  {
+    std::lock_guard<std::mutex> locked(m_BatchMutex);
+    if (m_BatchDepth > 0)
+      m_BatchChanges.AddedNodes.push_back(node);
+  }
+
   AddNodeEvent.Send(node);
 }
 
 void mitk::DataStorage::EmitRemoveNodeEvent(const DataNode *node)
 {
+  {
+    std::lock_guard<std::mutex> locked(m_BatchMutex);
+    if (m_BatchDepth > 0)
+      m_BatchChanges.RemovedNodes.push_back(node);
+  }
+
   RemoveNodeEvent.Send(node);
 }
 
+void mitk::DataStorage::BeginBatch()
+{
+  std::lock_guard<std::mutex> locked(m_BatchMutex);
+  ++m_BatchDepth;
+}
+
+void mitk::DataStorage::CommitBatch()
+{
+  BatchChanges changes;
+
+  {
+    std::lock_guard<std::mutex> locked(m_BatchMutex);
+
+    if (0 == m_BatchDepth)
+      mitkThrow() << "CommitBatch() was called without a matching BeginBatch().";
+
+    if (--m_BatchDepth > 0)
+      return;
+
+    std::swap(changes, m_BatchChanges);
+  }
+
+  // A node may have been added and removed or removed and added again during the batch,
+  // only its state at the end of the batch is reported.
+  std::set<const DataNode *> visitedNodes;
+  BatchChanges finalChanges;
+
+  for (auto iter = changes.AddedNodes.rbegin(); iter != changes.AddedNodes.rend(); ++iter)
+  {
+    if (visitedNodes.insert(*iter).second && this->Exists(*iter))
+      finalChanges.AddedNodes.push_back(*iter);
+  }
+  std::reverse(finalChanges.AddedNodes.begin(), finalChanges.AddedNodes.end());
+
+  for (const auto &node : changes.RemovedNodes)
+  {
+    if (visitedNodes.insert(node).second && !this->Exists(node))
+      finalChanges.RemovedNodes.push_back(node);
+  }
+
+  if (!finalChanges.AddedNodes.empty() || !finalChanges.RemovedNodes.empty())
+    BatchCommittedEvent.Send(finalChanges);
+}
+
+bool mitk::DataStorage::IsBatchActive() const
+{
+  std::lock_guard<std::mutex> locked(m_BatchMutex);
+  return m_BatchDepth > 0;
+}
+
+mitk::DataStorage::Batch::Batch(DataStorage *dataStorage) : m_DataStorage(dataStorage)
+{
+  if (m_DataStorage.IsNotNull())
+    m_DataStorage->BeginBatch();
+}
+
+mitk::DataStorage::Batch::~Batch()
+{
+  if (m_DataStorage.IsNull())
+    return;
+
+  try
+  {
+    m_DataStorage->CommitBatch();
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Exception while committing a data storage batch: " << e.what();
+  }
+}
+
 void mitk::DataStorage::OnNodeInteractorChanged(itk::Object *caller, const itk::EventObject &)
 {
   const auto *_Node = dynamic_cast<const DataNode *>(caller);
@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 // MITK
 #include "mitkImage.h"
+#include "mitkAbstractTransformGeometry.h"
 #include "mitkCompareImageDataFilter.h"
 #include "mitkImageStatisticsHolder.h"
 #include "mitkImageVtkReadAccessor.h"
@@ -22,6 +23,8 @@ found in the LICENSE file.
 // VTK
 #include <vtkImageData.h>
 
+#include <algorithm>
+
 // Other
 #include <cmath>
 
@@ -38,7 +41,8 @@ mitk::Image::Image()
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_ImageStatistics(nullptr),
+    m_UnknownModificationTime(0)
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -53,7 +57,8 @@ mitk::Image::Image(const Image &other)
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_ImageStatistics(nullptr),
+    m_UnknownModificationTime(0)
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -95,6 +100,135 @@ mitk::Image::~Image()
   delete m_ImageStatistics;
 }
 
+void mitk::Image::Modified() const
+{
+  Superclass::Modified();
+
+  MutexHolder lock(m_ModifiedRegionsLock);
+  m_ModifiedRegions.clear();
+  m_UnknownModificationTime = itk::Object::GetMTime();
+}
+
+void mitk::Image::RegionModified(const RegionType &region) const
+{
+  Superclass::Modified();
+
+  {
+    MutexHolder lock(m_ModifiedRegionsLock);
+    m_ModifiedRegions.emplace_back(itk::Object::GetMTime(), region);
+
+    // Writers like segmentation tools announce one region per stroke. Merging the oldest entries
+    // keeps the list short and only enlarges the region reported for old update times.
+    const std::size_t maximumNumberOfRegions = 32;
+    if (m_ModifiedRegions.size() > maximumNumberOfRegions)
+    {
+      auto &merged = m_ModifiedRegions[1];
+      RegionType::IndexType lower, upper;
+      for (unsigned int i = 0; i < RegionDimension; ++i)
+      {
+        lower[i] = std::min(m_ModifiedRegions[0].second.GetIndex(i), merged.second.GetIndex(i));
+        upper[i] = std::max(m_ModifiedRegions[0].second.GetUpperIndex()[i], merged.second.GetUpperIndex()[i]);
+      }
+      merged.second.SetIndex(lower);
+      merged.second.SetUpperIndex(upper);
+      m_ModifiedRegions.erase(m_ModifiedRegions.begin());
+    }
+  }
+
+  this->InvokeEvent(RegionModifiedEvent(region));
+}
+
+void mitk::Image::RegionModified(const itk::ImageRegion<3> &region, TimeStepType timeStep) const
+{
+  RegionType imageRegion;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    imageRegion.SetIndex(i, region.GetIndex(i));
+    imageRegion.SetSize(i, region.GetSize(i));
+  }
+  imageRegion.SetIndex(3, timeStep);
+  imageRegion.SetSize(3, 1);
+  imageRegion.SetIndex(4, 0);
+  imageRegion.SetSize(4, this->GetDimension(4));
+  this->RegionModified(imageRegion);
+}
+
+bool mitk::Image::GetModifiedRegionSince(itk::ModifiedTimeType time, RegionType &region) const
+{
+  region = RegionType();
+
+  if (this->GetTimeGeometry() != nullptr && this->GetTimeGeometry()->GetMTime() > time)
+    return false;
+
+  MutexHolder lock(m_ModifiedRegionsLock);
+  if (m_UnknownModificationTime > time)
+    return false;
+
+  bool isEmpty = true;
+  RegionType::IndexType lower, upper;
+  for (const auto &modifiedRegion : m_ModifiedRegions)
+  {
+    if (modifiedRegion.first <= time || modifiedRegion.second.GetNumberOfPixels() == 0)
+      continue;
+
+    for (unsigned int i = 0; i < RegionDimension; ++i)
+    {
+      lower[i] = isEmpty ? modifiedRegion.second.GetIndex(i) : std::min(lower[i], modifiedRegion.second.GetIndex(i));
+      upper[i] = isEmpty ? modifiedRegion.second.GetUpperIndex()[i] : std::max(upper[i], modifiedRegion.second.GetUpperIndex()[i]);
+    }
+    isEmpty = false;
+  }
+
+  if (!isEmpty)
+  {
+    region.SetIndex(lower);
+    region.SetUpperIndex(upper);
+  }
+  return true;
+}
+
+bool mitk::Image::IsModifiedNearPlaneSince(itk::ModifiedTimeType time,
+                                           TimeStepType timeStep,
+                                           const PlaneGeometry *plane,
+                                           ScalarType margin) const
+{
+  RegionType region;
+  if (!this->GetModifiedRegionSince(time, region))
+    return true;
+
+  if (0 == region.GetNumberOfPixels())
+    return false;
+
+  if (static_cast<IndexValueType>(timeStep) < region.GetIndex(3) ||
+      static_cast<IndexValueType>(timeStep) > region.GetUpperIndex()[3])
+    return false;
+
+  if (nullptr == plane || nullptr != dynamic_cast<const AbstractTransformGeometry *>(plane))
+    return true;
+
+  const BaseGeometry *geometry = this->GetGeometry(timeStep);
+  if (nullptr == geometry)
+    return true;
+
+  // the plane is near the region if the corners of the enlarged region are not all on the same side of it
+  bool isAbove = false;
+  bool isBelow = false;
+  for (unsigned int corner = 0; corner < 8; ++corner)
+  {
+    Point3D index, world;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      index[i] = (corner & (1u << i)) ? region.GetUpperIndex()[i] + margin : region.GetIndex(i) - margin;
+    }
+    geometry->IndexToWorld(index, world);
+
+    const auto distance = plane->SignedDistance(world);
+    isAbove = isAbove || distance >= 0;
+    isBelow = isBelow || distance <= 0;
+  }
+  return isAbove && isBelow;
+}
+
 const mitk::PixelType mitk::Image::GetPixelType(int n) const
 {
   return this->m_ImageDescriptor->GetChannelTypeById(n);
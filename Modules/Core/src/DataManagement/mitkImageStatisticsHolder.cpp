@@ -262,7 +262,30 @@ void mitk::ImageStatisticsHolder::ComputeImageStatistics(int t, unsigned int com
 
   // image modified?
   if (this->m_Image->GetMTime() > m_LastRecomputeTimeStamp.GetMTime())
-    this->ResetImageStatistics();
+  {
+    // if the image announced the modified region, only the statistics of the modified time steps are invalid
+    SlicedData::RegionType modifiedRegion;
+    if (m_Image->GetModifiedRegionSince(m_LastRecomputeTimeStamp.GetMTime(), modifiedRegion))
+    {
+      for (auto timeStep = modifiedRegion.GetIndex(3);
+           timeStep < modifiedRegion.GetIndex(3) + static_cast<SlicedData::IndexValueType>(modifiedRegion.GetSize(3)) &&
+           timeStep < static_cast<SlicedData::IndexValueType>(m_ScalarMin.size());
+           ++timeStep)
+      {
+        m_ScalarMin[timeStep] = itk::NumericTraits<ScalarType>::max();
+        m_ScalarMax[timeStep] = itk::NumericTraits<ScalarType>::NonpositiveMin();
+        m_Scalar2ndMin[timeStep] = itk::NumericTraits<ScalarType>::max();
+        m_Scalar2ndMax[timeStep] = itk::NumericTraits<ScalarType>::NonpositiveMin();
+        m_CountOfMinValuedVoxels[timeStep] = 0;
+        m_CountOfMaxValuedVoxels[timeStep] = 0;
+      }
+    }
+    else
+    {
+      this->ResetImageStatistics();
+    }
+    m_LastRecomputeTimeStamp.Modified();
+  }
 
   Expand(t + 1);
 
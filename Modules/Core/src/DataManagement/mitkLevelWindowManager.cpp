@@ -43,6 +43,8 @@ mitk::LevelWindowManager::~LevelWindowManager()
       MessageDelegate1<LevelWindowManager, const DataNode *>(this, &LevelWindowManager::DataStorageAddedNode));
     m_DataStorage->RemoveNodeEvent.RemoveListener(
       MessageDelegate1<LevelWindowManager, const DataNode *>(this, &LevelWindowManager::DataStorageRemovedNode));
+    m_DataStorage->BatchCommittedEvent.RemoveListener(
+      MessageDelegate1<LevelWindowManager, const DataStorage::BatchChanges &>(this, &LevelWindowManager::DataStorageCommittedBatch));
     m_DataStorage = nullptr;
   }
 
@@ -67,6 +69,8 @@ void mitk::LevelWindowManager::SetDataStorage(DataStorage *dataStorage)
       MessageDelegate1<LevelWindowManager, const DataNode *>(this, &LevelWindowManager::DataStorageAddedNode));
     m_DataStorage->RemoveNodeEvent.RemoveListener(
       MessageDelegate1<LevelWindowManager, const DataNode *>(this, &LevelWindowManager::DataStorageRemovedNode));
+    m_DataStorage->BatchCommittedEvent.RemoveListener(
+      MessageDelegate1<LevelWindowManager, const DataStorage::BatchChanges &>(this, &LevelWindowManager::DataStorageCommittedBatch));
   }
 
   // register listener for new DataStorage
@@ -75,6 +79,8 @@ void mitk::LevelWindowManager::SetDataStorage(DataStorage *dataStorage)
     MessageDelegate1<LevelWindowManager, const DataNode *>(this, &LevelWindowManager::DataStorageAddedNode));
   m_DataStorage->RemoveNodeEvent.AddListener(
     MessageDelegate1<LevelWindowManager, const DataNode *>(this, &LevelWindowManager::DataStorageRemovedNode));
+  m_DataStorage->BatchCommittedEvent.AddListener(
+    MessageDelegate1<LevelWindowManager, const DataStorage::BatchChanges &>(this, &LevelWindowManager::DataStorageCommittedBatch));
 
   this->DataStorageAddedNode();
 }
@@ -469,8 +475,12 @@ bool mitk::LevelWindowManager::IsSelectedImages() const
   return m_SelectedImagesMode;
 }
 
-void mitk::LevelWindowManager::DataStorageAddedNode(const DataNode *)
+void mitk::LevelWindowManager::DataStorageAddedNode(const DataNode *dataNode)
 {
+  // nodes added in a batch are handled at once when the batch is committed
+  if (nullptr != dataNode && m_DataStorage.IsNotNull() && m_DataStorage->IsBatchActive())
+    return;
+
   // update observers with new data storage
   this->UpdateObservers();
 
@@ -485,6 +495,12 @@ void mitk::LevelWindowManager::DataStorageAddedNode(const DataNode *)
   }
 }
 
+void mitk::LevelWindowManager::DataStorageCommittedBatch(const DataStorage::BatchChanges &changes)
+{
+  if (!changes.AddedNodes.empty())
+    this->DataStorageAddedNode();
+}
+
 void mitk::LevelWindowManager::DataStorageRemovedNode(const DataNode *removedNode)
 {
   // First: check if deleted node is part of relevant nodes.
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include <mitkUtf8Util.h>
 
 #include <algorithm>
+#include <typeinfo>
 
 #include <itksys/SystemTools.hxx>
 
@@ -90,6 +91,7 @@ namespace mitk
   }
 
   bool CustomMimeType::AppliesTo(const std::string &path) const { return MatchesExtension(path); }
+  bool CustomMimeType::ChecksFileContent() const { return typeid(*this) != typeid(CustomMimeType); }
   bool CustomMimeType::MatchesExtension(const std::string &path) const
   {
     std::string extension, filename;
@@ -0,0 +1,354 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkFileProbe.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <list>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace mitk
+{
+  namespace
+  {
+    const std::size_t DicomPreambleSize = 128;
+
+    std::uint16_t ReadUInt16(const char *data)
+    {
+      const auto *bytes = reinterpret_cast<const unsigned char *>(data);
+      return static_cast<std::uint16_t>(bytes[0] | (bytes[1] << 8));
+    }
+
+    std::uint32_t ReadUInt32(const char *data)
+    {
+      const auto *bytes = reinterpret_cast<const unsigned char *>(data);
+      return static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8) |
+             (static_cast<std::uint32_t>(bytes[2]) << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+    }
+
+    // value representations that use a 4 byte length in explicit VR encoding
+    bool HasLongLength(const char *vr)
+    {
+      static const char *longVRs[] = {"OB", "OD", "OF", "OL", "OV", "OW", "SQ", "SV", "UC", "UN", "UR", "UT", "UV"};
+      for (const char *longVR : longVRs)
+      {
+        if (vr[0] == longVR[0] && vr[1] == longVR[1])
+          return true;
+      }
+      return false;
+    }
+
+    std::string TrimDicomValue(const char *data, std::size_t length)
+    {
+      while (length > 0 && (data[length - 1] == ' ' || data[length - 1] == '\0'))
+        --length;
+      std::size_t begin = 0;
+      while (begin < length && data[begin] == ' ')
+        ++begin;
+      return std::string(data + begin, length - begin);
+    }
+
+    struct FileIdentity
+    {
+      std::uint64_t fileId = 0;
+      std::int64_t changeTime = 0;
+    };
+
+    // The inode (file index on Windows) and the change time of the file. They detect a file that was
+    // replaced by another one (e.g. by renaming) or rewritten with the same size and modification time.
+    FileIdentity GetFileIdentity(const std::string &path)
+    {
+      FileIdentity identity;
+#ifdef _WIN32
+      HANDLE handle = CreateFileW(std::filesystem::path(path).c_str(), FILE_READ_ATTRIBUTES,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+      if (handle == INVALID_HANDLE_VALUE)
+        return identity;
+
+      BY_HANDLE_FILE_INFORMATION info;
+      if (GetFileInformationByHandle(handle, &info))
+        identity.fileId = (static_cast<std::uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+
+      FILE_BASIC_INFO basicInfo;
+      if (GetFileInformationByHandleEx(handle, FileBasicInfo, &basicInfo, sizeof(basicInfo)))
+        identity.changeTime = basicInfo.ChangeTime.QuadPart;
+
+      CloseHandle(handle);
+#else
+      struct stat info;
+      if (stat(path.c_str(), &info) != 0)
+        return identity;
+
+      identity.fileId = static_cast<std::uint64_t>(info.st_ino);
+#ifdef __APPLE__
+      identity.changeTime = static_cast<std::int64_t>(info.st_ctimespec.tv_sec) * 1000000000 + info.st_ctimespec.tv_nsec;
+#else
+      identity.changeTime = static_cast<std::int64_t>(info.st_ctim.tv_sec) * 1000000000 + info.st_ctim.tv_nsec;
+#endif
+#endif
+      return identity;
+    }
+
+    struct DicomElementHeader
+    {
+      std::uint32_t tag;
+      std::uint32_t length;
+      std::size_t headerLength;
+    };
+
+    // returns false if the element header does not fit into the buffer
+    bool ReadDicomElementHeader(
+      const std::vector<char> &buffer, std::size_t pos, bool explicitVR, DicomElementHeader &header)
+    {
+      if (pos + 8 > buffer.size())
+        return false;
+
+      const char *data = buffer.data() + pos;
+      header.tag = (static_cast<std::uint32_t>(ReadUInt16(data)) << 16) | ReadUInt16(data + 2);
+
+      if (!explicitVR)
+      {
+        header.length = ReadUInt32(data + 4);
+        header.headerLength = 8;
+      }
+      else if (HasLongLength(data + 4))
+      {
+        if (pos + 12 > buffer.size())
+          return false;
+        header.length = ReadUInt32(data + 8);
+        header.headerLength = 12;
+      }
+      else
+      {
+        header.length = ReadUInt16(data + 6);
+        header.headerLength = 8;
+      }
+      return true;
+    }
+  }
+
+  class FileProbeCache
+  {
+  public:
+    static constexpr std::size_t MaximumSize = 32;
+
+    static FileProbeCache &GetInstance()
+    {
+      static FileProbeCache instance;
+      return instance;
+    }
+
+    std::shared_ptr<const FileProbe> Get(const std::string &path)
+    {
+      std::error_code error;
+      const std::filesystem::path fsPath(path);
+      const auto modificationTime = std::filesystem::last_write_time(fsPath, error);
+      const std::int64_t time = error ? 0 : modificationTime.time_since_epoch().count();
+      const auto status = std::filesystem::status(fsPath, error);
+      const bool isRegularFile = !error && std::filesystem::is_regular_file(status);
+      const std::uint64_t size = isRegularFile ? std::filesystem::file_size(fsPath, error) : 0;
+      const auto identity = GetFileIdentity(path);
+
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto iter = std::find_if(m_Probes.begin(), m_Probes.end(), [&path](const std::shared_ptr<const FileProbe> &probe) {
+          return probe->m_Path == path;
+        });
+
+        if (iter != m_Probes.end())
+        {
+          if ((*iter)->m_ModificationTime == time && (*iter)->m_FileSize == size && (*iter)->m_Exists &&
+              (*iter)->m_FileId == identity.fileId && (*iter)->m_ChangeTime == identity.changeTime)
+          {
+            // move to front, the list is ordered by last access
+            m_Probes.splice(m_Probes.begin(), m_Probes, iter);
+            return m_Probes.front();
+          }
+          m_Probes.erase(iter);
+        }
+      }
+
+      // read the header without holding the lock
+      std::shared_ptr<const FileProbe> probe = std::make_shared<const FileProbe>(path);
+
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Probes.push_front(probe);
+      if (m_Probes.size() > MaximumSize)
+        m_Probes.pop_back();
+      return probe;
+    }
+
+    void Clear()
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Probes.clear();
+    }
+
+  private:
+    std::mutex m_Mutex;
+    std::list<std::shared_ptr<const FileProbe>> m_Probes;
+  };
+
+  FileProbe::FileProbe(const std::string &path)
+    : m_Path(path), m_Exists(false), m_IsDirectory(false), m_FileSize(0), m_ModificationTime(0), m_FileId(0), m_ChangeTime(0)
+  {
+    std::error_code error;
+    const std::filesystem::path fsPath(path);
+    const auto status = std::filesystem::status(fsPath, error);
+    if (error || !std::filesystem::exists(status))
+      return;
+
+    m_Exists = true;
+    m_IsDirectory = std::filesystem::is_directory(status);
+
+    const auto modificationTime = std::filesystem::last_write_time(fsPath, error);
+    m_ModificationTime = error ? 0 : modificationTime.time_since_epoch().count();
+
+    const auto identity = GetFileIdentity(path);
+    m_FileId = identity.fileId;
+    m_ChangeTime = identity.changeTime;
+
+    if (!std::filesystem::is_regular_file(status))
+      return;
+
+    m_FileSize = std::filesystem::file_size(fsPath, error);
+    if (error)
+      m_FileSize = 0;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+      return;
+
+    m_Header.resize(static_cast<std::size_t>(std::min<std::uint64_t>(m_FileSize, HeaderSize)));
+    file.read(m_Header.data(), m_Header.size());
+    m_Header.resize(static_cast<std::size_t>(file.gcount()));
+  }
+
+  std::shared_ptr<const FileProbe> FileProbe::Get(const std::string &path)
+  {
+    return FileProbeCache::GetInstance().Get(path);
+  }
+
+  void FileProbe::ClearCache() { FileProbeCache::GetInstance().Clear(); }
+
+  const std::string &FileProbe::GetPath() const { return m_Path; }
+
+  bool FileProbe::Exists() const { return m_Exists; }
+
+  bool FileProbe::IsDirectory() const { return m_IsDirectory; }
+
+  std::uint64_t FileProbe::GetFileSize() const { return m_FileSize; }
+
+  const std::vector<char> &FileProbe::GetHeader() const { return m_Header; }
+
+  bool FileProbe::IsHeaderComplete() const { return m_Exists && !m_IsDirectory && m_Header.size() == m_FileSize; }
+
+  bool FileProbe::HeaderStartsWith(const std::string &magic) const
+  {
+    return m_Header.size() >= magic.size() && std::equal(magic.begin(), magic.end(), m_Header.begin());
+  }
+
+  bool FileProbe::ExcludesText(const std::string &text, const std::string &headerTerminator) const
+  {
+    auto headerEnd = std::search(m_Header.begin(), m_Header.end(), headerTerminator.begin(), headerTerminator.end());
+    if (headerEnd == m_Header.end() && !this->IsHeaderComplete())
+      return false;
+
+    return std::search(m_Header.begin(), headerEnd, text.begin(), text.end()) == headerEnd;
+  }
+
+  bool FileProbe::IsDicom() const
+  {
+    return m_Header.size() >= DicomPreambleSize + 4 &&
+           0 == std::memcmp(m_Header.data() + DicomPreambleSize, "DICM", 4);
+  }
+
+  bool FileProbe::FindDicomElement(std::uint16_t group, std::uint16_t element, std::string &value) const
+  {
+    value.clear();
+    if (!this->IsDicom())
+      return false;
+
+    const std::uint32_t searchedTag = (static_cast<std::uint32_t>(group) << 16) | element;
+    const std::uint32_t undefinedLength = 0xFFFFFFFF;
+
+    // the file meta information (group 0002) is always explicit VR little endian
+    std::size_t pos = DicomPreambleSize + 4;
+    std::string transferSyntax;
+    DicomElementHeader header;
+
+    while (ReadDicomElementHeader(m_Header, pos, true, header) && (header.tag >> 16) == 0x0002)
+    {
+      if (header.length == undefinedLength || pos + header.headerLength + header.length > m_Header.size())
+        return false;
+
+      const std::string elementValue = TrimDicomValue(m_Header.data() + pos + header.headerLength, header.length);
+      if (header.tag == 0x00020010)
+        transferSyntax = elementValue;
+
+      if (header.tag == searchedTag)
+      {
+        value = elementValue;
+        return true;
+      }
+      pos += header.headerLength + header.length;
+    }
+
+    if (group == 0x0002)
+      return !transferSyntax.empty();
+
+    bool explicitVR = true;
+    if (transferSyntax == "1.2.840.10008.1.2")
+    {
+      explicitVR = false;
+    }
+    else if (transferSyntax.empty() || transferSyntax == "1.2.840.10008.1.2.2" ||
+             transferSyntax == "1.2.840.10008.1.2.1.99")
+    {
+      // unknown, big endian or deflated data set
+      return false;
+    }
+
+    while (ReadDicomElementHeader(m_Header, pos, explicitVR, header))
+    {
+      if (header.tag > searchedTag)
+        return true; // elements are sorted, so the file has no such element
+
+      if (header.length == undefinedLength)
+        return false;
+
+      if (header.tag == searchedTag)
+      {
+        if (pos + header.headerLength + header.length > m_Header.size())
+          return false;
+
+        value = TrimDicomValue(m_Header.data() + pos + header.headerLength, header.length);
+        return true;
+      }
+      pos += header.headerLength + header.length;
+    }
+
+    // the data set ended before the searched element
+    return this->IsHeaderComplete() && pos == m_Header.size();
+  }
+}
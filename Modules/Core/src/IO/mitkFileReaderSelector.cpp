@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkFileReaderSelector.h"
 
 #include <mitkCoreServices.h>
+#include <mitkFileProbe.h>
 #include <mitkFileReaderRegistry.h>
 #include <mitkIMimeTypeProvider.h>
 #include <mitkUtf8Util.h>
@@ -56,6 +57,9 @@ namespace mitk
 
     mitk::CoreServicePointer<mitk::IMimeTypeProvider> mimeTypeProvider(mitk::CoreServices::GetMimeTypeProvider());
 
+    // Mime-types and reader confidence checks share the header of the file
+    auto probe = FileProbe::Get(path);
+
     // Get all mime types and associated readers for the given file path
 
     m_Data->m_MimeTypes = mimeTypeProvider->GetMimeTypesForFile(path);
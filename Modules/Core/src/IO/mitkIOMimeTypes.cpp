@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkIOMimeTypes.h"
 
 #include "mitkCustomMimeType.h"
+#include "mitkFileProbe.h"
 #include "mitkLog.h"
 #include <mitkUtf8Util.h>
 
@@ -68,27 +69,53 @@ namespace mitk
       }
     }
 
-    // Ask the GDCM ImageIO class directly
-    itk::GDCMImageIO::Pointer gdcmIO = itk::GDCMImageIO::New();
-    gdcmIO->SetFileName(filepath);
-    try {
-      gdcmIO->ReadImageInformation();
-    }
-    catch (const itk::ExceptionObject & /*err*/) {
-      return false;
-    }
+    auto probe = FileProbe::Get(filepath);
 
     //DICOMRT modalities have specific reader, don't read with normal DICOM readers
     std::string modality;
-    itk::MetaDataDictionary& dict = gdcmIO->GetMetaDataDictionary();
-    itk::ExposeMetaData<std::string>(dict, "0008|0060", modality);
-    MITK_DEBUG << "DICOM Modality detected by MimeType "<< this->GetName() << " is " << modality;
-    if (modality == "RTSTRUCT" || modality == "RTDOSE" || modality == "RTPLAN") {
+    if (probe->FindDicomElement(0x0008, 0x0060, modality) &&
+        (modality == "RTSTRUCT" || modality == "RTDOSE" || modality == "RTPLAN"))
+    {
       return false;
     }
-    else {
-      return gdcmIO->CanReadFile(filepath.c_str());
+
+    // Files without DICOM prefix are only handed to GDCM if they have a DICOM extension or no
+    // extension at all. DICOM files are often named without extension or with a running number
+    // (e.g. "IM_0001", "1.2.840.113619.2.1"), and not all of them have the preamble.
+    if (!probe->IsDicom() && !this->MatchesExtension(filepath))
+    {
+      const std::string extension = itksys::SystemTools::GetFilenameLastExtension(filepath);
+      const bool hasExtension =
+        extension.size() > 1 && extension.find_first_not_of("0123456789", 1) != std::string::npos;
+      if (hasExtension)
+      {
+        return false;
+      }
     }
+
+    // The result does not depend on the concrete mime-type, so all subclasses share it
+    return probe->Evaluate("mitk::IOMimeTypes::BaseDicomMimeType", [&filepath]() {
+      // Ask the GDCM ImageIO class directly
+      itk::GDCMImageIO::Pointer gdcmIO = itk::GDCMImageIO::New();
+      gdcmIO->SetFileName(filepath);
+      try {
+        gdcmIO->ReadImageInformation();
+      }
+      catch (const itk::ExceptionObject & /*err*/) {
+        return false;
+      }
+
+      std::string modality;
+      itk::MetaDataDictionary& dict = gdcmIO->GetMetaDataDictionary();
+      itk::ExposeMetaData<std::string>(dict, "0008|0060", modality);
+      MITK_DEBUG << "DICOM Modality detected by GDCM is " << modality;
+      if (modality == "RTSTRUCT" || modality == "RTDOSE" || modality == "RTPLAN") {
+        return false;
+      }
+      else {
+        return gdcmIO->CanReadFile(filepath.c_str());
+      }
+    });
   }
 
   IOMimeTypes::BaseDicomMimeType*IOMimeTypes::BaseDicomMimeType::Clone() const { return new BaseDicomMimeType(*this); }
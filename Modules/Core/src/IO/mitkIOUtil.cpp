@@ -579,6 +579,9 @@ namespace mitk
     int filesToRead = loadInfos.size();
     mitk::ProgressBar::GetInstance()->AddStepsToDo(2 * filesToRead);
 
+    // observers of the data storage process all loaded nodes at once instead of one by one
+    DataStorage::Batch batch(ds);
+
     std::string errMsg;
 
     std::map<std::string, FileReaderSelector::Item> usedReaderItems;
@@ -18,8 +18,10 @@ found in the LICENSE file.
 #include <mitkIOMimeTypes.h>
 #include <mitkIPropertyPersistence.h>
 #include <mitkImage.h>
+#include <mitkIOUtil.h>
 #include <mitkImageReadAccessor.h>
 #include <mitkLocaleSwitch.h>
+#include <mitkParallelGzipWriter.h>
 #include <mitkUIDManipulator.h>
 
 #include <itkImage.h>
@@ -27,8 +29,14 @@ found in the LICENSE file.
 #include <itkImageIOFactory.h>
 #include <itkImageIORegion.h>
 #include <itkMetaDataObject.h>
+#include <itksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 
 namespace mitk
 {
@@ -37,10 +45,17 @@ namespace mitk
   const char *const PROPERTY_KEY_TIMEGEOMETRY_TYPE = "org_mitk_timegeometry_type";
   const char *const PROPERTY_KEY_TIMEGEOMETRY_TIMEPOINTS = "org_mitk_timegeometry_timepoints";
   const char* const PROPERTY_KEY_UID = "org_mitk_uid";
+  const char *const ENVIRONMENT_COMPRESSION_LEVEL = "MITK_COMPRESSION_LEVEL";
+  const char *const ENVIRONMENT_COMPRESSION_THREADS = "MITK_COMPRESSION_THREADS";
 
   ItkImageIO::ItkImageIO(const ItkImageIO &other)
-    : AbstractFileIO(other), m_ImageIO(dynamic_cast<itk::ImageIOBase *>(other.m_ImageIO->Clone().GetPointer()))
+    : AbstractFileIO(other), m_ImageIOFactory(other.m_ImageIOFactory)
   {
+    std::lock_guard<std::mutex> lock(other.m_ImageIOMutex);
+    if (other.m_ImageIO.IsNotNull())
+    {
+      m_ImageIO = dynamic_cast<itk::ImageIOBase *>(other.m_ImageIO->Clone().GetPointer());
+    }
     this->InitializeDefaultMetaDataKeys();
   }
 
@@ -123,11 +138,43 @@ namespace mitk
     this->AbstractFileReader::SetMimeTypePrefix(IOMimeTypes::DEFAULT_BASE_NAME() + ".image.");
     this->InitializeDefaultMetaDataKeys();
 
-    std::vector<std::string> readExtensions = m_ImageIO->GetSupportedReadExtensions();
+    std::string imageIOName = m_ImageIO->GetNameOfClass();
+    this->InitializeMimeTypes(
+      imageIOName, m_ImageIO->GetSupportedReadExtensions(), m_ImageIO->GetSupportedWriteExtensions());
+
+    std::string description = std::string("ITK ") + imageIOName;
+    this->SetReaderDescription(description);
+    this->SetWriterDescription(description);
+
+    this->RegisterService();
+  }
+
+  ItkImageIO::ItkImageIO(const ImageIOInfo &imageIOInfo)
+    : AbstractFileIO(Image::GetStaticNameOfClass()), m_ImageIOFactory(imageIOInfo.Factory)
+  {
+    if (!m_ImageIOFactory)
+    {
+      mitkThrow() << "ITK ImageIO factory function must not be empty";
+    }
+
+    this->AbstractFileReader::SetMimeTypePrefix(IOMimeTypes::DEFAULT_BASE_NAME() + ".image.");
+    this->InitializeDefaultMetaDataKeys();
+
+    this->InitializeMimeTypes(imageIOInfo.Name, imageIOInfo.ReadExtensions, imageIOInfo.WriteExtensions);
 
+    std::string description = std::string("ITK ") + imageIOInfo.Name;
+    this->SetReaderDescription(description);
+    this->SetWriterDescription(description);
+
+    this->RegisterService();
+  }
+
+  void ItkImageIO::InitializeMimeTypes(const std::string &imageIOName,
+                                       std::vector<std::string> readExtensions,
+                                       std::vector<std::string> writeExtensions)
+  {
     if (readExtensions.empty())
     {
-      std::string imageIOName = m_ImageIO->GetNameOfClass();
       MITK_DEBUG << "ITK ImageIOBase " << imageIOName << " does not provide read extensions";
       readExtensions = FixUpImageIOExtensions(imageIOName);
     }
@@ -149,16 +196,13 @@ namespace mitk
     auto extensions = customReaderMimeType.GetExtensions();
     if (extensions.empty() || (extensions.size() == 1 && extensions[0].empty()))
     {
-      std::string imageIOName = m_ImageIO->GetNameOfClass();
       FixUpCustomMimeTypeName(imageIOName, customReaderMimeType);
     }
 
     this->AbstractFileReader::SetMimeType(customReaderMimeType);
 
-    std::vector<std::string> writeExtensions = imageIO->GetSupportedWriteExtensions();
     if (writeExtensions.empty())
     {
-      std::string imageIOName = imageIO->GetNameOfClass();
       MITK_DEBUG << "ITK ImageIOBase " << imageIOName << " does not provide write extensions";
       writeExtensions = FixUpImageIOExtensions(imageIOName);
     }
@@ -182,18 +226,11 @@ namespace mitk
       auto extensions = customWriterMimeType.GetExtensions();
       if (extensions.empty() || (extensions.size() == 1 && extensions[0].empty()))
       {
-        std::string imageIOName = m_ImageIO->GetNameOfClass();
         FixUpCustomMimeTypeName(imageIOName, customWriterMimeType);
       }
 
       this->AbstractFileWriter::SetMimeType(customWriterMimeType);
     }
-
-    std::string description = std::string("ITK ") + imageIO->GetNameOfClass();
-    this->SetReaderDescription(description);
-    this->SetWriterDescription(description);
-
-    this->RegisterService();
   }
 
   ItkImageIO::ItkImageIO(const CustomMimeType &mimeType, itk::ImageIOBase::Pointer imageIO, int rank)
@@ -217,6 +254,30 @@ namespace mitk
     this->RegisterService();
   }
 
+  ItkImageIO::ItkImageIO(const CustomMimeType &mimeType,
+                         const std::string &imageIOName,
+                         const ImageIOFactoryFunction &factory,
+                         int rank)
+    : AbstractFileIO(Image::GetStaticNameOfClass(), mimeType, std::string("ITK ") + imageIOName),
+      m_ImageIOFactory(factory)
+  {
+    if (!m_ImageIOFactory)
+    {
+      mitkThrow() << "ITK ImageIO factory function must not be empty";
+    }
+
+    this->AbstractFileReader::SetMimeTypePrefix(IOMimeTypes::DEFAULT_BASE_NAME() + ".image.");
+    this->InitializeDefaultMetaDataKeys();
+
+    if (rank)
+    {
+      this->AbstractFileReader::SetRanking(rank);
+      this->AbstractFileWriter::SetRanking(rank);
+    }
+
+    this->RegisterService();
+  }
+
   std::vector<TimePointType> ConvertMetaDataObjectToTimePointList(const itk::MetaDataObjectBase* data)
   {
     const auto* timeGeometryTimeData =
@@ -526,12 +587,13 @@ namespace mitk
   {
     std::vector<BaseData::Pointer> result;
 
-    auto image = LoadRawMitkImageFromImageIO(this->m_ImageIO, this->GetLocalFileName());
+    auto *imageIO = this->GetImageIO();
+    auto image = LoadRawMitkImageFromImageIO(imageIO, this->GetLocalFileName());
 
-    const itk::MetaDataDictionary& dictionary = this->m_ImageIO->GetMetaDataDictionary();
+    const itk::MetaDataDictionary& dictionary = imageIO->GetMetaDataDictionary();
 
     //meta data handling
-    auto props = ExtractMetaDataAsPropertyList(this->m_ImageIO->GetMetaDataDictionary(), this->GetMimeType()->GetName(), this->m_DefaultMetaDataKeys);
+    auto props = ExtractMetaDataAsPropertyList(imageIO->GetMetaDataDictionary(), this->GetMimeType()->GetName(), this->m_DefaultMetaDataKeys);
     for (auto& [name, prop] : *(props->GetMap()))
     {
       image->SetProperty(name, prop);
@@ -556,7 +618,7 @@ namespace mitk
 
   AbstractFileIO::ConfidenceLevel ItkImageIO::GetReaderConfidenceLevel() const
   {
-    return m_ImageIO->CanReadFile(GetLocalFileName().c_str()) ? IFileReader::Supported : IFileReader::Unsupported;
+    return this->GetImageIO()->CanReadFile(GetLocalFileName().c_str()) ? IFileReader::Supported : IFileReader::Unsupported;
   }
 
   void ItkImageIO::PreparImageIOToWriteImage(itk::ImageIOBase* imageIO, const Image* image)
@@ -715,7 +777,8 @@ namespace mitk
       mitkThrow() << "Cannot write non-image data";
     }
 
-    PreparImageIOToWriteImage(m_ImageIO, image);
+    auto *imageIO = this->GetImageIO();
+    PreparImageIOToWriteImage(imageIO, image);
 
     LocalFile localFile(this);
     const std::string path = localFile.GetFileName();
@@ -725,17 +788,13 @@ namespace mitk
     try
     {
       // Handle properties
-      SavePropertyListAsMetaData(m_ImageIO->GetMetaDataDictionary(), image->GetPropertyList(), this->GetMimeType()->GetName());
+      SavePropertyListAsMetaData(imageIO->GetMetaDataDictionary(), image->GetPropertyList(), this->GetMimeType()->GetName());
       // Handle UID
-      itk::EncapsulateMetaData<std::string>(m_ImageIO->GetMetaDataDictionary(), PROPERTY_KEY_UID, image->GetUID());
-
-      // use compression if available
-      m_ImageIO->UseCompressionOn();
-      m_ImageIO->SetFileName(path);
+      itk::EncapsulateMetaData<std::string>(imageIO->GetMetaDataDictionary(), PROPERTY_KEY_UID, image->GetUID());
 
       ImageReadAccessor imageAccess(image);
       LocaleSwitch localeSwitch2("C");
-      m_ImageIO->Write(imageAccess.GetData());
+      WriteImageIO(imageIO, imageAccess.GetData(), path);
     }
     catch (const std::exception &e)
     {
@@ -743,6 +802,172 @@ namespace mitk
     }
   }
 
+  namespace
+  {
+    /** Returns the value of an integer environment variable, or defaultValue if it is not set or invalid.*/
+    int GetEnvironmentInt(const char *name, int defaultValue, int minimum, int maximum)
+    {
+      const char *value = itksys::SystemTools::GetEnv(name);
+      if (nullptr == value || '\0' == *value)
+        return defaultValue;
+
+      char *end = nullptr;
+      const long result = std::strtol(value, &end, 10);
+      if ('\0' != *end || result < minimum || result > maximum)
+      {
+        MITK_WARN << "Ignoring invalid value \"" << value << "\" of environment variable " << name << ". Expected an integer from "
+                  << minimum << " to " << maximum << ".";
+        return defaultValue;
+      }
+      return static_cast<int>(result);
+    }
+
+    /** Reads the header of a NRRD file with attached, raw encoded data and changes it to gzip encoded data
+    with lastSize elements along the last axis.*/
+    std::string ReadNrrdHeader(const std::string &path, unsigned int lastSize)
+    {
+      std::ifstream input(path, std::ios::binary);
+      if (!input.is_open())
+        mitkThrow() << "Cannot open " << path << " for reading.";
+
+      // the header consists of the lines up to the first empty line, the data follows directly
+      std::string header;
+      std::string line;
+      bool isRawEncoded = false;
+      while (std::getline(input, line) && !line.empty())
+      {
+        if (line.compare(0, 9, "data file") == 0)
+          mitkThrow() << path << " has a detached data file.";
+
+        if (line.compare(0, 9, "encoding:") == 0)
+        {
+          isRawEncoded = line.find("raw") != std::string::npos;
+          line = "encoding: gzip";
+        }
+        else if (line.compare(0, 6, "sizes:") == 0)
+        {
+          line = line.substr(0, line.find_last_of(' ') + 1) + std::to_string(lastSize);
+        }
+        header += line + '\n';
+      }
+
+      if (!input || !isRawEncoded)
+        mitkThrow() << path << " is no NRRD file with attached, raw encoded data.";
+
+      return header + '\n';
+    }
+
+    /** Reads the header of an uncompressed NIfTI-1 file up to the voxel data and changes the size of the
+    given axis (1 for the first axis) to size.*/
+    std::string ReadNiftiHeader(const std::string &path, unsigned int axis, unsigned int size)
+    {
+      std::ifstream input(path, std::ios::binary);
+      if (!input.is_open())
+        mitkThrow() << "Cannot open " << path << " for reading.";
+
+      // the header was written in the byte order of this machine
+      const std::size_t headerSize = 348;
+      std::string header(headerSize, '\0');
+      input.read(&header[0], headerSize);
+
+      std::int32_t sizeOfHeader = 0;
+      float voxelOffset = 0.0f;
+      std::memcpy(&sizeOfHeader, header.data(), sizeof(sizeOfHeader));
+      std::memcpy(&voxelOffset, header.data() + 108, sizeof(voxelOffset));
+      if (!input || sizeOfHeader != static_cast<std::int32_t>(headerSize) || voxelOffset < headerSize)
+        mitkThrow() << path << " is no NIfTI-1 file.";
+
+      // extensions up to the voxel data
+      header.resize(static_cast<std::size_t>(voxelOffset));
+      input.read(&header[headerSize], static_cast<std::streamsize>(header.size() - headerSize));
+      if (!input)
+        mitkThrow() << "Cannot read the header of " << path << ".";
+
+      // the NIfTI library removes trailing axes of size 1 from dim[0]
+      std::int16_t dim[8];
+      std::memcpy(dim, header.data() + 40, sizeof(dim));
+      dim[0] = std::max(dim[0], static_cast<std::int16_t>(axis));
+      dim[axis] = static_cast<std::int16_t>(size);
+      std::memcpy(&header[40], dim, sizeof(dim));
+
+      return header;
+    }
+  }
+
+  void ItkImageIO::WriteImageIO(itk::ImageIOBase* imageIO, const void* buffer, const std::string& path)
+  {
+    const std::string imageIOName = imageIO->GetNameOfClass();
+    const auto lowerCasePath = itksys::SystemTools::LowerCase(path);
+    const bool isNrrd = imageIOName == "NrrdImageIO" && itksys::SystemTools::StringEndsWith(lowerCasePath, ".nrrd");
+    // NIfTI stores the components of vector images in separate volumes and needs NIfTI-2 for large images,
+    // both are left to the ImageIO
+    bool isNifti = imageIOName == "NiftiImageIO" && itksys::SystemTools::StringEndsWith(lowerCasePath, ".nii.gz") &&
+      imageIO->GetNumberOfComponents() == 1;
+    for (unsigned int i = 0; isNifti && i < imageIO->GetNumberOfDimensions(); ++i)
+      isNifti = imageIO->GetDimensions(i) <= 32767;
+
+    if (!isNrrd && !isNifti)
+    {
+      // use compression if available
+      imageIO->UseCompressionOn();
+      imageIO->SetFileName(path);
+      imageIO->Write(buffer);
+      return;
+    }
+
+    // the defaults are the compression levels of the ImageIOs
+    ParallelGzipWriter compressor;
+    compressor.SetCompressionLevel(GetEnvironmentInt(ENVIRONMENT_COMPRESSION_LEVEL, isNrrd ? 2 : 6, 0, 9));
+    compressor.SetNumberOfThreads(static_cast<unsigned int>(GetEnvironmentInt(ENVIRONMENT_COMPRESSION_THREADS, 0, 0, 1024)));
+
+    // The header is taken from an uncompressed file of the first slice along the last axis, which the ImageIO
+    // writes to a temporary file. The pixel data is compressed directly from the buffer, which has the layout
+    // of the file. Only the data of a NRRD file is compressed, a .nii.gz file is compressed as a whole.
+    const unsigned int lastAxis = imageIO->GetNumberOfDimensions() - 1;
+    const auto lastSize = static_cast<unsigned int>(imageIO->GetDimensions(lastAxis));
+    const auto ioRegion = imageIO->GetIORegion();
+    auto sliceRegion = ioRegion;
+    sliceRegion.SetSize(lastAxis, 1);
+
+    const auto headerPath = IOUtil::CreateTemporaryFile(isNrrd ? "XXXXXX.nrrd" : "XXXXXX.nii");
+    std::string header;
+    try
+    {
+      imageIO->UseCompressionOff();
+      imageIO->SetDimensions(lastAxis, 1);
+      imageIO->SetIORegion(sliceRegion);
+      imageIO->SetFileName(headerPath);
+      imageIO->Write(buffer);
+
+      header = isNrrd ? ReadNrrdHeader(headerPath, lastSize) : ReadNiftiHeader(headerPath, lastAxis + 1, lastSize);
+    }
+    catch (...)
+    {
+      std::remove(headerPath.c_str());
+      throw;
+    }
+    std::remove(headerPath.c_str());
+
+    imageIO->SetDimensions(lastAxis, lastSize);
+    imageIO->SetIORegion(ioRegion);
+    imageIO->SetFileName(path);
+    const auto size = static_cast<std::size_t>(imageIO->GetImageSizeInBytes());
+
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    if (!output.is_open())
+      mitkThrow() << "Cannot open " << path << " for writing.";
+
+    if (isNrrd)
+    {
+      output.write(header.data(), static_cast<std::streamsize>(header.size()));
+      compressor.Write(std::string(), buffer, size, output);
+    }
+    else
+    {
+      compressor.Write(header, buffer, size, output);
+    }
+  }
+
   AbstractFileIO::ConfidenceLevel ItkImageIO::GetWriterConfidenceLevel() const
   {
     // Check if the image dimension is supported
@@ -763,7 +988,7 @@ namespace mitk
       return IFileWriter::Unsupported;
     }
 
-    if (!m_ImageIO->SupportsDimension(image->GetDimension()))
+    if (!this->GetImageIO()->SupportsDimension(image->GetDimension()))
     {
       // okay, dimension is not supported. We have to look at a special case:
       // 3D-Image with one slice. We can treat that as a 2D image.
@@ -782,6 +1007,21 @@ namespace mitk
   }
 
   ItkImageIO *ItkImageIO::IOClone() const { return new ItkImageIO(*this); }
+
+  itk::ImageIOBase *ItkImageIO::GetImageIO() const
+  {
+    std::lock_guard<std::mutex> lock(m_ImageIOMutex);
+    if (m_ImageIO.IsNull() && m_ImageIOFactory)
+    {
+      m_ImageIO = m_ImageIOFactory();
+    }
+
+    if (m_ImageIO.IsNull())
+    {
+      mitkThrow() << "Cannot create ITK ImageIO for " << this->AbstractFileReader::GetDescription();
+    }
+    return m_ImageIO;
+  }
   void ItkImageIO::InitializeDefaultMetaDataKeys()
   {
     this->m_DefaultMetaDataKeys.push_back("NRRD.space");
@@ -0,0 +1,83 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkItkImageIO.h"
+
+#include <itkBMPImageIO.h>
+#include <itkBioRadImageIO.h>
+#include <itkBruker2dseqImageIO.h>
+#include <itkGE4ImageIO.h>
+#include <itkGE5ImageIO.h>
+#include <itkGEAdwImageIO.h>
+#include <itkGiplImageIO.h>
+#include <itkHDF5ImageIO.h>
+#include <itkJPEG2000ImageIO.h>
+#include <itkJPEGImageIO.h>
+#include <itkLSMImageIO.h>
+#include <itkMINCImageIO.h>
+#include <itkMRCImageIO.h>
+#include <itkMetaImageIO.h>
+#include <itkNrrdImageIO.h>
+#include <itkPNGImageIO.h>
+#include <itkSiemensVisionImageIO.h>
+#include <itkStimulateImageIO.h>
+#include <itkTIFFImageIO.h>
+#include <itkVTKImageIO.h>
+
+namespace mitk
+{
+  namespace
+  {
+    template <typename TImageIO>
+    ItkImageIO::ImageIOInfo MakeImageIOInfo(const std::string &name,
+                                            const std::vector<std::string> &readExtensions,
+                                            const std::vector<std::string> &writeExtensions)
+    {
+      return {name, readExtensions, writeExtensions, []() -> itk::ImageIOBase::Pointer { return TImageIO::New().GetPointer(); }};
+    }
+
+    template <typename TImageIO>
+    ItkImageIO::ImageIOInfo MakeImageIOInfo(const std::string &name, const std::vector<std::string> &extensions)
+    {
+      return MakeImageIOInfo<TImageIO>(name, extensions, extensions);
+    }
+  }
+
+  const std::vector<ItkImageIO::ImageIOInfo> &ItkImageIO::GetKnownImageIOs()
+  {
+    // The extensions must match the ones reported by the ITK version MITK is built
+    // with, mitkItkImageIOTest compares them to the instantiated ImageIOs.
+    static const std::vector<ImageIOInfo> knownImageIOs = {
+      MakeImageIOInfo<itk::BioRadImageIO>("BioRadImageIO", {".pic"}),
+      MakeImageIOInfo<itk::BMPImageIO>("BMPImageIO", {".bmp", ".BMP"}),
+      MakeImageIOInfo<itk::Bruker2dseqImageIO>("Bruker2dseqImageIO", {}),
+      MakeImageIOInfo<itk::GE4ImageIO>("GE4ImageIO", {}),
+      MakeImageIOInfo<itk::GE5ImageIO>("GE5ImageIO", {}),
+      MakeImageIOInfo<itk::GEAdwImageIO>("GEAdwImageIO", {}),
+      MakeImageIOInfo<itk::GiplImageIO>("GiplImageIO", {".gipl", ".gipl.gz"}),
+      MakeImageIOInfo<itk::HDF5ImageIO>("HDF5ImageIO", {".hdf", ".h4", ".hdf4", ".h5", ".hdf5", ".he4", ".he5", ".hd5"}),
+      MakeImageIOInfo<itk::JPEGImageIO>("JPEGImageIO", {".jpg", ".JPG", ".jpeg", ".JPEG"}),
+      MakeImageIOInfo<itk::JPEG2000ImageIO>("JPEG2000ImageIO", {".j2k", ".jp2", ".jpt"}),
+      MakeImageIOInfo<itk::LSMImageIO>("LSMImageIO", {".tif", ".TIF", ".tiff", ".TIFF", ".lsm", ".LSM"}),
+      MakeImageIOInfo<itk::MetaImageIO>("MetaImageIO", {".mha", ".mhd"}),
+      MakeImageIOInfo<itk::MINCImageIO>("MINCImageIO", {".mnc", ".MNC"}),
+      MakeImageIOInfo<itk::MRCImageIO>("MRCImageIO", {".mrc", ".rec"}),
+      MakeImageIOInfo<itk::NrrdImageIO>("NrrdImageIO", {".nrrd", ".nhdr"}),
+      MakeImageIOInfo<itk::PNGImageIO>("PNGImageIO", {".png", ".PNG"}),
+      MakeImageIOInfo<itk::SiemensVisionImageIO>("SiemensVisionImageIO", {}),
+      MakeImageIOInfo<itk::StimulateImageIO>("StimulateImageIO", {".spr"}),
+      MakeImageIOInfo<itk::TIFFImageIO>("TIFFImageIO", {".tif", ".TIF", ".tiff", ".TIFF"}),
+      MakeImageIOInfo<itk::VTKImageIO>("VTKImageIO", {".vtk"})
+    };
+    return knownImageIOs;
+  }
+}
@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "mitkMimeTypeProvider.h"
 
+#include "mitkFileProbe.h"
 #include "mitkLog.h"
 
 #include <usGetModuleContext.h>
@@ -51,14 +52,40 @@ namespace mitk
   std::vector<MimeType> MimeTypeProvider::GetMimeTypesForFile(const std::string &filePath) const
   {
     std::vector<MimeType> result;
-    for (const auto &elem : m_NameToMimeType)
+
+    // Look up mime-types that only check extensions by all suffixes of the path
+    // that have the length of a registered extension.
+    std::string lowerCasePath(filePath);
+    std::transform(lowerCasePath.begin(), lowerCasePath.end(), lowerCasePath.begin(), ::tolower);
+    for (auto length : m_ExtensionLengths)
     {
-      if (elem.second.AppliesTo(filePath))
+      if (length > lowerCasePath.size())
+        break;
+
+      auto iter = m_ExtensionToMimeTypes.find(lowerCasePath.substr(lowerCasePath.size() - length));
+      if (iter != m_ExtensionToMimeTypes.end())
       {
-        result.push_back(elem.second);
+        result.insert(result.end(), iter->second.begin(), iter->second.end());
+      }
+    }
+
+    if (!m_ContentMimeTypes.empty())
+    {
+      // Keep the probe alive, so that all mime-types share the header of the file
+      // even if other files are probed concurrently.
+      auto probe = FileProbe::Get(filePath);
+
+      for (const auto &mimeType : m_ContentMimeTypes)
+      {
+        if (mimeType.AppliesTo(filePath))
+        {
+          result.push_back(mimeType);
+        }
       }
     }
+
     std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
     std::reverse(result.begin(), result.end());
     return result;
   }
@@ -110,6 +137,7 @@ namespace mitk
 
       // get the highest ranked mime-type
       m_NameToMimeType[name] = *(m_NameToMimeTypes[name].rbegin());
+      this->UpdateExtensionIndex();
     }
     return result;
   }
@@ -134,6 +162,33 @@ namespace mitk
       // get the highest ranked mime-type
       m_NameToMimeType[name] = *(mimeTypes.rbegin());
     }
+    this->UpdateExtensionIndex();
+  }
+
+  void MimeTypeProvider::UpdateExtensionIndex()
+  {
+    m_ExtensionToMimeTypes.clear();
+    m_ExtensionLengths.clear();
+    m_ContentMimeTypes.clear();
+
+    for (const auto &elem : m_NameToMimeType)
+    {
+      if (elem.second.ChecksFileContent())
+      {
+        m_ContentMimeTypes.push_back(elem.second);
+        continue;
+      }
+
+      for (auto extension : elem.second.GetExtensions())
+      {
+        if (extension.empty())
+          continue;
+
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        m_ExtensionToMimeTypes[extension].push_back(elem.second);
+        m_ExtensionLengths.insert(extension.size());
+      }
+    }
   }
 
   MimeType MimeTypeProvider::GetMimeType(const ServiceReferenceType &reference) const
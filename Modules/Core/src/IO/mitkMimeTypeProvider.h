@@ -55,12 +55,21 @@ namespace mitk
 
     MimeType GetMimeType(const ServiceReferenceType &reference) const;
 
+    void UpdateExtensionIndex();
+
     us::ServiceTracker<CustomMimeType, MimeTypeTrackerTypeTraits> *m_Tracker;
 
     typedef std::map<std::string, std::set<MimeType>> MapType;
     MapType m_NameToMimeTypes;
 
     std::map<std::string, MimeType> m_NameToMimeType;
+
+    // lower case extension -> mime-types that only check the extension of a path
+    std::map<std::string, std::vector<MimeType>> m_ExtensionToMimeTypes;
+    std::set<std::size_t> m_ExtensionLengths;
+
+    // mime-types that have to be asked via AppliesTo()
+    std::vector<MimeType> m_ContentMimeTypes;
   };
 }
 
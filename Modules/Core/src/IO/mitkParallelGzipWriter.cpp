@@ -0,0 +1,229 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkParallelGzipWriter.h"
+
+#include <mitkExceptionMacro.h>
+
+#include <itk_zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  struct Block
+  {
+    std::vector<char> input;
+    std::vector<unsigned char> output;
+    uLong crc = 0;
+    bool isLast = false;
+    bool failed = false;
+  };
+
+  // Deflates the block as raw deflate data without zlib or gzip header. All blocks but the last one
+  // end with a sync flush, i.e. on a byte boundary without the final bit, so they can be concatenated.
+  void CompressBlock(Block &block, int level)
+  {
+    block.crc = crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<const Bytef *>(block.input.data()), static_cast<uInt>(block.input.size()));
+
+    z_stream stream = {};
+    if (Z_OK != deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY))
+    {
+      block.failed = true;
+      return;
+    }
+
+    // the bound is computed for Z_FINISH, a sync flush needs a few bytes more
+    block.output.resize(deflateBound(&stream, static_cast<uLong>(block.input.size())) + 16);
+    stream.next_in = reinterpret_cast<Bytef *>(block.input.data());
+    stream.avail_in = static_cast<uInt>(block.input.size());
+    stream.next_out = block.output.data();
+    stream.avail_out = static_cast<uInt>(block.output.size());
+
+    const auto result = deflate(&stream, block.isLast ? Z_FINISH : Z_SYNC_FLUSH);
+    block.failed = block.isLast ? result != Z_STREAM_END : (result != Z_OK || stream.avail_in != 0 || stream.avail_out == 0);
+    block.output.resize(stream.total_out);
+    deflateEnd(&stream);
+  }
+
+  void WriteLittleEndian(std::ostream &output, uLong value)
+  {
+    for (int i = 0; i < 4; ++i)
+    {
+      output.put(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+  }
+}
+
+mitk::ParallelGzipWriter::ParallelGzipWriter()
+  : m_NumberOfThreads(0), m_CompressionLevel(6), m_BlockSize(128 * 1024)
+{
+}
+
+void mitk::ParallelGzipWriter::SetNumberOfThreads(unsigned int numberOfThreads)
+{
+  m_NumberOfThreads = numberOfThreads;
+}
+
+unsigned int mitk::ParallelGzipWriter::GetNumberOfThreads() const
+{
+  return m_NumberOfThreads;
+}
+
+void mitk::ParallelGzipWriter::SetCompressionLevel(int level)
+{
+  m_CompressionLevel = std::max(0, std::min(9, level));
+}
+
+int mitk::ParallelGzipWriter::GetCompressionLevel() const
+{
+  return m_CompressionLevel;
+}
+
+void mitk::ParallelGzipWriter::SetBlockSize(std::size_t blockSize)
+{
+  m_BlockSize = std::max<std::size_t>(1, blockSize);
+}
+
+std::size_t mitk::ParallelGzipWriter::GetBlockSize() const
+{
+  return m_BlockSize;
+}
+
+void mitk::ParallelGzipWriter::Write(std::istream &input, std::ostream &output) const
+{
+  this->Write(
+    [&](std::vector<char> &block) {
+      block.resize(m_BlockSize);
+      input.read(block.data(), static_cast<std::streamsize>(m_BlockSize));
+      block.resize(static_cast<std::size_t>(input.gcount()));
+      if (input.bad())
+        mitkThrow() << "Cannot read the data to compress.";
+
+      // an empty input results in a single, empty final block
+      return std::char_traits<char>::eq_int_type(input.peek(), std::char_traits<char>::eof());
+    },
+    output);
+}
+
+void mitk::ParallelGzipWriter::Write(const std::string &prefix, const void *data, std::size_t size, std::ostream &output) const
+{
+  const auto *bytes = static_cast<const char *>(data);
+  std::size_t position = 0;
+  const std::size_t totalSize = prefix.size() + size;
+
+  this->Write(
+    [&](std::vector<char> &block) {
+      const auto blockSize = std::min(m_BlockSize, totalSize - position);
+      block.resize(blockSize);
+
+      // the block may start in the prefix and continue in the data
+      std::size_t offset = 0;
+      if (position < prefix.size())
+      {
+        offset = std::min(blockSize, prefix.size() - position);
+        std::copy_n(prefix.data() + position, offset, block.data());
+      }
+      if (offset < blockSize)
+        std::copy_n(bytes + (position + offset - prefix.size()), blockSize - offset, block.data() + offset);
+
+      position += blockSize;
+      return position == totalSize;
+    },
+    output);
+}
+
+void mitk::ParallelGzipWriter::Write(const std::function<bool(std::vector<char> &)> &readBlock, std::ostream &output) const
+{
+  const unsigned int numberOfThreads =
+    m_NumberOfThreads > 0 ? m_NumberOfThreads : std::max(1u, std::thread::hardware_concurrency());
+
+  // gzip header: magic, deflate, no flags, no modification time, no extra flags, unknown OS
+  const char header[10] = {'\x1f', '\x8b', 8, 0, 0, 0, 0, 0, 0, '\xff'};
+  output.write(header, sizeof(header));
+
+  // A few blocks per thread are read and compressed at once, which bounds the memory and keeps
+  // all threads busy even if some blocks compress faster than others.
+  std::vector<Block> blocks(numberOfThreads * 4);
+  uLong crc = crc32(0L, Z_NULL, 0);
+  std::size_t totalSize = 0;
+  bool isLastBatch = false;
+
+  while (!isLastBatch)
+  {
+    std::size_t numberOfBlocks = 0;
+    while (numberOfBlocks < blocks.size() && !isLastBatch)
+    {
+      auto &block = blocks[numberOfBlocks++];
+      isLastBatch = readBlock(block.input);
+      block.isLast = isLastBatch;
+    }
+
+    std::atomic<std::size_t> nextBlock(0);
+    auto compressBlocks = [&]() {
+      for (auto i = nextBlock++; i < numberOfBlocks; i = nextBlock++)
+      {
+        CompressBlock(blocks[i], m_CompressionLevel);
+      }
+    };
+
+    std::vector<std::thread> threads;
+    const auto numberOfWorkers = std::min<std::size_t>(numberOfThreads, numberOfBlocks);
+    for (std::size_t i = 1; i < numberOfWorkers; ++i)
+    {
+      threads.emplace_back(compressBlocks);
+    }
+    compressBlocks();
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+
+    for (std::size_t i = 0; i < numberOfBlocks; ++i)
+    {
+      const auto &block = blocks[i];
+      if (block.failed)
+        mitkThrow() << "Cannot compress the data. zlib failed.";
+
+      output.write(reinterpret_cast<const char *>(block.output.data()), static_cast<std::streamsize>(block.output.size()));
+      crc = crc32_combine(crc, block.crc, static_cast<z_off_t>(block.input.size()));
+      totalSize += block.input.size();
+    }
+
+    if (!output)
+      mitkThrow() << "Cannot write the compressed data.";
+  }
+
+  // gzip trailer: CRC-32 and size modulo 2^32 of the uncompressed data
+  WriteLittleEndian(output, crc);
+  WriteLittleEndian(output, static_cast<uLong>(totalSize & 0xffffffffUL));
+
+  if (!output)
+    mitkThrow() << "Cannot write the compressed data.";
+}
+
+void mitk::ParallelGzipWriter::WriteFile(const std::string &inputPath, const std::string &outputPath) const
+{
+  std::ifstream input(inputPath, std::ios::binary);
+  if (!input.is_open())
+    mitkThrow() << "Cannot open " << inputPath << " for reading.";
+
+  std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+  if (!output.is_open())
+    mitkThrow() << "Cannot open " << outputPath << " for writing.";
+
+  this->Write(input, output);
+}
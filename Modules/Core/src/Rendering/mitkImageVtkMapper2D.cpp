@@ -265,6 +265,8 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     }
   }
 
+  localStorage->m_ModifiedRegionMargin = thickSlicesMode > 0 ? thickSlicesNum + 1.0 : 1.0;
+
   const auto *planeGeometry = dynamic_cast<const PlaneGeometry *>(worldGeometry);
 
   if (thickSlicesMode > 0)
@@ -704,17 +706,33 @@ void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
   const DataNode *node = this->GetDataNode();
   data->UpdateOutputInformation();
 
-  // check if something important has changed and we need to rerender
-  if ((localStorage->m_LastUpdateTime < node->GetMTime()) ||
-      (localStorage->m_LastUpdateTime < data->GetPipelineMTime()) ||
+  // check if something important has changed and we need to rerender.
+  // DataNode::GetMTime() includes the MTime of the image, so only the node's own MTime is
+  // compared here. Changes of the image itself are handled below.
+  if ((localStorage->m_LastUpdateTime < node->GetDataReferenceChangedTime()) ||
       (localStorage->m_LastUpdateTime < renderer->GetCurrentWorldPlaneGeometryUpdateTime()) ||
       (localStorage->m_LastUpdateTime < renderer->GetCurrentWorldPlaneGeometry()->GetMTime()) ||
       (localStorage->m_LastUpdateTime < node->GetPropertyList()->GetMTime()) ||
       (localStorage->m_LastUpdateTime < node->GetPropertyList(renderer)->GetMTime()) ||
-      (localStorage->m_LastUpdateTime < data->GetPropertyList()->GetMTime()))
+      (localStorage->m_LastUpdateTime < data->GetPropertyList()->GetMTime()) ||
+      (localStorage->m_LastUpdateTime < node->itk::Object::GetMTime()) ||
+      (localStorage->m_LastUpdateTime < data->GetPipelineMTime()))
   {
     this->GenerateDataForRenderer(renderer);
   }
+  else if (localStorage->m_LastUpdateTime < data->GetMTime())
+  {
+    // only the image itself was modified; writers that announce the modified region
+    // (see Image::RegionModified()) do not require reslicing views that are far away.
+    // A modified source is not covered by the regions of the image, so it always regenerates (see above).
+    if (data->IsModifiedNearPlaneSince(localStorage->m_LastUpdateTime,
+                                       this->GetTimestep(),
+                                       renderer->GetCurrentWorldPlaneGeometry(),
+                                       localStorage->m_ModifiedRegionMargin))
+    {
+      this->GenerateDataForRenderer(renderer);
+    }
+  }
 
   // since we have checked that nothing important has changed, we can set
   // m_LastUpdateTime to the current time
@@ -35,9 +35,10 @@ found in the LICENSE file.
 #include "mitkLegacyFileWriterService.h"
 #include <mitkFileWriter.h>
 
-#include <itkGDCMImageIO.h>
 #include <itkNiftiImageIO.h>
 
+#include <set>
+
 // PropertyRelationRules
 #include <mitkPropertyRelationRuleBase.h>
 
@@ -365,36 +366,66 @@ void MitkCoreActivator::RegisterDefaultMimeTypes()
 
 void MitkCoreActivator::RegisterItkReaderWriter()
 {
-  std::list<itk::LightObject::Pointer> allobjects = itk::ObjectFactoryBase::CreateAllInstance("itkImageIOBase");
+  // Collect the names of all registered ImageIO overrides without instantiating them.
+  // Instantiating every ImageIO at startup is expensive, so known ImageIOs are
+  // registered from static meta data and only created when they are used.
+  // GetRegisteredFactories() does not initialize the factories (e.g. the ones
+  // loaded from ITK_AUTOLOAD_PATH), only creating an instance does. A class name
+  // without overrides initializes them without instantiating any ImageIO.
+  itk::ObjectFactoryBase::CreateAllInstance("mitkCoreActivatorFactoryInitialization");
+
+  std::set<std::string> imageIONames;
+  for (auto *factory : itk::ObjectFactoryBase::GetRegisteredFactories())
+  {
+    const auto overrides = factory->GetClassOverrideNames();
+    const auto overrideNames = factory->GetClassOverrideWithNames();
+    auto overrideName = overrideNames.begin();
+    for (auto overridden = overrides.begin(); overridden != overrides.end() && overrideName != overrideNames.end();
+         ++overridden, ++overrideName)
+    {
+      if (*overridden == "itkImageIOBase")
+        imageIONames.insert(*overrideName);
+    }
+  }
 
-  for (auto &allobject : allobjects)
+  // NiftiImageIO does not provide a correct "SupportsDimension()" methods
+  // and the supported read/write extensions are not ordered correctly.
+  // MITK provides its own DICOM reader (which internally uses GDCMImageIO).
+  imageIONames.erase("itkNiftiImageIO");
+  imageIONames.erase("itkGDCMImageIO");
+
+  for (const auto &info : mitk::ItkImageIO::GetKnownImageIOs())
   {
-    auto *io = dynamic_cast<itk::ImageIOBase *>(allobject.GetPointer());
+    if (imageIONames.erase("itk" + info.Name) > 0)
+      m_FileIOs.push_back(new mitk::ItkImageIO(info));
+  }
 
-    // NiftiImageIO does not provide a correct "SupportsDimension()" methods
-    // and the supported read/write extensions are not ordered correctly
-    if (dynamic_cast<itk::NiftiImageIO *>(io))
-      continue;
+  if (!imageIONames.empty())
+  {
+    // ImageIOs without static meta data have to be instantiated to query their extensions
+    std::list<itk::LightObject::Pointer> allobjects = itk::ObjectFactoryBase::CreateAllInstance("itkImageIOBase");
 
-    // Use a custom mime-type for GDCMImageIO below
-    if (dynamic_cast<itk::GDCMImageIO *>(allobject.GetPointer()))
+    for (auto &allobject : allobjects)
     {
-      // MITK provides its own DICOM reader (which internally uses GDCMImageIO).
-      continue;
-    }
+      if (imageIONames.count(std::string("itk") + allobject->GetNameOfClass()) == 0)
+        continue;
 
-    if (io)
-    {
-      m_FileIOs.push_back(new mitk::ItkImageIO(io));
-    }
-    else
-    {
-      MITK_WARN << "Error ImageIO factory did not return an ImageIOBase: " << (allobject)->GetNameOfClass();
+      auto *io = dynamic_cast<itk::ImageIOBase *>(allobject.GetPointer());
+      if (io)
+      {
+        m_FileIOs.push_back(new mitk::ItkImageIO(io));
+      }
+      else
+      {
+        MITK_WARN << "Error ImageIO factory did not return an ImageIOBase: " << (allobject)->GetNameOfClass();
+      }
     }
   }
 
-  FixedNiftiImageIO::Pointer itkNiftiIO = FixedNiftiImageIO::New();
-  mitk::ItkImageIO *niftiIO = new mitk::ItkImageIO(mitk::IOMimeTypes::NIFTI_MIMETYPE(), itkNiftiIO.GetPointer(), 0);
+  mitk::ItkImageIO *niftiIO = new mitk::ItkImageIO(mitk::IOMimeTypes::NIFTI_MIMETYPE(),
+                                                   "FixedNiftiImageIO",
+                                                   []() -> itk::ImageIOBase::Pointer { return FixedNiftiImageIO::New().GetPointer(); },
+                                                   0);
   m_FileIOs.push_back(niftiIO);
 }
 
@@ -27,6 +27,7 @@ set(MODULE_TESTS
   mitkActionTest.cpp
   mitkDispatcherTest.cpp
   mitkEnumerationPropertyTest.cpp
+  mitkFileProbeTest.cpp
   mitkFileReaderRegistryTest.cpp
   #mitkFileWriterRegistryTest.cpp
   mitkFloatToStringTest.cpp
@@ -38,6 +39,7 @@ set(MODULE_TESTS
   mitkImageCastTest.cpp
   mitkImageDataItemTest.cpp
   mitkImageGeneratorTest.cpp
+  mitkImageModifiedRegionTest.cpp
   mitkIOUtilTest.cpp
   mitkBaseDataTest.cpp
   mitkImportItkImageTest.cpp
@@ -45,6 +47,7 @@ set(MODULE_TESTS
   mitkInstantiateAccessFunctionTest.cpp
   mitkLevelWindowTest.cpp
   mitkMessageTest.cpp
+  mitkParallelGzipWriterTest.cpp
   mitkPixelTypeTest.cpp
   mitkPlaneGeometryTest.cpp
   mitkPointSetTest.cpp
@@ -124,6 +127,7 @@ set(MODULE_TESTS
 )
 
 set(MODULE_RENDERING_TESTS
+  mitkImageVtkMapper2DUpdateTest.cpp
   mitkPointSetDataInteractorTest.cpp
   mitkSurfaceVtkMapper2DTest.cpp
   mitkSurfaceVtkMapper2D3DTest.cpp
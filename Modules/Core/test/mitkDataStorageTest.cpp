@@ -59,10 +59,17 @@ class DSEventReceiver // Helper class for event testing
 public:
   const mitk::DataNode *m_NodeAdded;
   const mitk::DataNode *m_NodeRemoved;
+  mitk::DataStorage::BatchChanges m_BatchChanges;
+  unsigned int m_NumberOfBatches;
 
-  DSEventReceiver() : m_NodeAdded(nullptr), m_NodeRemoved(nullptr) {}
+  DSEventReceiver() : m_NodeAdded(nullptr), m_NodeRemoved(nullptr), m_NumberOfBatches(0) {}
   void OnAdd(const mitk::DataNode *node) { m_NodeAdded = node; }
   void OnRemove(const mitk::DataNode *node) { m_NodeRemoved = node; }
+  void OnBatch(const mitk::DataStorage::BatchChanges &changes)
+  {
+    m_BatchChanges = changes;
+    ++m_NumberOfBatches;
+  }
 };
 
 ///
@@ -819,6 +826,57 @@ void TestDataStorage(mitk::DataStorage *ds, std::string filename)
     MITK_TEST_FAILED_MSG(<< "Exception during object removal methods");
   }
 
+  /* Checking batches */
+  {
+    DSEventReceiver batchListener;
+    ds->BatchCommittedEvent +=
+      mitk::MessageDelegate1<DSEventReceiver, const mitk::DataStorage::BatchChanges &>(&batchListener, &DSEventReceiver::OnBatch);
+
+    mitk::DataNode::Pointer existing = mitk::DataNode::New();
+    ds->Add(existing);
+
+    mitk::DataNode::Pointer added1 = mitk::DataNode::New();
+    mitk::DataNode::Pointer added2 = mitk::DataNode::New();
+    mitk::DataNode::Pointer transient = mitk::DataNode::New();
+    {
+      mitk::DataStorage::Batch batch(ds);
+      MITK_TEST_CONDITION(ds->IsBatchActive(), "Checking IsBatchActive() in a batch");
+
+      ds->Add(added1);
+      ds->Add(transient);
+      {
+        // nested batches are committed with the outermost batch
+        mitk::DataStorage::Batch nestedBatch(ds);
+        ds->Add(added2);
+        ds->Remove(existing);
+      }
+      MITK_TEST_CONDITION(batchListener.m_NumberOfBatches == 0, "Checking no BatchCommittedEvent for nested batch");
+      ds->Remove(transient);
+    }
+
+    MITK_TEST_CONDITION(!ds->IsBatchActive(), "Checking IsBatchActive() after a batch");
+    MITK_TEST_CONDITION(batchListener.m_NumberOfBatches == 1, "Checking one BatchCommittedEvent per batch");
+    MITK_TEST_CONDITION(batchListener.m_BatchChanges.AddedNodes.size() == 2 &&
+                          batchListener.m_BatchChanges.AddedNodes[0] == added1.GetPointer() &&
+                          batchListener.m_BatchChanges.AddedNodes[1] == added2.GetPointer(),
+                        "Checking added nodes of batch");
+    MITK_TEST_CONDITION(batchListener.m_BatchChanges.RemovedNodes.size() == 1 &&
+                          batchListener.m_BatchChanges.RemovedNodes[0] == existing.GetPointer(),
+                        "Checking removed nodes of batch");
+
+    // an empty batch emits no event
+    ds->BeginBatch();
+    ds->CommitBatch();
+    MITK_TEST_CONDITION(batchListener.m_NumberOfBatches == 1, "Checking no BatchCommittedEvent for empty batch");
+    MITK_TEST_FOR_EXCEPTION(mitk::Exception, ds->CommitBatch());
+
+    ds->BatchCommittedEvent -=
+      mitk::MessageDelegate1<DSEventReceiver, const mitk::DataStorage::BatchChanges &>(&batchListener, &DSEventReceiver::OnBatch);
+    batchListener.m_BatchChanges = mitk::DataStorage::BatchChanges();
+    ds->Remove(added1);
+    ds->Remove(added2);
+  }
+
   // Checking ComputeBoundingGeometry3D method*/
   const mitk::DataStorage::SetOfObjects::ConstPointer all = ds->GetAll();
   auto geometry = ds->ComputeBoundingGeometry3D();
@@ -0,0 +1,231 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkCoreServices.h>
+#include <mitkFileProbe.h>
+#include <mitkIMimeTypeProvider.h>
+#include <mitkIOMimeTypes.h>
+#include <mitkIOUtil.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+class mitkFileProbeTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkFileProbeTestSuite);
+  MITK_TEST(TestHeader);
+  MITK_TEST(TestCache);
+  MITK_TEST(TestCacheReplacedFile);
+  MITK_TEST(TestEvaluate);
+  MITK_TEST(TestExcludesText);
+  MITK_TEST(TestDicomExplicitVR);
+  MITK_TEST(TestDicomImplicitVR);
+  MITK_TEST(TestNoDicom);
+  MITK_TEST(TestMimeTypesForFile);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::string m_FileName;
+
+  void WriteFile(const std::string &content)
+  {
+    std::ofstream file(m_FileName, std::ios::binary | std::ios::trunc);
+    file.write(content.data(), content.size());
+  }
+
+  static std::string UInt16(unsigned int value) { return std::string{char(value & 0xFF), char((value >> 8) & 0xFF)}; }
+
+  static std::string UInt32(unsigned int value) { return UInt16(value & 0xFFFF) + UInt16(value >> 16); }
+
+  static std::string Pad(std::string value)
+  {
+    if (value.size() % 2 != 0)
+      value += ' ';
+    return value;
+  }
+
+  static std::string ExplicitElement(unsigned int group, unsigned int element, const std::string &vr, std::string value)
+  {
+    value = Pad(value);
+    return UInt16(group) + UInt16(element) + vr + UInt16(static_cast<unsigned int>(value.size())) + value;
+  }
+
+  static std::string ImplicitElement(unsigned int group, unsigned int element, std::string value)
+  {
+    value = Pad(value);
+    return UInt16(group) + UInt16(element) + UInt32(static_cast<unsigned int>(value.size())) + value;
+  }
+
+  static std::string DicomPrefix(const std::string &transferSyntax)
+  {
+    std::string uid = transferSyntax;
+    if (uid.size() % 2 != 0)
+      uid += '\0';
+    return std::string(128, '\0') + "DICM" + ExplicitElement(0x0002, 0x0010, "UI", uid);
+  }
+
+public:
+  void setUp() override { m_FileName = mitk::IOUtil::CreateTemporaryFile("FileProbeTest_XXXXXX.dcm"); }
+
+  void tearDown() override
+  {
+    std::remove(m_FileName.c_str());
+    mitk::FileProbe::ClearCache();
+  }
+
+  void TestHeader()
+  {
+    this->WriteFile("NRRD0004\ntype: short\n\n");
+
+    auto probe = mitk::FileProbe::Get(m_FileName);
+    CPPUNIT_ASSERT_MESSAGE("File exists", probe->Exists());
+    CPPUNIT_ASSERT_MESSAGE("File is no directory", !probe->IsDirectory());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("File size", std::uint64_t(22), probe->GetFileSize());
+    CPPUNIT_ASSERT_MESSAGE("Small files are read completely", probe->IsHeaderComplete());
+    CPPUNIT_ASSERT_MESSAGE("Magic is found", probe->HeaderStartsWith("NRRD"));
+    CPPUNIT_ASSERT_MESSAGE("Other magic is not found", !probe->HeaderStartsWith("DICM"));
+
+    auto missing = mitk::FileProbe::Get(m_FileName + ".missing");
+    CPPUNIT_ASSERT_MESSAGE("Missing file does not exist", !missing->Exists());
+    CPPUNIT_ASSERT_MESSAGE("Missing file has no header", missing->GetHeader().empty());
+  }
+
+  void TestCache()
+  {
+    this->WriteFile("first content");
+    auto probe = mitk::FileProbe::Get(m_FileName);
+    CPPUNIT_ASSERT_MESSAGE("Probe is shared", probe == mitk::FileProbe::Get(m_FileName));
+
+    this->WriteFile("modified content");
+    auto modifiedProbe = mitk::FileProbe::Get(m_FileName);
+    CPPUNIT_ASSERT_MESSAGE("Modified file is probed again", probe != modifiedProbe);
+    CPPUNIT_ASSERT_MESSAGE("Modified header is read", modifiedProbe->HeaderStartsWith("modified"));
+  }
+
+  void TestCacheReplacedFile()
+  {
+    this->WriteFile("first");
+    auto probe = mitk::FileProbe::Get(m_FileName);
+
+    // another file of the same size and modification time replaces the probed one
+    const std::string otherFileName = m_FileName + ".other";
+    {
+      std::ofstream file(otherFileName, std::ios::binary | std::ios::trunc);
+      file << "other";
+    }
+    std::filesystem::last_write_time(otherFileName, std::filesystem::last_write_time(m_FileName));
+    std::filesystem::rename(otherFileName, m_FileName);
+
+    auto replacedProbe = mitk::FileProbe::Get(m_FileName);
+    CPPUNIT_ASSERT_MESSAGE("Replaced file is probed again", probe != replacedProbe);
+    CPPUNIT_ASSERT_MESSAGE("Header of the replacing file is read", replacedProbe->HeaderStartsWith("other"));
+  }
+
+  void TestEvaluate()
+  {
+    this->WriteFile("content");
+    auto probe = mitk::FileProbe::Get(m_FileName);
+
+    int numberOfEvaluations = 0;
+    auto predicate = [&numberOfEvaluations]() {
+      ++numberOfEvaluations;
+      return true;
+    };
+
+    CPPUNIT_ASSERT_MESSAGE("Result of first evaluation", probe->Evaluate("key", predicate));
+    CPPUNIT_ASSERT_MESSAGE("Stored result", mitk::FileProbe::Get(m_FileName)->Evaluate("key", predicate));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Predicate is evaluated once", 1, numberOfEvaluations);
+
+    probe->Evaluate("other key", predicate);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Keys are evaluated separately", 2, numberOfEvaluations);
+  }
+
+  void TestExcludesText()
+  {
+    this->WriteFile("NRRD0004\nmodality:=org.mitk.image\n\nbinary data org.mitk.image.multilabel");
+    auto probe = mitk::FileProbe::Get(m_FileName);
+    CPPUNIT_ASSERT_MESSAGE("Text after the header is ignored", probe->ExcludesText("org.mitk.image.multilabel", "\n\n"));
+    CPPUNIT_ASSERT_MESSAGE("Text in the header is found", !probe->ExcludesText("org.mitk.image", "\n\n"));
+
+    std::string header = "NRRD0004\n" + std::string(mitk::FileProbe::HeaderSize, 'x');
+    this->WriteFile(header + "\n\n");
+    CPPUNIT_ASSERT_MESSAGE("Incomplete header cannot rule out text",
+                           !mitk::FileProbe::Get(m_FileName)->ExcludesText("org.mitk.image.multilabel", "\n\n"));
+  }
+
+  void TestDicomExplicitVR()
+  {
+    this->WriteFile(DicomPrefix("1.2.840.10008.1.2.1") +
+                    ExplicitElement(0x0008, 0x0005, "CS", "ISO_IR 100") +
+                    UInt16(0x0008) + UInt16(0x0006) + "SQ" + UInt16(0) + UInt32(8) + std::string(8, '\0') +
+                    ExplicitElement(0x0008, 0x0016, "UI", "1.2.840.10008.5.1.4.1.1.66.4") +
+                    ExplicitElement(0x0008, 0x0060, "CS", "SEG") +
+                    UInt16(0x7FE0) + UInt16(0x0010) + "OB" + UInt16(0) + UInt32(4) + "data");
+
+    auto probe = mitk::FileProbe::Get(m_FileName);
+    CPPUNIT_ASSERT_MESSAGE("File is DICOM", probe->IsDicom());
+
+    std::string value;
+    CPPUNIT_ASSERT_MESSAGE("Transfer syntax is found", probe->FindDicomElement(0x0002, 0x0010, value));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Transfer syntax", std::string("1.2.840.10008.1.2.1"), value);
+    CPPUNIT_ASSERT_MESSAGE("SOP class is found", probe->FindDicomElement(0x0008, 0x0016, value));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("SOP class", std::string("1.2.840.10008.5.1.4.1.1.66.4"), value);
+    CPPUNIT_ASSERT_MESSAGE("Modality is found", probe->FindDicomElement(0x0008, 0x0060, value));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Padding is removed", std::string("SEG"), value);
+    CPPUNIT_ASSERT_MESSAGE("Missing element is decided", probe->FindDicomElement(0x0008, 0x0020, value));
+    CPPUNIT_ASSERT_MESSAGE("Missing element is empty", value.empty());
+  }
+
+  void TestDicomImplicitVR()
+  {
+    this->WriteFile(DicomPrefix("1.2.840.10008.1.2") +
+                    ImplicitElement(0x0008, 0x0016, "1.2.840.10008.5.1.4.1.1.481.2") +
+                    UInt16(0x0008) + UInt16(0x0050) + UInt32(0xFFFFFFFF) +
+                    ImplicitElement(0x0008, 0x0060, "RTDOSE"));
+
+    auto probe = mitk::FileProbe::Get(m_FileName);
+    std::string value;
+    CPPUNIT_ASSERT_MESSAGE("Element before undefined length is found", probe->FindDicomElement(0x0008, 0x0016, value));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("SOP class", std::string("1.2.840.10008.5.1.4.1.1.481.2"), value);
+    CPPUNIT_ASSERT_MESSAGE("Element after undefined length cannot be decided",
+                           !probe->FindDicomElement(0x0008, 0x0060, value));
+  }
+
+  void TestNoDicom()
+  {
+    this->WriteFile(std::string(200, 'x'));
+    auto probe = mitk::FileProbe::Get(m_FileName);
+    std::string value;
+    CPPUNIT_ASSERT_MESSAGE("File is no DICOM", !probe->IsDicom());
+    CPPUNIT_ASSERT_MESSAGE("No element can be decided", !probe->FindDicomElement(0x0008, 0x0060, value));
+  }
+
+  void TestMimeTypesForFile()
+  {
+    mitk::CoreServicePointer<mitk::IMimeTypeProvider> mimeTypeProvider(mitk::CoreServices::GetMimeTypeProvider());
+
+    const auto nrrdName = mitk::IOMimeTypes::NRRD_MIMETYPE_NAME();
+    bool found = false;
+    for (const auto &mimeType : mimeTypeProvider->GetMimeTypesForFile("/path/to/Image.NRRD"))
+      found = found || mimeType.GetName() == nrrdName;
+    CPPUNIT_ASSERT_MESSAGE("Extension index is case insensitive", found);
+
+    for (const auto &mimeType : mimeTypeProvider->GetMimeTypesForFile("/path/to/Image.nrrd.bak"))
+      CPPUNIT_ASSERT_MESSAGE("Only suffixes match", mimeType.GetName() != nrrdName);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkFileProbe)
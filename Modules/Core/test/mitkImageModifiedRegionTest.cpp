@@ -0,0 +1,167 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkImage.h>
+#include <mitkImageGenerator.h>
+#include <mitkImageStatisticsHolder.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkPlaneGeometry.h>
+
+#include <itkCommand.h>
+
+#include <algorithm>
+
+class mitkImageModifiedRegionTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageModifiedRegionTestSuite);
+
+  MITK_TEST(Modified_MakesRegionUnknown);
+  MITK_TEST(RegionModified_ReportsUnionOfNewerRegions);
+  MITK_TEST(RegionModified_InvokesEvent);
+  MITK_TEST(IsModifiedNearPlaneSince_ChecksPlaneAndTimeStep);
+  MITK_TEST(Statistics_AreRecomputedForModifiedTimeStepOnly);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  mitk::Image::RegionType m_ReceivedRegion;
+  unsigned int m_NumberOfEvents;
+
+  void OnRegionModified(const itk::EventObject &event)
+  {
+    m_ReceivedRegion = static_cast<const mitk::Image::RegionModifiedEvent &>(event).GetRegion();
+    ++m_NumberOfEvents;
+  }
+
+  static itk::ImageRegion<3> CreateRegion(long x, long y, long z, unsigned long sizeX, unsigned long sizeY, unsigned long sizeZ)
+  {
+    itk::ImageRegion<3> region;
+    region.SetIndex({{x, y, z}});
+    region.SetSize({{sizeX, sizeY, sizeZ}});
+    return region;
+  }
+
+  mitk::PlaneGeometry::Pointer CreateAxialPlane(int slice)
+  {
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(m_Image->GetGeometry(), mitk::AnatomicalPlane::Axial, slice);
+    return plane;
+  }
+
+  void FillVolume(mitk::TimeStepType timeStep, unsigned char value)
+  {
+    mitk::ImageWriteAccessor access(m_Image, m_Image->GetVolumeData(timeStep));
+    auto *data = static_cast<unsigned char *>(access.GetData());
+    std::fill(data, data + 10 * 10 * 10, value);
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::ImageGenerator::GenerateRandomImage<unsigned char>(10, 10, 10, 2, 1, 1, 1, 200, 100);
+    m_NumberOfEvents = 0;
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void Modified_MakesRegionUnknown()
+  {
+    const auto time = m_Image->GetMTime();
+    mitk::Image::RegionType region;
+    CPPUNIT_ASSERT_MESSAGE("Unmodified image", m_Image->GetModifiedRegionSince(time, region));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Nothing was modified", itk::SizeValueType(0), region.GetNumberOfPixels());
+
+    m_Image->RegionModified(CreateRegion(1, 1, 1, 2, 2, 2), 0);
+    m_Image->Modified();
+    CPPUNIT_ASSERT_MESSAGE("Plain modification has no region", !m_Image->GetModifiedRegionSince(time, region));
+    CPPUNIT_ASSERT_MESSAGE("Plain modification may affect every plane",
+                           m_Image->IsModifiedNearPlaneSince(time, 1, this->CreateAxialPlane(9)));
+  }
+
+  void RegionModified_ReportsUnionOfNewerRegions()
+  {
+    m_Image->RegionModified(CreateRegion(0, 0, 0, 1, 1, 1), 0);
+    const auto time = m_Image->GetMTime();
+    m_Image->RegionModified(CreateRegion(1, 2, 3, 2, 2, 1), 0);
+    m_Image->RegionModified(CreateRegion(5, 1, 4, 1, 1, 3), 1);
+
+    mitk::Image::RegionType region;
+    CPPUNIT_ASSERT_MESSAGE("Region is known", m_Image->GetModifiedRegionSince(time, region));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Index x", mitk::Image::IndexValueType(1), region.GetIndex(0));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Index y", mitk::Image::IndexValueType(1), region.GetIndex(1));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Index z", mitk::Image::IndexValueType(3), region.GetIndex(2));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Index t", mitk::Image::IndexValueType(0), region.GetIndex(3));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Size x", itk::SizeValueType(5), region.GetSize(0));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Size y", itk::SizeValueType(3), region.GetSize(1));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Size z", itk::SizeValueType(4), region.GetSize(2));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Size t", itk::SizeValueType(2), region.GetSize(3));
+
+    CPPUNIT_ASSERT_MESSAGE("Nothing is newer than the last modification",
+                           m_Image->GetModifiedRegionSince(m_Image->GetMTime(), region));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Empty region", itk::SizeValueType(0), region.GetNumberOfPixels());
+  }
+
+  void RegionModified_InvokesEvent()
+  {
+    auto command = itk::ReceptorMemberCommand<mitkImageModifiedRegionTestSuite>::New();
+    command->SetCallbackFunction(this, &mitkImageModifiedRegionTestSuite::OnRegionModified);
+    auto tag = m_Image->AddObserver(mitk::Image::RegionModifiedEvent(mitk::Image::RegionType()), command);
+
+    m_Image->Modified();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Plain modification invokes no region event", 0u, m_NumberOfEvents);
+
+    m_Image->RegionModified(CreateRegion(2, 3, 4, 1, 1, 1), 1);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Region event is invoked", 1u, m_NumberOfEvents);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Event carries the time step", mitk::Image::IndexValueType(1), m_ReceivedRegion.GetIndex(3));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Event carries the index", mitk::Image::IndexValueType(4), m_ReceivedRegion.GetIndex(2));
+
+    m_Image->RemoveObserver(tag);
+  }
+
+  void IsModifiedNearPlaneSince_ChecksPlaneAndTimeStep()
+  {
+    const auto time = m_Image->GetMTime();
+    m_Image->RegionModified(CreateRegion(2, 2, 5, 3, 3, 1), 1);
+
+    CPPUNIT_ASSERT_MESSAGE("Plane through the region", m_Image->IsModifiedNearPlaneSince(time, 1, this->CreateAxialPlane(5)));
+    CPPUNIT_ASSERT_MESSAGE("Plane within the margin", m_Image->IsModifiedNearPlaneSince(time, 1, this->CreateAxialPlane(6)));
+    CPPUNIT_ASSERT_MESSAGE("Plane far from the region", !m_Image->IsModifiedNearPlaneSince(time, 1, this->CreateAxialPlane(9)));
+    CPPUNIT_ASSERT_MESSAGE("Larger margin", m_Image->IsModifiedNearPlaneSince(time, 1, this->CreateAxialPlane(9), 4.0));
+    CPPUNIT_ASSERT_MESSAGE("Other time step", !m_Image->IsModifiedNearPlaneSince(time, 0, this->CreateAxialPlane(5)));
+    CPPUNIT_ASSERT_MESSAGE("Unknown plane", m_Image->IsModifiedNearPlaneSince(time, 1, nullptr));
+  }
+
+  void Statistics_AreRecomputedForModifiedTimeStepOnly()
+  {
+    this->FillVolume(0, 10);
+    this->FillVolume(1, 20);
+    m_Image->Modified();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Minimum of time step 0", 10.0, m_Image->GetStatistics()->GetScalarValueMin(0));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Minimum of time step 1", 20.0, m_Image->GetStatistics()->GetScalarValueMin(1));
+
+    // both time steps are changed, but only time step 1 is announced
+    this->FillVolume(0, 30);
+    this->FillVolume(1, 40);
+    m_Image->RegionModified(CreateRegion(0, 0, 0, 10, 10, 10), 1);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Time step 0 is kept", 10.0, m_Image->GetStatistics()->GetScalarValueMin(0));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Time step 1 is recomputed", 40.0, m_Image->GetStatistics()->GetScalarValueMin(1));
+
+    m_Image->Modified();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Plain modification recomputes everything", 30.0, m_Image->GetStatistics()->GetScalarValueMin(0));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageModifiedRegion)
@@ -0,0 +1,137 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// MITK
+#include <mitkImageGenerator.h>
+#include <mitkImageTimeSelector.h>
+#include <mitkImageVtkMapper2D.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkRenderingTestHelper.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+// VTK
+#include <vtkImageData.h>
+
+#include <algorithm>
+
+/** Checks when the ImageVtkMapper2D reslices the displayed image after the data was modified.
+ * The resliced image of the mapper is inspected directly, so no reference screenshots are needed.*/
+class mitkImageVtkMapper2DUpdateTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageVtkMapper2DUpdateTestSuite);
+  MITK_TEST(ModifiedSource_RegeneratesSlice);
+  MITK_TEST(RegionModified_RegeneratesSliceNearRegionOnly);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::RenderingTestHelper m_RenderingTestHelper;
+  mitk::Image::Pointer m_Image;
+  mitk::DataNode::Pointer m_Node;
+
+  void FillVolume(mitk::Image *image, mitk::TimeStepType timeStep, unsigned char value)
+  {
+    mitk::ImageWriteAccessor access(image, image->GetVolumeData(timeStep));
+    auto *data = static_cast<unsigned char *>(access.GetData());
+    std::fill(data, data + 10 * 10 * 10, value);
+  }
+
+  void AddImageNode(mitk::Image *image)
+  {
+    m_Node = mitk::DataNode::New();
+    m_Node->SetData(image);
+    m_RenderingTestHelper.AddNodeToStorage(m_Node);
+    m_RenderingTestHelper.SetViewDirection(mitk::AnatomicalPlane::Axial);
+    m_RenderingTestHelper.Render();
+  }
+
+  /** Returns the value in the center of the slice that the mapper resliced the last time.*/
+  double GetDisplayedValue()
+  {
+    auto *mapper = dynamic_cast<mitk::ImageVtkMapper2D *>(m_Node->GetMapper(mitk::BaseRenderer::Standard2D));
+    CPPUNIT_ASSERT(nullptr != mapper);
+
+    auto *renderer = mitk::BaseRenderer::GetInstance(m_RenderingTestHelper.GetVtkRenderWindow());
+    vtkImageData *slice = mapper->GetConstLocalStorage(renderer)->m_ReslicedImage;
+    CPPUNIT_ASSERT(nullptr != slice);
+
+    int extent[6];
+    slice->GetExtent(extent);
+    return slice->GetScalarComponentAsDouble((extent[0] + extent[1]) / 2, (extent[2] + extent[3]) / 2, extent[4], 0);
+  }
+
+public:
+  mitkImageVtkMapper2DUpdateTestSuite() : m_RenderingTestHelper(640, 480) {}
+
+  void setUp() override
+  {
+    m_RenderingTestHelper = mitk::RenderingTestHelper(640, 480);
+    m_Image = mitk::ImageGenerator::GenerateRandomImage<unsigned char>(10, 10, 10, 2, 1, 1, 1, 200, 100);
+    this->FillVolume(m_Image, 0, 10);
+    this->FillVolume(m_Image, 1, 20);
+    m_Image->Modified();
+  }
+
+  void tearDown() override
+  {
+    m_Node = nullptr;
+    m_Image = nullptr;
+  }
+
+  void ModifiedSource_RegeneratesSlice()
+  {
+    auto selector = mitk::ImageTimeSelector::New();
+    selector->SetInput(m_Image);
+    selector->SetTimeNr(0);
+    selector->Update();
+    mitk::Image::Pointer frame = selector->GetOutput();
+
+    this->AddImageNode(frame);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Slice of time step 0", 10.0, this->GetDisplayedValue());
+
+    // only the source is modified, the displayed image itself is not touched until the mapper updates it
+    const auto frameMTime = frame->GetMTime();
+    selector->SetTimeNr(1);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Image is not modified", frameMTime, frame->GetMTime());
+
+    m_RenderingTestHelper.Render();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Slice of time step 1", 20.0, this->GetDisplayedValue());
+  }
+
+  void RegionModified_RegeneratesSliceNearRegionOnly()
+  {
+    auto volume = mitk::ImageGenerator::GenerateRandomImage<unsigned char>(10, 10, 10, 1, 1, 1, 1, 200, 100);
+    this->FillVolume(volume, 0, 10);
+    volume->Modified();
+
+    this->AddImageNode(volume);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Initial slice", 10.0, this->GetDisplayedValue());
+
+    // the whole volume is changed, but only the first slice is announced, far from the displayed one
+    this->FillVolume(volume, 0, 30);
+    itk::ImageRegion<3> region;
+    region.SetIndex({{0, 0, 0}});
+    region.SetSize({{10, 10, 1}});
+    volume->RegionModified(region, 0);
+
+    m_RenderingTestHelper.Render();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Slice far from the region is kept", 10.0, this->GetDisplayedValue());
+
+    region.SetSize({{10, 10, 10}});
+    volume->RegionModified(region, 0);
+
+    m_RenderingTestHelper.Render();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Slice within the region is regenerated", 30.0, this->GetDisplayedValue());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageVtkMapper2DUpdate)
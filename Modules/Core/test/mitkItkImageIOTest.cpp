@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include <mitkTestingMacros.h>
 
 #include "mitkIOUtil.h"
+#include <mitkItkImageIO.h>
 #include <mitkUtf8Util.h>
 #include "mitkITKImageImport.h"
 #include <mitkExtractSliceFilter.h>
@@ -23,6 +24,8 @@ found in the LICENSE file.
 #include "itksys/SystemTools.hxx"
 #include <itkImageRegionIterator.h>
 
+#include <algorithm>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 
@@ -44,6 +47,8 @@ class mitkItkImageIOTestSuite : public mitk::TestFixture
   MITK_TEST(TestWrite3DImageWithTwoPlanes);
   MITK_TEST(TestWrite3DplusT_ArbitraryTG);
   MITK_TEST(TestWrite3DplusT_ProportionalTG);
+  MITK_TEST(TestKnownImageIOs);
+  MITK_TEST(TestLazyImageIO);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -278,6 +283,59 @@ public:
     }
   }
 
+  void TestKnownImageIOs()
+  {
+    for (const auto &info : mitk::ItkImageIO::GetKnownImageIOs())
+    {
+      auto imageIO = info.Factory();
+      CPPUNIT_ASSERT_MESSAGE("Factory creates ImageIO " + info.Name, imageIO.IsNotNull());
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Name of ImageIO", info.Name, std::string(imageIO->GetNameOfClass()));
+
+      std::vector<std::string> readExtensions(imageIO->GetSupportedReadExtensions().begin(),
+                                              imageIO->GetSupportedReadExtensions().end());
+      std::vector<std::string> writeExtensions(imageIO->GetSupportedWriteExtensions().begin(),
+                                               imageIO->GetSupportedWriteExtensions().end());
+      CPPUNIT_ASSERT_MESSAGE("Read extensions of " + info.Name + " are up to date", info.ReadExtensions == readExtensions);
+      CPPUNIT_ASSERT_MESSAGE("Write extensions of " + info.Name + " are up to date", info.WriteExtensions == writeExtensions);
+    }
+  }
+
+  void TestLazyImageIO()
+  {
+    const auto &knownImageIOs = mitk::ItkImageIO::GetKnownImageIOs();
+    auto nrrdInfo = std::find_if(knownImageIOs.begin(), knownImageIOs.end(), [](const mitk::ItkImageIO::ImageIOInfo &info) {
+      return info.Name == "NrrdImageIO";
+    });
+    CPPUNIT_ASSERT_MESSAGE("NrrdImageIO is known", nrrdInfo != knownImageIOs.end());
+
+    int numberOfCreatedImageIOs = 0;
+    mitk::ItkImageIO::ImageIOInfo info = *nrrdInfo;
+    info.Factory = [&numberOfCreatedImageIOs, nrrdInfo]() {
+      ++numberOfCreatedImageIOs;
+      return nrrdInfo->Factory();
+    };
+
+    auto image = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Pic3D.nrrd"));
+    std::string fileName = mitk::IOUtil::CreateTemporaryFile("LazyImageIOTest_XXXXXX.nrrd");
+
+    mitk::ItkImageIO imageIO(info);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("ImageIO is not created on construction", 0, numberOfCreatedImageIOs);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Description", std::string("ITK NrrdImageIO"), imageIO.GetReaderDescription());
+
+    mitk::IFileWriter *writer = &imageIO;
+    writer->SetInput(image);
+    writer->SetOutputLocation(fileName);
+    writer->Write();
+
+    mitk::IFileReader *reader = &imageIO;
+    reader->SetInput(fileName);
+    auto data = reader->Read();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Image is read", std::size_t(1), data.size());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("ImageIO is created once on first use", 1, numberOfCreatedImageIOs);
+
+    std::remove(fileName.c_str());
+  }
+
   /**
   *  test for "ImageWriter".
   *
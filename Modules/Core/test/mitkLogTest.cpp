@@ -21,6 +21,8 @@ found in the LICENSE file.
 #include <thread>
 #include <mitkUtf8Util.h>
 
+#include <map>
+
 /** Documentation
  *
  * @brief this class provides an accessible BackendCout to determine whether this backend was
@@ -49,6 +51,46 @@ public:
 private:
   bool m_Called;
 };
+
+/** Documentation
+ *
+ * @brief this class counts the processed messages and checks that the messages of each thread arrive in the
+ * order in which they were logged. It is needed for the asynchronous dispatch test.
+ */
+class TestBackendCounter : public mitk::LogBackendBase
+{
+public:
+  TestBackendCounter()
+    : m_NumberOfMessages(0),
+      m_InOrder(true)
+  {
+  }
+
+  void ProcessMessage(const mitk::LogMessage& message) override
+  {
+    ++m_NumberOfMessages;
+
+    if (message.Category.empty())
+      return;
+
+    // the category is the thread index, the message a running number
+    const int number = std::stoi(message.Message);
+    auto lastNumber = m_LastNumbers.find(message.Category);
+    m_InOrder &= number == (lastNumber != m_LastNumbers.end() ? lastNumber->second + 1 : 0);
+    m_LastNumbers[message.Category] = number;
+  }
+
+  OutputType GetOutputType() const override
+  {
+    return OutputType::Other;
+  }
+
+  unsigned int m_NumberOfMessages;
+  bool m_InOrder;
+
+private:
+  std::map<std::string, int> m_LastNumbers;
+};
 /** Documentation
   *
   * @brief Objects of this class can start an internal thread by calling the Start() method.
@@ -275,6 +317,80 @@ public:
     mitk::UnregisterBackend(&myCoutBackend);
     MITK_TEST_CONDITION_REQUIRED(success, "Test disable / enable logging backends.")
   }
+
+  static void TestEnableDisableLogLevels()
+  {
+    TestBackendCounter counter;
+    mitk::RegisterBackend(&counter);
+
+    int numberOfEvaluations = 0;
+    auto evaluate = [&numberOfEvaluations]() { return ++numberOfEvaluations; };
+
+    mitk::DisableLogLevel(mitk::LogLevel::Info);
+    MITK_INFO << "There should be no output! " << evaluate();
+    MITK_INFO("category") << "There should be no output! " << evaluate();
+    bool success = counter.m_NumberOfMessages == 0 && numberOfEvaluations == 0;
+    success &= mitk::IsLogLevelEnabled(mitk::LogLevel::Warn);
+
+    mitk::EnableLogLevel(mitk::LogLevel::Info);
+    MITK_INFO << "Now there should be an output. " << evaluate();
+    success &= counter.m_NumberOfMessages == 1 && numberOfEvaluations == 1;
+
+    mitk::UnregisterBackend(&counter);
+    MITK_TEST_CONDITION_REQUIRED(success, "Test disable / enable log levels.")
+  }
+
+  static void TestAsynchronousDispatch()
+  {
+    TestBackendCounter counter;
+    mitk::RegisterBackend(&counter);
+
+    // a small queue lets the logging threads wait for the dispatch thread
+    mitk::EnableAsynchronousDispatch(16);
+    MITK_TEST_CONDITION_REQUIRED(mitk::IsAsynchronousDispatchEnabled(), "Test enable asynchronous dispatch.");
+
+    const unsigned int numberOfThreads = 8;
+    const int numberOfMessagesPerThread = 2000;
+    std::vector<std::thread> threads;
+
+    for (unsigned int threadIdx = 0; threadIdx < numberOfThreads; ++threadIdx)
+    {
+      threads.emplace_back([threadIdx, numberOfMessagesPerThread]() {
+        for (int i = 0; i < numberOfMessagesPerThread; ++i)
+          MITK_WARN(std::to_string(threadIdx)) << i;
+      });
+    }
+
+    for (auto& thread : threads)
+      thread.join();
+
+    mitk::FlushBackends();
+    MITK_TEST_CONDITION(counter.m_NumberOfMessages == numberOfThreads * numberOfMessagesPerThread,
+                        "Test all messages are processed after flushing.");
+    MITK_TEST_CONDITION(counter.m_InOrder, "Test messages of each thread are processed in order.");
+
+    MITK_FATAL << "Test fatal stream.";
+    MITK_TEST_CONDITION(counter.m_NumberOfMessages == numberOfThreads * numberOfMessagesPerThread + 1,
+                        "Test fatal messages are processed before the logging thread continues.");
+
+    MITK_INFO << "Test info stream.";
+    mitk::DisableAsynchronousDispatch();
+    MITK_TEST_CONDITION(!mitk::IsAsynchronousDispatchEnabled(), "Test disable asynchronous dispatch.");
+    MITK_TEST_CONDITION(counter.m_NumberOfMessages == numberOfThreads * numberOfMessagesPerThread + 2,
+                        "Test queued messages are processed when disabling the asynchronous dispatch.");
+
+    // info messages may be discarded, but the number of discarded messages is reported as a warning
+    mitk::EnableAsynchronousDispatch(16, mitk::LogQueueOverflowPolicy::DiscardInfoAndDebug);
+    counter.m_NumberOfMessages = 0;
+
+    for (int i = 0; i < numberOfMessagesPerThread; ++i)
+      MITK_INFO << i;
+
+    mitk::DisableAsynchronousDispatch();
+    MITK_TEST_CONDITION(counter.m_NumberOfMessages > 0, "Test messages are processed with discard policy.");
+
+    mitk::UnregisterBackend(&counter);
+  }
 };
 
 int mitkLogTest(int /* argc */, char * /*argv*/ [])
@@ -292,6 +408,8 @@ int mitkLogTest(int /* argc */, char * /*argv*/ [])
   mitkLogTestClass::TestThreadSaveLog(false); // false = to console
   mitkLogTestClass::TestThreadSaveLog(true);  // true = to file
   mitkLogTestClass::TestEnableDisableBackends();
+  mitkLogTestClass::TestEnableDisableLogLevels();
+  mitkLogTestClass::TestAsynchronousDispatch();
   // TODO actually test file somehow?
 
   // always end with this!
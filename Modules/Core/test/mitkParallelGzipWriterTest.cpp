@@ -0,0 +1,147 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkIOUtil.h>
+#include <mitkImageGenerator.h>
+#include <mitkParallelGzipWriter.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class mitkParallelGzipWriterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkParallelGzipWriterTestSuite);
+
+  MITK_TEST(Write_EmptyInput_IsValidGzipStream);
+  MITK_TEST(Write_PrefixAndData_EqualsStream);
+  MITK_TEST(WriteFile_ManyBlocks_IsReadableByNiftiReader);
+  MITK_TEST(Save_Nrrd_IsReadable);
+  MITK_TEST(Save_NiftiGz_IsReadable);
+  MITK_TEST(Save_ManyBlocksWithThreads_IsReadable);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  std::vector<std::string> m_TemporaryFiles;
+
+  std::string CreateTemporaryFile(const std::string &templateName)
+  {
+    m_TemporaryFiles.push_back(mitk::IOUtil::CreateTemporaryFile(templateName));
+    return m_TemporaryFiles.back();
+  }
+
+  void SaveAndLoad(const std::string &extension)
+  {
+    const auto path = this->CreateTemporaryFile("XXXXXX" + extension);
+
+    mitk::IOUtil::Save(m_Image, path);
+
+    auto loadedImage = mitk::IOUtil::Load<mitk::Image>(path);
+    CPPUNIT_ASSERT_MESSAGE("Loaded image equals the saved image", mitk::Equal(*m_Image, *loadedImage, mitk::eps, true));
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::ImageGenerator::GenerateRandomImage<short>(64, 48, 20, 1, 1.0, 1.5, 2.0, 1000, -1000);
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+    itksys::SystemTools::UnPutEnv("MITK_COMPRESSION_THREADS");
+    for (const auto &path : m_TemporaryFiles)
+    {
+      std::remove(path.c_str());
+    }
+    m_TemporaryFiles.clear();
+  }
+
+  void Write_EmptyInput_IsValidGzipStream()
+  {
+    std::istringstream input;
+    std::ostringstream output;
+    mitk::ParallelGzipWriter().Write(input, output);
+
+    // header, final empty block, CRC-32 and size
+    const auto result = output.str();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Size of the stream", std::size_t(20), result.size());
+    CPPUNIT_ASSERT_MESSAGE("gzip magic", result[0] == '\x1f' && result[1] == '\x8b');
+    CPPUNIT_ASSERT_MESSAGE("Empty final block", result[10] == '\x03' && result[11] == '\x00');
+  }
+
+  void Write_PrefixAndData_EqualsStream()
+  {
+    const std::string prefix = "header";
+    std::string data;
+    for (int i = 0; i < 1000; ++i)
+    {
+      data += std::to_string(i);
+    }
+
+    // blocks that start in the prefix and end in the data
+    mitk::ParallelGzipWriter writer;
+    writer.SetBlockSize(7);
+    writer.SetNumberOfThreads(2);
+
+    std::istringstream input(prefix + data);
+    std::ostringstream streamOutput;
+    writer.Write(input, streamOutput);
+
+    std::ostringstream memoryOutput;
+    writer.Write(prefix, data.data(), data.size(), memoryOutput);
+
+    CPPUNIT_ASSERT_MESSAGE("Same gzip stream", streamOutput.str() == memoryOutput.str());
+  }
+
+  void WriteFile_ManyBlocks_IsReadableByNiftiReader()
+  {
+    const auto uncompressedPath = this->CreateTemporaryFile("XXXXXX.nii");
+    mitk::IOUtil::Save(m_Image, uncompressedPath);
+
+    // small blocks lead to several batches of blocks and an incomplete last batch
+    mitk::ParallelGzipWriter writer;
+    writer.SetBlockSize(10007);
+    writer.SetNumberOfThreads(3);
+    writer.SetCompressionLevel(1);
+
+    const auto path = this->CreateTemporaryFile("XXXXXX.nii.gz");
+    writer.WriteFile(uncompressedPath, path);
+
+    auto loadedImage = mitk::IOUtil::Load<mitk::Image>(path);
+    CPPUNIT_ASSERT_MESSAGE("Loaded image equals the saved image", mitk::Equal(*m_Image, *loadedImage, mitk::eps, true));
+  }
+
+  void Save_Nrrd_IsReadable() { this->SaveAndLoad(".nrrd"); }
+
+  void Save_NiftiGz_IsReadable() { this->SaveAndLoad(".nii.gz"); }
+
+  void Save_ManyBlocksWithThreads_IsReadable()
+  {
+    // about 2.5 MB of data, i.e. about 20 blocks of the default block size
+    m_Image = mitk::ImageGenerator::GenerateRandomImage<short>(128, 128, 80, 1, 1.0, 1.5, 2.0, 1000, -1000);
+    itksys::SystemTools::PutEnv("MITK_COMPRESSION_THREADS=4");
+
+    this->SaveAndLoad(".nrrd");
+    this->SaveAndLoad(".nii.gz");
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkParallelGzipWriter)
@@ -0,0 +1,138 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkCommandLineParser.h>
+#include <mitkCoreServices.h>
+#include <mitkIMimeTypeProvider.h>
+#include <mitkIOUtil.h>
+
+#include <itksys/Process.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <numeric>
+
+namespace
+{
+  // Runs in the spawned processes: loading the Core module registers all readers and
+  // writers, then the mime-types are queried like any application does on startup.
+  int RunChild(const std::string &inputFilename)
+  {
+    mitk::CoreServicePointer<mitk::IMimeTypeProvider> mimeTypeProvider(mitk::CoreServices::GetMimeTypeProvider());
+    if (mimeTypeProvider->GetMimeTypes().empty())
+      return EXIT_FAILURE;
+
+    if (!inputFilename.empty())
+      mitk::IOUtil::Load(inputFilename);
+
+    return EXIT_SUCCESS;
+  }
+
+  // Returns the wall time of one child process in milliseconds or a negative value on failure
+  double RunProcess(const std::vector<std::string> &arguments)
+  {
+    std::vector<const char *> command;
+    for (const auto &argument : arguments)
+      command.push_back(argument.c_str());
+    command.push_back(nullptr);
+
+    auto *process = itksysProcess_New();
+    itksysProcess_SetCommand(process, command.data());
+    itksysProcess_SetPipeShared(process, itksysProcess_Pipe_STDOUT, 1);
+    itksysProcess_SetPipeShared(process, itksysProcess_Pipe_STDERR, 1);
+
+    const auto start = std::chrono::steady_clock::now();
+    itksysProcess_Execute(process);
+    itksysProcess_WaitForExit(process, nullptr);
+    const auto end = std::chrono::steady_clock::now();
+
+    const bool success = itksysProcess_GetState(process) == itksysProcess_State_Exited &&
+                         itksysProcess_GetExitValue(process) == EXIT_SUCCESS;
+    itksysProcess_Delete(process);
+
+    return success ? std::chrono::duration<double, std::milli>(end - start).count() : -1.0;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  mitkCommandLineParser parser;
+
+  parser.setTitle("Startup Benchmark");
+  parser.setCategory("Benchmarks");
+  parser.setDescription("Measures the startup time of a minimal command-line app using the MitkCore module, "
+                        "including the registration of all readers and writers.");
+  parser.setContributor("German Cancer Research Center (DKFZ)");
+
+  parser.setArgumentPrefix("--", "-");
+  parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
+  parser.addArgument("runs", "r", mitkCommandLineParser::Int, "Runs:", "Number of measured startups (default: 10)", us::Any(10));
+  parser.addArgument("input", "i", mitkCommandLineParser::File, "Input file:", "Optional file that is loaded after startup", us::Any(), true, false, false, mitkCommandLineParser::Input);
+  parser.addArgument("child", "c", mitkCommandLineParser::Bool, "Child:", "Internal: run as measured process", us::Any(false));
+
+  std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
+
+  if (parsedArgs.count("help") || parsedArgs.count("h"))
+  {
+    std::cout << parser.helpText();
+    return EXIT_SUCCESS;
+  }
+
+  std::string inputFilename;
+  if (parsedArgs.count("input"))
+    inputFilename = us::any_cast<std::string>(parsedArgs["input"]);
+
+  if (parsedArgs.count("child") && us::any_cast<bool>(parsedArgs["child"]))
+    return RunChild(inputFilename);
+
+  int runs = 10;
+  if (parsedArgs.count("runs"))
+    runs = std::max(1, us::any_cast<int>(parsedArgs["runs"]));
+
+  std::vector<std::string> arguments = {argv[0], "--child"};
+  if (!inputFilename.empty())
+  {
+    arguments.push_back("--input");
+    arguments.push_back(inputFilename);
+  }
+
+  // The first run warms up the file system cache and is not measured
+  if (RunProcess(arguments) < 0.0)
+  {
+    MITK_ERROR << "Startup of " << arguments.front() << " failed";
+    return EXIT_FAILURE;
+  }
+
+  std::vector<double> times;
+  for (int run = 0; run < runs; ++run)
+  {
+    const double time = RunProcess(arguments);
+    if (time < 0.0)
+    {
+      MITK_ERROR << "Startup of " << arguments.front() << " failed";
+      return EXIT_FAILURE;
+    }
+    times.push_back(time);
+  }
+
+  std::sort(times.begin(), times.end());
+  const double mean = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+  const double median = times.size() % 2 == 0 ? (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2.0
+                                              : times[times.size() / 2];
+
+  std::cout << std::fixed << std::setprecision(1)
+            << "Startup time over " << times.size() << " runs [ms]: min " << times.front() << ", median " << median
+            << ", mean " << mean << ", max " << times.back() << std::endl;
+
+  return EXIT_SUCCESS;
+}
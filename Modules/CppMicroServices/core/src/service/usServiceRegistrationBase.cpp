@@ -133,6 +133,10 @@ void ServiceRegistrationBase::SetProperties(const ServiceProperties& props)
       {
         d->module->coreCtx->services.UpdateServiceRegistrationOrder(*this, classes);
       }
+      else
+      {
+        d->module->coreCtx->services.ServicePropertiesChanged();
+      }
     }
     else
     {
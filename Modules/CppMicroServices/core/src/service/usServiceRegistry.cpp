@@ -65,8 +65,16 @@ ServicePropertiesImpl ServiceRegistry::CreateServiceProperties(const ServiceProp
   return ServicePropertiesImpl(props);
 }
 
+namespace {
+
+// Lookups with many different filters, e.g. for service ids, must not let the caches grow forever
+const std::size_t MaxCacheSize = 512;
+
+}
+
 ServiceRegistry::ServiceRegistry(CoreModuleContext* coreCtx)
   : core(coreCtx)
+  , generation(0)
 {
 
 }
@@ -81,6 +89,9 @@ void ServiceRegistry::Clear()
   services.clear();
   serviceRegistrations.clear();
   classServices.clear();
+  lookupCache.clear();
+  ldapExprCache.clear();
+  ++generation;
   core = nullptr;
 }
 
@@ -123,6 +134,7 @@ ServiceRegistrationBase ServiceRegistry::RegisterService(ModulePrivate* module,
           std::lower_bound(s.begin(), s.end(), res);
       s.insert(ip, res);
     }
+    ++generation;
   }
 
   ServiceReferenceBase r = res.GetReference(std::string());
@@ -145,6 +157,13 @@ void ServiceRegistry::UpdateServiceRegistrationOrder(const ServiceRegistrationBa
     s.erase(std::remove(s.begin(), s.end(), sr), s.end());
     s.insert(std::lower_bound(s.begin(), s.end(), sr), sr);
   }
+  ++generation;
+}
+
+void ServiceRegistry::ServicePropertiesChanged()
+{
+  MutexLock lock(mutex);
+  ++generation;
 }
 
 void ServiceRegistry::Get(const std::string& clazz,
@@ -194,6 +213,68 @@ void ServiceRegistry::Get(const std::string& clazz, const std::string& filter,
 
 void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string& filter,
                           ModulePrivate* module, std::vector<ServiceReferenceBase>& res) const
+{
+  // Class names cannot contain a null character, so the key is unique
+  std::string key(clazz);
+  key.push_back('\0');
+  key.append(filter);
+
+  LookupCache::iterator cached = lookupCache.find(key);
+  if (cached == lookupCache.end() || cached->second.generation != generation)
+  {
+    CachedLookup lookup;
+    lookup.generation = generation;
+    Find_unlocked(clazz, filter, lookup.serviceRefs);
+
+    if (cached == lookupCache.end())
+    {
+      if (lookupCache.size() >= MaxCacheSize)
+      {
+        lookupCache.clear();
+      }
+      cached = lookupCache.insert(std::make_pair(key, lookup)).first;
+    }
+    else
+    {
+      cached->second = lookup;
+    }
+  }
+
+  res.insert(res.end(), cached->second.serviceRefs.begin(), cached->second.serviceRefs.end());
+
+  if (!res.empty())
+  {
+    if (module != nullptr)
+    {
+      core->serviceHooks.FilterServiceReferences(module->moduleContext, clazz, filter, res);
+    }
+    else
+    {
+      core->serviceHooks.FilterServiceReferences(nullptr, clazz, filter, res);
+    }
+  }
+}
+
+LDAPExpr ServiceRegistry::GetLDAPExpr_unlocked(const std::string& filter) const
+{
+  LDAPExprCache::const_iterator cached = ldapExprCache.find(filter);
+  if (cached != ldapExprCache.end())
+  {
+    return cached->second;
+  }
+
+  // throws std::invalid_argument for invalid filters, which are not cached
+  LDAPExpr ldap(filter);
+  if (ldapExprCache.size() >= MaxCacheSize)
+  {
+    ldapExprCache.clear();
+  }
+  ldapExprCache.insert(std::make_pair(filter, ldap));
+  return ldap;
+}
+
+void ServiceRegistry::Find_unlocked(const std::string& clazz, const std::string& filter,
+                                    std::vector<ServiceReferenceBase>& res) const
 {
   std::vector<ServiceRegistrationBase>::const_iterator s;
   std::vector<ServiceRegistrationBase>::const_iterator send;
@@ -203,7 +284,7 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
   {
     if (!filter.empty())
     {
-      ldap = LDAPExpr(filter);
+      ldap = GetLDAPExpr_unlocked(filter);
       LDAPExpr::ObjectClassSet matched;
       if (ldap.GetMatchedObjectClasses(matched))
       {
@@ -253,7 +334,7 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
     }
     if (!filter.empty())
     {
-      ldap = LDAPExpr(filter);
+      ldap = GetLDAPExpr_unlocked(filter);
     }
   }
 
@@ -266,18 +347,6 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
       res.push_back(sri);
     }
   }
-
-  if (!res.empty())
-  {
-    if (module != nullptr)
-    {
-      core->serviceHooks.FilterServiceReferences(module->moduleContext, clazz, filter, res);
-    }
-    else
-    {
-      core->serviceHooks.FilterServiceReferences(nullptr, clazz, filter, res);
-    }
-  }
 }
 
 void ServiceRegistry::RemoveServiceRegistration(const ServiceRegistrationBase& sr)
@@ -303,6 +372,7 @@ void ServiceRegistry::RemoveServiceRegistration(const ServiceRegistrationBase& s
       classServices.erase(*i);
     }
   }
+  ++generation;
 }
 
 void ServiceRegistry::GetRegisteredByModule(ModulePrivate* p,
@@ -27,6 +27,7 @@
 #include "usServiceRegistration.h"
 
 #include "usThreads_p.h"
+#include "usLDAPExpr_p.h"
 
 US_BEGIN_NAMESPACE
 
@@ -116,6 +117,12 @@ public:
   void UpdateServiceRegistrationOrder(const ServiceRegistrationBase& sr,
                                       const std::vector<std::string>& classes);
 
+  /**
+   * Service properties changed, lookup results cached before
+   * might not match the properties anymore.
+   */
+  void ServicePropertiesChanged();
+
   /**
    * Get all services implementing a certain class.
    * Only used internally by the framework.
@@ -178,6 +185,38 @@ private:
   void Get_unlocked(const std::string& clazz, const std::string& filter,
                     ModulePrivate* module, std::vector<ServiceReferenceBase>& serviceRefs) const;
 
+  /**
+   * Finds the services matching class and filter, without calling the find hooks.
+   */
+  void Find_unlocked(const std::string& clazz, const std::string& filter,
+                     std::vector<ServiceReferenceBase>& serviceRefs) const;
+
+  /**
+   * Returns the parsed filter, filters are parsed only once.
+   */
+  LDAPExpr GetLDAPExpr_unlocked(const std::string& filter) const;
+
+  /**
+   * Result of Find_unlocked() for a class and a filter, valid as long as
+   * the generation of the registry did not change.
+   */
+  struct CachedLookup
+  {
+    unsigned long generation;
+    std::vector<ServiceReferenceBase> serviceRefs;
+  };
+
+  typedef US_UNORDERED_MAP_TYPE<std::string, CachedLookup> LookupCache;
+  typedef US_UNORDERED_MAP_TYPE<std::string, LDAPExpr> LDAPExprCache;
+
+  /**
+   * Incremented whenever a service is registered, unregistered or modified.
+   */
+  unsigned long generation;
+
+  mutable LookupCache lookupCache;
+  mutable LDAPExprCache ldapExprCache;
+
   // purposely not implemented
   ServiceRegistry(const ServiceRegistry&);
   ServiceRegistry& operator=(const ServiceRegistry&);
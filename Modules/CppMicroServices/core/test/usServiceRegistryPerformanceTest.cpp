@@ -46,6 +46,8 @@ US_USE_NAMESPACE
 #error High precision timer support nod available on this platform
 #endif
 
+#include <sstream>
+#include <string>
 #include <vector>
 
 class HighPrecisionTimer
@@ -205,6 +207,7 @@ public:
   void TestRegisterServices();
 
   void TestModifyServices();
+  void TestGetServiceReferences();
   void TestUnregisterServices();
 
 private:
@@ -217,6 +220,7 @@ private:
   void AddListeners(int n);
   void RegisterServices(int n);
   void ModifyServices();
+  std::size_t GetServiceReferences(const std::string& filter, int n);
   void UnregisterServices();
 
 };
@@ -385,6 +389,78 @@ void ServiceRegistryPerformanceTest::ModifyServices()
   }
 }
 
+void ServiceRegistryPerformanceTest::TestGetServiceReferences()
+{
+  Log() << "Get service references repeatedly, like MITK does when looking up core services\n";
+
+  // after TestModifyServices(), the values are 0, 2, ..., 2 * (#services - 1)
+  const std::size_t nMatching = nServices / 2;
+  const std::string filter = "(perf.service.value>=" + std::to_string(nServices) + ")";
+
+  HighPrecisionTimer t;
+  t.Start();
+  std::size_t n = GetServiceReferences(filter, 1000);
+  Log() << "1000 filtered lookups took " << t.ElapsedMicro() << "us\n";
+  US_TEST_CONDITION_REQUIRED(n == nMatching, "# filtered references")
+
+  t.Start();
+  n = GetServiceReferences(std::string(), 1000);
+  Log() << "1000 unfiltered lookups took " << t.ElapsedMicro() << "us\n";
+  US_TEST_CONDITION_REQUIRED(n == static_cast<std::size_t>(nServices), "# unfiltered references")
+
+  t.Start();
+  for (int i = 0; i < 1000; i++)
+  {
+    std::stringstream ss;
+    ss << "(service.pid=my.service." << i % nServices << ")";
+    n = mc->GetServiceReferences<IPerfTestService>(ss.str()).size();
+  }
+  Log() << "1000 lookups with different filters took " << t.ElapsedMicro() << "us\n";
+  US_TEST_CONDITION_REQUIRED(n == 1, "# references for a pid")
+
+  t.Start();
+  for (int i = 0; i < 1000; i++)
+  {
+    mc->GetServiceReference<IPerfTestService>();
+  }
+  Log() << "1000 GetServiceReference() calls took " << t.ElapsedMicro() << "us\n";
+
+  // Cached lookups must not hide changes of the registry. The extra service does not match the
+  // filter of the service listeners, so the event counters are not affected.
+  const std::string extraFilter = "(|" + filter + "(perf.service.extra=1))";
+  US_TEST_CONDITION_REQUIRED(GetServiceReferences(extraFilter, 2) == nMatching, "# references before registration")
+
+  class PerfTestService : public IPerfTestService
+  {
+  };
+  PerfTestService extraService;
+  ServiceProperties props;
+  props["perf.service.extra"] = 1;
+  ServiceRegistration<IPerfTestService> extraReg = mc->RegisterService<IPerfTestService>(&extraService, props);
+  US_TEST_CONDITION_REQUIRED(GetServiceReferences(extraFilter, 2) == nMatching + 1, "# references after registration")
+
+  props["perf.service.extra"] = 2;
+  extraReg.SetProperties(props);
+  US_TEST_CONDITION_REQUIRED(GetServiceReferences(extraFilter, 2) == nMatching, "# references after modification")
+
+  props["perf.service.extra"] = 1;
+  extraReg.SetProperties(props);
+  US_TEST_CONDITION_REQUIRED(GetServiceReferences(extraFilter, 2) == nMatching + 1, "# references after second modification")
+
+  extraReg.Unregister();
+  US_TEST_CONDITION_REQUIRED(GetServiceReferences(extraFilter, 2) == nMatching, "# references after unregistration")
+}
+
+std::size_t ServiceRegistryPerformanceTest::GetServiceReferences(const std::string& filter, int n)
+{
+  std::size_t count = 0;
+  for (int i = 0; i < n; i++)
+  {
+    count = mc->GetServiceReferences<IPerfTestService>(filter).size();
+  }
+  return count;
+}
+
 void ServiceRegistryPerformanceTest::TestUnregisterServices()
 {
   Log() << "Unregister all services, and check that we get #of services ("
@@ -421,6 +497,7 @@ int usServiceRegistryPerformanceTest(int /*argc*/, char* /*argv*/[])
   perfTest.TestAddListeners();
   perfTest.TestRegisterServices();
   perfTest.TestModifyServices();
+  perfTest.TestGetServiceReferences();
   perfTest.TestUnregisterServices();
   perfTest.CleanupTestCase();
 
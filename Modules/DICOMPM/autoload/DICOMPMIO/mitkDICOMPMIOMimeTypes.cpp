@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkDICOMPMIOMimeTypes.h"
 #include "mitkIOMimeTypes.h"
 
+#include <mitkFileProbe.h>
 #include <mitkLog.h>
 
 #include <itkGDCMImageIO.h>
@@ -42,18 +43,11 @@ namespace mitk
 
   bool MitkDICOMPMIOMimeTypes::MitkDICOMPMMimeType::AppliesTo(const std::string &path) const
   {
-    std::ifstream myfile;
-    myfile.open(path, std::ios::binary);
-    //    myfile.seekg (128);
-    char *buffer = new char[128];
-    myfile.read(buffer, 128);
-    myfile.read(buffer, 4);
-    if (std::string(buffer).compare("DICM") != 0)
+    auto probe = FileProbe::Get(path);
+    if (!probe->IsDicom())
     {
-      delete[] buffer;
       return false;
     }
-    delete[] buffer;
 
     bool canRead(CustomMimeType::AppliesTo(path));
 
@@ -66,6 +60,18 @@ namespace mitk
       return canRead;
     }
     // end fix for bug 18572
+
+    if (!canRead)
+    {
+      return canRead;
+    }
+
+    std::string probedModality;
+    if (probe->FindDicomElement(0x0008, 0x0060, probedModality) && !probedModality.empty())
+    {
+      return probedModality == "RWV";
+    }
+
     DcmFileFormat dcmFileFormat;
     OFCondition status = dcmFileFormat.loadFile(path.c_str());
 
@@ -0,0 +1,176 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __itkShortestPathTree_h
+#define __itkShortestPathTree_h
+
+#include "itkShortestPathCostFunction.h"
+
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace itk
+{
+  /** \brief Single-source shortest path tree over an 8-connected 2D pixel grid.
+
+  In contrast to ShortestPathImageFilter, which searches one path between a start and
+  an end index per update, this class computes the shortest path tree rooted at a
+  source index (intelligent scissors). Once the tree has reached a pixel, the path
+  from the source to that pixel is a plain back-pointer walk. This makes it suitable
+  for interactive live wire, where the source (the anchor) changes rarely but the
+  target (the cursor) changes with every mouse move.
+
+  - Edge costs are requested from the cost function only once and cached, so they
+    survive changes of the source. If the cost function changes, the cache has to be
+    invalidated by InvalidateCosts().
+  - Path costs are quantized to integers and kept in a monotone radix heap.
+  - After SetSource() the tree is expanded incrementally by a background thread.
+    GetPath() expands the tree on demand until the requested target is settled.
+
+  The cost function is only evaluated under the internal lock. Callers must therefore
+  use Stop() or InvalidateCosts() before modifying the cost function.
+  */
+  template <class TInputImageType>
+  class ShortestPathTree : public Object
+  {
+  public:
+    /** Standard class typedefs. */
+    typedef ShortestPathTree Self;
+    typedef Object Superclass;
+    typedef SmartPointer<Self> Pointer;
+    typedef SmartPointer<const Self> ConstPointer;
+
+    /** Method for creation through the object factory. */
+    itkFactorylessNewMacro(Self);
+
+    /** Run-time type information (and related methods). */
+    itkTypeMacro(ShortestPathTree, Object);
+
+    typedef TInputImageType ImageType;
+    typedef typename TInputImageType::ConstPointer ImageConstPointer;
+    typedef typename TInputImageType::IndexType IndexType;
+    typedef ShortestPathCostFunction<TInputImageType> CostFunctionType;
+    typedef typename CostFunctionType::Pointer CostFunctionPointer;
+    typedef std::vector<IndexType> PathType;
+
+    typedef std::uint32_t NodeNumType;
+    typedef std::uint64_t DistanceType;
+
+    /** \brief Set the image defining the grid. Resets the tree and the edge cost cache.*/
+    void SetImage(const TInputImageType *image);
+
+    /** \brief Set the cost function used to compute edge costs. Resets the tree and the edge cost cache.*/
+    void SetCostFunction(CostFunctionType *costFunction);
+
+    /** \brief If enabled (default), the tree is expanded by a background thread after SetSource().*/
+    itkSetMacro(ComputeInBackground, bool);
+    itkGetMacro(ComputeInBackground, bool);
+
+    /** \brief Discard all cached edge costs and the current tree.*/
+    void InvalidateCosts();
+
+    /** \brief Discard the cached costs of all edges touching the given index and the current tree.*/
+    void InvalidateCosts(const IndexType &index);
+
+    /** \brief Start a new tree rooted at the given index.
+    \note The cost function has to be initialized by the caller.*/
+    void SetSource(const IndexType &source);
+
+    /** \brief Returns true if a valid tree rooted at the given index exists.*/
+    bool HasSource(const IndexType &source) const;
+
+    /** \brief Get the shortest path from the source to the given target, including both.
+    Expands the tree until the target is settled if necessary.
+    \return false if no tree is available or the target is outside the image.*/
+    bool GetPath(const IndexType &target, PathType &path);
+
+    /** \brief Stop the background expansion. The tree stays valid and can be expanded further by GetPath().*/
+    void Stop();
+
+  protected:
+    ShortestPathTree();
+    ~ShortestPathTree() override;
+
+    void PrintSelf(std::ostream &os, Indent indent) const override;
+
+  private:
+    ShortestPathTree(const Self &); // purposely not implemented
+    void operator=(const Self &);   // purposely not implemented
+
+    enum NodeState : unsigned char
+    {
+      UNVISITED = 0,
+      QUEUED = 1,
+      SETTLED = 2
+    };
+
+    /** Monotone priority queue for integer keys (radix heap). */
+    struct HeapEntry
+    {
+      DistanceType distance;
+      NodeNumType node;
+    };
+
+    static const unsigned int NumberOfNeighbors = 8;
+    static const unsigned int NumberOfBuckets = 65;
+
+    void ResetTree();
+    void Push(DistanceType distance, NodeNumType node);
+    bool Pop(HeapEntry &entry);
+    unsigned int GetBucket(DistanceType distance) const;
+
+    /** Settle the next node of the heap. Returns false if the heap is exhausted. Requires the lock.*/
+    bool ExpandNext();
+    float GetEdgeCost(NodeNumType node, unsigned int neighbor, NodeNumType neighborNode);
+    bool IsInside(const IndexType &index) const;
+    NodeNumType IndexToNode(const IndexType &index) const;
+    IndexType NodeToIndex(NodeNumType node) const;
+    void BackgroundExpansion();
+
+    ImageConstPointer m_Image;
+    CostFunctionPointer m_CostFunction;
+    IndexType m_RegionIndex;
+    long m_Width;
+    long m_Height;
+    NodeNumType m_NumberOfNodes;
+
+    std::vector<float> m_EdgeCosts;
+    std::vector<DistanceType> m_Distances;
+    std::vector<NodeNumType> m_Parents;
+    std::vector<unsigned char> m_States;
+
+    std::vector<HeapEntry> m_Buckets[NumberOfBuckets];
+    DistanceType m_LastPopped;
+    std::size_t m_HeapSize;
+
+    IndexType m_Source;
+    bool m_TreeValid;
+    bool m_ComputeInBackground;
+
+    std::mutex m_Mutex;
+    std::thread m_Worker;
+    std::atomic<bool> m_StopWorker;
+  };
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkShortestPathTree.txx"
+#endif
+
+#endif /* __itkShortestPathTree_h */
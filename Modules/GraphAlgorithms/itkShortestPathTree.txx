@@ -0,0 +1,400 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __itkShortestPathTree_txx
+#define __itkShortestPathTree_txx
+
+#include "itkShortestPathTree.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+  namespace ShortestPathTreeDetail
+  {
+    // offsets of the 8-connected neighborhood, opposite neighbors are at k and 7 - k
+    inline constexpr long NeighborOffsetX[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+    inline constexpr long NeighborOffsetY[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
+
+    // edge costs are quantized to integers for the radix heap
+    inline constexpr double CostQuantization = 10000.0;
+
+    // marks an edge cost that has not been requested from the cost function yet
+    inline constexpr float UnknownCost = -1.0f;
+
+    // number of nodes settled by the background thread per lock
+    inline constexpr unsigned int ExpansionChunkSize = 2048;
+  }
+
+  template <class TInputImageType>
+  ShortestPathTree<TInputImageType>::ShortestPathTree()
+    : m_Width(0),
+      m_Height(0),
+      m_NumberOfNodes(0),
+      m_LastPopped(0),
+      m_HeapSize(0),
+      m_TreeValid(false),
+      m_ComputeInBackground(true),
+      m_StopWorker(false)
+  {
+    m_RegionIndex.Fill(0);
+    m_Source.Fill(0);
+  }
+
+  template <class TInputImageType>
+  ShortestPathTree<TInputImageType>::~ShortestPathTree()
+  {
+    this->Stop();
+  }
+
+  template <class TInputImageType>
+  void ShortestPathTree<TInputImageType>::SetImage(const TInputImageType *image)
+  {
+    this->Stop();
+
+    m_Image = image;
+    m_TreeValid = false;
+
+    if (m_Image.IsNull())
+    {
+      m_Width = m_Height = 0;
+      m_NumberOfNodes = 0;
+    }
+    else
+    {
+      auto region = m_Image->GetLargestPossibleRegion();
+      m_RegionIndex = region.GetIndex();
+      m_Width = static_cast<long>(region.GetSize()[0]);
+      m_Height = static_cast<long>(region.GetSize()[1]);
+      m_NumberOfNodes = static_cast<NodeNumType>(m_Width * m_Height);
+    }
+
+    m_EdgeCosts.assign(static_cast<std::size_t>(m_NumberOfNodes) * NumberOfNeighbors, ShortestPathTreeDetail::UnknownCost);
+    m_Distances.resize(m_NumberOfNodes);
+    m_Parents.resize(m_NumberOfNodes);
+    m_States.resize(m_NumberOfNodes);
+
+    this->Modified();
+  }
+
+  template <class TInputImageType>
+  void ShortestPathTree<TInputImageType>::SetCostFunction(CostFunctionType *costFunction)
+  {
+    if (m_CostFunction != costFunction)
+    {
+      this->InvalidateCosts();
+      m_CostFunction = costFunction;
+      this->Modified();
+    }
+  }
+
+  template <class TInputImageType>
+  void ShortestPathTree<TInputImageType>::InvalidateCosts()
+  {
+    this->Stop();
+    std::fill(m_EdgeCosts.begin(), m_EdgeCosts.end(), ShortestPathTreeDetail::UnknownCost);
+    m_TreeValid = false;
+  }
+
+  template <class TInputImageType>
+  void ShortestPathTree<TInputImageType>::InvalidateCosts(const IndexType &index)
+  {
+    this->Stop();
+    m_TreeValid = false;
+
+    if (!this->IsInside(index))
+      return;
+
+    const NodeNumType node = this->IndexToNode(index);
+
+    for (unsigned int k = 0; k < NumberOfNeighbors; ++k)
+    {
+      IndexType neighborIndex = index;
+      neighborIndex[0] += ShortestPathTreeDetail::NeighborOffsetX[k];
+      neighborIndex[1] += ShortestPathTreeDetail::NeighborOffsetY[k];
+
+      // outgoing edge of the node
+      m_EdgeCosts[static_cast<std::size_t>(node) * NumberOfNeighbors + k] = ShortestPathTreeDetail::UnknownCost;
+
+      // incoming edge from the neighbor
+      if (this->IsInside(neighborIndex))
+      {
+        const NodeNumType neighborNode = this->IndexToNode(neighborIndex);
+        m_EdgeCosts[static_cast<std::size_t>(neighborNode) * NumberOfNeighbors + (NumberOfNeighbors - 1 - k)] =
+          ShortestPathTreeDetail::UnknownCost;
+      }
+    }
+  }
+
+  template <class TInputImageType>
+  void ShortestPathTree<TInputImageType>::SetSource(const IndexType &source)
+  {
+    this->Stop();
+
+    if (m_CostFunction.IsNull() || !this->IsInside(source))
+    {
+      m_TreeValid = false;
+      itkExceptionMacro("ShortestPathTree: no cost function set or source outside of the image.");
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+
+      m_Source = source;
+      this->ResetTree();
+
+      const NodeNumType sourceNode = this->IndexToNode(source);
+      m_Distances[sourceNode] = 0;
+      m_Parents[sourceNode] = sourceNode;
+      m_States[sourceNode] = QUEUED;
+      this->Push(0, sourceNode);
+
+      m_TreeValid = true;
+    }
+
+    if (m_ComputeInBackground)
+    {
+      m_StopWorker = false;
+      m_Worker = std::thread(&Self::BackgroundExpansion, this);
+    }
+  }
+
+  template <class TInputImageType>
+  bool ShortestPathTree<TInputImageType>::HasSource(const IndexType &source) const
+  {
+    return m_TreeValid && m_Source == source;
+  }
+
+  template <class TInputImageType>
+  bool ShortestPathTree<TInputImageType>::GetPath(const IndexType &target, PathType &path)
+  {
+    path.clear();
+
+    if (!m_TreeValid || !this->IsInside(target))
+      return false;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    const NodeNumType targetNode = this->IndexToNode(target);
+
+    while (m_States[targetNode] != SETTLED)
+    {
+      if (!this->ExpandNext())
+        return false; // target is not reachable
+    }
+
+    // back-pointer walk from the target to the source
+    NodeNumType node = targetNode;
+    path.push_back(this->NodeToIndex(node));
+    while (m_Parents[node] != node)
+    {
+      node = m_Parents[node];
+      path.push_back(this->NodeToIndex(node));
+    }
+
+    std::reverse(path.begin(), path.end());
+    return true;
+  }
+
+  template <class TInputImageType>
+  void ShortestPathTree<TInputImageType>::Stop()
+  {
+    if (m_Worker.joinable())
+    {
+      m_StopWorker = true;
+      m_Worker.join();
+      m_StopWorker = false;
+    }
+  }
+
+  template <class TInputImageType>
+  void ShortestPathTree<TInputImageType>::BackgroundExpansion()
+  {
+    bool expanding = true;
+
+    while (expanding && !m_StopWorker)
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+
+      for (unsigned int i = 0; i < ShortestPathTreeDetail::ExpansionChunkSize && expanding; ++i)
+      {
+        expanding = this->ExpandNext();
+      }
+    }
+  }
+
+  template <class TInputImageType>
+  void ShortestPathTree<TInputImageType>::ResetTree()
+  {
+    std::fill(m_States.begin(), m_States.end(), static_cast<unsigned char>(UNVISITED));
+
+    for (auto &bucket : m_Buckets)
+      bucket.clear();
+
+    m_LastPopped = 0;
+    m_HeapSize = 0;
+  }
+
+  template <class TInputImageType>
+  bool ShortestPathTree<TInputImageType>::ExpandNext()
+  {
+    HeapEntry entry;
+
+    // skip outdated heap entries (lazy deletion instead of decrease-key)
+    do
+    {
+      if (!this->Pop(entry))
+        return false;
+    } while (m_States[entry.node] == SETTLED || entry.distance != m_Distances[entry.node]);
+
+    const NodeNumType node = entry.node;
+    m_States[node] = SETTLED;
+
+    const IndexType index = this->NodeToIndex(node);
+
+    for (unsigned int k = 0; k < NumberOfNeighbors; ++k)
+    {
+      IndexType neighborIndex = index;
+      neighborIndex[0] += ShortestPathTreeDetail::NeighborOffsetX[k];
+      neighborIndex[1] += ShortestPathTreeDetail::NeighborOffsetY[k];
+
+      if (!this->IsInside(neighborIndex))
+        continue;
+
+      const NodeNumType neighborNode = this->IndexToNode(neighborIndex);
+
+      if (m_States[neighborNode] == SETTLED)
+        continue;
+
+      const DistanceType distance =
+        entry.distance + static_cast<DistanceType>(std::llround(
+                           static_cast<double>(this->GetEdgeCost(node, k, neighborNode)) *
+                           ShortestPathTreeDetail::CostQuantization));
+
+      if (m_States[neighborNode] == UNVISITED || distance < m_Distances[neighborNode])
+      {
+        m_States[neighborNode] = QUEUED;
+        m_Distances[neighborNode] = distance;
+        m_Parents[neighborNode] = node;
+        this->Push(distance, neighborNode);
+      }
+    }
+
+    return true;
+  }
+
+  template <class TInputImageType>
+  float ShortestPathTree<TInputImageType>::GetEdgeCost(NodeNumType node, unsigned int neighbor, NodeNumType neighborNode)
+  {
+    float &cost = m_EdgeCosts[static_cast<std::size_t>(node) * NumberOfNeighbors + neighbor];
+
+    if (cost < 0.0f)
+    {
+      cost = static_cast<float>(std::max(0.0, m_CostFunction->GetCost(this->NodeToIndex(node), this->NodeToIndex(neighborNode))));
+    }
+
+    return cost;
+  }
+
+  template <class TInputImageType>
+  unsigned int ShortestPathTree<TInputImageType>::GetBucket(DistanceType distance) const
+  {
+    // index of the highest bit in which the distance differs from the last popped one
+    DistanceType difference = distance ^ m_LastPopped;
+    unsigned int bucket = 0;
+
+    while (difference != 0)
+    {
+      ++bucket;
+      difference >>= 1;
+    }
+
+    return bucket;
+  }
+
+  template <class TInputImageType>
+  void ShortestPathTree<TInputImageType>::Push(DistanceType distance, NodeNumType node)
+  {
+    m_Buckets[this->GetBucket(distance)].push_back({distance, node});
+    ++m_HeapSize;
+  }
+
+  template <class TInputImageType>
+  bool ShortestPathTree<TInputImageType>::Pop(HeapEntry &entry)
+  {
+    if (m_HeapSize == 0)
+      return false;
+
+    if (m_Buckets[0].empty())
+    {
+      unsigned int bucket = 1;
+      while (m_Buckets[bucket].empty())
+        ++bucket;
+
+      // redistribute the first non-empty bucket relative to its minimum
+      auto &entries = m_Buckets[bucket];
+      m_LastPopped = std::min_element(entries.begin(), entries.end(), [](const HeapEntry &a, const HeapEntry &b) {
+                       return a.distance < b.distance;
+                     })->distance;
+
+      for (const auto &e : entries)
+        m_Buckets[this->GetBucket(e.distance)].push_back(e);
+
+      entries.clear();
+    }
+
+    entry = m_Buckets[0].back();
+    m_Buckets[0].pop_back();
+    --m_HeapSize;
+
+    return true;
+  }
+
+  template <class TInputImageType>
+  bool ShortestPathTree<TInputImageType>::IsInside(const IndexType &index) const
+  {
+    const long x = index[0] - m_RegionIndex[0];
+    const long y = index[1] - m_RegionIndex[1];
+    return x >= 0 && y >= 0 && x < m_Width && y < m_Height;
+  }
+
+  template <class TInputImageType>
+  typename ShortestPathTree<TInputImageType>::NodeNumType ShortestPathTree<TInputImageType>::IndexToNode(
+    const IndexType &index) const
+  {
+    return static_cast<NodeNumType>((index[1] - m_RegionIndex[1]) * m_Width + (index[0] - m_RegionIndex[0]));
+  }
+
+  template <class TInputImageType>
+  typename ShortestPathTree<TInputImageType>::IndexType ShortestPathTree<TInputImageType>::NodeToIndex(
+    NodeNumType node) const
+  {
+    IndexType index;
+    index[0] = static_cast<long>(node % m_Width) + m_RegionIndex[0];
+    index[1] = static_cast<long>(node / m_Width) + m_RegionIndex[1];
+    return index;
+  }
+
+  template <class TInputImageType>
+  void ShortestPathTree<TInputImageType>::PrintSelf(std::ostream &os, Indent indent) const
+  {
+    Superclass::PrintSelf(os, indent);
+    os << indent << "Number of nodes: " << m_NumberOfNodes << std::endl;
+    os << indent << "Source: " << m_Source << std::endl;
+    os << indent << "Tree valid: " << m_TreeValid << std::endl;
+    os << indent << "Compute in background: " << m_ComputeInBackground << std::endl;
+  }
+
+} // end namespace itk
+
+#endif // __itkShortestPathTree_txx
@@ -0,0 +1,86 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkLatencyHistogram.h"
+
+#include <algorithm>
+
+mitk::LatencyHistogram::LatencyHistogram(double binWidth, unsigned int numberOfBins)
+  : m_BinWidth(binWidth > 0.0 ? binWidth : 0.1),
+    m_BinCounts(std::max(numberOfBins, 1u), 0),
+    m_NumberOfSamples(0),
+    m_Sum(0.0),
+    m_Maximum(0.0)
+{
+}
+
+void mitk::LatencyHistogram::AddSample(double latency)
+{
+  latency = std::max(latency, 0.0);
+
+  const double bin = latency / m_BinWidth;
+  const std::size_t lastBin = m_BinCounts.size() - 1;
+  ++m_BinCounts[bin < lastBin ? static_cast<std::size_t>(bin) : lastBin];
+
+  ++m_NumberOfSamples;
+  m_Sum += latency;
+  m_Maximum = std::max(m_Maximum, latency);
+}
+
+void mitk::LatencyHistogram::Reset()
+{
+  std::fill(m_BinCounts.begin(), m_BinCounts.end(), 0);
+  m_NumberOfSamples = 0;
+  m_Sum = 0.0;
+  m_Maximum = 0.0;
+}
+
+std::uint64_t mitk::LatencyHistogram::GetNumberOfSamples() const
+{
+  return m_NumberOfSamples;
+}
+
+double mitk::LatencyHistogram::GetMean() const
+{
+  return m_NumberOfSamples > 0 ? m_Sum / m_NumberOfSamples : 0.0;
+}
+
+double mitk::LatencyHistogram::GetMaximum() const
+{
+  return m_Maximum;
+}
+
+double mitk::LatencyHistogram::GetPercentile(double percentile) const
+{
+  if (m_NumberOfSamples == 0)
+    return 0.0;
+
+  const double rank = std::min(std::max(percentile, 0.0), 100.0) / 100.0 * m_NumberOfSamples;
+  std::uint64_t count = 0;
+  for (std::size_t bin = 0; bin < m_BinCounts.size(); ++bin)
+  {
+    count += m_BinCounts[bin];
+    if (count > 0 && count >= rank)
+      return std::min((bin + 1) * m_BinWidth, m_Maximum);
+  }
+  return m_Maximum;
+}
+
+double mitk::LatencyHistogram::GetBinWidth() const
+{
+  return m_BinWidth;
+}
+
+const std::vector<std::uint64_t> &mitk::LatencyHistogram::GetBinCounts() const
+{
+  return m_BinCounts;
+}
@@ -0,0 +1,74 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLatencyHistogram_h
+#define mitkLatencyHistogram_h
+
+#include <MitkIGTExports.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace mitk
+{
+  /**Documentation
+  * \brief Fixed bin histogram of latencies in milliseconds.
+  *
+  * Samples are counted in bins of GetBinWidth() milliseconds. Samples beyond the
+  * last bin are counted in the last bin. Adding a sample does not allocate memory,
+  * so the histogram can be updated for every tracking sample.
+  *
+  * The class is not thread safe.
+  *
+  * \ingroup IGT
+  */
+  class MITKIGT_EXPORT LatencyHistogram
+  {
+  public:
+    /**
+    * \param binWidth width of a bin in milliseconds, default is 0.1 ms
+    * \param numberOfBins number of bins, default covers 0 to 100 ms
+    */
+    LatencyHistogram(double binWidth = 0.1, unsigned int numberOfBins = 1000);
+
+    void AddSample(double latency);
+
+    void Reset();
+
+    std::uint64_t GetNumberOfSamples() const;
+
+    /** \return the mean latency in milliseconds, 0 if there are no samples */
+    double GetMean() const;
+
+    /** \return the maximum latency in milliseconds, 0 if there are no samples */
+    double GetMaximum() const;
+
+    /**
+    * \brief Returns the upper bound of the bin that contains the given percentile.
+    * \param percentile value between 0 and 100
+    */
+    double GetPercentile(double percentile) const;
+
+    double GetBinWidth() const;
+
+    const std::vector<std::uint64_t> &GetBinCounts() const;
+
+  private:
+    double m_BinWidth;
+    std::vector<std::uint64_t> m_BinCounts;
+    std::uint64_t m_NumberOfSamples;
+    double m_Sum;
+    double m_Maximum;
+  };
+}
+
+#endif
@@ -20,7 +20,7 @@ found in the LICENSE file.
 #include "mitkIGTHardwareException.h"
 
 mitk::TrackingDeviceSource::TrackingDeviceSource()
-  : mitk::NavigationDataSource(), m_TrackingDevice(nullptr)
+  : mitk::NavigationDataSource(), m_TrackingDevice(nullptr), m_LastDataUpdate(0)
 {
 }
 
@@ -60,6 +60,11 @@ void mitk::TrackingDeviceSource::GenerateData()
       << m_TrackingDevice->GetToolCount() << " tools available in the tracking device.";
     throw std::out_of_range(ss.str());
   }
+  // check whether the device reported new data since the last update, to measure its latency
+  std::chrono::steady_clock::time_point dataArrival;
+  const std::uint64_t dataUpdate = m_TrackingDevice->GetNumberOfDataUpdates(&dataArrival);
+  const bool newData = dataUpdate != m_LastDataUpdate && dataUpdate != 0;
+
   /* update outputs with tracking data from tools */
   unsigned int toolCount = m_TrackingDevice->GetToolCount();
   for (unsigned int i = 0; i < toolCount; ++i)
@@ -89,6 +94,14 @@ void mitk::TrackingDeviceSource::GenerateData()
     //for backward compatibility: check if the timestamp was set, if not create a default timestamp
     if (nd->GetIGTTimeStamp()==0) nd->SetIGTTimeStamp(mitk::IGTTimeStamp::GetInstance()->GetElapsed());
   }
+
+  if (newData)
+  {
+    const double latency = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - dataArrival).count();
+    std::lock_guard<std::mutex> lock(m_LatencyHistogramMutex);
+    m_LatencyHistogram.AddSample(latency);
+  }
+  m_LastDataUpdate = dataUpdate;
 }
 
 void mitk::TrackingDeviceSource::SetTrackingDevice( mitk::TrackingDevice* td )
@@ -118,6 +131,11 @@ void mitk::TrackingDeviceSource::CreateOutputs(){
     return;
 
   this->SetNumberOfIndexedOutputs(m_TrackingDevice->GetToolCount());  // create outputs for all tools
+  {
+    std::lock_guard<std::mutex> lock(m_LatencyHistogramMutex);
+    m_LatencyHistogram.Reset();
+  }
+  m_LastDataUpdate = m_TrackingDevice->GetNumberOfDataUpdates();
   unsigned int numberOfOutputs = this->GetNumberOfIndexedOutputs();
   MITK_DEBUG << "Number of tools at start of method CreateOutputs(): " << m_TrackingDevice->GetToolCount();
   MITK_DEBUG << "Number of outputs at start of method CreateOutputs(): " << numberOfOutputs;
@@ -195,6 +213,26 @@ void mitk::TrackingDeviceSource::UpdateOutputInformation()
 //  return 0;
 //}
 
+bool mitk::TrackingDeviceSource::WaitForNewData(unsigned int timeoutInMilliseconds)
+{
+  if (m_TrackingDevice.IsNull())
+    return false;
+
+  return m_TrackingDevice->WaitForNewData(m_LastDataUpdate, timeoutInMilliseconds);
+}
+
+mitk::LatencyHistogram mitk::TrackingDeviceSource::GetLatencyHistogram() const
+{
+  std::lock_guard<std::mutex> lock(m_LatencyHistogramMutex);
+  return m_LatencyHistogram;
+}
+
+void mitk::TrackingDeviceSource::ResetLatencyHistogram()
+{
+  std::lock_guard<std::mutex> lock(m_LatencyHistogramMutex);
+  m_LatencyHistogram.Reset();
+}
+
 bool mitk::TrackingDeviceSource::IsConnected()
 {
   if (m_TrackingDevice.IsNull())
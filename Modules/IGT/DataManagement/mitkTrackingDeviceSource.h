@@ -15,6 +15,10 @@ found in the LICENSE file.
 
 #include <mitkNavigationDataSource.h>
 #include "mitkTrackingDevice.h"
+#include "mitkLatencyHistogram.h"
+
+#include <atomic>
+#include <mutex>
 
 namespace mitk {
   /**Documentation
@@ -33,6 +37,11 @@ namespace mitk {
   * \warning If a tool is removed from the tracking device, there will be a mismatch between
   * the outputs and the tool number!
   *
+  * Instead of updating the pipeline in fixed intervals, consumers can block in WaitForNewData()
+  * and update the pipeline as soon as the tracking device reports new data. The latency between
+  * the arrival of new data at the tracking device and its output by this source is recorded in a
+  * mitk::LatencyHistogram. It does not include the time a consumer needs to process the output.
+  *
   * \ingroup IGT
   */
   class MITKIGT_EXPORT TrackingDeviceSource : public NavigationDataSource
@@ -104,6 +113,26 @@ namespace mitk {
     */
     void UpdateOutputInformation() override;
 
+    /**
+    * \brief Blocks until the tracking device reports data that was not yet output by this source
+    * or the timeout expired.
+    *
+    * Typical use in a consumer thread: while (source->WaitForNewData(100)) { lastFilter->Update(); }
+    * \return true if new data is available, false after the timeout or if no tracking device is set.
+    */
+    bool WaitForNewData(unsigned int timeoutInMilliseconds);
+
+    /**
+    * \brief Returns the latencies in milliseconds between the arrival of new data at the tracking
+    * device and its output by this source.
+    *
+    * The tracking device reports the arrival of data for all tools at once, so there is one sample
+    * per data update of the device and not per tool.
+    */
+    LatencyHistogram GetLatencyHistogram() const;
+
+    void ResetLatencyHistogram();
+
   protected:
     TrackingDeviceSource();
     ~TrackingDeviceSource() override;
@@ -126,6 +155,11 @@ namespace mitk {
     void CreateOutputs();
 
     mitk::TrackingDevice::Pointer m_TrackingDevice;  ///< the tracking device that is used as a source for this filter object
+
+    std::atomic<std::uint64_t> m_LastDataUpdate; ///< number of data updates of the tracking device at the last GenerateData()
+
+    LatencyHistogram m_LatencyHistogram;
+    mutable std::mutex m_LatencyHistogramMutex;
   };
 } // namespace mitk
 #endif
@@ -14,6 +14,7 @@ found in the LICENSE file.
 
 #include <itksys/SystemTools.hxx>
 #include <mitkIGTTimeStamp.h>
+#include <algorithm>
 #include <fstream>
 
 #include "mitkIGTException.h"
@@ -33,7 +34,7 @@ mitk::NavigationDataPlayer::~NavigationDataPlayer()
 
 void mitk::NavigationDataPlayer::GenerateData()
 {
-  if ( m_NavigationDataSet->Size() == 0 )
+  if ( this->GetNumberOfSnapshots() == 0 )
   {
     MITK_WARN << "Cannot do anything with empty set of navigation datas.";
     return;
@@ -54,30 +55,33 @@ void mitk::NavigationDataPlayer::GenerateData()
   // imediatly with the first navigation data (not to wait till the first time
   // stamp is reached)
   TimeStampType timeStampSinceStartWithOffset = m_TimeStampSinceStart
-      + m_NavigationDataSet->Begin()->at(0)->GetIGTTimeStamp();
+      + this->GetSnapshotTimeStamp(0);
 
-  // iterate through all NavigationData objects of the given tool index
-  // till the timestamp of the NavigationData is greater then the given timestamp
-  for (; m_NavigationDataSetIterator != m_NavigationDataSet->End(); ++m_NavigationDataSetIterator)
+  const unsigned int numberOfSnapshots = this->GetNumberOfSnapshots();
+  if (m_NavigationDataStreamReader.IsNotNull())
   {
-    // test if the timestamp of the successor is greater than the time stamp
-    if ( m_NavigationDataSetIterator+1 == m_NavigationDataSet->End() ||
-        (m_NavigationDataSetIterator+1)->at(0)->GetIGTTimeStamp() > timeStampSinceStartWithOffset )
+    // seek via the index of the stream instead of touching every skipped snapshot
+    m_CurrentSnapshot = std::max(m_CurrentSnapshot, m_NavigationDataStreamReader->FindSnapshot(timeStampSinceStartWithOffset));
+  }
+  else
+  {
+    // iterate through all NavigationData objects of the given tool index
+    // till the timestamp of the NavigationData is greater then the given timestamp
+    for (; m_CurrentSnapshot < numberOfSnapshots; ++m_CurrentSnapshot)
     {
-      break;
+      // test if the timestamp of the successor is greater than the time stamp
+      if ( m_CurrentSnapshot+1 == numberOfSnapshots ||
+          this->GetSnapshotTimeStamp(m_CurrentSnapshot+1) > timeStampSinceStartWithOffset )
+      {
+        break;
+      }
     }
   }
 
-  for (unsigned int index = 0; index < GetNumberOfOutputs(); index++)
-  {
-    mitk::NavigationData* output = this->GetOutput(index);
-    if( !output ) { mitkThrowException(mitk::IGTException) << "Output of index "<<index<<" is null."; }
-
-    output->Graft(m_NavigationDataSetIterator->at(index));
-  }
+  this->GraftSnapshot(m_CurrentSnapshot);
 
   // stop playing if the last NavigationData objects were grafted
-  if (m_NavigationDataSetIterator+1 == m_NavigationDataSet->End())
+  if (m_CurrentSnapshot+1 == numberOfSnapshots)
   {
     this->StopPlaying();
 
@@ -97,9 +101,9 @@ void mitk::NavigationDataPlayer::StartPlaying()
   // make sure that player is initialized before playing starts
   this->InitPlayer();
 
-  // set state and iterator for playing from start
+  // set state and snapshot for playing from start
   m_CurPlayerState = PlayerRunning;
-  m_NavigationDataSetIterator = m_NavigationDataSet->Begin();
+  m_CurrentSnapshot = 0;
 
   // reset playing timestamps
   m_PauseTimeStamp = 0;
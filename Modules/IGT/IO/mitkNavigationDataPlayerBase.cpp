@@ -16,7 +16,8 @@ found in the LICENSE file.
 #include "mitkIGTException.h"
 
 mitk::NavigationDataPlayerBase::NavigationDataPlayerBase()
-  : m_Repeat(false)
+  : m_Repeat(false),
+    m_CurrentSnapshot(0)
 {
   this->SetName("Navigation Data Player Source");
 }
@@ -33,30 +34,83 @@ void mitk::NavigationDataPlayerBase::UpdateOutputInformation()
 
 bool mitk::NavigationDataPlayerBase::IsAtEnd()
 {
-  return m_NavigationDataSetIterator == m_NavigationDataSet->End();
+  return m_CurrentSnapshot >= this->GetNumberOfSnapshots();
 }
 
 void mitk::NavigationDataPlayerBase::SetNavigationDataSet(NavigationDataSet::Pointer navigationDataSet)
 {
   m_NavigationDataSet = navigationDataSet;
-  m_NavigationDataSetIterator = navigationDataSet->Begin();
+  m_NavigationDataStreamReader = nullptr;
+  m_CurrentSnapshot = 0;
+
+  this->InitPlayer();
+}
+
+void mitk::NavigationDataPlayerBase::SetNavigationDataStreamReader(NavigationDataStreamReader::Pointer reader)
+{
+  if (reader.IsNull() || !reader->IsOpen())
+  {
+    mitkThrowException(mitk::IGTException) << "NavigationDataStreamReader has to be opened before it can be played.";
+  }
+
+  m_NavigationDataStreamReader = reader;
+  m_NavigationDataSet = nullptr;
+  m_CurrentSnapshot = 0;
 
   this->InitPlayer();
 }
 
 unsigned int mitk::NavigationDataPlayerBase::GetNumberOfSnapshots()
 {
+  if (m_NavigationDataStreamReader.IsNotNull())
+    return m_NavigationDataStreamReader->GetNumberOfSnapshots();
+
   return m_NavigationDataSet.IsNull() ? 0 : m_NavigationDataSet->Size();
 }
 
 unsigned int mitk::NavigationDataPlayerBase::GetCurrentSnapshotNumber()
 {
-  return m_NavigationDataSet.IsNull() ? 0 : m_NavigationDataSetIterator - m_NavigationDataSet->Begin();
+  return m_CurrentSnapshot;
+}
+
+unsigned int mitk::NavigationDataPlayerBase::GetNumberOfTools()
+{
+  if (m_NavigationDataStreamReader.IsNotNull())
+    return m_NavigationDataStreamReader->GetNumberOfTools();
+
+  return m_NavigationDataSet.IsNull() ? 0 : m_NavigationDataSet->GetNumberOfTools();
+}
+
+void mitk::NavigationDataPlayerBase::GraftSnapshot(unsigned int snapshot)
+{
+  for (unsigned int index = 0; index < this->GetNumberOfOutputs(); index++)
+  {
+    mitk::NavigationData* output = this->GetOutput(index);
+    if( !output ) { mitkThrowException(mitk::IGTException) << "Output of index "<<index<<" is null."; }
+
+    if (m_NavigationDataStreamReader.IsNotNull())
+    {
+      // decode directly into the output, no NavigationData is kept per snapshot
+      m_NavigationDataStreamReader->GetNavigationData(snapshot, index, output);
+    }
+    else
+    {
+      output->Graft(m_NavigationDataSet->GetNavigationDataForIndex(snapshot, index));
+    }
+  }
+}
+
+mitk::NavigationData::TimeStampType mitk::NavigationDataPlayerBase::GetSnapshotTimeStamp(unsigned int snapshot)
+{
+  if (m_NavigationDataStreamReader.IsNotNull())
+    return m_NavigationDataStreamReader->GetTimeStamp(snapshot);
+
+  return m_NavigationDataSet->GetNavigationDataForIndex(snapshot, 0)->GetIGTTimeStamp();
 }
 
 void mitk::NavigationDataPlayerBase::InitPlayer()
 {
-  if ( m_NavigationDataSet.IsNull() )
+  if ( m_NavigationDataSet.IsNull() && m_NavigationDataStreamReader.IsNull() )
   {
     mitkThrowException(mitk::IGTException)
       << "NavigationDataSet has to be set before initializing player.";
@@ -64,7 +118,7 @@ void mitk::NavigationDataPlayerBase::InitPlayer()
 
   if (GetNumberOfOutputs() == 0)
   {
-    unsigned int requiredOutputs = m_NavigationDataSet->GetNumberOfTools();
+    unsigned int requiredOutputs = this->GetNumberOfTools();
     this->SetNumberOfRequiredOutputs(requiredOutputs);
 
     for (unsigned int n = this->GetNumberOfOutputs(); n < requiredOutputs; ++n)
@@ -74,7 +128,7 @@ void mitk::NavigationDataPlayerBase::InitPlayer()
       this->Modified();
     }
   }
-  else if (GetNumberOfOutputs() != m_NavigationDataSet->GetNumberOfTools())
+  else if (GetNumberOfOutputs() != this->GetNumberOfTools())
   {
     mitkThrowException(mitk::IGTException)
       << "Number of tools cannot be changed in existing player. Please create "
@@ -87,7 +141,7 @@ void mitk::NavigationDataPlayerBase::InitPlayer()
 
 void mitk::NavigationDataPlayerBase::GraftEmptyOutput()
 {
-  for (unsigned int index = 0; index < m_NavigationDataSet->GetNumberOfTools(); index++)
+  for (unsigned int index = 0; index < this->GetNumberOfTools(); index++)
   {
     mitk::NavigationData* output = this->GetOutput(index);
     assert(output);
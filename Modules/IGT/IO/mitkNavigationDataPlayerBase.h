@@ -15,11 +15,13 @@ found in the LICENSE file.
 
 #include "mitkNavigationDataSource.h"
 #include "mitkNavigationDataSet.h"
+#include "mitkNavigationDataStreamReader.h"
 
 namespace mitk{
   /**
   * \brief Base class for using mitk::NavigationData as a filter source.
-  * Subclasses can play objects of mitk::NavigationDataSet.
+  * Subclasses can play objects of mitk::NavigationDataSet or navigation data stream
+  * files opened by a mitk::NavigationDataStreamReader.
   *
   * Each subclass has to check the state of m_Repeat and do or do not repeat
   * the playing accordingly.
@@ -59,8 +61,19 @@ namespace mitk{
     */
     void SetNavigationDataSet(NavigationDataSet::Pointer navigationDataSet);
 
+    itkGetMacro(NavigationDataStreamReader, NavigationDataStreamReader::Pointer);
+
     /**
-    * \brief Getter for the size of the mitk::NavigationDataSet used in this object.
+    * \brief Set an opened mitk::NavigationDataStreamReader for playing.
+    * Snapshots are read from the memory mapped stream file on demand instead of
+    * being kept in a mitk::NavigationDataSet. Replaces a previously set NavigationDataSet.
+    *
+    * @param reader mitk::NavigationDataStreamReader which will be played by this player.
+    */
+    void SetNavigationDataStreamReader(NavigationDataStreamReader::Pointer reader);
+
+    /**
+    * \brief Getter for the size of the mitk::NavigationDataSet or stream used in this object.
     *
     * @return Returns the number of navigation data snapshots available in the player.
     */
@@ -97,6 +110,18 @@ namespace mitk{
     */
     void GraftEmptyOutput();
 
+    /**
+    * \brief Grafts the given snapshot of the played set or stream into the outputs.
+    */
+    void GraftSnapshot(unsigned int snapshot);
+
+    /**
+    * \brief Returns the time stamp of the first tool in the given snapshot.
+    */
+    NavigationData::TimeStampType GetSnapshotTimeStamp(unsigned int snapshot);
+
+    unsigned int GetNumberOfTools();
+
     /**
     * \brief If the player should repeat outputs. Default is false.
     */
@@ -104,10 +129,12 @@ namespace mitk{
 
     NavigationDataSet::Pointer m_NavigationDataSet;
 
+    NavigationDataStreamReader::Pointer m_NavigationDataStreamReader;
+
     /**
-    * \brief Iterator always points to the NavigationData object which is in the outputs at the moment.
+    * \brief Index of the snapshot which is in the outputs at the moment. Equals GetNumberOfSnapshots() at the end.
     */
-    mitk::NavigationDataSet::NavigationDataSetConstIterator m_NavigationDataSetIterator;
+    unsigned int m_CurrentSnapshot;
   };
 } // namespace mitk
 
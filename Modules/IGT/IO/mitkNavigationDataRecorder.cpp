@@ -28,6 +28,17 @@ mitk::NavigationDataRecorder::NavigationDataRecorder()
 mitk::NavigationDataRecorder::~NavigationDataRecorder()
 {
   //mitk::IGTTimeStamp::GetInstance()->Stop(this); //commented out because of bug 18952
+  if (m_StreamWriter.IsNotNull())
+  {
+    try
+    {
+      m_StreamWriter->Close();
+    }
+    catch (const std::exception& e)
+    {
+      MITK_ERROR << "Could not finish navigation data stream " << m_StreamFileName << ": " << e.what();
+    }
+  }
 }
 
 void mitk::NavigationDataRecorder::GenerateData()
@@ -40,6 +51,9 @@ void mitk::NavigationDataRecorder::GenerateData()
 
   bool atLeastOneInputIsInvalid = false;
 
+  // when streaming, the inputs are written directly and need not be cloned
+  const bool streaming = m_StreamWriter.IsNotNull();
+
   // For each input
   for (unsigned int index=0; index < inputs.size(); index++)
   {
@@ -54,6 +68,8 @@ void mitk::NavigationDataRecorder::GenerateData()
        atLeastOneInputIsInvalid = true;
     }
 
+    if (streaming) continue;
+
     // Clone a Navigation Data
     mitk::NavigationData::Pointer clone = mitk::NavigationData::New();
     clone->Graft(this->GetInput(index));
@@ -67,13 +83,26 @@ void mitk::NavigationDataRecorder::GenerateData()
   }
 
   // if limitation is set and has been reached, stop recording
-  if ((m_RecordCountLimit > 0) && (m_NavigationDataSet->Size() >= static_cast<unsigned int>(m_RecordCountLimit)))
+  if ((m_RecordCountLimit > 0) && (this->GetNumberOfRecordedSteps() >= m_RecordCountLimit))
     m_Recording = false;
   // We can skip the rest of the method, if recording is deactivated
   if (!m_Recording) return;
   // We can skip the rest of the method, if we read only valid data
   if (m_RecordOnlyValidData && atLeastOneInputIsInvalid) return;
 
+  if (streaming)
+  {
+    m_StreamSnapshot.clear();
+    for (unsigned int index = 0; index < inputs.size(); index++)
+      m_StreamSnapshot.push_back(this->GetInput(index));
+
+    if (m_StandardizeTime)
+      m_StreamWriter->AddSnapshot(m_StreamSnapshot, mitk::IGTTimeStamp::GetInstance()->GetElapsed(this));
+    else
+      m_StreamWriter->AddSnapshot(m_StreamSnapshot);
+    return;
+  }
+
   // Add data to set
   m_NavigationDataSet->AddNavigationDatas(clonedDatas);
 }
@@ -85,6 +114,10 @@ void mitk::NavigationDataRecorder::StartRecording()
     MITK_WARN << "Already recording please stop before start new recording session";
     return;
   }
+
+  if (!m_StreamFileName.empty() && m_StreamWriter.IsNull())
+    this->OpenStream();
+
   m_Recording = true;
 
   // The first time this StartRecording is called, we initialize the standardized time.
@@ -104,14 +137,27 @@ void mitk::NavigationDataRecorder::StopRecording()
     return;
   }
   m_Recording = false;
+
+  // make everything recorded so far readable
+  if (m_StreamWriter.IsNotNull())
+    m_StreamWriter->Flush();
 }
 
 void mitk::NavigationDataRecorder::ResetRecording()
 {
   m_NavigationDataSet = mitk::NavigationDataSet::New(GetNumberOfIndexedInputs());
 
+  if (m_StreamWriter.IsNotNull())
+  {
+    m_StreamWriter->Close();
+    m_StreamWriter = nullptr;
+  }
+
   if (m_Recording)
   {
+    if (!m_StreamFileName.empty())
+      this->OpenStream();
+
     mitk::IGTTimeStamp::GetInstance()->Stop(this);
     mitk::IGTTimeStamp::GetInstance()->Start(this);
   }
@@ -119,5 +165,22 @@ void mitk::NavigationDataRecorder::ResetRecording()
 
 int mitk::NavigationDataRecorder::GetNumberOfRecordedSteps()
 {
+  if (m_StreamWriter.IsNotNull())
+    return m_StreamWriter->GetNumberOfSnapshots();
+
   return m_NavigationDataSet->Size();
 }
+
+void mitk::NavigationDataRecorder::OpenStream()
+{
+  std::vector<std::string> toolNames;
+  for (unsigned int index = 0; index < this->GetNumberOfIndexedInputs(); index++)
+  {
+    const char* name = this->GetInput(index)->GetName();
+    toolNames.push_back(name != nullptr ? name : "");
+  }
+
+  mitk::NavigationDataStreamWriter::Pointer writer = mitk::NavigationDataStreamWriter::New();
+  writer->Open(m_StreamFileName, toolNames);
+  m_StreamWriter = writer;
+}
@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkNavigationDataToNavigationDataFilter.h"
 #include "mitkNavigationData.h"
 #include "mitkNavigationDataSet.h"
+#include "mitkNavigationDataStreamWriter.h"
 
 namespace mitk
 {
@@ -27,6 +28,11 @@ namespace mitk
   * With StopRecording() the stream is stopped, but can be resumed anytime.
   * To start recording to a new NavigationDataSet, call ResetRecording();
   *
+  * If a stream file name is set, the data is not kept in memory but streamed to a binary
+  * navigation data stream file by a mitk::NavigationDataStreamWriter instead. StopRecording()
+  * writes all data recorded so far to the file, ResetRecording() or the destruction of the
+  * recorder finishes the file. Use mitk::NavigationDataStreamReader to play it back.
+  *
   * \warning Do not add inputs while the recorder ist recording. The recorder can't handle that and will cause a nullpointer exception.
   * \ingroup IGT
   */
@@ -78,6 +84,13 @@ namespace mitk
     */
     itkGetMacro(RecordOnlyValidData, bool);
 
+    /**
+    * \brief Sets the file the data is streamed to. Must be set before StartRecording().
+    * An empty file name (default) records into the NavigationDataSet.
+    */
+    itkSetStringMacro(StreamFileName);
+    itkGetStringMacro(StreamFileName);
+
     /**
     * \brief Starts recording NavigationData into the NavigationDataSet
     */
@@ -112,6 +125,12 @@ namespace mitk
 
     ~NavigationDataRecorder() override;
 
+    /**
+    * \brief Creates the stream writer and opens m_StreamFileName.
+    * @throw mitk::IGTIOException if the file cannot be created.
+    */
+    void OpenStream();
+
     unsigned int m_NumberOfInputs; ///< counts the numbers of added input NavigationDatas
 
     mitk::NavigationDataSet::Pointer m_NavigationDataSet;
@@ -125,6 +144,12 @@ namespace mitk
     int m_RecordCountLimit; ///< limits the number of frames, recording will be stopped if the limit is reached. -1 disables the limit
 
     bool m_RecordOnlyValidData; ///< indicates whether only valid data is recorded
+
+    std::string m_StreamFileName; ///< file the data is streamed to, empty if recording into m_NavigationDataSet
+
+    mitk::NavigationDataStreamWriter::Pointer m_StreamWriter;
+
+    std::vector<const mitk::NavigationData*> m_StreamSnapshot; ///< reused for every streamed snapshot
   };
 }
 #endif
@@ -0,0 +1,106 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkNavigationDataStreamFormat_h
+#define mitkNavigationDataStreamFormat_h
+
+#include <cstdint>
+
+namespace mitk
+{
+  /**
+  * \brief Layout of the binary navigation data stream files written by
+  * mitk::NavigationDataStreamWriter and read by mitk::NavigationDataStreamReader.
+  *
+  * A file consists of
+  * - a FileHeader,
+  * - the tool names as zero terminated strings, padded to a multiple of 8 bytes,
+  * - an arbitrary number of chunks, each a ChunkHeader followed by
+  *   ChunkHeader::NumberOfSnapshots * FileHeader::NumberOfTools Records (snapshot major),
+  * - an IndexHeader followed by one IndexEntry per chunk.
+  *
+  * Chunks are only appended. The index and the final values of the file header
+  * are written when the file is closed; if FileHeader::IndexOffset is 0 the file was
+  * not closed properly and the reader rebuilds the index by scanning the chunks.
+  *
+  * All values are stored in the native byte order of the recording machine
+  * (little endian on all supported platforms).
+  *
+  * \ingroup IGT
+  */
+  namespace NavigationDataStreamFormat
+  {
+    inline constexpr char FileMagic[8] = {'M', 'I', 'T', 'K', 'N', 'D', 'S', '1'};
+    inline constexpr char ChunkMagic[4] = {'N', 'D', 'C', 'K'};
+    inline constexpr char IndexMagic[4] = {'N', 'D', 'I', 'X'};
+    inline constexpr std::uint32_t Version = 1;
+    inline constexpr std::uint32_t DefaultSnapshotsPerChunk = 256;
+    inline constexpr unsigned int CovarianceSize = 21; ///< upper triangle of the symmetric 6x6 covariance matrix
+
+    struct FileHeader
+    {
+      char Magic[8];
+      std::uint32_t Version;
+      std::uint32_t NumberOfTools;
+      std::uint32_t RecordSize;
+      std::uint32_t SnapshotsPerChunk;
+      std::uint64_t NumberOfSnapshots; ///< only valid if IndexOffset is not 0
+      std::uint64_t IndexOffset;       ///< 0 as long as the file is being written
+      std::uint64_t ToolNamesSize;     ///< size of the padded tool name block following the header
+    };
+
+    struct ChunkHeader
+    {
+      char Magic[4];
+      std::uint32_t NumberOfSnapshots;
+      std::uint64_t FirstSnapshot;
+      double FirstTimeStamp;
+      double LastTimeStamp;
+    };
+
+    struct IndexHeader
+    {
+      char Magic[4];
+      std::uint32_t NumberOfChunks;
+    };
+
+    struct IndexEntry
+    {
+      std::uint64_t Offset; ///< file offset of the ChunkHeader
+      std::uint64_t FirstSnapshot;
+      std::uint32_t NumberOfSnapshots;
+      std::uint32_t Reserved;
+      double FirstTimeStamp;
+      double LastTimeStamp;
+    };
+
+    struct Record
+    {
+      double TimeStamp;
+      double Position[3];
+      double Orientation[4]; ///< x, y, z, r as in mitk::NavigationData::OrientationType
+      double Covariance[CovarianceSize];
+      std::uint8_t DataValid;
+      std::uint8_t HasPosition;
+      std::uint8_t HasOrientation;
+      std::uint8_t Reserved[5];
+    };
+
+    static_assert(sizeof(FileHeader) == 48, "unexpected padding in NavigationDataStreamFormat::FileHeader");
+    static_assert(sizeof(ChunkHeader) == 32, "unexpected padding in NavigationDataStreamFormat::ChunkHeader");
+    static_assert(sizeof(IndexHeader) == 8, "unexpected padding in NavigationDataStreamFormat::IndexHeader");
+    static_assert(sizeof(IndexEntry) == 40, "unexpected padding in NavigationDataStreamFormat::IndexEntry");
+    static_assert(sizeof(Record) == 240, "unexpected padding in NavigationDataStreamFormat::Record");
+  }
+}
+
+#endif
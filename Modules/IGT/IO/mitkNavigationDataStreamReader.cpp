@@ -0,0 +1,379 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkNavigationDataStreamReader.h"
+
+#include "mitkIGTException.h"
+#include "mitkIGTIOException.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+* \brief Read-only memory mapping of a whole file.
+*/
+class mitk::NavigationDataStreamReader::MappedFile
+{
+public:
+  explicit MappedFile(const std::string &fileName) : m_Data(nullptr), m_Size(0)
+  {
+#ifdef _WIN32
+    m_File = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                         FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    m_Mapping = nullptr;
+    if (m_File == INVALID_HANDLE_VALUE)
+      return;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_File, &size) || size.QuadPart == 0)
+      return;
+
+    m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_Mapping == nullptr)
+      return;
+
+    m_Data = static_cast<const char *>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_Data != nullptr)
+      m_Size = static_cast<std::size_t>(size.QuadPart);
+#else
+    m_File = open(fileName.c_str(), O_RDONLY);
+    if (m_File < 0)
+      return;
+
+    struct stat status;
+    if (fstat(m_File, &status) != 0 || status.st_size == 0)
+      return;
+
+    void *data = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, m_File, 0);
+    if (data == MAP_FAILED)
+      return;
+
+    m_Data = static_cast<const char *>(data);
+    m_Size = static_cast<std::size_t>(status.st_size);
+#endif
+  }
+
+  ~MappedFile()
+  {
+#ifdef _WIN32
+    if (m_Data != nullptr)
+      UnmapViewOfFile(m_Data);
+    if (m_Mapping != nullptr)
+      CloseHandle(m_Mapping);
+    if (m_File != INVALID_HANDLE_VALUE)
+      CloseHandle(m_File);
+#else
+    if (m_Data != nullptr)
+      munmap(const_cast<char *>(m_Data), m_Size);
+    if (m_File >= 0)
+      close(m_File);
+#endif
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const char *GetData() const { return m_Data; }
+  std::size_t GetSize() const { return m_Size; }
+
+private:
+  const char *m_Data;
+  std::size_t m_Size;
+#ifdef _WIN32
+  HANDLE m_File;
+  HANDLE m_Mapping;
+#else
+  int m_File;
+#endif
+};
+
+mitk::NavigationDataStreamReader::NavigationDataStreamReader() : m_NumberOfSnapshots(0)
+{
+  std::memset(&m_FileHeader, 0, sizeof(m_FileHeader));
+}
+
+mitk::NavigationDataStreamReader::~NavigationDataStreamReader()
+{
+}
+
+void mitk::NavigationDataStreamReader::Open(const std::string &fileName)
+{
+  this->Close();
+
+  std::unique_ptr<MappedFile> mappedFile(new MappedFile(fileName));
+  if (mappedFile->GetData() == nullptr)
+    mitkThrowException(mitk::IGTIOException) << "Cannot open navigation data stream file " << fileName << ".";
+
+  if (mappedFile->GetSize() < sizeof(m_FileHeader))
+    mitkThrowException(mitk::IGTIOException) << fileName << " is no navigation data stream file.";
+
+  std::memcpy(&m_FileHeader, mappedFile->GetData(), sizeof(m_FileHeader));
+  if (std::memcmp(m_FileHeader.Magic, NavigationDataStreamFormat::FileMagic, sizeof(m_FileHeader.Magic)) != 0)
+    mitkThrowException(mitk::IGTIOException) << fileName << " is no navigation data stream file.";
+
+  if (m_FileHeader.Version != NavigationDataStreamFormat::Version ||
+      m_FileHeader.RecordSize != sizeof(NavigationDataStreamFormat::Record) || m_FileHeader.NumberOfTools == 0 ||
+      sizeof(m_FileHeader) + m_FileHeader.ToolNamesSize > mappedFile->GetSize())
+  {
+    mitkThrowException(mitk::IGTIOException) << "Navigation data stream file " << fileName
+                                              << " has an unsupported version or is corrupt.";
+  }
+
+  // tool names are zero terminated strings following the header
+  const char *names = mappedFile->GetData() + sizeof(m_FileHeader);
+  const char *namesEnd = names + m_FileHeader.ToolNamesSize;
+  for (unsigned int i = 0; i < m_FileHeader.NumberOfTools; ++i)
+  {
+    const char *end = std::find(names, namesEnd, '\0');
+    m_ToolNames.emplace_back(names, end);
+    names = end < namesEnd ? end + 1 : namesEnd;
+  }
+
+  m_MappedFile = std::move(mappedFile);
+  this->ReadIndex();
+}
+
+void mitk::NavigationDataStreamReader::ReadIndex()
+{
+  typedef NavigationDataStreamFormat::IndexHeader IndexHeader;
+  typedef NavigationDataStreamFormat::IndexEntry IndexEntry;
+
+  const std::uint64_t size = m_MappedFile->GetSize();
+  const std::uint64_t dataOffset = sizeof(m_FileHeader) + m_FileHeader.ToolNamesSize;
+  const std::uint64_t chunkStride = sizeof(NavigationDataStreamFormat::ChunkHeader);
+  const std::uint64_t snapshotSize = std::uint64_t(m_FileHeader.NumberOfTools) * m_FileHeader.RecordSize;
+
+  if (m_FileHeader.IndexOffset >= dataOffset && m_FileHeader.IndexOffset + sizeof(IndexHeader) <= size)
+  {
+    IndexHeader indexHeader;
+    std::memcpy(&indexHeader, m_MappedFile->GetData() + m_FileHeader.IndexOffset, sizeof(indexHeader));
+
+    const std::uint64_t entriesOffset = m_FileHeader.IndexOffset + sizeof(IndexHeader);
+    if (std::memcmp(indexHeader.Magic, NavigationDataStreamFormat::IndexMagic, sizeof(indexHeader.Magic)) == 0 &&
+        entriesOffset + std::uint64_t(indexHeader.NumberOfChunks) * sizeof(IndexEntry) <= size)
+    {
+      m_Index.resize(indexHeader.NumberOfChunks);
+      if (!m_Index.empty())
+        std::memcpy(m_Index.data(), m_MappedFile->GetData() + entriesOffset, m_Index.size() * sizeof(IndexEntry));
+
+      std::uint64_t numberOfSnapshots = 0;
+      bool valid = true;
+      for (const auto &entry : m_Index)
+      {
+        valid = valid && entry.FirstSnapshot == numberOfSnapshots &&
+                entry.Offset + chunkStride + entry.NumberOfSnapshots * snapshotSize <= m_FileHeader.IndexOffset;
+        numberOfSnapshots += entry.NumberOfSnapshots;
+      }
+
+      if (valid && numberOfSnapshots == m_FileHeader.NumberOfSnapshots)
+      {
+        m_NumberOfSnapshots = static_cast<unsigned int>(numberOfSnapshots);
+        return;
+      }
+    }
+
+    MITK_WARN("NavigationDataStreamReader") << "Index of navigation data stream is corrupt, scanning the file instead.";
+  }
+
+  this->ScanChunks(dataOffset);
+}
+
+void mitk::NavigationDataStreamReader::ScanChunks(std::uint64_t offset)
+{
+  typedef NavigationDataStreamFormat::ChunkHeader ChunkHeader;
+
+  const std::uint64_t size = m_MappedFile->GetSize();
+  const std::uint64_t snapshotSize = std::uint64_t(m_FileHeader.NumberOfTools) * m_FileHeader.RecordSize;
+
+  m_Index.clear();
+  std::uint64_t numberOfSnapshots = 0;
+
+  while (offset + sizeof(ChunkHeader) <= size)
+  {
+    ChunkHeader header;
+    std::memcpy(&header, m_MappedFile->GetData() + offset, sizeof(header));
+
+    const std::uint64_t chunkSize = sizeof(ChunkHeader) + header.NumberOfSnapshots * snapshotSize;
+    if (std::memcmp(header.Magic, NavigationDataStreamFormat::ChunkMagic, sizeof(header.Magic)) != 0 ||
+        header.NumberOfSnapshots == 0 || header.FirstSnapshot != numberOfSnapshots || offset + chunkSize > size)
+    {
+      break; // end of the completely written chunks
+    }
+
+    NavigationDataStreamFormat::IndexEntry entry;
+    entry.Offset = offset;
+    entry.FirstSnapshot = header.FirstSnapshot;
+    entry.NumberOfSnapshots = header.NumberOfSnapshots;
+    entry.Reserved = 0;
+    entry.FirstTimeStamp = header.FirstTimeStamp;
+    entry.LastTimeStamp = header.LastTimeStamp;
+    m_Index.push_back(entry);
+
+    numberOfSnapshots += header.NumberOfSnapshots;
+    offset += chunkSize;
+  }
+
+  m_NumberOfSnapshots = static_cast<unsigned int>(numberOfSnapshots);
+}
+
+void mitk::NavigationDataStreamReader::Close()
+{
+  m_MappedFile.reset();
+  m_ToolNames.clear();
+  m_Index.clear();
+  m_NumberOfSnapshots = 0;
+  std::memset(&m_FileHeader, 0, sizeof(m_FileHeader));
+}
+
+bool mitk::NavigationDataStreamReader::IsOpen() const
+{
+  return m_MappedFile != nullptr;
+}
+
+unsigned int mitk::NavigationDataStreamReader::GetNumberOfTools() const
+{
+  return m_FileHeader.NumberOfTools;
+}
+
+unsigned int mitk::NavigationDataStreamReader::GetNumberOfSnapshots() const
+{
+  return m_NumberOfSnapshots;
+}
+
+std::string mitk::NavigationDataStreamReader::GetToolName(unsigned int toolIndex) const
+{
+  return toolIndex < m_ToolNames.size() ? m_ToolNames[toolIndex] : std::string();
+}
+
+const mitk::NavigationDataStreamFormat::Record *mitk::NavigationDataStreamReader::GetRecord(unsigned int snapshot,
+                                                                                          unsigned int toolIndex) const
+{
+  if (snapshot >= m_NumberOfSnapshots || toolIndex >= m_FileHeader.NumberOfTools)
+  {
+    mitkThrowException(mitk::IGTException) << "There is no NavigationData available at index " << snapshot
+                                           << " for tool " << toolIndex << ".";
+  }
+
+  // last chunk starting at or before the snapshot
+  auto chunk = std::upper_bound(m_Index.begin(),
+                                m_Index.end(),
+                                snapshot,
+                                [](std::uint64_t value, const NavigationDataStreamFormat::IndexEntry &entry) {
+                                  return value < entry.FirstSnapshot;
+                                }) - 1;
+
+  const std::uint64_t recordIndex = (snapshot - chunk->FirstSnapshot) * m_FileHeader.NumberOfTools + toolIndex;
+  const char *data = m_MappedFile->GetData() + chunk->Offset + sizeof(NavigationDataStreamFormat::ChunkHeader) +
+                     recordIndex * sizeof(NavigationDataStreamFormat::Record);
+
+  // all parts of the file are 8 byte aligned, so the records can be accessed in place
+  return reinterpret_cast<const NavigationDataStreamFormat::Record *>(data);
+}
+
+void mitk::NavigationDataStreamReader::GetNavigationData(unsigned int snapshot,
+                                                         unsigned int toolIndex,
+                                                         NavigationData *output) const
+{
+  const NavigationDataStreamFormat::Record *record = this->GetRecord(snapshot, toolIndex);
+
+  NavigationData::PositionType position;
+  for (unsigned int i = 0; i < 3; ++i)
+    position[i] = record->Position[i];
+
+  NavigationData::OrientationType orientation(
+    record->Orientation[0], record->Orientation[1], record->Orientation[2], record->Orientation[3]);
+
+  NavigationData::CovarianceMatrixType covariance;
+  unsigned int k = 0;
+  for (unsigned int row = 0; row < 6; ++row)
+  {
+    for (unsigned int column = row; column < 6; ++column)
+    {
+      covariance[row][column] = record->Covariance[k];
+      covariance[column][row] = record->Covariance[k];
+      ++k;
+    }
+  }
+
+  output->SetName(m_ToolNames[toolIndex].c_str());
+  output->SetIGTTimeStamp(record->TimeStamp);
+  output->SetPosition(position);
+  output->SetOrientation(orientation);
+  output->SetCovErrorMatrix(covariance);
+  output->SetDataValid(record->DataValid != 0);
+  output->SetHasPosition(record->HasPosition != 0);
+  output->SetHasOrientation(record->HasOrientation != 0);
+}
+
+mitk::NavigationData::Pointer mitk::NavigationDataStreamReader::GetNavigationData(unsigned int snapshot,
+                                                                                  unsigned int toolIndex) const
+{
+  NavigationData::Pointer data = NavigationData::New();
+  this->GetNavigationData(snapshot, toolIndex, data);
+  return data;
+}
+
+mitk::NavigationData::TimeStampType mitk::NavigationDataStreamReader::GetTimeStamp(unsigned int snapshot) const
+{
+  return this->GetRecord(snapshot, 0)->TimeStamp;
+}
+
+unsigned int mitk::NavigationDataStreamReader::FindSnapshot(NavigationData::TimeStampType timeStamp) const
+{
+  if (m_Index.empty() || timeStamp < m_Index.front().FirstTimeStamp)
+    return 0;
+
+  // find the chunk via the index, then bisect the records of the chunk
+  auto chunk = std::upper_bound(m_Index.begin(),
+                                m_Index.end(),
+                                timeStamp,
+                                [](NavigationData::TimeStampType value, const NavigationDataStreamFormat::IndexEntry &entry) {
+                                  return value < entry.FirstTimeStamp;
+                                }) - 1;
+
+  unsigned int first = static_cast<unsigned int>(chunk->FirstSnapshot);
+  unsigned int last = first + chunk->NumberOfSnapshots - 1;
+  while (first < last)
+  {
+    const unsigned int middle = first + (last - first + 1) / 2;
+    if (this->GetTimeStamp(middle) <= timeStamp)
+      first = middle;
+    else
+      last = middle - 1;
+  }
+  return first;
+}
+
+mitk::NavigationDataSet::Pointer mitk::NavigationDataStreamReader::ReadNavigationDataSet() const
+{
+  NavigationDataSet::Pointer navigationDataSet = NavigationDataSet::New(this->GetNumberOfTools());
+
+  for (unsigned int snapshot = 0; snapshot < m_NumberOfSnapshots; ++snapshot)
+  {
+    std::vector<NavigationData::Pointer> navigationDatas;
+    for (unsigned int toolIndex = 0; toolIndex < this->GetNumberOfTools(); ++toolIndex)
+      navigationDatas.push_back(this->GetNavigationData(snapshot, toolIndex));
+
+    navigationDataSet->AddNavigationDatas(navigationDatas);
+  }
+
+  return navigationDataSet;
+}
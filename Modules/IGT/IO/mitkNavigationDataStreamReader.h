@@ -0,0 +1,115 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkNavigationDataStreamReader_h
+#define mitkNavigationDataStreamReader_h
+
+#include <MitkIGTExports.h>
+#include <mitkCommon.h>
+#include "mitkNavigationData.h"
+#include "mitkNavigationDataSet.h"
+#include "mitkNavigationDataStreamFormat.h"
+
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mitk
+{
+  /**
+  * \brief Provides random access to navigation data stream files written by
+  * mitk::NavigationDataStreamWriter.
+  *
+  * The file is memory mapped, so opening it is independent of the length of the
+  * recording and only the accessed snapshots are read from disk. The snapshot of a
+  * given index or time stamp is found via the chunk index of the file.
+  *
+  * Use mitk::NavigationDataPlayerBase::SetNavigationDataStreamReader() to play a stream.
+  *
+  * \ingroup IGT
+  */
+  class MITKIGT_EXPORT NavigationDataStreamReader : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(NavigationDataStreamReader, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    /**
+    * \brief Maps the given file into memory and reads its index.
+    *
+    * Files that were not closed by the writer (e.g. after a crash) can be opened as
+    * well, the index is then rebuilt from the completely written chunks.
+    *
+    * @throw mitk::IGTIOException if the file cannot be opened or is no navigation data stream.
+    */
+    void Open(const std::string &fileName);
+
+    void Close();
+
+    bool IsOpen() const;
+
+    unsigned int GetNumberOfTools() const;
+
+    unsigned int GetNumberOfSnapshots() const;
+
+    std::string GetToolName(unsigned int toolIndex) const;
+
+    /**
+    * \brief Copies the recorded data of the given snapshot and tool into output.
+    * @throw mitk::IGTException if one of the indices is out of range.
+    */
+    void GetNavigationData(unsigned int snapshot, unsigned int toolIndex, NavigationData *output) const;
+
+    /**
+    * \brief Convenience method that returns a new mitk::NavigationData for the given snapshot and tool.
+    */
+    NavigationData::Pointer GetNavigationData(unsigned int snapshot, unsigned int toolIndex) const;
+
+    /**
+    * \brief Returns the time stamp of the given snapshot (of its first tool) without decoding the whole record.
+    */
+    NavigationData::TimeStampType GetTimeStamp(unsigned int snapshot) const;
+
+    /**
+    * \brief Returns the index of the last snapshot whose time stamp is not greater than the given one,
+    * or 0 if the time stamp is before the first snapshot.
+    */
+    unsigned int FindSnapshot(NavigationData::TimeStampType timeStamp) const;
+
+    /**
+    * \brief Reads the whole stream into a mitk::NavigationDataSet.
+    */
+    NavigationDataSet::Pointer ReadNavigationDataSet() const;
+
+  protected:
+    NavigationDataStreamReader();
+    ~NavigationDataStreamReader() override;
+
+  private:
+    class MappedFile;
+
+    void ReadIndex();
+    void ScanChunks(std::uint64_t offset);
+    const NavigationDataStreamFormat::Record *GetRecord(unsigned int snapshot, unsigned int toolIndex) const;
+
+    std::unique_ptr<MappedFile> m_MappedFile;
+    NavigationDataStreamFormat::FileHeader m_FileHeader;
+    std::vector<std::string> m_ToolNames;
+    std::vector<NavigationDataStreamFormat::IndexEntry> m_Index;
+    unsigned int m_NumberOfSnapshots;
+  };
+}
+
+#endif
@@ -0,0 +1,371 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkNavigationDataStreamWriter.h"
+
+#include "mitkIGTIOException.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+  void ToRecord(const mitk::NavigationData *data,
+                mitk::NavigationData::TimeStampType timeStamp,
+                mitk::NavigationDataStreamFormat::Record &record)
+  {
+    record.TimeStamp = timeStamp;
+
+    const mitk::NavigationData::PositionType position = data->GetPosition();
+    for (unsigned int i = 0; i < 3; ++i)
+      record.Position[i] = position[i];
+
+    const mitk::NavigationData::OrientationType orientation = data->GetOrientation();
+    for (unsigned int i = 0; i < 4; ++i)
+      record.Orientation[i] = orientation[i];
+
+    const mitk::NavigationData::CovarianceMatrixType covariance = data->GetCovErrorMatrix();
+    unsigned int k = 0;
+    for (unsigned int row = 0; row < 6; ++row)
+      for (unsigned int column = row; column < 6; ++column)
+        record.Covariance[k++] = covariance[row][column];
+
+    record.DataValid = data->IsDataValid() ? 1 : 0;
+    record.HasPosition = data->GetHasPosition() ? 1 : 0;
+    record.HasOrientation = data->GetHasOrientation() ? 1 : 0;
+    std::memset(record.Reserved, 0, sizeof(record.Reserved));
+  }
+}
+
+mitk::NavigationDataStreamWriter::NavigationDataStreamWriter()
+  : m_SnapshotsPerChunk(NavigationDataStreamFormat::DefaultSnapshotsPerChunk),
+    m_NumberOfTools(0),
+    m_NumberOfSnapshots(0),
+    m_SnapshotsInCurrentChunk(0),
+    m_File(nullptr),
+    m_FileSize(0),
+    m_Writing(false),
+    m_StopWriting(false),
+    m_WriteFailed(false)
+{
+  std::memset(&m_FileHeader, 0, sizeof(m_FileHeader));
+}
+
+mitk::NavigationDataStreamWriter::~NavigationDataStreamWriter()
+{
+  if (this->IsOpen())
+  {
+    try
+    {
+      this->Close();
+    }
+    catch (const std::exception &e)
+    {
+      MITK_ERROR << "Could not finish navigation data stream: " << e.what();
+    }
+  }
+}
+
+void mitk::NavigationDataStreamWriter::Open(const std::string &fileName, const std::vector<std::string> &toolNames)
+{
+  if (this->IsOpen())
+    this->Close();
+
+  if (toolNames.empty())
+    mitkThrowException(mitk::IGTIOException) << "Cannot record a navigation data stream without tools.";
+
+  m_File = std::fopen(fileName.c_str(), "wb");
+  if (m_File == nullptr)
+    mitkThrowException(mitk::IGTIOException) << "Cannot open navigation data stream file " << fileName << " for writing.";
+
+  m_NumberOfTools = static_cast<unsigned int>(toolNames.size());
+  m_NumberOfSnapshots = 0;
+  m_LastTimeStamps.assign(m_NumberOfTools, 0.0);
+  m_SnapshotsPerChunk = std::max(m_SnapshotsPerChunk, 1u);
+  m_FileSize = 0;
+  m_Index.clear();
+  m_WriteFailed = false;
+  m_StopWriting = false;
+  m_Writing = false;
+
+  std::vector<char> toolNameBlock;
+  for (const auto &name : toolNames)
+    toolNameBlock.insert(toolNameBlock.end(), name.c_str(), name.c_str() + name.size() + 1);
+  toolNameBlock.resize((toolNameBlock.size() + 7) / 8 * 8, '\0');
+
+  std::memset(&m_FileHeader, 0, sizeof(m_FileHeader));
+  std::memcpy(m_FileHeader.Magic, NavigationDataStreamFormat::FileMagic, sizeof(m_FileHeader.Magic));
+  m_FileHeader.Version = NavigationDataStreamFormat::Version;
+  m_FileHeader.NumberOfTools = m_NumberOfTools;
+  m_FileHeader.RecordSize = sizeof(NavigationDataStreamFormat::Record);
+  m_FileHeader.SnapshotsPerChunk = m_SnapshotsPerChunk;
+  m_FileHeader.ToolNamesSize = toolNameBlock.size();
+
+  if (!this->Write(&m_FileHeader, sizeof(m_FileHeader)) || !this->Write(toolNameBlock.data(), toolNameBlock.size()) ||
+      std::fflush(m_File) != 0)
+  {
+    std::fclose(m_File);
+    m_File = nullptr;
+    mitkThrowException(mitk::IGTIOException) << "Cannot write header of navigation data stream file " << fileName << ".";
+  }
+
+  m_CurrentChunk.clear();
+  m_SnapshotsInCurrentChunk = 0;
+  m_WriterThread = std::thread(&NavigationDataStreamWriter::WriteChunks, this);
+}
+
+bool mitk::NavigationDataStreamWriter::IsOpen() const
+{
+  return m_File != nullptr;
+}
+
+bool mitk::NavigationDataStreamWriter::AddSnapshot(const std::vector<const NavigationData *> &snapshot)
+{
+  if (!this->CheckSnapshot(snapshot))
+    return false;
+
+  for (unsigned int i = 0; i < m_NumberOfTools; ++i)
+  {
+    if (m_NumberOfSnapshots > 0 && snapshot[i]->GetIGTTimeStamp() <= m_LastTimeStamps[i])
+    {
+      MITK_WARN("NavigationDataStreamWriter") << "IGTTimeStamp of new NavigationData should be newer than timestamp of last NavigationData.";
+      return false;
+    }
+  }
+
+  this->AppendRecords(snapshot, nullptr);
+  return true;
+}
+
+bool mitk::NavigationDataStreamWriter::AddSnapshot(const std::vector<const NavigationData *> &snapshot,
+                                                   NavigationData::TimeStampType timeStamp)
+{
+  if (!this->CheckSnapshot(snapshot))
+    return false;
+
+  if (m_NumberOfSnapshots > 0 && timeStamp <= m_LastTimeStamps[0])
+  {
+    MITK_WARN("NavigationDataStreamWriter") << "IGTTimeStamp of new NavigationData should be newer than timestamp of last NavigationData.";
+    return false;
+  }
+
+  this->AppendRecords(snapshot, &timeStamp);
+  return true;
+}
+
+bool mitk::NavigationDataStreamWriter::CheckSnapshot(const std::vector<const NavigationData *> &snapshot)
+{
+  if (!this->IsOpen())
+  {
+    MITK_WARN("NavigationDataStreamWriter") << "Navigation data stream is not open.";
+    return false;
+  }
+
+  if (snapshot.size() != m_NumberOfTools)
+  {
+    MITK_WARN("NavigationDataStreamWriter") << "Tried to add too many or too few navigation Datas to stream. " << m_NumberOfTools
+                                            << " required, tried to add " << snapshot.size() << ".";
+    return false;
+  }
+
+  for (const auto *data : snapshot)
+  {
+    if (data == nullptr)
+    {
+      MITK_WARN("NavigationDataStreamWriter") << "Tried to add a null NavigationData to stream.";
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void mitk::NavigationDataStreamWriter::AppendRecords(const std::vector<const NavigationData *> &snapshot,
+                                                     const NavigationData::TimeStampType *timeStamp)
+{
+  typedef NavigationDataStreamFormat::ChunkHeader ChunkHeader;
+  typedef NavigationDataStreamFormat::Record Record;
+
+  if (m_SnapshotsInCurrentChunk == 0)
+  {
+    // start a new chunk, the header is completed when the chunk is submitted
+    m_CurrentChunk.resize(sizeof(ChunkHeader));
+    m_CurrentChunk.reserve(sizeof(ChunkHeader) + std::size_t(m_SnapshotsPerChunk) * m_NumberOfTools * sizeof(Record));
+
+    ChunkHeader header;
+    std::memcpy(header.Magic, NavigationDataStreamFormat::ChunkMagic, sizeof(header.Magic));
+    header.NumberOfSnapshots = 0;
+    header.FirstSnapshot = m_NumberOfSnapshots;
+    header.FirstTimeStamp = timeStamp != nullptr ? *timeStamp : snapshot[0]->GetIGTTimeStamp();
+    header.LastTimeStamp = header.FirstTimeStamp;
+    std::memcpy(m_CurrentChunk.data(), &header, sizeof(header));
+  }
+
+  const std::size_t offset = m_CurrentChunk.size();
+  m_CurrentChunk.resize(offset + m_NumberOfTools * sizeof(Record));
+  for (unsigned int i = 0; i < m_NumberOfTools; ++i)
+  {
+    m_LastTimeStamps[i] = timeStamp != nullptr ? *timeStamp : snapshot[i]->GetIGTTimeStamp();
+
+    Record record;
+    ToRecord(snapshot[i], m_LastTimeStamps[i], record);
+    std::memcpy(m_CurrentChunk.data() + offset + i * sizeof(Record), &record, sizeof(Record));
+  }
+
+  ++m_NumberOfSnapshots;
+  if (++m_SnapshotsInCurrentChunk == m_SnapshotsPerChunk)
+    this->SubmitChunk();
+}
+
+void mitk::NavigationDataStreamWriter::SubmitChunk()
+{
+  if (m_SnapshotsInCurrentChunk == 0)
+    return;
+
+  NavigationDataStreamFormat::ChunkHeader header;
+  std::memcpy(&header, m_CurrentChunk.data(), sizeof(header));
+  header.NumberOfSnapshots = m_SnapshotsInCurrentChunk;
+  header.LastTimeStamp = m_LastTimeStamps[0];
+  std::memcpy(m_CurrentChunk.data(), &header, sizeof(header));
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_PendingChunks.push_back(std::move(m_CurrentChunk));
+
+    // reuse the memory of an already written chunk
+    if (!m_FreeChunks.empty())
+    {
+      m_CurrentChunk = std::move(m_FreeChunks.back());
+      m_FreeChunks.pop_back();
+    }
+    else
+    {
+      m_CurrentChunk = ChunkBuffer();
+    }
+  }
+  m_ChunkSubmitted.notify_one();
+
+  m_CurrentChunk.clear();
+  m_SnapshotsInCurrentChunk = 0;
+}
+
+void mitk::NavigationDataStreamWriter::WriteChunks()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  for (;;)
+  {
+    m_ChunkSubmitted.wait(lock, [this] { return m_StopWriting || !m_PendingChunks.empty(); });
+
+    if (m_PendingChunks.empty())
+      break; // stopped and nothing left to write
+
+    ChunkBuffer chunk = std::move(m_PendingChunks.front());
+    m_PendingChunks.pop_front();
+    m_Writing = true;
+    lock.unlock();
+
+    NavigationDataStreamFormat::ChunkHeader header;
+    std::memcpy(&header, chunk.data(), sizeof(header));
+
+    NavigationDataStreamFormat::IndexEntry entry;
+    entry.Offset = m_FileSize;
+    entry.FirstSnapshot = header.FirstSnapshot;
+    entry.NumberOfSnapshots = header.NumberOfSnapshots;
+    entry.Reserved = 0;
+    entry.FirstTimeStamp = header.FirstTimeStamp;
+    entry.LastTimeStamp = header.LastTimeStamp;
+
+    const bool written = this->Write(chunk.data(), chunk.size()) && std::fflush(m_File) == 0;
+    if (written)
+      m_Index.push_back(entry);
+
+    lock.lock();
+    if (!written)
+      m_WriteFailed = true;
+    m_Writing = false;
+    m_FreeChunks.push_back(std::move(chunk));
+    m_ChunkWritten.notify_all();
+  }
+}
+
+void mitk::NavigationDataStreamWriter::Flush()
+{
+  if (!this->IsOpen())
+    return;
+
+  this->SubmitChunk();
+
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_ChunkWritten.wait(lock, [this] { return m_PendingChunks.empty() && !m_Writing; });
+
+  if (m_WriteFailed)
+    mitkThrowException(mitk::IGTIOException) << "Writing the navigation data stream failed.";
+}
+
+void mitk::NavigationDataStreamWriter::StopWriterThread()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_StopWriting = true;
+  }
+  m_ChunkSubmitted.notify_one();
+
+  if (m_WriterThread.joinable())
+    m_WriterThread.join();
+}
+
+void mitk::NavigationDataStreamWriter::Close()
+{
+  if (!this->IsOpen())
+    return;
+
+  this->SubmitChunk();
+  this->StopWriterThread();
+
+  bool succeeded = !m_WriteFailed;
+  if (succeeded)
+  {
+    NavigationDataStreamFormat::IndexHeader indexHeader;
+    std::memcpy(indexHeader.Magic, NavigationDataStreamFormat::IndexMagic, sizeof(indexHeader.Magic));
+    indexHeader.NumberOfChunks = static_cast<std::uint32_t>(m_Index.size());
+
+    m_FileHeader.NumberOfSnapshots = m_NumberOfSnapshots;
+    m_FileHeader.IndexOffset = m_FileSize;
+
+    succeeded = this->Write(&indexHeader, sizeof(indexHeader)) &&
+                (m_Index.empty() || this->Write(m_Index.data(), m_Index.size() * sizeof(m_Index[0]))) &&
+                std::fseek(m_File, 0, SEEK_SET) == 0 &&
+                std::fwrite(&m_FileHeader, sizeof(m_FileHeader), 1, m_File) == 1;
+  }
+
+  succeeded = (std::fclose(m_File) == 0) && succeeded;
+  m_File = nullptr;
+  m_PendingChunks.clear();
+  m_FreeChunks.clear();
+
+  if (!succeeded)
+    mitkThrowException(mitk::IGTIOException) << "Writing the navigation data stream failed.";
+}
+
+unsigned int mitk::NavigationDataStreamWriter::GetNumberOfSnapshots() const
+{
+  return m_NumberOfSnapshots;
+}
+
+bool mitk::NavigationDataStreamWriter::Write(const void *data, std::size_t size)
+{
+  if (std::fwrite(data, 1, size, m_File) != size)
+    return false;
+
+  m_FileSize += size;
+  return true;
+}
@@ -0,0 +1,144 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkNavigationDataStreamWriter_h
+#define mitkNavigationDataStreamWriter_h
+
+#include <MitkIGTExports.h>
+#include <mitkCommon.h>
+#include "mitkNavigationData.h"
+#include "mitkNavigationDataStreamFormat.h"
+
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mitk
+{
+  /**
+  * \brief Writes navigation data snapshots into a binary, chunked, append-only stream
+  * file (see mitk::NavigationDataStreamFormat).
+  *
+  * AddSnapshot() only converts the data into the current chunk. Full chunks are
+  * handed over to a background thread that appends them to the file, so the caller
+  * (usually the tracking pipeline) never waits for the disk. Close() writes the
+  * chunk index that is used by mitk::NavigationDataStreamReader for seeking.
+  *
+  * Open(), AddSnapshot(), Flush() and Close() must be called from the same thread.
+  *
+  * \ingroup IGT
+  */
+  class MITKIGT_EXPORT NavigationDataStreamWriter : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(NavigationDataStreamWriter, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    /**
+    * \brief Number of snapshots that are collected before they are written to disk. Takes effect with the next Open().
+    */
+    itkSetMacro(SnapshotsPerChunk, unsigned int);
+    itkGetConstMacro(SnapshotsPerChunk, unsigned int);
+
+    /**
+    * \brief Creates (or truncates) the file and writes its header.
+    *
+    * @param fileName the file to write.
+    * @param toolNames one name per tool, this also defines the number of tools.
+    * @throw mitk::IGTIOException if the file cannot be created.
+    */
+    void Open(const std::string &fileName, const std::vector<std::string> &toolNames);
+
+    bool IsOpen() const;
+
+    /**
+    * \brief Appends one snapshot, i.e. one mitk::NavigationData per tool.
+    *
+    * Like mitk::NavigationDataSet::AddNavigationDatas() the snapshot is rejected if it
+    * does not contain one navigation data per tool or if its time stamps are not newer
+    * than the ones of the previous snapshot.
+    *
+    * @return true if the snapshot was added.
+    */
+    bool AddSnapshot(const std::vector<const NavigationData *> &snapshot);
+
+    /**
+    * \brief Same as AddSnapshot(), but stores the given time stamp for all tools instead of their own time stamps.
+    */
+    bool AddSnapshot(const std::vector<const NavigationData *> &snapshot, NavigationData::TimeStampType timeStamp);
+
+    /**
+    * \brief Writes all snapshots added so far to disk and waits until this is done.
+    *
+    * The file can be read afterwards even though it is not closed yet.
+    * @throw mitk::IGTIOException if writing failed.
+    */
+    void Flush();
+
+    /**
+    * \brief Writes the remaining snapshots and the index and closes the file.
+    * @throw mitk::IGTIOException if writing failed.
+    */
+    void Close();
+
+    /**
+    * \brief Returns the number of snapshots added since Open().
+    */
+    unsigned int GetNumberOfSnapshots() const;
+
+  protected:
+    NavigationDataStreamWriter();
+    ~NavigationDataStreamWriter() override;
+
+  private:
+    typedef std::vector<char> ChunkBuffer;
+
+    bool CheckSnapshot(const std::vector<const NavigationData *> &snapshot);
+    void AppendRecords(const std::vector<const NavigationData *> &snapshot, const NavigationData::TimeStampType *timeStamp);
+    void SubmitChunk();
+    void WriteChunks();
+    void StopWriterThread();
+    bool Write(const void *data, std::size_t size);
+
+    unsigned int m_SnapshotsPerChunk;
+    unsigned int m_NumberOfTools;
+    unsigned int m_NumberOfSnapshots;
+    std::vector<NavigationData::TimeStampType> m_LastTimeStamps;
+
+    ChunkBuffer m_CurrentChunk;
+    unsigned int m_SnapshotsInCurrentChunk;
+
+    std::FILE *m_File;
+    std::uint64_t m_FileSize;
+    NavigationDataStreamFormat::FileHeader m_FileHeader;
+    std::vector<NavigationDataStreamFormat::IndexEntry> m_Index; ///< only accessed by the writer thread while it runs
+
+    std::thread m_WriterThread;
+    std::mutex m_Mutex;
+    std::condition_variable m_ChunkSubmitted;
+    std::condition_variable m_ChunkWritten;
+    std::deque<ChunkBuffer> m_PendingChunks;
+    std::vector<ChunkBuffer> m_FreeChunks;
+    bool m_Writing;
+    bool m_StopWriting;
+    bool m_WriteFailed;
+  };
+}
+
+#endif
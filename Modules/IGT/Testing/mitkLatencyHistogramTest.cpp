@@ -0,0 +1,62 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkLatencyHistogram.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+class mitkLatencyHistogramTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLatencyHistogramTestSuite);
+  MITK_TEST(TestEmptyHistogram);
+  MITK_TEST(TestStatistics);
+  MITK_TEST(TestOverflowBin);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void TestEmptyHistogram()
+  {
+    mitk::LatencyHistogram histogram;
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("No samples", std::uint64_t(0), histogram.GetNumberOfSamples());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Mean of empty histogram", 0.0, histogram.GetMean());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Percentile of empty histogram", 0.0, histogram.GetPercentile(50.0));
+  }
+
+  void TestStatistics()
+  {
+    mitk::LatencyHistogram histogram(1.0, 100);
+    for (int i = 1; i <= 100; ++i)
+      histogram.AddSample(i - 0.5);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Number of samples", std::uint64_t(100), histogram.GetNumberOfSamples());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Mean", 50.0, histogram.GetMean(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Maximum", 99.5, histogram.GetMaximum(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Median", 50.0, histogram.GetPercentile(50.0), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("95th percentile", 95.0, histogram.GetPercentile(95.0), 1e-9);
+
+    histogram.Reset();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Reset removes all samples", std::uint64_t(0), histogram.GetNumberOfSamples());
+  }
+
+  void TestOverflowBin()
+  {
+    mitk::LatencyHistogram histogram(1.0, 10);
+    histogram.AddSample(1000.0);
+    histogram.AddSample(-1.0);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Large latency is counted in the last bin", std::uint64_t(1), histogram.GetBinCounts().back());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Negative latency is counted in the first bin", std::uint64_t(1), histogram.GetBinCounts().front());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Maximum is exact", 1000.0, histogram.GetMaximum(), 1e-9);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLatencyHistogram)
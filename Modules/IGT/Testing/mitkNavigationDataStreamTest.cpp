@@ -0,0 +1,240 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkNavigationDataRecorder.h>
+#include <mitkNavigationDataSequentialPlayer.h>
+#include <mitkNavigationDataStreamReader.h>
+#include <mitkNavigationDataStreamWriter.h>
+#include <mitkIOUtil.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include "mitkIGTException.h"
+#include "mitkIGTIOException.h"
+
+#include <cstdio>
+
+class mitkNavigationDataStreamTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkNavigationDataStreamTestSuite);
+  MITK_TEST(TestWriteAndRead);
+  MITK_TEST(TestReadUnfinishedStream);
+  MITK_TEST(TestFindSnapshot);
+  MITK_TEST(TestSequentialPlayerWithStream);
+  MITK_TEST(TestRecorderStreaming);
+  MITK_TEST(TestInvalidFileException);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::string m_FileName;
+  std::vector<std::string> m_ToolNames;
+
+  static constexpr unsigned int NumberOfSnapshots = 100;
+
+  mitk::NavigationData::Pointer CreateNavigationData(unsigned int snapshot, unsigned int tool)
+  {
+    mitk::NavigationData::Pointer data = mitk::NavigationData::New();
+    mitk::NavigationData::PositionType position;
+    position[0] = snapshot;
+    position[1] = tool;
+    position[2] = snapshot * 0.5 + tool;
+    mitk::NavigationData::OrientationType orientation(0.1 * tool, 0.2, 0.3, 0.4 + snapshot);
+    data->SetPosition(position);
+    data->SetOrientation(orientation);
+    data->SetPositionAccuracy(0.25 * (tool + 1));
+    data->SetIGTTimeStamp(10.0 + snapshot * 2.0);
+    data->SetDataValid(snapshot % 3 != 0);
+    return data;
+  }
+
+  void WriteStream(mitk::NavigationDataStreamWriter *writer, unsigned int numberOfSnapshots)
+  {
+    for (unsigned int snapshot = 0; snapshot < numberOfSnapshots; ++snapshot)
+    {
+      std::vector<mitk::NavigationData::Pointer> datas;
+      std::vector<const mitk::NavigationData *> snapshotDatas;
+      for (unsigned int tool = 0; tool < m_ToolNames.size(); ++tool)
+      {
+        datas.push_back(this->CreateNavigationData(snapshot, tool));
+        snapshotDatas.push_back(datas.back());
+      }
+      CPPUNIT_ASSERT_MESSAGE("Snapshot is added", writer->AddSnapshot(snapshotDatas));
+    }
+  }
+
+  void CheckNavigationData(const mitk::NavigationData *data, unsigned int snapshot, unsigned int tool)
+  {
+    mitk::NavigationData::Pointer reference = this->CreateNavigationData(snapshot, tool);
+    CPPUNIT_ASSERT_MESSAGE("Position is equal",
+                           mitk::Equal(reference->GetPosition(), data->GetPosition(), mitk::eps, true));
+    CPPUNIT_ASSERT_MESSAGE("Orientation is equal",
+                           reference->GetOrientation().as_vector() == data->GetOrientation().as_vector());
+    CPPUNIT_ASSERT_MESSAGE("Covariance is equal", reference->GetCovErrorMatrix() == data->GetCovErrorMatrix());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Time stamp is equal", reference->GetIGTTimeStamp(), data->GetIGTTimeStamp());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Valid flag is equal", reference->IsDataValid(), data->IsDataValid());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Tool name is equal", m_ToolNames[tool], std::string(data->GetName()));
+  }
+
+public:
+  void setUp() override
+  {
+    m_FileName = mitk::IOUtil::CreateTemporaryFile("NavigationDataStreamTest_XXXXXX.nds");
+    m_ToolNames = {"Pointer", "Reference"};
+  }
+
+  void tearDown() override { std::remove(m_FileName.c_str()); }
+
+  void TestWriteAndRead()
+  {
+    auto writer = mitk::NavigationDataStreamWriter::New();
+    writer->SetSnapshotsPerChunk(16); // several chunks and an incomplete last one
+    writer->Open(m_FileName, m_ToolNames);
+    this->WriteStream(writer, NumberOfSnapshots);
+    writer->Close();
+
+    auto reader = mitk::NavigationDataStreamReader::New();
+    reader->Open(m_FileName);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Number of tools", 2u, reader->GetNumberOfTools());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Number of snapshots", NumberOfSnapshots, reader->GetNumberOfSnapshots());
+
+    // random access in reverse order
+    auto data = mitk::NavigationData::New();
+    for (unsigned int snapshot = NumberOfSnapshots; snapshot-- > 0;)
+    {
+      for (unsigned int tool = 0; tool < 2; ++tool)
+      {
+        reader->GetNavigationData(snapshot, tool, data);
+        this->CheckNavigationData(data, snapshot, tool);
+      }
+    }
+
+    auto navigationDataSet = reader->ReadNavigationDataSet();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("NavigationDataSet contains all snapshots", NumberOfSnapshots, navigationDataSet->Size());
+  }
+
+  void TestReadUnfinishedStream()
+  {
+    auto writer = mitk::NavigationDataStreamWriter::New();
+    writer->SetSnapshotsPerChunk(16);
+    writer->Open(m_FileName, m_ToolNames);
+    this->WriteStream(writer, 40);
+    writer->Flush();
+
+    // the file has no index yet, the reader has to scan the chunks
+    auto reader = mitk::NavigationDataStreamReader::New();
+    reader->Open(m_FileName);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Flushed snapshots are readable", 40u, reader->GetNumberOfSnapshots());
+    this->CheckNavigationData(reader->GetNavigationData(39, 1), 39, 1);
+    reader->Close();
+
+    writer->Close();
+  }
+
+  void TestFindSnapshot()
+  {
+    auto writer = mitk::NavigationDataStreamWriter::New();
+    writer->SetSnapshotsPerChunk(7);
+    writer->Open(m_FileName, m_ToolNames);
+    this->WriteStream(writer, NumberOfSnapshots);
+    writer->Close();
+
+    auto reader = mitk::NavigationDataStreamReader::New();
+    reader->Open(m_FileName);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Before first snapshot", 0u, reader->FindSnapshot(0.0));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Exact time stamp", 20u, reader->FindSnapshot(50.0));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Between two snapshots", 20u, reader->FindSnapshot(51.0));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("After last snapshot", NumberOfSnapshots - 1, reader->FindSnapshot(1e6));
+  }
+
+  void TestSequentialPlayerWithStream()
+  {
+    auto writer = mitk::NavigationDataStreamWriter::New();
+    writer->Open(m_FileName, m_ToolNames);
+    this->WriteStream(writer, NumberOfSnapshots);
+    writer->Close();
+
+    auto reader = mitk::NavigationDataStreamReader::New();
+    reader->Open(m_FileName);
+
+    auto player = mitk::NavigationDataSequentialPlayer::New();
+    player->SetNavigationDataStreamReader(reader);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Player has all snapshots", NumberOfSnapshots, player->GetNumberOfSnapshots());
+
+    for (unsigned int snapshot = 0; snapshot < NumberOfSnapshots; ++snapshot)
+    {
+      player->Update();
+      this->CheckNavigationData(player->GetOutput(0), snapshot, 0);
+      this->CheckNavigationData(player->GetOutput(1), snapshot, 1);
+      player->GoToNextSnapshot();
+    }
+    CPPUNIT_ASSERT_MESSAGE("Player is at end", player->IsAtEnd());
+
+    player->GoToSnapshot(42);
+    this->CheckNavigationData(player->GetOutput(1), 42, 1);
+  }
+
+  void TestRecorderStreaming()
+  {
+    auto navigationDataSet = mitk::NavigationDataSet::New(2);
+    for (unsigned int snapshot = 0; snapshot < NumberOfSnapshots; ++snapshot)
+    {
+      std::vector<mitk::NavigationData::Pointer> datas;
+      for (unsigned int tool = 0; tool < 2; ++tool)
+      {
+        datas.push_back(this->CreateNavigationData(snapshot, tool));
+        datas.back()->SetName(m_ToolNames[tool].c_str());
+      }
+      navigationDataSet->AddNavigationDatas(datas);
+    }
+
+    auto player = mitk::NavigationDataSequentialPlayer::New();
+    player->SetNavigationDataSet(navigationDataSet);
+
+    auto recorder = mitk::NavigationDataRecorder::New();
+    recorder->ConnectTo(player);
+
+    recorder->SetStreamFileName(m_FileName);
+    recorder->StartRecording();
+    while (!player->IsAtEnd())
+    {
+      recorder->Update();
+      player->GoToNextSnapshot();
+    }
+    recorder->StopRecording();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("All snapshots are recorded", int(NumberOfSnapshots), recorder->GetNumberOfRecordedSteps());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Nothing is kept in memory", 0u, recorder->GetNavigationDataSet()->Size());
+
+    recorder->ResetRecording(); // finishes the file
+
+    auto reader = mitk::NavigationDataStreamReader::New();
+    reader->Open(m_FileName);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Number of snapshots", NumberOfSnapshots, reader->GetNumberOfSnapshots());
+    for (unsigned int snapshot = 0; snapshot < NumberOfSnapshots; ++snapshot)
+      this->CheckNavigationData(reader->GetNavigationData(snapshot, 1), snapshot, 1);
+  }
+
+  void TestInvalidFileException()
+  {
+    std::FILE *file = std::fopen(m_FileName.c_str(), "wb");
+    std::fputs("this is no navigation data stream", file);
+    std::fclose(file);
+
+    auto reader = mitk::NavigationDataStreamReader::New();
+    CPPUNIT_ASSERT_THROW(reader->Open(m_FileName), mitk::IGTIOException);
+
+    auto player = mitk::NavigationDataSequentialPlayer::New();
+    CPPUNIT_ASSERT_THROW(player->SetNavigationDataStreamReader(reader), mitk::IGTException);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkNavigationDataStream)
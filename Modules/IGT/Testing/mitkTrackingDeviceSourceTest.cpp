@@ -105,6 +105,13 @@ int mitkTrackingDeviceSourceTest(int /* argc */, char* /*argv*/[])
     MITK_TEST_CONDITION(mitk::Equal(newPos, pos) == false, "Testing if output changes on each update");
   }
 
+  //test push based updates: the virtual tracking device reports every new sample
+  mySource->ResetLatencyHistogram();
+  MITK_TEST_CONDITION(mySource->GetLatencyHistogram().GetNumberOfSamples() == 0, "Testing ResetLatencyHistogram()");
+  MITK_TEST_CONDITION(mySource->WaitForNewData(1000) == true, "Testing WaitForNewData()");
+  mySource->Update();
+  MITK_TEST_CONDITION(mySource->GetLatencyHistogram().GetNumberOfSamples() == 1, "Testing if one latency is recorded per data update of the device");
+
   mySource->StopTracking();
   mySource->Disconnect();
 
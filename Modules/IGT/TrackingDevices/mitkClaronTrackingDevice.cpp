@@ -280,6 +280,7 @@ void mitk::ClaronTrackingDevice::TrackTools()
           currentTool->SetDataValid(false);
         }
       }
+      this->NotifyNewData();
       /* Update the local copy of m_StopTracking */
       this->m_StopTrackingMutex.lock();
       localStopTracking = m_StopTracking;
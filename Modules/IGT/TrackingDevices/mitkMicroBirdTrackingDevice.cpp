@@ -393,6 +393,9 @@ void mitk::MicroBirdTrackingDevice::TrackTools()
     /// @todo : is there any synchronisation?
     // Average timestamp: timeStamp/nOfAttachedSensors
 
+    if (nOfAttachedSensors > 0)
+      this->NotifyNewData();
+
     // Compute sleep time
     double sleepTime = updateRate - measurementDuration;
     // Sleep
@@ -733,6 +733,7 @@ void mitk::NDITrackingDevice::TrackTools()
       if (returnvalue != NDIOKAY)
         break;
     }
+    this->NotifyNewData();
     /* Update the local copy of m_StopTracking */
     this->m_StopTrackingMutex.lock();
     localStopTracking = m_StopTracking;
@@ -819,6 +820,10 @@ void mitk::NDITrackingDevice::TrackToolsAndMarkers()
     {
       std::cout << "Error in TX: could not read data. Possibly no markers present." << std::endl;
     }
+    else
+    {
+      this->NotifyNewData();
+    }
     /* Update the local copy of m_StopTracking */
     this->m_StopTrackingMutex.lock();
     localStopTracking = m_StopTracking;
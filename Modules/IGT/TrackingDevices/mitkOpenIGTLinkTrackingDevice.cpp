@@ -22,11 +22,9 @@ found in the LICENSE file.
 #include <mitkOpenIGTLinkTypeInformation.h>
 #include <vtkConeSource.h>
 
-//sleep headers
 #include <chrono>
-#include <thread>
 
-mitk::OpenIGTLinkTrackingDevice::OpenIGTLinkTrackingDevice() : mitk::TrackingDevice(), m_UpdateRate(60)
+mitk::OpenIGTLinkTrackingDevice::OpenIGTLinkTrackingDevice() : mitk::TrackingDevice(), m_UpdateRate(60), m_NumberOfReceivedMessages(0)
 {
   //set the type of this tracking device
   this->m_Data = mitk::OpenIGTLinkTypeInformation::GetDeviceDataOpenIGTLinkTrackingDeviceConnection();
@@ -37,10 +35,42 @@ mitk::OpenIGTLinkTrackingDevice::OpenIGTLinkTrackingDevice() : mitk::TrackingDev
 
   m_IGTLDeviceSource = mitk::IGTLTrackingDataDeviceSource::New();
   m_IGTLDeviceSource->SetIGTLDevice(m_OpenIGTLinkClient);
+
+  //wake up threads waiting for messages as soon as a message arrives instead of polling
+  typedef itk::SimpleMemberCommand< mitk::OpenIGTLinkTrackingDevice > CurCommandType;
+  CurCommandType::Pointer messageArrivalCommand = CurCommandType::New();
+  messageArrivalCommand->SetCallbackFunction(this, &mitk::OpenIGTLinkTrackingDevice::OnMessageReceived);
+  m_MessageArrivalObserverTag = m_OpenIGTLinkClient->AddReceiveObserver(mitk::MessageReceivedEvent(), messageArrivalCommand);
 }
 
 mitk::OpenIGTLinkTrackingDevice::~OpenIGTLinkTrackingDevice()
 {
+  m_OpenIGTLinkClient->RemoveReceiveObserver(m_MessageArrivalObserverTag);
+
+  //the receive thread may be executing the command right now, it is stopped before this object is gone
+  m_OpenIGTLinkClient->StopCommunication();
+}
+
+void mitk::OpenIGTLinkTrackingDevice::OnMessageReceived()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_MessageArrivalMutex);
+    ++m_NumberOfReceivedMessages;
+  }
+  m_MessageArrival.notify_all();
+}
+
+bool mitk::OpenIGTLinkTrackingDevice::WaitForMessage(std::uint64_t lastMessage, int waitingTime)
+{
+  std::unique_lock<std::mutex> lock(m_MessageArrivalMutex);
+  return m_MessageArrival.wait_for(lock, std::chrono::milliseconds(waitingTime),
+    [this, lastMessage] { return m_NumberOfReceivedMessages != lastMessage; });
+}
+
+std::uint64_t mitk::OpenIGTLinkTrackingDevice::GetNumberOfReceivedMessages()
+{
+  std::lock_guard<std::mutex> lock(m_MessageArrivalMutex);
+  return m_NumberOfReceivedMessages;
 }
 
 int mitk::OpenIGTLinkTrackingDevice::GetPortNumber()
@@ -129,9 +159,12 @@ mitk::NavigationToolStorage::Pointer mitk::OpenIGTLinkTrackingDevice::DiscoverTo
   mitk::NavigationToolStorage::Pointer returnValue = mitk::NavigationToolStorage::New();
   std::map<std::string, int> toolNameMap;
 
+  std::uint64_t lastMessage = this->GetNumberOfReceivedMessages();
   for (int j = 0; j<NumberOfMessagesToWait; j++)
   {
-    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    //wait for the next message, at most as long as the former polling interval
+    this->WaitForMessage(lastMessage, 20);
+    lastMessage = this->GetNumberOfReceivedMessages();
     m_IGTLDeviceSource->Update();
     switch (type)
     {
@@ -287,13 +320,15 @@ mitk::IGTLMessage::Pointer mitk::OpenIGTLinkTrackingDevice::ReceiveMessage(int w
 
   while (!(receivedMessage.IsNotNull() && receivedMessage->IsDataValid()))
   {
+    std::uint64_t lastMessage = this->GetNumberOfReceivedMessages();
     m_IGTLDeviceSource->Update();
     receivedMessage = m_IGTLDeviceSource->GetOutput();
 
     if ((time + d) < std::chrono::high_resolution_clock::now())
       break;
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    //wake up as soon as the next message arrives, but check the timeout at least every 100 ms
+    this->WaitForMessage(lastMessage, 100);
   }
   return receivedMessage;
 }
@@ -349,6 +384,9 @@ void mitk::OpenIGTLinkTrackingDevice::UpdateTools()
       }
     }
   }
+
+  //push the new data to waiting consumers
+  this->NotifyNewData();
 }
 
 bool mitk::OpenIGTLinkTrackingDevice::StartTracking()
@@ -384,7 +422,7 @@ bool mitk::OpenIGTLinkTrackingDevice::StartTracking()
   typedef itk::SimpleMemberCommand< mitk::OpenIGTLinkTrackingDevice > CurCommandType;
   CurCommandType::Pointer messageReceivedCommand = CurCommandType::New();
   messageReceivedCommand->SetCallbackFunction(this, &mitk::OpenIGTLinkTrackingDevice::UpdateTools);
-  m_MessageReceivedObserverTag = m_OpenIGTLinkClient->AddObserver(mitk::MessageReceivedEvent(), messageReceivedCommand);
+  m_MessageReceivedObserverTag = m_OpenIGTLinkClient->AddReceiveObserver(mitk::MessageReceivedEvent(), messageReceivedCommand);
 
   m_OpenIGTLinkClient->EnableNoBufferingMode(true);
   this->SetState(Tracking);
@@ -400,7 +438,7 @@ bool mitk::OpenIGTLinkTrackingDevice::StopTracking()
     return false;
   }
 
-  m_OpenIGTLinkClient->RemoveObserver(m_MessageReceivedObserverTag); //disconnect itk events
+  m_OpenIGTLinkClient->RemoveReceiveObserver(m_MessageReceivedObserverTag); //disconnect itk events
 
   try
   {
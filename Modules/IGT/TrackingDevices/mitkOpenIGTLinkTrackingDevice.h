@@ -24,6 +24,10 @@ found in the LICENSE file.
 #include <igtlTransformMessage.h>
 #include "mitkIGTLTrackingDataDeviceSource.h"
 
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
 namespace mitk
 {
   /** Documentation:
@@ -138,6 +142,21 @@ namespace mitk
      */
     mitk::IGTLMessage::Pointer ReceiveMessage(int waitingTime);
 
+    /** Called by the receive thread of the OpenIGTLink client for every received message. */
+    void OnMessageReceived();
+
+    /** Blocks until a message arrived after the given message number or the timeout expired.
+     *  @return true if a new message arrived.
+     */
+    bool WaitForMessage(std::uint64_t lastMessage, int waitingTime);
+
+    std::uint64_t GetNumberOfReceivedMessages();
+
+    unsigned long m_MessageArrivalObserverTag;
+    std::mutex m_MessageArrivalMutex;
+    std::condition_variable m_MessageArrival;
+    std::uint64_t m_NumberOfReceivedMessages;
+
     /**
     * \return Returns all tools of the tracking device.
     */
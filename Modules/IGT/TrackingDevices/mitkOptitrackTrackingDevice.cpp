@@ -439,6 +439,7 @@ void mitk::OptitrackTrackingDevice::TrackTools()
           mitkThrowException(mitk::IGTException) << "Get data from tool number " << i << " failed";
         }
       }
+      this->NotifyNewData();
 
       /* Update the local copy of m_StopTracking */
       this->m_StopTrackingMutex.lock();
@@ -214,6 +214,7 @@ void mitk::PolhemusTrackingDevice::TrackTools()
           currentTool->SetOrientation(lastData.at(i).rot);
           currentTool->SetIGTTimeStamp(mitk::IGTTimeStamp::GetInstance()->GetElapsed());
         }
+        this->NotifyNewData();
       }
       /* Update the local copy of m_StopTracking */
       this->m_StopTrackingMutex.lock();
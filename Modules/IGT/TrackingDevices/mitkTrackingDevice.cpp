@@ -20,12 +20,20 @@ found in the LICENSE file.
 #include "mitkUnspecifiedTrackingTypeInformation.h"
 #include "mitkTrackingDeviceTypeCollection.h"
 
+#include <algorithm>
+
+namespace
+{
+  // polling interval in ms of WaitForNewData() for devices that do not call NotifyNewData()
+  const unsigned int NewDataPollingInterval = 20;
+}
 
 mitk::TrackingDevice::TrackingDevice() :
   m_State(mitk::TrackingDevice::Setup),
   m_Data(mitk::UnspecifiedTrackingTypeInformation::GetDeviceDataUnspecified()),
   m_StopTracking(false),
-  m_RotationMode(mitk::TrackingDevice::RotationStandard)
+  m_RotationMode(mitk::TrackingDevice::RotationStandard),
+  m_NumberOfDataUpdates(0)
 
 {
 }
@@ -144,3 +152,42 @@ std::string mitk::TrackingDevice::GetTrackingDeviceName()
 {
   return this->GetData().Line;
 }
+
+std::uint64_t mitk::TrackingDevice::GetNumberOfDataUpdates(std::chrono::steady_clock::time_point* lastUpdateTime) const
+{
+  std::lock_guard<std::mutex> lock(m_NewDataMutex);
+  if (lastUpdateTime != nullptr)
+    *lastUpdateTime = m_LastDataUpdateTime;
+  return m_NumberOfDataUpdates;
+}
+
+bool mitk::TrackingDevice::WaitForNewData(std::uint64_t lastUpdate, unsigned int timeoutInMilliseconds) const
+{
+  std::unique_lock<std::mutex> lock(m_NewDataMutex);
+
+  if (m_NumberOfDataUpdates == 0)
+  {
+    // the device never reported new data, so it may not call NotifyNewData() at all:
+    // fall back to polling, i.e. assume new data after the polling interval while tracking
+    const unsigned int interval = std::min(timeoutInMilliseconds, NewDataPollingInterval);
+    if (m_NewDataCondition.wait_for(lock, std::chrono::milliseconds(interval),
+      [this, lastUpdate] { return m_NumberOfDataUpdates != lastUpdate; }))
+      return true;
+
+    lock.unlock();
+    return this->GetState() == Tracking;
+  }
+
+  return m_NewDataCondition.wait_for(lock, std::chrono::milliseconds(timeoutInMilliseconds),
+    [this, lastUpdate] { return m_NumberOfDataUpdates != lastUpdate; });
+}
+
+void mitk::TrackingDevice::NotifyNewData()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_NewDataMutex);
+    ++m_NumberOfDataUpdates;
+    m_LastDataUpdateTime = std::chrono::steady_clock::now();
+  }
+  m_NewDataCondition.notify_all();
+}
@@ -19,6 +19,9 @@ found in the LICENSE file.
 #include "mitkCommon.h"
 #include "mitkTrackingTypes.h"
 #include "mitkNavigationToolStorage.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <mutex>
 
 namespace mitk {
@@ -178,6 +181,26 @@ namespace mitk {
      */
     virtual mitk::NavigationToolStorage::Pointer AutoDetectTools();
 
+    /**
+     * \brief Returns how often the device reported new tracking data, see NotifyNewData().
+     *
+     * @param lastUpdateTime optional, receives the time of the last report.
+     */
+    std::uint64_t GetNumberOfDataUpdates(std::chrono::steady_clock::time_point* lastUpdateTime = nullptr) const;
+
+    /**
+     * \brief Blocks until the device reported new tracking data after the given update number or the timeout expired.
+     *
+     * This allows consumers to update their pipelines as soon as new data arrives instead of
+     * polling in fixed intervals. As long as a device never reported new data (e.g. a device that
+     * does not call NotifyNewData()), this method falls back to polling: it returns true after a short
+     * polling interval if the device is tracking.
+     *
+     * @param lastUpdate the value of GetNumberOfDataUpdates() when the consumer read the data the last time.
+     * @return true if new data is available.
+     */
+    bool WaitForNewData(std::uint64_t lastUpdate, unsigned int timeoutInMilliseconds) const;
+
     private:
       TrackingDeviceState m_State; ///< current object state (Setup, Ready or Tracking)
     protected:
@@ -187,6 +210,12 @@ namespace mitk {
       */
       void SetState(TrackingDeviceState state);
 
+      /**
+      * \brief Wakes up all threads waiting in WaitForNewData().
+      * Subclasses call this from their tracking thread after all tools were updated.
+      */
+      void NotifyNewData();
+
 
       TrackingDevice();
       ~TrackingDevice() override;
@@ -198,6 +227,11 @@ namespace mitk {
       std::mutex m_TrackingFinishedMutex; ///< mutex to manage control flow of StopTracking()
       mutable std::mutex m_StateMutex; ///< mutex to control access to m_State
       RotationMode m_RotationMode; ///< defines the rotation mode Standard or Transposed, Standard is default
+
+      mutable std::mutex m_NewDataMutex; ///< mutex to control access to m_NumberOfDataUpdates and m_LastDataUpdateTime
+      mutable std::condition_variable m_NewDataCondition; ///< signaled by NotifyNewData()
+      std::uint64_t m_NumberOfDataUpdates; ///< number of calls of NotifyNewData()
+      std::chrono::steady_clock::time_point m_LastDataUpdateTime; ///< time of the last call of NotifyNewData()
     };
 } // namespace mitk
 
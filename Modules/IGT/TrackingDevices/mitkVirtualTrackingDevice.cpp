@@ -257,6 +257,7 @@ void mitk::VirtualTrackingDevice::TrackTools()
       currentTool->SetDataValid(true);
       currentTool->Modified();
     }
+    this->NotifyNewData();
     itksys::SystemTools::Delay(m_RefreshRate);
     /* Update the local copy of m_StopTracking */
     this->m_StopTrackingMutex.lock();
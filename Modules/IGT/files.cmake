@@ -19,6 +19,7 @@ set(CPP_FILES
   Algorithms/mitkPivotCalibration.cpp
 
   Common/mitkIGTTimeStamp.cpp
+  Common/mitkLatencyHistogram.cpp
   Common/mitkSerialCommunication.cpp
 
   DataManagement/mitkNavigationDataSource.cpp
@@ -37,6 +38,8 @@ set(CPP_FILES
   IO/mitkNavigationDataRecorder.cpp
   IO/mitkNavigationDataRecorderDeprecated.cpp
   IO/mitkNavigationDataSequentialPlayer.cpp
+  IO/mitkNavigationDataStreamReader.cpp
+  IO/mitkNavigationDataStreamWriter.cpp
   IO/mitkNavigationToolReader.cpp
   IO/mitkNavigationToolStorageSerializer.cpp
   IO/mitkNavigationToolStorageDeserializer.cpp
@@ -77,6 +80,7 @@ set(CPP_FILES
 set(H_FILES
   DataManagement/mitkTrackingDeviceTypeInformation.h
   Common/mitkTrackingTypes.h
+  IO/mitkNavigationDataStreamFormat.h
 )
 
 set(RESOURCE_FILES
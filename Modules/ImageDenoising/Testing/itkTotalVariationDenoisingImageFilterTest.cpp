@@ -15,6 +15,8 @@ found in the LICENSE file.
 #include "itkTotalVariationDenoisingImageFilter.h"
 #include "itkTotalVariationSingleIterationImageFilter.h"
 
+#include <algorithm>
+
 // image typedefs
 typedef itk::Image<float, 3> ImageType;
 typedef itk::ImageRegionIterator<ImageType> IteratorType;
@@ -203,6 +205,89 @@ int itkTotalVariationDenoisingImageFilterTest(int /*argc*/, char * /*argv*/ [])
     return EXIT_FAILURE;
   }
 
+  try
+  {
+    // the result must not depend on the number of work units
+    typedef itk::TotalVariationDenoisingImageFilter<ImageType, ImageType> TVFilterType;
+    ImageType::Pointer largeImage = ImageType::New();
+    ImageType::RegionType largeRegion;
+    ImageType::SizeType largeSize = {{7, 6, 9}};
+    largeRegion.SetSize(largeSize);
+    largeImage->SetRegions(largeRegion);
+    largeImage->Allocate();
+
+    int i = 0;
+    for (IteratorType it(largeImage, largeRegion); !it.IsAtEnd(); ++it)
+    {
+      it.Set((float)((i++ * 37) % 101));
+    }
+
+    TVFilterType::Pointer singleThreadFilter = TVFilterType::New();
+    singleThreadFilter->SetInput(largeImage);
+    singleThreadFilter->SetNumberIterations(5);
+    singleThreadFilter->SetNumberOfWorkUnits(1);
+    singleThreadFilter->SetLambda(0.1);
+    singleThreadFilter->Update();
+
+    TVFilterType::Pointer multiThreadFilter = TVFilterType::New();
+    multiThreadFilter->SetInput(largeImage);
+    multiThreadFilter->SetNumberIterations(5);
+    multiThreadFilter->SetNumberOfWorkUnits(4);
+    multiThreadFilter->SetLambda(0.1);
+    multiThreadFilter->Update();
+
+    IteratorType singleIt(singleThreadFilter->GetOutput(), largeRegion);
+    IteratorType multiIt(multiThreadFilter->GetOutput(), largeRegion);
+    for (; !singleIt.IsAtEnd(); ++singleIt, ++multiIt)
+    {
+      if (singleIt.Get() != multiIt.Get())
+      {
+        return EXIT_FAILURE;
+      }
+    }
+
+    // the fused iterations must match the chained single iteration filters
+    typedef itk::TotalVariationSingleIterationImageFilter<ImageType, ImageType> SingleFilterType;
+    ImageType::Pointer chainedImage = largeImage;
+    for (int iteration = 0; iteration < 5; ++iteration)
+    {
+      SingleFilterType::Pointer sFilter = SingleFilterType::New();
+      sFilter->SetInput(chainedImage);
+      sFilter->SetOriginalImage(largeImage);
+      sFilter->SetLambda(0.1);
+      sFilter->SetNumberOfWorkUnits(1);
+      sFilter->UpdateLargestPossibleRegion();
+      chainedImage = sFilter->GetOutput();
+    }
+
+    IteratorType chainedIt(chainedImage, largeRegion);
+    for (singleIt.GoToBegin(); !singleIt.IsAtEnd(); ++singleIt, ++chainedIt)
+    {
+      if (fabs(singleIt.Get() - chainedIt.Get()) > 1e-4 * std::max<double>(1.0, fabs(chainedIt.Get())))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+
+    // iterating stops early as soon as the pixels change less than the tolerance
+    TVFilterType::Pointer toleranceFilter = TVFilterType::New();
+    toleranceFilter->SetInput(largeImage);
+    toleranceFilter->SetNumberIterations(1000);
+    toleranceFilter->SetTolerance(0.01);
+    toleranceFilter->SetLambda(0.1);
+    toleranceFilter->Update();
+
+    if (toleranceFilter->GetElapsedIterations() >= 1000 || toleranceFilter->GetMaximumChange() >= 0.01)
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  catch (const itk::ExceptionObject& e)
+  {
+    e.Print(std::cerr);
+    return EXIT_FAILURE;
+  }
+
   VectorImageType::Pointer vecImage = GenerateVectorTestImage();
   PrintVectorImage(vecImage);
 
@@ -16,7 +16,6 @@ found in the LICENSE file.
 #include "itkCastImageFilter.h"
 #include "itkImage.h"
 #include "itkImageToImageFilter.h"
-#include "itkTotalVariationSingleIterationImageFilter.h"
 
 namespace itk
 {
@@ -25,6 +24,17 @@ namespace itk
    *
    * Reference: Tony F. Chan et al., The digital TV filter and nonlinear denoising
    *
+   * All iterations work on two buffers of the output size (ping-pong), so no image is allocated
+   * per iteration. Each iteration is a single multi-threaded pass over slabs of slices along the
+   * last image dimension: every work unit keeps the local variation of three neighboring slices
+   * in a rolling buffer and updates the middle slice, instead of computing a local variation
+   * image first.
+   *
+   * The iteration stops early once all pixels change less than the tolerance. An IterationEvent
+   * and a ProgressEvent are invoked after each iteration.
+   *
+   * The filter supports itk::Image with scalar or itk::Vector pixels.
+   *
    * \sa Image
    * \sa Neighborhood
    * \sa NeighborhoodOperator
@@ -66,8 +76,6 @@ namespace itk
 
     typedef typename InputImageType::SizeType InputSizeType;
 
-    typedef TotalVariationSingleIterationImageFilter<TOutputImage, TOutputImage> SingleIterationFilterType;
-
     typedef typename itk::CastImageFilter<TInputImage, TOutputImage> CastType;
 
     itkSetMacro(Lambda, double);
@@ -76,20 +84,59 @@ namespace itk
     itkSetMacro(NumberIterations, int);
     itkGetMacro(NumberIterations, int);
 
+    /** Iterating stops as soon as the largest change of a pixel in one iteration is below
+     * the tolerance. The default of 0 always runs all iterations. */
+    itkSetMacro(Tolerance, double);
+    itkGetMacro(Tolerance, double);
+
+    /** Number of iterations done by the last update. */
+    itkGetConstMacro(ElapsedIterations, int);
+
+    /** Largest change of a pixel in the most recent iteration. */
+    itkGetConstMacro(MaximumChange, double);
+
   protected:
     TotalVariationDenoisingImageFilter();
     ~TotalVariationDenoisingImageFilter() override {}
     void PrintSelf(std::ostream &os, Indent indent) const override;
 
+    /** The filter needs the whole input image. */
+    void GenerateInputRequestedRegion() override;
+
+    /** The filter produces the whole output image. */
+    void EnlargeOutputRequestedRegion(DataObject *output) override;
+
     void GenerateData() override;
 
     double m_Lambda;
 
     int m_NumberIterations;
 
+    double m_Tolerance;
+
+    int m_ElapsedIterations;
+
+    double m_MaximumChange;
+
   private:
     TotalVariationDenoisingImageFilter(const Self &); // purposely not implemented
     void operator=(const Self &);                     // purposely not implemented
+
+    /** Computes 1 / local variation of all pixels of one slice. */
+    void ComputeInverseLocalVariation(const OutputPixelType *image, SizeValueType slice, double *inverseLocalVariation) const;
+
+    /** Does one iteration for the slices [firstSlice, endSlice) and returns the largest squared change of a pixel.
+     * inverseLocalVariation must provide three slices of memory. */
+    double UpdateSlab(const OutputPixelType *image,
+                      const OutputPixelType *originalImage,
+                      OutputPixelType *updatedImage,
+                      SizeValueType firstSlice,
+                      SizeValueType endSlice,
+                      double *inverseLocalVariation) const;
+
+    InputSizeType m_BufferSize;
+    SizeValueType m_SliceSize;
+    SizeValueType m_NumberOfSlices;
   };
 
 } // end namespace itk
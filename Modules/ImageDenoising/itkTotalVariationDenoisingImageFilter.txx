@@ -19,75 +19,272 @@ This file is based heavily on a corresponding ITK filter.
 #define _itkTotalVariationDenoisingImageFilter_txx
 #include "itkTotalVariationDenoisingImageFilter.h"
 
-#include "itkConstShapedNeighborhoodIterator.h"
-#include "itkImageRegionConstIterator.h"
-#include "itkImageRegionIterator.h"
 #include "itkLocalVariationImageFilter.h"
-#include "itkNeighborhoodAlgorithm.h"
-#include "itkNeighborhoodInnerProduct.h"
-#include "itkOffset.h"
-#include "itkProgressReporter.h"
-#include "itkZeroFluxNeumannBoundaryCondition.h"
+#include "itkMultiThreaderBase.h"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <vector>
 
 namespace itk
 {
   template <class TInputImage, class TOutputImage>
   TotalVariationDenoisingImageFilter<TInputImage, TOutputImage>::TotalVariationDenoisingImageFilter()
-    : m_Lambda(1.0), m_NumberIterations(0)
+    : m_Lambda(1.0), m_NumberIterations(0), m_Tolerance(0.0), m_ElapsedIterations(0), m_MaximumChange(0.0),
+      m_SliceSize(0), m_NumberOfSlices(0)
   {
+    m_BufferSize.Fill(0);
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void TotalVariationDenoisingImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+  {
+    Superclass::GenerateInputRequestedRegion();
+
+    auto *input = const_cast<TInputImage *>(this->GetInput());
+    if (input)
+    {
+      input->SetRequestedRegionToLargestPossibleRegion();
+    }
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void TotalVariationDenoisingImageFilter<TInputImage, TOutputImage>::EnlargeOutputRequestedRegion(DataObject *output)
+  {
+    Superclass::EnlargeOutputRequestedRegion(output);
+    output->SetRequestedRegionToLargestPossibleRegion();
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void TotalVariationDenoisingImageFilter<TInputImage, TOutputImage>::ComputeInverseLocalVariation(
+    const OutputPixelType *image, SizeValueType slice, double *inverseLocalVariation) const
+  {
+    // neighbors outside of the image are replaced by the pixel itself (zero flux Neumann boundary condition)
+    const OutputPixelType *center = image + slice * m_SliceSize;
+    const OutputPixelType *lower = slice > 0 ? center - m_SliceSize : center;
+    const OutputPixelType *upper = slice + 1 < m_NumberOfSlices ? center + m_SliceSize : center;
+
+    std::array<SizeValueType, OutputImageDimension> index;
+    index.fill(0);
+
+    for (SizeValueType pixel = 0; pixel < m_SliceSize; ++pixel)
+    {
+      float localVariation = 0;
+      SizeValueType stride = 1;
+      for (unsigned int d = 0; d + 1 < OutputImageDimension; ++d)
+      {
+        const auto lowerNeighbor = index[d] > 0 ? pixel - stride : pixel;
+        const auto upperNeighbor = index[d] + 1 < m_BufferSize[d] ? pixel + stride : pixel;
+        OutputPixelType difference = center[lowerNeighbor] - center[pixel];
+        localVariation += SquaredEuclideanMetric<OutputPixelType>::Calc(difference);
+        difference = center[upperNeighbor] - center[pixel];
+        localVariation += SquaredEuclideanMetric<OutputPixelType>::Calc(difference);
+        stride *= m_BufferSize[d];
+      }
+      OutputPixelType difference = lower[pixel] - center[pixel];
+      localVariation += SquaredEuclideanMetric<OutputPixelType>::Calc(difference);
+      difference = upper[pixel] - center[pixel];
+      localVariation += SquaredEuclideanMetric<OutputPixelType>::Calc(difference);
+
+      // same precision as itk::LocalVariationImageFilter with a float output image
+      inverseLocalVariation[pixel] = 1.0 / static_cast<float>(std::sqrt(localVariation + 0.0001));
+
+      for (unsigned int d = 0; d + 1 < OutputImageDimension; ++d)
+      {
+        if (++index[d] < m_BufferSize[d])
+          break;
+        index[d] = 0;
+      }
+    }
+  }
+
+  template <class TInputImage, class TOutputImage>
+  double TotalVariationDenoisingImageFilter<TInputImage, TOutputImage>::UpdateSlab(const OutputPixelType *image,
+                                                                                    const OutputPixelType *originalImage,
+                                                                                    OutputPixelType *updatedImage,
+                                                                                    SizeValueType firstSlice,
+                                                                                    SizeValueType endSlice,
+                                                                                    double *inverseLocalVariation) const
+  {
+    constexpr unsigned int NeighborhoodSize = 2 * OutputImageDimension;
+
+    // rolling buffer with the local variation of the slices below, at and above the current slice
+    double *lowerVariation = inverseLocalVariation;
+    double *centerVariation = inverseLocalVariation + m_SliceSize;
+    double *upperVariation = inverseLocalVariation + 2 * m_SliceSize;
+
+    if (firstSlice > 0)
+      this->ComputeInverseLocalVariation(image, firstSlice - 1, lowerVariation);
+    this->ComputeInverseLocalVariation(image, firstSlice, centerVariation);
+    if (firstSlice + 1 < m_NumberOfSlices)
+      this->ComputeInverseLocalVariation(image, firstSlice + 1, upperVariation);
+
+    std::array<SizeValueType, OutputImageDimension> index;
+    std::array<const OutputPixelType *, NeighborhoodSize> neighbors;
+    std::array<double, NeighborhoodSize> weights;
+    double maximumChange = 0.0;
+
+    for (SizeValueType slice = firstSlice; slice < endSlice; ++slice)
+    {
+      const SizeValueType sliceOffset = slice * m_SliceSize;
+      const OutputPixelType *center = image + sliceOffset;
+      const OutputPixelType *original = originalImage + sliceOffset;
+      OutputPixelType *updated = updatedImage + sliceOffset;
+
+      const bool hasLowerSlice = slice > 0;
+      const bool hasUpperSlice = slice + 1 < m_NumberOfSlices;
+      const OutputPixelType *lower = hasLowerSlice ? center - m_SliceSize : center;
+      const OutputPixelType *upper = hasUpperSlice ? center + m_SliceSize : center;
+      const double *lowerSliceVariation = hasLowerSlice ? lowerVariation : centerVariation;
+      const double *upperSliceVariation = hasUpperSlice ? upperVariation : centerVariation;
+
+      index.fill(0);
+
+      for (SizeValueType pixel = 0; pixel < m_SliceSize; ++pixel)
+      {
+        //   1 / ||nabla_alpha(u)||_a
+        const double inverseVariation = centerVariation[pixel];
+
+        // w_alphabeta(u) = 1 / ||nabla_alpha(u)||_a + 1 / ||nabla_beta(u)||_a
+        unsigned int count = 0;
+        SizeValueType stride = 1;
+        for (unsigned int d = 0; d + 1 < OutputImageDimension; ++d)
+        {
+          const auto lowerNeighbor = index[d] > 0 ? pixel - stride : pixel;
+          const auto upperNeighbor = index[d] + 1 < m_BufferSize[d] ? pixel + stride : pixel;
+          neighbors[count] = center + lowerNeighbor;
+          weights[count++] = inverseVariation + centerVariation[lowerNeighbor];
+          neighbors[count] = center + upperNeighbor;
+          weights[count++] = inverseVariation + centerVariation[upperNeighbor];
+          stride *= m_BufferSize[d];
+        }
+        neighbors[count] = lower + pixel;
+        weights[count++] = inverseVariation + lowerSliceVariation[pixel];
+        neighbors[count] = upper + pixel;
+        weights[count++] = inverseVariation + upperSliceVariation[pixel];
+
+        double weightSum = 0.0;
+        for (unsigned int i = 0; i < NeighborhoodSize; ++i)
+          weightSum += weights[i];
+
+        const double normalization = 1.0 / (m_Lambda + weightSum);
+
+        // h_alphaalpha * u_alpha^zero + sum of h_alphabeta * u_beta
+        OutputPixelType result = static_cast<OutputPixelType>(original[pixel] * (m_Lambda * normalization));
+        for (unsigned int i = 0; i < NeighborhoodSize; ++i)
+          result += *neighbors[i] * (weights[i] * normalization);
+
+        const OutputPixelType change = result - center[pixel];
+        maximumChange = std::max(maximumChange, SquaredEuclideanMetric<OutputPixelType>::Calc(change));
+        updated[pixel] = result;
+
+        for (unsigned int d = 0; d + 1 < OutputImageDimension; ++d)
+        {
+          if (++index[d] < m_BufferSize[d])
+            break;
+          index[d] = 0;
+        }
+      }
+
+      // move the rolling buffer one slice up
+      std::swap(lowerVariation, centerVariation);
+      std::swap(centerVariation, upperVariation);
+      if (slice + 2 < m_NumberOfSlices && slice + 1 < endSlice)
+        this->ComputeInverseLocalVariation(image, slice + 2, upperVariation);
+    }
+
+    return maximumChange;
   }
 
   template <class TInputImage, class TOutputImage>
   void TotalVariationDenoisingImageFilter<TInputImage, TOutputImage>::GenerateData()
   {
-    // first we cast the input image to match output type
-    typename CastType::Pointer infilter = CastType::New();
-    infilter->SetInput(this->GetInput());
-    infilter->Update();
-    typename TOutputImage::Pointer image = infilter->GetOutput();
-
-    // a second copy of the input image is saved as reference
-    infilter = CastType::New();
-    infilter->SetInput(this->GetInput());
-    infilter->Update();
-    typename TOutputImage::Pointer origImage = infilter->GetOutput();
-
-    typename SingleIterationFilterType::Pointer filter;
-    for (int i = 0; i < m_NumberIterations; i++)
+    // the input, cast to the output type, is the reference of the data term and the start of the iteration
+    typename CastType::Pointer caster = CastType::New();
+    caster->SetInput(this->GetInput());
+    caster->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    caster->Update();
+    typename OutputImageType::Pointer originalImage = caster->GetOutput();
+
+    this->AllocateOutputs();
+    OutputImageType *output = this->GetOutput();
+
+    const OutputImageRegionType region = output->GetBufferedRegion();
+    const SizeValueType numberOfPixels = region.GetNumberOfPixels();
+
+    m_ElapsedIterations = 0;
+    m_MaximumChange = 0.0;
+
+    if (m_NumberIterations <= 0 || 0 == numberOfPixels)
     {
-      filter = SingleIterationFilterType::New();
-      filter->SetInput(image);
-      filter->SetOriginalImage(origImage);
-      filter->SetLambda(m_Lambda);
-      filter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-      filter->UpdateLargestPossibleRegion();
-      image = filter->GetOutput();
-      std::cout << "Iteration " << i + 1 << "/" << m_NumberIterations << std::endl;
+      std::copy_n(originalImage->GetBufferPointer(), numberOfPixels, output->GetBufferPointer());
+      return;
     }
 
-    typename OutputImageType::Pointer output = this->GetOutput();
-    output->SetSpacing(image->GetSpacing());
-    typename OutputImageType::RegionType largestPossibleRegion;
-    largestPossibleRegion.SetSize(image->GetLargestPossibleRegion().GetSize());
-    largestPossibleRegion.SetIndex(image->GetLargestPossibleRegion().GetIndex());
-    output->SetLargestPossibleRegion(image->GetLargestPossibleRegion());
-    output->SetBufferedRegion(image->GetLargestPossibleRegion());
-    output->Allocate();
+    // the image is processed in slices along the last dimension
+    m_BufferSize = region.GetSize();
+    m_NumberOfSlices = m_BufferSize[OutputImageDimension - 1];
+    m_SliceSize = numberOfPixels / m_NumberOfSlices;
+
+    // iterations alternate between the output buffer and a second buffer; the first one reads the original image
+    typename OutputImageType::Pointer secondBuffer;
+    if (m_NumberIterations > 1)
+    {
+      secondBuffer = OutputImageType::New();
+      secondBuffer->CopyInformation(output);
+      secondBuffer->SetRegions(region);
+      secondBuffer->Allocate();
+    }
+
+    std::array<OutputImageType *, 2> targets = {{output, secondBuffer.GetPointer()}};
+    unsigned int target = 0;
+    const OutputPixelType *current = originalImage->GetBufferPointer();
+
+    const auto numberOfWorkUnits = static_cast<unsigned int>(
+      std::min<SizeValueType>(std::max(1u, this->GetNumberOfWorkUnits()), m_NumberOfSlices));
+    std::vector<double> inverseLocalVariation(numberOfWorkUnits * 3 * m_SliceSize);
+    std::vector<double> maximumChanges(numberOfWorkUnits);
 
-    itk::ImageRegionIterator<OutputImageType> oit(output, output->GetLargestPossibleRegion());
-    oit.GoToBegin();
+    MultiThreaderBase *multiThreader = this->GetMultiThreader();
+    multiThreader->SetNumberOfWorkUnits(numberOfWorkUnits);
 
-    itk::ImageRegionConstIterator<OutputImageType> iit(image, image->GetLargestPossibleRegion());
-    iit.GoToBegin();
+    for (int i = 0; i < m_NumberIterations; ++i)
+    {
+      OutputPixelType *updated = targets[target]->GetBufferPointer();
+
+      multiThreader->ParallelizeArray(
+        0,
+        numberOfWorkUnits,
+        [&](SizeValueType workUnit) {
+          const SizeValueType firstSlice = workUnit * m_NumberOfSlices / numberOfWorkUnits;
+          const SizeValueType endSlice = (workUnit + 1) * m_NumberOfSlices / numberOfWorkUnits;
+          maximumChanges[workUnit] = this->UpdateSlab(current,
+                                                      originalImage->GetBufferPointer(),
+                                                      updated,
+                                                      firstSlice,
+                                                      endSlice,
+                                                      inverseLocalVariation.data() + workUnit * 3 * m_SliceSize);
+        },
+        nullptr);
+
+      current = updated;
+      target = 1 - target;
+
+      ++m_ElapsedIterations;
+      m_MaximumChange = std::sqrt(*std::max_element(maximumChanges.begin(), maximumChanges.end()));
+
+      this->InvokeEvent(IterationEvent());
+      this->UpdateProgress(static_cast<float>(i + 1) / m_NumberIterations);
+
+      if (m_MaximumChange < m_Tolerance)
+        break;
+    }
 
-    while (!oit.IsAtEnd())
+    // the last iteration may have written to the second buffer; hand its memory over to the output
+    if (current != output->GetBufferPointer())
     {
-      oit.Set(iit.Get());
-      ++iit;
-      ++oit;
+      output->SetPixelContainer(secondBuffer->GetPixelContainer());
     }
   }
 
@@ -98,6 +295,10 @@ namespace itk
   void TotalVariationDenoisingImageFilter<TInputImage, TOutput>::PrintSelf(std::ostream &os, Indent indent) const
   {
     Superclass::PrintSelf(os, indent);
+    os << indent << "Lambda: " << m_Lambda << std::endl;
+    os << indent << "NumberIterations: " << m_NumberIterations << std::endl;
+    os << indent << "Tolerance: " << m_Tolerance << std::endl;
+    os << indent << "ElapsedIterations: " << m_ElapsedIterations << std::endl;
   }
 
 } // end namespace itk
@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include <mitkLogBackendBase.h>
 
+#include <cstddef>
 #include <sstream>
 
 #include <MitkLogExports.h>
@@ -60,6 +61,62 @@ namespace mitk
    */
   bool MITKLOG_EXPORT IsBackendEnabled(LogBackendBase::OutputType type);
 
+  /** \brief Enable the messages of a log level. All log levels are enabled by default.
+   */
+  void MITKLOG_EXPORT EnableLogLevel(LogLevel level);
+
+  /** \brief Disable the messages of a log level.
+   *
+   * The log macros check the level before anything is streamed, so the arguments of a disabled log statement are
+   * not even evaluated.
+   */
+  void MITKLOG_EXPORT DisableLogLevel(LogLevel level);
+
+  /** \brief Check wether the messages of this log level are enabled.
+   */
+  bool MITKLOG_EXPORT IsLogLevelEnabled(LogLevel level);
+
+  /** \brief Behavior of the asynchronous dispatch if its message queue is full.
+   */
+  enum class LogQueueOverflowPolicy
+  {
+    /** The logging thread waits until there is space in the queue. No message is lost. */
+    Block,
+    /** Info and debug messages are discarded, all other messages wait for space in the queue. The number of
+     * discarded messages is logged as a warning. */
+    DiscardInfoAndDebug
+  };
+
+  /** \brief Distribute log messages to the backends in a dedicated thread.
+   *
+   * Logging threads only copy their messages into a bounded, lock-free queue and do not wait for the formatting and
+   * the output of the backends anymore. The messages are still processed in the order in which they were queued.
+   * Fatal messages are an exception: the logging thread waits until the fatal message and all messages before it
+   * were processed, since the application might terminate right after a fatal message.
+   *
+   * Calling this method again replaces the queue after all queued messages were processed.
+   * Call DisableAsynchronousDispatch() before the application exits to process the remaining messages.
+   *
+   * \param queueCapacity Number of messages the queue can hold, rounded up to a power of two.
+   * \param policy What happens to messages if the queue is full.
+   */
+  void MITKLOG_EXPORT EnableAsynchronousDispatch(std::size_t queueCapacity = 8192,
+                                                 LogQueueOverflowPolicy policy = LogQueueOverflowPolicy::Block);
+
+  /** \brief Process all queued messages, stop the dispatch thread and distribute further messages synchronously.
+   */
+  void MITKLOG_EXPORT DisableAsynchronousDispatch();
+
+  /** \brief Check wether log messages are distributed to the backends in a dedicated thread.
+   */
+  bool MITKLOG_EXPORT IsAsynchronousDispatchEnabled();
+
+  /** \brief Wait until all messages that were queued before have been processed by the backends.
+   *
+   * Returns immediately if the asynchronous dispatch is disabled.
+   */
+  void MITKLOG_EXPORT FlushBackends();
+
   /** \brief Simulates a std::cout stream.
    *
    * Should only be used by the macros defined in the file mitkLog.h.
@@ -72,6 +129,7 @@ namespace mitk
         m_Message(level, filePath, lineNumber, functionName),
         m_Stream(std::stringstream::out)
     {
+      m_Stream.imbue(std::locale::classic());
     }
 
     /** \brief The encapsulated message is written to the backend.
@@ -90,16 +148,8 @@ namespace mitk
     PseudoLogStream& operator<<(const T& data)
     {
       if (!m_Disabled)
-      {
-        std::locale C("C");
-        std::locale originalLocale = m_Stream.getloc();
-        m_Stream.imbue(C);
-
         m_Stream << data;
 
-        m_Stream.imbue(originalLocale);
-      }
-
       return *this;
     }
 
@@ -107,32 +157,16 @@ namespace mitk
     PseudoLogStream& operator<<(T& data)
     {
       if (!m_Disabled)
-      {
-        std::locale C("C");
-        std::locale originalLocale = m_Stream.getloc();
-        m_Stream.imbue(C);
-
         m_Stream << data;
 
-        m_Stream.imbue(originalLocale);
-      }
-
       return *this;
     }
 
     PseudoLogStream& operator<<(std::ostream& (*func)(std::ostream&))
     {
       if (!m_Disabled)
-      {
-        std::locale C("C");
-        std::locale originalLocale = m_Stream.getloc();
-        m_Stream.imbue(C);
-
         m_Stream << func;
 
-        m_Stream.imbue(originalLocale);
-      }
-
       return *this;
     }
 
@@ -204,15 +238,38 @@ namespace mitk
       return *this;
     }
   };
+
+  /**
+   * \brief Turns a complete log statement into a void expression.
+   *
+   * Used by the log macros to skip disabled log levels. The operator & binds weaker than the stream operators, so
+   * the whole statement is skipped, including the evaluation of the streamed arguments.
+   */
+  class LogStreamVoidify
+  {
+  public:
+    void operator&(const PseudoLogStream&)
+    {
+    }
+  };
 }
 
-#define MITK_INFO mitk::PseudoLogStream(mitk::LogLevel::Info, __FILE__, __LINE__, __FUNCTION__)
-#define MITK_WARN mitk::PseudoLogStream(mitk::LogLevel::Warn, __FILE__, __LINE__, __FUNCTION__)
-#define MITK_ERROR mitk::PseudoLogStream(mitk::LogLevel::Error, __FILE__, __LINE__, __FUNCTION__)
-#define MITK_FATAL mitk::PseudoLogStream(mitk::LogLevel::Fatal, __FILE__, __LINE__, __FUNCTION__)
+/** \brief Log statement with an explicit source location, e.g. for relaying messages of other log systems.
+ */
+#define MITKLOG_STREAM_AT(level, filePath, lineNumber, functionName) \
+  !mitk::IsLogLevelEnabled(level) \
+    ? (void)0 \
+    : mitk::LogStreamVoidify() & mitk::PseudoLogStream(level, filePath, lineNumber, functionName)
+
+#define MITKLOG_STREAM(level) MITKLOG_STREAM_AT(level, __FILE__, __LINE__, __FUNCTION__)
+
+#define MITK_INFO MITKLOG_STREAM(mitk::LogLevel::Info)
+#define MITK_WARN MITKLOG_STREAM(mitk::LogLevel::Warn)
+#define MITK_ERROR MITKLOG_STREAM(mitk::LogLevel::Error)
+#define MITK_FATAL MITKLOG_STREAM(mitk::LogLevel::Fatal)
 
 #ifdef MITK_ENABLE_DEBUG_MESSAGES
-#define MITK_DEBUG mitk::PseudoLogStream(mitk::LogLevel::Debug, __FILE__, __LINE__, __FUNCTION__)
+#define MITK_DEBUG MITKLOG_STREAM(mitk::LogLevel::Debug)
 #else
 #define MITK_DEBUG true ? mitk::NullLogStream() : mitk::NullLogStream()
 #endif
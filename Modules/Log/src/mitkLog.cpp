@@ -13,68 +13,430 @@ found in the LICENSE file.
 #include <mitkLog.h>
 #include <mitkLogBackendCout.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <thread>
 
 static std::list<mitk::LogBackendBase*> backends;
 static std::set<mitk::LogBackendBase::OutputType> disabledBackendTypes;
 
+// Backends may log themselves while processing a message, hence the recursive mutex
+static std::recursive_mutex backendsMutex;
+
+static std::atomic<unsigned int> disabledLogLevels(0);
+
+namespace
+{
+  unsigned int GetLogLevelBit(mitk::LogLevel level)
+  {
+    return 1u << static_cast<unsigned int>(level);
+  }
+
+  void DispatchToBackends(mitk::LogMessage& message)
+  {
+    // Crop Message
+    {
+      std::string::size_type i = message.Message.find_last_not_of(" \t\f\v\n\r");
+
+      message.Message = i != std::string::npos
+        ? message.Message.substr(0, i + 1)
+        : "";
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(backendsMutex);
+
+    // create dummy backend if there is no backend registered (so we have an output anyway)
+    static mitk::LogBackendCout* dummyBackend = nullptr;
+
+    if (backends.empty() && dummyBackend == nullptr)
+    {
+      dummyBackend = new mitk::LogBackendCout;
+      mitk::RegisterBackend(dummyBackend);
+    }
+    else if (backends.size() > 1 && dummyBackend != nullptr)
+    {
+      // if there was added another backend remove the dummy backend and delete it
+      mitk::UnregisterBackend(dummyBackend);
+      delete dummyBackend;
+      dummyBackend = nullptr;
+    }
+
+    // iterate through all registered images and call the ProcessMessage() methods of the backends
+    for (auto i = backends.begin(); i != backends.end(); ++i)
+    {
+      if (mitk::IsBackendEnabled((*i)->GetOutputType()))
+        (*i)->ProcessMessage(message);
+    }
+  }
+
+  /** \brief Distributes log messages to the backends in a dedicated thread.
+   *
+   * The messages are passed through a bounded multi-producer/single-consumer queue (an array of cells with sequence
+   * numbers, see D. Vyukov's bounded MPMC queue), so logging threads never wait for a lock or for the backends unless
+   * the queue is full or a fatal message is logged.
+   */
+  class AsyncDispatcher
+  {
+  public:
+    AsyncDispatcher(std::size_t capacity, mitk::LogQueueOverflowPolicy policy)
+      : m_Mask(0),
+        m_Policy(policy),
+        m_EnqueuePosition(0),
+        m_DequeuePosition(0),
+        m_NumberOfProcessedMessages(0),
+        m_NumberOfDiscardedMessages(0),
+        m_NumberOfReportedDiscardedMessages(0),
+        m_NumberOfFlushWaiters(0),
+        m_Sleeping(false),
+        m_Stop(false)
+    {
+      std::size_t size = 2;
+      while (size < capacity)
+        size *= 2;
+
+      m_Mask = size - 1;
+      m_Cells.reset(new Cell[size]);
+
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        m_Cells[i].Sequence.store(i, std::memory_order_relaxed);
+        m_Cells[i].Message = nullptr;
+      }
+
+      m_Thread = std::thread(&AsyncDispatcher::Run, this);
+    }
+
+    /** \brief Processes the remaining messages and stops the dispatch thread.
+     *
+     * No message must be pushed concurrently.
+     */
+    ~AsyncDispatcher()
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+      }
+      m_WakeUp.notify_one();
+      m_Thread.join();
+    }
+
+    bool IsDispatchThread() const
+    {
+      return std::this_thread::get_id() == m_Thread.get_id();
+    }
+
+    void Push(const mitk::LogMessage& message)
+    {
+      auto* queuedMessage = new mitk::LogMessage(message);
+
+      const bool mayDiscard = m_Policy == mitk::LogQueueOverflowPolicy::DiscardInfoAndDebug &&
+                              (message.Level == mitk::LogLevel::Info || message.Level == mitk::LogLevel::Debug);
+
+      bool pushed = this->TryPush(queuedMessage);
+
+      if (!pushed && mayDiscard)
+      {
+        delete queuedMessage;
+        ++m_NumberOfDiscardedMessages;
+      }
+
+      while (!pushed && !mayDiscard)
+      {
+        this->WakeUp();
+        std::this_thread::yield();
+        pushed = this->TryPush(queuedMessage);
+      }
+
+      if (m_Sleeping.load())
+        this->WakeUp();
+
+      if (message.Level == mitk::LogLevel::Fatal)
+        this->Flush();
+    }
+
+    void Flush()
+    {
+      if (this->IsDispatchThread())
+        return;
+
+      const std::size_t target = m_EnqueuePosition.load();
+
+      if (m_NumberOfProcessedMessages.load() >= target)
+        return;
+
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      ++m_NumberOfFlushWaiters;
+      m_WakeUp.notify_one();
+      m_Processed.wait(lock, [this, target]() { return m_NumberOfProcessedMessages.load() >= target; });
+      --m_NumberOfFlushWaiters;
+    }
+
+  private:
+    struct Cell
+    {
+      std::atomic<std::size_t> Sequence;
+      mitk::LogMessage* Message;
+    };
+
+    bool TryPush(mitk::LogMessage* message)
+    {
+      std::size_t position = m_EnqueuePosition.load(std::memory_order_relaxed);
+      Cell* cell = nullptr;
+
+      while (true)
+      {
+        cell = &m_Cells[position & m_Mask];
+        const std::size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+        if (difference == 0)
+        {
+          if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (difference < 0)
+        {
+          return false; // full
+        }
+        else
+        {
+          position = m_EnqueuePosition.load(std::memory_order_relaxed);
+        }
+      }
+
+      cell->Message = message;
+      cell->Sequence.store(position + 1);
+      return true;
+    }
+
+    mitk::LogMessage* TryPop()
+    {
+      Cell& cell = m_Cells[m_DequeuePosition & m_Mask];
+
+      if (cell.Sequence.load(std::memory_order_acquire) != m_DequeuePosition + 1)
+        return nullptr;
+
+      auto* message = cell.Message;
+      cell.Message = nullptr;
+      cell.Sequence.store(m_DequeuePosition + m_Mask + 1, std::memory_order_release);
+      ++m_DequeuePosition;
+      return message;
+    }
+
+    bool IsEmpty() const
+    {
+      return m_Cells[m_DequeuePosition & m_Mask].Sequence.load() != m_DequeuePosition + 1;
+    }
+
+    void WakeUp()
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_WakeUp.notify_one();
+    }
+
+    void ReportDiscardedMessages()
+    {
+      const std::size_t numberOfDiscardedMessages = m_NumberOfDiscardedMessages.load();
+
+      if (numberOfDiscardedMessages == m_NumberOfReportedDiscardedMessages)
+        return;
+
+      mitk::LogMessage message(mitk::LogLevel::Warn, __FILE__, __LINE__, __FUNCTION__);
+      message.ModuleName = MITKLOG_MODULENAME;
+      message.Message = std::to_string(numberOfDiscardedMessages - m_NumberOfReportedDiscardedMessages) +
+                        " log messages were discarded because the log queue was full.";
+      m_NumberOfReportedDiscardedMessages = numberOfDiscardedMessages;
+
+      DispatchToBackends(message);
+    }
+
+    void Run()
+    {
+      while (true)
+      {
+        std::unique_ptr<mitk::LogMessage> message(this->TryPop());
+
+        if (message)
+        {
+          DispatchToBackends(*message);
+          ++m_NumberOfProcessedMessages;
+
+          if (m_NumberOfFlushWaiters.load() > 0)
+          {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Processed.notify_all();
+          }
+
+          continue;
+        }
+
+        this->ReportDiscardedMessages();
+
+        std::unique_lock<std::mutex> lock(m_Mutex);
+
+        if (m_Stop)
+          break;
+
+        m_Sleeping = true;
+
+        // A producer that pushed right before m_Sleeping was set does not wake us up, hence the timeout
+        if (this->IsEmpty())
+          m_WakeUp.wait_for(lock, std::chrono::milliseconds(10));
+
+        m_Sleeping = false;
+      }
+    }
+
+    std::unique_ptr<Cell[]> m_Cells;
+    std::size_t m_Mask;
+    mitk::LogQueueOverflowPolicy m_Policy;
+
+    std::atomic<std::size_t> m_EnqueuePosition;
+    std::size_t m_DequeuePosition; // only used by the dispatch thread
+
+    std::atomic<std::size_t> m_NumberOfProcessedMessages;
+    std::atomic<std::size_t> m_NumberOfDiscardedMessages;
+    std::size_t m_NumberOfReportedDiscardedMessages; // only used by the dispatch thread
+
+    std::atomic<int> m_NumberOfFlushWaiters;
+    std::atomic<bool> m_Sleeping;
+    bool m_Stop;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_WakeUp;
+    std::condition_variable m_Processed;
+    std::thread m_Thread;
+  };
+
+  std::mutex dispatchModeMutex;
+  std::atomic<AsyncDispatcher*> asyncDispatcher(nullptr);
+
+  // Number of threads that might push a message right now, a dispatcher is only deleted if there are none
+  std::atomic<int> numberOfPushingThreads(0);
+
+  // Processes the queued messages when the application exits without disabling the asynchronous dispatch.
+  // Defined last, so it is destroyed before the backends and the queue.
+  struct AsyncDispatchCleanup
+  {
+    ~AsyncDispatchCleanup()
+    {
+      mitk::DisableAsynchronousDispatch();
+    }
+  } asyncDispatchCleanup;
+}
+
 void mitk::RegisterBackend(LogBackendBase* backend)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   backends.push_back(backend);
 }
 
 void mitk::UnregisterBackend(LogBackendBase* backend)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   backends.remove(backend);
 }
 
 void mitk::DistributeToBackends(LogMessage& message)
 {
-  // Crop Message
-  {
-    std::string::size_type i = message.Message.find_last_not_of(" \t\f\v\n\r");
-
-    message.Message = i != std::string::npos
-      ? message.Message.substr(0, i + 1)
-      : "";
-  }
+  ++numberOfPushingThreads;
 
-  // create dummy backend if there is no backend registered (so we have an output anyway)
-  static LogBackendCout* dummyBackend = nullptr;
+  auto* dispatcher = asyncDispatcher.load();
 
-  if (backends.empty() && dummyBackend == nullptr)
+  // messages logged by a backend itself are not queued, the dispatch thread would wait for itself
+  if (dispatcher != nullptr && !dispatcher->IsDispatchThread())
   {
-    dummyBackend = new LogBackendCout;
-    RegisterBackend(dummyBackend);
+    dispatcher->Push(message);
+    --numberOfPushingThreads;
   }
-  else if (backends.size() > 1 && dummyBackend != nullptr)
+  else
   {
-    // if there was added another backend remove the dummy backend and delete it
-    UnregisterBackend(dummyBackend);
-    delete dummyBackend;
-    dummyBackend = nullptr;
-  }
-
-  // iterate through all registered images and call the ProcessMessage() methods of the backends
-  for (auto i = backends.begin(); i != backends.end(); ++i)
-  {
-    if (IsBackendEnabled((*i)->GetOutputType()))
-      (*i)->ProcessMessage(message);
+    --numberOfPushingThreads;
+    DispatchToBackends(message);
   }
 }
 
 void mitk::EnableBackends(LogBackendBase::OutputType type)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   disabledBackendTypes.erase(type);
 }
 
 void mitk::DisableBackends(LogBackendBase::OutputType type)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   disabledBackendTypes.insert(type);
 }
 
 bool mitk::IsBackendEnabled(LogBackendBase::OutputType type)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   return disabledBackendTypes.find(type) == disabledBackendTypes.end();
 }
+
+void mitk::EnableLogLevel(LogLevel level)
+{
+  disabledLogLevels &= ~GetLogLevelBit(level);
+}
+
+void mitk::DisableLogLevel(LogLevel level)
+{
+  disabledLogLevels |= GetLogLevelBit(level);
+}
+
+bool mitk::IsLogLevelEnabled(LogLevel level)
+{
+  return (disabledLogLevels.load(std::memory_order_relaxed) & GetLogLevelBit(level)) == 0;
+}
+
+void mitk::EnableAsynchronousDispatch(std::size_t queueCapacity, LogQueueOverflowPolicy policy)
+{
+  std::lock_guard<std::mutex> lock(dispatchModeMutex);
+
+  auto* newDispatcher = new AsyncDispatcher(queueCapacity, policy);
+  auto* oldDispatcher = asyncDispatcher.exchange(newDispatcher);
+
+  if (oldDispatcher != nullptr)
+  {
+    // threads that still push to the old queue have to finish before it can be deleted
+    while (numberOfPushingThreads.load() > 0)
+      std::this_thread::yield();
+
+    delete oldDispatcher;
+  }
+}
+
+void mitk::DisableAsynchronousDispatch()
+{
+  std::lock_guard<std::mutex> lock(dispatchModeMutex);
+
+  auto* dispatcher = asyncDispatcher.exchange(nullptr);
+
+  if (dispatcher != nullptr)
+  {
+    while (numberOfPushingThreads.load() > 0)
+      std::this_thread::yield();
+
+    delete dispatcher;
+  }
+}
+
+bool mitk::IsAsynchronousDispatchEnabled()
+{
+  return asyncDispatcher.load() != nullptr;
+}
+
+void mitk::FlushBackends()
+{
+  std::lock_guard<std::mutex> lock(dispatchModeMutex);
+
+  auto* dispatcher = asyncDispatcher.load();
+
+  if (dispatcher != nullptr)
+    dispatcher->Flush();
+}
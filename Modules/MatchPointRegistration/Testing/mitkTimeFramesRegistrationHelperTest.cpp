@@ -14,6 +14,72 @@ found in the LICENSE file.
 #include "mitkTestFixture.h"
 
 #include "mitkTimeFramesRegistrationHelper.h"
+#include "mitkImageReadAccessor.h"
+
+#include <mapAlgorithmIdentificationInterface.h>
+#include <mapDiscreteElements.h>
+#include <mapDummyImageRegistrationAlgorithm.h>
+
+#include <itkCommand.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+  mapGenerateAlgorithmUIDPolicyMacro(TestIdentityRegIDPolicy, "de.dkfz.dipp", "TestIdentity", "1.0.0", "");
+
+  typedef map::core::discrete::Elements<3>::InternalImageType FrameImageType;
+  typedef map::algorithm::DummyImageRegistrationAlgorithm<FrameImageType, FrameImageType, TestIdentityRegIDPolicy>
+    IdentityRegistrationAlgorithmType;
+
+  /** Clones the identity algorithm, which has no meta properties, so that frames are processed concurrently.*/
+  class ClonableFramesRegistrationHelper : public mitk::TimeFramesRegistrationHelper
+  {
+  public:
+    mitkClassMacro(ClonableFramesRegistrationHelper, mitk::TimeFramesRegistrationHelper);
+    itkFactorylessNewMacro(Self);
+
+    unsigned int GetNumberOfClones() const
+    {
+      return m_NumberOfClones;
+    }
+
+  protected:
+    RegistrationAlgorithmPointer CloneAlgorithm() const override
+    {
+      ++m_NumberOfClones;
+      return IdentityRegistrationAlgorithmType::New().GetPointer();
+    }
+
+    mutable unsigned int m_NumberOfClones = 0;
+  };
+
+  /** Records the comments of the frame mapping events in the order they are invoked.*/
+  class FrameMappingEventRecorder : public itk::Command
+  {
+  public:
+    mitkClassMacroItkParent(FrameMappingEventRecorder, itk::Command);
+    itkFactorylessNewMacro(Self);
+
+    void Execute(itk::Object *caller, const itk::EventObject &event) override
+    {
+      this->Execute(static_cast<const itk::Object *>(caller), event);
+    }
+
+    void Execute(const itk::Object *, const itk::EventObject &event) override
+    {
+      const auto *mappingEvent = dynamic_cast<const mitk::FrameMappingEvent *>(&event);
+      if (nullptr != mappingEvent)
+      {
+        m_Comments.push_back(mappingEvent->getComment());
+      }
+    }
+
+    std::vector<std::string> m_Comments;
+  };
+}
 
 class mitkTimeFramesRegistrationHelperTestSuite : public mitk::TestFixture
 {
@@ -25,10 +91,49 @@ class mitkTimeFramesRegistrationHelperTestSuite : public mitk::TestFixture
   MITK_TEST(SetAllowUnregPixels_GetAllowUnregPixels);
   MITK_TEST(SetInterpolatorType_GetInterpolatorType);
   MITK_TEST(Set_Get_Clear_IgnoreList);
+  MITK_TEST(SetMaximumNumberOfConcurrentFrames_GetMaximumNumberOfConcurrentFrames);
+  MITK_TEST(SetInitializeByNeighborFrame_GetInitializeByNeighborFrame);
+  MITK_TEST(Generate_Sequential_RegistersFramesInOrder);
+  MITK_TEST(Generate_Concurrent_EqualsSequential);
   CPPUNIT_TEST_SUITE_END();
 private:
   mitk::TimeFramesRegistrationHelper::Pointer frameRegHelper;
   mitk::TimeFramesRegistrationHelper::IgnoreListType ignoreList;
+  mitk::Image::Pointer image4D;
+
+  static constexpr unsigned int NumberOfFrames = 5;
+  static constexpr unsigned int NumberOfFrameVoxels = 4 * 3 * 2;
+
+  static float GetExpectedValue(unsigned int frame, unsigned int voxel)
+  {
+    return static_cast<float>(frame * 100 + voxel);
+  }
+
+  void CheckRegisteredImage(const mitk::Image *registeredImage)
+  {
+    CPPUNIT_ASSERT(nullptr != registeredImage);
+    CPPUNIT_ASSERT_EQUAL(NumberOfFrames, registeredImage->GetTimeSteps());
+
+    for (unsigned int frame = 0; frame < NumberOfFrames; ++frame)
+    {
+      mitk::ImageReadAccessor accessor(registeredImage, registeredImage->GetVolumeData(frame));
+      const auto *data = static_cast<const float *>(accessor.GetData());
+
+      for (unsigned int voxel = 0; voxel < NumberOfFrameVoxels; ++voxel)
+      {
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Frame #" + std::to_string(frame) + ", voxel #" + std::to_string(voxel),
+                                     GetExpectedValue(frame, voxel), data[voxel]);
+      }
+    }
+  }
+
+  void ConfigureForGenerate(mitk::TimeFramesRegistrationHelper *helper)
+  {
+    helper->Set4DImage(image4D);
+    helper->SetAlgorithm(IdentityRegistrationAlgorithmType::New());
+    helper->SetInterpolatorType(mitk::ImageMappingInterpolator::NearestNeighbor);
+    helper->SetIgnoreList({ 2 });
+  }
 
 public:
   void setUp() override
@@ -37,6 +142,20 @@ public:
     ignoreList.clear();
     ignoreList.push_back(2);
     ignoreList.push_back(13);
+
+    unsigned int dimensions[4] = { 4, 3, 2, NumberOfFrames };
+    image4D = mitk::Image::New();
+    image4D->Initialize(mitk::MakeScalarPixelType<float>(), 4, dimensions);
+
+    std::vector<float> frameData(NumberOfFrameVoxels);
+    for (unsigned int frame = 0; frame < NumberOfFrames; ++frame)
+    {
+      for (unsigned int voxel = 0; voxel < NumberOfFrameVoxels; ++voxel)
+      {
+        frameData[voxel] = GetExpectedValue(frame, voxel);
+      }
+      image4D->SetVolume(frameData.data(), frame);
+    }
   }
 
   void tearDown() override
@@ -102,6 +221,70 @@ public:
     CPPUNIT_ASSERT(frameRegHelper->GetIgnoreList().empty());
   }
 
+  void SetMaximumNumberOfConcurrentFrames_GetMaximumNumberOfConcurrentFrames()
+  {
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Check getter on default value", 1u,
+                                 frameRegHelper->GetMaximumNumberOfConcurrentFrames());
+
+    itk::ModifiedTimeType mtime = frameRegHelper->GetMTime();
+    frameRegHelper->SetMaximumNumberOfConcurrentFrames(4);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Check getter on changed value", 4u,
+                                 frameRegHelper->GetMaximumNumberOfConcurrentFrames());
+    CPPUNIT_ASSERT(mtime < frameRegHelper->GetMTime());
+  }
+
+  void SetInitializeByNeighborFrame_GetInitializeByNeighborFrame()
+  {
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Check getter on default value", false,
+                                 frameRegHelper->GetInitializeByNeighborFrame());
+    frameRegHelper->InitializeByNeighborFrameOn();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Check getter on changed value", true,
+                                 frameRegHelper->GetInitializeByNeighborFrame());
+  }
+
+  void Generate_Sequential_RegistersFramesInOrder()
+  {
+    ConfigureForGenerate(frameRegHelper);
+
+    auto recorder = FrameMappingEventRecorder::New();
+    frameRegHelper->AddObserver(mitk::FrameMappingEvent(), recorder);
+
+    CheckRegisteredImage(frameRegHelper->GetRegisteredImage());
+
+    std::vector<std::string> expectedComments = { "Mapped frame #1", "Mapped frame #3", "Mapped frame #4" };
+    CPPUNIT_ASSERT_MESSAGE("Frames are mapped in their order", expectedComments == recorder->m_Comments);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, frameRegHelper->GetProgress(), 1e-6);
+  }
+
+  void Generate_Concurrent_EqualsSequential()
+  {
+    ConfigureForGenerate(frameRegHelper);
+    mitk::Image::Pointer sequentialResult = frameRegHelper->GetRegisteredImage();
+
+    auto concurrentHelper = ClonableFramesRegistrationHelper::New();
+    ConfigureForGenerate(concurrentHelper);
+    concurrentHelper->SetMaximumNumberOfConcurrentFrames(4);
+
+    auto recorder = FrameMappingEventRecorder::New();
+    concurrentHelper->AddObserver(mitk::FrameMappingEvent(), recorder);
+
+    mitk::Image::Pointer concurrentResult = concurrentHelper->GetRegisteredImage();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("One algorithm instance per registered frame", 2u, concurrentHelper->GetNumberOfClones());
+    CheckRegisteredImage(concurrentResult);
+
+    mitk::ImageReadAccessor sequentialAccessor(sequentialResult);
+    mitk::ImageReadAccessor concurrentAccessor(concurrentResult);
+    const auto *sequentialData = static_cast<const float *>(sequentialAccessor.GetData());
+    const auto *concurrentData = static_cast<const float *>(concurrentAccessor.GetData());
+    CPPUNIT_ASSERT(std::equal(sequentialData, sequentialData + NumberOfFrames * NumberOfFrameVoxels, concurrentData));
+
+    std::sort(recorder->m_Comments.begin(), recorder->m_Comments.end());
+    std::vector<std::string> expectedComments = { "Mapped frame #1", "Mapped frame #3", "Mapped frame #4" };
+    CPPUNIT_ASSERT_MESSAGE("Each frame is mapped once", expectedComments == recorder->m_Comments);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, concurrentHelper->GetProgress(), 1e-6);
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkTimeFramesRegistrationHelper)
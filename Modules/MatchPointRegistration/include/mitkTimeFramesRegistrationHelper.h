@@ -24,6 +24,8 @@ found in the LICENSE file.
 
 #include "MitkMatchPointRegistrationExports.h"
 
+#include <atomic>
+
 namespace mitk
 {
 
@@ -35,6 +37,7 @@ namespace mitk
    * to the first frame of the image. The user can define frames that may be not registered. These frames will be copied directly.
    * Per default all frames will be registered.
    * The user may set a mask for the target frame (1st frame). If this mask image has mulitple time steps, the first time step will be used.
+   * Frames are registered independently of each other, so several frames are processed concurrently (see SetMaximumNumberOfConcurrentFrames()).
    * The helper class invokes three eventtypes: \n
    * - mitk::FrameRegistrationEvent: when ever a frame was registered.
    * - mitk::FrameMappingEvent: when ever a frame was mapped registered.
@@ -78,6 +81,22 @@ namespace mitk
     itkSetMacro(InterpolatorType, mitk::ImageMappingInterpolator::Type);
     itkGetConstMacro(InterpolatorType, mitk::ImageMappingInterpolator::Type);
 
+    /** Maximum number of frames that are registered and mapped at the same time. Each of them needs its own
+    * instance of the algorithm (see CloneAlgorithm()) and keeps its moving, target and mapped frame in memory,
+    * so the value bounds the memory consumption. 0: one frame per processor core; 1 (default): sequential processing.
+    * Observers of the algorithm only get the events of the frames that are processed by the algorithm itself, so
+    * concurrent processing has to be requested explicitly.*/
+    itkSetMacro(MaximumNumberOfConcurrentFrames, unsigned int);
+    itkGetConstMacro(MaximumNumberOfConcurrentFrames, unsigned int);
+
+    /** If set, a frame is first mapped with the registration of the previously processed frame and only the remaining
+    * motion is registered. Both registrations are combined before the frame is mapped, so it is interpolated only once.
+    * Frames that are processed concurrently are split into contiguous blocks; the first frame of each block is
+    * registered without initialization. Only supported for 2D and 3D frames. Default: false.*/
+    itkSetMacro(InitializeByNeighborFrame, bool);
+    itkGetConstMacro(InitializeByNeighborFrame, bool);
+    itkBooleanMacro(InitializeByNeighborFrame);
+
     /** cleares the ignore list. Therefore all frames will be processed.*/
     void ClearIgnoreList();
     void SetIgnoreList(const IgnoreListType& il);
@@ -110,6 +129,8 @@ namespace mitk
       m_AllowUnregPixels(true),
       m_ErrorValue(0),
       m_InterpolatorType(mitk::ImageMappingInterpolator::Linear),
+      m_MaximumNumberOfConcurrentFrames(1),
+      m_InitializeByNeighborFrame(false),
       m_Progress(0)
     {
       m_4DImage = nullptr;
@@ -119,7 +140,7 @@ namespace mitk
 
     ~TimeFramesRegistrationHelper() override {};
 
-    RegistrationPointer DoFrameRegistration(const mitk::Image* movingFrame,
+    RegistrationPointer DoFrameRegistration(RegistrationAlgorithmBaseType* algorithm, const mitk::Image* movingFrame,
                                             const mitk::Image* targetFrame, const mitk::Image* targetMask) const;
 
     mitk::Image::Pointer DoFrameMapping(const mitk::Image* movingFrame, const RegistrationType* reg,
@@ -132,6 +153,17 @@ namespace mitk
 
     mitk::Image::Pointer GetFrameImage(const mitk::Image* image, mitk::TimePointType timePoint) const;
 
+    /** Creates an additional instance of the algorithm with the same configuration, which is copied via the meta
+    * properties of the algorithm. Returns nullptr if the algorithm cannot be cloned; the frames are then
+    * processed sequentially with the algorithm itself.
+    * Only the configuration that is accessible as meta property is copied:
+    * - Read-only properties are not copied; they describe the state of the algorithm (e.g. the current iteration).
+    * - If a writable property cannot be read or set, nullptr is returned, because the clone would be configured differently.
+    * - Observers of the algorithm are not copied; the clone does not invoke events to them.
+    * - Any configuration that is not exposed as meta property (e.g. a set optimizer instance) is not copied.
+    * Derived classes can override the method for algorithms that need another way of cloning.*/
+    virtual RegistrationAlgorithmPointer CloneAlgorithm() const;
+
     RegistrationAlgorithmPointer m_Algorithm;
 
   private:
@@ -152,7 +184,10 @@ namespace mitk
     /** Type of interpolator. Only relevant for images and if m_doGeometryRefinement is false. */
     mitk::ImageMappingInterpolator::Type m_InterpolatorType;
 
-    double m_Progress;
+    unsigned int m_MaximumNumberOfConcurrentFrames;
+    bool m_InitializeByNeighborFrame;
+
+    std::atomic<double> m_Progress;
   };
 
 }
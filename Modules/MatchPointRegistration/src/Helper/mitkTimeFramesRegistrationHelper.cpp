@@ -19,6 +19,16 @@ found in the LICENSE file.
 #include <mitkMaskedAlgorithmHelper.h>
 #include <mitkMAPAlgorithmHelper.h>
 
+#include <mapMetaPropertyAlgorithmInterface.h>
+#include <mapRegistration.h>
+#include <mapRegistrationCombinator.h>
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 mitk::Image::Pointer
 mitk::TimeFramesRegistrationHelper::GetFrameImage(const mitk::Image* image,
     mitk::TimePointType timePoint) const
@@ -32,6 +42,34 @@ mitk::TimeFramesRegistrationHelper::GetFrameImage(const mitk::Image* image,
   return frameImage;
 };
 
+namespace
+{
+  template <unsigned int VDimension>
+  mitk::TimeFramesRegistrationHelper::RegistrationPointer CombineRegistrations(const ::map::core::RegistrationBase* first,
+    const ::map::core::RegistrationBase* second)
+  {
+    typedef ::map::core::Registration<VDimension, VDimension> ConcreteRegistrationType;
+    typedef ::map::core::RegistrationCombinator<ConcreteRegistrationType, ConcreteRegistrationType> CombinatorType;
+
+    const auto* castedFirst = dynamic_cast<const ConcreteRegistrationType*>(first);
+    const auto* castedSecond = dynamic_cast<const ConcreteRegistrationType*>(second);
+
+    if (nullptr == castedFirst || nullptr == castedSecond)
+    {
+      mitkThrow() << "Cannot combine frame registrations. Registrations have an unexpected type.";
+    }
+
+    typename CombinatorType::Pointer combinator = CombinatorType::New();
+    return combinator->process(*castedFirst, *castedSecond).GetPointer();
+  }
+
+  bool CanCombineRegistration(const ::map::core::RegistrationBase* registration)
+  {
+    return registration->getMovingDimensions() == registration->getTargetDimensions() &&
+      (registration->getTargetDimensions() == 2 || registration->getTargetDimensions() == 3);
+  }
+}
+
 void
 mitk::TimeFramesRegistrationHelper::Generate()
 {
@@ -40,8 +78,6 @@ mitk::TimeFramesRegistrationHelper::Generate()
   //prepare processing
   mitk::Image::Pointer targetFrame = GetFrameImage(this->m_4DImage, 0);
 
-  this->m_Registered4DImage = this->m_4DImage->Clone();
-
   Image::ConstPointer mask;
 
   if (m_TargetMask.IsNotNull())
@@ -59,48 +95,193 @@ mitk::TimeFramesRegistrationHelper::Generate()
   double progressDelta = 1.0 / ((this->m_4DImage->GetTimeSteps() - 1) * 3.0);
   m_Progress = 0.0;
 
-  //process the frames
-  for (unsigned int i = 1; i < this->m_4DImage->GetTimeSteps(); ++i)
-  {
-    Image::Pointer movingFrame = GetFrameImage(this->m_4DImage, i);
-    Image::Pointer mappedFrame;
+  //The result is only initialized with the frames that are not registered. The mapped frames
+  //are written into their volume as soon as they are available.
+  this->m_Registered4DImage = mitk::Image::New();
+  this->m_Registered4DImage->Initialize(this->m_4DImage);
+  this->m_Registered4DImage->SetPropertyList(this->m_4DImage->GetPropertyList()->Clone());
 
-    IgnoreListType::iterator finding = std::find(m_IgnoreList.begin(), m_IgnoreList.end(), i);
+  std::vector<mitk::TimeStepType> framesToRegister;
 
+  for (unsigned int i = 0; i < this->m_4DImage->GetTimeSteps(); ++i)
+  {
+    auto finding = std::find(m_IgnoreList.cbegin(), m_IgnoreList.cend(), i);
 
-    if (finding == m_IgnoreList.end())
+    if (i > 0 && finding == m_IgnoreList.cend())
     {
-      //frame should be processed
-      RegistrationPointer reg = DoFrameRegistration(movingFrame, targetFrame, mask);
+      framesToRegister.push_back(i);
+    }
+    else
+    {
+      mitk::ImageReadAccessor accessor(this->m_4DImage, this->m_4DImage->GetVolumeData(i));
+      this->m_Registered4DImage->SetVolume(accessor.GetData(), i);
 
-      m_Progress += progressDelta;
-      this->InvokeEvent(::mitk::FrameRegistrationEvent(nullptr,
-                        "Registred frame #" +::map::core::convert::toStr(i)));
+      if (i > 0)
+      {
+        m_Progress = m_Progress + 3 * progressDelta;
+        this->InvokeEvent(::itk::ProgressEvent());
+      }
+    }
+  }
 
-      mappedFrame = DoFrameMapping(movingFrame, reg, targetFrame);
+  if (framesToRegister.empty())
+  {
+    return;
+  }
 
-      m_Progress += progressDelta;
-      this->InvokeEvent(::mitk::FrameMappingEvent(nullptr,
-                        "Mapped frame #" + ::map::core::convert::toStr(i)));
+  //every concurrently processed frame needs its own algorithm instance
+  unsigned int numberOfWorkers = m_MaximumNumberOfConcurrentFrames;
+  if (0 == numberOfWorkers)
+  {
+    numberOfWorkers = std::max(1u, std::thread::hardware_concurrency());
+  }
+  numberOfWorkers = std::min<unsigned int>(numberOfWorkers, framesToRegister.size());
 
-      mitk::ImageReadAccessor accessor(mappedFrame, mappedFrame->GetVolumeData(0, 0, nullptr,
-                                       mitk::Image::ReferenceMemory));
+  std::vector<RegistrationAlgorithmPointer> algorithms = { m_Algorithm };
+  while (algorithms.size() < numberOfWorkers)
+  {
+    auto clonedAlgorithm = this->CloneAlgorithm();
+    if (clonedAlgorithm.IsNull())
+    {
+      MITK_WARN << "Registration algorithm cannot be cloned. Frames are registered with " << algorithms.size()
+                << " instead of " << numberOfWorkers << " concurrent algorithm instance(s).";
+      break;
+    }
+    algorithms.push_back(clonedAlgorithm);
+  }
+  numberOfWorkers = algorithms.size();
 
+  //If frames are initialized by their neighbor, each worker processes a contiguous block of frames.
+  //Otherwise the frames are distributed alternately to balance the load.
+  std::vector<std::vector<mitk::TimeStepType>> workerFrames(numberOfWorkers);
+  for (std::size_t pos = 0; pos < framesToRegister.size(); ++pos)
+  {
+    auto workerIndex = m_InitializeByNeighborFrame ? (pos * numberOfWorkers) / framesToRegister.size() : pos % numberOfWorkers;
+    workerFrames[workerIndex].push_back(framesToRegister[pos]);
+  }
 
-      this->m_Registered4DImage->SetVolume(accessor.GetData(), i);
-      this->m_Registered4DImage->GetTimeGeometry()->SetTimeStepGeometry(mappedFrame->GetGeometry(), i);
+  //guards the frame extraction from the input images, the write access to the result, progress and events
+  std::mutex mutex;
+  std::exception_ptr workerException;
+  std::atomic_bool cancelled(false);
 
-      m_Progress += progressDelta;
+  auto processFrames = [&](unsigned int workerIndex)
+  {
+    try
+    {
+      //MITK images are converted to ITK while registering, so each worker uses its own copy of target and mask
+      Image::Pointer workerTargetFrame;
+      Image::ConstPointer workerMask;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        workerTargetFrame = targetFrame->Clone();
+        if (mask.IsNotNull())
+        {
+          workerMask = mask->Clone().GetPointer();
+        }
+      }
+
+      RegistrationPointer neighborReg;
+
+      for (auto i : workerFrames[workerIndex])
+      {
+        if (cancelled)
+        {
+          return;
+        }
+
+        Image::Pointer movingFrame;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          movingFrame = GetFrameImage(this->m_4DImage, i);
+        }
+
+        //frame should be processed
+        RegistrationPointer reg;
+        if (m_InitializeByNeighborFrame && neighborReg.IsNotNull() && CanCombineRegistration(neighborReg))
+        {
+          Image::Pointer preMappedFrame = mitk::ImageMappingHelper::map(movingFrame, neighborReg, false, m_PaddingValue,
+                                            workerTargetFrame->GetGeometry(), false, m_ErrorValue, m_InterpolatorType);
+          RegistrationPointer residualReg = DoFrameRegistration(algorithms[workerIndex], preMappedFrame, workerTargetFrame, workerMask);
+
+          if (2 == neighborReg->getTargetDimensions())
+          {
+            reg = CombineRegistrations<2>(neighborReg, residualReg);
+          }
+          else
+          {
+            reg = CombineRegistrations<3>(neighborReg, residualReg);
+          }
+        }
+        else
+        {
+          reg = DoFrameRegistration(algorithms[workerIndex], movingFrame, workerTargetFrame, workerMask);
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          m_Progress = m_Progress + progressDelta;
+          this->InvokeEvent(::mitk::FrameRegistrationEvent(nullptr,
+                            "Registred frame #" +::map::core::convert::toStr(i)));
+        }
+
+        Image::Pointer mappedFrame = DoFrameMapping(movingFrame, reg, workerTargetFrame);
+
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          m_Progress = m_Progress + progressDelta;
+          this->InvokeEvent(::mitk::FrameMappingEvent(nullptr,
+                            "Mapped frame #" + ::map::core::convert::toStr(i)));
+
+          mitk::ImageReadAccessor accessor(mappedFrame, mappedFrame->GetVolumeData(0, 0, nullptr,
+                                           mitk::Image::ReferenceMemory));
+
+          this->m_Registered4DImage->SetVolume(accessor.GetData(), i);
+          this->m_Registered4DImage->GetTimeGeometry()->SetTimeStepGeometry(mappedFrame->GetGeometry(), i);
+
+          m_Progress = m_Progress + progressDelta;
+          this->InvokeEvent(::itk::ProgressEvent());
+        }
+
+        neighborReg = reg;
+      }
     }
-    else
+    catch (...)
     {
-      m_Progress += 3 * progressDelta;
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!workerException)
+      {
+        workerException = std::current_exception();
+      }
+      cancelled = true;
     }
+  };
 
-    this->InvokeEvent(::itk::ProgressEvent());
+  if (1 == numberOfWorkers)
+  {
+    processFrames(0);
+  }
+  else
+  {
+    std::vector<std::thread> threads;
+    threads.reserve(numberOfWorkers);
 
+    for (unsigned int workerIndex = 0; workerIndex < numberOfWorkers; ++workerIndex)
+    {
+      threads.emplace_back(processFrames, workerIndex);
+    }
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
   }
 
+  if (workerException)
+  {
+    this->m_Registered4DImage = nullptr;
+    std::rethrow_exception(workerException);
+  }
 };
 
 mitk::Image::Pointer
@@ -131,22 +312,68 @@ mitk::TimeFramesRegistrationHelper::ClearIgnoreList()
 
 
 mitk::TimeFramesRegistrationHelper::RegistrationPointer
-mitk::TimeFramesRegistrationHelper::DoFrameRegistration(const mitk::Image* movingFrame,
-    const mitk::Image* targetFrame, const mitk::Image* targetMask) const
+mitk::TimeFramesRegistrationHelper::DoFrameRegistration(RegistrationAlgorithmBaseType* algorithm,
+    const mitk::Image* movingFrame, const mitk::Image* targetFrame, const mitk::Image* targetMask) const
 {
-  mitk::MAPAlgorithmHelper algHelper(m_Algorithm);
+  mitk::MAPAlgorithmHelper algHelper(algorithm);
   algHelper.SetAllowImageCasting(true);
   algHelper.SetData(movingFrame, targetFrame);
 
   if (targetMask)
   {
-    mitk::MaskedAlgorithmHelper maskHelper(m_Algorithm);
+    mitk::MaskedAlgorithmHelper maskHelper(algorithm);
     maskHelper.SetMasks(nullptr, targetMask);
   }
 
   return algHelper.GetRegistration();
 };
 
+mitk::TimeFramesRegistrationHelper::RegistrationAlgorithmPointer
+mitk::TimeFramesRegistrationHelper::CloneAlgorithm() const
+{
+  auto* metaInterface = dynamic_cast<::map::algorithm::facet::MetaPropertyAlgorithmInterface*>(m_Algorithm.GetPointer());
+
+  if (nullptr == metaInterface)
+  {
+    return nullptr;
+  }
+
+  ::itk::LightObject::Pointer anotherObject = m_Algorithm->CreateAnother();
+  RegistrationAlgorithmPointer clone = dynamic_cast<RegistrationAlgorithmBaseType*>(anotherObject.GetPointer());
+  auto* cloneMetaInterface = dynamic_cast<::map::algorithm::facet::MetaPropertyAlgorithmInterface*>(clone.GetPointer());
+
+  if (nullptr == cloneMetaInterface)
+  {
+    return nullptr;
+  }
+
+  //Read-only properties are the state of the algorithm and are skipped. Every writable property is part of the
+  //configuration; if it cannot be copied, the clone would behave differently, so the algorithm is not cloned.
+  for (const auto& info : metaInterface->getPropertyInfos())
+  {
+    if (!info->isWritable())
+    {
+      continue;
+    }
+
+    if (!info->isReadable())
+    {
+      MITK_WARN << "Registration algorithm cannot be cloned. Property \"" << info->getName() << "\" is not readable.";
+      return nullptr;
+    }
+
+    auto property = metaInterface->getProperty(info);
+
+    if (property.IsNull() || !cloneMetaInterface->setProperty(info, property))
+    {
+      MITK_WARN << "Registration algorithm cannot be cloned. Property \"" << info->getName() << "\" cannot be copied.";
+      return nullptr;
+    }
+  }
+
+  return clone;
+};
+
 mitk::Image::Pointer mitk::TimeFramesRegistrationHelper::DoFrameMapping(
   const mitk::Image* movingFrame, const RegistrationType* reg, const mitk::Image* targetFrame) const
 {
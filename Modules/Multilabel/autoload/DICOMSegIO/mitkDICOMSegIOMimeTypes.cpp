@@ -13,8 +13,7 @@ found in the LICENSE file.
 #include "mitkDICOMSegIOMimeTypes.h"
 #include "mitkIOMimeTypes.h"
 
-#include <array>
-
+#include <mitkFileProbe.h>
 #include <mitkLog.h>
 
 #include <itkGDCMImageIO.h>
@@ -58,38 +57,31 @@ namespace mitk
     }
     // end fix for bug 18572
 
-    const std::size_t offset = 128;
-    const std::size_t bufferSize = 4;
-
-    std::ifstream myfile(path, std::ifstream::binary);
-
-    if (!myfile.is_open())
-      return false;
-
-    myfile.seekg(0, std::ifstream::end);
-    const auto fileSize = static_cast<std::size_t>(myfile.tellg());
-
-    if (fileSize < offset + bufferSize)
+    auto probe = FileProbe::Get(path);
+    if (!probe->IsDicom())
       return false;
 
-    myfile.seekg(offset);
-    std::array<char, bufferSize> buffer;
-    myfile.read(buffer.data(), bufferSize);
+    if (!canRead)
+    {
+      return canRead;
+    }
 
-    if (0 != std::string(buffer.data(), bufferSize).compare("DICM"))
-      return false;
+    // Modality and SOP class are usually found in the shared header of the file
+    std::string probedModality;
+    std::string probedSOPClassUID;
+    if (probe->FindDicomElement(0x0008, 0x0016, probedSOPClassUID) &&
+        probe->FindDicomElement(0x0008, 0x0060, probedModality) && !probedModality.empty() &&
+        !probedSOPClassUID.empty())
+    {
+      return probedModality == "SEG" && probedSOPClassUID == "1.2.840.10008.5.1.4.1.1.66.4";
+    }
 
     DcmFileFormat dcmFileFormat;
     OFCondition status = dcmFileFormat.loadFile(path.c_str());
 
     if (status.bad())
     {
-      canRead = false;
-    }
-
-    if (!canRead)
-    {
-      return canRead;
+      return false;
     }
 
     OFString modality;
@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include <mitkDICOMDCMTKTagScanner.h>
 #include <mitkDICOMIOHelper.h>
 #include <mitkDICOMProperty.h>
+#include <mitkFileProbe.h>
 #include <mitkIDICOMTagsOfInterest.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
@@ -245,6 +246,10 @@ namespace mitk
 
     const std::string fileName = this->GetLocalFileName();
 
+    std::string probedModality;
+    if (FileProbe::Get(fileName)->FindDicomElement(0x0008, 0x0060, probedModality) && !probedModality.empty())
+      return probedModality == "SEG" ? Supported : Unsupported;
+
     DcmFileFormat dcmFileFormat;
     OFCondition status = dcmFileFormat.loadFile(fileName.c_str());
 
@@ -23,6 +23,7 @@ found in the LICENSE file.
 #include <mitkArbitraryTimeGeometry.h>
 #include <mitkIPropertyPersistence.h>
 #include <mitkCoreServices.h>
+#include <mitkFileProbe.h>
 #include <mitkItkImageIO.h>
 #include <mitkUIDManipulator.h>
 
@@ -65,6 +66,11 @@ namespace mitk
     if (AbstractFileReader::GetConfidenceLevel() == Unsupported)
       return Unsupported;
     const std::string fileName = this->GetLocalFileName();
+
+    auto probe = FileProbe::Get(fileName);
+    if (probe->HeaderStartsWith("NRRD") && probe->ExcludesText("org.mitk.image.multilabel", "\n\n"))
+      return Unsupported;
+
     itk::NrrdImageIO::Pointer io = itk::NrrdImageIO::New();
     io->SetFileName(fileName);
     io->ReadImageInformation();
@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include <mitkArbitraryTimeGeometry.h>
 #include <mitkIPropertyPersistence.h>
 #include <mitkCoreServices.h>
+#include <mitkFileProbe.h>
 #include <mitkItkImageIO.h>
 #include <mitkUIDManipulator.h>
 
@@ -111,12 +112,8 @@ namespace mitk
       // Handle UID
       itk::EncapsulateMetaData<std::string>(nrrdImageIo->GetMetaDataDictionary(), PROPERTY_KEY_UID, input->GetUID());
 
-      // use compression if available
-      nrrdImageIo->UseCompressionOn();
-      nrrdImageIo->SetFileName(path);
-
       ImageReadAccessor imageAccess(inputVector);
-      nrrdImageIo->Write(imageAccess.GetData());
+      ItkImageIO::WriteImageIO(nrrdImageIo, imageAccess.GetData(), path);
     }
     catch (const std::exception &e)
     {
@@ -129,6 +126,12 @@ namespace mitk
     if (AbstractFileIO::GetReaderConfidenceLevel() == Unsupported)
       return Unsupported;
     const std::string fileName = this->GetLocalFileName();
+
+    // Every NRRD file is offered to this reader, rule out plain images on the shared header
+    auto probe = FileProbe::Get(fileName);
+    if (probe->HeaderStartsWith("NRRD") && probe->ExcludesText(MULTILABEL_SEGMENTATION_MODALITY_VALUE, "\n\n"))
+      return Unsupported;
+
     itk::NrrdImageIO::Pointer io = itk::NrrdImageIO::New();
     io->SetFileName(fileName);
     io->ReadImageInformation();
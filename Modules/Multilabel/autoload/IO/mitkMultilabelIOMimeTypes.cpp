@@ -11,6 +11,7 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkMultilabelIOMimeTypes.h"
+#include <mitkFileProbe.h>
 #include <mitkIOMimeTypes.h>
 #include <mitkLog.h>
 #include <filesystem>
@@ -90,36 +91,40 @@ bool mitk::MitkMultilabelIOMimeTypes::LegacyLabelSetMimeType::AppliesTo(const st
     return false;
   }
 
-  std::string value("");
-  try
-  {
-    std::ifstream file(path);
-
-    if (!file.is_open())
-      return false;
-
-    itk::NrrdImageIO::Pointer io = itk::NrrdImageIO::New();
-    io->SetFileName(path);
-    io->ReadImageInformation();
-
-    itk::MetaDataDictionary imgMetaDataDictionary = io->GetMetaDataDictionary();
-    itk::ExposeMetaData<std::string>(imgMetaDataDictionary, "modality", value);
-  }
-  catch(const std::exception& e)
-  {
-    MITK_DEBUG << "Error while try to anylize NRRD file for LegacyLabelSetMimeType. File: " << path <<"; Error: " << e.what();
-  }
-  catch(...)
-  {
-    MITK_DEBUG << "Unkown error while try to anylize NRRD file for LegacyLabelSetMimeType. File: " << path;
-  }
-
-  if (value.compare("org.mitk.image.multilabel") != 0)
+  // Most NRRD files can be ruled out on the shared header without parsing them
+  auto probe = FileProbe::Get(path);
+  if (probe->HeaderStartsWith("NRRD") && probe->ExcludesText("org.mitk.image.multilabel", "\n\n"))
   {
     return false;
   }
 
-  return true;
+  return probe->Evaluate("mitk::MitkMultilabelIOMimeTypes::LegacyLabelSetMimeType", [&path]() {
+    std::string value("");
+    try
+    {
+      std::ifstream file(path);
+
+      if (!file.is_open())
+        return false;
+
+      itk::NrrdImageIO::Pointer io = itk::NrrdImageIO::New();
+      io->SetFileName(path);
+      io->ReadImageInformation();
+
+      itk::MetaDataDictionary imgMetaDataDictionary = io->GetMetaDataDictionary();
+      itk::ExposeMetaData<std::string>(imgMetaDataDictionary, "modality", value);
+    }
+    catch(const std::exception& e)
+    {
+      MITK_DEBUG << "Error while try to anylize NRRD file for LegacyLabelSetMimeType. File: " << path <<"; Error: " << e.what();
+    }
+    catch(...)
+    {
+      MITK_DEBUG << "Unkown error while try to anylize NRRD file for LegacyLabelSetMimeType. File: " << path;
+    }
+
+    return value.compare("org.mitk.image.multilabel") == 0;
+  });
 }
 
 mitk::MitkMultilabelIOMimeTypes::LegacyLabelSetMimeType* mitk::MitkMultilabelIOMimeTypes::LegacyLabelSetMimeType::Clone() const
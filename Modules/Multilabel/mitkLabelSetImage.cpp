@@ -1480,7 +1480,14 @@ void mitk::TransferLabelContentAtTimeStep(
     AccessFixedPixelTypeByItk_n(sourceImageAtTimeStep, TransferLabelContentAtTimeStepHelper, (Label::PixelType), (destinationImageAtTimeStep, destinationLabelSet, sourceBackground, destinationBackground, destinationBackgroundLocked, sourceLabel, newDestinationLabel, mergeStyle, overwriteStlye));
     destinationLabelSet->ModifyLabelEvent.Send(newDestinationLabel);
   }
-  destinationImage->Modified();
+
+  // only the requested time step was changed
+  itk::ImageRegion<3> volumeRegion;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    volumeRegion.SetSize(i, destinationImage->GetDimension(i));
+  }
+  destinationImage->RegionModified(volumeRegion, timeStep);
 }
 
 void mitk::TransferLabelContent(
@@ -521,8 +521,16 @@ void mitk::LabelSetImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
 
   // check if something important has changed and we need to re-render
 
-  if ((localStorage->m_LastDataUpdateTime < image->GetMTime()) ||
-      (localStorage->m_LastDataUpdateTime < image->GetPipelineMTime()) ||
+  // writers that announce the modified region of the image (see Image::RegionModified())
+  // do not require reslicing views that are far away from it. A modified source is not
+  // covered by the regions of the image, so it always requires reslicing.
+  const bool isDataModified = (localStorage->m_LastDataUpdateTime < image->GetPipelineMTime()) ||
+                              ((localStorage->m_LastDataUpdateTime < image->GetMTime()) &&
+                               image->IsModifiedNearPlaneSince(localStorage->m_LastDataUpdateTime,
+                                                               this->GetTimestep(),
+                                                               renderer->GetCurrentWorldPlaneGeometry()));
+
+  if (isDataModified ||
       (localStorage->m_LastDataUpdateTime < renderer->GetCurrentWorldPlaneGeometryUpdateTime()) ||
       (localStorage->m_LastDataUpdateTime < renderer->GetCurrentWorldPlaneGeometry()->GetMTime()))
   {
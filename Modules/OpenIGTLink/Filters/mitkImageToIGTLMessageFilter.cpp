@@ -15,6 +15,86 @@ found in the LICENSE file.
 #include "itkByteSwapper.h"
 #include "igtlImageMessage.h"
 
+#include <atomic>
+
+/**
+ * \brief Image message of the pool of an ImageToIGTLMessageFilter.
+ *
+ * The filter acquires the message by setting the in-use flag. The flag is
+ * released when the last reference besides the one of the pool is dropped,
+ * i.e. when the message is neither an output nor queued for sending anymore.
+ * The references are counted once more in an atomic counter, so that the
+ * drop from two references to one is detected in the same step as the
+ * decrement, even if the filter takes a reference concurrently.
+ */
+class mitk::ImageToIGTLMessageFilter::PooledImageMessage : public igtl::ImageMessage
+{
+public:
+  igtlTypeMacro(mitk::ImageToIGTLMessageFilter::PooledImageMessage, igtl::ImageMessage);
+  igtlNewMacro(mitk::ImageToIGTLMessageFilter::PooledImageMessage);
+
+  bool TryAcquire()
+  {
+    bool expected = false;
+    return m_InUse.compare_exchange_strong(expected, true, std::memory_order_acquire);
+  }
+
+  /** \brief Called by the pool after it took its reference. */
+  void Attach() { m_Pooled = true; }
+
+  /** \brief Called by the pool before it drops its reference, no release is tracked afterwards. */
+  void Detach() { m_Pooled = false; }
+
+  void Register() const override
+  {
+    igtl::ImageMessage::Register();
+    m_ReferenceCount.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void UnRegister() const override
+  {
+    // only the pool refers to the message after this reference is dropped
+    if (m_ReferenceCount.fetch_sub(1, std::memory_order_acq_rel) == 2 && m_Pooled)
+      m_InUse.store(false, std::memory_order_release);
+
+    igtl::ImageMessage::UnRegister();
+  }
+
+protected:
+  PooledImageMessage() : m_InUse(true), m_Pooled(false), m_ReferenceCount(1) {}
+  ~PooledImageMessage() override = default;
+
+private:
+  mutable std::atomic<bool> m_InUse;
+  std::atomic<bool> m_Pooled;
+  mutable std::atomic<int> m_ReferenceCount;
+};
+
+namespace
+{
+  /**
+   * \brief Copies the pixels into the little endian pack of a message in a
+   * single pass. On little endian hosts, this is a plain memcpy.
+   */
+  template <typename T>
+  void CopyToLittleEndian(const void* in, void* out, std::size_t numberOfScalars)
+  {
+    if (itk::ByteSwapper<T>::SystemIsLittleEndian())
+    {
+      memcpy(out, in, numberOfScalars * sizeof(T));
+      return;
+    }
+
+    const auto* inScalars = static_cast<const T*>(in);
+    auto* outScalars = static_cast<T*>(out);
+    for (std::size_t i = 0; i < numberOfScalars; ++i)
+    {
+      outScalars[i] = inScalars[i];
+      itk::ByteSwapper<T>::SwapFromSystemToLittleEndian(&outScalars[i]);
+    }
+  }
+}
+
 mitk::ImageToIGTLMessageFilter::ImageToIGTLMessageFilter()
 {
   mitk::IGTLMessage::Pointer output = mitk::IGTLMessage::New();
@@ -23,6 +103,12 @@ mitk::ImageToIGTLMessageFilter::ImageToIGTLMessageFilter()
   this->SetNumberOfRequiredInputs(1);
 }
 
+mitk::ImageToIGTLMessageFilter::~ImageToIGTLMessageFilter()
+{
+  for (auto& pooledMessage : m_MessagePool)
+    pooledMessage->Detach();
+}
+
 void mitk::ImageToIGTLMessageFilter::GenerateData()
 {
   // MITK_INFO << "ImageToIGTLMessageFilter.GenerateData()";
@@ -52,7 +138,7 @@ void mitk::ImageToIGTLMessageFilter::GenerateData()
       continue;
     }
 
-    igtl::ImageMessage::Pointer imgMsg = igtl::ImageMessage::New();
+    igtl::ImageMessage::Pointer imgMsg = this->AcquireImageMessage();
 
     // TODO: Which kind of coordinate system does MITK really use?
     imgMsg->SetCoordinateSystem(igtl::ImageMessage::COORDINATE_RAS);
@@ -142,58 +228,54 @@ void mitk::ImageToIGTLMessageFilter::GenerateData()
     }
     imgMsg->SetDimensions(sizes);
 
-    // Allocate and copy data.
+    // Allocate and copy data. The pack of a recycled message is only
+    // reallocated if its size changed. OpenIGTLink sends the pack as one
+    // contiguous buffer, therefore the pixels are copied once, and swapped
+    // to little endian in the same pass if necessary.
     imgMsg->AllocatePack();
     imgMsg->AllocateScalars();
 
     size_t num_pixel = sizes[0] * sizes[1] * sizes[2];
+    size_t num_scalars = num_pixel * type.GetNumberOfComponents();
     void* out = imgMsg->GetScalarPointer();
+
     {
       // Scoped, so that readAccess will be released ASAP.
       mitk::ImageReadAccessor readAccess(img, img->GetChannelData(0));
       const void* in = readAccess.GetData();
 
-      memcpy(out, in, num_pixel * type.GetSize());
-    }
-
-    // We want to byte swap to little endian. We would like to just
-    // swap by number of bytes for each component, but itk::ByteSwapper
-    // is templated over element type, not over element size. So we need to
-    // switch on the size and use types of the same size.
-    size_t num_scalars = num_pixel * type.GetNumberOfComponents();
-    switch (type.GetComponentType())
-    {
-    case itk::IOComponentEnum::CHAR:
-    case itk::IOComponentEnum::UCHAR:
-      // No endian conversion necessary, because a char is exactly one byte!
-      break;
-    case itk::IOComponentEnum::SHORT:
-    case itk::IOComponentEnum::USHORT:
-      itk::ByteSwapper<short>::SwapRangeFromSystemToLittleEndian((short*)out,
-        num_scalars);
-      break;
-    case itk::IOComponentEnum::INT:
-    case itk::IOComponentEnum::UINT:
-      itk::ByteSwapper<int>::SwapRangeFromSystemToLittleEndian((int*)out,
-        num_scalars);
-      break;
-    case itk::IOComponentEnum::LONG:
-    case itk::IOComponentEnum::ULONG:
-      itk::ByteSwapper<long>::SwapRangeFromSystemToLittleEndian((long*)out,
-        num_scalars);
-      break;
-    case itk::IOComponentEnum::FLOAT:
-      itk::ByteSwapper<float>::SwapRangeFromSystemToLittleEndian((float*)out,
-        num_scalars);
-      break;
-    case itk::IOComponentEnum::DOUBLE:
-      itk::ByteSwapper<double>::SwapRangeFromSystemToLittleEndian(
-        (double*)out, num_scalars);
-      break;
-    default:
-      MITK_ERROR << "Can not handle pixel component type "
-        << type.GetComponentType();
-      return;
+      // itk::ByteSwapper is templated over element type, not over element
+      // size. So we need to switch on the size and use types of the same size.
+      switch (type.GetComponentType())
+      {
+      case itk::IOComponentEnum::CHAR:
+      case itk::IOComponentEnum::UCHAR:
+        // No endian conversion necessary, because a char is exactly one byte!
+        memcpy(out, in, num_scalars);
+        break;
+      case itk::IOComponentEnum::SHORT:
+      case itk::IOComponentEnum::USHORT:
+        CopyToLittleEndian<short>(in, out, num_scalars);
+        break;
+      case itk::IOComponentEnum::INT:
+      case itk::IOComponentEnum::UINT:
+        CopyToLittleEndian<int>(in, out, num_scalars);
+        break;
+      case itk::IOComponentEnum::LONG:
+      case itk::IOComponentEnum::ULONG:
+        CopyToLittleEndian<long>(in, out, num_scalars);
+        break;
+      case itk::IOComponentEnum::FLOAT:
+        CopyToLittleEndian<float>(in, out, num_scalars);
+        break;
+      case itk::IOComponentEnum::DOUBLE:
+        CopyToLittleEndian<double>(in, out, num_scalars);
+        break;
+      default:
+        MITK_ERROR << "Can not handle pixel component type "
+          << type.GetComponentType();
+        return;
+      }
     }
 
     //copy timestamp of mitk image
@@ -207,6 +289,27 @@ void mitk::ImageToIGTLMessageFilter::GenerateData()
   }
 }
 
+igtl::ImageMessage::Pointer mitk::ImageToIGTLMessageFilter::AcquireImageMessage()
+{
+  for (const auto& pooledMessage : m_MessagePool)
+  {
+    // take the reference before acquiring, so a concurrent release cannot happen afterwards
+    PooledImageMessage::Pointer candidate = pooledMessage;
+    if (candidate->TryAcquire())
+      return candidate.GetPointer();
+  }
+
+  PooledImageMessage::Pointer message = PooledImageMessage::New();
+
+  if (m_MessagePool.size() < MaximumMessagePoolSize)
+  {
+    m_MessagePool.push_back(message);
+    message->Attach();
+  }
+
+  return message.GetPointer();
+}
+
 void mitk::ImageToIGTLMessageFilter::SetInput(const mitk::Image* img)
 {
   this->ProcessObject::SetNthInput(0, const_cast<mitk::Image*>(img));
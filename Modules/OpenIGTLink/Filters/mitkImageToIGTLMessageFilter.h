@@ -18,12 +18,20 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <mitkImageSource.h>
 
+#include <igtlImageMessage.h>
+
+#include <vector>
+
 namespace mitk
 {
 /**Documentation
  *
  * \brief This filter creates IGTL messages from mitk::Image objects
  *
+ * Image messages are recycled: the filter acquires a message of a small pool,
+ * which is released as soon as it is not referenced anymore by the output or
+ * the send queue of a device. Only released messages are reused.
+ *
  * \ingroup OpenIGTLink
  *
  */
@@ -80,14 +88,28 @@ class MITKOPENIGTLINK_EXPORT ImageToIGTLMessageFilter : public IGTLMessageSource
  protected:
   ImageToIGTLMessageFilter();
 
-  ~ImageToIGTLMessageFilter() override {};
+  ~ImageToIGTLMessageFilter() override;
 
   /**
   * \brief create output objects for all inputs
   */
   virtual void CreateOutputsForAllInputs();
 
+  /**
+  * \brief Returns a message of the pool that is not in use anymore or a new one
+  */
+  igtl::ImageMessage::Pointer AcquireImageMessage();
+
   mitk::ImageSource* m_Upstream;
+
+  class PooledImageMessage;
+
+  /**
+  * \brief Messages reused for consecutive images, see AcquireImageMessage()
+  */
+  std::vector<igtl::SmartPointer<PooledImageMessage>> m_MessagePool;
+
+  static const std::size_t MaximumMessagePoolSize = 4;
 };
 }  // namespace mitk
 
@@ -0,0 +1,176 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+
+#include <mitkIGTLMessageQueue.h>
+
+#include <igtlStringMessage.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+class mitkIGTLMessageQueueTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkIGTLMessageQueueTestSuite);
+  MITK_TEST(Test_NoBufferingMode_KeepsLatestMessage);
+  MITK_TEST(Test_DropOldest_KeepsMaximumDepth);
+  MITK_TEST(Test_Block_DropsNothing);
+  MITK_TEST(Test_Block_TimesOutWithoutConsumer);
+  MITK_TEST(Test_Block_ReleasedByClear);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::IGTLMessageQueue::Pointer m_Queue;
+  std::thread m_Producer;
+
+  igtl::StringMessage::Pointer CreateMessage(int number)
+  {
+    igtl::StringMessage::Pointer message = igtl::StringMessage::New();
+    message->SetString(std::to_string(number));
+    return message;
+  }
+
+  void PushMessages(int count)
+  {
+    for (int i = 0; i < count; ++i)
+      m_Queue->PushMessage(this->CreateMessage(i).GetPointer());
+  }
+
+public:
+  void setUp() override
+  {
+    m_Queue = mitk::IGTLMessageQueue::New();
+  }
+
+  void tearDown() override
+  {
+    // a failed assertion must not leave a joinable thread behind
+    if (m_Producer.joinable())
+    {
+      m_Queue->Clear();
+      m_Producer.join();
+    }
+    m_Queue = nullptr;
+  }
+
+  void Test_NoBufferingMode_KeepsLatestMessage()
+  {
+    m_Queue->EnableNoBufferingMode(true);
+    this->PushMessages(10);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Only one message is buffered", 1, m_Queue->GetSize());
+
+    igtl::StringMessage::Pointer message = m_Queue->PullStringMessage();
+    CPPUNIT_ASSERT_MESSAGE("The latest message is returned", message.IsNotNull() && std::string("9") == message->GetString());
+
+    auto statistics = m_Queue->GetQueueStatistics(mitk::IGTLMessageQueue::StringQueue);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("All messages were counted", std::uint64_t(10), statistics.NumberOfPushed);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Older messages were dropped", std::uint64_t(9), statistics.NumberOfDropped);
+  }
+
+  void Test_DropOldest_KeepsMaximumDepth()
+  {
+    m_Queue->EnableNoBufferingMode(false);
+    m_Queue->SetMaximumDepth(mitk::IGTLMessageQueue::StringQueue, 4);
+    this->PushMessages(10);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("The queue is limited to its maximum depth", 4, m_Queue->GetSize());
+
+    for (int i = 6; i < 10; ++i)
+    {
+      igtl::StringMessage::Pointer message = m_Queue->PullStringMessage();
+      CPPUNIT_ASSERT_MESSAGE("The newest messages are kept in order", std::to_string(i) == message->GetString());
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("The queue is empty", m_Queue->PullStringMessage().IsNull());
+
+    auto statistics = m_Queue->GetQueueStatistics(mitk::IGTLMessageQueue::StringQueue);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Oldest messages were dropped", std::uint64_t(6), statistics.NumberOfDropped);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Maximum depth was recorded", std::size_t(4), statistics.MaximumDepth);
+  }
+
+  void Test_Block_DropsNothing()
+  {
+    const int numberOfMessages = 1000;
+    m_Queue->SetDropPolicy(mitk::IGTLMessageQueue::StringQueue, mitk::IGTLMessageQueue::DropPolicy::Block);
+    m_Queue->SetMaximumDepth(mitk::IGTLMessageQueue::StringQueue, 8);
+
+    m_Queue->SetBlockTimeout(std::chrono::minutes(1));
+
+    m_Producer = std::thread([this, numberOfMessages]() { this->PushMessages(numberOfMessages); });
+
+    int received = 0;
+    while (received < numberOfMessages)
+    {
+      igtl::StringMessage::Pointer message = m_Queue->PullStringMessage();
+      if (message.IsNull())
+      {
+        std::this_thread::yield();
+        continue;
+      }
+      CPPUNIT_ASSERT_MESSAGE("Messages arrive in order", std::to_string(received) == message->GetString());
+      ++received;
+    }
+
+    m_Producer.join();
+
+    auto statistics = m_Queue->GetQueueStatistics(mitk::IGTLMessageQueue::StringQueue);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("No message was dropped", std::uint64_t(0), statistics.NumberOfDropped);
+  }
+
+  void Test_Block_TimesOutWithoutConsumer()
+  {
+    m_Queue->SetDropPolicy(mitk::IGTLMessageQueue::StringQueue, mitk::IGTLMessageQueue::DropPolicy::Block);
+    m_Queue->SetMaximumDepth(mitk::IGTLMessageQueue::StringQueue, 4);
+    m_Queue->SetBlockTimeout(std::chrono::milliseconds(10));
+
+    this->PushMessages(6);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("The queue is limited to its maximum depth", 4, m_Queue->GetSize());
+
+    auto statistics = m_Queue->GetQueueStatistics(mitk::IGTLMessageQueue::StringQueue);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Timed out pushes dropped the oldest messages", std::uint64_t(2), statistics.NumberOfDropped);
+    CPPUNIT_ASSERT_MESSAGE("The oldest remaining message is pulled first", std::string("2") == m_Queue->PullStringMessage()->GetString());
+    m_Queue->PullStringMessage();
+    m_Queue->PullStringMessage();
+    CPPUNIT_ASSERT_MESSAGE("The newest message is kept and pulled last", std::string("5") == m_Queue->PullStringMessage()->GetString());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("All kept messages were pulled", 0, m_Queue->GetSize());
+  }
+
+  void Test_Block_ReleasedByClear()
+  {
+    m_Queue->SetDropPolicy(mitk::IGTLMessageQueue::StringQueue, mitk::IGTLMessageQueue::DropPolicy::Block);
+    m_Queue->SetMaximumDepth(mitk::IGTLMessageQueue::StringQueue, 1);
+    m_Queue->SetBlockTimeout(std::chrono::minutes(1));
+
+    std::atomic<bool> finished(false);
+    m_Producer = std::thread([this, &finished]() {
+      this->PushMessages(2);
+      finished = true;
+    });
+
+    while (m_Queue->GetSize() < 1)
+      std::this_thread::yield();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CPPUNIT_ASSERT_MESSAGE("The producer waits for the consumer", !finished);
+
+    m_Queue->Clear();
+    m_Producer.join();
+
+    CPPUNIT_ASSERT_MESSAGE("The producer was released", finished);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkIGTLMessageQueue)
@@ -29,6 +29,7 @@ class mitkOpenIGTLinkIGTLImageMessageFilterTestSuite : public mitk::TestFixture
   MITK_TEST(TestSmallImage);
   MITK_TEST(TestMediumImage);
   MITK_TEST(TestLargeImage);
+  MITK_TEST(TestMessagePool);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -67,6 +68,33 @@ public:
     Equal_ContentOfIGTLImageMessageAndMitkImage_True(BIG_DIM);
   }
 
+  /**
+  * A message is only reused for the next image after all consumers released it.
+  */
+  void TestMessagePool()
+  {
+    m_TestImage = mitk::ImageGenerator::GenerateGradientImage<short>(SMALL_DIM, SMALL_DIM, 1u);
+    m_ImageToIGTLMessageFilter->SetInput(m_TestImage);
+
+    m_ImageToIGTLMessageFilter->GenerateData();
+    igtl::MessageBase::Pointer firstMessage = m_ImageToIGTLMessageFilter->GetOutput()->GetMessage();
+    const igtl::MessageBase* firstMessagePointer = firstMessage.GetPointer();
+
+    m_ImageToIGTLMessageFilter->GenerateData();
+    igtl::MessageBase::Pointer secondMessage = m_ImageToIGTLMessageFilter->GetOutput()->GetMessage();
+    CPPUNIT_ASSERT_MESSAGE("A message in use is not reused", firstMessagePointer != secondMessage.GetPointer());
+
+    firstMessage = nullptr;
+    m_ImageToIGTLMessageFilter->GenerateData();
+    igtl::MessageBase::Pointer thirdMessage = m_ImageToIGTLMessageFilter->GetOutput()->GetMessage();
+    CPPUNIT_ASSERT_MESSAGE("A released message is reused", firstMessagePointer == thirdMessage.GetPointer());
+
+    mitk::ImageReadAccessor readAccess(m_TestImage, m_TestImage->GetChannelData(0));
+    auto* igtlImageMessage = static_cast<igtl::ImageMessage*>(thirdMessage.GetPointer());
+    CPPUNIT_ASSERT_MESSAGE("Reused message contains the image",
+      memcmp(readAccess.GetData(), igtlImageMessage->GetScalarPointer(), SMALL_DIM * SMALL_DIM * sizeof(short)) == 0);
+  }
+
   /**
   * This test takes a generated gradient mitk image. Then an IGTL Message is produced
   * using the ImageToIGTLMessageFilter. In the end it is tested, wether the image data in both images is equivalent.
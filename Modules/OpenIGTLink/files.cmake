@@ -1,3 +1,7 @@
+set(H_FILES
+  mitkIGTLRingBuffer.h
+)
+
 set(CPP_FILES
   mitkIGTLClient.cpp
   mitkIGTLServer.cpp
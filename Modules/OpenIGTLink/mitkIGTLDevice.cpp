@@ -15,6 +15,7 @@ found in the LICENSE file.
 //#include "mitkIGTTimeStamp.h"
 #include <itkMultiThreaderBase.h>
 #include <itksys/SystemTools.hxx>
+#include <algorithm>
 #include <cstring>
 #include <thread>
 
@@ -45,7 +46,8 @@ m_Name("Unspecified Device"),
 m_StopCommunication(false),
 m_Hostname("127.0.0.1"),
 m_PortNumber(-1),
-m_LogMessages(false)
+m_LogMessages(false),
+m_NextReceiveObserverTag(0)
 {
   m_ReadFully = ReadFully;
   // execution rights are owned by the application thread at the beginning
@@ -175,7 +177,7 @@ unsigned int mitk::IGTLDevice::ReceivePrivate(igtl::Socket* socket)
         std::strstr(curDevType, "RTS_") != nullptr)
       {
         this->m_MessageQueue->PushCommandMessage(headerMsg);
-        this->InvokeEvent(CommandReceivedEvent());
+        this->InvokeReceiveEvent(CommandReceivedEvent());
         return IGTL_STATUS_OK;
       }
 
@@ -218,14 +220,14 @@ unsigned int mitk::IGTLDevice::ReceivePrivate(igtl::Socket* socket)
         if (std::strstr(curDevType, "STT_") != nullptr)
         {
           this->m_MessageQueue->PushCommandMessage(curMessage);
-          this->InvokeEvent(CommandReceivedEvent());
+          this->InvokeReceiveEvent(CommandReceivedEvent());
         }
         else
         {
           if(m_LogMessages)
             MITK_INFO << "Received Message: " << mitk::IGTLMessage::New(curMessage)->ToString();
           this->m_MessageQueue->PushMessage(curMessage);
-          this->InvokeEvent(MessageReceivedEvent());
+          this->InvokeReceiveEvent(MessageReceivedEvent());
         }
         return IGTL_STATUS_OK;
       }
@@ -252,6 +254,40 @@ unsigned int mitk::IGTLDevice::ReceivePrivate(igtl::Socket* socket)
   }
 }
 
+unsigned long mitk::IGTLDevice::AddReceiveObserver(const itk::EventObject &event, itk::Command *command)
+{
+  std::lock_guard<std::mutex> lock(m_ReceiveObserversMutex);
+  const unsigned long tag = m_NextReceiveObserverTag++;
+  m_ReceiveObservers.push_back({ tag, std::shared_ptr<const itk::EventObject>(event.MakeObject()), command });
+  return tag;
+}
+
+void mitk::IGTLDevice::RemoveReceiveObserver(unsigned long tag)
+{
+  std::lock_guard<std::mutex> lock(m_ReceiveObserversMutex);
+  m_ReceiveObservers.erase(std::remove_if(m_ReceiveObservers.begin(), m_ReceiveObservers.end(),
+    [tag](const ReceiveObserver &observer) { return observer.Tag == tag; }), m_ReceiveObservers.end());
+}
+
+void mitk::IGTLDevice::InvokeReceiveEvent(const itk::EventObject &event)
+{
+  this->InvokeEvent(event);
+
+  // copy the commands, so they are executed without holding the lock
+  std::vector<itk::Command::Pointer> commands;
+  {
+    std::lock_guard<std::mutex> lock(m_ReceiveObserversMutex);
+    for (const auto &observer : m_ReceiveObservers)
+    {
+      if (observer.Event->CheckEvent(&event))
+        commands.push_back(observer.Command);
+    }
+  }
+
+  for (const auto &command : commands)
+    command->Execute(this, event);
+}
+
 void mitk::IGTLDevice::SendMessage(mitk::IGTLMessage::Pointer msg)
 {
   m_MessageQueue->PushSendMessage(msg);
@@ -372,6 +408,8 @@ bool mitk::IGTLDevice::StopCommunication()
     m_StopCommunicationMutex.lock();
     m_StopCommunication = true;
     m_StopCommunicationMutex.unlock();
+    // the receive thread must not wait for a consumer that may be gone
+    m_MessageQueue->ReleaseBlockedProducers();
     // we have to wait here that the other thread recognizes the STOP-command
     // and executes it
     m_SendingFinishedMutex.lock();
@@ -13,8 +13,10 @@ found in the LICENSE file.
 #ifndef mitkIGTLDevice_h
 #define mitkIGTLDevice_h
 
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "mitkCommon.h"
 
@@ -242,6 +244,27 @@ namespace mitk {
 
     void EnableNoBufferingMode(bool enable = true);
 
+    /**
+    * \brief Adds an observer of the events invoked by the receive thread
+    * (MessageReceivedEvent, CommandReceivedEvent).
+    *
+    * Unlike AddObserver(), the observer can be removed safely with
+    * RemoveReceiveObserver() while the receive thread is running.
+    * \return the tag of the observer, only valid for RemoveReceiveObserver()
+    */
+    unsigned long AddReceiveObserver(const itk::EventObject &event, itk::Command *command);
+
+    /**
+    * \brief Removes an observer that was added with AddReceiveObserver().
+    *
+    * The receive thread copies the observers before it executes their
+    * commands and does not hold a lock meanwhile, so this method never waits
+    * for a command, which may in turn wait for the calling thread. A command
+    * that was started before may still finish after this method returned.
+    * StopCommunication() returns only after the receive thread stopped.
+    */
+    void RemoveReceiveObserver(unsigned long tag);
+
     /**
     * \brief Returns the number of connections of this device
     */
@@ -356,6 +379,21 @@ namespace mitk {
 
   private:
 
+    /** Invokes the event for the observers of AddObserver() and AddReceiveObserver() */
+    void InvokeReceiveEvent(const itk::EventObject &event);
+
+    struct ReceiveObserver
+    {
+      unsigned long Tag;
+      std::shared_ptr<const itk::EventObject> Event;
+      itk::Command::Pointer Command;
+    };
+
+    /** observers of AddReceiveObserver(), guarded by m_ReceiveObserversMutex */
+    std::vector<ReceiveObserver> m_ReceiveObservers;
+    unsigned long m_NextReceiveObserverTag;
+    std::mutex m_ReceiveObserversMutex;
+
     /** Sending thread */
     std::thread m_SendThread;
     /** Receiving thread */
@@ -13,210 +13,99 @@ found in the LICENSE file.
 #include "mitkIGTLMessageQueue.h"
 #include <string>
 #include "igtlMessageBase.h"
+#include <mitkExceptionMacro.h>
 
 void mitk::IGTLMessageQueue::PushSendMessage(mitk::IGTLMessage::Pointer message)
 {
-  this->m_Mutex.lock();
-  if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-    m_SendQueue.clear();
-
-  m_SendQueue.push_back(message);
-  this->m_Mutex.unlock();
+  std::lock_guard<std::mutex> lock(m_SendMutex);
+  m_SendQueue.Push(message);
 }
 
 void mitk::IGTLMessageQueue::PushCommandMessage(igtl::MessageBase::Pointer message)
 {
-  this->m_Mutex.lock();
-  if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-    m_CommandQueue.clear();
-
-  m_CommandQueue.push_back(message);
-  this->m_Mutex.unlock();
+  m_CommandQueue.Push(message);
 }
 
 void mitk::IGTLMessageQueue::PushMessage(igtl::MessageBase::Pointer msg)
 {
-  this->m_Mutex.lock();
-
-  std::stringstream infolog;
-
-  infolog << "Received message of type ";
-
   if (dynamic_cast<igtl::TrackingDataMessage*>(msg.GetPointer()) != nullptr)
   {
-    if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-      m_TrackingDataQueue.clear();
-
-    this->m_TrackingDataQueue.push_back(dynamic_cast<igtl::TrackingDataMessage*>(msg.GetPointer()));
-
-    infolog << "TDATA";
+    this->m_TrackingDataQueue.Push(dynamic_cast<igtl::TrackingDataMessage*>(msg.GetPointer()));
   }
   else if (dynamic_cast<igtl::TransformMessage*>(msg.GetPointer()) != nullptr)
   {
-    if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-      m_TransformQueue.clear();
-
-    this->m_TransformQueue.push_back(dynamic_cast<igtl::TransformMessage*>(msg.GetPointer()));
-
-    infolog << "TRANSFORM";
+    this->m_TransformQueue.Push(dynamic_cast<igtl::TransformMessage*>(msg.GetPointer()));
   }
   else if (dynamic_cast<igtl::StringMessage*>(msg.GetPointer()) != nullptr)
   {
-    if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-      m_StringQueue.clear();
-
-    this->m_StringQueue.push_back(dynamic_cast<igtl::StringMessage*>(msg.GetPointer()));
-
-    infolog << "STRING";
+    this->m_StringQueue.Push(dynamic_cast<igtl::StringMessage*>(msg.GetPointer()));
   }
   else if (dynamic_cast<igtl::ImageMessage*>(msg.GetPointer()) != nullptr)
   {
     igtl::ImageMessage::Pointer imageMsg = dynamic_cast<igtl::ImageMessage*>(msg.GetPointer());
-    int* dim = new int[3];
+    int dim[3];
     imageMsg->GetDimensions(dim);
     if (dim[2] > 1)
     {
-      if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-        m_Image3dQueue.clear();
-
-      this->m_Image3dQueue.push_back(dynamic_cast<igtl::ImageMessage*>(msg.GetPointer()));
-
-      infolog << "IMAGE3D";
+      this->m_Image3dQueue.Push(imageMsg);
     }
     else
     {
-      if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-        m_Image2dQueue.clear();
-
-      this->m_Image2dQueue.push_back(dynamic_cast<igtl::ImageMessage*>(msg.GetPointer()));
-
-      infolog << "IMAGE2D";
+      this->m_Image2dQueue.Push(imageMsg);
     }
   }
   else
   {
-    if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-      m_MiscQueue.clear();
-
-    this->m_MiscQueue.push_back(msg);
-
-    infolog << "OTHER";
+    this->m_MiscQueue.Push(msg);
   }
 
+  std::lock_guard<std::mutex> lock(m_LatestMessageMutex);
   m_Latest_Message = msg;
-
-  //MITK_INFO << infolog.str();
-
-  this->m_Mutex.unlock();
 }
 
 mitk::IGTLMessage::Pointer mitk::IGTLMessageQueue::PullSendMessage()
 {
-  mitk::IGTLMessage::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_SendQueue.size() > 0)
-  {
-    ret = this->m_SendQueue.front();
-    this->m_SendQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_SendQueue.Pull();
 }
 
 igtl::MessageBase::Pointer mitk::IGTLMessageQueue::PullMiscMessage()
 {
-  igtl::MessageBase::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_MiscQueue.size() > 0)
-  {
-    ret = this->m_MiscQueue.front();
-    this->m_MiscQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_MiscQueue.Pull();
 }
 
 igtl::ImageMessage::Pointer mitk::IGTLMessageQueue::PullImage2dMessage()
 {
-  igtl::ImageMessage::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_Image2dQueue.size() > 0)
-  {
-    ret = this->m_Image2dQueue.front();
-    this->m_Image2dQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_Image2dQueue.Pull();
 }
 
 igtl::ImageMessage::Pointer mitk::IGTLMessageQueue::PullImage3dMessage()
 {
-  igtl::ImageMessage::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_Image3dQueue.size() > 0)
-  {
-    ret = this->m_Image3dQueue.front();
-    this->m_Image3dQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_Image3dQueue.Pull();
 }
 
 igtl::TrackingDataMessage::Pointer mitk::IGTLMessageQueue::PullTrackingMessage()
 {
-  igtl::TrackingDataMessage::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_TrackingDataQueue.size() > 0)
-  {
-    ret = this->m_TrackingDataQueue.front();
-    this->m_TrackingDataQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_TrackingDataQueue.Pull();
 }
 
 igtl::MessageBase::Pointer mitk::IGTLMessageQueue::PullCommandMessage()
 {
-  igtl::MessageBase::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_CommandQueue.size() > 0)
-  {
-    ret = this->m_CommandQueue.front();
-    this->m_CommandQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_CommandQueue.Pull();
 }
 
 igtl::StringMessage::Pointer mitk::IGTLMessageQueue::PullStringMessage()
 {
-  igtl::StringMessage::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_StringQueue.size() > 0)
-  {
-    ret = this->m_StringQueue.front();
-    this->m_StringQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_StringQueue.Pull();
 }
 
 igtl::TransformMessage::Pointer mitk::IGTLMessageQueue::PullTransformMessage()
 {
-  igtl::TransformMessage::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_TransformQueue.size() > 0)
-  {
-    ret = this->m_TransformQueue.front();
-    this->m_TransformQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_TransformQueue.Pull();
 }
 
 std::string mitk::IGTLMessageQueue::GetNextMsgInformationString()
 {
-  this->m_Mutex.lock();
+  std::lock_guard<std::mutex> lock(m_LatestMessageMutex);
   std::stringstream s;
   if (this->m_Latest_Message != nullptr)
   {
@@ -227,13 +116,12 @@ std::string mitk::IGTLMessageQueue::GetNextMsgInformationString()
   {
     s << "No Msg";
   }
-  this->m_Mutex.unlock();
   return s.str();
 }
 
 std::string mitk::IGTLMessageQueue::GetNextMsgDeviceType()
 {
-  this->m_Mutex.lock();
+  std::lock_guard<std::mutex> lock(m_LatestMessageMutex);
   std::stringstream s;
   if (m_Latest_Message != nullptr)
   {
@@ -243,13 +131,12 @@ std::string mitk::IGTLMessageQueue::GetNextMsgDeviceType()
   {
     s << "";
   }
-  this->m_Mutex.unlock();
   return s.str();
 }
 
 std::string mitk::IGTLMessageQueue::GetLatestMsgInformationString()
 {
-  this->m_Mutex.lock();
+  std::lock_guard<std::mutex> lock(m_LatestMessageMutex);
   std::stringstream s;
   if (m_Latest_Message != nullptr)
   {
@@ -260,13 +147,12 @@ std::string mitk::IGTLMessageQueue::GetLatestMsgInformationString()
   {
     s << "No Msg";
   }
-  this->m_Mutex.unlock();
   return s.str();
 }
 
 std::string mitk::IGTLMessageQueue::GetLatestMsgDeviceType()
 {
-  this->m_Mutex.lock();
+  std::lock_guard<std::mutex> lock(m_LatestMessageMutex);
   std::stringstream s;
   if (m_Latest_Message != nullptr)
   {
@@ -276,32 +162,138 @@ std::string mitk::IGTLMessageQueue::GetLatestMsgDeviceType()
   {
     s << "";
   }
-  this->m_Mutex.unlock();
   return s.str();
 }
 
 int mitk::IGTLMessageQueue::GetSize()
 {
-  return (this->m_CommandQueue.size() + this->m_Image2dQueue.size() + this->m_Image3dQueue.size() + this->m_MiscQueue.size()
-    + this->m_StringQueue.size() + this->m_TrackingDataQueue.size() + this->m_TransformQueue.size());
+  return static_cast<int>(this->m_CommandQueue.GetSize() + this->m_Image2dQueue.GetSize() + this->m_Image3dQueue.GetSize() + this->m_MiscQueue.GetSize()
+    + this->m_StringQueue.GetSize() + this->m_TrackingDataQueue.GetSize() + this->m_TransformQueue.GetSize());
 }
 
 void mitk::IGTLMessageQueue::EnableNoBufferingMode(bool enable)
 {
-  this->m_Mutex.lock();
   if (enable)
     this->m_BufferingType = IGTLMessageQueue::BufferingType::NoBuffering;
   else
     this->m_BufferingType = IGTLMessageQueue::BufferingType::Infinit;
-  this->m_Mutex.unlock();
+
+  for (int queue = 0; queue < NumberOfQueueTypes; ++queue)
+  {
+    this->SetDropPolicy(static_cast<QueueType>(queue), enable ? DropPolicy::LatestOnly : DropPolicy::DropOldest);
+  }
+}
+
+void mitk::IGTLMessageQueue::SetDropPolicy(QueueType queue, DropPolicy policy)
+{
+  this->GetQueue(queue)->SetDropPolicy(policy);
+}
+
+mitk::IGTLMessageQueue::DropPolicy mitk::IGTLMessageQueue::GetDropPolicy(QueueType queue) const
+{
+  return this->GetQueue(queue)->GetDropPolicy();
+}
+
+void mitk::IGTLMessageQueue::SetMaximumDepth(QueueType queue, std::size_t depth)
+{
+  this->GetQueue(queue)->SetMaximumDepth(depth);
+}
+
+std::size_t mitk::IGTLMessageQueue::GetMaximumDepth(QueueType queue) const
+{
+  return this->GetQueue(queue)->GetMaximumDepth();
+}
+
+mitk::IGTLMessageQueue::QueueStatistics mitk::IGTLMessageQueue::GetQueueStatistics(QueueType queue) const
+{
+  return this->GetQueue(queue)->GetStatistics();
+}
+
+void mitk::IGTLMessageQueue::ResetQueueStatistics()
+{
+  for (int queue = 0; queue < NumberOfQueueTypes; ++queue)
+  {
+    this->GetQueue(static_cast<QueueType>(queue))->ResetStatistics();
+  }
+}
+
+void mitk::IGTLMessageQueue::SetBlockTimeout(std::chrono::milliseconds timeout)
+{
+  for (int queue = 0; queue < NumberOfQueueTypes; ++queue)
+  {
+    this->GetQueue(static_cast<QueueType>(queue))->SetBlockTimeout(timeout);
+  }
+}
+
+void mitk::IGTLMessageQueue::ReleaseBlockedProducers()
+{
+  for (int queue = 0; queue < NumberOfQueueTypes; ++queue)
+  {
+    this->GetQueue(static_cast<QueueType>(queue))->ReleaseBlockedProducer();
+  }
+}
+
+void mitk::IGTLMessageQueue::Clear()
+{
+  this->ReleaseBlockedProducers();
+
+  m_CommandQueue.Clear();
+  m_Image2dQueue.Clear();
+  m_Image3dQueue.Clear();
+  m_TransformQueue.Clear();
+  m_TrackingDataQueue.Clear();
+  m_StringQueue.Clear();
+  m_MiscQueue.Clear();
+  m_SendQueue.Clear();
+
+  std::lock_guard<std::mutex> lock(m_LatestMessageMutex);
+  m_Latest_Message = nullptr;
+}
+
+mitk::IGTLRingBufferBase *mitk::IGTLMessageQueue::GetQueue(QueueType queue)
+{
+  return const_cast<IGTLRingBufferBase *>(static_cast<const IGTLMessageQueue *>(this)->GetQueue(queue));
+}
+
+const mitk::IGTLRingBufferBase *mitk::IGTLMessageQueue::GetQueue(QueueType queue) const
+{
+  switch (queue)
+  {
+    case CommandQueue:
+      return &m_CommandQueue;
+    case Image2dQueue:
+      return &m_Image2dQueue;
+    case Image3dQueue:
+      return &m_Image3dQueue;
+    case TransformQueue:
+      return &m_TransformQueue;
+    case TrackingDataQueue:
+      return &m_TrackingDataQueue;
+    case StringQueue:
+      return &m_StringQueue;
+    case MiscQueue:
+      return &m_MiscQueue;
+    case SendQueue:
+      return &m_SendQueue;
+    default:
+      mitkThrow() << "Invalid message queue type " << queue;
+  }
 }
 
 mitk::IGTLMessageQueue::IGTLMessageQueue()
+  : m_CommandQueue(QueueCapacity),
+    m_Image2dQueue(QueueCapacity),
+    m_Image3dQueue(QueueCapacity),
+    m_TransformQueue(QueueCapacity),
+    m_TrackingDataQueue(QueueCapacity),
+    m_StringQueue(QueueCapacity),
+    m_MiscQueue(QueueCapacity),
+    m_SendQueue(QueueCapacity)
 {
-  this->m_BufferingType = IGTLMessageQueue::NoBuffering;
+  this->EnableNoBufferingMode(true);
 }
 
 mitk::IGTLMessageQueue::~IGTLMessageQueue()
 {
-  this->m_Mutex.unlock();
+  this->ReleaseBlockedProducers();
 }
@@ -18,9 +18,9 @@ found in the LICENSE file.
 #include "itkObject.h"
 #include "mitkCommon.h"
 
-#include <deque>
 #include <mutex>
 #include <mitkIGTLMessage.h>
+#include <mitkIGTLRingBuffer.h>
 
 //OpenIGTLink
 #include "igtlMessageBase.h"
@@ -34,6 +34,16 @@ namespace mitk {
   * \class IGTLMessageQueue
   * \brief Thread safe message queue to store OpenIGTLink messages.
   *
+  * Each message type is stored in its own bounded lock-free ring buffer
+  * (\sa IGTLRingBuffer), so the receiving thread never waits for the threads
+  * pulling the messages. Every receive queue expects a single producer (the
+  * receive thread of the device) and a single consumer per message type.
+  * Messages to send may be pushed from several threads; only the producers of
+  * the send queue are serialized.
+  *
+  * What happens if a queue is full is defined per queue by an IGTLDropPolicy.
+  * Depth and drop counters of each queue can be queried by GetQueueStatistics().
+  *
   * \ingroup OpenIGTLink
   */
   class MITKOPENIGTLINK_EXPORT IGTLMessageQueue : public itk::Object
@@ -45,11 +55,36 @@ namespace mitk {
 
       /**
        * \brief Different buffering types
-       * Infinit buffering means that you can push as many messages as you want
+       * Infinit buffering means that the queues keep up to their maximum depth
+       * messages and drop the oldest ones if it is exceeded
        * NoBuffering means that the queue just stores a single message
        */
     enum BufferingType { Infinit, NoBuffering };
 
+    /**
+     * \brief The queues for the different message types
+     */
+    enum QueueType
+    {
+      CommandQueue,
+      Image2dQueue,
+      Image3dQueue,
+      TransformQueue,
+      TrackingDataQueue,
+      StringQueue,
+      MiscQueue,
+      SendQueue,
+      NumberOfQueueTypes
+    };
+
+    typedef IGTLDropPolicy DropPolicy;
+    typedef IGTLRingBufferStatistics QueueStatistics;
+
+    /**
+     * \brief Number of messages each queue is able to hold at most
+     */
+    static const std::size_t QueueCapacity = 256;
+
     void PushSendMessage(mitk::IGTLMessage::Pointer message);
 
     /**
@@ -101,31 +136,81 @@ namespace mitk {
     std::string GetLatestMsgDeviceType();
 
     /**
+     * \brief Switches all queues to IGTLDropPolicy::LatestOnly (enable) or
+     * IGTLDropPolicy::DropOldest (disable).
      */
     void EnableNoBufferingMode(bool enable);
 
+    /**
+     * \brief Sets what happens if a message is pushed into the full queue of the given type
+     */
+    void SetDropPolicy(QueueType queue, DropPolicy policy);
+    DropPolicy GetDropPolicy(QueueType queue) const;
+
+    /**
+     * \brief Limits the number of messages kept in the queue of the given type
+     * (at most QueueCapacity)
+     */
+    void SetMaximumDepth(QueueType queue, std::size_t depth);
+    std::size_t GetMaximumDepth(QueueType queue) const;
+
+    /**
+     * \brief Returns depth and push/drop counters of the queue of the given type
+     */
+    QueueStatistics GetQueueStatistics(QueueType queue) const;
+
+    /**
+     * \brief Resets the counters of all queues
+     */
+    void ResetQueueStatistics();
+
+    /**
+     * \brief Sets the maximum time a push into a full queue with IGTLDropPolicy::Block
+     * waits for the consumer, for all queues
+     */
+    void SetBlockTimeout(std::chrono::milliseconds timeout);
+
+    /**
+     * \brief Wakes producers that wait in a push into a full queue with
+     * IGTLDropPolicy::Block, e.g. because the consumer stopped
+     */
+    void ReleaseBlockedProducers();
+
+    /**
+     * \brief Removes all received messages and wakes blocked producers
+     */
+    void Clear();
+
   protected:
     IGTLMessageQueue();
     ~IGTLMessageQueue() override;
 
   protected:
+    IGTLRingBufferBase *GetQueue(QueueType queue);
+    const IGTLRingBufferBase *GetQueue(QueueType queue) const;
+
+    /**
+    * \brief Serializes threads pushing into the send queue
+    */
+    std::mutex m_SendMutex;
+
     /**
-    * \brief Mutex to take car of the queue
+    * \brief Guards m_Latest_Message, which is only used for information
     */
-    std::mutex m_Mutex;
+    mutable std::mutex m_LatestMessageMutex;
 
     /**
-    * \brief the queue that stores pointer to the inserted messages
+    * \brief the queues that store pointer to the inserted messages
     */
-    std::deque< igtl::MessageBase::Pointer > m_CommandQueue;
-    std::deque< igtl::ImageMessage::Pointer > m_Image2dQueue;
-    std::deque< igtl::ImageMessage::Pointer > m_Image3dQueue;
-    std::deque< igtl::TransformMessage::Pointer > m_TransformQueue;
-    std::deque< igtl::TrackingDataMessage::Pointer > m_TrackingDataQueue;
-    std::deque< igtl::StringMessage::Pointer > m_StringQueue;
-    std::deque< igtl::MessageBase::Pointer > m_MiscQueue;
-
-    std::deque< mitk::IGTLMessage::Pointer > m_SendQueue;
+    IGTLRingBuffer< igtl::MessageBase::Pointer > m_CommandQueue;
+    IGTLRingBuffer< igtl::ImageMessage::Pointer > m_Image2dQueue;
+    IGTLRingBuffer< igtl::ImageMessage::Pointer > m_Image3dQueue;
+    IGTLRingBuffer< igtl::TransformMessage::Pointer > m_TransformQueue;
+    IGTLRingBuffer< igtl::TrackingDataMessage::Pointer > m_TrackingDataQueue;
+    IGTLRingBuffer< igtl::StringMessage::Pointer > m_StringQueue;
+    IGTLRingBuffer< igtl::MessageBase::Pointer > m_MiscQueue;
+
+    IGTLRingBuffer< mitk::IGTLMessage::Pointer > m_SendQueue;
 
     igtl::MessageBase::Pointer m_Latest_Message;
 
@@ -0,0 +1,333 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkIGTLRingBuffer_h
+#define mitkIGTLRingBuffer_h
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace mitk {
+  /**
+  * \brief Policy applied by an IGTLRingBuffer when a new element is pushed into a full buffer.
+  */
+  enum class IGTLDropPolicy
+  {
+    LatestOnly, ///< the buffer keeps only the newest element, all older ones are dropped
+    DropOldest, ///< the oldest element is dropped if the maximum depth is reached
+    Block       ///< the producer waits until the consumer made room, at most for the block timeout
+  };
+
+  /**
+  * \brief Counters of an IGTLRingBuffer, e.g. for latency monitoring.
+  */
+  struct IGTLRingBufferStatistics
+  {
+    std::size_t Depth = 0;                ///< current number of elements in the buffer
+    std::size_t MaximumDepth = 0;         ///< highest number of elements observed since the last reset
+    std::uint64_t NumberOfPushed = 0;     ///< number of elements pushed since the last reset
+    std::uint64_t NumberOfDropped = 0;    ///< number of elements dropped since the last reset
+  };
+
+  /**
+  * \class IGTLRingBufferBase
+  * \brief Type independent part of IGTLRingBuffer: drop policy, depth limit and counters.
+  *
+  * All members may be accessed from any thread.
+  *
+  * \ingroup OpenIGTLink
+  */
+  class IGTLRingBufferBase
+  {
+  public:
+    explicit IGTLRingBufferBase(std::size_t capacity)
+      : m_Capacity(RoundUpToPowerOfTwo(capacity)),
+        m_DropPolicy(IGTLDropPolicy::DropOldest),
+        m_DepthLimit(m_Capacity),
+        m_BlockTimeout(1000),
+        m_ReleaseCount(0),
+        m_EnqueuePosition(0),
+        m_DequeuePosition(0),
+        m_NumberOfPushed(0),
+        m_NumberOfDropped(0),
+        m_MaximumDepth(0)
+    {
+    }
+
+    virtual ~IGTLRingBufferBase() = default;
+
+    IGTLRingBufferBase(const IGTLRingBufferBase &) = delete;
+    IGTLRingBufferBase &operator=(const IGTLRingBufferBase &) = delete;
+
+    void SetDropPolicy(IGTLDropPolicy policy) { m_DropPolicy = policy; }
+    IGTLDropPolicy GetDropPolicy() const { return m_DropPolicy; }
+
+    /**
+    * \brief Limits the number of buffered elements. The value is clamped to [1, capacity].
+    */
+    void SetMaximumDepth(std::size_t depth)
+    {
+      m_DepthLimit = depth < 1 ? 1 : (depth > m_Capacity ? m_Capacity : depth);
+    }
+    std::size_t GetMaximumDepth() const { return m_DepthLimit; }
+
+    std::size_t GetCapacity() const { return m_Capacity; }
+
+    /**
+    * \brief Maximum time a push waits with IGTLDropPolicy::Block. If the consumer does not make
+    * room in time, the oldest element is dropped instead. Default is one second.
+    */
+    void SetBlockTimeout(std::chrono::milliseconds timeout) { m_BlockTimeout = timeout.count(); }
+    std::chrono::milliseconds GetBlockTimeout() const { return std::chrono::milliseconds(m_BlockTimeout.load()); }
+
+    /**
+    * \brief Wakes a producer that currently waits with IGTLDropPolicy::Block. The waiting push
+    * drops the oldest element and returns. May be called from any thread.
+    */
+    void ReleaseBlockedProducer() { ++m_ReleaseCount; }
+
+    /**
+    * \brief Returns the number of buffered elements. The value may be outdated
+    * as soon as it is returned if producer or consumer are active.
+    */
+    std::size_t GetSize() const
+    {
+      const std::size_t dequeuePosition = m_DequeuePosition.load(std::memory_order_acquire);
+      const std::size_t enqueuePosition = m_EnqueuePosition.load(std::memory_order_acquire);
+      return enqueuePosition > dequeuePosition ? enqueuePosition - dequeuePosition : 0;
+    }
+
+    IGTLRingBufferStatistics GetStatistics() const
+    {
+      IGTLRingBufferStatistics statistics;
+      statistics.Depth = this->GetSize();
+      statistics.MaximumDepth = m_MaximumDepth;
+      statistics.NumberOfPushed = m_NumberOfPushed;
+      statistics.NumberOfDropped = m_NumberOfDropped;
+      return statistics;
+    }
+
+    void ResetStatistics()
+    {
+      m_NumberOfPushed = 0;
+      m_NumberOfDropped = 0;
+      m_MaximumDepth = this->GetSize();
+    }
+
+  protected:
+    static std::size_t RoundUpToPowerOfTwo(std::size_t value)
+    {
+      std::size_t result = 2;
+      while (result < value)
+        result <<= 1;
+      return result;
+    }
+
+    void UpdateMaximumDepth()
+    {
+      const std::size_t depth = this->GetSize();
+      std::size_t maximum = m_MaximumDepth.load(std::memory_order_relaxed);
+      while (depth > maximum && !m_MaximumDepth.compare_exchange_weak(maximum, depth, std::memory_order_relaxed))
+      {
+      }
+    }
+
+    const std::size_t m_Capacity;
+    std::atomic<IGTLDropPolicy> m_DropPolicy;
+    std::atomic<std::size_t> m_DepthLimit;
+    std::atomic<std::chrono::milliseconds::rep> m_BlockTimeout;
+    std::atomic<std::uint64_t> m_ReleaseCount;
+
+    // producer and consumer positions on separate cache lines to avoid false sharing
+    alignas(64) std::atomic<std::size_t> m_EnqueuePosition;
+    alignas(64) std::atomic<std::size_t> m_DequeuePosition;
+
+    alignas(64) std::atomic<std::uint64_t> m_NumberOfPushed;
+    std::atomic<std::uint64_t> m_NumberOfDropped;
+    std::atomic<std::size_t> m_MaximumDepth;
+  };
+
+  /**
+  * \class IGTLRingBuffer
+  * \brief Bounded lock-free single-producer/single-consumer ring buffer.
+  *
+  * Push() must only be called by one thread at a time (the producer), Pull() by one
+  * thread at a time (the consumer). To drop the oldest element the producer takes it
+  * out of the buffer like a second consumer, therefore every slot carries a sequence
+  * number that tells whether it is free, filled or currently read.
+  *
+  * \ingroup OpenIGTLink
+  */
+  template <typename T>
+  class IGTLRingBuffer : public IGTLRingBufferBase
+  {
+  public:
+    explicit IGTLRingBuffer(std::size_t capacity = 256)
+      : IGTLRingBufferBase(capacity),
+        m_Slots(new Slot[m_Capacity])
+    {
+      for (std::size_t i = 0; i < m_Capacity; ++i)
+        m_Slots[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /**
+    * \brief Adds an element according to the drop policy. Producer side.
+    */
+    void Push(T element)
+    {
+      ++m_NumberOfPushed;
+
+      switch (m_DropPolicy.load())
+      {
+        case IGTLDropPolicy::LatestOnly:
+          this->DropElements(0);
+          this->PushDropping(element);
+          break;
+
+        case IGTLDropPolicy::DropOldest:
+          this->DropElements(m_DepthLimit - 1);
+          this->PushDropping(element);
+          break;
+
+        case IGTLDropPolicy::Block:
+        {
+          const std::uint64_t releaseCount = m_ReleaseCount.load();
+          const auto deadline = std::chrono::steady_clock::now() + this->GetBlockTimeout();
+
+          while (this->GetSize() >= m_DepthLimit || !this->TryPush(element))
+          {
+            // the policy may be changed while waiting, e.g. when disconnecting, and the
+            // consumer may have stopped: never wait longer than the block timeout
+            if (m_DropPolicy.load() != IGTLDropPolicy::Block || m_ReleaseCount.load() != releaseCount ||
+                std::chrono::steady_clock::now() >= deadline)
+            {
+              this->DropElements(m_DepthLimit - 1);
+              this->PushDropping(element);
+              break;
+            }
+            std::this_thread::yield();
+          }
+          break;
+        }
+      }
+
+      this->UpdateMaximumDepth();
+    }
+
+    /**
+    * \brief Returns and removes the oldest element or a default constructed T if
+    * the buffer is empty. Consumer side.
+    */
+    T Pull()
+    {
+      T element = T();
+      this->TryPull(element);
+      return element;
+    }
+
+    /**
+    * \brief Removes all elements. Consumer side.
+    */
+    void Clear()
+    {
+      T element;
+      while (this->TryPull(element))
+      {
+      }
+    }
+
+  private:
+    struct Slot
+    {
+      std::atomic<std::size_t> Sequence;
+      T Element;
+    };
+
+    /** Drops the oldest elements until at most maxSize elements remain. */
+    void DropElements(std::size_t maxSize)
+    {
+      T element;
+      while (this->GetSize() > maxSize && this->TryPull(element))
+        ++m_NumberOfDropped;
+    }
+
+    /** Pushes the element, dropping the oldest one while the buffer is completely full. */
+    void PushDropping(T &element)
+    {
+      while (!this->TryPush(element))
+      {
+        T dropped;
+        if (this->GetSize() >= m_Capacity && this->TryPull(dropped))
+          ++m_NumberOfDropped;
+        else
+          std::this_thread::yield(); // the consumer is still reading the slot
+      }
+    }
+
+    /** Moves the element into the next slot if it is free, leaves it untouched otherwise. */
+    bool TryPush(T &element)
+    {
+      const std::size_t position = m_EnqueuePosition.load(std::memory_order_relaxed);
+      Slot &slot = m_Slots[position & (m_Capacity - 1)];
+
+      if (slot.Sequence.load(std::memory_order_acquire) != position)
+        return false;
+
+      slot.Element = std::move(element);
+      slot.Sequence.store(position + 1, std::memory_order_release);
+      m_EnqueuePosition.store(position + 1, std::memory_order_release);
+      return true;
+    }
+
+    /** Moves the oldest element out of its slot. Safe to be called concurrently by consumer and producer. */
+    bool TryPull(T &element)
+    {
+      std::size_t position = m_DequeuePosition.load(std::memory_order_relaxed);
+      Slot *slot;
+
+      for (;;)
+      {
+        slot = &m_Slots[position & (m_Capacity - 1)];
+        const std::size_t sequence = slot->Sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t difference =
+          static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+        if (difference == 0)
+        {
+          if (m_DequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_acq_rel))
+            break;
+        }
+        else if (difference < 0)
+        {
+          return false; // empty
+        }
+        else
+        {
+          position = m_DequeuePosition.load(std::memory_order_relaxed);
+        }
+      }
+
+      element = std::move(slot->Element);
+      slot->Element = T(); // do not keep a reference in the slot
+      slot->Sequence.store(position + m_Capacity, std::memory_order_release);
+      return true;
+    }
+
+    std::unique_ptr<Slot[]> m_Slots;
+  };
+}
+
+#endif
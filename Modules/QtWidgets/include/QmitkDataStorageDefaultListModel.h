@@ -18,6 +18,8 @@ found in the LICENSE file.
 // qt widgets module
 #include <QmitkAbstractDataStorageModel.h>
 
+#include <unordered_map>
+
 /**
 * @brief The 'QmitkDataStorageDefaultListModel' is a basic list model, derived from the 'QmitkAbstractDataStorageModel'.
 *        It provides functions to accept a data storage and a node predicate in order to customize the model data nodes.
@@ -70,8 +72,21 @@ public:
 protected:
 
   virtual void UpdateModelData();
+  /*
+  * @brief Rebuilds the index of the node rows. Has to be called whenever 'm_DataNodes' is replaced.
+  */
+  void UpdateNodeRows();
 
   std::vector<mitk::DataNode::Pointer> m_DataNodes;
+  /*
+  * @brief Row of each node in 'm_DataNodes', so that added, changed and removed nodes are found without a linear search.
+  */
+  std::unordered_map<const mitk::DataNode*, int> m_NodeRows;
+
+private:
+
+  void InsertNode(const mitk::DataNode* node);
+  void RemoveRow(int row);
 
 };
 
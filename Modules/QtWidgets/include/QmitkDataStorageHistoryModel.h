@@ -41,6 +41,10 @@ public:
     static void AddNodeToHistory(mitk::DataNode* node);
     static void ResetHistory();
 
+    void NodeAdded(const mitk::DataNode* node) override;
+    void NodeChanged(const mitk::DataNode* node) override;
+    void NodeRemoved(const mitk::DataNode* node) override;
+
 protected:
     void UpdateModelData() override;
 };
@@ -26,6 +26,8 @@ found in the LICENSE file.
 
 #include <QList>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 class QmitkDataStorageTreeModelInternalItem;
@@ -121,6 +123,11 @@ public:
   ///
   virtual void AddNode(const mitk::DataNode *node);
   ///
+  /// Adds the nodes of a committed data storage batch to this model in one pass.
+  /// Nodes added during a batch are ignored by AddNode and added here. Called by the DataStorage
+  ///
+  virtual void AddNodes(const mitk::DataStorage::BatchChanges &changes);
+  ///
   /// Removes a node from this model. Also removes any event listener from the node.
   ///
   virtual void RemoveNode(const mitk::DataNode *node);
@@ -196,14 +203,27 @@ protected:
   bool m_AllowHierarchyChange;
 
 private:
-  void AddNodeInternal(const mitk::DataNode *);
+  void AddNodeInternal(const mitk::DataNode *, bool adjustLayers = true);
   void RemoveNodeInternal(const mitk::DataNode *);
   ///
+  /// Returns the tree item of the node in constant time or nullptr if the node is not in the tree
+  ///
+  TreeItem *FindTreeItem(const mitk::DataNode *node) const;
+  ///
+  /// Emits one dataChanged signal for every node that was modified since the last call
+  ///
+  void EmitPendingDataChanged();
+  ///
   /// Checks if dicom properties patient name, study names and series name exists
   ///
   bool DicomPropertiesExists(const mitk::DataNode &) const;
 
   unsigned long m_DataStorageDeletedTag;
+
+  /// Index of all tree items except the root, maintained alongside the tree
+  std::unordered_map<const mitk::DataNode *, TreeItem *> m_TreeItems;
+  /// Nodes that were modified since the last dataChanged signals were emitted
+  std::unordered_set<const mitk::DataNode *> m_ModifiedNodes;
 };
 
 #endif
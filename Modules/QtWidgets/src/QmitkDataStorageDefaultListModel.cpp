@@ -32,30 +32,55 @@ void QmitkDataStorageDefaultListModel::NodePredicateChanged()
   UpdateModelData();
 }
 
-void QmitkDataStorageDefaultListModel::NodeAdded(const mitk::DataNode* /*node*/)
+void QmitkDataStorageDefaultListModel::NodeAdded(const mitk::DataNode* node)
 {
-  UpdateModelData();
+  if (node == nullptr || m_NodeRows.find(node) != m_NodeRows.end())
+  {
+    return;
+  }
+
+  if (m_NodePredicate.IsNull() || m_NodePredicate->CheckNode(node))
+  {
+    InsertNode(node);
+  }
 }
 
 void QmitkDataStorageDefaultListModel::NodeChanged(const mitk::DataNode* node)
 {
-  // since the "NodeChanged" event is sent quite often, we check here, if it is relevant for this model
-  if (m_NodePredicate.IsNull() || m_NodePredicate->CheckNode(node))
+  // since the "NodeChanged" event is sent quite often, only the row of the node is updated
+  auto finding = m_NodeRows.find(node);
+  bool isRelevant = m_NodePredicate.IsNull() || m_NodePredicate->CheckNode(node);
+
+  if (finding != m_NodeRows.end())
   {
-    UpdateModelData();
-    return;
+    if (isRelevant)
+    {
+      auto index = this->index(finding->second, 0);
+      emit dataChanged(index, index);
+    }
+    else
+    {
+      RemoveRow(finding->second);
+    }
   }
-
-  // not relevant - need to check if we have to remove it
-  if (std::find(m_DataNodes.begin(), m_DataNodes.end(), node) != m_DataNodes.end())
+  else if (isRelevant)
   {
-    UpdateModelData();
+    // the node was filtered so far
+    auto dataStorage = m_DataStorage.Lock();
+    if (dataStorage.IsNotNull() && dataStorage->Exists(node))
+    {
+      InsertNode(node);
+    }
   }
 }
 
-void QmitkDataStorageDefaultListModel::NodeRemoved(const mitk::DataNode* /*node*/)
+void QmitkDataStorageDefaultListModel::NodeRemoved(const mitk::DataNode* node)
 {
-  UpdateModelData();
+  auto finding = m_NodeRows.find(node);
+  if (finding != m_NodeRows.end())
+  {
+    RemoveRow(finding->second);
+  }
 }
 
 QModelIndex QmitkDataStorageDefaultListModel::index(int row, int column, const QModelIndex &parent) const
@@ -171,5 +196,41 @@ void QmitkDataStorageDefaultListModel::UpdateModelData()
       m_DataNodes.push_back(node);
     }
   }
+  UpdateNodeRows();
   endResetModel();
 }
+
+void QmitkDataStorageDefaultListModel::UpdateNodeRows()
+{
+  m_NodeRows.clear();
+  m_NodeRows.reserve(m_DataNodes.size());
+
+  for (int row = 0; row < static_cast<int>(m_DataNodes.size()); ++row)
+  {
+    m_NodeRows[m_DataNodes[row]] = row;
+  }
+}
+
+void QmitkDataStorageDefaultListModel::InsertNode(const mitk::DataNode* node)
+{
+  int row = static_cast<int>(m_DataNodes.size());
+
+  beginInsertRows(QModelIndex(), row, row);
+  m_DataNodes.push_back(const_cast<mitk::DataNode*>(node));
+  m_NodeRows[node] = row;
+  endInsertRows();
+}
+
+void QmitkDataStorageDefaultListModel::RemoveRow(int row)
+{
+  beginRemoveRows(QModelIndex(), row, row);
+  m_NodeRows.erase(m_DataNodes[row]);
+  m_DataNodes.erase(m_DataNodes.begin() + row);
+
+  // the rows of all following nodes move up by one
+  for (int i = row; i < static_cast<int>(m_DataNodes.size()); ++i)
+  {
+    m_NodeRows[m_DataNodes[i]] = i;
+  }
+  endRemoveRows();
+}
@@ -56,9 +56,30 @@ void QmitkDataStorageHistoryModel::UpdateModelData()
     // update the model, so that it will be filled with the nodes of the new data storage
     beginResetModel();
     m_DataNodes = dataNodes;
+    UpdateNodeRows();
     endResetModel();
 }
 
+void QmitkDataStorageHistoryModel::NodeAdded(const mitk::DataNode* /*node*/)
+{
+    // the order of the nodes is defined by the history, so the model is always updated completely
+    UpdateModelData();
+}
+
+void QmitkDataStorageHistoryModel::NodeChanged(const mitk::DataNode* node)
+{
+    // since the "NodeChanged" event is sent quite often, we check here, if it is relevant for this model
+    if (m_NodePredicate.IsNull() || m_NodePredicate->CheckNode(node) || m_NodeRows.find(node) != m_NodeRows.end())
+    {
+        UpdateModelData();
+    }
+}
+
+void QmitkDataStorageHistoryModel::NodeRemoved(const mitk::DataNode* /*node*/)
+{
+    UpdateModelData();
+}
+
 void QmitkDataStorageHistoryModel::AddNodeToHistory(mitk::DataNode* node)
 {
     const std::lock_guard<std::mutex> lock(_historyMutex);
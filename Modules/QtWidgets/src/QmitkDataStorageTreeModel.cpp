@@ -33,6 +33,7 @@ found in the LICENSE file.
 #include <QIcon>
 #include <QMimeData>
 #include <QTextStream>
+#include <QTimer>
 
 #include <map>
 
@@ -520,6 +521,10 @@ void QmitkDataStorageTreeModel::SetDataStorage(mitk::DataStorage *_DataStorage)
       dataStorage->RemoveNodeEvent.RemoveListener(
         mitk::MessageDelegate1<QmitkDataStorageTreeModel, const mitk::DataNode *>(
           this, &QmitkDataStorageTreeModel::RemoveNode));
+
+      dataStorage->BatchCommittedEvent.RemoveListener(
+        mitk::MessageDelegate1<QmitkDataStorageTreeModel, const mitk::DataStorage::BatchChanges &>(
+          this, &QmitkDataStorageTreeModel::AddNodes));
     }
 
     this->beginResetModel();
@@ -530,6 +535,8 @@ void QmitkDataStorageTreeModel::SetDataStorage(mitk::DataStorage *_DataStorage)
     // delete the old root (if necessary, create new)
     if (m_Root)
       m_Root->Delete();
+    m_TreeItems.clear();
+    m_ModifiedNodes.clear();
     mitk::DataNode::Pointer rootDataNode = mitk::DataNode::New();
     rootDataNode->SetName("Data Manager");
     m_Root = new TreeItem(rootDataNode, nullptr);
@@ -554,6 +561,10 @@ void QmitkDataStorageTreeModel::SetDataStorage(mitk::DataStorage *_DataStorage)
         mitk::MessageDelegate1<QmitkDataStorageTreeModel, const mitk::DataNode *>(
           this, &QmitkDataStorageTreeModel::RemoveNode));
 
+      dataStorage->BatchCommittedEvent.AddListener(
+        mitk::MessageDelegate1<QmitkDataStorageTreeModel, const mitk::DataStorage::BatchChanges &>(
+          this, &QmitkDataStorageTreeModel::AddNodes));
+
       // finally add all nodes to the model
       this->Update();
     }
@@ -567,11 +578,11 @@ void QmitkDataStorageTreeModel::SetDataStorageDeleted()
   this->SetDataStorage(nullptr);
 }
 
-void QmitkDataStorageTreeModel::AddNodeInternal(const mitk::DataNode *node)
+void QmitkDataStorageTreeModel::AddNodeInternal(const mitk::DataNode *node, bool adjustLayers)
 {
   auto dataStorage = m_DataStorage.Lock();
 
-  if (node == nullptr || dataStorage.IsNull() || !dataStorage->Exists(node) || m_Root->Find(node) != nullptr)
+  if (node == nullptr || dataStorage.IsNull() || !dataStorage->Exists(node) || this->FindTreeItem(node) != nullptr)
     return;
 
   // find out if we have a root node
@@ -581,11 +592,11 @@ void QmitkDataStorageTreeModel::AddNodeInternal(const mitk::DataNode *node)
 
   if (parentDataNode) // no top level data node
   {
-    parentTreeItem = m_Root->Find(parentDataNode); // find the corresponding tree item
+    parentTreeItem = this->FindTreeItem(parentDataNode); // find the corresponding tree item
     if (!parentTreeItem)
     {
-      this->AddNode(parentDataNode);
-      parentTreeItem = m_Root->Find(parentDataNode);
+      this->AddNodeInternal(parentDataNode, adjustLayers);
+      parentTreeItem = this->FindTreeItem(parentDataNode);
       if (!parentTreeItem)
         return;
     }
@@ -599,7 +610,9 @@ void QmitkDataStorageTreeModel::AddNodeInternal(const mitk::DataNode *node)
   {
     // emit beginInsertRows event
     beginInsertRows(index, 0, 0);
-    parentTreeItem->InsertChild(new TreeItem(const_cast<mitk::DataNode *>(node)), 0);
+    auto treeItem = new TreeItem(const_cast<mitk::DataNode *>(node));
+    parentTreeItem->InsertChild(treeItem, 0);
+    m_TreeItems[node] = treeItem;
   }
   else
   {
@@ -620,13 +633,15 @@ void QmitkDataStorageTreeModel::AddNodeInternal(const mitk::DataNode *node)
       ++firstRowWithASiblingBelow;
     }
     beginInsertRows(index, firstRowWithASiblingBelow, firstRowWithASiblingBelow);
-    parentTreeItem->InsertChild(new TreeItem(const_cast<mitk::DataNode*>(node)), firstRowWithASiblingBelow);
+    auto treeItem = new TreeItem(const_cast<mitk::DataNode*>(node));
+    parentTreeItem->InsertChild(treeItem, firstRowWithASiblingBelow);
+    m_TreeItems[node] = treeItem;
   }
 
   // emit endInsertRows event
   endInsertRows();
 
-  if(m_PlaceNewNodesOnTop)
+  if(m_PlaceNewNodesOnTop && adjustLayers)
   {
     this->AdjustLayerProperty();
   }
@@ -636,13 +651,31 @@ void QmitkDataStorageTreeModel::AddNode(const mitk::DataNode *node)
 {
   auto dataStorage = m_DataStorage.Lock();
 
-  if (node == nullptr || m_BlockDataStorageEvents || dataStorage.IsNull() || !dataStorage->Exists(node) ||
-      m_Root->Find(node) != nullptr)
+  // nodes added in a batch are added at once by AddNodes()
+  if (node == nullptr || m_BlockDataStorageEvents || dataStorage.IsNull() || dataStorage->IsBatchActive() ||
+      !dataStorage->Exists(node) || this->FindTreeItem(node) != nullptr)
     return;
 
   this->AddNodeInternal(node);
 }
 
+void QmitkDataStorageTreeModel::AddNodes(const mitk::DataStorage::BatchChanges &changes)
+{
+  if (m_BlockDataStorageEvents || changes.AddedNodes.empty())
+    return;
+
+  // the layers are adjusted once for all nodes instead of once per node
+  for (const auto &node : changes.AddedNodes)
+  {
+    this->AddNodeInternal(node, false);
+  }
+
+  if (m_PlaceNewNodesOnTop)
+  {
+    this->AdjustLayerProperty();
+  }
+}
+
 void QmitkDataStorageTreeModel::SetPlaceNewNodesOnTop(bool _PlaceNewNodesOnTop)
 {
   m_PlaceNewNodesOnTop = _PlaceNewNodesOnTop;
@@ -653,10 +686,13 @@ void QmitkDataStorageTreeModel::RemoveNodeInternal(const mitk::DataNode *node)
   if (!m_Root)
     return;
 
-  TreeItem *treeItem = m_Root->Find(node);
+  TreeItem *treeItem = this->FindTreeItem(node);
   if (!treeItem)
     return; // return because there is no treeitem containing this node
 
+  m_TreeItems.erase(node);
+  m_ModifiedNodes.erase(node);
+
   TreeItem *parentTreeItem = treeItem->GetParent();
   QModelIndex parentIndex = this->IndexFromTreeItem(parentTreeItem);
 
@@ -696,13 +732,29 @@ void QmitkDataStorageTreeModel::RemoveNode(const mitk::DataNode *node)
 
 void QmitkDataStorageTreeModel::SetNodeModified(const mitk::DataNode *node)
 {
-  TreeItem *treeItem = m_Root->Find(node);
-  if (treeItem)
+  if (this->FindTreeItem(node) == nullptr)
+    return;
+
+  // a node is often modified several times in a row (e.g. by setting several properties), so the
+  // dataChanged signals are collected and emitted once per node when the event loop is reached
+  if (m_ModifiedNodes.empty())
+    QTimer::singleShot(0, this, &QmitkDataStorageTreeModel::EmitPendingDataChanged);
+
+  m_ModifiedNodes.insert(node);
+}
+
+void QmitkDataStorageTreeModel::EmitPendingDataChanged()
+{
+  auto modifiedNodes = std::move(m_ModifiedNodes);
+  m_ModifiedNodes.clear();
+
+  for (const auto node : modifiedNodes)
   {
-    TreeItem *parentTreeItem = treeItem->GetParent();
+    TreeItem *treeItem = this->FindTreeItem(node);
     // as the root node should not be removed one should always have a parent item
-    if (!parentTreeItem)
-      return;
+    if (!treeItem || !treeItem->GetParent())
+      continue;
+
     QModelIndex index = this->createIndex(treeItem->GetIndex(), 0, treeItem);
 
     // now emit the dataChanged signal
@@ -710,6 +762,17 @@ void QmitkDataStorageTreeModel::SetNodeModified(const mitk::DataNode *node)
   }
 }
 
+QmitkDataStorageTreeModel::TreeItem *QmitkDataStorageTreeModel::FindTreeItem(const mitk::DataNode *node) const
+{
+  auto it = m_TreeItems.find(node);
+  if (it == m_TreeItems.end())
+    return nullptr;
+
+  // the tree items only hold weak pointers, so an entry is stale if its node was deleted
+  // without a remove event and another node was created at the same address
+  return it->second->GetDataNode().GetPointer() == node ? it->second : nullptr;
+}
+
 mitk::DataNode *QmitkDataStorageTreeModel::GetParentNode(const mitk::DataNode *node) const
 {
   mitk::DataNode *dataNode = nullptr;
@@ -824,7 +887,7 @@ QModelIndex QmitkDataStorageTreeModel::GetIndex(const mitk::DataNode *node) cons
 {
   if (m_Root)
   {
-    TreeItem *item = m_Root->Find(node);
+    TreeItem *item = this->FindTreeItem(node);
     if (item)
       return this->IndexFromTreeItem(item);
   }
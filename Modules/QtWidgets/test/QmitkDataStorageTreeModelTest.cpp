@@ -0,0 +1,228 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <QmitkDataStorageDefaultListModel.h>
+#include <QmitkDataStorageTreeModel.h>
+#include <QApplication>
+#include <mitkNodePredicateFunction.h>
+#include <mitkStandaloneDataStorage.h>
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+#include <mitkRenderingTestHelper.h>
+
+#include <algorithm>
+#include <chrono>
+
+extern std::vector<std::string> globalCmdLineArgs;
+
+class QmitkDataStorageTreeModelTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(QmitkDataStorageTreeModelTestSuite);
+  MITK_TEST(NodeLookupTest);
+  MITK_TEST(ModifiedNodesAreCoalescedTest);
+  MITK_TEST(TreeModelStressTest);
+  MITK_TEST(ListModelStressTest);
+  CPPUNIT_TEST_SUITE_END();
+
+  static constexpr int NumberOfNodes = 5000;
+
+  mitk::DataStorage::Pointer m_DataStorage;
+  std::vector<mitk::DataNode::Pointer> m_Nodes;
+
+  QApplication* m_TestApp;
+
+  using Clock = std::chrono::steady_clock;
+
+  static double MillisecondsSince(Clock::time_point start)
+  {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  }
+
+  void CreateNodes(int numberOfNodes)
+  {
+    for (int i = 0; i < numberOfNodes; ++i)
+    {
+      auto node = mitk::DataNode::New();
+      node->SetName("node" + std::to_string(i));
+      node->SetIntProperty("layer", i);
+      m_Nodes.push_back(node);
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_DataStorage = mitk::StandaloneDataStorage::New();
+
+    mitk::RenderingTestHelper::ArgcHelperClass cmdLineArgs(globalCmdLineArgs);
+    auto argc = cmdLineArgs.GetArgc();
+    auto argv = cmdLineArgs.GetArgv();
+    m_TestApp = new QApplication(argc, argv);
+  }
+
+  void tearDown() override
+  {
+    m_Nodes.clear();
+    m_DataStorage = nullptr;
+    delete m_TestApp;
+  }
+
+  void NodeLookupTest()
+  {
+    QmitkDataStorageTreeModel model(m_DataStorage, false);
+    this->CreateNodes(3);
+
+    m_DataStorage->Add(m_Nodes[0]);
+    m_DataStorage->Add(m_Nodes[1], m_Nodes[0]);
+    m_DataStorage->Add(m_Nodes[2], m_Nodes[1]);
+
+    for (const auto& node : m_Nodes)
+    {
+      auto index = model.GetIndex(node);
+      CPPUNIT_ASSERT_MESSAGE("Node is found", index.isValid());
+      CPPUNIT_ASSERT_MESSAGE("Index belongs to the node", model.GetNode(index) == node);
+    }
+    CPPUNIT_ASSERT_MESSAGE("Derived node is a child of its source", model.GetIndex(m_Nodes[0]) == model.GetIndex(m_Nodes[1]).parent());
+
+    // the children of a removed node move into its parent and keep being found
+    m_DataStorage->Remove(m_Nodes[1]);
+    CPPUNIT_ASSERT_MESSAGE("Removed node is not found", !model.GetIndex(m_Nodes[1]).isValid());
+    auto index = model.GetIndex(m_Nodes[2]);
+    CPPUNIT_ASSERT_MESSAGE("Child of the removed node is found", index.isValid());
+    CPPUNIT_ASSERT_MESSAGE("Index belongs to the child", model.GetNode(index) == m_Nodes[2]);
+    CPPUNIT_ASSERT_MESSAGE("Child moved into the parent", model.GetIndex(m_Nodes[0]) == index.parent());
+
+    // a new data storage resets the index
+    model.SetDataStorage(mitk::StandaloneDataStorage::New());
+    CPPUNIT_ASSERT_MESSAGE("Nodes of the old data storage are not found", !model.GetIndex(m_Nodes[0]).isValid());
+  }
+
+  void ModifiedNodesAreCoalescedTest()
+  {
+    QmitkDataStorageTreeModel model(m_DataStorage, false);
+    this->CreateNodes(3);
+    for (const auto& node : m_Nodes)
+      m_DataStorage->Add(node);
+
+    std::vector<QModelIndex> changedIndices;
+    QObject::connect(&model, &QAbstractItemModel::dataChanged, [&changedIndices](const QModelIndex& topLeft, const QModelIndex&) {
+      changedIndices.push_back(topLeft);
+    });
+
+    for (int i = 0; i < 10; ++i)
+    {
+      m_Nodes[0]->SetIntProperty("test", i);
+      m_Nodes[1]->SetIntProperty("test", i);
+    }
+    m_Nodes[2]->SetIntProperty("test", 0);
+    m_DataStorage->Remove(m_Nodes[2]);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Signals are emitted when the event loop is reached", std::size_t(0), changedIndices.size());
+
+    QApplication::processEvents();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("One signal per modified node still in the model", std::size_t(2), changedIndices.size());
+    CPPUNIT_ASSERT_MESSAGE("Signal for the first node", std::find(changedIndices.begin(), changedIndices.end(), model.GetIndex(m_Nodes[0])) != changedIndices.end());
+    CPPUNIT_ASSERT_MESSAGE("Signal for the second node", std::find(changedIndices.begin(), changedIndices.end(), model.GetIndex(m_Nodes[1])) != changedIndices.end());
+
+    changedIndices.clear();
+    QApplication::processEvents();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("No further signals", std::size_t(0), changedIndices.size());
+  }
+
+  void TreeModelStressTest()
+  {
+    QmitkDataStorageTreeModel model(m_DataStorage, false);
+    this->CreateNodes(NumberOfNodes);
+
+    auto start = Clock::now();
+    for (int i = 0; i < NumberOfNodes; ++i)
+    {
+      // every tenth node is derived from the previous one to get a few levels in the tree
+      if (i % 10 != 0)
+        m_DataStorage->Add(m_Nodes[i], m_Nodes[i - 1]);
+      else
+        m_DataStorage->Add(m_Nodes[i]);
+    }
+    MITK_INFO << "Adding " << NumberOfNodes << " nodes to the tree model: " << MillisecondsSince(start) << " ms";
+
+    int numberOfSignals = 0;
+    QObject::connect(&model, &QAbstractItemModel::dataChanged, [&numberOfSignals]() { ++numberOfSignals; });
+
+    start = Clock::now();
+    for (const auto& node : m_Nodes)
+    {
+      node->SetVisibility(false);
+      node->SetOpacity(0.5f);
+    }
+    QApplication::processEvents();
+    MITK_INFO << "Modifying " << NumberOfNodes << " nodes in the tree model: " << MillisecondsSince(start) << " ms";
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("One signal per modified node", NumberOfNodes, numberOfSignals);
+
+    for (const auto& node : m_Nodes)
+    {
+      auto index = model.GetIndex(node);
+      CPPUNIT_ASSERT_MESSAGE("Every node is found", index.isValid() && model.GetNode(index) == node);
+    }
+
+    start = Clock::now();
+    for (int i = NumberOfNodes - 1; i >= 0; i -= 2)
+    {
+      m_DataStorage->Remove(m_Nodes[i]);
+    }
+    MITK_INFO << "Removing " << NumberOfNodes / 2 << " nodes from the tree model: " << MillisecondsSince(start) << " ms";
+
+    for (int i = 0; i < NumberOfNodes; ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Only remaining nodes are found", i % 2 == 0, model.GetIndex(m_Nodes[i]).isValid());
+    }
+  }
+
+  void ListModelStressTest()
+  {
+    QmitkDataStorageDefaultListModel model(nullptr);
+    model.SetDataStorage(m_DataStorage);
+    model.SetNodePredicate(mitk::NodePredicateFunction::New([](const mitk::DataNode* node) {
+      return node->IsVisible(nullptr);
+    }));
+    this->CreateNodes(NumberOfNodes);
+
+    auto start = Clock::now();
+    for (const auto& node : m_Nodes)
+    {
+      m_DataStorage->Add(node);
+    }
+    MITK_INFO << "Adding " << NumberOfNodes << " nodes to the list model: " << MillisecondsSince(start) << " ms";
+    CPPUNIT_ASSERT_EQUAL(NumberOfNodes, model.rowCount());
+
+    start = Clock::now();
+    for (int i = 0; i < NumberOfNodes; i += 2)
+    {
+      m_Nodes[i]->SetVisibility(false);
+    }
+    MITK_INFO << "Modifying " << NumberOfNodes / 2 << " nodes in the list model: " << MillisecondsSince(start) << " ms";
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Nodes that do not match the predicate anymore are removed", NumberOfNodes / 2, model.rowCount());
+
+    m_Nodes[0]->SetVisibility(true);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Node that matches the predicate again is added", NumberOfNodes / 2 + 1, model.rowCount());
+
+    start = Clock::now();
+    for (const auto& node : m_Nodes)
+    {
+      m_DataStorage->Remove(node);
+    }
+    MITK_INFO << "Removing " << NumberOfNodes << " nodes from the list model: " << MillisecondsSince(start) << " ms";
+    CPPUNIT_ASSERT_EQUAL(0, model.rowCount());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(QmitkDataStorageTreeModel)
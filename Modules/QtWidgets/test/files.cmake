@@ -8,4 +8,5 @@ endif()
 set(MODULE_CUSTOM_TESTS
   QmitkDataStorageListModelTest.cpp
   QmitkAbstractNodeSelectionWidgetTest.cpp
+  QmitkDataStorageTreeModelTest.cpp
 )
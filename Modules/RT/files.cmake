@@ -7,6 +7,7 @@ SET(CPP_FILES
   mitkIsoDoseLevelSetProperty.cpp
   mitkIsoDoseLevelVectorProperty.cpp
   mitkDoseImageVtkMapper2D.cpp
+  mitkDoseVolumeHistogramCalculator.cpp
   mitkIsoLevelsGenerator.cpp
   mitkDoseNodeHelper.cpp
   mitkDICOMRTMimeTypes.cpp
@@ -27,6 +27,12 @@ found in the LICENSE file.
 #include <vtkPropAssembly.h>
 #include <vtkCellArray.h>
 
+//STL
+#include <cstddef>
+#include <list>
+#include <utility>
+#include <vector>
+
 class vtkActor;
 class vtkPolyDataMapper;
 class vtkPlaneSource;
@@ -130,6 +136,32 @@ namespace mitk {
     vtkProp* GetVtkProp(mitk::BaseRenderer* renderer) override;
     //### end of methods of MITK-VTK rendering pipeline
 
+    /** \brief Absolute dose value and color of a visible iso line. */
+    struct IsoLine
+    {
+      double doseValue;
+      unsigned char color[3];
+    };
+
+    /** \brief Everything the iso lines of a slice depend on.
+    *
+    * The iso lines of a slice are only recomputed if the slice geometry, the reslice settings,
+    * the dose image or one of the visible iso levels has changed.
+    */
+    struct OutlineCacheKey
+    {
+      double resliceAxes[16];
+      int extent[6];
+      double spacing[2];
+      /** \brief Thick slices mode, number of thick slices and interpolation mode of the reslicer. */
+      int resliceSettings[3];
+      int timeStep;
+      itk::ModifiedTimeType doseModifiedTime;
+      float depth;
+      std::vector<IsoLine> isoLines;
+
+      bool operator==(const OutlineCacheKey &other) const;
+    };
 
     /** \brief Internal class holding the mapper, actor, etc. for each of the 3 2D render windows */
     /**
@@ -174,6 +206,9 @@ namespace mitk {
       This container is used to save a computed contour for the next rendering execution.
       For instance, if you zoom or pann, there is no need to recompute the contour. */
       vtkSmartPointer<vtkPolyData> m_OutlinePolyData;
+      /** \brief Iso lines of the recently rendered slices, most recently used first.
+      Switching back and forth between slices does not recompute their iso lines. */
+      std::list<std::pair<OutlineCacheKey, vtkSmartPointer<vtkPolyData>>> m_OutlineCache;
 
       /** \brief Timestamp of last update of stored data. */
       itk::TimeStamp m_LastUpdateTime;
@@ -184,6 +219,17 @@ namespace mitk {
       /** \brief This filter is used to apply the level window to Grayvalue and RBG(A) images. */
       vtkSmartPointer<vtkMitkLevelWindowFilter> m_LevelWindowFilter;
 
+      /** \brief Number of slices whose iso lines are kept in m_OutlineCache. */
+      static constexpr std::size_t MaximumNumberOfCachedOutlines = 16;
+
+      /** \brief Returns the cached iso lines of the key and marks them as most recently used,
+      or nullptr if they are not cached. */
+      vtkSmartPointer<vtkPolyData> GetCachedOutline(const OutlineCacheKey &key);
+
+      /** \brief Caches the iso lines of the key. The least recently used iso lines are removed
+      if more than MaximumNumberOfCachedOutlines slices are cached. */
+      void CacheOutline(const OutlineCacheKey &key, vtkPolyData *outline);
+
       /** \brief Default constructor of the local storage. */
       LocalStorage();
       /** \brief Default deconstructor of the local storage. */
@@ -196,6 +242,23 @@ namespace mitk {
     /** \brief Get the LocalStorage corresponding to the current renderer. */
     LocalStorage* GetLocalStorage(mitk::BaseRenderer* renderer);
 
+    /** \brief Generates the outlines of the given iso lines in a slice of dose values.
+    *
+    * The slice is traversed once: for each pixel edge, the outlines of all iso lines whose dose value lies
+    * between the values of the two adjacent pixels are generated at once. Each line is colored by its iso line.
+    \param pixels: The dose values of the slice, row by row
+    \param extent: The extent of the slice, only the first four values are used
+    \param mmPerPixel: The spacing of the slice
+    \param depth: The z coordinate of the outlines
+    \param isoLines: The iso lines to outline
+    \note This code is based on code from the iil library.
+    */
+    static vtkSmartPointer<vtkPolyData> CreateOutlinePolyData(const float *pixels,
+                                                              const int extent[6],
+                                                              const mitk::ScalarType mmPerPixel[2],
+                                                              float depth,
+                                                              const std::vector<IsoLine> &isoLines);
+
     /** \brief Set the default properties for general image rendering. */
     static void SetDefaultProperties(mitk::DataNode* node, mitk::BaseRenderer* renderer = nullptr, bool overwrite = false);
 
@@ -225,11 +288,18 @@ namespace mitk {
     */
     void GeneratePlane(mitk::BaseRenderer* renderer, double planeBounds[6]);
 
-    /** \brief Generates a vtkPolyData object containing the outline of a given binary slice.
+    /** \brief Generates a vtkPolyData object containing the outlines of all given iso lines in the current slice.
     \param renderer: Pointer to the renderer containing the needed information
-    \note This code is based on code from the iil library.
+    \param isoLines: The iso lines to outline
+    */
+    vtkSmartPointer<vtkPolyData> CreateOutlinePolyData(mitk::BaseRenderer* renderer, const std::vector<IsoLine>& isoLines);
+
+    /** \brief Returns the outlines of the visible iso levels in the current slice.
+    *
+    * The outlines are taken from the cache of the local storage, if they have been generated for the
+    * same slice, dose image and iso levels before. Otherwise they are generated by CreateOutlinePolyData().
     */
-    vtkSmartPointer<vtkPolyData> CreateOutlinePolyData(mitk::BaseRenderer* renderer);
+    vtkSmartPointer<vtkPolyData> GetOutlinePolyData(mitk::BaseRenderer* renderer, const int resliceSettings[3]);
 
     /** Default constructor */
     DoseImageVtkMapper2D();
@@ -294,7 +364,8 @@ namespace mitk {
     bool RenderingGeometryIntersectsImage( const PlaneGeometry* renderingGeometry, SlicedGeometry3D* imageGeometry );
 
   private:
-    void CreateLevelOutline(mitk::BaseRenderer* renderer, const mitk::IsoDoseLevel* level, float pref, vtkSmartPointer<vtkPoints> points, vtkSmartPointer<vtkCellArray> lines,  vtkSmartPointer<vtkUnsignedCharArray> colors);
+    /** \brief Collects the dose values and colors of the visible iso levels and free iso values. */
+    std::vector<IsoLine> GetVisibleIsoLines() const;
 
   };
 
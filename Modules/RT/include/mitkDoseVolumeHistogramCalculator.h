@@ -0,0 +1,139 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDoseVolumeHistogramCalculator_h
+#define mitkDoseVolumeHistogramCalculator_h
+
+#include <MitkRTExports.h>
+
+#include <mitkImage.h>
+#include <mitkLabelSetImage.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mitk
+{
+  /**
+  \brief Dose volume histogram (DVH) of one structure.
+
+  The dose axis is divided into bins of equal width, starting at 0 Gy. Volumes are given in ml.
+  */
+  struct MITKRT_EXPORT DoseVolumeHistogram
+  {
+    using ChartDataType = std::vector<std::pair<double, double>>;
+
+    LabelSetImage::LabelValueType labelValue = LabelSetImage::UnlabeledValue;
+    std::string name;
+    /** \brief Width of each dose bin in Gy.*/
+    double binWidth = 0.0;
+    /** \brief Volume of the structure in ml.*/
+    double volume = 0.0;
+    double minimumDose = 0.0;
+    double maximumDose = 0.0;
+    double meanDose = 0.0;
+    /** \brief Volume that receives a dose in [i * binWidth, (i + 1) * binWidth) for each bin i.*/
+    std::vector<double> differentialVolumes;
+    /** \brief Volume that receives a dose of at least i * binWidth for each bin i.*/
+    std::vector<double> cumulativeVolumes;
+
+    /** \brief Returns the cumulative DVH as (dose, volume) pairs, as expected by QmitkChartWidget::AddData2D().
+    \param relative If true, the volumes are given in percent of the structure volume, otherwise in ml.*/
+    ChartDataType GetCumulativeChartData(bool relative = true) const;
+
+    /** \brief Returns the differential DVH as (dose, volume) pairs, as expected by QmitkChartWidget::AddData2D().
+    The dose of each pair is the center of its bin.
+    \param relative If true, the volumes are given in percent of the structure volume, otherwise in ml.*/
+    ChartDataType GetDifferentialChartData(bool relative = false) const;
+  };
+
+  /**
+  \brief Computes the dose volume histograms of all labels of a LabelSetImage in one pass.
+
+  The structure image is traversed once, split into slabs that are processed by several threads.
+  Each structure voxel is mapped onto the dose grid without resampling the dose: the voxel is divided
+  into Subdivisions^3 sub-voxels, and each sub-voxel adds its volume to the dose voxel that contains its
+  center. Therefore, structure voxels that straddle several dose voxels are weighted fractionally, and
+  structure images with a finer grid than the dose image are handled exactly.
+  Structure voxels outside of the dose image receive a dose of 0 Gy.
+
+  The histograms of all labels are computed at once, when the first one is requested after the
+  inputs or parameters have changed.
+  */
+  class MITKRT_EXPORT DoseVolumeHistogramCalculator : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(DoseVolumeHistogramCalculator, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    using LabelValueType = LabelSetImage::LabelValueType;
+    using HistogramMapType = std::map<LabelValueType, DoseVolumeHistogram>;
+
+    /** \brief Dose image with dose values in Gy.*/
+    itkSetConstObjectMacro(DoseImage, Image);
+    itkGetConstObjectMacro(DoseImage, Image);
+
+    /** \brief Structures whose DVHs are computed. Each label is one structure.*/
+    itkSetConstObjectMacro(StructureImage, LabelSetImage);
+    itkGetConstObjectMacro(StructureImage, LabelSetImage);
+
+    /** \brief Time step of the dose image and (if it has more than one) the structure image. Default is 0.*/
+    itkSetMacro(TimeStep, TimeStepType);
+    itkGetConstMacro(TimeStep, TimeStepType);
+
+    /** \brief Width of the dose bins in Gy. Default is 0.1 Gy.*/
+    itkSetMacro(BinWidth, double);
+    itkGetConstMacro(BinWidth, double);
+
+    /** \brief Number of sub-voxels per structure voxel along each axis. Default is 2.*/
+    itkSetMacro(Subdivisions, unsigned int);
+    itkGetConstMacro(Subdivisions, unsigned int);
+
+    /** \brief Number of computing threads. 0 (default) uses all cores.*/
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetConstMacro(NumberOfThreads, unsigned int);
+
+    /** \brief Returns the DVHs of all labels of the structure image.
+    If the DVHs are not computed yet, the computation is done as well.*/
+    const HistogramMapType &GetHistograms();
+
+    /** \brief Returns the DVH of the label with the given value.
+    If the DVHs are not computed yet, the computation is done as well.
+    \exception mitk::Exception if the structure image has no label with the given value.*/
+    const DoseVolumeHistogram &GetHistogram(LabelValueType labelValue);
+
+  protected:
+    DoseVolumeHistogramCalculator();
+    ~DoseVolumeHistogramCalculator() override;
+
+  private:
+    bool IsUpdateRequired() const;
+    void Compute();
+
+    template <typename TPixel, unsigned int VImageDimension>
+    void InternalCompute(const itk::Image<TPixel, VImageDimension> *doseImage, const BaseGeometry *doseGeometry);
+
+    Image::ConstPointer m_DoseImage;
+    LabelSetImage::ConstPointer m_StructureImage;
+    TimeStepType m_TimeStep;
+    double m_BinWidth;
+    unsigned int m_Subdivisions;
+    unsigned int m_NumberOfThreads;
+
+    HistogramMapType m_Histograms;
+    itk::TimeStamp m_ComputeTime;
+  };
+}
+
+#endif
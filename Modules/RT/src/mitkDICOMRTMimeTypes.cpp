@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include <mitkDICOMRTMimeTypes.h>
 
+#include <mitkFileProbe.h>
 #include <mitkIOMimeTypes.h>
 
 #include <mitkDICOMDCMTKTagScanner.h>
@@ -77,6 +78,12 @@ bool DICOMRTMimeTypes::RTDoseMimeType::AppliesTo(const std::string &path) const
 
 std::string DICOMRTMimeTypes::GetModality(const std::string & path)
 {
+  // Usually the modality is found in the shared header of the file, so the three
+  // RT mime-types do not have to scan the file on their own.
+  std::string modality;
+  if (FileProbe::Get(path)->FindDicomElement(0x0008, 0x0060, modality))
+    return modality;
+
   const auto modalityTagPath = DICOMTagPath(0x0008, 0x0060);
 
   mitk::DICOMDCMTKTagScanner::Pointer scanner = mitk::DICOMDCMTKTagScanner::New();
@@ -85,7 +92,6 @@ std::string DICOMRTMimeTypes::GetModality(const std::string & path)
   scanner->Scan();
 
   mitk::DICOMDatasetAccessingImageFrameList frames = scanner->GetFrameInfoList();
-  std::string modality = "";
   if (frames.empty())
     return modality;
   auto findings = frames.front()->GetTagValueAsString(modalityTagPath);
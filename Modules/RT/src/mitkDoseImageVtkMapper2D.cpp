@@ -58,6 +58,10 @@ found in the LICENSE file.
 // ITK
 #include <itkRGBAPixel.h>
 
+// STL
+#include <algorithm>
+#include <numeric>
+
 mitk::DoseImageVtkMapper2D::DoseImageVtkMapper2D()
 {
 }
@@ -164,12 +168,12 @@ void mitk::DoseImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *ren
 
   // Initialize the interpolation mode for resampling; switch to nearest
   // neighbor if the input image is too small.
+  int interpolationMode = VTK_RESLICE_NEAREST;
   if ((input->GetDimension() >= 3) && (input->GetDimension(2) > 1))
   {
     VtkResliceInterpolationProperty *resliceInterpolationProperty;
     datanode->GetProperty(resliceInterpolationProperty, "reslice interpolation");
 
-    int interpolationMode = VTK_RESLICE_NEAREST;
     if (resliceInterpolationProperty != nullptr)
     {
       interpolationMode = resliceInterpolationProperty->GetInterpolation();
@@ -327,8 +331,9 @@ void mitk::DoseImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *ren
 
   if (showIsoLines) // contour rendering
   {
-    // generate contours/outlines
-    localStorage->m_OutlinePolyData = CreateOutlinePolyData(renderer);
+    // generate contours/outlines, unless they have already been generated for this slice
+    const int resliceSettings[3] = {thickSlicesMode, thickSlicesNum, interpolationMode};
+    localStorage->m_OutlinePolyData = this->GetOutlinePolyData(renderer, resliceSettings);
 
     float binaryOutlineWidth(1.0);
     if (datanode->GetFloatProperty("outline width", binaryOutlineWidth, renderer))
@@ -842,43 +847,127 @@ mitk::DoseImageVtkMapper2D::LocalStorage *mitk::DoseImageVtkMapper2D::GetLocalSt
   return m_LSH.GetLocalStorage(renderer);
 }
 
-vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(mitk::BaseRenderer *renderer)
+bool mitk::DoseImageVtkMapper2D::OutlineCacheKey::operator==(const OutlineCacheKey &other) const
 {
-  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();      // the points to draw
-  vtkSmartPointer<vtkCellArray> lines = vtkSmartPointer<vtkCellArray>::New(); // the lines to connect the points
-  vtkSmartPointer<vtkUnsignedCharArray> colors = vtkSmartPointer<vtkUnsignedCharArray>::New();
-  colors->SetNumberOfComponents(3);
-  colors->SetName("Colors");
+  auto isoLineEqual = [](const IsoLine &first, const IsoLine &second) {
+    return first.doseValue == second.doseValue && std::equal(first.color, first.color + 3, second.color);
+  };
+
+  return std::equal(resliceAxes, resliceAxes + 16, other.resliceAxes) &&
+         std::equal(extent, extent + 6, other.extent) && std::equal(spacing, spacing + 2, other.spacing) &&
+         std::equal(resliceSettings, resliceSettings + 3, other.resliceSettings) && timeStep == other.timeStep &&
+         doseModifiedTime == other.doseModifiedTime && depth == other.depth &&
+         isoLines.size() == other.isoLines.size() &&
+         std::equal(isoLines.begin(), isoLines.end(), other.isoLines.begin(), isoLineEqual);
+}
+
+std::vector<mitk::DoseImageVtkMapper2D::IsoLine> mitk::DoseImageVtkMapper2D::GetVisibleIsoLines() const
+{
+  std::vector<IsoLine> isoLines;
 
-  float pref;
+  float pref = 0.0f;
   this->GetDataNode()->GetFloatProperty(mitk::RTConstants::REFERENCE_DOSE_PROPERTY_NAME.c_str(), pref);
 
+  auto addIsoLine = [&isoLines, pref](const mitk::IsoDoseLevel *level) {
+    if (level->GetVisibleIsoLine())
+    {
+      mitk::IsoDoseLevel::ColorType isoColor = level->GetColor();
+      isoLines.push_back({level->GetDoseValue() * pref,
+                          {static_cast<unsigned char>(isoColor.GetRed() * 255),
+                           static_cast<unsigned char>(isoColor.GetGreen() * 255),
+                           static_cast<unsigned char>(isoColor.GetBlue() * 255)}});
+    }
+  };
+
   mitk::IsoDoseLevelSetProperty::Pointer propIsoSet = dynamic_cast<mitk::IsoDoseLevelSetProperty *>(
     GetDataNode()->GetProperty(mitk::RTConstants::DOSE_ISO_LEVELS_PROPERTY_NAME.c_str()));
-  mitk::IsoDoseLevelSet::Pointer isoDoseLevelSet = propIsoSet->GetValue();
-
-  for (mitk::IsoDoseLevelSet::ConstIterator doseIT = isoDoseLevelSet->Begin(); doseIT != isoDoseLevelSet->End();
-       ++doseIT)
+  if (propIsoSet.IsNotNull())
   {
-    if (doseIT->GetVisibleIsoLine())
+    mitk::IsoDoseLevelSet::Pointer isoDoseLevelSet = propIsoSet->GetValue();
+    for (mitk::IsoDoseLevelSet::ConstIterator doseIT = isoDoseLevelSet->Begin(); doseIT != isoDoseLevelSet->End();
+         ++doseIT)
     {
-      this->CreateLevelOutline(renderer, &(doseIT.Value()), pref, points, lines, colors);
-    } // end of if visible dose value
-  }   // end of loop over all does values
+      addIsoLine(&(doseIT.Value()));
+    }
+  }
 
   mitk::IsoDoseLevelVectorProperty::Pointer propfreeIsoVec = dynamic_cast<mitk::IsoDoseLevelVectorProperty *>(
     GetDataNode()->GetProperty(mitk::RTConstants::DOSE_FREE_ISO_VALUES_PROPERTY_NAME.c_str()));
-  mitk::IsoDoseLevelVector::Pointer frereIsoDoseLevelVec = propfreeIsoVec->GetValue();
-
-  for (mitk::IsoDoseLevelVector::ConstIterator freeDoseIT = frereIsoDoseLevelVec->Begin();
-       freeDoseIT != frereIsoDoseLevelVec->End();
-       ++freeDoseIT)
+  if (propfreeIsoVec.IsNotNull())
   {
-    if (freeDoseIT->Value()->GetVisibleIsoLine())
+    mitk::IsoDoseLevelVector::Pointer freeIsoDoseLevelVec = propfreeIsoVec->GetValue();
+    for (mitk::IsoDoseLevelVector::ConstIterator freeDoseIT = freeIsoDoseLevelVec->Begin();
+         freeDoseIT != freeIsoDoseLevelVec->End();
+         ++freeDoseIT)
     {
-      this->CreateLevelOutline(renderer, freeDoseIT->Value(), pref, points, lines, colors);
-    } // end of if visible dose value
-  }   // end of loop over all does values
+      addIsoLine(freeDoseIT->Value());
+    }
+  }
+
+  return isoLines;
+}
+
+vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::GetOutlinePolyData(mitk::BaseRenderer *renderer,
+                                                                            const int resliceSettings[3])
+{
+  LocalStorage *localStorage = this->GetLocalStorage(renderer);
+
+  OutlineCacheKey key;
+  vtkMatrix4x4 *resliceAxes = localStorage->m_Reslicer->GetResliceAxes();
+  for (int i = 0; i < 16; ++i)
+  {
+    key.resliceAxes[i] = resliceAxes->GetElement(i / 4, i % 4);
+  }
+  localStorage->m_ReslicedImage->GetExtent(key.extent);
+  key.spacing[0] = localStorage->m_mmPerPixel[0];
+  key.spacing[1] = localStorage->m_mmPerPixel[1];
+  std::copy(resliceSettings, resliceSettings + 3, key.resliceSettings);
+  key.timeStep = this->GetTimestep();
+  key.doseModifiedTime = this->GetInput()->GetMTime();
+  key.depth = this->CalculateLayerDepth(renderer);
+  key.isoLines = this->GetVisibleIsoLines();
+
+  vtkSmartPointer<vtkPolyData> polyData = localStorage->GetCachedOutline(key);
+  if (polyData == nullptr)
+  {
+    polyData = this->CreateOutlinePolyData(renderer, key.isoLines);
+    localStorage->CacheOutline(key, polyData);
+  }
+
+  return polyData;
+}
+
+vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(mitk::BaseRenderer *renderer,
+                                                                               const std::vector<IsoLine> &isoLines)
+{
+  LocalStorage *localStorage = this->GetLocalStorage(renderer);
+
+  // We take the pointer to the first pixel of the image
+  const float *pixels = static_cast<float *>(localStorage->m_ReslicedImage->GetScalarPointer());
+
+  if (!pixels)
+  {
+    mitkThrow() << "currentPixel invalid";
+  }
+
+  return CreateOutlinePolyData(pixels,
+                               localStorage->m_ReslicedImage->GetExtent(),
+                               localStorage->m_mmPerPixel,
+                               this->CalculateLayerDepth(renderer),
+                               isoLines);
+}
+
+vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(const float *pixels,
+                                                                               const int extent[6],
+                                                                               const mitk::ScalarType mmPerPixel[2],
+                                                                               float depth,
+                                                                               const std::vector<IsoLine> &isoLines)
+{
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();      // the points to draw
+  vtkSmartPointer<vtkCellArray> lines = vtkSmartPointer<vtkCellArray>::New(); // the lines to connect the points
+  vtkSmartPointer<vtkUnsignedCharArray> colors = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  colors->SetNumberOfComponents(3);
+  colors->SetName("Colors");
 
   // Create a polydata to store everything in
   vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
@@ -887,178 +976,114 @@ vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(m
   // Add the lines to the dataset
   polyData->SetLines(lines);
   polyData->GetCellData()->SetScalars(colors);
-  return polyData;
-}
 
-void mitk::DoseImageVtkMapper2D::CreateLevelOutline(mitk::BaseRenderer *renderer,
-                                                    const mitk::IsoDoseLevel *level,
-                                                    float pref,
-                                                    vtkSmartPointer<vtkPoints> points,
-                                                    vtkSmartPointer<vtkCellArray> lines,
-                                                    vtkSmartPointer<vtkUnsignedCharArray> colors)
-{
-  LocalStorage *localStorage = this->GetLocalStorage(renderer);
+  if (isoLines.empty())
+  {
+    return polyData;
+  }
 
   // get the min and max index values of each direction
-  int *extent = localStorage->m_ReslicedImage->GetExtent();
   int xMin = extent[0];
-  int xMax = extent[1];
   int yMin = extent[2];
-  int yMax = extent[3];
-
-  int *dims = localStorage->m_ReslicedImage->GetDimensions(); // dimensions of the image
-  int line = dims[0];                                         // how many pixels per line?
-  // get the depth for each contour
-  float depth = CalculateLayerDepth(renderer);
+  int width = extent[1] - extent[0] + 1;  // how many pixels per line?
+  int height = extent[3] - extent[2] + 1; // how many lines?
+
+  // Sort the iso lines by their dose value. The iso lines a pixel lies within (i.e. whose dose value
+  // is not larger than the pixel value) are then given by their number.
+  std::vector<std::size_t> order(isoLines.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&isoLines](std::size_t first, std::size_t second) {
+    return isoLines[first].doseValue < isoLines[second].doseValue;
+  });
+
+  std::vector<double> doseValues;
+  doseValues.reserve(order.size());
+  for (auto index : order)
+  {
+    doseValues.push_back(isoLines[index].doseValue);
+  }
 
-  double doseValue = level->GetDoseValue() * pref;
-  mitk::IsoDoseLevel::ColorType isoColor = level->GetColor();
-  unsigned char colorLine[3] = {static_cast<unsigned char>(isoColor.GetRed() * 255),
-                                static_cast<unsigned char>(isoColor.GetGreen() * 255),
-                                static_cast<unsigned char>(isoColor.GetBlue() * 255)};
+  std::vector<unsigned int> levels(static_cast<std::size_t>(width) * height);
+  for (std::size_t i = 0; i < levels.size(); ++i)
+  {
+    const float pixelValue = pixels[i];
+    levels[i] = static_cast<unsigned int>(
+      std::partition_point(doseValues.begin(), doseValues.end(), [pixelValue](double doseValue) {
+        return pixelValue >= doseValue;
+      }) - doseValues.begin());
+  }
 
-  int x = xMin; // pixel index x
-  int y = yMin; // pixel index y
-  float *currentPixel;
+  // each pixel corner is inserted once and shared by all lines that touch it
+  std::vector<vtkIdType> cornerIds(static_cast<std::size_t>(width + 1) * (height + 1), -1);
+  auto getCornerId = [&](int x, int y) {
+    vtkIdType &cornerId = cornerIds[static_cast<std::size_t>(y) * (width + 1) + x];
+    if (cornerId < 0)
+    {
+      cornerId = points->InsertNextPoint((xMin + x) * mmPerPixel[0], (yMin + y) * mmPerPixel[1], depth);
+    }
+    return cornerId;
+  };
 
-  // We take the pointer to the first pixel of the image
-  currentPixel = static_cast<float *>(localStorage->m_ReslicedImage->GetScalarPointer());
+  // adds the line between two pixel corners for the iso lines [firstLevel, lastLevel)
+  auto addLines = [&](int x1, int y1, int x2, int y2, unsigned int firstLevel, unsigned int lastLevel) {
+    if (firstLevel >= lastLevel)
+    {
+      return;
+    }
 
-  if (!currentPixel){
-    mitkThrow() << "currentPixel invalid";
-  }
+    vtkIdType lineIds[2] = {getCornerId(x1, y1), getCornerId(x2, y2)};
+    for (unsigned int level = firstLevel; level < lastLevel; ++level)
+    {
+      lines->InsertNextCell(2, lineIds);
+      colors->InsertNextTypedTuple(isoLines[order[level]].color);
+    }
+  };
 
-  while (y <= yMax)
+  for (int y = 0; y < height; ++y)
   {
-    // if the current pixel value is set to something
-    if ((currentPixel) && (*currentPixel >= doseValue))
+    for (int x = 0; x < width; ++x)
     {
-      // check in which direction a line is necessary
-      // a line is added if the neighbor of the current pixel has the value 0
-      // and if the pixel is located at the edge of the image
-
-      // if   vvvvv  not the first line vvvvv
-      if (y > yMin && *(currentPixel - line) < doseValue)
-      { // x direction - bottom edge of the pixel
-        // add the 2 points
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 =
-          points->InsertNextPoint((x + 1) * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        // add the line between both points
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
-      }
-
-      // if   vvvvv  not the last line vvvvv
-      if (y < yMax && *(currentPixel + line) < doseValue)
-      { // x direction - top edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 = points->InsertNextPoint(
-          (x + 1) * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
-      }
+      const unsigned int level = levels[static_cast<std::size_t>(y) * width + x];
 
-      // if   vvvvv  not the first pixel vvvvv
-      if ((x > xMin || y > yMin) && *(currentPixel - 1) < doseValue)
-      { // y direction - left edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
+      // a pixel edge between two pixels is part of all iso lines whose dose value lies
+      // between both pixel values; each of these edges is visited once from its left / bottom pixel
+      if (x + 1 < width)
+      { // y direction - right edge of the pixel
+        const unsigned int rightLevel = levels[static_cast<std::size_t>(y) * width + x + 1];
+        addLines(x + 1, y, x + 1, y + 1, std::min(level, rightLevel), std::max(level, rightLevel));
       }
 
-      // if   vvvvv  not the last pixel vvvvv
-      if ((y < yMax || (x < xMax)) && *(currentPixel + 1) < doseValue)
-      { // y direction - right edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint((x + 1) * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 = points->InsertNextPoint(
-          (x + 1) * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
+      if (y + 1 < height)
+      { // x direction - top edge of the pixel
+        const unsigned int topLevel = levels[static_cast<std::size_t>(y + 1) * width + x];
+        addLines(x, y + 1, x + 1, y + 1, std::min(level, topLevel), std::max(level, topLevel));
       }
 
-      /*  now consider pixels at the edge of the image  */
+      /*  now consider pixels at the edge of the image, which are part of all iso lines the pixel lies within  */
 
-      // if   vvvvv  left edge of image vvvvv
-      if (x == xMin)
+      if (x == 0)
       { // draw left edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
+        addLines(x, y, x, y + 1, 0, level);
       }
 
-      // if   vvvvv  right edge of image vvvvv
-      if (x == xMax)
+      if (x == width - 1)
       { // draw right edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint((x + 1) * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 = points->InsertNextPoint(
-          (x + 1) * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
+        addLines(x + 1, y, x + 1, y + 1, 0, level);
       }
 
-      // if   vvvvv  bottom edge of image vvvvv
-      if (y == yMin)
+      if (y == 0)
       { // draw bottom edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 =
-          points->InsertNextPoint((x + 1) * localStorage->m_mmPerPixel[0], y * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
+        addLines(x, y, x + 1, y, 0, level);
       }
 
-      // if   vvvvv  top edge of image vvvvv
-      if (y == yMax)
+      if (y == height - 1)
       { // draw top edge of the pixel
-        vtkIdType p1 =
-          points->InsertNextPoint(x * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        vtkIdType p2 = points->InsertNextPoint(
-          (x + 1) * localStorage->m_mmPerPixel[0], (y + 1) * localStorage->m_mmPerPixel[1], depth);
-        lines->InsertNextCell(2);
-        lines->InsertCellPoint(p1);
-        lines->InsertCellPoint(p2);
-        colors->InsertNextTypedTuple(colorLine);
+        addLines(x, y + 1, x + 1, y + 1, 0, level);
       }
-    } // end if currentpixel is set
-
-    x++;
-
-    if (x > xMax)
-    { // reached end of line
-      x = xMin;
-      y++;
     }
+  }
 
-    // Increase the pointer-position to the next pixel.
-    // This is safe, as the while-loop and the x-reset logic above makes
-    // sure we do not exceed the bounds of the image
-    currentPixel++;
-  } // end of while
+  return polyData;
 }
 
 void mitk::DoseImageVtkMapper2D::TransformActor(mitk::BaseRenderer *renderer)
@@ -1161,3 +1186,26 @@ mitk::DoseImageVtkMapper2D::LocalStorage::LocalStorage()
   m_Actors->AddPart(outlineShadowActor);
   m_Actors->AddPart(m_Actor);
 }
+
+vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::LocalStorage::GetCachedOutline(const OutlineCacheKey &key)
+{
+  auto cachedOutline =
+    std::find_if(m_OutlineCache.begin(), m_OutlineCache.end(), [&key](const auto &entry) { return entry.first == key; });
+  if (cachedOutline == m_OutlineCache.end())
+  {
+    return nullptr;
+  }
+
+  // move the outline to the front, since it is the most recently used one now
+  m_OutlineCache.splice(m_OutlineCache.begin(), m_OutlineCache, cachedOutline);
+  return m_OutlineCache.front().second;
+}
+
+void mitk::DoseImageVtkMapper2D::LocalStorage::CacheOutline(const OutlineCacheKey &key, vtkPolyData *outline)
+{
+  m_OutlineCache.emplace_front(key, outline);
+  if (m_OutlineCache.size() > MaximumNumberOfCachedOutlines)
+  {
+    m_OutlineCache.pop_back();
+  }
+}
@@ -0,0 +1,364 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDoseVolumeHistogramCalculator.h"
+
+#include <mitkImageAccessByItk.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageTimeSelector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <thread>
+
+namespace
+{
+  /** Volumes and doses of one label, accumulated by one thread.*/
+  struct LabelAccumulator
+  {
+    std::vector<double> differentialVolumes;
+    double volume = 0.0;
+    double weightedDoseSum = 0.0;
+    double minimumDose = std::numeric_limits<double>::max();
+    double maximumDose = std::numeric_limits<double>::lowest();
+  };
+
+  mitk::DoseVolumeHistogram::ChartDataType GetChartData(const std::vector<double> &volumes,
+                                                        double binWidth,
+                                                        double binOffset,
+                                                        double volumeScale)
+  {
+    mitk::DoseVolumeHistogram::ChartDataType chartData;
+    chartData.reserve(volumes.size());
+    for (std::size_t bin = 0; bin < volumes.size(); ++bin)
+    {
+      chartData.emplace_back((bin + binOffset) * binWidth, volumes[bin] * volumeScale);
+    }
+
+    return chartData;
+  }
+}
+
+mitk::DoseVolumeHistogram::ChartDataType mitk::DoseVolumeHistogram::GetCumulativeChartData(bool relative) const
+{
+  return GetChartData(cumulativeVolumes, binWidth, 0.0, relative && volume > 0.0 ? 100.0 / volume : 1.0);
+}
+
+mitk::DoseVolumeHistogram::ChartDataType mitk::DoseVolumeHistogram::GetDifferentialChartData(bool relative) const
+{
+  return GetChartData(differentialVolumes, binWidth, 0.5, relative && volume > 0.0 ? 100.0 / volume : 1.0);
+}
+
+mitk::DoseVolumeHistogramCalculator::DoseVolumeHistogramCalculator()
+  : m_TimeStep(0), m_BinWidth(0.1), m_Subdivisions(2), m_NumberOfThreads(0)
+{
+}
+
+mitk::DoseVolumeHistogramCalculator::~DoseVolumeHistogramCalculator()
+{
+}
+
+const mitk::DoseVolumeHistogramCalculator::HistogramMapType &mitk::DoseVolumeHistogramCalculator::GetHistograms()
+{
+  if (this->IsUpdateRequired())
+  {
+    this->Compute();
+  }
+
+  return m_Histograms;
+}
+
+const mitk::DoseVolumeHistogram &mitk::DoseVolumeHistogramCalculator::GetHistogram(LabelValueType labelValue)
+{
+  const auto &histograms = this->GetHistograms();
+  auto histogram = histograms.find(labelValue);
+  if (histogram == histograms.end())
+  {
+    mitkThrow() << "The structure image has no label with value " << labelValue << ".";
+  }
+
+  return histogram->second;
+}
+
+bool mitk::DoseVolumeHistogramCalculator::IsUpdateRequired() const
+{
+  if (m_DoseImage.IsNull() || m_StructureImage.IsNull())
+  {
+    return true;
+  }
+
+  return m_ComputeTime < this->GetMTime() || m_ComputeTime < m_DoseImage->GetMTime() ||
+         m_ComputeTime < m_StructureImage->GetMTime();
+}
+
+void mitk::DoseVolumeHistogramCalculator::Compute()
+{
+  if (m_DoseImage.IsNull())
+  {
+    mitkThrow() << "Dose image not set.";
+  }
+
+  if (m_StructureImage.IsNull())
+  {
+    mitkThrow() << "Structure image not set.";
+  }
+
+  if (m_BinWidth <= 0.0)
+  {
+    mitkThrow() << "Invalid bin width " << m_BinWidth << ". The bin width has to be positive.";
+  }
+
+  if (!m_DoseImage->GetTimeGeometry()->IsValidTimeStep(m_TimeStep))
+  {
+    mitkThrow() << "Invalid time step " << m_TimeStep << " of the dose image.";
+  }
+
+  auto timeSelector = ImageTimeSelector::New();
+  timeSelector->SetInput(m_DoseImage);
+  timeSelector->SetTimeNr(m_TimeStep);
+  timeSelector->UpdateLargestPossibleRegion();
+
+  m_Histograms.clear();
+
+  try
+  {
+    AccessFixedDimensionByItk_1(timeSelector->GetOutput(), InternalCompute, 3, m_DoseImage->GetGeometry(m_TimeStep));
+  }
+  catch (const AccessByItkException &e)
+  {
+    mitkThrow() << "Unsupported dose image: " << e.what();
+  }
+
+  m_ComputeTime.Modified();
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+void mitk::DoseVolumeHistogramCalculator::InternalCompute(const itk::Image<TPixel, VImageDimension> *doseImage,
+                                                          const BaseGeometry *doseGeometry)
+{
+  const TPixel *doseBuffer = doseImage->GetBufferPointer();
+  const auto &doseSize = doseImage->GetBufferedRegion().GetSize();
+  const long doseDimensions[3] = {static_cast<long>(doseSize[0]), static_cast<long>(doseSize[1]), static_cast<long>(doseSize[2])};
+
+  // the maximum dose determines the number of bins
+  double maximumDose = 0.0;
+  const std::size_t numberOfDoseVoxels = doseImage->GetBufferedRegion().GetNumberOfPixels();
+  for (std::size_t i = 0; i < numberOfDoseVoxels; ++i)
+  {
+    maximumDose = std::max(maximumDose, static_cast<double>(doseBuffer[i]));
+  }
+  const std::size_t numberOfBins = static_cast<std::size_t>(maximumDose / m_BinWidth) + 1;
+
+  // the structure image may have a single time step only
+  const TimeStepType structureTimeStep = m_TimeStep < m_StructureImage->GetTimeSteps() ? m_TimeStep : 0;
+  const BaseGeometry *structureGeometry = m_StructureImage->GetGeometry(structureTimeStep);
+
+  // The mapping of structure voxel indices to continuous dose voxel indices is affine. It is given by the
+  // dose index of the first structure voxel and the dose index offsets of one step along each structure axis.
+  Point3D structureIndex, worldPoint, doseOrigin;
+  structureIndex.Fill(0.0);
+  structureGeometry->IndexToWorld(structureIndex, worldPoint);
+  doseGeometry->WorldToIndex(worldPoint, doseOrigin);
+
+  Vector3D doseAxes[3];
+  for (unsigned int axis = 0; axis < 3; ++axis)
+  {
+    Point3D doseIndex;
+    structureIndex.Fill(0.0);
+    structureIndex[axis] = 1.0;
+    structureGeometry->IndexToWorld(structureIndex, worldPoint);
+    doseGeometry->WorldToIndex(worldPoint, doseIndex);
+    doseAxes[axis] = doseIndex - doseOrigin;
+  }
+
+  // offsets of the sub-voxel centers relative to the voxel center, in dose voxel indices
+  const unsigned int subdivisions = std::max(m_Subdivisions, 1u);
+  std::vector<Vector3D> subVoxelOffsets;
+  for (unsigned int k = 0; k < subdivisions; ++k)
+  {
+    for (unsigned int j = 0; j < subdivisions; ++j)
+    {
+      for (unsigned int i = 0; i < subdivisions; ++i)
+      {
+        subVoxelOffsets.push_back(doseAxes[0] * ((i + 0.5) / subdivisions - 0.5) +
+                                  doseAxes[1] * ((j + 0.5) / subdivisions - 0.5) +
+                                  doseAxes[2] * ((k + 0.5) / subdivisions - 0.5));
+      }
+    }
+  }
+
+  // volume of a sub-voxel in ml
+  const Vector3D &spacing = structureGeometry->GetSpacing();
+  const double subVoxelVolume = spacing[0] * spacing[1] * spacing[2] / 1000.0 / subVoxelOffsets.size();
+
+  auto getDose = [&](const Point3D &doseIndex) {
+    // the dose voxel that contains the point; dose voxel centers are at integer indices
+    long index[3];
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+      index[axis] = static_cast<long>(std::floor(doseIndex[axis] + 0.5));
+      if (index[axis] < 0 || index[axis] >= doseDimensions[axis])
+      {
+        return 0.0;
+      }
+    }
+
+    return static_cast<double>(doseBuffer[(index[2] * doseDimensions[1] + index[1]) * doseDimensions[0] + index[0]]);
+  };
+
+  // all labels of all layers; labels of different layers may overlap
+  std::vector<Label::ConstPointer> labels;
+  for (unsigned int layer = 0; layer < m_StructureImage->GetNumberOfLayers(); ++layer)
+  {
+    auto layerLabels = m_StructureImage->GetLabelsInGroup(layer);
+    labels.insert(labels.end(), layerLabels.begin(), layerLabels.end());
+  }
+
+  unsigned int numberOfThreads = 0 != m_NumberOfThreads ? m_NumberOfThreads : std::thread::hardware_concurrency();
+  numberOfThreads = std::max(numberOfThreads, 1u);
+  std::vector<std::vector<LabelAccumulator>> accumulators(numberOfThreads, std::vector<LabelAccumulator>(labels.size()));
+
+  std::size_t firstLabelOfLayer = 0;
+  for (unsigned int layer = 0; layer < m_StructureImage->GetNumberOfLayers(); ++layer)
+  {
+    auto layerLabels = m_StructureImage->GetLabelsInGroup(layer);
+    if (layerLabels.empty())
+    {
+      continue;
+    }
+
+    // lookup of the label index by the pixel value; -1 for pixel values without label
+    std::vector<int> labelIndices;
+    for (std::size_t i = 0; i < layerLabels.size(); ++i)
+    {
+      auto labelValue = layerLabels[i]->GetValue();
+      if (labelIndices.size() <= labelValue)
+      {
+        labelIndices.resize(labelValue + 1, -1);
+      }
+      labelIndices[labelValue] = static_cast<int>(firstLabelOfLayer + i);
+    }
+    firstLabelOfLayer += layerLabels.size();
+
+    const Image *layerImage = m_StructureImage->GetActiveLayer() != layer
+      ? m_StructureImage->GetLayerImage(layer)
+      : m_StructureImage.GetPointer();
+
+    ImageReadAccessor layerAccessor(layerImage, layerImage->GetVolumeData(structureTimeStep));
+    const auto *labelBuffer = static_cast<const LabelValueType *>(layerAccessor.GetData());
+    const unsigned int structureDimensions[3] = {
+      layerImage->GetDimension(0), layerImage->GetDimension(1), layerImage->GetDimension(2)};
+
+    // each thread accumulates the volumes of a slab of slices
+    auto processSlab = [&](unsigned int firstSlice, unsigned int endSlice, std::vector<LabelAccumulator> &threadAccumulators) {
+      for (unsigned int z = firstSlice; z < endSlice; ++z)
+      {
+        for (unsigned int y = 0; y < structureDimensions[1]; ++y)
+        {
+          const LabelValueType *labelRow = labelBuffer + (static_cast<std::size_t>(z) * structureDimensions[1] + y) * structureDimensions[0];
+          for (unsigned int x = 0; x < structureDimensions[0]; ++x)
+          {
+            const LabelValueType labelValue = labelRow[x];
+            if (LabelSetImage::UnlabeledValue == labelValue || labelIndices.size() <= labelValue || labelIndices[labelValue] < 0)
+            {
+              continue;
+            }
+
+            auto &accumulator = threadAccumulators[labelIndices[labelValue]];
+            if (accumulator.differentialVolumes.empty())
+            {
+              accumulator.differentialVolumes.resize(numberOfBins, 0.0);
+            }
+
+            const Point3D voxelCenter = doseOrigin + doseAxes[0] * x + doseAxes[1] * y + doseAxes[2] * z;
+            for (const auto &subVoxelOffset : subVoxelOffsets)
+            {
+              const double dose = getDose(voxelCenter + subVoxelOffset);
+              const auto bin = std::min(static_cast<std::size_t>(std::max(dose, 0.0) / m_BinWidth), numberOfBins - 1);
+              accumulator.differentialVolumes[bin] += subVoxelVolume;
+              accumulator.weightedDoseSum += dose * subVoxelVolume;
+              accumulator.minimumDose = std::min(accumulator.minimumDose, dose);
+              accumulator.maximumDose = std::max(accumulator.maximumDose, dose);
+            }
+            accumulator.volume += subVoxelVolume * subVoxelOffsets.size();
+          }
+        }
+      }
+    };
+
+    const unsigned int numberOfSlices = structureDimensions[2];
+    const unsigned int numberOfLayerThreads = std::min(numberOfThreads, std::max(numberOfSlices, 1u));
+    std::vector<std::thread> threads;
+    for (unsigned int thread = 1; thread < numberOfLayerThreads; ++thread)
+    {
+      threads.emplace_back(processSlab,
+                           numberOfSlices * thread / numberOfLayerThreads,
+                           numberOfSlices * (thread + 1) / numberOfLayerThreads,
+                           std::ref(accumulators[thread]));
+    }
+    processSlab(0, numberOfSlices / numberOfLayerThreads, accumulators[0]);
+
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+  }
+
+  // merge the accumulators of all threads
+  for (std::size_t i = 0; i < labels.size(); ++i)
+  {
+    DoseVolumeHistogram histogram;
+    histogram.labelValue = labels[i]->GetValue();
+    histogram.name = labels[i]->GetName();
+    histogram.binWidth = m_BinWidth;
+    histogram.differentialVolumes.resize(numberOfBins, 0.0);
+
+    double weightedDoseSum = 0.0;
+    double minimumDose = std::numeric_limits<double>::max();
+    double maximumDose = std::numeric_limits<double>::lowest();
+    for (const auto &threadAccumulators : accumulators)
+    {
+      const auto &accumulator = threadAccumulators[i];
+      if (accumulator.differentialVolumes.empty())
+      {
+        continue;
+      }
+
+      std::transform(histogram.differentialVolumes.begin(), histogram.differentialVolumes.end(),
+                     accumulator.differentialVolumes.begin(), histogram.differentialVolumes.begin(), std::plus<double>());
+      histogram.volume += accumulator.volume;
+      weightedDoseSum += accumulator.weightedDoseSum;
+      minimumDose = std::min(minimumDose, accumulator.minimumDose);
+      maximumDose = std::max(maximumDose, accumulator.maximumDose);
+    }
+
+    if (histogram.volume > 0.0)
+    {
+      histogram.minimumDose = minimumDose;
+      histogram.maximumDose = maximumDose;
+      histogram.meanDose = weightedDoseSum / histogram.volume;
+    }
+
+    // the cumulative volume of a bin is the volume of the bin and all bins with higher doses
+    histogram.cumulativeVolumes.resize(numberOfBins);
+    double cumulativeVolume = 0.0;
+    for (std::size_t bin = numberOfBins; bin > 0; --bin)
+    {
+      cumulativeVolume += histogram.differentialVolumes[bin - 1];
+      histogram.cumulativeVolumes[bin - 1] = cumulativeVolume;
+    }
+
+    m_Histograms[histogram.labelValue] = std::move(histogram);
+  }
+}
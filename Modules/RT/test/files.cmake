@@ -1,4 +1,6 @@
 SET(MODULE_TESTS
+  mitkDoseImageVtkMapper2DTest.cpp
+  mitkDoseVolumeHistogramCalculatorTest.cpp
   mitkRTStructureSetReaderServiceTest.cpp
   mitkRTDoseReaderServiceTest.cpp
   mitkRTPlanReaderServiceTest.cpp
@@ -0,0 +1,293 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+
+#include <mitkDoseImageVtkMapper2D.h>
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkIdList.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkUnsignedCharArray.h>
+
+#include <algorithm>
+#include <array>
+#include <set>
+#include <vector>
+
+class mitkDoseImageVtkMapper2DTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDoseImageVtkMapper2DTestSuite);
+  MITK_TEST(TestOutlineEqualsPerLevelOutline);
+  MITK_TEST(TestOutlineSharesPoints);
+  MITK_TEST(TestOutlineWithoutIsoLines);
+  MITK_TEST(TestCacheHitOnUnchangedSlice);
+  MITK_TEST(TestCacheMissAfterIsoLineChange);
+  MITK_TEST(TestCacheMissAfterSliceChange);
+  MITK_TEST(TestCacheKeepsRecentlyUsedSlices);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  using IsoLine = mitk::DoseImageVtkMapper2D::IsoLine;
+  using OutlineCacheKey = mitk::DoseImageVtkMapper2D::OutlineCacheKey;
+
+  /** end points (ordered) and color of a line */
+  using Segment = std::array<double, 7>;
+
+  static constexpr int Width = 6;
+  static constexpr int Height = 5;
+
+  std::vector<float> m_Pixels;
+  int m_Extent[6];
+  mitk::ScalarType m_Spacing[2];
+  std::vector<IsoLine> m_IsoLines;
+
+  static Segment MakeSegment(const double p1[3], const double p2[3], const unsigned char color[3])
+  {
+    const bool swap = p2[0] < p1[0] || (p2[0] == p1[0] && p2[1] < p1[1]);
+    const double *first = swap ? p2 : p1;
+    const double *second = swap ? p1 : p2;
+    return {first[0], first[1], second[0], second[1], double(color[0]), double(color[1]), double(color[2])};
+  }
+
+  static std::vector<Segment> GetSegments(vtkPolyData *polyData)
+  {
+    std::vector<Segment> segments;
+    auto *colors = vtkUnsignedCharArray::SafeDownCast(polyData->GetCellData()->GetScalars());
+    auto idList = vtkSmartPointer<vtkIdList>::New();
+    vtkCellArray *lines = polyData->GetLines();
+    lines->InitTraversal();
+    for (vtkIdType cell = 0; lines->GetNextCell(idList); ++cell)
+    {
+      CPPUNIT_ASSERT_EQUAL(vtkIdType(2), idList->GetNumberOfIds());
+      double p1[3], p2[3];
+      polyData->GetPoint(idList->GetId(0), p1);
+      polyData->GetPoint(idList->GetId(1), p2);
+      unsigned char color[3];
+      colors->GetTypedTuple(cell, color);
+      segments.push_back(MakeSegment(p1, p2, color));
+    }
+    return segments;
+  }
+
+  /** The outline of a single iso line as it was generated before all iso lines were outlined in one pass. */
+  void AddPerLevelOutline(const IsoLine &isoLine, std::vector<Segment> &segments) const
+  {
+    const int xMin = m_Extent[0];
+    const int xMax = m_Extent[1];
+    const int yMin = m_Extent[2];
+    const int yMax = m_Extent[3];
+    const int line = Width;
+    const double doseValue = isoLine.doseValue;
+
+    auto addLine = [&](double x1, double y1, double x2, double y2) {
+      const double p1[3] = {x1 * m_Spacing[0], y1 * m_Spacing[1], 0.0};
+      const double p2[3] = {x2 * m_Spacing[0], y2 * m_Spacing[1], 0.0};
+      segments.push_back(MakeSegment(p1, p2, isoLine.color));
+    };
+
+    int x = xMin;
+    int y = yMin;
+    const float *currentPixel = m_Pixels.data();
+    while (y <= yMax)
+    {
+      if (*currentPixel >= doseValue)
+      {
+        if (y > yMin && *(currentPixel - line) < doseValue)
+          addLine(x, y, x + 1, y);
+        if (y < yMax && *(currentPixel + line) < doseValue)
+          addLine(x, y + 1, x + 1, y + 1);
+        if ((x > xMin || y > yMin) && *(currentPixel - 1) < doseValue)
+          addLine(x, y, x, y + 1);
+        if ((y < yMax || (x < xMax)) && *(currentPixel + 1) < doseValue)
+          addLine(x + 1, y, x + 1, y + 1);
+
+        if (x == xMin)
+          addLine(x, y, x, y + 1);
+        if (x == xMax)
+          addLine(x + 1, y, x + 1, y + 1);
+        if (y == yMin)
+          addLine(x, y, x + 1, y);
+        if (y == yMax)
+          addLine(x, y + 1, x + 1, y + 1);
+      }
+
+      x++;
+      if (x > xMax)
+      {
+        x = xMin;
+        y++;
+      }
+      currentPixel++;
+    }
+  }
+
+  OutlineCacheKey CreateCacheKey(double sliceOffset) const
+  {
+    OutlineCacheKey key;
+    for (int i = 0; i < 16; ++i)
+      key.resliceAxes[i] = (i % 5 == 0) ? 1.0 : 0.0;
+    key.resliceAxes[11] = sliceOffset;
+    std::copy(m_Extent, m_Extent + 6, key.extent);
+    key.spacing[0] = m_Spacing[0];
+    key.spacing[1] = m_Spacing[1];
+    key.resliceSettings[0] = 0;
+    key.resliceSettings[1] = 1;
+    key.resliceSettings[2] = 0;
+    key.timeStep = 0;
+    key.doseModifiedTime = 42;
+    key.depth = 0.0f;
+    key.isoLines = m_IsoLines;
+    return key;
+  }
+
+public:
+  void setUp() override
+  {
+    // a small dose slice with a hot spot, values equal to dose values and non-zero extent start
+    m_Pixels = {
+      0.0f, 1.0f, 2.0f, 2.0f, 1.0f, 0.0f,
+      1.0f, 3.0f, 5.0f, 4.5f, 2.0f, 0.5f,
+      2.0f, 5.0f, 8.0f, 6.0f, 3.0f, 1.0f,
+      1.0f, 3.0f, 5.0f, 4.0f, 2.0f, 0.0f,
+      5.0f, 1.0f, 2.0f, 1.0f, 0.0f, 5.0f,
+    };
+    const int extent[6] = {2, 2 + Width - 1, 3, 3 + Height - 1, 0, 0};
+    std::copy(extent, extent + 6, m_Extent);
+    m_Spacing[0] = 1.5;
+    m_Spacing[1] = 2.0;
+
+    // deliberately not sorted by dose value
+    m_IsoLines = {{5.0, {255, 0, 0}}, {2.0, {0, 255, 0}}, {7.5, {0, 0, 255}}, {0.5, {255, 255, 0}}};
+  }
+
+  void tearDown() override
+  {
+    m_Pixels.clear();
+    m_IsoLines.clear();
+  }
+
+  void TestOutlineEqualsPerLevelOutline()
+  {
+    auto polyData = mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(m_Pixels.data(), m_Extent, m_Spacing, 0.0f, m_IsoLines);
+    const auto segments = GetSegments(polyData);
+    const std::set<Segment> uniqueSegments(segments.begin(), segments.end());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Every line is generated once", uniqueSegments.size(), segments.size());
+
+    // The per-level outline drew some edges at the image border twice, so only distinct lines are compared.
+    std::vector<Segment> perLevelSegments;
+    for (const auto &isoLine : m_IsoLines)
+      this->AddPerLevelOutline(isoLine, perLevelSegments);
+    const std::set<Segment> uniquePerLevelSegments(perLevelSegments.begin(), perLevelSegments.end());
+
+    CPPUNIT_ASSERT_MESSAGE("The per-level outline is not empty", !uniquePerLevelSegments.empty());
+    CPPUNIT_ASSERT_MESSAGE("Same lines as the per-level outline", uniqueSegments == uniquePerLevelSegments);
+  }
+
+  void TestOutlineSharesPoints()
+  {
+    auto polyData = mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(m_Pixels.data(), m_Extent, m_Spacing, 3.0f, m_IsoLines);
+
+    std::set<std::array<double, 3>> uniquePoints;
+    for (vtkIdType i = 0; i < polyData->GetNumberOfPoints(); ++i)
+    {
+      std::array<double, 3> point;
+      polyData->GetPoint(i, point.data());
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Depth of the outline", 3.0, point[2]);
+      uniquePoints.insert(point);
+    }
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Pixel corners are shared between lines",
+                                 uniquePoints.size(), static_cast<std::size_t>(polyData->GetNumberOfPoints()));
+    CPPUNIT_ASSERT(polyData->GetNumberOfPoints() <= (Width + 1) * (Height + 1));
+  }
+
+  void TestOutlineWithoutIsoLines()
+  {
+    auto polyData = mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(
+      m_Pixels.data(), m_Extent, m_Spacing, 0.0f, std::vector<IsoLine>());
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), polyData->GetNumberOfCells());
+  }
+
+  void TestCacheHitOnUnchangedSlice()
+  {
+    mitk::DoseImageVtkMapper2D::LocalStorage localStorage;
+    CPPUNIT_ASSERT_MESSAGE("Empty cache", localStorage.GetCachedOutline(this->CreateCacheKey(0.0)) == nullptr);
+
+    auto outline = vtkSmartPointer<vtkPolyData>::New();
+    localStorage.CacheOutline(this->CreateCacheKey(0.0), outline);
+    CPPUNIT_ASSERT_MESSAGE("Cached outline of an unchanged slice",
+                           localStorage.GetCachedOutline(this->CreateCacheKey(0.0)) == outline);
+  }
+
+  void TestCacheMissAfterIsoLineChange()
+  {
+    mitk::DoseImageVtkMapper2D::LocalStorage localStorage;
+    localStorage.CacheOutline(this->CreateCacheKey(0.0), vtkSmartPointer<vtkPolyData>::New());
+
+    auto key = this->CreateCacheKey(0.0);
+    key.isoLines[1].doseValue = 2.5;
+    CPPUNIT_ASSERT_MESSAGE("Changed dose value of an iso level", localStorage.GetCachedOutline(key) == nullptr);
+
+    key = this->CreateCacheKey(0.0);
+    key.isoLines[1].color[0] = 128;
+    CPPUNIT_ASSERT_MESSAGE("Changed color of an iso level", localStorage.GetCachedOutline(key) == nullptr);
+
+    key = this->CreateCacheKey(0.0);
+    key.isoLines.pop_back();
+    CPPUNIT_ASSERT_MESSAGE("Hidden iso level", localStorage.GetCachedOutline(key) == nullptr);
+
+    key = this->CreateCacheKey(0.0);
+    key.doseModifiedTime += 1;
+    CPPUNIT_ASSERT_MESSAGE("Modified dose image", localStorage.GetCachedOutline(key) == nullptr);
+  }
+
+  void TestCacheMissAfterSliceChange()
+  {
+    mitk::DoseImageVtkMapper2D::LocalStorage localStorage;
+    localStorage.CacheOutline(this->CreateCacheKey(0.0), vtkSmartPointer<vtkPolyData>::New());
+
+    CPPUNIT_ASSERT_MESSAGE("Other slice", localStorage.GetCachedOutline(this->CreateCacheKey(1.0)) == nullptr);
+
+    auto key = this->CreateCacheKey(0.0);
+    key.extent[1] += 1;
+    CPPUNIT_ASSERT_MESSAGE("Changed extent", localStorage.GetCachedOutline(key) == nullptr);
+
+    key = this->CreateCacheKey(0.0);
+    key.timeStep = 1;
+    CPPUNIT_ASSERT_MESSAGE("Other time step", localStorage.GetCachedOutline(key) == nullptr);
+
+    CPPUNIT_ASSERT_MESSAGE("Still cached", localStorage.GetCachedOutline(this->CreateCacheKey(0.0)) != nullptr);
+  }
+
+  void TestCacheKeepsRecentlyUsedSlices()
+  {
+    mitk::DoseImageVtkMapper2D::LocalStorage localStorage;
+    const auto maximum = mitk::DoseImageVtkMapper2D::LocalStorage::MaximumNumberOfCachedOutlines;
+
+    for (std::size_t slice = 0; slice < maximum; ++slice)
+      localStorage.CacheOutline(this->CreateCacheKey(slice), vtkSmartPointer<vtkPolyData>::New());
+
+    // using the first slice makes the second one the least recently used slice
+    CPPUNIT_ASSERT(localStorage.GetCachedOutline(this->CreateCacheKey(0.0)) != nullptr);
+    localStorage.CacheOutline(this->CreateCacheKey(maximum), vtkSmartPointer<vtkPolyData>::New());
+
+    CPPUNIT_ASSERT_MESSAGE("Recently used slice is kept", localStorage.GetCachedOutline(this->CreateCacheKey(0.0)) != nullptr);
+    CPPUNIT_ASSERT_MESSAGE("Least recently used slice is removed", localStorage.GetCachedOutline(this->CreateCacheKey(1.0)) == nullptr);
+    CPPUNIT_ASSERT_MESSAGE("New slice is cached", localStorage.GetCachedOutline(this->CreateCacheKey(maximum)) != nullptr);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDoseImageVtkMapper2D)
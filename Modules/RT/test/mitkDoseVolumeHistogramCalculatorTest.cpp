@@ -0,0 +1,189 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+
+#include <mitkDoseVolumeHistogramCalculator.h>
+#include <mitkImagePixelWriteAccessor.h>
+
+class mitkDoseVolumeHistogramCalculatorTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDoseVolumeHistogramCalculatorTestSuite);
+  MITK_TEST(TestHistograms);
+  MITK_TEST(TestThreadsAndSubdivisions);
+  MITK_TEST(TestFractionalWeighting);
+  MITK_TEST(TestChartData);
+  MITK_TEST(TestInvalidLabel);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_DoseImage;
+  mitk::LabelSetImage::Pointer m_StructureImage;
+
+  static constexpr itk::IndexValueType Size = 10;
+
+  // dose image whose dose in Gy equals the x index of the voxel
+  static mitk::Image::Pointer CreateDoseImage()
+  {
+    unsigned int dimensions[3] = {Size, Size, Size};
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<float>(), 3, dimensions);
+
+    mitk::ImagePixelWriteAccessor<float, 3> accessor(image);
+    itk::Index<3> index;
+    for (index[2] = 0; index[2] < Size; ++index[2])
+      for (index[1] = 0; index[1] < Size; ++index[1])
+        for (index[0] = 0; index[0] < Size; ++index[0])
+          accessor.SetPixelByIndex(index, static_cast<float>(index[0]));
+
+    return image;
+  }
+
+  // structure image with label 1 in the voxels with x < 5 and label 2 in the other voxels
+  static mitk::LabelSetImage::Pointer CreateStructureImage(double originX)
+  {
+    unsigned int dimensions[3] = {Size, Size, Size};
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<mitk::LabelSetImage::LabelValueType>(), 3, dimensions);
+    mitk::Point3D origin;
+    origin.Fill(0.0);
+    origin[0] = originX;
+    image->GetGeometry()->SetOrigin(origin);
+
+    {
+      mitk::ImagePixelWriteAccessor<mitk::LabelSetImage::LabelValueType, 3> accessor(image);
+      itk::Index<3> index;
+      for (index[2] = 0; index[2] < Size; ++index[2])
+        for (index[1] = 0; index[1] < Size; ++index[1])
+          for (index[0] = 0; index[0] < Size; ++index[0])
+            accessor.SetPixelByIndex(index, index[0] < 5 ? 1 : 2);
+    }
+
+    auto structureImage = mitk::LabelSetImage::New();
+    structureImage->InitializeByLabeledImage(image);
+    return structureImage;
+  }
+
+  mitk::DoseVolumeHistogramCalculator::Pointer CreateCalculator(const mitk::LabelSetImage *structureImage)
+  {
+    auto calculator = mitk::DoseVolumeHistogramCalculator::New();
+    calculator->SetDoseImage(m_DoseImage);
+    calculator->SetStructureImage(structureImage);
+    calculator->SetBinWidth(1.0);
+    return calculator;
+  }
+
+public:
+  void setUp() override
+  {
+    m_DoseImage = CreateDoseImage();
+    m_StructureImage = CreateStructureImage(0.0);
+  }
+
+  void tearDown() override
+  {
+    m_DoseImage = nullptr;
+    m_StructureImage = nullptr;
+  }
+
+  void TestHistograms()
+  {
+    auto calculator = this->CreateCalculator(m_StructureImage);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Histograms of all labels are computed", std::size_t(2), calculator->GetHistograms().size());
+
+    const auto &histogram = calculator->GetHistogram(1);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Volume of the structure in ml", 0.5, histogram.volume, mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Minimum dose", 0.0, histogram.minimumDose, mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Maximum dose", 4.0, histogram.maximumDose, mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Mean dose", 2.0, histogram.meanDose, mitk::eps);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("One bin per Gy up to the maximum dose", std::size_t(10), histogram.differentialVolumes.size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Differential volume", 0.1, histogram.differentialVolumes[4], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Differential volume", 0.0, histogram.differentialVolumes[5], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Cumulative volume", 0.5, histogram.cumulativeVolumes[0], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Cumulative volume", 0.2, histogram.cumulativeVolumes[3], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Cumulative volume", 0.0, histogram.cumulativeVolumes[5], mitk::eps);
+
+    const auto &otherHistogram = calculator->GetHistogram(2);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Mean dose", 7.0, otherHistogram.meanDose, mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Cumulative volume", 0.5, otherHistogram.cumulativeVolumes[5], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Cumulative volume", 0.1, otherHistogram.cumulativeVolumes[9], mitk::eps);
+  }
+
+  void TestThreadsAndSubdivisions()
+  {
+    auto calculator = this->CreateCalculator(m_StructureImage);
+    calculator->SetNumberOfThreads(1);
+    calculator->SetSubdivisions(1);
+    auto reference = calculator->GetHistograms();
+
+    calculator->SetNumberOfThreads(4);
+    calculator->SetSubdivisions(3);
+    const auto &histograms = calculator->GetHistograms();
+
+    for (const auto &referenceHistogram : reference)
+    {
+      const auto &histogram = histograms.at(referenceHistogram.first);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Same volume", referenceHistogram.second.volume, histogram.volume, mitk::eps);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Same mean dose", referenceHistogram.second.meanDose, histogram.meanDose, mitk::eps);
+      for (std::size_t bin = 0; bin < histogram.differentialVolumes.size(); ++bin)
+      {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Same differential volumes",
+          referenceHistogram.second.differentialVolumes[bin], histogram.differentialVolumes[bin], mitk::eps);
+      }
+    }
+  }
+
+  void TestFractionalWeighting()
+  {
+    // each structure voxel covers one half of two neighboring dose voxels
+    auto shiftedStructureImage = CreateStructureImage(0.5);
+    auto calculator = this->CreateCalculator(shiftedStructureImage);
+
+    calculator->SetSubdivisions(1);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Voxel centers are mapped to one dose voxel", 3.0, calculator->GetHistogram(1).meanDose, mitk::eps);
+
+    calculator->SetSubdivisions(2);
+    const auto &histogram = calculator->GetHistogram(1);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Sub-voxels are weighted by their dose voxel", 2.5, histogram.meanDose, mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Volume is independent of the weighting", 0.5, histogram.volume, mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Half voxels at the lowest dose", 0.05, histogram.differentialVolumes[0], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Full voxels at the other doses", 0.1, histogram.differentialVolumes[1], mitk::eps);
+  }
+
+  void TestChartData()
+  {
+    auto calculator = this->CreateCalculator(m_StructureImage);
+    const auto &histogram = calculator->GetHistogram(1);
+
+    auto cumulative = histogram.GetCumulativeChartData();
+    CPPUNIT_ASSERT_EQUAL(histogram.cumulativeVolumes.size(), cumulative.size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Dose of the first bin", 0.0, cumulative[0].first, mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Whole structure receives at least 0 Gy", 100.0, cumulative[0].second, mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Relative volume", 40.0, cumulative[3].second, mitk::eps);
+
+    auto differential = histogram.GetDifferentialChartData();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Dose of the bin center", 0.5, differential[0].first, mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Absolute volume", 0.1, differential[0].second, mitk::eps);
+  }
+
+  void TestInvalidLabel()
+  {
+    auto calculator = this->CreateCalculator(m_StructureImage);
+    CPPUNIT_ASSERT_THROW(calculator->GetHistogram(42), mitk::Exception);
+
+    calculator->SetDoseImage(nullptr);
+    CPPUNIT_ASSERT_THROW(calculator->GetHistograms(), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDoseVolumeHistogramCalculator)
@@ -206,9 +206,13 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneUnzipped(const std::string &i
   }
 
   SceneReader::Pointer reader = SceneReader::New();
-  if (!reader->LoadScene(document, workingDir, storage))
   {
-    MITK_ERROR << "There were errors while loading scene file " << indexfilename << ". Your data may be corrupted";
+    // observers process the nodes of the scene at once instead of one by one
+    DataStorage::Batch batch(storage);
+    if (!reader->LoadScene(document, workingDir, storage))
+    {
+      MITK_ERROR << "There were errors while loading scene file " << indexfilename << ". Your data may be corrupted";
+    }
   }
 
   // return new data storage, even if empty or uncomplete (return as much as possible but notify calling method)
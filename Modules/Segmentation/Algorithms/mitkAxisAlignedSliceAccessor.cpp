@@ -0,0 +1,363 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkAxisAlignedSliceAccessor.h"
+
+#include <mitkAbstractTransformGeometry.h>
+#include <mitkExceptionMacro.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+  mitk::AxisAlignedSliceAccessor::RegionType GetRunRegion(const mitk::AxisAlignedSliceAccessor::RunLengthPatch::Run &run)
+  {
+    mitk::AxisAlignedSliceAccessor::RegionType region;
+    region.SetIndex(0, run.x);
+    region.SetIndex(1, run.y);
+    region.SetSize(0, run.length);
+    region.SetSize(1, 1);
+    return region;
+  }
+
+  // Tolerance (in voxels) for deciding whether the plane is aligned with the voxel grid
+  constexpr double AlignmentTolerance = 1e-3;
+
+  bool IsInteger(double value)
+  {
+    return std::abs(value - std::round(value)) < AlignmentTolerance;
+  }
+
+  // Returns the only volume axis the vector points to, or -1 if it is oblique.
+  int GetAlignedAxis(const mitk::Vector3D &vector, double length)
+  {
+    int axis = -1;
+    for (int i = 0; i < 3; ++i)
+    {
+      if (std::abs(std::abs(vector[i]) - length) < AlignmentTolerance)
+      {
+        axis = i;
+      }
+      else if (std::abs(vector[i]) >= AlignmentTolerance)
+      {
+        return -1;
+      }
+    }
+    return axis;
+  }
+}
+
+mitk::AxisAlignedSliceAccessor::AxisAlignedSliceAccessor(Image *volume, TimeStepType timeStep, const PlaneGeometry *plane)
+  : m_Volume(volume),
+    m_TimeStep(timeStep),
+    m_IsValid(false),
+    m_PixelSize(0),
+    m_Width(0),
+    m_Height(0),
+    m_FirstOffset(0),
+    m_StepX(0),
+    m_StepY(0),
+    m_AxisX(0),
+    m_AxisY(1)
+{
+  m_FirstIndex.Fill(0);
+
+  if (nullptr == volume || nullptr == plane || !volume->IsInitialized() || timeStep >= volume->GetTimeSteps())
+    return;
+
+  // non-rigid planes and multi-component images always need the reslicer
+  if (nullptr != dynamic_cast<const AbstractTransformGeometry *>(plane) ||
+      volume->GetPixelType().GetNumberOfComponents() != 1)
+    return;
+
+  const BaseGeometry *geometry = volume->GetGeometry(timeStep);
+  if (nullptr == geometry)
+    return;
+
+  // The extent of the slice is computed the same way as in ExtractSliceFilter: the length of the
+  // plane axes in voxels of the volume.
+  Vector3D right, bottom;
+  Point3D origin;
+  geometry->WorldToIndex(plane->GetAxisVector(0), right);
+  geometry->WorldToIndex(plane->GetAxisVector(1), bottom);
+  geometry->WorldToIndex(plane->GetOrigin(), origin);
+
+  const double width = right.GetNorm();
+  const double height = bottom.GetNorm();
+  if (!IsInteger(width) || !IsInteger(height) || width < 0.5 || height < 0.5)
+    return;
+
+  const int axisX = GetAlignedAxis(right, width);
+  const int axisY = GetAlignedAxis(bottom, height);
+  if (axisX < 0 || axisY < 0 || axisX == axisY)
+    return;
+  const int normalAxis = 3 - axisX - axisY;
+
+  // center of the first slice pixel
+  Point3D first = origin + right * (0.5 / width) + bottom * (0.5 / height);
+  if (!IsInteger(first[axisX]) || !IsInteger(first[axisY]))
+    return;
+
+  // a plane between two voxel layers would make the nearest neighbor undefined
+  const double fraction = first[normalAxis] - std::floor(first[normalAxis]);
+  if (std::abs(fraction - 0.5) < AlignmentTolerance)
+    return;
+
+  m_Width = static_cast<unsigned int>(std::round(width));
+  m_Height = static_cast<unsigned int>(std::round(height));
+  const int signX = right[axisX] > 0 ? 1 : -1;
+  const int signY = bottom[axisY] > 0 ? 1 : -1;
+
+  std::ptrdiff_t stride[3];
+  long firstIndex[3];
+  long lastIndex[3];
+  stride[0] = 1;
+  stride[1] = volume->GetDimension(0);
+  stride[2] = stride[1] * volume->GetDimension(1);
+  for (int i = 0; i < 3; ++i)
+  {
+    firstIndex[i] = std::lround(first[i]);
+  }
+  std::copy(firstIndex, firstIndex + 3, lastIndex);
+  lastIndex[axisX] += signX * static_cast<long>(m_Width - 1);
+  lastIndex[axisY] += signY * static_cast<long>(m_Height - 1);
+
+  for (int i = 0; i < 3; ++i)
+  {
+    const long dimension = volume->GetDimension(i);
+    if (firstIndex[i] < 0 || firstIndex[i] >= dimension || lastIndex[i] < 0 || lastIndex[i] >= dimension)
+      return;
+    m_FirstOffset += firstIndex[i] * stride[i];
+  }
+
+  for (int i = 0; i < 3; ++i)
+  {
+    m_FirstIndex[i] = firstIndex[i];
+  }
+  m_AxisX = axisX;
+  m_AxisY = axisY;
+  m_StepX = signX * stride[axisX];
+  m_StepY = signY * stride[axisY];
+  m_PixelSize = volume->GetPixelType().GetSize();
+  m_IsValid = true;
+}
+
+bool mitk::AxisAlignedSliceAccessor::IsCompatible(const Image *slice) const
+{
+  return m_IsValid && nullptr != slice && slice->IsInitialized() &&
+         slice->GetPixelType() == m_Volume->GetPixelType() && slice->GetDimension(0) == m_Width &&
+         slice->GetDimension(1) == m_Height && slice->GetDimension(2) == 1;
+}
+
+mitk::AxisAlignedSliceAccessor::RunLengthPatch mitk::AxisAlignedSliceAccessor::ComputeChangedRuns(const Image *slice) const
+{
+  if (!this->IsCompatible(slice))
+    mitkThrow() << "Cannot compare slice. Slice does not match the plane or the pixel type of the volume.";
+
+  // a gap of unchanged pixels that takes less memory than a run is stored as part of the run
+  const unsigned int maximumGap = std::max<unsigned int>(1, static_cast<unsigned int>(sizeof(RunLengthPatch::Run) / m_PixelSize));
+
+  ImageReadAccessor sliceAccess(slice, slice->GetVolumeData(0));
+  ImageReadAccessor volumeAccess(m_Volume, m_Volume->GetVolumeData(m_TimeStep));
+  const auto *sliceData = static_cast<const char *>(sliceAccess.GetData());
+  const auto *volumeData = static_cast<const char *>(volumeAccess.GetData());
+  const auto pixelSize = static_cast<std::ptrdiff_t>(m_PixelSize);
+
+  RunLengthPatch patch;
+  for (unsigned int y = 0; y < m_Height; ++y)
+  {
+    const char *sliceLine = sliceData + y * m_Width * m_PixelSize;
+    const char *volumeLine = volumeData + (m_FirstOffset + y * m_StepY) * pixelSize;
+
+    if (m_StepX == 1 && 0 == std::memcmp(sliceLine, volumeLine, m_Width * m_PixelSize))
+      continue;
+
+    bool isRunOpen = false;
+    unsigned int lastChangedX = 0;
+    for (unsigned int x = 0; x < m_Width; ++x)
+    {
+      if (0 == std::memcmp(sliceLine + x * m_PixelSize, volumeLine + x * m_StepX * pixelSize, m_PixelSize))
+        continue;
+
+      if (isRunOpen && x - lastChangedX <= maximumGap)
+      {
+        patch.runs.back().length = x - patch.runs.back().x + 1;
+      }
+      else
+      {
+        patch.runs.push_back({x, y, 1});
+        isRunOpen = true;
+      }
+      lastChangedX = x;
+    }
+  }
+
+  std::size_t numberOfPixels = 0;
+  for (const auto &run : patch.runs)
+    numberOfPixels += run.length;
+  patch.values.resize(numberOfPixels * m_PixelSize);
+
+  auto *values = patch.values.data();
+  for (const auto &run : patch.runs)
+  {
+    std::memcpy(values, sliceData + (run.y * m_Width + run.x) * m_PixelSize, run.length * m_PixelSize);
+    values += run.length * m_PixelSize;
+  }
+  return patch;
+}
+
+mitk::AxisAlignedSliceAccessor::RunLengthPatch mitk::AxisAlignedSliceAccessor::ReadRuns(const RunLengthPatch &patch) const
+{
+  if (!m_IsValid)
+    mitkThrow() << "Cannot read runs. Plane is not aligned with the volume.";
+
+  RunLengthPatch result;
+  result.runs = patch.runs;
+
+  std::size_t numberOfPixels = 0;
+  for (const auto &run : result.runs)
+  {
+    if (run.y >= m_Height || run.x >= m_Width || run.length > m_Width - run.x)
+      mitkThrow() << "Cannot read runs. Run exceeds the slice.";
+    numberOfPixels += run.length;
+  }
+  result.values.resize(numberOfPixels * m_PixelSize);
+
+  auto *values = result.values.data();
+  for (const auto &run : result.runs)
+  {
+    this->CopyFromVolume(values, run.length, GetRunRegion(run));
+    values += run.length * m_PixelSize;
+  }
+  return result;
+}
+
+void mitk::AxisAlignedSliceAccessor::WriteRuns(const RunLengthPatch &patch)
+{
+  if (!m_IsValid)
+    mitkThrow() << "Cannot write runs. Plane is not aligned with the volume.";
+
+  std::size_t numberOfPixels = 0;
+  for (const auto &run : patch.runs)
+  {
+    if (run.y >= m_Height || run.x >= m_Width || run.length > m_Width - run.x)
+      mitkThrow() << "Cannot write runs. Run exceeds the slice.";
+    numberOfPixels += run.length;
+  }
+  if (patch.values.size() != numberOfPixels * m_PixelSize)
+    mitkThrow() << "Cannot write runs. Values do not match the runs or the pixel type of the volume.";
+
+  const auto *values = patch.values.data();
+  for (const auto &run : patch.runs)
+  {
+    this->CopyToVolume(values, run.length, GetRunRegion(run));
+    values += run.length * m_PixelSize;
+  }
+}
+
+mitk::AxisAlignedSliceAccessor::RegionType mitk::AxisAlignedSliceAccessor::RunLengthPatch::GetBoundingRegion() const
+{
+  RegionType region;
+  if (runs.empty())
+    return region;
+
+  region = GetRunRegion(runs.front());
+  for (const auto &run : runs)
+  {
+    const auto runRegion = GetRunRegion(run);
+    RegionType::IndexType lower, upper;
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+      lower[i] = std::min(region.GetIndex(i), runRegion.GetIndex(i));
+      upper[i] = std::max(region.GetUpperIndex()[i], runRegion.GetUpperIndex()[i]);
+    }
+    region.SetIndex(lower);
+    region.SetUpperIndex(upper);
+  }
+  return region;
+}
+
+void mitk::AxisAlignedSliceAccessor::CopyFromVolume(char *buffer, std::size_t lineLength, const RegionType &region) const
+{
+  ImageReadAccessor volumeAccess(m_Volume, m_Volume->GetVolumeData(m_TimeStep));
+  const auto *volumeData = static_cast<const char *>(volumeAccess.GetData());
+  const auto pixelSize = static_cast<std::ptrdiff_t>(m_PixelSize);
+
+  for (unsigned int y = 0; y < region.GetSize(1); ++y)
+  {
+    char *line = buffer + y * lineLength * m_PixelSize;
+    const char *volumeLine = volumeData + (m_FirstOffset + (region.GetIndex(0) * m_StepX) +
+                                           (region.GetIndex(1) + y) * m_StepY) * pixelSize;
+    if (m_StepX == 1)
+    {
+      std::memcpy(line, volumeLine, region.GetSize(0) * m_PixelSize);
+      continue;
+    }
+    for (unsigned int x = 0; x < region.GetSize(0); ++x)
+    {
+      std::memcpy(line + x * m_PixelSize, volumeLine + x * m_StepX * pixelSize, m_PixelSize);
+    }
+  }
+}
+
+void mitk::AxisAlignedSliceAccessor::CopyToVolume(const char *buffer, std::size_t lineLength, const RegionType &region)
+{
+  ImageWriteAccessor volumeAccess(m_Volume, m_Volume->GetVolumeData(m_TimeStep));
+  auto *volumeData = static_cast<char *>(volumeAccess.GetData());
+  const auto pixelSize = static_cast<std::ptrdiff_t>(m_PixelSize);
+
+  for (unsigned int y = 0; y < region.GetSize(1); ++y)
+  {
+    const char *line = buffer + y * lineLength * m_PixelSize;
+    char *volumeLine = volumeData + (m_FirstOffset + (region.GetIndex(0) * m_StepX) +
+                                     (region.GetIndex(1) + y) * m_StepY) * pixelSize;
+    if (m_StepX == 1)
+    {
+      std::memcpy(volumeLine, line, region.GetSize(0) * m_PixelSize);
+      continue;
+    }
+    for (unsigned int x = 0; x < region.GetSize(0); ++x)
+    {
+      std::memcpy(volumeLine + x * m_StepX * pixelSize, line + x * m_PixelSize, m_PixelSize);
+    }
+  }
+}
+
+itk::ImageRegion<3> mitk::AxisAlignedSliceAccessor::GetVolumeRegion(const RegionType &region) const
+{
+  itk::ImageRegion<3> volumeRegion;
+  if (!m_IsValid || 0 == region.GetNumberOfPixels())
+    return volumeRegion;
+
+  // the steps are negative for flipped axes, so the corners of the slice region are not ordered in the volume
+  const itk::IndexValueType signX = m_StepX < 0 ? -1 : 1;
+  const itk::IndexValueType signY = m_StepY < 0 ? -1 : 1;
+  itk::Index<3> lower = m_FirstIndex;
+  itk::Index<3> upper = m_FirstIndex;
+  lower[m_AxisX] += signX * region.GetIndex(0);
+  upper[m_AxisX] += signX * region.GetUpperIndex()[0];
+  lower[m_AxisY] += signY * region.GetIndex(1);
+  upper[m_AxisY] += signY * region.GetUpperIndex()[1];
+  for (int i = 0; i < 3; ++i)
+  {
+    if (upper[i] < lower[i])
+      std::swap(lower[i], upper[i]);
+  }
+
+  volumeRegion.SetIndex(lower);
+  volumeRegion.SetUpperIndex(upper);
+  return volumeRegion;
+}
@@ -0,0 +1,112 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkAxisAlignedSliceAccessor_h
+#define mitkAxisAlignedSliceAccessor_h
+
+#include <MitkSegmentationExports.h>
+#include <mitkImage.h>
+#include <mitkPlaneGeometry.h>
+
+#include <itkImageRegion.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace mitk
+{
+  /** \brief Reads and writes the pixels of a slice directly in the buffer of an image volume.
+
+    ExtractSliceFilter together with mitkVtkImageOverwrite maps every pixel of a slice through
+    vtkImageReslice, which is needed for oblique planes. If the plane is aligned with the axes of the
+    volume, each slice pixel corresponds to exactly one voxel and the slice can be copied row by row.
+    The accessor checks whether this is the case (see IsValid()) and then accesses the same voxels the
+    reslicer would access with nearest neighbor interpolation.
+
+    All regions are given in index coordinates of the slice that ExtractSliceFilter extracts for the plane.
+  */
+  class MITKSEGMENTATION_EXPORT AxisAlignedSliceAccessor
+  {
+  public:
+    typedef itk::ImageRegion<2> RegionType;
+
+    /** \brief Runs of consecutive pixels in the lines of a slice together with their values.
+
+      Only the pixels of the runs are stored, so for an edit the memory scales with the number of
+      changed pixels instead of the size of the slice.
+    */
+    struct RunLengthPatch
+    {
+      struct Run
+      {
+        unsigned int x;
+        unsigned int y;
+        unsigned int length;
+      };
+
+      std::vector<Run> runs;
+      /** Pixel values of all runs, concatenated in the order of the runs.*/
+      std::vector<char> values;
+
+      bool IsEmpty() const { return runs.empty(); }
+      /** \brief Smallest region of the slice that contains all runs.*/
+      RegionType GetBoundingRegion() const;
+    };
+
+    AxisAlignedSliceAccessor(Image *volume, TimeStepType timeStep, const PlaneGeometry *plane);
+
+    /** \brief True if the plane is aligned with the axes of the volume and lies completely inside of it.*/
+    bool IsValid() const { return m_IsValid; }
+
+    /** \brief True if the slice has the extent of the plane and the pixel type of the volume.*/
+    bool IsCompatible(const Image *slice) const;
+
+    /** \brief Runs of the slice pixels which differ from the volume, with the values of the slice.
+      Runs separated by only a few unchanged pixels are merged, because storing a run costs more than
+      storing these pixels.*/
+    RunLengthPatch ComputeChangedRuns(const Image *slice) const;
+
+    /** \brief Reads the runs of the given patch from the volume, e.g. for undoing WriteRuns().*/
+    RunLengthPatch ReadRuns(const RunLengthPatch &patch) const;
+
+    /** \brief Writes the values of the runs into the volume. All other voxels are not touched.*/
+    void WriteRuns(const RunLengthPatch &patch);
+
+    /** \brief Voxels of the volume that correspond to the given region of the slice,
+      e.g. for announcing the modification with Image::RegionModified().*/
+    itk::ImageRegion<3> GetVolumeRegion(const RegionType &region) const;
+
+  private:
+    /** Copy the pixels of the region between the volume and a buffer that starts with the first pixel
+      of the region and whose lines have the given length (in pixels).*/
+    void CopyFromVolume(char *buffer, std::size_t lineLength, const RegionType &region) const;
+    void CopyToVolume(const char *buffer, std::size_t lineLength, const RegionType &region);
+
+    Image::Pointer m_Volume;
+    TimeStepType m_TimeStep;
+    bool m_IsValid;
+    std::size_t m_PixelSize;
+    unsigned int m_Width;
+    unsigned int m_Height;
+    // Voxel offsets in the buffer of the time step, i.e. pixel (x, y) of the slice is the voxel
+    // m_FirstOffset + x * m_StepX + y * m_StepY
+    std::ptrdiff_t m_FirstOffset;
+    std::ptrdiff_t m_StepX;
+    std::ptrdiff_t m_StepY;
+    // Volume index of the first slice pixel and the volume axes of the slice axes
+    itk::Index<3> m_FirstIndex;
+    int m_AxisX;
+    int m_AxisY;
+  };
+}
+
+#endif
@@ -16,6 +16,8 @@ found in the LICENSE file.
 
 #include <itkCommand.h>
 
+#include <utility>
+
 mitk::DiffSliceOperation::DiffSliceOperation() : Operation(1)
 {
   m_TimeStep = 0;
@@ -24,6 +26,7 @@ mitk::DiffSliceOperation::DiffSliceOperation() : Operation(1)
   m_SliceGeometry = nullptr;
   m_ImageIsValid = false;
   m_DeleteObserverTag = 0;
+  m_IsPatch = false;
 }
 
 mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
@@ -51,6 +54,7 @@ mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
 
   m_Image = imageVolume;
   m_DeleteObserverTag = 0;
+  m_IsPatch = false;
 
   if (m_Image)
   {
@@ -67,6 +71,17 @@ mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
     m_ImageIsValid = false;
 }
 
+mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
+                                             AxisAlignedSliceAccessor::RunLengthPatch patch,
+                                             const SlicedGeometry3D *sliceGeometry,
+                                             TimeStepType timestep,
+                                             const BaseGeometry *currentWorldGeometry)
+  : DiffSliceOperation(imageVolume, nullptr, sliceGeometry, timestep, currentWorldGeometry)
+{
+  m_IsPatch = true;
+  m_Patch = std::move(patch);
+}
+
 mitk::DiffSliceOperation::~DiffSliceOperation()
 {
   m_WorldGeometry = nullptr;
@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include "mitkCompressedImageContainer.h"
 #include <MitkSegmentationExports.h>
+#include <mitkAxisAlignedSliceAccessor.h>
 #include <mitkOperation.h>
 
 #include <vtkSmartPointer.h>
@@ -57,6 +58,16 @@ namespace mitk
                        const TimeStepType timestep,
                        const BaseGeometry *currentWorldGeometry);
 
+    /** \brief Creates an operation that only holds the runs of the slice pixels that were changed.
+
+      Only planes that are aligned with the axes of the volume are supported (see AxisAlignedSliceAccessor).
+    */
+    DiffSliceOperation(mitk::Image *imageVolume,
+                       AxisAlignedSliceAccessor::RunLengthPatch patch,
+                       const SlicedGeometry3D *sliceGeometry,
+                       const TimeStepType timestep,
+                       const BaseGeometry *currentWorldGeometry);
+
     /** \brief Check if it is a valid operation.*/
     bool IsValid();
 
@@ -67,6 +78,12 @@ namespace mitk
     /** \brief Get the slice that is applied in the operation.*/
     Image::Pointer GetSlice();
 
+    /** \brief True if the operation holds a patch instead of a slice. GetSlice() returns nullptr then.*/
+    bool IsPatch() const { return this->m_IsPatch; }
+
+    /** \brief Get the runs of the slice that are applied in the operation.*/
+    const AxisAlignedSliceAccessor::RunLengthPatch &GetPatch() const { return this->m_Patch; }
+
     /** \brief Set timeStep*/
     TimeStepType GetTimeStep() const { return this->m_TimeStep; }
     /** \brief Get the axis where the slice has to be applied in the volume.*/
@@ -95,6 +112,10 @@ namespace mitk
 
     unsigned long m_DeleteObserverTag;
 
+    bool m_IsPatch;
+
+    AxisAlignedSliceAccessor::RunLengthPatch m_Patch;
+
     mitk::BaseGeometry::ConstPointer m_GuardReferenceGeometry;
   };
 }
@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "mitkDiffSliceOperationApplier.h"
 
+#include "mitkAxisAlignedSliceAccessor.h"
 #include "mitkDiffSliceOperation.h"
 #include "mitkRenderingManager.h"
 #include "mitkSegTool2D.h"
@@ -40,31 +41,52 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
   // check if the operation is valid
   if (imageOperation->IsValid())
   {
-    // the actual overwrite filter (vtk)
-    vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
-
-    mitk::Image::Pointer slice = imageOperation->GetSlice();
-    // Set the slice as 'input'
-    reslice->SetInputSlice(slice->GetVtkImageData());
-
-    // set overwrite mode to true to write back to the image volume
-    reslice->SetOverwriteMode(true);
-    reslice->Modified();
-
-    // a wrapper for vtkImageOverwrite
-    mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
-    extractor->SetInput(imageOperation->GetImage());
-    extractor->SetTimeStep(imageOperation->GetTimeStep());
-    extractor->SetWorldGeometry(dynamic_cast<const PlaneGeometry *>(imageOperation->GetWorldGeometry()));
-    extractor->SetVtkOutputRequest(true);
-    extractor->SetResliceTransformByGeometry(imageOperation->GetImage()->GetGeometry(imageOperation->GetTimeStep()));
-
-    extractor->Modified();
-    extractor->Update();
+    if (imageOperation->IsPatch())
+    {
+      // patches are only created for axis-aligned planes. Only the runs of changed pixels are written
+      // directly into the image buffer.
+      AxisAlignedSliceAccessor accessor(imageOperation->GetImage(),
+                                        imageOperation->GetTimeStep(),
+                                        dynamic_cast<const PlaneGeometry *>(imageOperation->GetWorldGeometry()));
+      if (!accessor.IsValid())
+      {
+        MITK_WARN << "Cannot apply slice patch. The plane is no longer aligned with the image.";
+        return;
+      }
+      accessor.WriteRuns(imageOperation->GetPatch());
+      imageOperation->GetImage()->RegionModified(accessor.GetVolumeRegion(imageOperation->GetPatch().GetBoundingRegion()),
+                                                 imageOperation->GetTimeStep());
+      imageOperation->GetImage()->GetVtkImageData(imageOperation->GetTimeStep())->Modified();
+    }
+    else
+    {
+      mitk::Image::Pointer slice = imageOperation->GetSlice();
+
+      // the actual overwrite filter (vtk)
+      vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+
+      // Set the slice as 'input'
+      reslice->SetInputSlice(slice->GetVtkImageData());
+
+      // set overwrite mode to true to write back to the image volume
+      reslice->SetOverwriteMode(true);
+      reslice->Modified();
+
+      // a wrapper for vtkImageOverwrite
+      mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
+      extractor->SetInput(imageOperation->GetImage());
+      extractor->SetTimeStep(imageOperation->GetTimeStep());
+      extractor->SetWorldGeometry(dynamic_cast<const PlaneGeometry *>(imageOperation->GetWorldGeometry()));
+      extractor->SetVtkOutputRequest(true);
+      extractor->SetResliceTransformByGeometry(imageOperation->GetImage()->GetGeometry(imageOperation->GetTimeStep()));
+
+      extractor->Modified();
+      extractor->Update();
+      imageOperation->GetImage()->Modified();
+    }
 
     // make sure the modification is rendered
     RenderingManager::GetInstance()->RequestUpdateAll();
-    imageOperation->GetImage()->Modified();
 
     mitk::ExtractSliceFilter::Pointer extractor2 = mitk::ExtractSliceFilter::New();
     extractor2->SetInput(imageOperation->GetImage());
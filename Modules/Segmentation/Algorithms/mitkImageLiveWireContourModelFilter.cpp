@@ -27,7 +27,11 @@ mitk::ImageLiveWireContourModelFilter::ImageLiveWireContourModelFilter()
   m_CostFunction = CostFunctionType::New();
   m_ShortestPathFilter = ShortestPathImageFilterType::New();
   m_ShortestPathFilter->SetCostFunction(m_CostFunction);
+  m_ShortestPathTree = ShortestPathTreeType::New();
+  m_ShortestPathTree->SetCostFunction(m_CostFunction);
   m_UseDynamicCostMap = false;
+  m_ShortestPathTreeUsesDynamicCostMap = false;
+  m_UseCostFunction = true;
   m_TimeStep = 0;
 }
 
@@ -124,17 +128,20 @@ void mitk::ImageLiveWireContourModelFilter::ItkPreProcessImage(const itk::Image<
   castFilter->SetInput(inputImage);
   castFilter->Update();
   m_InternalImage = castFilter->GetOutput();
+  m_ShortestPathTree->SetImage(m_InternalImage);
   m_CostFunction->SetImage(m_InternalImage);
   m_ShortestPathFilter->SetInput(m_InternalImage);
 }
 
 void mitk::ImageLiveWireContourModelFilter::ClearRepulsivePoints()
 {
+  m_ShortestPathTree->InvalidateCosts();
   m_CostFunction->ClearRepulsivePoints();
 }
 
 void mitk::ImageLiveWireContourModelFilter::AddRepulsivePoint(const itk::Index<2> &idx)
 {
+  m_ShortestPathTree->InvalidateCosts(idx);
   m_CostFunction->AddRepulsivePoint(idx);
 }
 
@@ -148,11 +155,13 @@ void mitk::ImageLiveWireContourModelFilter::DumpMaskImage()
 
 void mitk::ImageLiveWireContourModelFilter::RemoveRepulsivePoint(const itk::Index<2> &idx)
 {
+  m_ShortestPathTree->InvalidateCosts(idx);
   m_CostFunction->RemoveRepulsivePoint(idx);
 }
 
 void mitk::ImageLiveWireContourModelFilter::SetRepulsivePoints(const ShortestPathType &points)
 {
+  m_ShortestPathTree->InvalidateCosts();
   m_CostFunction->ClearRepulsivePoints();
 
   auto iter = points.begin();
@@ -187,30 +196,55 @@ void mitk::ImageLiveWireContourModelFilter::UpdateLiveWire()
   region.SetSize(size);
   region.SetIndex(startRegion);
 
-  // inputImage->SetRequestedRegion(region);
+  ShortestPathType shortestPath;
 
-  // extracts features from image and calculates costs
-  // m_CostFunction->SetImage(m_InternalImage);
-  m_CostFunction->SetStartIndex(startPoint);
-  m_CostFunction->SetEndIndex(endPoint);
-  m_CostFunction->SetRequestedRegion(region);
-  m_CostFunction->SetUseCostMap(m_UseDynamicCostMap);
+  if (m_UseCostFunction)
+  {
+    // the tree has to be stopped before the cost function is touched
+    if (m_UseDynamicCostMap != m_ShortestPathTreeUsesDynamicCostMap)
+    {
+      m_ShortestPathTree->InvalidateCosts();
+      m_ShortestPathTreeUsesDynamicCostMap = m_UseDynamicCostMap;
+    }
 
-  // calculate shortest path between start and end point
-  m_ShortestPathFilter->SetFullNeighborsMode(true);
-  // m_ShortestPathFilter->SetInput( m_CostFunction->SetImage(m_InternalImage) );
-  m_ShortestPathFilter->SetMakeOutputImage(false);
+    if (!m_ShortestPathTree->HasSource(startPoint))
+    {
+      m_ShortestPathTree->Stop();
 
-  // m_ShortestPathFilter->SetCalcAllDistances(true);
-  m_ShortestPathFilter->SetStartIndex(startPoint);
-  m_ShortestPathFilter->SetEndIndex(endPoint);
+      // extracts features from image and calculates costs
+      m_CostFunction->SetStartIndex(startPoint);
+      m_CostFunction->SetEndIndex(endPoint);
+      m_CostFunction->SetRequestedRegion(region);
+      m_CostFunction->SetUseCostMap(m_UseDynamicCostMap);
+      m_CostFunction->Initialize();
 
-  m_ShortestPathFilter->Update();
+      m_ShortestPathTree->SetSource(startPoint);
+    }
 
-  // construct contour from path image
-  // get the shortest path as vector
-  ShortestPathType shortestPath = m_ShortestPathFilter->GetVectorPath();
+    // walk back the shortest path tree from the end point
+    m_ShortestPathTree->GetPath(endPoint, shortestPath);
+  }
+  else
+  {
+    m_ShortestPathTree->Stop();
+
+    m_CostFunction->SetStartIndex(startPoint);
+    m_CostFunction->SetEndIndex(endPoint);
+    m_CostFunction->SetRequestedRegion(region);
+    m_CostFunction->SetUseCostMap(m_UseDynamicCostMap);
+
+    // calculate shortest path between start and end point
+    m_ShortestPathFilter->SetFullNeighborsMode(true);
+    m_ShortestPathFilter->SetMakeOutputImage(false);
+    m_ShortestPathFilter->SetStartIndex(startPoint);
+    m_ShortestPathFilter->SetEndIndex(endPoint);
+
+    m_ShortestPathFilter->Update();
 
+    shortestPath = m_ShortestPathFilter->GetVectorPath();
+  }
+
+  // construct contour from path image
   // fill the output contour with control points from the path
   OutputType::Pointer output = dynamic_cast<OutputType *>(this->MakeOutput(0).GetPointer());
   this->SetNthOutput(0, output.GetPointer());
@@ -431,6 +465,8 @@ void mitk::ImageLiveWireContourModelFilter::CreateDynamicCostMapByITK(
     max = (partRight1 + partRight2 + partLeft1 + partLeft2);
   }
 
+  // the shortest path tree must not evaluate the cost function while it changes
+  this->m_ShortestPathTree->InvalidateCosts();
   this->m_CostFunction->SetDynamicCostMap(histogram);
   this->m_CostFunction->SetCostMapMaximum(max);
 }
@@ -24,6 +24,7 @@ found in the LICENSE file.
 
 #include <itkShortestPathCostFunctionLiveWire.h>
 #include <itkShortestPathImageFilter.h>
+#include <itkShortestPathTree.h>
 
 namespace mitk
 {
@@ -39,6 +40,10 @@ namespace mitk
    \note On the fly training will only be used for next update.
    The computation uses the last calculated segment to map cost according to features in the area of the segment.
 
+   The paths are taken from a shortest path tree rooted at the start point (\sa itk::ShortestPathTree).
+   As long as the start point and the costs do not change, updating the end point (e.g. on mouse move)
+   only walks back the tree instead of running a new shortest path search.
+
    Caution: time support currently not available. Filter will always work on the first
    timestep in its current implementation.
 
@@ -59,6 +64,7 @@ namespace mitk
     typedef itk::Image<float, 2> InternalImageType;
     typedef itk::ShortestPathImageFilter<InternalImageType, InternalImageType> ShortestPathImageFilterType;
     typedef itk::ShortestPathCostFunctionLiveWire<InternalImageType> CostFunctionType;
+    typedef itk::ShortestPathTree<InternalImageType> ShortestPathTreeType;
     typedef std::vector<itk::Index<2>> ShortestPathType;
 
     /** \brief start point in world coordinates*/
@@ -108,7 +114,11 @@ namespace mitk
     /** \brief Create dynamic cost tranfer map - on the fly training*/
     bool CreateDynamicCostMap(mitk::ContourModel *path = nullptr);
 
-    void SetUseCostFunction(bool doUseCostFunction) { m_ShortestPathFilter->SetUseCostFunction(doUseCostFunction); };
+    void SetUseCostFunction(bool doUseCostFunction)
+    {
+      m_UseCostFunction = doUseCostFunction;
+      m_ShortestPathFilter->SetUseCostFunction(doUseCostFunction);
+    };
 
   protected:
     ImageLiveWireContourModelFilter();
@@ -139,9 +149,17 @@ namespace mitk
     /** \brief Shortest path filter according to cost function m_CostFunction*/
     ShortestPathImageFilterType::Pointer m_ShortestPathFilter;
 
+    /** \brief Shortest path tree rooted at the start point, used if the cost function is enabled*/
+    ShortestPathTreeType::Pointer m_ShortestPathTree;
+
     /** \brief Flag to use a dynmic cost map or not*/
     bool m_UseDynamicCostMap;
 
+    /** \brief Value of m_UseDynamicCostMap the costs of m_ShortestPathTree were computed with*/
+    bool m_ShortestPathTreeUsesDynamicCostMap;
+
+    bool m_UseCostFunction;
+
     unsigned int m_TimeStep;
 
     template <typename TPixel, unsigned int VImageDimension>
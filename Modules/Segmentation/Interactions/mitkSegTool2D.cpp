@@ -37,6 +37,7 @@ found in the LICENSE file.
 
 #include "mitkOperationEvent.h"
 #include "mitkUndoController.h"
+#include <mitkAxisAlignedSliceAccessor.h>
 #include <mitkDiffSliceOperationApplier.h>
 
 #include "mitkAbstractTransformGeometry.h"
@@ -590,62 +591,107 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
   }
 
   DiffSliceOperation* undoOperation = nullptr;
+  DiffSliceOperation* doOperation = nullptr;
 
-  if (allowUndo)
+  // Planes aligned with the image axes do not need the reslicer. Only the runs of changed pixels are
+  // written into the image buffer and only these runs are kept for undo/redo.
+  AxisAlignedSliceAccessor accessor(workingImage, sliceInfo.timestep, sliceInfo.plane);
+  if (accessor.IsCompatible(sliceInfo.slice))
   {
-    /*============= BEGIN undo/redo feature block ========================*/
-    // Create undo operation by caching the not yet modified slices
-    mitk::Image::Pointer originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
-    undoOperation =
-      new DiffSliceOperation(workingImage,
-        originalSlice,
-        dynamic_cast<SlicedGeometry3D*>(originalSlice->GetGeometry()),
-        sliceInfo.timestep,
-        sliceInfo.plane);
-    /*============= END undo/redo feature block ========================*/
-  }
+    auto redoPatch = accessor.ComputeChangedRuns(sliceInfo.slice);
+    if (redoPatch.IsEmpty())
+    {
+      return;
+    }
 
-  // Make sure that for reslicing and overwriting the same alogrithm is used. We can specify the mode of the vtk
-  // reslicer
-  vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+    const auto* sliceGeometry = dynamic_cast<const SlicedGeometry3D*>(sliceInfo.slice->GetGeometry());
 
-  // Set the slice as 'input'
-  // casting const away is needed and OK as long the OverwriteMode of
-  // mitkVTKImageOverwrite is true.
-  // Reason: because then the input slice is not touched but
-  // used to overwrite the input of the ExtractSliceFilter.
-  auto noneConstSlice = const_cast<Image*>(sliceInfo.slice.GetPointer());
-  reslice->SetInputSlice(noneConstSlice->GetVtkImageData());
+    if (allowUndo)
+    {
+      undoOperation = new DiffSliceOperation(workingImage,
+        accessor.ReadRuns(redoPatch),
+        sliceGeometry,
+        sliceInfo.timestep,
+        sliceInfo.plane);
+    }
 
-  // set overwrite mode to true to write back to the image volume
-  reslice->SetOverwriteMode(true);
-  reslice->Modified();
+    accessor.WriteRuns(redoPatch);
 
-  mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
-  extractor->SetInput(workingImage);
-  extractor->SetTimeStep(sliceInfo.timestep);
-  extractor->SetWorldGeometry(sliceInfo.plane);
-  extractor->SetVtkOutputRequest(false);
-  extractor->SetResliceTransformByGeometry(workingImage->GetGeometry(sliceInfo.timestep));
+    // the image buffer was modified directly, but not marked so. Announcing the region lets views
+    // of other slices and other time steps skip their update.
+    workingImage->RegionModified(accessor.GetVolumeRegion(redoPatch.GetBoundingRegion()), sliceInfo.timestep);
+    workingImage->GetVtkImageData(sliceInfo.timestep)->Modified();
 
-  extractor->Modified();
-  extractor->Update();
+    if (allowUndo)
+    {
+      doOperation = new DiffSliceOperation(workingImage,
+        std::move(redoPatch),
+        sliceGeometry,
+        sliceInfo.timestep,
+        sliceInfo.plane);
+    }
+  }
+  else
+  {
+    if (allowUndo)
+    {
+      /*============= BEGIN undo/redo feature block ========================*/
+      // Create undo operation by caching the not yet modified slices
+      mitk::Image::Pointer originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
+      undoOperation =
+        new DiffSliceOperation(workingImage,
+          originalSlice,
+          dynamic_cast<SlicedGeometry3D*>(originalSlice->GetGeometry()),
+          sliceInfo.timestep,
+          sliceInfo.plane);
+      /*============= END undo/redo feature block ========================*/
+    }
 
-  // the image was modified within the pipeline, but not marked so
-  workingImage->Modified();
-  workingImage->GetVtkImageData()->Modified();
+    // Make sure that for reslicing and overwriting the same alogrithm is used. We can specify the mode of the vtk
+    // reslicer
+    vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+
+    // Set the slice as 'input'
+    // casting const away is needed and OK as long the OverwriteMode of
+    // mitkVTKImageOverwrite is true.
+    // Reason: because then the input slice is not touched but
+    // used to overwrite the input of the ExtractSliceFilter.
+    auto noneConstSlice = const_cast<Image*>(sliceInfo.slice.GetPointer());
+    reslice->SetInputSlice(noneConstSlice->GetVtkImageData());
+
+    // set overwrite mode to true to write back to the image volume
+    reslice->SetOverwriteMode(true);
+    reslice->Modified();
+
+    mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
+    extractor->SetInput(workingImage);
+    extractor->SetTimeStep(sliceInfo.timestep);
+    extractor->SetWorldGeometry(sliceInfo.plane);
+    extractor->SetVtkOutputRequest(false);
+    extractor->SetResliceTransformByGeometry(workingImage->GetGeometry(sliceInfo.timestep));
+
+    extractor->Modified();
+    extractor->Update();
+
+    // the image was modified within the pipeline, but not marked so
+    workingImage->Modified();
+    workingImage->GetVtkImageData()->Modified();
+
+    if (allowUndo)
+    {
+      // specify the redo operation with the edited slice
+      doOperation =
+        new DiffSliceOperation(workingImage,
+          extractor->GetOutput(),
+          dynamic_cast<SlicedGeometry3D*>(sliceInfo.slice->GetGeometry()),
+          sliceInfo.timestep,
+          sliceInfo.plane);
+    }
+  }
 
   if (allowUndo)
   {
     /*============= BEGIN undo/redo feature block ========================*/
-    // specify the redo operation with the edited slice
-    auto* doOperation =
-      new DiffSliceOperation(workingImage,
-        extractor->GetOutput(),
-        dynamic_cast<SlicedGeometry3D*>(sliceInfo.slice->GetGeometry()),
-        sliceInfo.timestep,
-        sliceInfo.plane);
-
     // create an operation event for the undo stack
     OperationEvent* undoStackItem =
       new OperationEvent(DiffSliceOperationApplier::GetInstance(), doOperation, undoOperation, "Segmentation");
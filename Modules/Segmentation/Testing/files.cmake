@@ -1,9 +1,11 @@
 set(MODULE_TESTS
+  mitkAxisAlignedSliceAccessorTest.cpp
   mitkContourMapper2DTest.cpp
   mitkContourTest.cpp
   mitkContourModelSetToImageFilterTest.cpp
   mitkDataNodeSegmentationTest.cpp
   mitkFeatureBasedEdgeDetectionFilterTest.cpp
+  mitkImageLiveWireContourModelFilterTest.cpp
   mitkImageToContourFilterTest.cpp
   mitkSegmentationInterpolationTest.cpp
   mitkOverwriteSliceFilterTest.cpp
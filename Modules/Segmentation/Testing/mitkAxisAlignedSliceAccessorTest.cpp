@@ -0,0 +1,210 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkAxisAlignedSliceAccessor.h>
+#include <mitkExtractSliceFilter.h>
+#include <mitkImageCast.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkInteractionConst.h>
+#include <mitkRotationOperation.h>
+#include <mitkSegTool2D.h>
+#include <mitkVtkImageOverwrite.h>
+
+#include <itkImage.h>
+#include <itkImageRegionIterator.h>
+
+#include <vtkSmartPointer.h>
+
+#include <cstring>
+#include <vector>
+
+class mitkAxisAlignedSliceAccessorTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkAxisAlignedSliceAccessorTestSuite);
+
+  MITK_TEST(Accessor_ReadsSameVoxelsAsExtractSliceFilter);
+  MITK_TEST(Accessor_WritesSameVoxelsAsVtkImageOverwrite);
+  MITK_TEST(ChangedRuns_OnlyContainChangedPixels);
+  MITK_TEST(ObliquePlane_IsNotValid);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<unsigned short, 3> ImageType;
+
+  mitk::Image::Pointer m_Image;
+
+  mitk::PlaneGeometry::Pointer CreatePlane(mitk::AnatomicalPlane orientation, int sliceIndex, bool frontside, bool rotated)
+  {
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(m_Image->GetGeometry(), orientation, sliceIndex, frontside, rotated);
+
+    // move the plane to the voxel centers, the spacing is 1
+    mitk::Vector3D normal = plane->GetNormal();
+    normal.Normalize();
+    plane->SetOrigin(plane->GetOrigin() + normal * 0.5);
+    return plane;
+  }
+
+  std::vector<mitk::PlaneGeometry::Pointer> CreateAlignedPlanes()
+  {
+    std::vector<mitk::PlaneGeometry::Pointer> planes;
+    for (auto orientation : {mitk::AnatomicalPlane::Axial, mitk::AnatomicalPlane::Sagittal, mitk::AnatomicalPlane::Coronal})
+    {
+      for (bool frontside : {true, false})
+      {
+        for (bool rotated : {false, true})
+        {
+          planes.push_back(this->CreatePlane(orientation, 5, frontside, rotated));
+        }
+      }
+    }
+    return planes;
+  }
+
+  static bool AreEqual(const mitk::Image *image1, const mitk::Image *image2)
+  {
+    mitk::ImageReadAccessor access1(image1);
+    mitk::ImageReadAccessor access2(image2);
+    const auto size1 = image1->GetPixelType().GetSize() * image1->GetDimension(0) * image1->GetDimension(1) * image1->GetDimension(2);
+    const auto size2 = image2->GetPixelType().GetSize() * image2->GetDimension(0) * image2->GetDimension(1) * image2->GetDimension(2);
+    return size1 == size2 && 0 == std::memcmp(access1.GetData(), access2.GetData(), size1);
+  }
+
+  static void SetPixel(mitk::Image *slice, unsigned int x, unsigned int y, unsigned short value)
+  {
+    mitk::ImageWriteAccessor access(slice);
+    static_cast<unsigned short *>(access.GetData())[y * slice->GetDimension(0) + x] = value;
+  }
+
+public:
+  void setUp() override
+  {
+    auto image = ImageType::New();
+    ImageType::SizeType size = {{11, 9, 7}};
+    image->SetRegions(ImageType::RegionType(size));
+    image->Allocate();
+
+    unsigned short value = 1;
+    itk::ImageRegionIterator<ImageType> iter(image, image->GetLargestPossibleRegion());
+    for (; !iter.IsAtEnd(); ++iter)
+    {
+      iter.Set(value++);
+    }
+    mitk::CastToMitkImage(image, m_Image);
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void Accessor_ReadsSameVoxelsAsExtractSliceFilter()
+  {
+    for (const auto &plane : this->CreateAlignedPlanes())
+    {
+      mitk::AxisAlignedSliceAccessor accessor(m_Image, 0, plane);
+      auto slice = mitk::SegTool2D::GetAffectedImageSliceAs2DImage(plane, m_Image, 0);
+      CPPUNIT_ASSERT_MESSAGE("Plane is axis-aligned", accessor.IsValid());
+      CPPUNIT_ASSERT_MESSAGE("Extracted slice is compatible", accessor.IsCompatible(slice));
+      CPPUNIT_ASSERT_MESSAGE("Extracted slice equals the volume", accessor.ComputeChangedRuns(slice).IsEmpty());
+
+      mitk::AxisAlignedSliceAccessor::RunLengthPatch slicePatch;
+      for (unsigned int y = 0; y < slice->GetDimension(1); ++y)
+        slicePatch.runs.push_back({0, y, slice->GetDimension(0)});
+      const auto readPatch = accessor.ReadRuns(slicePatch);
+
+      mitk::ImageReadAccessor sliceAccess(slice);
+      CPPUNIT_ASSERT_MESSAGE("Read runs equal the extracted slice",
+                             0 == std::memcmp(sliceAccess.GetData(), readPatch.values.data(), readPatch.values.size()));
+    }
+  }
+
+  void Accessor_WritesSameVoxelsAsVtkImageOverwrite()
+  {
+    for (const auto &plane : this->CreateAlignedPlanes())
+    {
+      auto slice = mitk::SegTool2D::GetAffectedImageSliceAs2DImage(plane, m_Image, 0);
+      SetPixel(slice, 1, 2, 1000);
+      SetPixel(slice, 3, 4, 2000);
+
+      auto expectedImage = m_Image->Clone();
+      auto reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+      reslice->SetInputSlice(slice->GetVtkImageData());
+      reslice->SetOverwriteMode(true);
+      auto extractor = mitk::ExtractSliceFilter::New(reslice);
+      extractor->SetInput(expectedImage);
+      extractor->SetWorldGeometry(plane);
+      extractor->SetVtkOutputRequest(true);
+      extractor->SetResliceTransformByGeometry(expectedImage->GetGeometry());
+      extractor->Update();
+
+      auto image = m_Image->Clone();
+      mitk::AxisAlignedSliceAccessor accessor(image, 0, plane);
+      const auto redoPatch = accessor.ComputeChangedRuns(slice);
+      const auto undoPatch = accessor.ReadRuns(redoPatch);
+      accessor.WriteRuns(redoPatch);
+      CPPUNIT_ASSERT_MESSAGE("Written runs equal overwritten volume", AreEqual(expectedImage, image));
+
+      accessor.WriteRuns(undoPatch);
+      CPPUNIT_ASSERT_MESSAGE("Undo runs restore the volume", AreEqual(m_Image, image));
+    }
+  }
+
+  void ChangedRuns_OnlyContainChangedPixels()
+  {
+    auto plane = this->CreatePlane(mitk::AnatomicalPlane::Axial, 2, true, false);
+    auto slice = mitk::SegTool2D::GetAffectedImageSliceAs2DImage(plane, m_Image, 0);
+    SetPixel(slice, 1, 2, 0);
+    SetPixel(slice, 3, 2, 0);
+    SetPixel(slice, 10, 2, 0);
+    SetPixel(slice, 0, 6, 0);
+
+    mitk::AxisAlignedSliceAccessor accessor(m_Image, 0, plane);
+    const auto patch = accessor.ComputeChangedRuns(slice);
+
+    // the gap of one pixel is cheaper than a run and is merged, the gap of six pixels is not
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Number of runs", std::size_t(3), patch.runs.size());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Merged run x", 1u, patch.runs[0].x);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Merged run y", 2u, patch.runs[0].y);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Merged run length", 3u, patch.runs[0].length);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Single pixel run", 1u, patch.runs[1].length);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Run in other line", 6u, patch.runs[2].y);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Values of all runs", std::size_t(5 * sizeof(unsigned short)), patch.values.size());
+
+    const auto region = patch.GetBoundingRegion();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Bounding region index x", itk::IndexValueType(0), region.GetIndex(0));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Bounding region index y", itk::IndexValueType(2), region.GetIndex(1));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Bounding region size x", itk::SizeValueType(11), region.GetSize(0));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Bounding region size y", itk::SizeValueType(5), region.GetSize(1));
+
+    CPPUNIT_ASSERT_MESSAGE("Unchanged slice has no runs",
+                           accessor.ComputeChangedRuns(mitk::SegTool2D::GetAffectedImageSliceAs2DImage(plane, m_Image, 0)).IsEmpty());
+  }
+
+  void ObliquePlane_IsNotValid()
+  {
+    auto plane = this->CreatePlane(mitk::AnatomicalPlane::Axial, 3, true, false);
+    mitk::Vector3D rotationAxis;
+    rotationAxis[0] = 1;
+    rotationAxis[1] = 0;
+    rotationAxis[2] = 0;
+    auto op = new mitk::RotationOperation(mitk::OpROTATE, plane->GetCenter(), rotationAxis, 30.0);
+    plane->ExecuteOperation(op);
+    delete op;
+
+    CPPUNIT_ASSERT_MESSAGE("Oblique plane is not axis-aligned", !mitk::AxisAlignedSliceAccessor(m_Image, 0, plane).IsValid());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkAxisAlignedSliceAccessor)
@@ -0,0 +1,181 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImageCast.h>
+#include <mitkImageLiveWireContourModelFilter.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkImageRegionIteratorWithIndex.h>
+
+class mitkImageLiveWireContourModelFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageLiveWireContourModelFilterTestSuite);
+  MITK_TEST(TestPathConnectsStartAndEnd);
+  MITK_TEST(TestMovingEndPointReusesTree);
+  MITK_TEST(TestTreeMatchesShortestPathFilter);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+
+  mitk::Point3D IndexToWorld(double x, double y)
+  {
+    mitk::Point3D index;
+    index[0] = x;
+    index[1] = y;
+    index[2] = 0.0;
+    mitk::Point3D world;
+    m_Image->GetGeometry()->IndexToWorld(index, world);
+    return world;
+  }
+
+  void CheckPath(mitk::ContourModel *contour, const mitk::Point3D &start, const mitk::Point3D &end)
+  {
+    CPPUNIT_ASSERT_MESSAGE("Live wire contains at least two vertices", contour->GetNumberOfVertices() >= 2);
+    CPPUNIT_ASSERT_MESSAGE("Live wire starts at the start point",
+                           contour->GetVertexAt(0)->Coordinates.EuclideanDistanceTo(start) < 1.0);
+    CPPUNIT_ASSERT_MESSAGE(
+      "Live wire ends at the end point",
+      contour->GetVertexAt(contour->GetNumberOfVertices() - 1)->Coordinates.EuclideanDistanceTo(end) < 1.0);
+
+    for (int i = 1; i < contour->GetNumberOfVertices(); ++i)
+    {
+      double distance = contour->GetVertexAt(i - 1)->Coordinates.EuclideanDistanceTo(contour->GetVertexAt(i)->Coordinates);
+      CPPUNIT_ASSERT_MESSAGE("Consecutive vertices are neighbors", distance < 1.5);
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    // 2D image with a bright disc, the live wire should snap to its border
+    typedef itk::Image<unsigned short, 2> ImageType;
+    ImageType::Pointer image = ImageType::New();
+    ImageType::RegionType region;
+    ImageType::SizeType size;
+    size.Fill(64);
+    region.SetSize(size);
+    image->SetRegions(region);
+    image->Allocate();
+
+    itk::ImageRegionIteratorWithIndex<ImageType> iter(image, region);
+    for (iter.GoToBegin(); !iter.IsAtEnd(); ++iter)
+    {
+      double dx = iter.GetIndex()[0] - 32.0;
+      double dy = iter.GetIndex()[1] - 32.0;
+      iter.Set(dx * dx + dy * dy < 400.0 ? 200 : 10);
+    }
+
+    mitk::CastToMitkImage(image, m_Image);
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void TestPathConnectsStartAndEnd()
+  {
+    auto filter = mitk::ImageLiveWireContourModelFilter::New();
+    filter->SetUseCostFunction(true);
+    filter->SetInput(m_Image);
+
+    auto start = this->IndexToWorld(12, 32);
+    auto end = this->IndexToWorld(32, 12);
+    filter->SetStartPoint(start);
+    filter->SetEndPoint(end);
+    filter->Update();
+
+    this->CheckPath(filter->GetOutput(), start, end);
+  }
+
+  void TestMovingEndPointReusesTree()
+  {
+    auto filter = mitk::ImageLiveWireContourModelFilter::New();
+    filter->SetUseCostFunction(true);
+    filter->SetInput(m_Image);
+
+    auto start = this->IndexToWorld(12, 32);
+    filter->SetStartPoint(start);
+
+    for (int y = 12; y < 52; y += 4)
+    {
+      auto end = this->IndexToWorld(52, y);
+      filter->SetEndPoint(end);
+      filter->Update();
+      this->CheckPath(filter->GetOutput(), start, end);
+    }
+
+    // repulsive points invalidate the tree and must still lead to valid paths
+    itk::Index<2> repulsive;
+    repulsive[0] = 20;
+    repulsive[1] = 20;
+    filter->AddRepulsivePoint(repulsive);
+
+    auto end = this->IndexToWorld(32, 52);
+    filter->SetEndPoint(end);
+    filter->Update();
+    this->CheckPath(filter->GetOutput(), start, end);
+  }
+
+  void TestTreeMatchesShortestPathFilter()
+  {
+    typedef mitk::ImageLiveWireContourModelFilter::InternalImageType InternalImageType;
+    typedef mitk::ImageLiveWireContourModelFilter::CostFunctionType CostFunctionType;
+    typedef mitk::ImageLiveWireContourModelFilter::ShortestPathTreeType ShortestPathTreeType;
+    typedef mitk::ImageLiveWireContourModelFilter::ShortestPathImageFilterType ShortestPathImageFilterType;
+
+    InternalImageType::Pointer image;
+    mitk::CastToItkImage(m_Image, image);
+
+    InternalImageType::IndexType start, end;
+    start[0] = 12;
+    start[1] = 32;
+    end[0] = 50;
+    end[1] = 40;
+
+    auto costFunction = CostFunctionType::New();
+    costFunction->SetImage(image);
+    costFunction->SetStartIndex(start);
+    costFunction->SetEndIndex(end);
+    costFunction->Initialize();
+
+    auto tree = ShortestPathTreeType::New();
+    tree->SetImage(image);
+    tree->SetCostFunction(costFunction);
+    tree->SetComputeInBackground(false);
+    tree->SetSource(start);
+
+    ShortestPathTreeType::PathType treePath;
+    CPPUNIT_ASSERT_MESSAGE("Tree reaches the end point", tree->GetPath(end, treePath));
+
+    auto filter = ShortestPathImageFilterType::New();
+    filter->SetInput(image);
+    filter->SetCostFunction(costFunction);
+    filter->SetFullNeighborsMode(true);
+    filter->SetMakeOutputImage(false);
+    filter->SetStartIndex(start);
+    filter->SetEndIndex(end);
+    filter->Update();
+    auto filterPath = filter->GetVectorPath();
+
+    auto pathCost = [&costFunction](const std::vector<itk::Index<2>> &path) {
+      double cost = 0.0;
+      for (std::size_t i = 1; i < path.size(); ++i)
+        cost += costFunction->GetCost(path[i - 1], path[i]);
+      return cost;
+    };
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(
+      "Tree path is as cheap as the shortest path filter result", pathCost(filterPath), pathCost(treePath), 1e-2);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageLiveWireContourModelFilter)
@@ -1,4 +1,5 @@
 set(CPP_FILES
+  Algorithms/mitkAxisAlignedSliceAccessor.cpp
   Algorithms/mitkCalculateSegmentationVolume.cpp
   Algorithms/mitkContourModelSetToImageFilter.cpp
   Algorithms/mitkContourSetToPointSetFilter.cpp
@@ -27,6 +27,7 @@ found in the LICENSE file.
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 #include <mitkPropertyNameHelper.h>
+#include <mitkVectorProperty.h>
 
 // mitk persistence
 #include <mitkPersistenceService.h>
@@ -39,6 +40,7 @@ class mitkSemanticRelationsTestSuite : public mitk::TestFixture
   MITK_TEST(DataStorageAccessTest);
   MITK_TEST(RemoveAndUnlinkTest);
   MITK_TEST(LesionAndControlPointTest);
+  MITK_TEST(RelationStorageIndexTest);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -104,6 +106,13 @@ public:
     MITK_INFO << "=== LesionAndControlPointTest end ===";
   }
 
+  void RelationStorageIndexTest()
+  {
+    MITK_INFO << "=== RelationStorageIndexTest start ===";
+    ExternalPropertyListModification();
+    MITK_INFO << "=== RelationStorageIndexTest end ===";
+  }
+
   //////////////////////////////////////////////////////////////////////////
   // SPECIFIC TESTS
   //////////////////////////////////////////////////////////////////////////
@@ -942,6 +951,57 @@ public:
     auto allLesionClasses = mitk::SemanticRelationsInference::GetAllLesionClassesOfCase(caseID);
     CPPUNIT_ASSERT_MESSAGE("One lesion class should be stored", allLesionClasses.size() == 1);
   }
+
+  // RelationStorageIndexTest
+  void ExternalPropertyListModification()
+  {
+    MITK_INFO << "=== ExternalPropertyListModification";
+
+    // load data
+    mitk::SemanticRelationsIntegration semanticRelationsIntegration;
+
+    auto CTImage = mitk::SemanticRelationsTestHelper::GetPatientOneCTImage();
+    m_DataStorage->Add(CTImage);
+    semanticRelationsIntegration.AddImage(CTImage);
+
+    auto MRImage = mitk::SemanticRelationsTestHelper::GetPatientOneMRImage();
+    m_DataStorage->Add(MRImage);
+    semanticRelationsIntegration.AddImage(MRImage);
+
+    auto caseID = mitk::GetCaseIDFromDataNode(CTImage);
+    auto CTImageID = mitk::GetIDFromDataNode(CTImage);
+    auto MRImageID = mitk::GetIDFromDataNode(MRImage);
+
+    // start test
+    auto allImageIDs = mitk::RelationStorage::GetAllImageIDsOfCase(caseID);
+    CPPUNIT_ASSERT_MESSAGE("Images should be stored in the order they were added",
+      allImageIDs.size() == 2 && allImageIDs[0] == CTImageID && allImageIDs[1] == MRImageID);
+
+    auto controlPoint = mitk::SemanticRelationsInference::GetControlPointOfImage(CTImage);
+    allImageIDs = mitk::RelationStorage::GetAllImageIDsOfControlPoint(caseID, controlPoint);
+    CPPUNIT_ASSERT_MESSAGE("Images of a control point should be in the order of all images",
+      allImageIDs.size() == 2 && allImageIDs[0] == CTImageID && allImageIDs[1] == MRImageID);
+
+    // modify the stored image data without the relation storage, e.g. as it happens when a session is loaded
+    PERSISTENCE_GET_SERVICE_MACRO
+    CPPUNIT_ASSERT_MESSAGE("Persistence service could not be loaded", nullptr != persistenceService);
+    auto propertyList = persistenceService->GetPropertyList(caseID);
+    auto imageVectorProperty = mitk::VectorProperty<std::string>::New();
+    imageVectorProperty->SetValue({ "PET", "" });
+    propertyList->ReplaceProperty(CTImageID, imageVectorProperty);
+
+    CPPUNIT_ASSERT_MESSAGE("Modified information type should be found",
+      mitk::SemanticRelationsInference::GetInformationTypeOfImage(CTImage) == "PET");
+    allImageIDs = mitk::RelationStorage::GetAllImageIDsOfInformationType(caseID, "PET");
+    CPPUNIT_ASSERT_MESSAGE("Image should be found by its modified information type", allImageIDs.size() == 1 && allImageIDs[0] == CTImageID);
+    allImageIDs = mitk::RelationStorage::GetAllImageIDsOfControlPoint(caseID, controlPoint);
+    CPPUNIT_ASSERT_MESSAGE("Image should not be found by its former control point", allImageIDs.size() == 1 && allImageIDs[0] == MRImageID);
+
+    // remove the stored data without the relation storage
+    mitk::SemanticRelationsTestHelper::ClearRelationStorage();
+    CPPUNIT_ASSERT_MESSAGE("No case should be stored", mitk::RelationStorage::GetAllCaseIDs().empty());
+    CPPUNIT_ASSERT_MESSAGE("No image should be stored", mitk::RelationStorage::GetAllImageIDsOfCase(caseID).empty());
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkSemanticRelations)
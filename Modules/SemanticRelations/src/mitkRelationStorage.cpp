@@ -25,649 +25,760 @@ found in the LICENSE file.
 // c++
 #include <algorithm>
 #include <iostream>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace
 {
-  std::vector<mitk::SemanticTypes::CaseID> GetCaseIDs()
+  using ID = mitk::SemanticTypes::ID;
+
+  /*
+  * @brief IDs in a fixed order. Each ID has a position that defines its order, so that IDs can be
+  *        inserted and erased without changing the order of the other IDs.
+  */
+  class OrderedIDs
   {
-    PERSISTENCE_GET_SERVICE_MACRO
-    if (nullptr == persistenceService)
+  public:
+
+    // appends the ID behind all other IDs, if it is not contained yet, and returns its position
+    std::size_t Append(const ID& id)
     {
-      MITK_DEBUG << "Persistence service could not be loaded";
-      return std::vector<mitk::SemanticTypes::CaseID>();
+      auto finding = m_Positions.find(id);
+      if (finding == m_Positions.end())
+      {
+        finding = m_Positions.emplace(id, m_NextPosition++).first;
+        m_IDs.emplace(finding->second, id);
+      }
+
+      return finding->second;
     }
-    // the property list is valid for a certain scenario and contains all the case IDs of the radiological user's MITK session
-    std::string listIdentifier = "caseIDs";
-    mitk::PropertyList::Pointer propertyList = persistenceService->GetPropertyList(listIdentifier);
-    if (nullptr == propertyList)
+
+    void Insert(const ID& id, std::size_t position)
     {
-      MITK_DEBUG << "Could not find the property list " << listIdentifier << " for the current MITK workbench / session.";
-      return std::vector<mitk::SemanticTypes::CaseID>();
+      if (m_Positions.emplace(id, position).second)
+      {
+        m_IDs.emplace(position, id);
+      }
     }
-    // retrieve a vector property that contains all case IDs
-    mitk::VectorProperty<std::string>* caseIDsVectorProperty = dynamic_cast<mitk::VectorProperty<std::string>*>(propertyList->GetProperty(listIdentifier));
-    if (nullptr == caseIDsVectorProperty)
+
+    void Erase(const ID& id)
     {
-      MITK_DEBUG << "Could not find the property " << listIdentifier << " for the " << listIdentifier << " property list.";
-      return std::vector<mitk::SemanticTypes::CaseID>();
+      auto finding = m_Positions.find(id);
+      if (finding != m_Positions.end())
+      {
+        m_IDs.erase(finding->second);
+        m_Positions.erase(finding);
+      }
     }
 
-    return caseIDsVectorProperty->GetValue();
-  }
+    bool Contains(const ID& id) const
+    {
+      return m_Positions.find(id) != m_Positions.end();
+    }
 
-  bool CaseIDExists(const mitk::SemanticTypes::CaseID& caseID)
-  {
-    auto allCaseIDs = GetCaseIDs();
-    auto existingCase = std::find(allCaseIDs.begin(), allCaseIDs.end(), caseID);
-    if (existingCase == allCaseIDs.end())
+    std::size_t GetPosition(const ID& id) const
     {
-      return false;
+      return m_Positions.at(id);
     }
 
-    return true;
-  }
+    bool IsEmpty() const
+    {
+      return m_IDs.empty();
+    }
 
-  mitk::PropertyList::Pointer GetStorageData(const mitk::SemanticTypes::CaseID& caseID)
+    mitk::SemanticTypes::IDVector GetIDs() const
+    {
+      mitk::SemanticTypes::IDVector ids;
+      ids.reserve(m_IDs.size());
+      for (const auto& positionAndID : m_IDs)
+      {
+        ids.push_back(positionAndID.second);
+      }
+
+      return ids;
+    }
+
+    template <typename Function>
+    void ForEach(Function function) const
+    {
+      for (const auto& positionAndID : m_IDs)
+      {
+        function(positionAndID.second);
+      }
+    }
+
+  private:
+
+    std::map<std::size_t, ID> m_IDs;
+    std::unordered_map<ID, std::size_t> m_Positions;
+    std::size_t m_NextPosition = 0;
+  };
+
+  /*
+  * @brief IDs grouped by a key, e.g. the image IDs of each control point. The IDs of a group keep the
+  *        order of the list they are taken from.
+  */
+  class IDGroups
   {
-    // access the storage
-    PERSISTENCE_GET_SERVICE_MACRO
-    if (nullptr == persistenceService)
+  public:
+
+    void Insert(const ID& key, const ID& id, std::size_t position)
     {
-      MITK_DEBUG << "Persistence service could not be loaded";
-      return nullptr;
+      m_Groups[key].Insert(id, position);
     }
 
-    // The persistence service may create a new property list with the given ID, if no property list is found.
-    // Since we don't want to return a new property list but rather inform the user that the given case
-    // is not a valid, stored case, we will return nullptr in that case.
-    if (CaseIDExists(caseID))
+    void Erase(const ID& key, const ID& id)
     {
-      // the property list is valid for a whole case and contains all the properties for the current case
-      return persistenceService->GetPropertyList(const_cast<mitk::SemanticTypes::CaseID&>(caseID));
+      auto finding = m_Groups.find(key);
+      if (finding != m_Groups.end())
+      {
+        finding->second.Erase(id);
+        if (finding->second.IsEmpty())
+        {
+          m_Groups.erase(finding);
+        }
+      }
     }
 
-    return nullptr;
+    mitk::SemanticTypes::IDVector GetIDs(const ID& key) const
+    {
+      auto finding = m_Groups.find(key);
+      if (finding == m_Groups.end())
+      {
+        return mitk::SemanticTypes::IDVector();
+      }
+
+      return finding->second.GetIDs();
+    }
+
+  private:
+
+    std::unordered_map<ID, OrderedIDs> m_Groups;
+  };
+
+  const std::vector<std::string>* GetStringVector(const mitk::PropertyList* propertyList, const std::string& key)
+  {
+    auto vectorProperty = dynamic_cast<mitk::VectorProperty<std::string>*>(propertyList->GetProperty(key));
+    return nullptr == vectorProperty ? nullptr : &vectorProperty->GetValue();
   }
 
-  mitk::SemanticTypes::Lesion GenerateLesion(const mitk::SemanticTypes::CaseID& caseID, const mitk::SemanticTypes::ID& lesionID)
+  /*
+  * @brief In-memory index of the relations of a case.
+  *
+  *   The index is built from the property list of the case and answers the queries without copying
+  *   or searching the property values. Each function of the relation storage that modifies the property list
+  *   updates the index incrementally and its modified time afterwards. If the property list is replaced or
+  *   if properties are set or removed by anyone else (e.g. if a session is loaded), the index is rebuilt on the next access.
+  *   Values that are changed in-place by anyone else are not detected.
+  */
+  class CaseIndex
   {
-    mitk::PropertyList::Pointer propertyList = GetStorageData(caseID);
-    if (nullptr == propertyList)
+  public:
+
+    struct ImageData
+    {
+      mitk::SemanticTypes::InformationType informationType;
+      ID controlPointID;
+    };
+
+    struct SegmentationData
+    {
+      ID imageID;
+      ID lesionID;
+    };
+
+    struct LesionData
+    {
+      std::string name;
+      ID lesionClassID;
+    };
+
+    mitk::PropertyList::Pointer propertyList;
+    itk::ModifiedTimeType modifiedTime = 0;
+
+    OrderedIDs imageIDs;
+    std::unordered_map<ID, ImageData> images;
+    IDGroups imagesOfControlPoint;
+    IDGroups imagesOfInformationType;
+
+    OrderedIDs segmentationIDs;
+    std::unordered_map<ID, SegmentationData> segmentations;
+    IDGroups segmentationsOfImage;
+    IDGroups segmentationsOfLesion;
+
+    OrderedIDs lesionIDs;
+    std::unordered_map<ID, LesionData> lesions;
+    std::unordered_map<ID, std::string> lesionClasses;
+
+    OrderedIDs controlPointIDs;
+    std::unordered_map<ID, boost::gregorian::date> controlPointDates;
+
+    OrderedIDs examinationPeriodIDs;
+    std::unordered_map<ID, mitk::SemanticTypes::ExaminationPeriod> examinationPeriods;
+
+    mitk::SemanticTypes::InformationTypeVector informationTypes;
+
+    bool IsUpToDate(const mitk::PropertyList* currentPropertyList) const
     {
-      MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
-      return mitk::SemanticTypes::Lesion();
+      // only the modified time of the list itself is compared, since the overridden 'GetMTime' checks every property
+      return propertyList == currentPropertyList && modifiedTime == currentPropertyList->itk::Object::GetMTime();
     }
 
-    mitk::VectorProperty<std::string>* lesionDataProperty = dynamic_cast<mitk::VectorProperty<std::string>*>(propertyList->GetProperty(lesionID));
-    if (nullptr == lesionDataProperty)
+    void UpdateModifiedTime()
     {
-      MITK_DEBUG << "Lesion " << lesionID << " not found. Lesion can not be retrieved.";
-      return mitk::SemanticTypes::Lesion();
+      // takes over the modified time of properties that were changed in place
+      modifiedTime = propertyList->GetMTime();
     }
 
-    std::vector<std::string> lesionData = lesionDataProperty->GetValue();
-    // a lesion date has to have exactly two values (the name of the lesion and the UID of the lesion class)
-    if (lesionData.size() != 2)
+    void Build(mitk::PropertyList* currentPropertyList)
+    {
+      *this = CaseIndex();
+      propertyList = currentPropertyList;
+
+      if (auto informationTypesValue = GetStringVector(propertyList, "informationtypes"))
+      {
+        informationTypes = *informationTypesValue;
+      }
+
+      if (auto imagesValue = GetStringVector(propertyList, "images"))
+      {
+        for (const auto& imageID : *imagesValue)
+        {
+          imageIDs.Append(imageID);
+          // an image has to have exactly two values (the information type and the ID of the control point)
+          auto imageValue = GetStringVector(propertyList, imageID);
+          if (nullptr != imageValue && imageValue->size() == 2)
+          {
+            SetImage(imageID, { (*imageValue)[0], (*imageValue)[1] });
+          }
+        }
+      }
+
+      if (auto segmentationsValue = GetStringVector(propertyList, "segmentations"))
+      {
+        for (const auto& segmentationID : *segmentationsValue)
+        {
+          segmentationIDs.Append(segmentationID);
+          // a segmentation has to have exactly two values (the ID of the referenced image and the ID of the referenced lesion)
+          auto segmentationValue = GetStringVector(propertyList, segmentationID);
+          if (nullptr != segmentationValue && segmentationValue->size() == 2)
+          {
+            SetSegmentation(segmentationID, { (*segmentationValue)[0], (*segmentationValue)[1] });
+          }
+        }
+      }
+
+      if (auto lesionsValue = GetStringVector(propertyList, "lesions"))
+      {
+        for (const auto& lesionID : *lesionsValue)
+        {
+          lesionIDs.Append(lesionID);
+          // a lesion has to have exactly two values (the name of the lesion and the UID of the lesion class)
+          auto lesionValue = GetStringVector(propertyList, lesionID);
+          if (nullptr == lesionValue || lesionValue->size() != 2)
+          {
+            continue;
+          }
+
+          const auto& lesionClassID = (*lesionValue)[1];
+          lesions[lesionID] = { (*lesionValue)[0], lesionClassID };
+          auto lesionClassProperty = dynamic_cast<mitk::StringProperty*>(propertyList->GetProperty(lesionClassID));
+          if (nullptr != lesionClassProperty)
+          {
+            lesionClasses[lesionClassID] = lesionClassProperty->GetValue();
+          }
+        }
+      }
+
+      if (auto controlPointsValue = GetStringVector(propertyList, "controlpoints"))
+      {
+        for (const auto& controlPointID : *controlPointsValue)
+        {
+          controlPointIDs.Append(controlPointID);
+          // a control point has to have exactly three integer values (year, month and day)
+          auto controlPointProperty = dynamic_cast<mitk::VectorProperty<int>*>(propertyList->GetProperty(controlPointID));
+          if (nullptr != controlPointProperty && controlPointProperty->GetValue().size() == 3)
+          {
+            const auto& date = controlPointProperty->GetValue();
+            controlPointDates[controlPointID] = boost::gregorian::date(date[0], date[1], date[2]);
+          }
+        }
+      }
+
+      if (auto examinationPeriodsValue = GetStringVector(propertyList, "examinationperiods"))
+      {
+        for (const auto& examinationPeriodID : *examinationPeriodsValue)
+        {
+          examinationPeriodIDs.Append(examinationPeriodID);
+          auto examinationPeriodValue = GetStringVector(propertyList, examinationPeriodID);
+          if (nullptr != examinationPeriodValue)
+          {
+            SetExaminationPeriod(examinationPeriodID, *examinationPeriodValue);
+          }
+        }
+      }
+
+      UpdateModifiedTime();
+    }
+
+    void SetImage(const ID& imageID, const ImageData& imageData)
     {
-      MITK_DEBUG << "Incorrect lesion data storage. Not two (2) strings of the lesion name and the lesion UID are stored.";
-      return mitk::SemanticTypes::Lesion();
+      if (!imageIDs.Contains(imageID))
+      {
+        return;
+      }
+
+      RemoveImageData(imageID);
+      images[imageID] = imageData;
+      auto position = imageIDs.GetPosition(imageID);
+      imagesOfControlPoint.Insert(imageData.controlPointID, imageID, position);
+      imagesOfInformationType.Insert(imageData.informationType, imageID, position);
     }
 
-    // the lesion class ID is stored as the second property
-    std::string lesionClassID = lesionData[1];
-    mitk::StringProperty* lesionClassProperty = dynamic_cast<mitk::StringProperty*>(propertyList->GetProperty(lesionClassID));
-    if (nullptr != lesionClassProperty)
+    void RemoveImage(const ID& imageID)
     {
-      mitk::SemanticTypes::LesionClass generatedLesionClass;
-      generatedLesionClass.UID = lesionClassID;
-      generatedLesionClass.classType = lesionClassProperty->GetValue();
+      RemoveImageData(imageID);
+      imageIDs.Erase(imageID);
+    }
+
+    void SetSegmentation(const ID& segmentationID, const SegmentationData& segmentationData)
+    {
+      if (!segmentationIDs.Contains(segmentationID))
+      {
+        return;
+      }
+
+      RemoveSegmentationData(segmentationID);
+      segmentations[segmentationID] = segmentationData;
+      auto position = segmentationIDs.GetPosition(segmentationID);
+      segmentationsOfImage.Insert(segmentationData.imageID, segmentationID, position);
+      segmentationsOfLesion.Insert(segmentationData.lesionID, segmentationID, position);
+    }
+
+    void RemoveSegmentation(const ID& segmentationID)
+    {
+      RemoveSegmentationData(segmentationID);
+      segmentationIDs.Erase(segmentationID);
+    }
+
+    void SetExaminationPeriod(const ID& examinationPeriodID, const std::vector<std::string>& examinationPeriodValue)
+    {
+      // an examination period has an arbitrary number of vector values (name and control point UIDs) (at least one for the name)
+      if (!examinationPeriodIDs.Contains(examinationPeriodID) || examinationPeriodValue.empty())
+      {
+        examinationPeriods.erase(examinationPeriodID);
+        return;
+      }
+
+      auto& examinationPeriod = examinationPeriods[examinationPeriodID];
+      examinationPeriod.UID = examinationPeriodID;
+      examinationPeriod.name = examinationPeriodValue[0];
+      examinationPeriod.controlPointUIDs.assign(examinationPeriodValue.begin() + 1, examinationPeriodValue.end());
+    }
+
+    mitk::SemanticTypes::Lesion GenerateLesion(const ID& lesionID) const
+    {
+      auto lesion = lesions.find(lesionID);
+      if (lesion == lesions.end())
+      {
+        MITK_DEBUG << "Lesion " << lesionID << " not found. Lesion can not be retrieved.";
+        return mitk::SemanticTypes::Lesion();
+      }
+
+      auto lesionClass = lesionClasses.find(lesion->second.lesionClassID);
+      if (lesionClass == lesionClasses.end())
+      {
+        MITK_DEBUG << "Incorrect lesion class storage. Lesion " << lesionID << " can not be retrieved.";
+        return mitk::SemanticTypes::Lesion();
+      }
 
       mitk::SemanticTypes::Lesion generatedLesion;
       generatedLesion.UID = lesionID;
-      generatedLesion.name = lesionData[0];
-      generatedLesion.lesionClass = generatedLesionClass;
+      generatedLesion.name = lesion->second.name;
+      generatedLesion.lesionClass.UID = lesionClass->first;
+      generatedLesion.lesionClass.classType = lesionClass->second;
 
       return generatedLesion;
     }
 
-    MITK_DEBUG << "Incorrect lesion class storage. Lesion " << lesionID << " can not be retrieved.";
-    return mitk::SemanticTypes::Lesion();
-  }
+    mitk::SemanticTypes::ControlPoint GenerateControlPoint(const ID& controlPointID) const
+    {
+      auto date = controlPointDates.find(controlPointID);
+      if (date == controlPointDates.end())
+      {
+        MITK_DEBUG << "Could not find the control point " << controlPointID << " in the storage.";
+        return mitk::SemanticTypes::ControlPoint();
+      }
+
+      mitk::SemanticTypes::ControlPoint generatedControlPoint;
+      generatedControlPoint.UID = controlPointID;
+      generatedControlPoint.date = date->second;
+
+      return generatedControlPoint;
+    }
+
+  private:
+
+    void RemoveImageData(const ID& imageID)
+    {
+      auto image = images.find(imageID);
+      if (image != images.end())
+      {
+        imagesOfControlPoint.Erase(image->second.controlPointID, imageID);
+        imagesOfInformationType.Erase(image->second.informationType, imageID);
+        images.erase(image);
+      }
+    }
+
+    void RemoveSegmentationData(const ID& segmentationID)
+    {
+      auto segmentation = segmentations.find(segmentationID);
+      if (segmentation != segmentations.end())
+      {
+        segmentationsOfImage.Erase(segmentation->second.imageID, segmentationID);
+        segmentationsOfLesion.Erase(segmentation->second.lesionID, segmentationID);
+        segmentations.erase(segmentation);
+      }
+    }
+  };
 
-  mitk::SemanticTypes::ControlPoint GenerateControlpoint(const mitk::SemanticTypes::CaseID& caseID, const mitk::SemanticTypes::ID& controlPointUID)
+  /*
+  * @brief In-memory index of the case IDs, built from the "caseIDs" property list.
+  */
+  struct CaseIDIndex
   {
-    mitk::PropertyList::Pointer propertyList = GetStorageData(caseID);
+    mitk::PropertyList::Pointer propertyList;
+    itk::ModifiedTimeType modifiedTime = 0;
+    std::vector<mitk::SemanticTypes::CaseID> caseIDs;
+    std::unordered_set<mitk::SemanticTypes::CaseID> existingCaseIDs;
+  };
+
+  CaseIDIndex& GetCaseIDIndex()
+  {
+    static CaseIDIndex caseIDIndex;
+
+    PERSISTENCE_GET_SERVICE_MACRO
+    if (nullptr == persistenceService)
+    {
+      MITK_DEBUG << "Persistence service could not be loaded";
+      caseIDIndex = CaseIDIndex();
+      return caseIDIndex;
+    }
+    // the property list is valid for a certain scenario and contains all the case IDs of the radiological user's MITK session
+    std::string listIdentifier = "caseIDs";
+    mitk::PropertyList::Pointer propertyList = persistenceService->GetPropertyList(listIdentifier);
     if (nullptr == propertyList)
     {
-      MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
-      return mitk::SemanticTypes::ControlPoint();
+      MITK_DEBUG << "Could not find the property list " << listIdentifier << " for the current MITK workbench / session.";
+      caseIDIndex = CaseIDIndex();
+      return caseIDIndex;
+    }
+
+    if (caseIDIndex.propertyList == propertyList && caseIDIndex.modifiedTime == propertyList->itk::Object::GetMTime())
+    {
+      return caseIDIndex;
+    }
+
+    caseIDIndex = CaseIDIndex();
+    caseIDIndex.propertyList = propertyList;
+    // retrieve a vector property that contains all case IDs
+    if (auto caseIDsValue = GetStringVector(propertyList, listIdentifier))
+    {
+      caseIDIndex.caseIDs = *caseIDsValue;
+      caseIDIndex.existingCaseIDs.insert(caseIDsValue->begin(), caseIDsValue->end());
+    }
+    else
+    {
+      MITK_DEBUG << "Could not find the property " << listIdentifier << " for the " << listIdentifier << " property list.";
+    }
+
+    caseIDIndex.modifiedTime = propertyList->GetMTime();
+    return caseIDIndex;
+  }
+
+  CaseIndex* GetCaseIndex(const mitk::SemanticTypes::CaseID& caseID)
+  {
+    static std::unordered_map<mitk::SemanticTypes::CaseID, CaseIndex> caseIndices;
+
+    // The persistence service may create a new property list with the given ID, if no property list is found.
+    // Since we don't want to return a new property list but rather inform the user that the given case
+    // is not a valid, stored case, we will return nullptr in that case.
+    if (0 == GetCaseIDIndex().existingCaseIDs.count(caseID))
+    {
+      caseIndices.erase(caseID);
+      return nullptr;
     }
 
-    // retrieve a vector property that contains the integer values of the date of a control point (0. year 1. month 2. day)
-    mitk::VectorProperty<int>* controlPointVectorProperty = dynamic_cast<mitk::VectorProperty<int>*>(propertyList->GetProperty(controlPointUID));
-    if (nullptr == controlPointVectorProperty)
+    // access the storage
+    PERSISTENCE_GET_SERVICE_MACRO
+    if (nullptr == persistenceService)
     {
-      MITK_DEBUG << "Could not find the control point " << controlPointUID << " in the storage.";
-      return mitk::SemanticTypes::ControlPoint();
+      MITK_DEBUG << "Persistence service could not be loaded";
+      return nullptr;
     }
 
-    std::vector<int> controlPointVectorPropertyValue = controlPointVectorProperty->GetValue();
-    // a control point has to have exactly three integer values (year, month and day)
-    if (controlPointVectorPropertyValue.size() != 3)
+    // the property list is valid for a whole case and contains all the properties for the current case
+    mitk::PropertyList::Pointer propertyList = persistenceService->GetPropertyList(const_cast<mitk::SemanticTypes::CaseID&>(caseID));
+    if (nullptr == propertyList)
     {
-      MITK_DEBUG << "Incorrect control point storage. Not three (3) values of the date are stored.";
-      return mitk::SemanticTypes::ControlPoint();
+      return nullptr;
     }
 
-    // set the values of the control point
-    mitk::SemanticTypes::ControlPoint generatedControlPoint;
-    generatedControlPoint.UID = controlPointUID;
-    generatedControlPoint.date = boost::gregorian::date(controlPointVectorPropertyValue[0],
-      controlPointVectorPropertyValue[1],
-      controlPointVectorPropertyValue[2]);
+    auto& caseIndex = caseIndices[caseID];
+    if (!caseIndex.IsUpToDate(propertyList))
+    {
+      caseIndex.Build(propertyList);
+    }
 
-    return generatedControlPoint;
+    return &caseIndex;
   }
 }
 
 mitk::SemanticTypes::LesionVector mitk::RelationStorage::GetAllLesionsOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::LesionVector();
   }
-  // retrieve a vector property that contains the valid lesion-IDs for the current case
-  VectorProperty<std::string>* lesionsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("lesions"));
-  if (nullptr == lesionsVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any lesion in the storage.";
-    return SemanticTypes::LesionVector();
-  }
 
-  std::vector<std::string> lesionsVectorPropertyValue = lesionsVectorProperty->GetValue();
   SemanticTypes::LesionVector allLesionsOfCase;
-  for (const auto& lesionID : lesionsVectorPropertyValue)
+  caseIndex->lesionIDs.ForEach([caseIndex, &allLesionsOfCase](const SemanticTypes::ID& lesionID)
   {
-    SemanticTypes::Lesion generatedLesion = GenerateLesion(caseID, lesionID);
+    SemanticTypes::Lesion generatedLesion = caseIndex->GenerateLesion(lesionID);
     if (!generatedLesion.UID.empty())
     {
       allLesionsOfCase.push_back(generatedLesion);
     }
-  }
+  });
 
   return allLesionsOfCase;
 }
 
 mitk::SemanticTypes::Lesion mitk::RelationStorage::GetLesionOfSegmentation(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& segmentationID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::Lesion();
   }
 
-  // retrieve a vector property that contains the referenced ID of a segmentation (0. image ID 1. lesion ID)
-  VectorProperty<std::string>* segmentationVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(segmentationID));
-  if (nullptr == segmentationVectorProperty)
+  auto segmentation = caseIndex->segmentations.find(segmentationID);
+  if (segmentation == caseIndex->segmentations.end())
   {
     MITK_DEBUG << "Could not find the segmentation " << segmentationID << " in the storage.";
     return SemanticTypes::Lesion();
   }
 
-  std::vector<std::string> segmentationVectorPropertyValue = segmentationVectorProperty->GetValue();
-  // the lesion ID of a segmentation is the second value in the vector
-  if (segmentationVectorPropertyValue.size() != 2)
-  {
-    MITK_DEBUG << "Incorrect segmentation storage. Not two (2) IDs stored.";
-    return SemanticTypes::Lesion();
-  }
-
-  std::string lesionID = segmentationVectorPropertyValue[1];
+  const auto& lesionID = segmentation->second.lesionID;
   if (lesionID.empty())
   {
     // segmentation does not refer to any lesion; return empty lesion
     return SemanticTypes::Lesion();
   }
 
-  return GenerateLesion(caseID, lesionID);
+  return caseIndex->GenerateLesion(lesionID);
 }
 
 mitk::SemanticTypes::ControlPointVector mitk::RelationStorage::GetAllControlPointsOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::ControlPointVector();
   }
 
-  // retrieve a vector property that contains the valid control point-IDs for the current case
-  VectorProperty<std::string>* controlPointsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("controlpoints"));
-  if (nullptr == controlPointsVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any control points in the storage.";
-    return SemanticTypes::ControlPointVector();
-  }
-
-  std::vector<std::string> controlPointsVectorPropertyValue = controlPointsVectorProperty->GetValue();
   SemanticTypes::ControlPointVector allControlPointsOfCase;
-  for (const auto& controlPointUID : controlPointsVectorPropertyValue)
+  caseIndex->controlPointIDs.ForEach([caseIndex, &allControlPointsOfCase](const SemanticTypes::ID& controlPointUID)
   {
-    SemanticTypes::ControlPoint generatedControlPoint = GenerateControlpoint(caseID, controlPointUID);
+    SemanticTypes::ControlPoint generatedControlPoint = caseIndex->GenerateControlPoint(controlPointUID);
     if (!generatedControlPoint.UID.empty())
     {
       allControlPointsOfCase.push_back(generatedControlPoint);
     }
-  }
+  });
 
   return allControlPointsOfCase;
 }
 
 mitk::SemanticTypes::ControlPoint mitk::RelationStorage::GetControlPointOfImage(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& imageID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::ControlPoint();
   }
-  // retrieve a vector property that contains the information type and the referenced ID of a control point (0. information type 1. control point ID)
-  VectorProperty<std::string>* imageVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(imageID));
-  if (nullptr == imageVectorProperty)
-  {
-    MITK_DEBUG << "Could not find the image " << imageID << " in the storage.";
-    return SemanticTypes::ControlPoint();
-  }
-
-  std::vector<std::string> imageVectorPropertyValue = imageVectorProperty->GetValue();
-  SemanticTypes::ControlPoint controlPoint;
-  // an image has to have exactly two values (the information type and the ID of the control point)
-  if (imageVectorPropertyValue.size() != 2)
-  {
-    MITK_DEBUG << "Incorrect data storage. Not two (2) values stored.";
-    return SemanticTypes::ControlPoint();
-  }
 
-  // the second value of the image vector is the ID of the referenced control point
-  std::string controlPointID = imageVectorPropertyValue[1];
-  // retrieve a vector property that contains the integer values of the date of a control point (0. year 1. month 2. day)
-  VectorProperty<int>* controlPointVectorProperty = dynamic_cast<VectorProperty<int>*>(propertyList->GetProperty(controlPointID));
-  if (nullptr == controlPointVectorProperty)
+  auto image = caseIndex->images.find(imageID);
+  if (image == caseIndex->images.end())
   {
-    MITK_DEBUG << "Could not find the control point " << controlPointID << " in the storage.";
-    return SemanticTypes::ControlPoint();
-  }
-
-  std::vector<int> controlPointVectorPropertyValue = controlPointVectorProperty->GetValue();
-  // a control point has to have exactly three integer values (year, month and day)
-  if (controlPointVectorPropertyValue.size() != 3)
-  {
-    MITK_DEBUG << "Incorrect control point storage. Not three (3) values of the date are stored.";
+    MITK_DEBUG << "Could not find the image " << imageID << " in the storage.";
     return SemanticTypes::ControlPoint();
   }
 
-  // set the values of the control point
-  controlPoint.UID = controlPointID;
-  controlPoint.date = boost::gregorian::date(controlPointVectorPropertyValue[0],
-                                             controlPointVectorPropertyValue[1],
-                                             controlPointVectorPropertyValue[2]);
-
-  return controlPoint;
+  return caseIndex->GenerateControlPoint(image->second.controlPointID);
 }
 
 mitk::SemanticTypes::ExaminationPeriodVector mitk::RelationStorage::GetAllExaminationPeriodsOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::ExaminationPeriodVector();
   }
 
-  // retrieve a vector property that contains the valid examination period UIDs for the current case
-  VectorProperty<std::string>::Pointer examinationPeriodsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("examinationperiods"));
-  if (nullptr == examinationPeriodsVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any examination periods in the storage.";
-    return SemanticTypes::ExaminationPeriodVector();
-  }
-
-  std::vector<std::string> examinationPeriodsVectorPropertyValue = examinationPeriodsVectorProperty->GetValue();
   SemanticTypes::ExaminationPeriodVector allExaminationPeriods;
-  for (const auto& examinationPeriodID : examinationPeriodsVectorPropertyValue)
+  caseIndex->examinationPeriodIDs.ForEach([caseIndex, &allExaminationPeriods](const SemanticTypes::ID& examinationPeriodID)
   {
-    // retrieve a vector property that contains the represented control point-IDs
-    VectorProperty<std::string>::Pointer examinationPeriodVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(examinationPeriodID));
-    if (nullptr == examinationPeriodVectorProperty)
+    auto examinationPeriod = caseIndex->examinationPeriods.find(examinationPeriodID);
+    if (examinationPeriod == caseIndex->examinationPeriods.end())
     {
       MITK_DEBUG << "Could not find the examination period " << examinationPeriodID << " in the storage.";
-      continue;
+      return;
     }
 
-    std::vector<std::string> examinationPeriodVectorPropertyValue = examinationPeriodVectorProperty->GetValue();
-    // an examination period has an arbitrary number of vector values (name and control point UIDs) (at least one for the name)
-    if (examinationPeriodVectorPropertyValue.empty())
-    {
-      MITK_DEBUG << "Incorrect examination period storage. At least one (1) value for the examination period name has to be stored.";
-      continue;
-    }
-    else
-    {
-      // set the values of the name and the control points
-      SemanticTypes::ExaminationPeriod generatedExaminationPeriod;
-      generatedExaminationPeriod.UID = examinationPeriodID;
-      generatedExaminationPeriod.name = examinationPeriodVectorPropertyValue[0];
-      for (size_t i = 1; i < examinationPeriodVectorPropertyValue.size(); ++i)
-      {
-        generatedExaminationPeriod.controlPointUIDs.push_back(examinationPeriodVectorPropertyValue[i]);
-      }
+    allExaminationPeriods.push_back(examinationPeriod->second);
+  });
 
-      allExaminationPeriods.push_back(generatedExaminationPeriod);
-    }
-  }
   return allExaminationPeriods;
 }
 
 mitk::SemanticTypes::InformationTypeVector mitk::RelationStorage::GetAllInformationTypesOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::InformationTypeVector();
   }
-  // retrieve a vector property that contains the valid information types of the current case
-  VectorProperty<std::string>* informationTypesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("informationtypes"));
-  if (nullptr == informationTypesVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any information types in the storage.";
-    return SemanticTypes::InformationTypeVector();
-  }
 
-  return informationTypesVectorProperty->GetValue();
+  return caseIndex->informationTypes;
 }
 
 mitk::SemanticTypes::InformationType mitk::RelationStorage::GetInformationTypeOfImage(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& imageID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::InformationType();
   }
-  // retrieve a vector property that contains the information type and the referenced ID of an image (0. information type 1. control point ID)
-  VectorProperty<std::string>* imageVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(imageID));
-  if (nullptr == imageVectorProperty)
-  {
-    MITK_DEBUG << "Could not find the image " << imageID << " in the storage.";
-    return SemanticTypes::InformationType();
-  }
 
-  std::vector<std::string> imageVectorPropertyValue = imageVectorProperty->GetValue();
-  // an image has to have exactly two values (the information type and the ID of the control point)
-  if (imageVectorPropertyValue.size() != 2)
+  auto image = caseIndex->images.find(imageID);
+  if (image == caseIndex->images.end())
   {
-    MITK_DEBUG << "Incorrect data storage. Not two (2) values stored.";
+    MITK_DEBUG << "Could not find the image " << imageID << " in the storage.";
     return SemanticTypes::InformationType();
   }
 
-  // the first value of the image vector is the information type
-  return imageVectorPropertyValue[0];
+  return image->second.informationType;
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllImageIDsOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::IDVector();
   }
-  // retrieve a vector property that contains the valid image-IDs of the current case
-  VectorProperty<std::string>* imagesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("images"));
-  if (nullptr == imagesVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any image in the storage.";
-    return SemanticTypes::IDVector();
-  }
 
-  return imagesVectorProperty->GetValue();
+  return caseIndex->imageIDs.GetIDs();
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllImageIDsOfControlPoint(const SemanticTypes::CaseID& caseID, const SemanticTypes::ControlPoint& controlPoint)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::IDVector();
   }
-  // retrieve a vector property that contains the valid image-IDs of the current case
-  VectorProperty<std::string>* imagesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("images"));
-  if (nullptr == imagesVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any image in the storage.";
-    return SemanticTypes::IDVector();
-  }
-
-  mitk::SemanticTypes::IDVector allImageIDsOfControlPoint;
-  std::vector<std::string> imagesVectorPropertyValue = imagesVectorProperty->GetValue();
-  for (const auto& imageID : imagesVectorPropertyValue)
-  {
-    // retrieve a vector property that contains the referenced ID of an image (0. information type 1. control point ID)
-    VectorProperty<std::string>* imageVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(imageID));
-    if (nullptr == imageVectorProperty)
-    {
-      continue;
-    }
-
-    std::vector<std::string> imageVectorPropertyValue = imageVectorProperty->GetValue();
-    // an image has to have exactly two values (the information type and the ID of the control point)
-    if (imageVectorPropertyValue.size() != 2)
-    {
-      continue;
-    }
-
-    // the second value of the image vector is the ID of the referenced control point
-    if (imageVectorPropertyValue[1] == controlPoint.UID)
-    {
-      allImageIDsOfControlPoint.push_back(imageID);
-    }
-  }
 
-  return allImageIDsOfControlPoint;
+  return caseIndex->imagesOfControlPoint.GetIDs(controlPoint.UID);
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllImageIDsOfInformationType(const SemanticTypes::CaseID& caseID, const SemanticTypes::InformationType& informationType)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::IDVector();
   }
-  // retrieve a vector property that contains the valid image-IDs of the current case
-  VectorProperty<std::string>* imagesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("images"));
-  if (nullptr == imagesVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any image in the storage.";
-    return SemanticTypes::IDVector();
-  }
-
-  mitk::SemanticTypes::IDVector allImageIDsOfInformationType;
-  std::vector<std::string> imagesVectorPropertyValue = imagesVectorProperty->GetValue();
-  for (const auto& imageID : imagesVectorPropertyValue)
-  {
-    // retrieve a vector property that contains the referenced ID of an image (0. information type 1. control point ID)
-    VectorProperty<std::string>* imageVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(imageID));
-    if (nullptr == imageVectorProperty)
-    {
-      continue;
-    }
-
-    std::vector<std::string> imageVectorPropertyValue = imageVectorProperty->GetValue();
-    // an image has to have exactly two values (the information type and the ID of the control point)
-    if (imageVectorPropertyValue.size() != 2)
-    {
-      continue;
-    }
-
-    // the first value of the image vector is the ID of the referenced information type
-    if (imageVectorPropertyValue[0] == informationType)
-    {
-      allImageIDsOfInformationType.push_back(imageID);
-    }
-  }
 
-  return allImageIDsOfInformationType;
+  return caseIndex->imagesOfInformationType.GetIDs(informationType);
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllSegmentationIDsOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::IDVector();
   }
-  // retrieve a vector property that contains the valid segmentation-IDs for the current case
-  VectorProperty<std::string>* segmentationsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("segmentations"));
-  if (nullptr == segmentationsVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any segmentation in the storage.";
-    return SemanticTypes::IDVector();
-  }
 
-  return segmentationsVectorProperty->GetValue();
+  return caseIndex->segmentationIDs.GetIDs();
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllSegmentationIDsOfImage(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& imageID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::IDVector();
   }
-  // retrieve a vector property that contains the valid segmentation-IDs for the current case
-  VectorProperty<std::string>* segmentationsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("segmentations"));
-  if (nullptr == segmentationsVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any segmentation in the storage.";
-    return SemanticTypes::IDVector();
-  }
-
-  mitk::SemanticTypes::IDVector allSegmentationIDsOfImage;
-  std::vector<std::string> segmentationsVectorPropertyValue = segmentationsVectorProperty->GetValue();
-  for (const auto& segmentationID : segmentationsVectorPropertyValue)
-  {
-    // retrieve a vector property that contains the referenced ID of a segmentation (0. image ID 1. lesion ID)
-    VectorProperty<std::string>* segmentationVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(segmentationID));
-    if (nullptr == segmentationVectorProperty)
-    {
-      continue;
-    }
-
-    std::vector<std::string> segmentationVectorPropertyValue = segmentationVectorProperty->GetValue();
-    // a segmentation has to have exactly two values (the ID of the referenced image and the ID of the referenced lesion)
-    if (segmentationVectorPropertyValue.size() != 2)
-    {
-      continue;
-    }
-
-    // the first value of the segmentation vector is the ID of the referenced image
-    if (segmentationVectorPropertyValue[0] == imageID)
-    {
-      allSegmentationIDsOfImage.push_back(segmentationID);
-    }
-  }
 
-  return allSegmentationIDsOfImage;
+  return caseIndex->segmentationsOfImage.GetIDs(imageID);
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllSegmentationIDsOfLesion(const SemanticTypes::CaseID& caseID, const SemanticTypes::Lesion& lesion)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::IDVector();
   }
-  // retrieve a vector property that contains the valid segmentation-IDs for the current case
-  VectorProperty<std::string>* segmentationsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("segmentations"));
-  if (nullptr == segmentationsVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any segmentation in the storage.";
-    return SemanticTypes::IDVector();
-  }
-
-  mitk::SemanticTypes::IDVector allSegmentationIDsOfLesion;
-  std::vector<std::string> segmentationsVectorPropertyValue = segmentationsVectorProperty->GetValue();
-  for (const auto& segmentationID : segmentationsVectorPropertyValue)
-  {
-    // retrieve a vector property that contains the referenced ID of a segmentation (0. image ID 1. lesion ID)
-    VectorProperty<std::string>* segmentationVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(segmentationID));
-    if (nullptr == segmentationVectorProperty)
-    {
-      continue;
-    }
-
-    std::vector<std::string> segmentationVectorPropertyValue = segmentationVectorProperty->GetValue();
-    // a segmentation has to have exactly two values (the ID of the referenced image and the ID of the referenced lesion)
-    if (segmentationVectorPropertyValue.size() != 2)
-    {
-      continue;
-    }
-
-    // the second value of the segmentation vector is the ID of the referenced lesion
-    if (segmentationVectorPropertyValue[1] == lesion.UID)
-    {
-      allSegmentationIDsOfLesion.push_back(segmentationID);
-    }
-  }
 
-  return allSegmentationIDsOfLesion;
+  return caseIndex->segmentationsOfLesion.GetIDs(lesion.UID);
 }
 
 mitk::SemanticTypes::ID mitk::RelationStorage::GetImageIDOfSegmentation(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& segmentationID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  const CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::ID();
   }
 
-  // retrieve a vector property that contains the referenced ID of a segmentation (0. image ID 1. lesion ID)
-  VectorProperty<std::string>* segmentationVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(segmentationID));
-  if (nullptr == segmentationVectorProperty)
+  auto segmentation = caseIndex->segmentations.find(segmentationID);
+  if (segmentation == caseIndex->segmentations.end())
   {
     MITK_DEBUG << "Could not find the segmentation " << segmentationID << " in the storage.";
     return SemanticTypes::ID();
   }
 
-  std::vector<std::string> segmentationVectorPropertyValue = segmentationVectorProperty->GetValue();
-  // the lesion ID of a segmentation is the second value in the vector
-  if (segmentationVectorPropertyValue.size() != 2)
-  {
-    MITK_DEBUG << "Incorrect segmentation storage. Not two (2) IDs stored.";
-    return SemanticTypes::ID();
-  }
-
-  return segmentationVectorPropertyValue[0];
+  return segmentation->second.imageID;
 }
 
 std::vector<mitk::SemanticTypes::CaseID> mitk::RelationStorage::GetAllCaseIDs()
 {
-  return GetCaseIDs();
+  return GetCaseIDIndex().caseIDs;
 }
 
 bool mitk::RelationStorage::InstanceExists(const SemanticTypes::CaseID& caseID)
 {
-  return CaseIDExists(caseID);
+  return 0 != GetCaseIDIndex().existingCaseIDs.count(caseID);
 }
 
 void mitk::RelationStorage::AddCase(const SemanticTypes::CaseID& caseID)
@@ -686,6 +797,7 @@ void mitk::RelationStorage::AddCase(const SemanticTypes::CaseID& caseID)
     MITK_DEBUG << "Could not find the property list " << listIdentifier << " for the current MITK workbench / session.";
     return;
   }
+  CaseIDIndex& caseIDIndex = GetCaseIDIndex();
   // retrieve a vector property that contains all case IDs
   VectorProperty<std::string>::Pointer caseIDsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(listIdentifier));
   std::vector<std::string> caseIDsVectorPropertyValue;
@@ -708,16 +820,24 @@ void mitk::RelationStorage::AddCase(const SemanticTypes::CaseID& caseID)
   caseIDsVectorPropertyValue.push_back(caseID);
   caseIDsVectorProperty->SetValue(caseIDsVectorPropertyValue);
   propertyList->SetProperty(listIdentifier, caseIDsVectorProperty);
+
+  if (caseIDIndex.propertyList == propertyList)
+  {
+    caseIDIndex.caseIDs.push_back(caseID);
+    caseIDIndex.existingCaseIDs.insert(caseID);
+    caseIDIndex.modifiedTime = propertyList->GetMTime();
+  }
 }
 
 void mitk::RelationStorage::AddImage(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& imageID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
 
   // retrieve a vector property that contains the valid image-IDs for the current case
   VectorProperty<std::string>::Pointer imagesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("images"));
@@ -748,16 +868,21 @@ void mitk::RelationStorage::AddImage(const SemanticTypes::CaseID& caseID, const
   std::vector<std::string> imageVectorPropertyValue(2);
   imageVectorProperty->SetValue(imageVectorPropertyValue);
   propertyList->SetProperty(imageID, imageVectorProperty);
+
+  caseIndex->imageIDs.Append(imageID);
+  caseIndex->SetImage(imageID, CaseIndex::ImageData());
+  caseIndex->UpdateModifiedTime();
 }
 
 void mitk::RelationStorage::RemoveImage(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& imageID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
 
   // retrieve a vector property that contains the valid image-IDs for the current case
   VectorProperty<std::string>::Pointer imagesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("images"));
@@ -783,16 +908,20 @@ void mitk::RelationStorage::RemoveImage(const SemanticTypes::CaseID& caseID, con
 
   // remove the image instance itself
   propertyList->DeleteProperty(imageID);
+
+  caseIndex->RemoveImage(imageID);
+  caseIndex->UpdateModifiedTime();
 }
 
 void mitk::RelationStorage::AddSegmentation(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& segmentationID, const SemanticTypes::ID& parentID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
 
   // retrieve a vector property that contains the valid segmentation-IDs for the current case
   VectorProperty<std::string>::Pointer segmentationsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("segmentations"));
@@ -824,16 +953,21 @@ void mitk::RelationStorage::AddSegmentation(const SemanticTypes::CaseID& caseID,
   segmentationVectorPropertyValue[0] = parentID;
   segmentationVectorProperty->SetValue(segmentationVectorPropertyValue);
   propertyList->SetProperty(segmentationID, segmentationVectorProperty);
+
+  caseIndex->segmentationIDs.Append(segmentationID);
+  caseIndex->SetSegmentation(segmentationID, { parentID, "" });
+  caseIndex->UpdateModifiedTime();
 }
 
 void mitk::RelationStorage::RemoveSegmentation(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& segmentationID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
 
   // retrieve a vector property that contains the valid segmentation-IDs for the current case
   VectorProperty<std::string>::Pointer segmentationsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("segmentations"));
@@ -859,16 +993,20 @@ void mitk::RelationStorage::RemoveSegmentation(const SemanticTypes::CaseID& case
 
   // remove the lesion instance itself
   propertyList->DeleteProperty(segmentationID);
+
+  caseIndex->RemoveSegmentation(segmentationID);
+  caseIndex->UpdateModifiedTime();
 }
 
 void mitk::RelationStorage::AddLesion(const SemanticTypes::CaseID& caseID, const SemanticTypes::Lesion& lesion)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
   // retrieve a vector property that contains the valid lesion-IDs for the current case
   VectorProperty<std::string>::Pointer lesionsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("lesions"));
   std::vector<std::string> lesionsVectorPropertyValue;
@@ -904,16 +1042,22 @@ void mitk::RelationStorage::AddLesion(const SemanticTypes::CaseID& caseID, const
   // add the lesion class with the lesion class UID as key and the class type as value
   std::string lesionClassType = lesion.lesionClass.classType;
   propertyList->SetStringProperty(lesion.lesionClass.UID.c_str(), lesionClassType.c_str());
+
+  caseIndex->lesionIDs.Append(lesion.UID);
+  caseIndex->lesions[lesion.UID] = { lesion.name, lesion.lesionClass.UID };
+  caseIndex->lesionClasses[lesion.lesionClass.UID] = lesionClassType;
+  caseIndex->UpdateModifiedTime();
 }
 
 void mitk::RelationStorage::OverwriteLesion(const SemanticTypes::CaseID& caseID, const SemanticTypes::Lesion& lesion)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
   // retrieve a vector property that contains the valid lesion-IDs for the current case
   VectorProperty<std::string>* lesionVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("lesions"));
   if (nullptr == lesionVectorProperty)
@@ -937,6 +1081,10 @@ void mitk::RelationStorage::OverwriteLesion(const SemanticTypes::CaseID& caseID,
     // overwrite the lesion class with the lesion class UID as key and the new, given class type as value
     std::string lesionClassType = lesion.lesionClass.classType;
     propertyList->SetStringProperty(lesion.lesionClass.UID.c_str(), lesionClassType.c_str());
+
+    caseIndex->lesions[lesion.UID] = { lesion.name, lesion.lesionClass.UID };
+    caseIndex->lesionClasses[lesion.lesionClass.UID] = lesionClassType;
+    caseIndex->UpdateModifiedTime();
   }
   else
   {
@@ -946,12 +1094,13 @@ void mitk::RelationStorage::OverwriteLesion(const SemanticTypes::CaseID& caseID,
 
 void mitk::RelationStorage::LinkSegmentationToLesion(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& segmentationID, const SemanticTypes::Lesion& lesion)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
   // retrieve a vector property that contains the valid lesion-IDs for the current case
   VectorProperty<std::string>* lesionVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("lesions"));
   if (nullptr == lesionVectorProperty)
@@ -983,6 +1132,9 @@ void mitk::RelationStorage::LinkSegmentationToLesion(const SemanticTypes::CaseID
     // the lesion ID of a segmentation is the second value in the vector
     segmentationVectorPropertyValue[1] = lesion.UID;
     segmentationVectorProperty->SetValue(segmentationVectorPropertyValue);
+
+    caseIndex->SetSegmentation(segmentationID, { segmentationVectorPropertyValue[0], lesion.UID });
+    caseIndex->UpdateModifiedTime();
     return;
   }
 
@@ -991,12 +1143,13 @@ void mitk::RelationStorage::LinkSegmentationToLesion(const SemanticTypes::CaseID
 
 void mitk::RelationStorage::UnlinkSegmentationFromLesion(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& segmentationID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
   // retrieve a vector property that contains the referenced ID of a segmentation (0. image ID 1. lesion ID)
   VectorProperty<std::string>* segmentationVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(segmentationID));
   if (nullptr == segmentationVectorProperty)
@@ -1017,16 +1170,20 @@ void mitk::RelationStorage::UnlinkSegmentationFromLesion(const SemanticTypes::Ca
   // set the lesion reference to an empty string for removal
   segmentationVectorPropertyValue[1] = "";
   segmentationVectorProperty->SetValue(segmentationVectorPropertyValue);
+
+  caseIndex->SetSegmentation(segmentationID, { segmentationVectorPropertyValue[0], "" });
+  caseIndex->UpdateModifiedTime();
 }
 
 void mitk::RelationStorage::RemoveLesion(const SemanticTypes::CaseID& caseID, const SemanticTypes::Lesion& lesion)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
   // retrieve a vector property that contains the valid lesions of the current case
   VectorProperty<std::string>* lesionVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("lesions"));
   if (nullptr == lesionVectorProperty)
@@ -1049,6 +1206,10 @@ void mitk::RelationStorage::RemoveLesion(const SemanticTypes::CaseID& caseID, co
     lesionVectorProperty->SetValue(lesionsVectorPropertyValue);
   }
 
+  caseIndex->lesionIDs.Erase(lesion.UID);
+  caseIndex->lesions.erase(lesion.UID);
+  caseIndex->UpdateModifiedTime();
+
   // remove the lesion instance itself
   // the lesion data is stored under the lesion ID
   VectorProperty<std::string>* lesionDataProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(lesion.UID));
@@ -1070,16 +1231,18 @@ void mitk::RelationStorage::RemoveLesion(const SemanticTypes::CaseID& caseID, co
     RemoveLesionClass(caseID, lesionClassID);
   }
   propertyList->DeleteProperty(lesion.UID);
+  caseIndex->UpdateModifiedTime();
 }
 
 void mitk::RelationStorage::RemoveLesionClass(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& lesionClassID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
 
   // retrieve a vector property that contains the lesion class
   StringProperty* lesionClassProperty = dynamic_cast<StringProperty*>(propertyList->GetProperty(lesionClassID));
@@ -1121,17 +1284,21 @@ void mitk::RelationStorage::RemoveLesionClass(const SemanticTypes::CaseID& caseI
   {
     // lesion class ID not referenced; remove lesion class
     propertyList->DeleteProperty(lesionClassID);
+
+    caseIndex->lesionClasses.erase(lesionClassID);
+    caseIndex->UpdateModifiedTime();
   }
 }
 
 void mitk::RelationStorage::AddControlPoint(const SemanticTypes::CaseID& caseID, const SemanticTypes::ControlPoint& controlPoint)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
   // retrieve a vector property that contains the valid controlPoint UIDs for the current case
   VectorProperty<std::string>::Pointer controlPointsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("controlpoints"));
   std::vector<std::string> controlPointsVectorPropertyValue;
@@ -1165,16 +1332,21 @@ void mitk::RelationStorage::AddControlPoint(const SemanticTypes::CaseID& caseID,
   VectorProperty<int>::Pointer newControlPointVectorProperty = VectorProperty<int>::New();
   newControlPointVectorProperty->SetValue(controlPointDate);
   propertyList->SetProperty(controlPoint.UID, newControlPointVectorProperty);
+
+  caseIndex->controlPointIDs.Append(controlPoint.UID);
+  caseIndex->controlPointDates[controlPoint.UID] = boost::gregorian::date(controlPointDate[0], controlPointDate[1], controlPointDate[2]);
+  caseIndex->UpdateModifiedTime();
 }
 
 void mitk::RelationStorage::LinkImageToControlPoint(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& imageID, const SemanticTypes::ControlPoint& controlPoint)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
   // retrieve a vector property that contains the valid controlPoint UIDs for the current case
   VectorProperty<std::string>* controlPointsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("controlpoints"));
   if (nullptr == controlPointsVectorProperty)
@@ -1207,6 +1379,9 @@ void mitk::RelationStorage::LinkImageToControlPoint(const SemanticTypes::CaseID&
     // the second value of the image vector is the ID of the referenced control point
     imageVectorPropertyValue[1] = controlPoint.UID;
     imageVectorProperty->SetValue(imageVectorPropertyValue);
+
+    caseIndex->SetImage(imageID, { imageVectorPropertyValue[0], controlPoint.UID });
+    caseIndex->UpdateModifiedTime();
     return;
   }
 
@@ -1215,12 +1390,13 @@ void mitk::RelationStorage::LinkImageToControlPoint(const SemanticTypes::CaseID&
 
 void mitk::RelationStorage::UnlinkImageFromControlPoint(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& imageID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
   // retrieve a vector property that contains the referenced ID of a date (0. information type 1. control point ID)
   VectorProperty<std::string>* imageVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(imageID));
   if (nullptr == imageVectorProperty)
@@ -1241,16 +1417,20 @@ void mitk::RelationStorage::UnlinkImageFromControlPoint(const SemanticTypes::Cas
   // set the control point reference to an empty string for removal
   imageVectorPropertyValue[1] = "";
   imageVectorProperty->SetValue(imageVectorPropertyValue);
+
+  caseIndex->SetImage(imageID, { imageVectorPropertyValue[0], "" });
+  caseIndex->UpdateModifiedTime();
 }
 
 void mitk::RelationStorage::RemoveControlPoint(const SemanticTypes::CaseID& caseID, const SemanticTypes::ControlPoint& controlPoint)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
   // retrieve a vector property that contains the valid controlPoint UIDs for the current case
   VectorProperty<std::string>* controlPointsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("controlpoints"));
   if (nullptr == controlPointsVectorProperty)
@@ -1275,16 +1455,21 @@ void mitk::RelationStorage::RemoveControlPoint(const SemanticTypes::CaseID& case
 
   // remove the control point instance itself
   propertyList->DeleteProperty(controlPoint.UID);
+
+  caseIndex->controlPointIDs.Erase(controlPoint.UID);
+  caseIndex->controlPointDates.erase(controlPoint.UID);
+  caseIndex->UpdateModifiedTime();
 }
 
 void mitk::RelationStorage::AddExaminationPeriod(const SemanticTypes::CaseID& caseID, const SemanticTypes::ExaminationPeriod& examinationPeriod)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
   // retrieve a vector property that contains the valid examination period UIDs for the current case
   VectorProperty<std::string>::Pointer examinationPeriodsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("examinationperiods"));
   std::vector<std::string> examinationPeriodsVectorPropertyValue;
@@ -1315,16 +1500,21 @@ void mitk::RelationStorage::AddExaminationPeriod(const SemanticTypes::CaseID& ca
   VectorProperty<std::string>::Pointer newExaminationPeriodVectorProperty = VectorProperty<std::string>::New();
   newExaminationPeriodVectorProperty->SetValue(examinationPeriodData);
   propertyList->SetProperty(examinationPeriod.UID, newExaminationPeriodVectorProperty);
+
+  caseIndex->examinationPeriodIDs.Append(examinationPeriod.UID);
+  caseIndex->SetExaminationPeriod(examinationPeriod.UID, examinationPeriodData);
+  caseIndex->UpdateModifiedTime();
 }
 
 void mitk::RelationStorage::RenameExaminationPeriod(const SemanticTypes::CaseID& caseID, const SemanticTypes::ExaminationPeriod& examinationPeriod)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
   // retrieve a vector property that contains the data of the given examination period
   VectorProperty<std::string>* examinationPeriodDataVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(examinationPeriod.UID));
   if (nullptr == examinationPeriodDataVectorProperty)
@@ -1346,17 +1536,21 @@ void mitk::RelationStorage::RenameExaminationPeriod(const SemanticTypes::CaseID&
     examinationPeriodDataVectorPropertyValue[0] = examinationPeriod.name;
     // store the modified vector value
     examinationPeriodDataVectorProperty->SetValue(examinationPeriodDataVectorPropertyValue);
+
+    caseIndex->SetExaminationPeriod(examinationPeriod.UID, examinationPeriodDataVectorPropertyValue);
+    caseIndex->UpdateModifiedTime();
   }
 }
 
 void mitk::RelationStorage::AddControlPointToExaminationPeriod(const SemanticTypes::CaseID& caseID, const SemanticTypes::ControlPoint& controlPoint, const SemanticTypes::ExaminationPeriod& examinationPeriod)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
 
   // retrieve a vector property that contains the represented control point UIDs of the given examination period
   VectorProperty<std::string>* controlPointUIDsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(examinationPeriod.UID));
@@ -1370,10 +1564,10 @@ void mitk::RelationStorage::AddControlPointToExaminationPeriod(const SemanticTyp
   // store the control point UID
   controlPointUIDsVectorPropertyValue.push_back(controlPoint.UID);
   // sort the vector according to the date of the control points referenced by the UIDs
-  auto lambda = [&caseID](const SemanticTypes::ID& leftControlPointUID, const SemanticTypes::ID& rightControlPointUID)
+  auto lambda = [caseIndex](const SemanticTypes::ID& leftControlPointUID, const SemanticTypes::ID& rightControlPointUID)
   {
-    const auto& leftControlPoint = GenerateControlpoint(caseID, leftControlPointUID);
-    const auto& rightControlPoint = GenerateControlpoint(caseID, rightControlPointUID);
+    const auto& leftControlPoint = caseIndex->GenerateControlPoint(leftControlPointUID);
+    const auto& rightControlPoint = caseIndex->GenerateControlPoint(rightControlPointUID);
 
     return leftControlPoint.date <= rightControlPoint.date;
   };
@@ -1381,16 +1575,20 @@ void mitk::RelationStorage::AddControlPointToExaminationPeriod(const SemanticTyp
   std::sort(controlPointUIDsVectorPropertyValue.begin(), controlPointUIDsVectorPropertyValue.end(), lambda);
   // store the modified and sorted control point UID vector of this examination period
   controlPointUIDsVectorProperty->SetValue(controlPointUIDsVectorPropertyValue);
+
+  caseIndex->SetExaminationPeriod(examinationPeriod.UID, controlPointUIDsVectorPropertyValue);
+  caseIndex->UpdateModifiedTime();
 }
 
 void mitk::RelationStorage::RemoveControlPointFromExaminationPeriod(const SemanticTypes::CaseID& caseID, const SemanticTypes::ControlPoint& controlPoint, const SemanticTypes::ExaminationPeriod& examinationPeriod)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
 
   // retrieve a vector property that contains the represented control point UIDs of the given examination period
   VectorProperty<std::string>* controlPointUIDsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(examinationPeriod.UID));
@@ -1418,18 +1616,22 @@ void mitk::RelationStorage::RemoveControlPointFromExaminationPeriod(const Semant
     {
       // store the modified vector value
       controlPointUIDsVectorProperty->SetValue(controlPointUIDsVectorPropertyValue);
+
+      caseIndex->SetExaminationPeriod(examinationPeriod.UID, controlPointUIDsVectorPropertyValue);
+      caseIndex->UpdateModifiedTime();
     }
   }
 }
 
 void mitk::RelationStorage::RemoveExaminationPeriod(const SemanticTypes::CaseID& caseID, const SemanticTypes::ExaminationPeriod& examinationPeriod)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
   // retrieve a vector property that contains the valid examination period UIDs for the current case
   VectorProperty<std::string>::Pointer examinationPeriodsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("examinationperiods"));
   if (nullptr == examinationPeriodsVectorProperty)
@@ -1453,16 +1655,21 @@ void mitk::RelationStorage::RemoveExaminationPeriod(const SemanticTypes::CaseID&
 
   // remove the examination period instance itself
   propertyList->DeleteProperty(examinationPeriod.UID);
+
+  caseIndex->examinationPeriodIDs.Erase(examinationPeriod.UID);
+  caseIndex->examinationPeriods.erase(examinationPeriod.UID);
+  caseIndex->UpdateModifiedTime();
 }
 
 void mitk::RelationStorage::AddInformationTypeToImage(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& imageID, const SemanticTypes::InformationType& informationType)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
   // retrieve a vector property that contains the valid information types of the current case
   VectorProperty<std::string>::Pointer informationTypesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("informationtypes"));
   std::vector<std::string> informationTypesVectorPropertyValue;
@@ -1482,6 +1689,9 @@ void mitk::RelationStorage::AddInformationTypeToImage(const SemanticTypes::CaseI
     informationTypesVectorPropertyValue.push_back(informationType);
     informationTypesVectorProperty->SetValue(informationTypesVectorPropertyValue);
     propertyList->SetProperty("informationtypes", informationTypesVectorProperty);
+
+    caseIndex->informationTypes = informationTypesVectorPropertyValue;
+    caseIndex->UpdateModifiedTime();
   }
 
   // set / overwrite the information type of the given data
@@ -1504,16 +1714,20 @@ void mitk::RelationStorage::AddInformationTypeToImage(const SemanticTypes::CaseI
   // the first value of the image vector is the information type
   imageVectorPropertyValue[0] = informationType;
   imageVectorProperty->SetValue(imageVectorPropertyValue);
+
+  caseIndex->SetImage(imageID, { informationType, imageVectorPropertyValue[1] });
+  caseIndex->UpdateModifiedTime();
 }
 
 void mitk::RelationStorage::RemoveInformationTypeFromImage(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& imageID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
   // retrieve a vector property that contains the referenced ID of an image (0. information type 1. control point ID)
   VectorProperty<std::string>* imageVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(imageID));
   if (nullptr == imageVectorProperty)
@@ -1534,16 +1748,20 @@ void mitk::RelationStorage::RemoveInformationTypeFromImage(const SemanticTypes::
   // set the information type to an empty string for removal
   imageVectorPropertyValue[0] = "";
   imageVectorProperty->SetValue(imageVectorPropertyValue);
+
+  caseIndex->SetImage(imageID, { "", imageVectorPropertyValue[1] });
+  caseIndex->UpdateModifiedTime();
 }
 
 void mitk::RelationStorage::RemoveInformationType(const SemanticTypes::CaseID& caseID, const SemanticTypes::InformationType& informationType)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  CaseIndex* caseIndex = GetCaseIndex(caseID);
+  if (nullptr == caseIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  PropertyList::Pointer propertyList = caseIndex->propertyList;
   // retrieve a vector property that contains the valid information types of the current case
   VectorProperty<std::string>* informationTypesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("informationtypes"));
   if (nullptr == informationTypesVectorProperty)
@@ -1564,4 +1782,7 @@ void mitk::RelationStorage::RemoveInformationType(const SemanticTypes::CaseID& c
     // or store the modified vector value
     informationTypesVectorProperty->SetValue(informationTypesVectorPropertyValue);
   }
+
+  caseIndex->informationTypes = informationTypesVectorPropertyValue;
+  caseIndex->UpdateModifiedTime();
 }
@@ -15,4 +15,5 @@ set(MODULE_TESTS
 set(MODULE_CUSTOM_TESTS
   mitkPlayerLoadAndRenderDepthDataTest.cpp
   mitkPlayerLoadAndRenderRGBDataTest.cpp
+  mitkToFCompositeFilterBenchmark.cpp
 )
@@ -0,0 +1,113 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImageReadAccessor.h>
+#include <mitkTestingMacros.h>
+#include <mitkToFCameraMITKPlayerDevice.h>
+#include <mitkToFCompositeFilter.h>
+#include <mitkToFConfig.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static mitk::ToFCompositeFilter::Pointer CreateCompositeFilter(mitk::Image* distanceImage, unsigned int numberOfWorkUnits)
+{
+  mitk::ToFCompositeFilter::Pointer compositeFilter = mitk::ToFCompositeFilter::New();
+  compositeFilter->SetApplyThresholdFilter(true);
+  compositeFilter->SetThresholdFilterParameter(1, 7000);
+  compositeFilter->SetApplyTemporalMedianFilter(true);
+  compositeFilter->SetTemporalMedianFilterParameter(10);
+  compositeFilter->SetApplyMedianFilter(true);
+  compositeFilter->SetApplyBilateralFilter(true);
+  compositeFilter->SetBilateralFilterParameter(2, 60, 0);
+  if (numberOfWorkUnits > 0)
+  {
+    compositeFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+  }
+  compositeFilter->SetInput(distanceImage);
+  return compositeFilter;
+}
+
+/**
+ * @brief Checks that the parallel ToFCompositeFilter computes the same output as the sequential one on a recorded
+ * sequence and measures the frame rate of both with all filters enabled.
+ *
+ * Usage: mitkToFCompositeFilterBenchmark DistanceImage.nrrd (must be in MITK_TOF_DATA_DIR) [number of frames]
+ * The frames are played by the ToFCameraMITKPlayerDevice, only the processing time of the filters is measured.
+ * The frame rates are reported for information only.
+ */
+int mitkToFCompositeFilterBenchmark(int argc, char* argv[])
+{
+  MITK_TEST_BEGIN("mitkToFCompositeFilterBenchmark");
+
+  MITK_TEST_CONDITION_REQUIRED(argc >= 2, "Testing if enough input parameters are set. Usage: Testname, ImageName (must be in MITK_TOF_DATA_DIR), [number of frames]");
+  std::string dirname = MITK_TOF_DATA_DIR;
+  std::string distanceFileName = dirname + "/" + argv[1];
+  int numberOfFrames = argc >= 3 ? std::atoi(argv[2]) : 300;
+
+  mitk::ToFCameraMITKPlayerDevice::Pointer playerDevice = mitk::ToFCameraMITKPlayerDevice::New();
+  playerDevice->SetProperty("DistanceImageFileName", mitk::StringProperty::New(distanceFileName));
+  MITK_TEST_CONDITION_REQUIRED(playerDevice->ConnectCamera(), "ConnectCamera() should return true in case of success.");
+  playerDevice->StartCamera();
+
+  unsigned int dimension[2];
+  dimension[0] = playerDevice->GetCaptureWidth();
+  dimension[1] = playerDevice->GetCaptureHeight();
+  std::vector<float> distances(dimension[0] * dimension[1]);
+
+  mitk::Image::Pointer distanceImage = mitk::Image::New();
+  distanceImage->Initialize(mitk::PixelType(mitk::MakeScalarPixelType<float>()), 2, dimension, 1);
+
+  mitk::ToFCompositeFilter::Pointer parallelFilter = CreateCompositeFilter(distanceImage, 0);
+  mitk::ToFCompositeFilter::Pointer sequentialFilter = CreateCompositeFilter(distanceImage, 1);
+  const size_t imageSize = dimension[0] * dimension[1] * sizeof(float);
+
+  std::chrono::duration<double> parallelTime(0.0);
+  std::chrono::duration<double> sequentialTime(0.0);
+  int imageSequence = 0;
+  int matchingFrames = 0;
+  for (int frame = 0; frame < numberOfFrames; ++frame)
+  {
+    playerDevice->GetDistances(distances.data(), imageSequence);
+    distanceImage->SetSlice(distances.data());
+    distanceImage->Modified();
+
+    auto start = std::chrono::steady_clock::now();
+    parallelFilter->Update();
+    parallelTime += std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    sequentialFilter->Update();
+    sequentialTime += std::chrono::steady_clock::now() - start;
+
+    mitk::ImageReadAccessor parallelAccess(parallelFilter->GetOutput());
+    mitk::ImageReadAccessor sequentialAccess(sequentialFilter->GetOutput());
+    if (std::memcmp(parallelAccess.GetData(), sequentialAccess.GetData(), imageSize) == 0)
+    {
+      ++matchingFrames;
+    }
+  }
+
+  playerDevice->StopCamera();
+  playerDevice->DisconnectCamera();
+
+  MITK_TEST_CONDITION(matchingFrames == numberOfFrames, "Parallel output equals sequential output in all frames");
+
+  MITK_TEST_OUTPUT(<< "ToFCompositeFilter processed " << numberOfFrames << " frames of " << dimension[0] << "x" << dimension[1]
+                   << " pixels with " << numberOfFrames / parallelTime.count() << " frames per second using "
+                   << parallelFilter->GetNumberOfWorkUnits() << " work units and "
+                   << numberOfFrames / sequentialTime.count() << " frames per second using 1 work unit");
+
+  MITK_TEST_END();
+}
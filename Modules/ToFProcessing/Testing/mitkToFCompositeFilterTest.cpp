@@ -24,6 +24,9 @@ found in the LICENSE file.
 #include <itkMedianImageFilter.h>
 #include <mitkImagePixelReadAccessor.h>
 
+#include <algorithm>
+#include <vector>
+
 
 /**Documentation
 *  \brief test for the class "ToFCompositeFilter".
@@ -290,6 +293,48 @@ int mitkToFCompositeFilterTest(int /* argc */, char* /*argv*/[])
                                "Test threshold filter, bilateral filter and temporal median filter in pipeline");
 
 
+  //-------------------------------------------------------------------------------------------------------
+
+  //Apply the temporal median filter to a stream of frames
+
+  compositeFilter->SetApplyThresholdFilter(false);
+  compositeFilter->SetApplyMedianFilter(false);
+  compositeFilter->SetApplyBilateralFilter(false);
+  compositeFilter->SetApplyTemporalMedianFilter(true);
+  compositeFilter->SetTemporalMedianFilterParameter(3);
+
+  std::vector<ItkImageType_2D::Pointer> frames;
+  for (int frame = 0; frame < 5; ++frame)
+  {
+    ItkImageType_2D::Pointer itkFrame = ItkImageType_2D::New();
+    mitk::Image::Pointer mitkFrame = mitk::Image::New();
+    CreateRandomDistanceImage(100,100,itkFrame,mitkFrame);
+    frames.push_back(itkFrame);
+    compositeFilter->SetInput(mitkFrame);
+    mitkOutputImage->Update();
+  }
+
+  //the ring buffer holds the last three frames
+  bool temporalMedianEqual = true;
+  {
+    mitk::ImagePixelReadAccessor<ToFScalarType,2> outputAccess(mitkOutputImage, mitkOutputImage->GetSliceData());
+    ItkImageRegionIteratorType2D frameIterator(frames.back(), frames.back()->GetLargestPossibleRegion());
+    for (frameIterator.GoToBegin(); !frameIterator.IsAtEnd(); ++frameIterator)
+    {
+      ItkImageType_2D::IndexType index = frameIterator.GetIndex();
+      std::vector<ToFScalarType> values = { frames[2]->GetPixel(index), frames[3]->GetPixel(index), frames[4]->GetPixel(index) };
+      std::sort(values.begin(), values.end());
+      itk::Index<2> pixelIndex = {{ index[0], index[1] }};
+      if (!mitk::Equal(values[1], outputAccess.GetPixelByIndex(pixelIndex)))
+      {
+        temporalMedianEqual = false;
+      }
+    }
+  }
+  MITK_TEST_CONDITION_REQUIRED(temporalMedianEqual, "Test temporal median filter over the last frames");
+  compositeFilter->SetApplyTemporalMedianFilter(false);
+
+
   //-------------------------------------------------------------------------------------------------------
   // TODO: Rewrite this. This don't make sense. the itk reference applies a median filter
   // and threshold filter afterwards. The composite filter does it in the other directtion.
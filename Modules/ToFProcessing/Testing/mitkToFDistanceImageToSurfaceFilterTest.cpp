@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include <mitkImage.h>
 #include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
 #include <mitkImageGenerator.h>
 #include <mitkSurface.h>
 #include <mitkToFProcessingCommon.h>
@@ -375,6 +376,48 @@ int mitkToFDistanceImageToSurfaceFilterTest(int /* argc */, char* /*argv*/[])
   }
   MITK_TEST_CONDITION_REQUIRED(compareToInput,"Testing backward transformation compared to original image with interpixeldistance");
 
+  //Invalidating a pixel has to update points and triangles of the output, the previous output must stay unchanged
+  vtkSmartPointer<vtkPolyData> previousPolyData = resultSurface->GetVtkPolyData();
+  vtkIdType numberOfPoints = previousPolyData->GetNumberOfPoints();
+  vtkIdType numberOfPolys = previousPolyData->GetNumberOfPolys();
+  {
+    mitk::ImagePixelWriteAccessor<float,2> writeAccess(image, image->GetSliceData());
+    itk::Index<2> index = {{ 10, 10 }};
+    writeAccess.SetPixelByIndex(index, 0.0f);
+  }
+  filter->Modified();
+  filter->Update();
+  vtkPolyData* polyData = filter->GetOutput()->GetVtkPolyData();
+  MITK_TEST_CONDITION_REQUIRED(polyData != previousPolyData, "Testing that the previous output poly data is not reused by the next update");
+  MITK_TEST_CONDITION_REQUIRED(previousPolyData->GetNumberOfPoints() == numberOfPoints, "Testing that the previous output keeps its points");
+  MITK_TEST_CONDITION_REQUIRED(previousPolyData->GetNumberOfPolys() == numberOfPolys, "Testing that the previous output keeps its triangles");
+  MITK_TEST_CONDITION_REQUIRED(polyData->GetNumberOfPoints() == numberOfPoints - 1, "Testing number of points after invalidating a pixel");
+  MITK_TEST_CONDITION_REQUIRED(polyData->GetNumberOfPolys() == numberOfPolys - 8, "Testing number of triangles after invalidating a pixel");
+
+  //The unchanged frame has to result in the same mesh, also if the buffer of an older output is reused
+  filter->Modified();
+  filter->Update();
+  MITK_TEST_CONDITION_REQUIRED(filter->GetOutput()->GetVtkPolyData()->GetNumberOfPoints() == numberOfPoints - 1, "Testing number of points of the next update");
+  MITK_TEST_CONDITION_REQUIRED(filter->GetOutput()->GetVtkPolyData()->GetNumberOfPolys() == numberOfPolys - 8, "Testing number of triangles of the next update");
+
+  //Changing the intrinsics has to update the cached rays
+  cameraIntrinsics->SetFocalLength(2*focalLengthX, 2*focalLengthY);
+  filter->Modified();
+  filter->Update();
+  float firstDistance = 0.0;
+  {
+    mitk::ImagePixelReadAccessor<float,2> readAccess(image, image->GetSliceData());
+    itk::Index<2> index = {{ 0, 0 }};
+    firstDistance = readAccess.GetPixelByIndex(index);
+  }
+  ToFPoint3D expectedFirstPoint = mitk::ToFProcessingCommon::IndexToCartesianCoordinatesWithInterpixdist(0,0,firstDistance,2*focalLength,interPixelDistance,principalPoint);
+  double* firstPoint = filter->GetOutput()->GetVtkPolyData()->GetPoint(0);
+  ToFPoint3D resultFirstPoint;
+  resultFirstPoint[0] = firstPoint[0];
+  resultFirstPoint[1] = firstPoint[1];
+  resultFirstPoint[2] = firstPoint[2];
+  MITK_TEST_CONDITION_REQUIRED(mitk::Equal(expectedFirstPoint, resultFirstPoint), "Testing reconstruction after changing the camera intrinsics");
+
   //clean up
   delete[] point;
   //  expectedResult->Delete();
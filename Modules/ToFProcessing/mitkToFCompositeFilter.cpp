@@ -13,27 +13,27 @@ found in the LICENSE file.
 #include <mitkToFCompositeFilter.h>
 #include <mitkInstantiateAccessFunctions.h>
 #include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
 
 #include <itkImage.h>
 
-#include <opencv2/imgproc/imgproc_c.h>
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <memory>
 
 mitk::ToFCompositeFilter::ToFCompositeFilter() : m_SegmentationMask(nullptr), m_ImageWidth(0), m_ImageHeight(0), m_ImageSize(0),
-m_IplDistanceImage(nullptr), m_IplOutputImage(nullptr), m_ItkInputImage(nullptr), m_ApplyTemporalMedianFilter(false), m_ApplyAverageFilter(false),
-  m_ApplyMedianFilter(false), m_ApplyThresholdFilter(false), m_ApplyMaskSegmentation(false), m_ApplyBilateralFilter(false), m_DataBuffer(nullptr),
-m_DataBufferCurrentIndex(0), m_DataBufferMaxSize(0), m_TemporalMedianFilterNumOfFrames(10), m_ThresholdFilterMin(1),
+m_ItkInputImage(nullptr), m_ApplyTemporalMedianFilter(false), m_ApplyAverageFilter(false),
+  m_ApplyMedianFilter(false), m_ApplyThresholdFilter(false), m_ApplyMaskSegmentation(false), m_ApplyBilateralFilter(false),
+m_DataBufferCurrentIndex(0), m_DataBufferMaxSize(0), m_DataBufferNumberOfFrames(0), m_TemporalMedianFilterNumOfFrames(10), m_ThresholdFilterMin(1),
 m_ThresholdFilterMax(7000), m_BilateralFilterDomainSigma(2), m_BilateralFilterRangeSigma(60), m_BilateralFilterKernelRadius(0)
 {
+  m_BilateralFilter = BilateralFilterType::New();
+  m_MultiThreader = itk::MultiThreaderBase::New();
 }
 
 mitk::ToFCompositeFilter::~ToFCompositeFilter()
 {
-  cvReleaseImage(&(this->m_IplDistanceImage));
-  cvReleaseImage(&(this->m_IplOutputImage));
-  if (m_DataBuffer!=nullptr)
-  {
-    delete [] m_DataBuffer;
-  }
 }
 
 void mitk::ToFCompositeFilter::SetInput(  const InputImageType* distanceImage )
@@ -49,32 +49,6 @@ void mitk::ToFCompositeFilter::SetInput( unsigned int idx,  const InputImageType
   }
   else
   {
-    if (idx==0) //create IPL image holding distance data
-    {
-      if (!distanceImage->IsEmpty())
-      {
-        this->m_ImageWidth = distanceImage->GetDimension(0);
-        this->m_ImageHeight = distanceImage->GetDimension(1);
-        this->m_ImageSize = this->m_ImageWidth * this->m_ImageHeight * sizeof(float);
-
-        if (this->m_IplDistanceImage != nullptr)
-        {
-          cvReleaseImage(&(this->m_IplDistanceImage));
-        }
-        ImageReadAccessor distImgAcc(distanceImage, distanceImage->GetSliceData(0,0,0));
-        float* distanceFloatData = (float*) distImgAcc.GetData();
-        this->m_IplDistanceImage = cvCreateImage(cvSize(this->m_ImageWidth, this->m_ImageHeight), IPL_DEPTH_32F, 1);
-        memcpy(this->m_IplDistanceImage->imageData, (void*)distanceFloatData, this->m_ImageSize);
-
-        if (this->m_IplOutputImage != nullptr)
-        {
-          cvReleaseImage(&(this->m_IplOutputImage));
-        }
-        this->m_IplOutputImage = cvCreateImage(cvSize(this->m_ImageWidth, this->m_ImageHeight), IPL_DEPTH_32F, 1);
-
-        CreateItkImage(this->m_ItkInputImage);
-      }
-    }
     this->ProcessObject::SetNthInput(idx, const_cast<InputImageType*>(distanceImage));   // Process object is not const-correct so the const_cast is required here
   }
 
@@ -95,53 +69,75 @@ void mitk::ToFCompositeFilter::SetInput( unsigned int idx,  const InputImageType
 
 void mitk::ToFCompositeFilter::GenerateData()
 {
-  // copy input 1...n to output 1...n
+  // initialize the outputs only if the input changed in order to keep their buffers
   for (unsigned int idx=0; idx<this->GetNumberOfOutputs(); idx++)
   {
     mitk::Image::Pointer outputImage = this->GetOutput(idx);
     mitk::Image::Pointer inputImage = this->GetInput(idx);
     if (outputImage.IsNotNull()&&inputImage.IsNotNull())
     {
-      ImageReadAccessor inputAcc(inputImage, inputImage->GetSliceData());
-      outputImage->CopyInformation(inputImage);
-      outputImage->Initialize(inputImage->GetPixelType(),inputImage->GetDimension(),inputImage->GetDimensions());
-      outputImage->SetSlice(inputAcc.GetData());
+      bool initialize = !outputImage->IsInitialized() || outputImage->GetPixelType() != inputImage->GetPixelType() ||
+        outputImage->GetDimension() != inputImage->GetDimension();
+      for (unsigned int dim = 0; !initialize && dim < inputImage->GetDimension(); ++dim)
+      {
+        initialize = outputImage->GetDimension(dim) != inputImage->GetDimension(dim);
+      }
+      if (initialize)
+      {
+        outputImage->CopyInformation(inputImage);
+        outputImage->Initialize(inputImage->GetPixelType(),inputImage->GetDimension(),inputImage->GetDimensions());
+      }
+      // copy input 1...n to output 1...n, output 0 is written by the filters below
+      if (idx > 0)
+      {
+        ImageReadAccessor inputAcc(inputImage, inputImage->GetSliceData());
+        outputImage->SetSlice(inputAcc.GetData());
+      }
     }
   }
-  //mitk::Image::Pointer outputDistanceImage = this->GetOutput();
-  ImageReadAccessor outputAcc(this->GetOutput(), this->GetOutput()->GetSliceData(0, 0, 0) );
-  float* outputDistanceFloatData = (float*) outputAcc.GetData();
-
-  //mitk::Image::Pointer inputDistanceImage = this->GetInput();
-  ImageReadAccessor inputAcc(this->GetInput(), this->GetInput()->GetSliceData(0, 0, 0) );
 
-  // copy initial distance image to ipl image
-  float* distanceFloatData = (float*)inputAcc.GetData();
-  memcpy(this->m_IplDistanceImage->imageData, (void*)distanceFloatData, this->m_ImageSize);
-  if (m_ApplyThresholdFilter||m_ApplyMaskSegmentation)
+  mitk::Image::Pointer inputDistanceImage = this->GetInput();
+  int width = inputDistanceImage->GetDimension(0);
+  int height = inputDistanceImage->GetDimension(1);
+  if (width != this->m_ImageWidth || height != this->m_ImageHeight)
   {
-    ProcessSegmentation(this->m_IplDistanceImage);
+    this->m_ImageWidth = width;
+    this->m_ImageHeight = height;
+    this->m_ImageSize = this->m_ImageWidth * this->m_ImageHeight * sizeof(float);
+    this->m_WorkBuffer.resize(this->m_ImageWidth * this->m_ImageHeight);
+    CreateItkImage(this->m_ItkInputImage);
   }
-  if (this->m_ApplyTemporalMedianFilter||this->m_ApplyAverageFilter)
+
+  ImageReadAccessor inputAcc(inputDistanceImage, inputDistanceImage->GetSliceData(0, 0, 0) );
+  const float* distanceFloatData = (const float*)inputAcc.GetData();
+
+  ImageWriteAccessor outputAcc(this->GetOutput(), this->GetOutput()->GetSliceData(0, 0, 0) );
+  float* outputDistanceFloatData = (float*) outputAcc.GetData();
+
+  std::unique_ptr<ImageReadAccessor> segMaskAcc;
+  const char* segmentationMask = nullptr;
+  if (m_ApplyMaskSegmentation && m_SegmentationMask.IsNotNull())
   {
-    ProcessStreamedQuickSelectMedianImageFilter(this->m_IplDistanceImage);
+    segMaskAcc.reset(new ImageReadAccessor(m_SegmentationMask, m_SegmentationMask->GetSliceData(0,0,0)));
+    segmentationMask = (const char*)segMaskAcc->GetData();
   }
+
+  // The pixel-wise filters are fused into one pass. Its result is written to the output directly
+  // unless the spatial median filter, which cannot work in place, follows.
+  float* pixelFilterResult = this->m_ApplyMedianFilter ? this->m_WorkBuffer.data() : outputDistanceFloatData;
+  ProcessSegmentationAndTemporalFilter(distanceFloatData, pixelFilterResult, segmentationMask);
+
   if (this->m_ApplyMedianFilter)
   {
-    ProcessCVMedianFilter(this->m_IplDistanceImage, this->m_IplOutputImage);
-    memcpy( this->m_IplDistanceImage->imageData, this->m_IplOutputImage->imageData, this->m_ImageSize );
+    ProcessCVMedianFilter(pixelFilterResult, outputDistanceFloatData);
   }
   if (this->m_ApplyBilateralFilter)
   {
-      float* itkFloatData = this->m_ItkInputImage->GetBufferPointer();
-      memcpy(itkFloatData, this->m_IplDistanceImage->imageData, this->m_ImageSize );
-      ItkImageType2D::Pointer itkOutputImage = ProcessItkBilateralFilter(this->m_ItkInputImage);
-      memcpy( this->m_IplDistanceImage->imageData, itkOutputImage->GetBufferPointer(), this->m_ImageSize );
+    ProcessItkBilateralFilter(outputDistanceFloatData, outputDistanceFloatData);
 
-    //ProcessCVBilateralFilter(this->m_IplDistanceImage, this->m_OutputIplImage, domainSigma, rangeSigma, kernelRadius);
-    //memcpy( distanceFloatData, this->m_OutputIplImage->imageData, distanceImageSize );
+    //ProcessCVBilateralFilter(outputDistanceFloatData, this->m_WorkBuffer.data());
+    //memcpy( outputDistanceFloatData, this->m_WorkBuffer.data(), this->m_ImageSize );
   }
-  memcpy( outputDistanceFloatData, this->m_IplDistanceImage->imageData, this->m_ImageSize );
 }
 
 void mitk::ToFCompositeFilter::CreateOutputsForAllInputs()
@@ -172,145 +168,120 @@ void mitk::ToFCompositeFilter::GenerateOutputInformation()
   output->SetPropertyList(input->GetPropertyList()->Clone());
 }
 
-void mitk::ToFCompositeFilter::ProcessSegmentation(IplImage* inputIplImage)
+void mitk::ToFCompositeFilter::ProcessSegmentationAndTemporalFilter(const float* input, float* output, const char* segmentationMask)
 {
-  char* segmentationMask;
-  if (m_SegmentationMask.IsNotNull())
-  {
-    ImageReadAccessor segMaskAcc(m_SegmentationMask, m_SegmentationMask->GetSliceData(0,0,0));
-    segmentationMask = (char*)segMaskAcc.GetData();
-  }
-  else
+  const bool applyTemporalFilter = (this->m_ApplyTemporalMedianFilter||this->m_ApplyAverageFilter) && this->m_TemporalMedianFilterNumOfFrames > 0;
+  int numberOfFrames = 0;
+  if (applyTemporalFilter)
   {
-    segmentationMask = nullptr;
+    InitializeTemporalFilterBuffer();
+    numberOfFrames = std::min(this->m_DataBufferNumberOfFrames + 1, this->m_DataBufferMaxSize);
   }
-  float *f = (float*)inputIplImage->imageData;
-  for(int i=0; i<this->m_ImageWidth*this->m_ImageHeight; i++)
+
+  const int width = this->m_ImageWidth;
+  const int bufferMaxSize = this->m_DataBufferMaxSize;
+  const int bufferIndex = this->m_DataBufferCurrentIndex;
+  float* dataBuffer = this->m_DataBuffer.data();
+
+  auto processRow = [&](itk::SizeValueType row)
   {
-    if (this->m_ApplyThresholdFilter)
+    // values of the temporal median window, sorted in place by quick_select
+    thread_local std::vector<float> tmpArray;
+    tmpArray.resize(bufferMaxSize);
+
+    const int rowEnd = (static_cast<int>(row) + 1) * width;
+    for (int i = static_cast<int>(row) * width; i < rowEnd; ++i)
     {
-      if (f[i]<=m_ThresholdFilterMin)
+      float value = input[i];
+      if (this->m_ApplyThresholdFilter)
       {
-        f[i] = 0.0;
+        if (value<=m_ThresholdFilterMin)
+        {
+          value = 0.0;
+        }
+        else if (value>=m_ThresholdFilterMax)
+        {
+          value = 0.0;
+        }
       }
-      else if (f[i]>=m_ThresholdFilterMax)
+      if (segmentationMask && segmentationMask[i]==0)
       {
-        f[i] = 0.0;
+        value = 0.0;
       }
-    }
-    if (this->m_ApplyMaskSegmentation)
-    {
-      if (segmentationMask)
+
+      if (applyTemporalFilter)
       {
-        if (segmentationMask[i]==0)
+        float* pixelBuffer = dataBuffer + static_cast<std::size_t>(i) * bufferMaxSize;
+        pixelBuffer[bufferIndex] = value;
+        if (m_ApplyAverageFilter)
+        {
+          float tmpValue = 0.0f;
+          for(int j=0; j<numberOfFrames; j++)
+          {
+            tmpValue+=pixelBuffer[j];
+          }
+          value = tmpValue/numberOfFrames;
+        }
+        else
         {
-          f[i] = 0.0;
+          std::copy(pixelBuffer, pixelBuffer + numberOfFrames, tmpArray.begin());
+          value = quick_select(tmpArray.data(), numberOfFrames);
         }
       }
+      output[i] = value;
     }
+  };
+  this->m_MultiThreader->ParallelizeArray(0, this->m_ImageHeight, processRow, nullptr);
+
+  if (applyTemporalFilter)
+  {
+    this->m_DataBufferNumberOfFrames = numberOfFrames;
+    this->m_DataBufferCurrentIndex = (this->m_DataBufferCurrentIndex + 1) % this->m_DataBufferMaxSize;
   }
 }
 
-ItkImageType2D::Pointer mitk::ToFCompositeFilter::ProcessItkBilateralFilter(ItkImageType2D::Pointer inputItkImage)
+void mitk::ToFCompositeFilter::InitializeTemporalFilterBuffer()
 {
-  ItkImageType2D::Pointer outputItkImage;
-  BilateralFilterType::Pointer bilateralFilter = BilateralFilterType::New();
-  bilateralFilter->SetInput(inputItkImage);
-  bilateralFilter->SetDomainSigma(m_BilateralFilterDomainSigma);
-  bilateralFilter->SetRangeSigma(m_BilateralFilterRangeSigma);
-  //bilateralFilter->SetRadius(m_BilateralFilterKernelRadius);
-  outputItkImage = bilateralFilter->GetOutput();
-  outputItkImage->Update();
-  return outputItkImage;
+  std::size_t bufferSize = static_cast<std::size_t>(this->m_TemporalMedianFilterNumOfFrames) * this->m_ImageWidth * this->m_ImageHeight;
+  if (this->m_TemporalMedianFilterNumOfFrames != this->m_DataBufferMaxSize || this->m_DataBuffer.size() != bufferSize) // reset
+  {
+    this->m_DataBufferMaxSize = this->m_TemporalMedianFilterNumOfFrames;
+    this->m_DataBuffer.assign(bufferSize, 0.0f);
+    this->m_DataBufferCurrentIndex = 0;
+    this->m_DataBufferNumberOfFrames = 0;
+  }
 }
 
-void mitk::ToFCompositeFilter::ProcessCVBilateralFilter(IplImage* inputIplImage, IplImage* outputIplImage)
+void mitk::ToFCompositeFilter::ProcessItkBilateralFilter(float* input, float* output)
 {
-  int diameter = m_BilateralFilterKernelRadius;
-  double sigmaColor = m_BilateralFilterRangeSigma;
-  double sigmaSpace = m_BilateralFilterDomainSigma;
-  cvSmooth(inputIplImage, outputIplImage, CV_BILATERAL, diameter, 0, sigmaColor, sigmaSpace);
+  // the ITK image uses the buffer of the input directly, the bilateral filter keeps its output buffer
+  this->m_ItkInputImage->GetPixelContainer()->SetImportPointer(input, this->m_ImageWidth * this->m_ImageHeight, false);
+  this->m_ItkInputImage->Modified();
+
+  this->m_BilateralFilter->SetInput(this->m_ItkInputImage);
+  this->m_BilateralFilter->SetDomainSigma(m_BilateralFilterDomainSigma);
+  this->m_BilateralFilter->SetRangeSigma(m_BilateralFilterRangeSigma);
+  //this->m_BilateralFilter->SetRadius(m_BilateralFilterKernelRadius);
+  this->m_BilateralFilter->Update();
+  memcpy( output, this->m_BilateralFilter->GetOutput()->GetBufferPointer(), this->m_ImageSize );
 }
 
-void mitk::ToFCompositeFilter::ProcessCVMedianFilter(IplImage* inputIplImage, IplImage* outputIplImage, int radius)
+void mitk::ToFCompositeFilter::ProcessCVBilateralFilter(float* input, float* output)
 {
-  cvSmooth(inputIplImage, outputIplImage, CV_MEDIAN, radius, 0, 0, 0);
+  int diameter = m_BilateralFilterKernelRadius;
+  double sigmaColor = m_BilateralFilterRangeSigma;
+  double sigmaSpace = m_BilateralFilterDomainSigma;
+  cv::Mat inputMat(this->m_ImageHeight, this->m_ImageWidth, CV_32FC1, input);
+  cv::Mat outputMat(this->m_ImageHeight, this->m_ImageWidth, CV_32FC1, output);
+  cv::bilateralFilter(inputMat, outputMat, diameter, sigmaColor, sigmaSpace);
 }
 
-void mitk::ToFCompositeFilter::ProcessStreamedQuickSelectMedianImageFilter(IplImage* inputIplImage)
+void mitk::ToFCompositeFilter::ProcessCVMedianFilter(float* input, float* output, int radius)
 {
-  float* data = (float*)inputIplImage->imageData;
-
-  int imageSize = inputIplImage->width * inputIplImage->height;
-  float* tmpArray;
-
-  if (this->m_TemporalMedianFilterNumOfFrames == 0)
-  {
-    return;
-  }
-
-  if (m_TemporalMedianFilterNumOfFrames != this->m_DataBufferMaxSize) // reset
-  {
-    //delete current buffer
-    for( int i=0; i<this->m_DataBufferMaxSize; i++ ) {
-      delete[] this->m_DataBuffer[i];
-    }
-    if (this->m_DataBuffer != nullptr)
-    {
-      delete[] this->m_DataBuffer;
-    }
-
-    this->m_DataBufferMaxSize = m_TemporalMedianFilterNumOfFrames;
-
-    // create new buffer with current size
-    this->m_DataBuffer = new float*[this->m_DataBufferMaxSize];
-    for(int i=0; i<this->m_DataBufferMaxSize; i++)
-    {
-      this->m_DataBuffer[i] = nullptr;
-    }
-    this->m_DataBufferCurrentIndex = 0;
-  }
-
-  int currentBufferSize = this->m_DataBufferMaxSize;
-  tmpArray = new float[this->m_DataBufferMaxSize];
-
-  // copy data to buffer
-  if (this->m_DataBuffer[this->m_DataBufferCurrentIndex] == nullptr)
-  {
-    this->m_DataBuffer[this->m_DataBufferCurrentIndex] = new float[imageSize];
-    currentBufferSize = this->m_DataBufferCurrentIndex + 1;
-  }
-
-  for(int j=0; j<imageSize; j++)
-  {
-    this->m_DataBuffer[this->m_DataBufferCurrentIndex][j] = data[j];
-  }
-
-  float tmpValue = 0.0f;
-  for(int i=0; i<imageSize; i++)
-  {
-    if (m_ApplyAverageFilter)
-    {
-      tmpValue = 0.0f;
-      for(int j=0; j<currentBufferSize; j++)
-      {
-          tmpValue+=this->m_DataBuffer[j][i];
-      }
-      data[i] = tmpValue/currentBufferSize;
-    }
-    else if (m_ApplyTemporalMedianFilter)
-    {
-      for(int j=0; j<currentBufferSize; j++)
-      {
-        tmpArray[j] = this->m_DataBuffer[j][i];
-      }
-      data[i] = quick_select(tmpArray, currentBufferSize);
-    }
-  }
-
-  this->m_DataBufferCurrentIndex = (this->m_DataBufferCurrentIndex + 1) % this->m_DataBufferMaxSize;
-
-  delete[] tmpArray;
+  // the OpenCV matrices only wrap the buffers, no data is copied
+  cv::Mat inputMat(this->m_ImageHeight, this->m_ImageWidth, CV_32FC1, input);
+  cv::Mat outputMat(this->m_ImageHeight, this->m_ImageWidth, CV_32FC1, output);
+  cv::medianBlur(inputMat, outputMat, radius);
 }
 
 #define ELEM_SWAP(a,b) { float t=(a);(a)=(b);(b)=t; }
@@ -380,6 +351,18 @@ void mitk::ToFCompositeFilter::SetBilateralFilterParameter(double domainSigma, d
   this->m_BilateralFilterKernelRadius = kernelRadius;
 }
 
+void mitk::ToFCompositeFilter::SetNumberOfWorkUnits(unsigned int numberOfWorkUnits)
+{
+  this->m_MultiThreader->SetNumberOfWorkUnits(numberOfWorkUnits);
+  this->m_BilateralFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+  this->Modified();
+}
+
+unsigned int mitk::ToFCompositeFilter::GetNumberOfWorkUnits() const
+{
+  return this->m_MultiThreader->GetNumberOfWorkUnits();
+}
+
 void mitk::ToFCompositeFilter::CreateItkImage(ItkImageType2D::Pointer &itkInputImage)
 {
   itkInputImage = ItkImageType2D::New();
@@ -393,6 +376,5 @@ void mitk::ToFCompositeFilter::CreateItkImage(ItkImageType2D::Pointer &itkInputI
   region.SetSize( size );
   region.SetIndex( startIndex );
   itkInputImage->SetRegions( region );
-  itkInputImage->Allocate();
-
+  // no allocation, the buffer is imported in ProcessItkBilateralFilter()
 }
@@ -16,7 +16,9 @@ found in the LICENSE file.
 #include "mitkImageToImageFilter.h"
 #include <MitkToFProcessingExports.h>
 #include <itkBilateralImageFilter.h>
-#include <opencv2/core/types_c.h>
+#include <itkMultiThreaderBase.h>
+
+#include <vector>
 
 typedef itk::Image<float, 2> ItkImageType2D;
 typedef itk::Image<float, 3> ItkImageType3D;
@@ -35,6 +37,10 @@ namespace mitk
   * - spatial median filter
   * - bilateral filter
   *
+  * The filter is meant for streaming data: threshold, mask segmentation and the temporal filters are applied
+  * in a single multithreaded pass over the frame. The last frames are kept in a preallocated ring buffer and
+  * all intermediate buffers are reused between frames.
+  *
   * @ingroup ToFProcessing
   */
   class MITKTOFPROCESSING_EXPORT ToFCompositeFilter : public ImageToImageFilter
@@ -100,6 +106,15 @@ namespace mitk
     \param kernelRadius radius of the filter mask of the bilateral filter
     */
     void SetBilateralFilterParameter(double domainSigma, double rangeSigma, int kernelRadius);
+    /*!
+    \brief Sets the number of work units the rows of the image are distributed to
+    \param numberOfWorkUnits 1 processes the image sequentially. Default value: number of cores
+    */
+    void SetNumberOfWorkUnits(unsigned int numberOfWorkUnits);
+    /*!
+    \brief Returns the number of work units the rows of the image are distributed to
+    */
+    unsigned int GetNumberOfWorkUnits() const;
 
   protected:
     /*!
@@ -125,27 +140,26 @@ namespace mitk
     */
     void CreateOutputsForAllInputs();
     /*!
-    \brief Applies a mask and/or threshold segmentation to the input image.
+    \brief Applies the mask and/or threshold segmentation and the temporal median or average filter in one pass.
     All pixels with values outside the mask, below the lower threshold (min) and above the upper threshold (max)
-    are assigned the pixel value 0
+    are assigned the pixel value 0 before they are added to the temporal filter buffer.
+    \param input distance data of the current frame
+    \param output may be the same as input
+    \param segmentationMask mask with the size of the input or nullptr
     */
-    void ProcessSegmentation(IplImage* inputIplImage);
+    void ProcessSegmentationAndTemporalFilter(const float* input, float* output, const char* segmentationMask);
     /*!
     \brief Applies the ITK bilateral filter to the input image
     */
-    ItkImageType2D::Pointer ProcessItkBilateralFilter(ItkImageType2D::Pointer inputItkImage);
+    void ProcessItkBilateralFilter(float* input, float* output);
     /*!
     \brief Applies the OpenCV bilateral filter to the input image.
     */
-    void ProcessCVBilateralFilter(IplImage* inputIplImage, IplImage* outputIplImage);
+    void ProcessCVBilateralFilter(float* input, float* output);
     /*!
-    \brief Applies the OpenCV median filter to the input image.
+    \brief Applies the OpenCV median filter to the input image. input and output must be different.
     */
-    void ProcessCVMedianFilter(IplImage* inputIplImage, IplImage* outputIplImage, int radius = 3);
-    /*!
-    \brief Performs temporal median filter on an image given the number of frames to be considered
-    */
-    void ProcessStreamedQuickSelectMedianImageFilter(IplImage* inputIplImage);
+    void ProcessCVMedianFilter(float* input, float* output, int radius = 3);
     /*!
     \brief Quickselect algorithm
     * This Quickselect routine is based on the algorithm described in
@@ -153,9 +167,13 @@ namespace mitk
     * Cambridge University Press, 1992, Section 8.5, ISBN 0-521-43108-5
     * This code by Nicolas Devillard - 1998. Public domain.
     */
-    float quick_select(float arr[], int n);
+    static float quick_select(float arr[], int n);
     /*!
-    \brief Initialize and allocate a 2D ITK image of dimension m_ImageWidth*m_ImageHeight
+    \brief Allocates the ring buffer of the temporal filters if its size or the image size changed
+    */
+    void InitializeTemporalFilterBuffer();
+    /*!
+    \brief Initialize a 2D ITK image of dimension m_ImageWidth*m_ImageHeight without allocating its buffer
     */
     void CreateItkImage(ItkImageType2D::Pointer &itkInputImage);
 
@@ -165,10 +183,12 @@ namespace mitk
     int m_ImageHeight; ///< y-dimension of the image
     int m_ImageSize; ///< size of the image in bytes
 
-    IplImage* m_IplDistanceImage; ///< OpenCV-representation of the distance image
-    IplImage* m_IplOutputImage; ///< OpenCV-representation of the output image
+    std::vector<float> m_WorkBuffer; ///< Intermediate result of the spatial filters
+
+    ItkImageType2D::Pointer m_ItkInputImage; ///< ITK image importing the buffer processed by the bilateral filter
+    BilateralFilterType::Pointer m_BilateralFilter; ///< Bilateral filter, kept to reuse its output buffer
 
-    ItkImageType2D::Pointer m_ItkInputImage; ///< ITK representation of the distance image
+    itk::MultiThreaderBase::Pointer m_MultiThreader; ///< Distributes the rows of the fused filter pass
 
     bool m_ApplyTemporalMedianFilter; ///< Flag indicating if the temporal median filter is currently active for processing the distance image
     bool m_ApplyAverageFilter; ///< Flag indicating if the average filter is currently active for processing the distance image
@@ -177,9 +197,10 @@ namespace mitk
     bool m_ApplyMaskSegmentation; ///< Flag indicating if a mask segmentation is performed
     bool m_ApplyBilateralFilter; ///< Flag indicating if the bilateral filter is currently active for processing the distance image
 
-    float** m_DataBuffer; ///< Buffer used for calculating the pixel-wise median over the last n (m_TemporalMedianFilterNumOfFrames) number of frames
+    std::vector<float> m_DataBuffer; ///< Ring buffer holding the last n (m_TemporalMedianFilterNumOfFrames) frames pixel by pixel, i.e. the values of one pixel are contiguous
     int m_DataBufferCurrentIndex; ///< Current index in the buffer of the temporal median filter
-    int m_DataBufferMaxSize; ///< Maximal size for the buffer of the temporal median filter (m_DataBuffer)
+    int m_DataBufferMaxSize; ///< Maximal number of frames in the buffer of the temporal median filter (m_DataBuffer)
+    int m_DataBufferNumberOfFrames; ///< Number of frames currently stored in m_DataBuffer
 
     int m_TemporalMedianFilterNumOfFrames; ///< Number of frames to be used in the calculation of the temporal median
     int m_ThresholdFilterMin; ///< Lower threshold of the threshold filter. Pixels with values below will be assigned value 0 when applying the threshold filter
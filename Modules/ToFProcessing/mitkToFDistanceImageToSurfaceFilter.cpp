@@ -30,7 +30,7 @@ found in the LICENSE file.
 
 mitk::ToFDistanceImageToSurfaceFilter::ToFDistanceImageToSurfaceFilter() :
   m_IplScalarImage(nullptr), m_CameraIntrinsics(), m_TextureImageWidth(0), m_TextureImageHeight(0), m_InterPixelDistance(), m_TextureIndex(0),
-  m_GenerateTriangularMesh(true), m_TriangulationThreshold(0.0)
+  m_GenerateTriangularMesh(true), m_TriangulationThreshold(0.0), m_CurrentMeshBuffer(0)
 {
   m_InterPixelDistance.Fill(0.045);
   m_CameraIntrinsics = mitk::CameraIntrinsics::New();
@@ -38,6 +38,27 @@ mitk::ToFDistanceImageToSurfaceFilter::ToFDistanceImageToSurfaceFilter() :
   m_CameraIntrinsics->SetPrincipalPoint(107.867935181,98.3807373047);
   m_CameraIntrinsics->SetDistorsionCoeffs(-0.486690014601f,0.553943634033f,0.00222016777843f,-0.00300851115026f);
   m_ReconstructionMode = WithInterPixelDistance;
+
+  // The output mesh is handed out to consumers, e.g. the render window. Two meshes are used
+  // alternately, so the mesh of the previous update is never modified while the next one is generated.
+  for (auto& buffer : m_MeshBuffers)
+  {
+    buffer.Points = vtkSmartPointer<vtkPoints>::New();
+    buffer.Points->SetDataTypeToDouble();
+    buffer.Polys = vtkSmartPointer<vtkCellArray>::New();
+    buffer.Vertices = vtkSmartPointer<vtkCellArray>::New();
+    buffer.ScalarArray = vtkSmartPointer<vtkFloatArray>::New();
+    buffer.TextureCoords = vtkSmartPointer<vtkFloatArray>::New();
+    buffer.TextureCoords->SetNumberOfComponents(2);
+
+    buffer.Mesh = vtkSmartPointer<vtkPolyData>::New();
+    buffer.Mesh->SetPoints(buffer.Points);
+    buffer.Mesh->SetPolys(buffer.Polys);
+    buffer.Mesh->SetVerts(buffer.Vertices);
+
+    buffer.TopologyWidth = -1;
+    buffer.TopologyIsTriangulated = false;
+  }
 }
 
 mitk::ToFDistanceImageToSurfaceFilter::~ToFDistanceImageToSurfaceFilter()
@@ -85,53 +106,11 @@ mitk::Image* mitk::ToFDistanceImageToSurfaceFilter::GetInput( unsigned int idx )
   return static_cast< mitk::Image*>(this->ProcessObject::GetInput(idx));
 }
 
-void mitk::ToFDistanceImageToSurfaceFilter::GenerateData()
+void mitk::ToFDistanceImageToSurfaceFilter::UpdateRayTable(mitk::Image* input)
 {
-  mitk::Surface::Pointer output = this->GetOutput();
-  assert(output);
-  mitk::Image::Pointer input = this->GetInput();
-  assert(input);
-  // mesh points
   int xDimension = input->GetDimension(0);
   int yDimension = input->GetDimension(1);
-  unsigned int size = xDimension*yDimension; //size of the image-array
-  std::vector<bool> isPointValid;
-  isPointValid.resize(size);
-  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-  points->SetDataTypeToDouble();
-  vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
-  vtkSmartPointer<vtkCellArray> vertices = vtkSmartPointer<vtkCellArray>::New();
-  vtkSmartPointer<vtkFloatArray> scalarArray = vtkSmartPointer<vtkFloatArray>::New();
-  vtkSmartPointer<vtkFloatArray> textureCoords = vtkSmartPointer<vtkFloatArray>::New();
-  textureCoords->SetNumberOfComponents(2);
-  textureCoords->Allocate(size);
-
-  //Make a vtkIdList to save the ID's of the polyData corresponding to the image
-  //pixel ID's. See below for more documentation.
-  m_VertexIdList = vtkSmartPointer<vtkIdList>::New();
-  //Allocate the object once else it would automatically allocate new memory
-  //for every vertex and perform a copy which is expensive.
-  m_VertexIdList->Allocate(size);
-  m_VertexIdList->SetNumberOfIds(size);
-  for(unsigned int i = 0; i < size; ++i)
-  {
-    m_VertexIdList->SetId(i, 0);
-  }
-
-  float* scalarFloatData = nullptr;
 
-  if (this->m_IplScalarImage) // if scalar image is defined use it for texturing
-  {
-    scalarFloatData = (float*)this->m_IplScalarImage->imageData;
-  }
-  else if (this->GetInput(m_TextureIndex)) // otherwise use intensity image (input(2))
-  {
-    ImageReadAccessor inputAcc(this->GetInput(m_TextureIndex));
-    scalarFloatData = (float*)inputAcc.GetData();
-  }
-
-  ImageReadAccessor inputAcc(input, input->GetSliceData(0,0,0));
-  float* inputFloatData = (float*)inputAcc.GetData();
   //calculate world coordinates
   mitk::ToFProcessingCommon::ToFPoint2D focalLengthInPixelUnits;
   mitk::ToFProcessingCommon::ToFScalarType focalLengthInMm;
@@ -162,149 +141,268 @@ void mitk::ToFDistanceImageToSurfaceFilter::GenerateData()
   mitk::Point3D origin = input->GetGeometry()->GetOrigin();
   mitk::Vector3D spacing = input->GetGeometry()->GetSpacing();
 
+  // the intrinsics may be changed without modifying the filter, so the values are compared
+  std::vector<double> parameters = { static_cast<double>(m_ReconstructionMode), static_cast<double>(xDimension), static_cast<double>(yDimension),
+                                     focalLengthInPixelUnits[0], focalLengthInPixelUnits[1], focalLengthInMm,
+                                     m_InterPixelDistance[0], m_InterPixelDistance[1], principalPoint[0], principalPoint[1],
+                                     origin[0], origin[1], spacing[0], spacing[1] };
+  if (parameters == m_RayTableParameters)
+    return;
+
+  m_RayTableParameters = parameters;
+  m_RayTable.assign(3 * xDimension * yDimension, 0.0);
+
+  if ((m_ReconstructionMode != WithOutInterPixelDistance) && (m_ReconstructionMode != WithInterPixelDistance) && (m_ReconstructionMode != Kinect))
+  {
+    MITK_ERROR << "Incorrect reconstruction mode!";
+    return;
+  }
+
   for (int j=0; j<yDimension; j++)
   {
     for (int i=0; i<xDimension; i++)
     {
-      unsigned int pixelID = i+j*xDimension;
-
-      mitk::ToFProcessingCommon::ToFScalarType distance = (double)inputFloatData[pixelID];
-
       /** Here we have to incorporate spacing and origin to allow processing of cropped/resampled images
       * Usually origin will be [0, 0, 0] and spacing will be [1, 1, 1], but just in case the image is moved
       * due to cropping or the spacing differes due to up- or downsampling.*/
       unsigned int completeIndexX = i*spacing[0]+origin[0];
       unsigned int completeIndexY = j*spacing[1]+origin[1];
 
-      mitk::ToFProcessingCommon::ToFPoint3D cartesianCoordinates;
+      // all reconstruction modes are linear in the distance, so the point for distance 1 is the ray of the pixel
+      mitk::ToFProcessingCommon::ToFPoint3D ray;
       switch (m_ReconstructionMode)
       {
       case WithOutInterPixelDistance:
       {
-        cartesianCoordinates = mitk::ToFProcessingCommon::IndexToCartesianCoordinates(completeIndexX,completeIndexY,distance,focalLengthInPixelUnits,principalPoint);
+        ray = mitk::ToFProcessingCommon::IndexToCartesianCoordinates(completeIndexX,completeIndexY,1.0,focalLengthInPixelUnits,principalPoint);
         break;
       }
       case WithInterPixelDistance:
       {
-        cartesianCoordinates = mitk::ToFProcessingCommon::IndexToCartesianCoordinatesWithInterpixdist(completeIndexX,completeIndexY,distance,focalLengthInMm,m_InterPixelDistance,principalPoint);
-        break;
-      }
-      case Kinect:
-      {
-        cartesianCoordinates = mitk::ToFProcessingCommon::KinectIndexToCartesianCoordinates(completeIndexX,completeIndexY,distance,focalLengthInPixelUnits,principalPoint);
+        ray = mitk::ToFProcessingCommon::IndexToCartesianCoordinatesWithInterpixdist(completeIndexX,completeIndexY,1.0,focalLengthInMm,m_InterPixelDistance,principalPoint);
         break;
       }
       default:
       {
-        MITK_ERROR << "Incorrect reconstruction mode!";
+        ray = mitk::ToFProcessingCommon::KinectIndexToCartesianCoordinates(completeIndexX,completeIndexY,1.0,focalLengthInPixelUnits,principalPoint);
       }
       }
-      //Epsilon here, because we may have small float values like 0.00000001 which in fact represents 0.
-      if (distance<=mitk::eps)
+
+      double* tableEntry = &m_RayTable[3 * (i + j*xDimension)];
+      tableEntry[0] = ray[0];
+      tableEntry[1] = ray[1];
+      tableEntry[2] = ray[2];
+    }
+  }
+}
+
+void mitk::ToFDistanceImageToSurfaceFilter::UpdateTopology(MeshBuffer& buffer, int xDimension, int yDimension, const double* points)
+{
+  const vtkIdType* vertexIds = m_VertexIdList->GetPointer(0);
+
+  buffer.Polys->Reset();
+  buffer.Vertices->Reset();
+
+  for (int j=0; j<yDimension; j++)
+  {
+    for (int i=0; i<xDimension; i++)
+    {
+      unsigned int pixelID = i+j*xDimension;
+      if (!m_ValidityMask[pixelID])
+        continue;
+
+      if (!m_GenerateTriangularMesh)
+      {
+        //We dont want triangulation, we only want vertices
+        buffer.Vertices->InsertNextCell(1);
+        buffer.Vertices->InsertCellPoint(vertexIds[pixelID]);
+        continue;
+      }
+
+      //We can only start triangulation if we are at vertex (1,1),
+      //because we need the other 3 vertices near this one.
+      if ((i < 1) || (j < 1))
+        continue;
+
+      //This little piece of art explains the ID's:
+      //
+      // P(x_1y_1)---P(xy_1)
+      // |           |
+      // |           |
+      // |           |
+      // P(x_1y)-----P(xy)
+      //
+      //To go one pixel line back in the image array, we have to
+      //subtract 1x xDimension.
+      vtkIdType xy = pixelID;
+      vtkIdType x_1y = pixelID-1;
+      vtkIdType xy_1 = pixelID-xDimension;
+      vtkIdType x_1y_1 = xy_1-1;
+
+      if (!(m_ValidityMask[x_1y] && m_ValidityMask[x_1y_1] && m_ValidityMask[xy_1])) // check if points of cell are valid
+        continue;
+
+      //Find the corresponding vertex ID's in the saved vertexIdList:
+      vtkIdType xyV = vertexIds[xy];
+      vtkIdType x_1yV = vertexIds[x_1y];
+      vtkIdType xy_1V = vertexIds[xy_1];
+      vtkIdType x_1y_1V = vertexIds[x_1y_1];
+
+      const double* pointXY = points + 3*xyV;
+      const double* pointX_1Y = points + 3*x_1yV;
+      const double* pointXY_1 = points + 3*xy_1V;
+      const double* pointX_1Y_1 = points + 3*x_1y_1V;
+
+      if( (mitk::Equal(m_TriangulationThreshold, 0.0)) || ((vtkMath::Distance2BetweenPoints(pointXY, pointX_1Y) <= m_TriangulationThreshold)
+                                                           && (vtkMath::Distance2BetweenPoints(pointXY, pointXY_1) <= m_TriangulationThreshold)
+                                                           && (vtkMath::Distance2BetweenPoints(pointX_1Y, pointX_1Y_1) <= m_TriangulationThreshold)
+                                                           && (vtkMath::Distance2BetweenPoints(pointXY_1, pointX_1Y_1) <= m_TriangulationThreshold)))
       {
-        isPointValid[pixelID] = false;
+        vtkIdType firstTriangle[3] = { x_1yV, xyV, x_1y_1V };
+        vtkIdType secondTriangle[3] = { x_1y_1V, xyV, xy_1V };
+        buffer.Polys->InsertNextCell(3, firstTriangle);
+        buffer.Polys->InsertNextCell(3, secondTriangle);
       }
       else
       {
-        isPointValid[pixelID] = true;
-        //VTK would insert empty points into the polydata if we use
-        //points->InsertPoint(pixelID, cartesianCoordinates.GetDataPointer()).
-        //If we use points->InsertNextPoint(...) instead, the ID's do not
-        //correspond to the image pixel ID's. Thus, we have to save them
-        //in the vertexIdList.
-        m_VertexIdList->SetId(pixelID, points->InsertNextPoint(cartesianCoordinates.GetDataPointer()));
-
-        if (m_GenerateTriangularMesh)
-        {
-          if((i >= 1) && (j >= 1))
-          {
-            //This little piece of art explains the ID's:
-            //
-            // P(x_1y_1)---P(xy_1)
-            // |           |
-            // |           |
-            // |           |
-            // P(x_1y)-----P(xy)
-            //
-            //We can only start triangulation if we are at vertex (1,1),
-            //because we need the other 3 vertices near this one.
-            //To go one pixel line back in the image array, we have to
-            //subtract 1x xDimension.
-            vtkIdType xy = pixelID;
-            vtkIdType x_1y = pixelID-1;
-            vtkIdType xy_1 = pixelID-xDimension;
-            vtkIdType x_1y_1 = xy_1-1;
-
-            //Find the corresponding vertex ID's in the saved vertexIdList:
-            vtkIdType xyV = m_VertexIdList->GetId(xy);
-            vtkIdType x_1yV = m_VertexIdList->GetId(x_1y);
-            vtkIdType xy_1V = m_VertexIdList->GetId(xy_1);
-            vtkIdType x_1y_1V = m_VertexIdList->GetId(x_1y_1);
-
-            if (isPointValid[xy]&&isPointValid[x_1y]&&isPointValid[x_1y_1]&&isPointValid[xy_1]) // check if points of cell are valid
-            {
-              double pointXY[3], pointX_1Y[3], pointXY_1[3], pointX_1Y_1[3];
-
-              points->GetPoint(xyV, pointXY);
-              points->GetPoint(x_1yV, pointX_1Y);
-              points->GetPoint(xy_1V, pointXY_1);
-              points->GetPoint(x_1y_1V, pointX_1Y_1);
-
-              if( (mitk::Equal(m_TriangulationThreshold, 0.0)) || ((vtkMath::Distance2BetweenPoints(pointXY, pointX_1Y) <= m_TriangulationThreshold)
-                                                                   && (vtkMath::Distance2BetweenPoints(pointXY, pointXY_1) <= m_TriangulationThreshold)
-                                                                   && (vtkMath::Distance2BetweenPoints(pointX_1Y, pointX_1Y_1) <= m_TriangulationThreshold)
-                                                                   && (vtkMath::Distance2BetweenPoints(pointXY_1, pointX_1Y_1) <= m_TriangulationThreshold)))
-              {
-                polys->InsertNextCell(3);
-                polys->InsertCellPoint(x_1yV);
-                polys->InsertCellPoint(xyV);
-                polys->InsertCellPoint(x_1y_1V);
-
-                polys->InsertNextCell(3);
-                polys->InsertCellPoint(x_1y_1V);
-                polys->InsertCellPoint(xyV);
-                polys->InsertCellPoint(xy_1V);
-              }
-              else
-              {
-                //We dont want triangulation, but we want to keep the vertex
-                vertices->InsertNextCell(1);
-                vertices->InsertCellPoint(xyV);
-              }
-            }
-          }
-        }
-        else
-        {
-          //We dont want triangulation, we only want vertices
-          vertices->InsertNextCell(1);
-          vertices->InsertCellPoint(m_VertexIdList->GetId(pixelID));
-        }
-        //Scalar values are necessary for mapping colors/texture onto the surface
-        if (scalarFloatData)
-        {
-          scalarArray->InsertTuple1(m_VertexIdList->GetId(pixelID), scalarFloatData[pixelID]);
-        }
-        //These Texture Coordinates will map color pixel and vertices 1:1 (e.g. for Kinect).
-        float xNorm = (((float)i)/xDimension);// correct video texture scale for kinect
-        float yNorm = ((float)j)/yDimension; //don't flip. we don't need to flip.
-        textureCoords->InsertTuple2(m_VertexIdList->GetId(pixelID), xNorm, yNorm);
+        //We dont want triangulation, but we want to keep the vertex
+        buffer.Vertices->InsertNextCell(1);
+        buffer.Vertices->InsertCellPoint(xyV);
       }
     }
   }
 
-  vtkSmartPointer<vtkPolyData> mesh = vtkSmartPointer<vtkPolyData>::New();
-  mesh->SetPoints(points);
-  mesh->SetPolys(polys);
-  mesh->SetVerts(vertices);
+  buffer.Polys->Modified();
+  buffer.Vertices->Modified();
+
+  // Without threshold the topology only depends on the valid pixels and can be reused by later frames
+  buffer.TopologyValidityMask = m_ValidityMask;
+  buffer.TopologyWidth = mitk::Equal(m_TriangulationThreshold, 0.0) ? xDimension : -1;
+  buffer.TopologyIsTriangulated = m_GenerateTriangularMesh;
+}
+
+void mitk::ToFDistanceImageToSurfaceFilter::GenerateData()
+{
+  mitk::Surface::Pointer output = this->GetOutput();
+  assert(output);
+  mitk::Image::Pointer input = this->GetInput();
+  assert(input);
+  // mesh points
+  int xDimension = input->GetDimension(0);
+  int yDimension = input->GetDimension(1);
+  unsigned int size = xDimension*yDimension; //size of the image-array
+
+  float* scalarFloatData = nullptr;
+
+  if (this->m_IplScalarImage) // if scalar image is defined use it for texturing
+  {
+    scalarFloatData = (float*)this->m_IplScalarImage->imageData;
+  }
+  else if (this->GetInput(m_TextureIndex)) // otherwise use intensity image (input(2))
+  {
+    ImageReadAccessor inputAcc(this->GetInput(m_TextureIndex));
+    scalarFloatData = (float*)inputAcc.GetData();
+  }
+
+  ImageReadAccessor inputAcc(input, input->GetSliceData(0,0,0));
+  float* inputFloatData = (float*)inputAcc.GetData();
+
+  this->UpdateRayTable(input);
+
+  //Epsilon here, because we may have small float values like 0.00000001 which in fact represents 0.
+  m_ValidityMask.resize(size);
+  vtkIdType numberOfPoints = 0;
+  for (unsigned int pixelID = 0; pixelID < size; ++pixelID)
+  {
+    m_ValidityMask[pixelID] = inputFloatData[pixelID] > mitk::eps;
+    numberOfPoints += m_ValidityMask[pixelID];
+  }
+
+  //VTK would insert empty points into the polydata if we use the pixel ID's
+  //as point ID's. Thus, the points are stored consecutively and we have to
+  //save the point ID of each pixel in the vertexIdList.
+  if (m_VertexIdList == nullptr || m_VertexIdList->GetNumberOfIds() != static_cast<vtkIdType>(size) ||
+      m_ValidityMask != m_VertexIdValidityMask)
+  {
+    if (m_VertexIdList == nullptr)
+    {
+      m_VertexIdList = vtkSmartPointer<vtkIdList>::New();
+    }
+    //Allocate the object once else it would automatically allocate new memory
+    //for every vertex and perform a copy which is expensive.
+    m_VertexIdList->SetNumberOfIds(size);
+    vtkIdType* vertexIds = m_VertexIdList->GetPointer(0);
+    vtkIdType vertexID = 0;
+    for (unsigned int pixelID = 0; pixelID < size; ++pixelID)
+    {
+      vertexIds[pixelID] = m_ValidityMask[pixelID] ? vertexID++ : 0;
+    }
+    m_VertexIdValidityMask = m_ValidityMask;
+  }
+
+  // generate the output in the mesh that was not handed out by the last update
+  m_CurrentMeshBuffer = 1 - m_CurrentMeshBuffer;
+  MeshBuffer& buffer = m_MeshBuffers[m_CurrentMeshBuffer];
+
+  buffer.Points->SetNumberOfPoints(numberOfPoints);
+  buffer.TextureCoords->SetNumberOfTuples(numberOfPoints);
+  buffer.ScalarArray->SetNumberOfTuples(scalarFloatData ? numberOfPoints : 0);
+
+  double* points = static_cast<double*>(buffer.Points->GetVoidPointer(0));
+  float* textureCoords = buffer.TextureCoords->GetPointer(0);
+  float* scalars = scalarFloatData ? buffer.ScalarArray->GetPointer(0) : nullptr;
+  const double* rays = m_RayTable.data();
+
+  vtkIdType pointID = 0;
+  for (int j=0; j<yDimension; j++)
+  {
+    //don't flip. we don't need to flip.
+    float yNorm = ((float)j)/yDimension;
+    for (int i=0; i<xDimension; i++)
+    {
+      unsigned int pixelID = i+j*xDimension;
+      if (!m_ValidityMask[pixelID])
+        continue;
+
+      double distance = (double)inputFloatData[pixelID];
+      const double* ray = rays + 3*pixelID;
+      double* point = points + 3*pointID;
+      point[0] = distance*ray[0];
+      point[1] = distance*ray[1];
+      point[2] = distance*ray[2];
+
+      //Scalar values are necessary for mapping colors/texture onto the surface
+      if (scalars)
+      {
+        scalars[pointID] = scalarFloatData[pixelID];
+      }
+      //These Texture Coordinates will map color pixel and vertices 1:1 (e.g. for Kinect).
+      textureCoords[2*pointID] = ((float)i)/xDimension;// correct video texture scale for kinect
+      textureCoords[2*pointID+1] = yNorm;
+      ++pointID;
+    }
+  }
+  buffer.Points->Modified();
+  buffer.TextureCoords->Modified();
+  buffer.ScalarArray->Modified();
+
+  if (buffer.TopologyWidth != xDimension || buffer.TopologyIsTriangulated != m_GenerateTriangularMesh ||
+      buffer.TopologyValidityMask != m_ValidityMask)
+  {
+    this->UpdateTopology(buffer, xDimension, yDimension, points);
+  }
+
+  buffer.Mesh->GetPointData()->Initialize();
   //Pass the scalars to the polydata (if they were set).
-  if (scalarArray->GetNumberOfTuples()>0)
+  if (buffer.ScalarArray->GetNumberOfTuples()>0)
   {
-    mesh->GetPointData()->SetScalars(scalarArray);
+    buffer.Mesh->GetPointData()->SetScalars(buffer.ScalarArray);
   }
   //Pass the TextureCoords to the polydata anyway (to save them).
-  mesh->GetPointData()->SetTCoords(textureCoords);
-  output->SetVtkPolyData(mesh);
+  buffer.Mesh->GetPointData()->SetTCoords(buffer.TextureCoords);
+  buffer.Mesh->Modified();
+
+  output->SetVtkPolyData(buffer.Mesh);
 }
 
 void mitk::ToFDistanceImageToSurfaceFilter::CreateOutputsForAllInputs()
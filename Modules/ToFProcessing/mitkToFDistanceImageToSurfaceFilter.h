@@ -23,9 +23,15 @@ found in the LICENSE file.
 
 #include <vtkSmartPointer.h>
 #include <vtkIdList.h>
+#include <vtkCellArray.h>
+#include <vtkFloatArray.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
 
 #include <opencv2/core/types_c.h>
 
+#include <vector>
+
 namespace mitk
 {
   /**
@@ -40,6 +46,11 @@ namespace mitk
   * The definition of the image plane and its coordinate systems (pixel and mm) is depicted in the following image
   * \image html Modules/ToFProcessing/Documentation/ImagePlane.png
   *
+  * For streaming data the filter keeps the ray of each pixel for the current camera intrinsics, so that a 3D point
+  * is the product of the measured distance and the ray. The triangles are kept as long as the set of valid pixels
+  * does not change and no triangulation threshold is set. The vtkPolyData of the output is reused by every update,
+  * use DeepCopy() to keep the result of a single frame.
+  *
   * @ingroup SurfaceFilters
   * @ingroup ToFProcessing
   */
@@ -170,6 +181,17 @@ namespace mitk
     */
     void CreateOutputsForAllInputs();
 
+    /*!
+    \brief Recomputes m_RayTable if the camera intrinsics, the reconstruction mode or the geometry of the input changed
+    */
+    void UpdateRayTable(Image* input);
+
+    /*!
+    \brief Rebuilds the triangles and vertices of the given mesh for the current m_ValidityMask and m_VertexIdList
+    \param points the reconstructed points in the order of m_VertexIdList
+    */
+    void UpdateTopology(MeshBuffer& buffer, int xDimension, int yDimension, const double* points);
+
     IplImage* m_IplScalarImage; ///< Scalar image used for surface texturing
 
     mitk::CameraIntrinsics::Pointer m_CameraIntrinsics; ///< Specifies the intrinsic parameters
@@ -187,6 +209,29 @@ namespace mitk
 
     double m_TriangulationThreshold;
 
+    std::vector<double> m_RayTable; ///< Cartesian coordinates of each pixel for a distance of 1 (x, y, z interleaved)
+    std::vector<double> m_RayTableParameters; ///< Intrinsics, mode and input geometry m_RayTable was computed for
+    std::vector<unsigned char> m_ValidityMask; ///< Pixels with a distance > eps in the last processed frame
+    std::vector<unsigned char> m_VertexIdValidityMask; ///< Validity mask m_VertexIdList was generated for
+
+    /**
+    \brief Output mesh with its arrays and the state its topology was generated for
+    */
+    struct MeshBuffer
+    {
+      vtkSmartPointer<vtkPolyData> Mesh;
+      vtkSmartPointer<vtkPoints> Points;
+      vtkSmartPointer<vtkCellArray> Polys;
+      vtkSmartPointer<vtkCellArray> Vertices;
+      vtkSmartPointer<vtkFloatArray> ScalarArray;
+      vtkSmartPointer<vtkFloatArray> TextureCoords;
+      std::vector<unsigned char> TopologyValidityMask; ///< Validity mask the topology was generated for
+      int TopologyWidth; ///< x-dimension of the topology, -1 if the topology has to be rebuilt
+      bool TopologyIsTriangulated; ///< Value of m_GenerateTriangularMesh the topology was generated for
+    };
+
+    MeshBuffer m_MeshBuffers[2]; ///< Used alternately, so the output mesh of the previous update is not modified by the next one
+    unsigned int m_CurrentMeshBuffer; ///< Index of the mesh buffer of the current output
   };
 } //END mitk namespace
 #endif
@@ -11,10 +11,71 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkIGTLMessageToUSImageFilter.h>
+#include <mitkImageWriteAccessor.h>
 #include <igtlImageMessage.h>
 #include <itkByteSwapper.h>
 
-#include <vtkSmartPointer.h>
+#include <atomic>
+
+namespace
+{
+  // number of images the filter reuses for converted messages
+  const std::size_t MaximumImagePoolSize = 4;
+}
+
+/**
+ * \brief Image of the pool of an IGTLMessageToUSImageFilter.
+ *
+ * The filter acquires the image by setting the in-use flag. The flag is
+ * released when the last reference besides the one of the pool is dropped,
+ * i.e. when the consumer is done with the image. The references are counted
+ * once more in an atomic counter, so that the drop from two references to one
+ * is detected in the same step as the decrement, even if the filter takes a
+ * reference concurrently. Acquire and release are atomic, so a consumer thread
+ * releasing the image and the filter acquiring it never overlap.
+ */
+class mitk::IGTLMessageToUSImageFilter::PooledImage : public mitk::Image
+{
+public:
+  mitkClassMacro(PooledImage, mitk::Image);
+  itkFactorylessNewMacro(Self);
+
+  bool TryAcquire()
+  {
+    bool expected = false;
+    return m_InUse.compare_exchange_strong(expected, true, std::memory_order_acquire);
+  }
+
+  /** \brief Called by the pool after it took its reference. */
+  void Attach() { m_Pooled = true; }
+
+  /** \brief Called by the pool before it drops its reference, no release is tracked afterwards. */
+  void Detach() { m_Pooled = false; }
+
+  void Register() const override
+  {
+    Superclass::Register();
+    m_ReferenceCount.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void UnRegister() const noexcept override
+  {
+    // only the pool refers to the image after this reference is dropped
+    if (m_ReferenceCount.fetch_sub(1, std::memory_order_acq_rel) == 2 && m_Pooled)
+      m_InUse.store(false, std::memory_order_release);
+
+    Superclass::UnRegister();
+  }
+
+protected:
+  PooledImage() : m_InUse(true), m_Pooled(false), m_ReferenceCount(1) {}
+  ~PooledImage() override = default;
+
+private:
+  mutable std::atomic<bool> m_InUse;
+  std::atomic<bool> m_Pooled;
+  mutable std::atomic<int> m_ReferenceCount;
+};
 
 void mitk::IGTLMessageToUSImageFilter::GetNextRawImage(
   std::vector<mitk::Image::Pointer>& imgVector)
@@ -29,7 +90,7 @@ void mitk::IGTLMessageToUSImageFilter::GetNextRawImage(
 
   if (msg != nullptr && (!msg->IsDataValid() || std::strcmp(msg->GetIGTLMessageType(), "IMAGE") != 0))
   {
-    img = m_previousImage;
+    img = this->AcquirePreviousImage();
     return;
   }
 
@@ -80,22 +141,12 @@ void mitk::IGTLMessageToUSImageFilter::Initiate(mitk::Image::Pointer& img,
   igtl::ImageMessage* msg,
   bool big_endian)
 {
-  typedef itk::Image<TPixel, 3> ImageType;
-
-  typename ImageType::Pointer output = ImageType::New();
-  typename ImageType::RegionType region;
-  typename ImageType::RegionType::SizeType size;
-  typename ImageType::RegionType::IndexType index;
-  typename ImageType::SpacingType spacing;
-  typename ImageType::PointType origin;
-
   // Copy dimensions
   int dims[3];
   msg->GetDimensions(dims);
   size_t num_pixel = 1;
   for (size_t i = 0; i < 3; i++)
   {
-    size[i] = dims[i];
     num_pixel *= dims[i];
   }
 
@@ -112,65 +163,121 @@ void mitk::IGTLMessageToUSImageFilter::Initiate(mitk::Image::Pointer& img,
     }
   }
 
-  index.Fill(0);
-
-  float matF[4][4];
-  msg->GetMatrix(matF);
-  vtkSmartPointer<vtkMatrix4x4> vtkMatrix = vtkSmartPointer<vtkMatrix4x4>::New();
-
-  for (size_t i = 0; i < 4; ++i)
-    for (size_t j = 0; j < 4; ++j)
-      vtkMatrix->SetElement(i, j, matF[i][j]);
-
   float spacingMsg[3];
-
   msg->GetSpacing(spacingMsg);
 
+  mitk::Vector3D spacing;
   for (int i = 0; i < 3; ++i)
     spacing[i] = spacingMsg[i];
 
-  region.SetSize(size);
-  region.SetIndex(index);
-  output->SetRegions(region);
-  output->SetSpacing(spacing);
-  output->Allocate();
+  const mitk::PixelType pixelType = mitk::MakeScalarPixelType<TPixel>();
+  unsigned int dimensions[3];
+  for (int i = 0; i < 3; ++i)
+    dimensions[i] = static_cast<unsigned int>(dims[i]);
+
+  const TPixel* in = static_cast<const TPixel*>(msg->GetScalarPointer());
 
-  TPixel* in = (TPixel*)msg->GetScalarPointer();
-  TPixel* out = (TPixel*)output->GetBufferPointer();
-  memcpy(out, in, num_pixel * sizeof(TPixel));
-  if (big_endian)
+  // Swap directly from the message into a recycled image buffer. The image
+  // does not reference the message memory: image data items, slices and
+  // clones may live longer than the message.
+  img = this->AcquireImage(pixelType, dimensions);
+
+  mitk::ImageWriteAccessor writeAccess(img, img->GetVolumeData(0));
+  TPixel* out = static_cast<TPixel*>(writeAccess.GetData());
+  if (sizeof(TPixel) == 1 || big_endian == itk::ByteSwapper<TPixel>::SystemIsBigEndian())
   {
-    // Even though this method is called "FromSystemToBigEndian", it also swaps
-    // "FromBigEndianToSystem".
-    // This makes sense, but might be confusing at first glance.
-    itk::ByteSwapper<TPixel>::SwapRangeFromSystemToBigEndian(out, num_pixel);
+    memcpy(out, in, num_pixel * sizeof(TPixel));
   }
   else
   {
-    itk::ByteSwapper<TPixel>::SwapRangeFromSystemToLittleEndian(out, num_pixel);
+    // Copy and swap in a single pass. Even though the method is called
+    // "FromSystemToBigEndian", it also swaps "FromBigEndianToSystem".
+    void (*swap)(TPixel*) = big_endian ? &itk::ByteSwapper<TPixel>::SwapFromSystemToBigEndian
+                                        : &itk::ByteSwapper<TPixel>::SwapFromSystemToLittleEndian;
+    for (size_t i = 0; i < num_pixel; ++i)
+    {
+      out[i] = in[i];
+      swap(&out[i]);
+    }
   }
+  img->Modified();
 
-  img = mitk::Image::New();
-  img->InitializeByItk(output.GetPointer());
-  img->SetVolume(output->GetBufferPointer());
-  //img->GetGeometry()->SetIndexToWorldTransformByVtkMatrix(vtkMatrix);
-  m_previousImage = img;
+  img->GetGeometry()->SetSpacing(spacing);
+  m_PreviousImage = img.GetPointer();
+}
 
-  float iorigin[3];
-  msg->GetOrigin(iorigin);
-  for (size_t i = 0; i < 3; i++)
+mitk::Image::Pointer mitk::IGTLMessageToUSImageFilter::AcquirePreviousImage()
+{
+  for (const auto &pooledImage : m_ImagePool)
   {
-    origin[i] = iorigin[i];
+    if (pooledImage.GetPointer() != m_PreviousImage)
+      continue;
+
+    // The image is either still in use by other consumers, then it is shared
+    // with them, or it was released and is acquired again. Its pixels are not
+    // overwritten in between, because only this filter acquires images.
+    PooledImage::Pointer candidate = pooledImage;
+    candidate->TryAcquire();
+    return candidate.GetPointer();
   }
-  output->SetOrigin(origin);
+
+  return nullptr;
+}
+
+mitk::Image::Pointer mitk::IGTLMessageToUSImageFilter::AcquireImage(const mitk::PixelType &pixelType,
+                                                                    const unsigned int *dimensions)
+{
+  for (const auto &pooledImage : m_ImagePool)
+  {
+    if (pooledImage->GetPixelType() != pixelType || pooledImage->GetDimension(0) != dimensions[0] ||
+        pooledImage->GetDimension(1) != dimensions[1] || pooledImage->GetDimension(2) != dimensions[2])
+      continue;
+
+    // take the reference before acquiring, so a concurrent release cannot happen afterwards
+    PooledImage::Pointer candidate = pooledImage;
+    if (candidate->TryAcquire())
+      return candidate.GetPointer();
+  }
+
+  PooledImage::Pointer image = PooledImage::New();
+  image->Initialize(pixelType, 3, dimensions);
+
+  if (m_ImagePool.size() < MaximumImagePoolSize)
+  {
+    m_ImagePool.push_back(image);
+    image->Attach();
+  }
+  else
+  {
+    // replace an image that is not in use anymore (e.g. of another size)
+    for (auto &pooledImage : m_ImagePool)
+    {
+      PooledImage::Pointer candidate = pooledImage;
+      if (candidate->TryAcquire())
+      {
+        candidate->Detach();
+        pooledImage = image;
+        image->Attach();
+        break;
+      }
+    }
+  }
+
+  return image.GetPointer();
 }
 
 mitk::IGTLMessageToUSImageFilter::IGTLMessageToUSImageFilter()
-  : m_upstream(nullptr)
+  : m_upstream(nullptr), m_PreviousImage(nullptr)
 {
   MITK_DEBUG << "Instantiated this (" << this << ") mitkIGTMessageToUSImageFilter\n";
 }
 
+mitk::IGTLMessageToUSImageFilter::~IGTLMessageToUSImageFilter()
+{
+  for (auto &pooledImage : m_ImagePool)
+    pooledImage->Detach();
+}
+
 void mitk::IGTLMessageToUSImageFilter::SetNumberOfExpectedOutputs(
   unsigned int numOutputs)
 {
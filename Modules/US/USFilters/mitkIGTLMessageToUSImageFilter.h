@@ -21,6 +21,13 @@ found in the LICENSE file.
 
 namespace mitk
 {
+  /**
+  * \brief Converts OpenIGTLink image messages into mitk::Image objects.
+  *
+  * The message data is byte swapped in a single pass into images of a small
+  * pool. An image of the pool is acquired by the filter and released as soon as
+  * no one but the pool refers to it anymore, then it is recycled.
+  */
   class MITKUS_EXPORT IGTLMessageToUSImageFilter : public USImageSource
   {
   public:
@@ -49,6 +56,7 @@ namespace mitk
 
   protected:
     IGTLMessageToUSImageFilter();
+    ~IGTLMessageToUSImageFilter() override;
 
     using Superclass::GetNextRawImage;
 
@@ -60,10 +68,37 @@ namespace mitk
     void GetNextRawImage(std::vector<mitk::Image::Pointer>& imgVector) override;
 
   private:
+    class PooledImage;
+
     mitk::IGTLMessageSource* m_upstream;
-    mitk::Image::Pointer m_previousImage;
+
+    /**
+     * \brief Image of the last converted message, only compared with the
+     * images of the pool. It is not referenced, so it can be released.
+     */
+    const mitk::Image* m_PreviousImage;
+
+    /**
+     * \brief Images that are reused for converted messages, see AcquireImage()
+     */
+    std::vector<itk::SmartPointer<PooledImage>> m_ImagePool;
+
+    /**
+     * \brief Returns an image of the given type and size whose buffer may be
+     * overwritten. Images of the pool are reused if they could be acquired,
+     * i.e. they were released by all consumers, otherwise a new image is
+     * added to the pool.
+     */
+    mitk::Image::Pointer AcquireImage(const mitk::PixelType &pixelType, const unsigned int *dimensions);
+
+    /**
+     * \brief Returns the image of the last converted message again, if it is
+     * still in the pool, otherwise nullptr.
+     */
+    mitk::Image::Pointer AcquirePreviousImage();
+
     /**
-     * \brief Templated method to copy the data of the OIGTL message to the image, depending
+     * \brief Templated method to transfer the data of the OIGTL message to the image, depending
      * on the pixel type contained in the message.
      *
      * \param img the image to fill with the data from msg
@@ -39,30 +39,24 @@ QSharedPointer<ctkPlugin> LogImpl::GetBundle() const
 
 void LogImpl::Log(const SmartPointer<IStatus>& status)
 {
+  mitk::LogLevel level = mitk::LogLevel::Info;
   switch (status->GetSeverity())
   {
   case IStatus::WARNING_TYPE:
-    mitk::PseudoLogStream(mitk::LogLevel::Warn,
-                         qPrintable(status->GetFileName()),
-                         status->GetLineNumber(),
-                         qPrintable(status->GetMethodName()))(qPrintable(plugin->getSymbolicName()))
-        << status->ToString().toStdString();
+    level = mitk::LogLevel::Warn;
     break;
   case IStatus::ERROR_TYPE:
-    mitk::PseudoLogStream(mitk::LogLevel::Error,
-                         qPrintable(status->GetFileName()),
-                         status->GetLineNumber(),
-                         qPrintable(status->GetMethodName()))(qPrintable(plugin->getSymbolicName()))
-        << status->ToString().toStdString();
+    level = mitk::LogLevel::Error;
     break;
   default:
-    mitk::PseudoLogStream(mitk::LogLevel::Info,
-                         qPrintable(status->GetFileName()),
-                         status->GetLineNumber(),
-                         qPrintable(status->GetMethodName()))(qPrintable(plugin->getSymbolicName()))
-        << status->ToString().toStdString();
     break;
   }
+
+  MITKLOG_STREAM_AT(level,
+                    qPrintable(status->GetFileName()),
+                    status->GetLineNumber(),
+                    qPrintable(status->GetMethodName()))(qPrintable(plugin->getSymbolicName()))
+      << status->ToString().toStdString();
 }
 
 void LogImpl::RemoveLogListener(ILogListener* /*listener*/)
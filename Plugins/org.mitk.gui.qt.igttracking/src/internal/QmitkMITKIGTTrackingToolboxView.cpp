@@ -47,8 +47,9 @@ QmitkMITKIGTTrackingToolboxView::QmitkMITKIGTTrackingToolboxView()
   , m_Controls(nullptr)
   , m_DeviceTypeCollection(nullptr)
   , m_ToolProjectionNode(nullptr)
+  , m_WaitForTrackingData(false)
+  , m_LoggingUpdatePending(false)
 {
-  m_TrackingLoggingTimer = new QTimer(this);
   m_TrackingRenderTimer = new QTimer(this);
   m_TimeoutTimer = new QTimer(this);
   m_tracking = false;
@@ -102,10 +103,9 @@ QmitkMITKIGTTrackingToolboxView::QmitkMITKIGTTrackingToolboxView()
 QmitkMITKIGTTrackingToolboxView::~QmitkMITKIGTTrackingToolboxView()
 {
   this->StoreUISettings();
-  m_TrackingLoggingTimer->stop();
+  this->StopWaitingForTrackingData();
   m_TrackingRenderTimer->stop();
   m_TimeoutTimer->stop();
-  delete m_TrackingLoggingTimer;
   delete m_TrackingRenderTimer;
   delete m_TimeoutTimer;
   try
@@ -152,7 +152,6 @@ void QmitkMITKIGTTrackingToolboxView::CreateQtPartControl(QWidget *parent)
     connect(m_Controls->m_ConnectSimpleMode, SIGNAL(clicked()), this, SLOT(OnConnectDisconnect()));
     connect(m_Controls->m_StartTrackingSimpleMode, SIGNAL(clicked()), this, SLOT(OnStartStopTracking()));
     connect(m_Controls->m_FreezeUnfreezeTrackingButton, SIGNAL(clicked()), this, SLOT(OnFreezeUnfreezeTracking()));
-    connect(m_TrackingLoggingTimer, SIGNAL(timeout()), this, SLOT(UpdateLoggingTrackingTimer()));
     connect(m_TrackingRenderTimer, SIGNAL(timeout()), this, SLOT(UpdateRenderTrackingTimer()));
     connect(m_TimeoutTimer, SIGNAL(timeout()), this, SLOT(OnTimeOut()));
     connect(m_Controls->m_ChooseFile, SIGNAL(clicked()), this, SLOT(OnChooseFileClicked()));
@@ -650,12 +649,12 @@ void QmitkMITKIGTTrackingToolboxView::OnStartTrackingFinished(bool success, QStr
     {
       if (m_Controls->m_RenderUpdateRate->value() != 0)
         m_TrackingRenderTimer->start(1000 / (m_Controls->m_RenderUpdateRate->value()));
-      m_TrackingLoggingTimer->start(1000 / (m_Controls->m_LogUpdateRate->value()));
+      this->StartWaitingForTrackingData(m_Controls->m_LogUpdateRate->value());
     }
     else
     {
       m_TrackingRenderTimer->start(1000 / (m_Controls->m_UpdateRate->value()));
-      m_TrackingLoggingTimer->start(1000 / (m_Controls->m_UpdateRate->value()));
+      this->StartWaitingForTrackingData(m_Controls->m_UpdateRate->value());
     }
   }
 
@@ -728,7 +727,7 @@ void QmitkMITKIGTTrackingToolboxView::OnStopTracking()
 
 
   m_TrackingRenderTimer->stop();
-  m_TrackingLoggingTimer->stop();
+  this->StopWaitingForTrackingData();
 
   m_Worker->SetWorkerMethod(QmitkMITKIGTTrackingToolboxViewWorker::eStopTracking);
   m_WorkerThread->start();
@@ -970,6 +969,64 @@ void QmitkMITKIGTTrackingToolboxView::UpdateLoggingTrackingTimer()
   m_Controls->m_TrackingToolsStatusWidget->Refresh();
 }
 
+void QmitkMITKIGTTrackingToolboxView::OnNewTrackingData()
+{
+  this->UpdateLoggingTrackingTimer();
+
+  std::lock_guard<std::mutex> lock(m_LoggingUpdateMutex);
+  m_LoggingUpdatePending = false;
+  m_LoggingUpdateDone.notify_all();
+}
+
+void QmitkMITKIGTTrackingToolboxView::StartWaitingForTrackingData(int maximumUpdateRate)
+{
+  this->StopWaitingForTrackingData();
+
+  mitk::TrackingDeviceSource::Pointer source = m_Worker->GetTrackingDeviceSource();
+  if (source.IsNull() || maximumUpdateRate <= 0)
+    return;
+
+  m_LoggingUpdatePending = false;
+  m_WaitForTrackingData = true;
+  m_TrackingDataThread = std::thread(&QmitkMITKIGTTrackingToolboxView::WaitForTrackingData, this, source,
+                                     std::chrono::milliseconds(1000 / maximumUpdateRate));
+}
+
+void QmitkMITKIGTTrackingToolboxView::StopWaitingForTrackingData()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_LoggingUpdateMutex);
+    m_WaitForTrackingData = false;
+    m_LoggingUpdateDone.notify_all();
+  }
+
+  // the thread never waits for the GUI thread after m_WaitForTrackingData is reset, so joining cannot block
+  if (m_TrackingDataThread.joinable())
+    m_TrackingDataThread.join();
+}
+
+void QmitkMITKIGTTrackingToolboxView::WaitForTrackingData(mitk::TrackingDeviceSource::Pointer source, std::chrono::milliseconds minimumInterval)
+{
+  auto lastUpdate = std::chrono::steady_clock::now() - minimumInterval;
+  while (m_WaitForTrackingData)
+  {
+    if (!source->WaitForNewData(100))
+      continue;
+
+    // do not log faster than the chosen logging update rate
+    std::this_thread::sleep_until(lastUpdate + minimumInterval);
+    lastUpdate = std::chrono::steady_clock::now();
+
+    // request one update at a time, the data is output by the GUI thread before the next wait
+    std::unique_lock<std::mutex> lock(m_LoggingUpdateMutex);
+    if (!m_WaitForTrackingData)
+      break;
+    m_LoggingUpdatePending = true;
+    QMetaObject::invokeMethod(this, "OnNewTrackingData", Qt::QueuedConnection);
+    m_LoggingUpdateDone.wait(lock, [this] { return !m_LoggingUpdatePending || !m_WaitForTrackingData; });
+  }
+}
+
 void QmitkMITKIGTTrackingToolboxView::OnChooseFileClicked()
 {
   QDir currentPath = QFileInfo(m_Controls->m_LoggingFileName->text()).dir();
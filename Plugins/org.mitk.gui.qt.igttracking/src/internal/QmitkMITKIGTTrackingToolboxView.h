@@ -32,6 +32,12 @@ found in the LICENSE file.
 //QT headers
 #include <QTimer>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "QmitkMITKIGTTrackingToolboxViewWorker.h"
 
 //Forward declaration of MITK classes
@@ -129,6 +135,9 @@ class QmitkMITKIGTTrackingToolboxView : public QmitkAbstractView
     void UpdateRenderTrackingTimer();
     void UpdateLoggingTrackingTimer();
 
+    /** @brief Updates the logging filter for new tracking data, which was announced by the tracking data thread.*/
+    void OnNewTrackingData();
+
     /** @brief Slot for showing the rendering disabled warning label*/
     void OnChangeRenderUpdateRate();
 
@@ -211,11 +220,25 @@ class QmitkMITKIGTTrackingToolboxView : public QmitkAbstractView
    mitk::IGTLServer::Pointer m_IGTLServer;
    mitk::IGTLMessageProvider::Pointer m_IGTLMessageProvider;
 
-   /** @brief This timer updates the IGT pipline and also the logging filter if logging is activated.*/
+   /** @brief This timer updates the IGT pipline for rendering.*/
    QTimer* m_TrackingRenderTimer;
-   QTimer* m_TrackingLoggingTimer;
    QTimer* m_TimeoutTimer;
 
+   /** @brief Instead of the logging timer, this thread waits for new data of the tracking device source and
+    *  requests a logging update in the GUI thread as soon as it arrives. The logging update rate is kept as maximum rate.*/
+   std::thread m_TrackingDataThread;
+   std::atomic<bool> m_WaitForTrackingData;
+   bool m_LoggingUpdatePending; ///> true while a logging update is requested but not yet done, guarded by m_LoggingUpdateMutex
+   std::mutex m_LoggingUpdateMutex;
+   std::condition_variable m_LoggingUpdateDone;
+
+   /** @brief Starts the tracking data thread, which requests at most maximumUpdateRate logging updates per second.*/
+   void StartWaitingForTrackingData(int maximumUpdateRate);
+   /** @brief Stops the tracking data thread. Returns only after the thread finished.*/
+   void StopWaitingForTrackingData();
+   /** @brief Loop of the tracking data thread.*/
+   void WaitForTrackingData(mitk::TrackingDeviceSource::Pointer source, std::chrono::milliseconds minimumInterval);
+
    bool m_SimpleModeEnabled; ///>Stores if simple UI mode is enabled
 
    /** Replaces the current navigation tool storage which is stored in m_toolStorage.